@@ -0,0 +1,168 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * apps/examples/messaging_sample/messaging_benchmark.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <messaging/messaging.h>
+#include "messaging_sample_internal.h"
+
+#define BENCH_PORT "bench_port"
+#define BENCH_MSG_CNT 1000
+#define BENCH_PRIO 100
+#define BENCH_STACKSIZE 2048
+#define BENCH_MAX_MSGLEN 1024
+
+#ifdef CONFIG_MESSAGING_SHM_RING
+#define BENCH_TRANSPORT "shm ring"
+#else
+#define BENCH_TRANSPORT "mqueue"
+#endif
+
+extern int fail_cnt;
+static volatile int g_recv_cnt;
+static sem_t g_recv_ready;
+static sem_t g_recv_done;
+
+static void bench_recv_callback(msg_reply_type_t msg_type, msg_recv_buf_t *recv_data, void *cb_data)
+{
+	g_recv_cnt++;
+	if (g_recv_cnt == BENCH_MSG_CNT) {
+		sem_post(&g_recv_done);
+	}
+}
+
+static int bench_recv(int argc, FAR char *argv[])
+{
+	int ret;
+	msg_callback_info_t cb_info;
+	msg_recv_buf_t data;
+
+	cb_info.cb_func = bench_recv_callback;
+	cb_info.cb_data = NULL;
+
+	data.buf = (char *)malloc(BENCH_MAX_MSGLEN);
+	if (data.buf == NULL) {
+		printf("Fail to allocate benchmark receive buffer.\n");
+		sem_post(&g_recv_ready);
+		return ERROR;
+	}
+	data.buflen = BENCH_MAX_MSGLEN;
+
+	ret = messaging_recv_nonblock(BENCH_PORT, &data, &cb_info);
+	sem_post(&g_recv_ready);
+	if (ret != OK) {
+		printf("Fail to receive with non-block mode.\n");
+		free(data.buf);
+		return ERROR;
+	}
+
+	/* Keep this task alive until all messages are handled in the callback. */
+	while (g_recv_cnt < BENCH_MSG_CNT) {
+		usleep(10000);
+	}
+
+	messaging_cleanup(BENCH_PORT);
+	free(data.buf);
+	return OK;
+}
+
+static void messaging_benchmark_run(int msglen)
+{
+	int idx;
+	int ret;
+	int receiver_pid;
+	uint64_t elapsed_us;
+	struct timespec stime;
+	struct timespec etime;
+	msg_send_data_t send_data;
+
+	send_data.msg = (char *)malloc(msglen);
+	if (send_data.msg == NULL) {
+		fail_cnt++;
+		printf("Fail to allocate benchmark message.\n");
+		return;
+	}
+	memset(send_data.msg, 'M', msglen);
+	send_data.msglen = msglen;
+	send_data.priority = BENCH_PRIO;
+
+	g_recv_cnt = 0;
+	sem_init(&g_recv_ready, 0, 0);
+	sem_init(&g_recv_done, 0, 0);
+
+	receiver_pid = task_create("bench_recv", BENCH_PRIO, BENCH_STACKSIZE, bench_recv, NULL);
+	if (receiver_pid < 0) {
+		fail_cnt++;
+		printf("Fail to create bench_recv task.\n");
+		goto errout;
+	}
+	sem_wait(&g_recv_ready);
+
+	clock_gettime(CLOCK_REALTIME, &stime);
+	for (idx = 0; idx < BENCH_MSG_CNT; idx++) {
+		ret = messaging_send(BENCH_PORT, &send_data);
+		if (ret != OK) {
+			fail_cnt++;
+			printf("Fail to send %d-th benchmark message.\n", idx);
+			task_delete(receiver_pid);
+			goto errout;
+		}
+	}
+	sem_wait(&g_recv_done);
+	clock_gettime(CLOCK_REALTIME, &etime);
+
+	elapsed_us = (uint64_t)(etime.tv_sec - stime.tv_sec) * 1000000 + (etime.tv_nsec - stime.tv_nsec) / 1000;
+	if (elapsed_us == 0) {
+		elapsed_us = 1;
+	}
+	printf("[%s] %4d bytes x %d msgs : %llu us, %llu msgs/s, %llu KB/s\n", BENCH_TRANSPORT, msglen, BENCH_MSG_CNT, elapsed_us,
+		   (uint64_t)BENCH_MSG_CNT * 1000000 / elapsed_us, (uint64_t)BENCH_MSG_CNT * msglen * 1000000 / 1024 / elapsed_us);
+
+errout:
+	sem_destroy(&g_recv_ready);
+	sem_destroy(&g_recv_done);
+	free(send_data.msg);
+}
+
+void messaging_benchmark(void)
+{
+	printf("\n--- Start the messaging benchmark with %s transport. ---\n", BENCH_TRANSPORT);
+
+	messaging_benchmark_run(64);
+
+	/* Wait for finishing previous receiver. */
+	sleep(1);
+
+	messaging_benchmark_run(1024);
+
+	/* Wait for finishing previous receiver. */
+	sleep(1);
+}
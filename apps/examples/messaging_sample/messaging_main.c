@@ -134,6 +134,16 @@ int messaging_main(int argc, char *argv[])
 	char *cnt_arg = NULL;
 	int execution_type = EXEC_NORMAL;
 
+	if (argc == 2 && strncmp(argv[1], "-b", strlen("-b") + 1) == 0) {
+		if (is_running) {
+			goto already_running;
+		}
+		is_running = true;
+		messaging_benchmark();
+		is_running = false;
+		return 0;
+	}
+
 	if (argc >= 4 || argc == 2) {
 		goto usage;
 	}
@@ -196,6 +206,7 @@ usage:
 	printf(" -r start : Execute messaging sample infinitely until stop cmd.\n");
 	printf("    stop  : Stop the messaging sample infinite execution.\n");
 	printf(" -n COUNT : Execute messaging sample COUNT-iterations.\n");
+	printf(" -b       : Measure the messaging throughput with 64 and 1024 bytes messages.\n");
 	return -1;
 already_running:
 	printf("There is already running Messaging Sample.\n");
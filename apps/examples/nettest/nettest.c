@@ -149,6 +149,7 @@ uint32_t total_data;
 #define NETTEST_PROTO_BROADCAST "brc"
 #define NETTEST_PROTO_MULTICAST "mtc"
 #define NETTEST_PROTO_STRESS "str"
+#define NETTEST_PROTO_LATENCY "lat"
 
 typedef enum {
 	NT_NONE,
@@ -157,6 +158,7 @@ typedef enum {
 	NT_BROADCAST,
 	NT_MULTICAST,
 	NT_STRESS,
+	NT_LATENCY,
 } nettest_proto_e;
 
 /****************************************************************************
@@ -177,6 +179,8 @@ static void show_usage(void)
 	printf("\tmtc: MULTICAST\n");
 	printf("\tbrc: BROADCAST\n");
 	printf("\tstr: STRESS TEST\n");
+	printf("\tlat: socket call LATENCY on loopback, client mode only\n");
+	printf("\t\t(e.g. nettest 2 lat 127.0.0.1 5001 1000)\n");
 
 	printf("ADDRESS\n");
 	printf("\tAddress to bind if mode is server\n");
@@ -193,6 +197,7 @@ static void show_usage(void)
 	printf("\t\t(If you want to receive continousely then insert 0)\n");
 	printf("\tThe number of packets to send if the mode is client\n");
 	printf("\t\t(If you want to send continousely then insert 0)\n");
+	printf("\tThe number of calls to time if the protocol is lat (default 1000)\n");
 
 	printf("INTERVAL\n");
 	printf("\tSet the interval of the sent packet if mode is client(default 0)\n");
@@ -831,6 +836,7 @@ out_with_socket:
 }
 
 extern void nettest_stress(char *addr, int port);
+extern void nettest_latency(char *addr, int port, int count);
 
 /* Sample App to test Transport Layer (TCP / UDP) / IP Multicast Functionality */
 #ifdef CONFIG_BUILD_KERNEL
@@ -868,6 +874,8 @@ int nettest_main(int argc, char *argv[])
 		proto = NT_MULTICAST;
 	} else if (!strncmp(argv[2], NETTEST_PROTO_STRESS, strlen(NETTEST_PROTO_STRESS) + 1)) {
 		proto = NT_STRESS;
+	} else if (!strncmp(argv[2], NETTEST_PROTO_LATENCY, strlen(NETTEST_PROTO_LATENCY) + 1)) {
+		proto = NT_LATENCY;
 	} else {
 		goto err_with_input;
 	}
@@ -885,6 +893,14 @@ int nettest_main(int argc, char *argv[])
 		goto err_with_input;
 	}
 
+	if (proto == NT_LATENCY) {
+		if (mode != NETTEST_CLIENT_MODE) {
+			goto err_with_input;
+		}
+		nettest_latency(g_app_target_addr, g_app_target_port, num_packets_to_process);
+		return 0;
+	}
+
 	if (mode == NETTEST_SERVER_MODE) {
 		if (proto == NT_TCP) {
 			tcp_server_thread(num_packets_to_process);
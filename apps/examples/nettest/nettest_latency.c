@@ -0,0 +1,287 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LAT_MSG_SIZE 64
+#define LAT_SOCKOPT_CALLS 2	/* setsockopt + getsockopt per iteration */
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+#define LAT_CLOCK CLOCK_MONOTONIC
+#else
+#define LAT_CLOCK CLOCK_REALTIME
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint64_t lat_now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(LAT_CLOCK, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void lat_report(const char *name, uint64_t elapsed_us, int calls)
+{
+	/* in 1/100 us, the total is only a few system ticks for short runs */
+	uint32_t per_call = (uint32_t)(elapsed_us * 100 / calls);
+
+	printf("%-28s %6d calls %8lu.%02lu us/call\n", name, calls,
+		   (unsigned long)(per_call / 100), (unsigned long)(per_call % 100));
+}
+
+static void lat_sockaddr(struct sockaddr_in *addr, const char *ip, int port)
+{
+	memset(addr, 0, sizeof(*addr));
+	addr->sin_family = AF_INET;
+	addr->sin_port = htons(port);
+	addr->sin_addr.s_addr = inet_addr(ip);
+}
+
+/* setsockopt()/getsockopt() do not touch the network at all, so this is
+ * the bare cost of getting into the stack and back.
+ */
+static int lat_sockopt(int count)
+{
+	struct timeval tv = {1, 0};
+	socklen_t len;
+	uint64_t start;
+	int type;
+	int sock;
+	int i;
+
+	sock = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sock < 0) {
+		printf("socket fail %d\n", errno);
+		return -1;
+	}
+
+	start = lat_now_us();
+	for (i = 0; i < count; i++) {
+		len = sizeof(type);
+		if (setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0 ||
+			getsockopt(sock, SOL_SOCKET, SO_TYPE, &type, &len) < 0) {
+			printf("sockopt fail %d\n", errno);
+			close(sock);
+			return -1;
+		}
+	}
+	lat_report("setsockopt+getsockopt", lat_now_us() - start, count * LAT_SOCKOPT_CALLS);
+
+	close(sock);
+	return 0;
+}
+
+/* A UDP socket sends to itself: sendto() alone, then the round trip
+ * through the loopback interface up to recvfrom().
+ */
+static int lat_udp(const char *ip, int port, int count)
+{
+	struct sockaddr_in addr;
+	struct timeval tv = {1, 0};
+	char buf[LAT_MSG_SIZE];
+	uint64_t send_us = 0;
+	uint64_t start;
+	uint64_t sent;
+	int sock;
+	int i;
+
+	sock = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sock < 0) {
+		printf("socket fail %d\n", errno);
+		return -1;
+	}
+
+	lat_sockaddr(&addr, ip, port);
+	if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printf("bind fail %d\n", errno);
+		goto errout;
+	}
+	setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+	memset(buf, 'u', sizeof(buf));
+	start = lat_now_us();
+	for (i = 0; i < count; i++) {
+		sent = lat_now_us();
+		if (sendto(sock, buf, sizeof(buf), 0, (struct sockaddr *)&addr, sizeof(addr)) != sizeof(buf)) {
+			printf("sendto fail %d\n", errno);
+			goto errout;
+		}
+		send_us += lat_now_us() - sent;
+		if (recvfrom(sock, buf, sizeof(buf), 0, NULL, NULL) != sizeof(buf)) {
+			printf("recvfrom fail %d\n", errno);
+			goto errout;
+		}
+	}
+	lat_report("udp sendto", send_us, count);
+	lat_report("udp sendto+recvfrom", lat_now_us() - start, count);
+
+	close(sock);
+	return 0;
+
+errout:
+	close(sock);
+	return -1;
+}
+
+static void *lat_tcp_echo(void *arg)
+{
+	char buf[LAT_MSG_SIZE];
+	int listener = (int)arg;
+	int sock;
+	int len;
+
+	sock = accept(listener, NULL, NULL);
+	if (sock < 0) {
+		printf("accept fail %d\n", errno);
+		return NULL;
+	}
+
+	while ((len = recv(sock, buf, sizeof(buf), 0)) > 0) {
+		if (send(sock, buf, len, 0) != len) {
+			break;
+		}
+	}
+
+	close(sock);
+	return NULL;
+}
+
+/* A ping-pong over a loopback TCP connection with an echo thread: send()
+ * alone, then the round trip including the echo thread's recv()/send().
+ */
+static int lat_tcp(const char *ip, int port, int count)
+{
+	struct sockaddr_in addr;
+	char buf[LAT_MSG_SIZE];
+	uint64_t send_us = 0;
+	uint64_t start;
+	uint64_t sent;
+	pthread_t tid;
+	int listener;
+	int sock = -1;
+	int opt = 1;
+	int len;
+	int ret = -1;
+	int i;
+
+	listener = socket(AF_INET, SOCK_STREAM, 0);
+	if (listener < 0) {
+		printf("socket fail %d\n", errno);
+		return -1;
+	}
+	setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+	lat_sockaddr(&addr, ip, port);
+	if (bind(listener, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listener, 1) < 0) {
+		printf("bind/listen fail %d\n", errno);
+		close(listener);
+		return -1;
+	}
+
+	if (pthread_create(&tid, NULL, lat_tcp_echo, (void *)listener) != 0) {
+		printf("pthread_create fail\n");
+		close(listener);
+		return -1;
+	}
+
+	sock = socket(AF_INET, SOCK_STREAM, 0);
+	if (sock < 0 || connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printf("connect fail %d\n", errno);
+		goto out;
+	}
+	setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+
+	memset(buf, 't', sizeof(buf));
+	start = lat_now_us();
+	for (i = 0; i < count; i++) {
+		sent = lat_now_us();
+		if (send(sock, buf, sizeof(buf), 0) != sizeof(buf)) {
+			printf("send fail %d\n", errno);
+			goto out;
+		}
+		send_us += lat_now_us() - sent;
+		for (len = 0; len < sizeof(buf);) {
+			int nbytes = recv(sock, buf + len, sizeof(buf) - len, 0);
+			if (nbytes <= 0) {
+				printf("recv fail %d\n", errno);
+				goto out;
+			}
+			len += nbytes;
+		}
+	}
+	lat_report("tcp send", send_us, count);
+	lat_report("tcp send+recv (echo)", lat_now_us() - start, count);
+	ret = 0;
+
+out:
+	if (sock >= 0) {
+		close(sock);
+	}
+	/* closing the listener also wakes up an echo thread still in accept() */
+	close(listener);
+	pthread_join(tid, NULL);
+	return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/* Measures the time socket calls take on the loopback interface. The
+ * numbers are only meaningful relative to each other, e.g. between a build
+ * with CONFIG_NET_TCPIP_CORE_LOCKING and one without it.
+ */
+void nettest_latency(char *addr, int port, int count)
+{
+	if (count <= 0) {
+		count = 1000;
+	}
+
+#ifdef CONFIG_NET_TCPIP_CORE_LOCKING
+	printf("socket call latency, tcpip core locking\n");
+#else
+	printf("socket call latency, tcpip thread messages\n");
+#endif
+
+	if (lat_sockopt(count) < 0 || lat_udp(addr, port, count) < 0 || lat_tcp(addr, port, count) < 0) {
+		printf("latency test failed\n");
+	}
+}
@@ -49,6 +49,7 @@
 #include <tinyara/streams.h>
 #include <tinyara/fs/ioctl.h>
 #include <tinyara/fs/fs_utils.h>
+#include <tinyara/pipe.h>
 #include <tinyara/configdata.h>
 #include <time.h>
 #include "tc_common.h"
@@ -124,6 +125,8 @@
 #define FIFO_FILE_PATH "/dev/fifo_test"
 
 #define FIFO_DATA "FIFO DATA"
+
+#define PIPE_SPLICE_LEN 3000
 #endif
 
 #ifndef STDIN_FILENO
@@ -2322,6 +2325,94 @@ static void tc_fs_vfs_mkfifo_exist_path_n(void)
 
 	TC_SUCCESS_RESULT();
 }
+
+/**
+ * @testcase         tc_fs_vfs_pipe_resize_splice_p
+ * @brief            Resize a pipe and splice its data to and from a file
+ * @scenario         Grow the pipe, check that it can't shrink below the buffered data,
+ *                   then move the data into a file and back without a user buffer
+ * @apicovered       pipe, ioctl(PIPEIOC_GETSIZE, PIPEIOC_SETSIZE, PIPEIOC_SPLICE)
+ * @precondition     CONFIG_PIPES should be enabled & CONFIG_DEV_PIPE_SIZE must greater than 11
+ * @postcondition    NA
+ */
+static void tc_fs_vfs_pipe_resize_splice_p(void)
+{
+	static char buf[PIPE_SPLICE_LEN];
+	struct pipe_splice_s splice;
+	struct stat st;
+	size_t size;
+	int fds[2];
+	int fd;
+	int ret;
+	int i;
+
+	ret = pipe(fds);
+	TC_ASSERT_EQ("pipe", ret, OK);
+
+	ret = ioctl(fds[1], PIPEIOC_GETSIZE, (unsigned long)&size);
+	TC_ASSERT_EQ_CLEANUP("ioctl", ret, OK, goto errout_with_pipe);
+	TC_ASSERT_EQ_CLEANUP("ioctl", size & (size - 1), 0, goto errout_with_pipe);
+
+	ret = ioctl(fds[1], PIPEIOC_SETSIZE, PIPE_SPLICE_LEN);
+	TC_ASSERT_EQ_CLEANUP("ioctl", ret, OK, goto errout_with_pipe);
+	ret = ioctl(fds[1], PIPEIOC_GETSIZE, (unsigned long)&size);
+	TC_ASSERT_EQ_CLEANUP("ioctl", size, 4096, goto errout_with_pipe);
+
+	for (i = 0; i < PIPE_SPLICE_LEN; i++) {
+		buf[i] = (char)i;
+	}
+	ret = write(fds[1], buf, PIPE_SPLICE_LEN);
+	TC_ASSERT_EQ_CLEANUP("write", ret, PIPE_SPLICE_LEN, goto errout_with_pipe);
+
+	ret = ioctl(fds[1], PIPEIOC_SETSIZE, PIPE_SPLICE_LEN / 2);
+	TC_ASSERT_LT_CLEANUP("ioctl", ret, 0, goto errout_with_pipe);
+
+	vfs_mount();
+
+	fd = open(VFS_FILE_PATH, O_WRONLY | O_CREAT | O_TRUNC);
+	TC_ASSERT_GEQ_CLEANUP("open", fd, 0, goto errout_with_mount);
+
+	splice.ps_fd = fd;
+	splice.ps_len = PIPE_SPLICE_LEN;
+	splice.ps_flags = PIPE_SPLICE_FROMPIPE;
+	ret = ioctl(fds[0], PIPEIOC_SPLICE, (unsigned long)&splice);
+	close(fd);
+	TC_ASSERT_EQ_CLEANUP("ioctl", ret, PIPE_SPLICE_LEN, goto errout_with_mount);
+
+	ret = stat(VFS_FILE_PATH, &st);
+	TC_ASSERT_EQ_CLEANUP("stat", ret, OK, goto errout_with_mount);
+	TC_ASSERT_EQ_CLEANUP("stat", st.st_size, PIPE_SPLICE_LEN, goto errout_with_mount);
+
+	fd = open(VFS_FILE_PATH, O_RDONLY);
+	TC_ASSERT_GEQ_CLEANUP("open", fd, 0, goto errout_with_mount);
+
+	splice.ps_flags = PIPE_SPLICE_TOPIPE;
+	ret = ioctl(fds[1], PIPEIOC_SPLICE, (unsigned long)&splice);
+	close(fd);
+	TC_ASSERT_EQ_CLEANUP("ioctl", ret, PIPE_SPLICE_LEN, goto errout_with_mount);
+
+	memset(buf, 0, PIPE_SPLICE_LEN);
+	ret = read(fds[0], buf, PIPE_SPLICE_LEN);
+	TC_ASSERT_EQ_CLEANUP("read", ret, PIPE_SPLICE_LEN, goto errout_with_mount);
+	for (i = 0; i < PIPE_SPLICE_LEN; i++) {
+		TC_ASSERT_EQ_CLEANUP("read", buf[i], (char)i, goto errout_with_mount);
+	}
+
+	unlink(VFS_FILE_PATH);
+	vfs_unmount();
+	close(fds[0]);
+	close(fds[1]);
+
+	TC_SUCCESS_RESULT();
+	return;
+
+errout_with_mount:
+	unlink(VFS_FILE_PATH);
+	vfs_unmount();
+errout_with_pipe:
+	close(fds[0]);
+	close(fds[1]);
+}
 #endif
 
 /**
@@ -6108,6 +6199,7 @@ int tc_filesystem_main(int argc, char *argv[])
 #if defined(CONFIG_PIPES) && (CONFIG_DEV_PIPE_SIZE > 11)
 	tc_fs_vfs_mkfifo_p();
 	tc_fs_vfs_mkfifo_exist_path_n();
+	tc_fs_vfs_pipe_resize_splice_p();
 #endif
 	tc_fs_vfs_sendfile_p();
 	tc_fs_vfs_sendfile_invalid_fd_n();
@@ -88,6 +88,9 @@ int tc_network_main(int argc, char *argv[])
 #ifdef CONFIG_TC_NET_SHUTDOWN
 	net_shutdown_main();
 #endif
+#ifdef CONFIG_TC_NET_SOCKETPAIR
+	net_socketpair_main();
+#endif
 #ifdef CONFIG_TC_NET_DHCPC
 	net_dhcpc_main();
 #endif
@@ -79,6 +79,9 @@ int net_recvfrom_main(void);
 #ifdef CONFIG_TC_NET_SHUTDOWN
 int net_shutdown_main(void);
 #endif
+#ifdef CONFIG_TC_NET_SOCKETPAIR
+int net_socketpair_main(void);
+#endif
 #ifdef CONFIG_TC_NET_SELECT
 int net_select_main(void);
 #endif
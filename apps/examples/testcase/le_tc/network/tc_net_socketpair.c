@@ -0,0 +1,120 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file tc_net_socketpair.c
+/// @brief Test Case Example for socketpair() API
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "tc_internal.h"
+
+#define TC_SOCKETPAIR_MSG "socketpair"
+#define TC_SOCKETPAIR_LEN ((int)sizeof(TC_SOCKETPAIR_MSG))
+
+/**
+ * @testcase         :tc_net_socketpair_p
+ * @brief            :
+ * @scenario         :create a pair of sockets and send in both directions
+ * @apicovered       :socketpair(), send(), recv()
+ * @precondition     :
+ * @postcondition    :
+ */
+static void tc_net_socketpair_p(void)
+{
+	char buf[TC_SOCKETPAIR_LEN];
+	int sv[2];
+	int ret;
+	int i;
+
+	ret = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+	TC_ASSERT_EQ("socketpair", ret, 0);
+
+	for (i = 0; i < 2; i++) {
+		ret = send(sv[i], TC_SOCKETPAIR_MSG, TC_SOCKETPAIR_LEN, 0);
+		TC_ASSERT_EQ_CLEANUP("send", ret, TC_SOCKETPAIR_LEN, close(sv[0]); close(sv[1]));
+
+		memset(buf, 0, sizeof(buf));
+		ret = recv(sv[1 - i], buf, sizeof(buf), 0);
+		TC_ASSERT_EQ_CLEANUP("recv", ret, TC_SOCKETPAIR_LEN, close(sv[0]); close(sv[1]));
+		TC_ASSERT_EQ_CLEANUP("recv", strcmp(buf, TC_SOCKETPAIR_MSG), 0, close(sv[0]); close(sv[1]));
+	}
+
+	close(sv[0]);
+
+	/* The peer sees the end of file once the other end is closed */
+
+	ret = recv(sv[1], buf, sizeof(buf), 0);
+	close(sv[1]);
+	TC_ASSERT_EQ("recv", ret, 0);
+	TC_SUCCESS_RESULT();
+}
+
+/**
+ * @testcase         :tc_net_socketpair_family_n
+ * @brief            :
+ * @scenario         :socketpair() of an address family without socket pairs
+ * @apicovered       :socketpair()
+ * @precondition     :
+ * @postcondition    :
+ */
+static void tc_net_socketpair_family_n(void)
+{
+	int sv[2];
+	int ret;
+
+	ret = socketpair(AF_INET, SOCK_STREAM, 0, sv);
+	TC_ASSERT_EQ("socketpair", ret, -1);
+	TC_ASSERT_EQ("socketpair", errno, EAFNOSUPPORT);
+	TC_SUCCESS_RESULT();
+}
+
+/**
+ * @testcase         :tc_net_socketpair_type_n
+ * @brief            :
+ * @scenario         :socketpair() of datagram sockets
+ * @apicovered       :socketpair()
+ * @precondition     :
+ * @postcondition    :
+ */
+static void tc_net_socketpair_type_n(void)
+{
+	int sv[2];
+	int ret;
+
+	ret = socketpair(AF_UNIX, SOCK_DGRAM, 0, sv);
+	TC_ASSERT_EQ("socketpair", ret, -1);
+	TC_ASSERT_EQ("socketpair", errno, EOPNOTSUPP);
+	TC_SUCCESS_RESULT();
+}
+
+/****************************************************************************
+ * Name: socketpair()
+ ****************************************************************************/
+
+int net_socketpair_main(void)
+{
+	tc_net_socketpair_p();
+	tc_net_socketpair_family_n();
+	tc_net_socketpair_type_n();
+
+	return 0;
+}
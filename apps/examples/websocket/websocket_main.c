@@ -319,6 +319,12 @@ RECV_RETRY:
 	if (r == 0) {
 		websocket_set_error(info->data, WEBSOCKET_ERR_CALLBACK_FAILURE);
 	} else if (r < 0) {
+		if ((info->data->tls_enabled && (r == MBEDTLS_ERR_SSL_WANT_READ || r == MBEDTLS_ERR_SSL_WANT_WRITE)) ||
+			(!info->data->tls_enabled && (errno == EAGAIN || errno == EWOULDBLOCK))) {
+			/* A non-blocking socket has nothing to transfer now */
+			websocket_set_error(info->data, WEBSOCKET_ERR_WOULDBLOCK);
+			return -1;
+		}
 		printf("websocket recv_cb err : %d\n", errno);
 		if (retry_cnt == 0) {
 			websocket_set_error(info->data, WEBSOCKET_ERR_CALLBACK_FAILURE);
@@ -348,6 +354,12 @@ SEND_RETRY:
 	}
 
 	if (r < 0) {
+		if ((info->data->tls_enabled && (r == MBEDTLS_ERR_SSL_WANT_READ || r == MBEDTLS_ERR_SSL_WANT_WRITE)) ||
+			(!info->data->tls_enabled && (errno == EAGAIN || errno == EWOULDBLOCK))) {
+			/* A non-blocking socket has nothing to transfer now */
+			websocket_set_error(info->data, WEBSOCKET_ERR_WOULDBLOCK);
+			return -1;
+		}
 		printf("websocket send_cb err : %d\n", errno);
 		if (retry_cnt == 0) {
 			websocket_set_error(info->data, WEBSOCKET_ERR_CALLBACK_FAILURE);
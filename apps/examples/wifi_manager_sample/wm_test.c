@@ -101,6 +101,7 @@ static void wm_sta_disconnected(wifi_manager_disconnect_e);
 static void wm_softap_sta_join(void);
 static void wm_softap_sta_leave(void);
 static void wm_scan_done(wifi_manager_scan_info_s **scan_result, wifi_manager_scan_result_e res);
+static void wm_scan_partial(wifi_manager_scan_info_s **scan_result);
 
 /*
  * Handler
@@ -145,6 +146,7 @@ static wifi_manager_cb_s wifi_callbacks = {
 	wm_softap_sta_join,
 	wm_softap_sta_leave,
 	wm_scan_done,
+	wm_scan_partial,
 };
 
 static sem_t g_wm_sem = SEM_INITIALIZER(0);
@@ -152,6 +154,11 @@ static sem_t g_wm_func_sem = SEM_INITIALIZER(0);
 
 static int g_mode = 0; // check program is running
 
+/* scan timing: when the scan was requested and when its first results came */
+static struct timeval g_scan_start;
+static long g_scan_first_ms = -1;
+static int g_scan_partial_aps = 0;
+
 #define WM_TEST_SIGNAL										\
 	do {													\
 		sem_post(&g_wm_sem);                                \
@@ -477,9 +484,30 @@ void wm_softap_sta_leave(void)
 	WM_TEST_SIGNAL;
 }
 
+static long wm_scan_elapsed_ms(void)
+{
+	struct timeval now;
+	gettimeofday(&now, NULL);
+	return (now.tv_sec - g_scan_start.tv_sec) * 1000 + (now.tv_usec - g_scan_start.tv_usec) / 1000;
+}
+
+void wm_scan_partial(wifi_manager_scan_info_s **scan_result)
+{
+	if (g_scan_first_ms < 0) {
+		g_scan_first_ms = wm_scan_elapsed_ms();
+	}
+	wifi_manager_scan_info_s *wifi_scan_iter = *scan_result;
+	while (wifi_scan_iter != NULL) {
+		g_scan_partial_aps++;
+		wifi_scan_iter = wifi_scan_iter->next;
+	}
+}
+
 void wm_scan_done(wifi_manager_scan_info_s **scan_result, wifi_manager_scan_result_e res)
 {
 	printf("[WT]  T%d --> %s\n", getpid(), __FUNCTION__);
+	printf("[WT] scan done in %ld ms, first partial result in %ld ms (%d APs)\n",
+		   wm_scan_elapsed_ms(), g_scan_first_ms, g_scan_partial_aps);
 	/* Make sure you copy the scan results onto a local data structure.
 	 * It will be deleted soon eventually as you exit this function.
 	 */
@@ -686,6 +714,9 @@ void wm_scan(void *arg)
 	wifi_manager_result_e res = WIFI_MANAGER_SUCCESS;
 
 	struct options *ap_info = (struct options *)arg;
+	g_scan_first_ms = -1;
+	g_scan_partial_aps = 0;
+	gettimeofday(&g_scan_start, NULL);
 	if (ap_info->scan_specific) {
 		wifi_manager_ap_config_s config;
 		config.ssid_length = strlen(ap_info->ssid);
@@ -771,6 +802,10 @@ void wm_get_stats(void *arg)
 		printf("CONN    CONNFAIL    DISCONN    RECONN    SCAN    SOFTAP    JOIN    LEFT\n");
 		printf("%-8d%-12d%-11d%-10d", stats.connect, stats.connectfail, stats.disconnect, stats.reconnect);
 		printf("%-8d%-10d%-8d%-8d\n", stats.scan, stats.softap, stats.joined, stats.left);
+		printf("-----------------------------------------------------------------------\n");
+		printf("last connection: association %u ms%s, DHCP %u ms%s\n",
+			   stats.assoc_time, stats.fast_assoc ? " (cached BSSID)" : "",
+			   stats.dhcp_time, stats.fast_dhcp ? " (cached lease)" : "");
 		printf("=======================================================================\n");
 	}
 	WM_TEST_LOG_END;
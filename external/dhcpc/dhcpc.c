@@ -469,6 +469,7 @@ static void dhcpc_close(void *handle)
 }
 
 static struct dhcpc_state *g_pResult;
+static struct dhcpc_lease g_dhcpc_lease;
 int g_dhcpc_state;
 
 /****************************************************************************
@@ -736,6 +737,9 @@ int dhcp_client_start(const char *intf)
 			return -1;
 		}
 		DHCPC_SET_IP4ADDR(intf, state.ipaddr, state.netmask, state.default_router);
+		g_dhcpc_lease.ipaddr = state.ipaddr;
+		g_dhcpc_lease.serverid = state.serverid;
+		g_dhcpc_lease.lease_time = state.lease_time;
 		ndbg("[DHCPC] IP address : %s ----\n", inet_ntoa(state.ipaddr));
 		dhcpc_close(dhcp_hnd);
 	} else {
@@ -746,12 +750,36 @@ int dhcp_client_start(const char *intf)
 	return OK;
 }
 
+/****************************************************************************
+ * Name: dhcp_client_start_reboot
+ ****************************************************************************/
+int dhcp_client_start_reboot(const char *intf, const struct dhcpc_lease *lease)
+{
+	/* This client has no INIT-REBOOT state, run the full sequence */
+	(void)lease;
+	return dhcp_client_start(intf);
+}
+
+/****************************************************************************
+ * Name: dhcp_client_get_lease
+ ****************************************************************************/
+int dhcp_client_get_lease(const char *intf, struct dhcpc_lease *lease)
+{
+	(void)intf;
+	if (lease == NULL || g_dhcpc_lease.ipaddr.s_addr == INADDR_ANY) {
+		return -1;
+	}
+	*lease = g_dhcpc_lease;
+	return OK;
+}
+
 /****************************************************************************
  * Name: dhcp_client_stop
  ****************************************************************************/
 void dhcp_client_stop(const char *intf)
 {
 	struct in_addr in = { .s_addr = INADDR_NONE };
+	memset(&g_dhcpc_lease, 0, sizeof(g_dhcpc_lease));
 	DHCPC_SET_IP4ADDR(intf, in, in, in);
 	ndbg("[DHCPC] dhcpc_stop -release IP address (app)\n");
 	return;
@@ -135,6 +135,67 @@ int dhcp_client_start(const char *intf)
 	return ret;
 }
 
+/****************************************************************************
+ * Name: dhcp_client_start_reboot
+ ****************************************************************************/
+int dhcp_client_start_reboot(const char *intf, const struct dhcpc_lease *lease)
+{
+	int ret = -1;
+	struct req_lwip_data req;
+
+	int sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sockfd < 0) {
+		ndbg("socket() failed with errno: %d\n", errno);
+		return ret;
+	}
+
+	memset(&req, 0, sizeof(req));
+	req.type = DHCPCREBOOT;
+	req.intf = intf;
+	req.lease = (struct dhcpc_lease *)lease;
+
+	ret = ioctl(sockfd, SIOCLWIP, (unsigned long)&req);
+	if (ret == ERROR) {
+		ndbg("ioctl() failed with errno: %d\n", errno);
+		close(sockfd);
+		return ret;
+	}
+
+	ret = req.req_res;
+	close(sockfd);
+	return ret;
+}
+
+/****************************************************************************
+ * Name: dhcp_client_get_lease
+ ****************************************************************************/
+int dhcp_client_get_lease(const char *intf, struct dhcpc_lease *lease)
+{
+	int ret = -1;
+	struct req_lwip_data req;
+
+	int sockfd = socket(AF_INET, SOCK_DGRAM, 0);
+	if (sockfd < 0) {
+		ndbg("socket() failed with errno: %d\n", errno);
+		return ret;
+	}
+
+	memset(&req, 0, sizeof(req));
+	req.type = DHCPCLEASE;
+	req.intf = intf;
+	req.lease = lease;
+
+	ret = ioctl(sockfd, SIOCLWIP, (unsigned long)&req);
+	if (ret == ERROR) {
+		close(sockfd);
+		return ret;
+	}
+
+	ret = req.req_res;
+	close(sockfd);
+	return ret;
+}
+
 /****************************************************************************
  * Name: dhcp_client_stop
  ****************************************************************************/
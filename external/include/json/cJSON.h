@@ -84,6 +84,8 @@ extern "C"
 
 #define cJSON_IsReference 256
 #define cJSON_StringIsConst 512
+#define cJSON_ValueStringIsConst 1024 /* valuestring is not owned by the item (in-situ or arena parse) */
+#define cJSON_ItemInArena 2048 /* the item itself is owned by a cJSON_Arena */
 
 /* The cJSON structure: */
 typedef struct cJSON
@@ -116,6 +118,9 @@ typedef struct cJSON_Hooks
 
 typedef int cJSON_bool;
 
+/* Bump allocator for the items and strings of parsed documents, freed all at once */
+typedef struct cJSON_Arena cJSON_Arena;
+
 #if !defined(__WINDOWS__) && (defined(WIN32) || defined(WIN64) || defined(_MSC_VER) || defined(_WIN32))
 #define __WINDOWS__
 #endif
@@ -165,6 +170,11 @@ then using the CJSON_API_VISIBILITY flag to "export" the same symbols the way CJ
 #define CJSON_NESTING_LIMIT 1000
 #endif
 
+/* Default size of the chunks of a cJSON_Arena */
+#ifndef CJSON_ARENA_CHUNK_SIZE
+#define CJSON_ARENA_CHUNK_SIZE 1024
+#endif
+
 /* returns the version of cJSON as a string */
 CJSON_PUBLIC(const char*) cJSON_Version(void);
 
@@ -178,6 +188,23 @@ CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value);
 /* If you supply a ptr in return_parse_end and parsing fails, then return_parse_end will contain a pointer to the error. If not, then cJSON_GetErrorPtr() does the job. */
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 
+/* In-situ parsing: the strings are unescaped inside the (mutable) input buffer and the valuestring/string of the
+ * returned items point into it, so no string is allocated. The buffer is modified and must outlive the returned tree.
+ * The tree is still released with cJSON_Delete, which then frees only the items. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSitu(char *value);
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSituWithOpts(char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
+
+/* Arena parsing: the items (and the strings, unless parsed in-situ) are carved out of big chunks owned by the arena
+ * instead of being allocated one by one. The trees parsed into an arena are released all at once by cJSON_ResetArena
+ * or cJSON_DeleteArena; calling cJSON_Delete on them is harmless but frees nothing but items added later.
+ * chunk_size is the size of the chunks allocated with the cJSON_Hooks, 0 selects CJSON_ARENA_CHUNK_SIZE. */
+CJSON_PUBLIC(cJSON_Arena *) cJSON_CreateArena(size_t chunk_size);
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithArena(cJSON_Arena *arena, const char *value);
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSituWithArena(cJSON_Arena *arena, char *value);
+/* Release every tree parsed into the arena, keeping one chunk for the next parse. */
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena *arena);
+CJSON_PUBLIC(void) cJSON_DeleteArena(cJSON_Arena *arena);
+
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
 /* Render a cJSON entity to text for transfer/storage without any formatting. */
@@ -0,0 +1,104 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * external/include/json/cJSON_SAX.h
+ *
+ * Incremental (SAX style) JSON parser. The document is fed chunk by chunk,
+ * e.g. as it arrives from a socket, and reported through callbacks without
+ * building a tree, so the memory used is the parser state and one token
+ * buffer whatever the size of the document.
+ *
+ ****************************************************************************/
+
+#ifndef __EXTERNAL_INCLUDE_JSON_CJSON_SAX_H
+#define __EXTERNAL_INCLUDE_JSON_CJSON_SAX_H
+
+#ifdef __cplusplus
+// *INDENT-OFF*
+extern "C"
+{
+// *INDENT-ON*
+#endif
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <json/cJSON.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Events of the parser, any of them may be NULL. Returning false aborts the parse.
+ * The key and string values are unescaped and NUL terminated, length doesn't count the terminator.
+ * They live in the token buffer and are only valid during the call. */
+typedef struct cJSON_SAX_Callbacks
+{
+    cJSON_bool (*start_object)(void *user_data);
+    cJSON_bool (*end_object)(void *user_data);
+    cJSON_bool (*start_array)(void *user_data);
+    cJSON_bool (*end_array)(void *user_data);
+    cJSON_bool (*key)(void *user_data, const char *key, size_t length);
+    cJSON_bool (*string)(void *user_data, const char *value, size_t length);
+    cJSON_bool (*number)(void *user_data, double value);
+    cJSON_bool (*boolean)(void *user_data, cJSON_bool value);
+    cJSON_bool (*null)(void *user_data);
+} cJSON_SAX_Callbacks;
+
+/* Parser state, may live on the stack. The members are private. */
+typedef struct cJSON_SAX
+{
+    const cJSON_SAX_Callbacks *callbacks;
+    void *user_data;
+    char *token; /* keys, strings and numbers are collected here */
+    size_t token_size;
+    size_t token_length;
+    size_t offset; /* bytes consumed so far, the position of the error after a failure */
+    size_t depth;
+    const char *literal; /* true, false or null being matched */
+    unsigned int codepoint; /* \u escape being decoded */
+    unsigned int high_surrogate;
+    unsigned char hex_digits;
+    unsigned char literal_index;
+    unsigned char is_key;
+    unsigned char state;
+    unsigned char containers[(CJSON_NESTING_LIMIT + 7) / 8]; /* bit set for an object, clear for an array */
+} cJSON_SAX;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* Prepare sax to parse one JSON value. token_buffer holds the longest key, string or number
+ * (plus the terminator) of the document, a longer one fails the parse. */
+CJSON_PUBLIC(void) cJSON_SAX_Init(cJSON_SAX *sax, const cJSON_SAX_Callbacks *callbacks, void *user_data, char *token_buffer, size_t token_buffer_size);
+/* Parse the next length bytes of the document. Returns false on a syntax error, a too long token
+ * or an aborting callback, after which every call fails. The chunk may be released after the call. */
+CJSON_PUBLIC(cJSON_bool) cJSON_SAX_Feed(cJSON_SAX *sax, const char *chunk, size_t length);
+/* Signal the end of the document. Returns true if exactly one complete value was parsed. */
+CJSON_PUBLIC(cJSON_bool) cJSON_SAX_Finish(cJSON_SAX *sax);
+/* Offset of the byte that failed the parse (or the number of bytes parsed so far). */
+CJSON_PUBLIC(size_t) cJSON_SAX_GetOffset(const cJSON_SAX *sax);
+
+#ifdef __cplusplus
+// *INDENT-OFF*
+}
+// *INDENT-ON*
+#endif
+#endif							/* __EXTERNAL_INCLUDE_JSON_CJSON_SAX_H */
@@ -79,6 +79,16 @@
 /****************************************************************************
  * Public Types
  ****************************************************************************/
+
+/**
+ * @brief Lease obtained by the DHCP client, kept to rejoin the same network
+ *	with INIT-REBOOT instead of a full DISCOVER
+ */
+struct dhcpc_lease {
+	struct in_addr ipaddr;		/* Leased address */
+	struct in_addr serverid;	/* Server that granted the lease */
+	uint32_t lease_time;		/* Lease duration in seconds */
+};
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -107,6 +117,28 @@ int dhcp_client_start(const char *intf);
  */
 void dhcp_client_stop(const char *intf);
 
+/**
+ * @brief Starts DHCP client by requesting a previously leased address
+ *	(INIT-REBOOT). If the server refuses it or does not answer, the client
+ *	falls back to the full DISCOVER sequence.
+ *
+ * @param[in] intf name of interface to run dhcpc
+ * @param[in] lease lease obtained on the previous connection
+ * @return On success, 0. On failure, returns negative
+ * @since TizenRT v3.1
+ */
+int dhcp_client_start_reboot(const char *intf, const struct dhcpc_lease *lease);
+
+/**
+ * @brief Get the lease currently bound by the DHCP client
+ *
+ * @param[in] intf name of interface running dhcpc
+ * @param[out] lease current lease
+ * @return On success, 0. On failure, returns negative
+ * @since TizenRT v3.1
+ */
+int dhcp_client_get_lease(const char *intf, struct dhcpc_lease *lease);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
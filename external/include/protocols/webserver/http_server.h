@@ -109,6 +109,24 @@
 #define HTTP_CONF_MAX_QUERY_HANDLER_COUNT       64
 #define HTTP_CONF_MAX_ENTITY_LENGTH             2048
 
+#if defined(CONFIG_NETUTILS_WEBSERVER_KEEPALIVE_TIMEOUT_MSEC)
+#define HTTP_CONF_KEEPALIVE_TIMEOUT_MSEC        (CONFIG_NETUTILS_WEBSERVER_KEEPALIVE_TIMEOUT_MSEC)
+#else
+#define HTTP_CONF_KEEPALIVE_TIMEOUT_MSEC        2000
+#endif
+
+#if defined(CONFIG_NETUTILS_WEBSERVER_KEEPALIVE_MAX_REQUESTS)
+#define HTTP_CONF_KEEPALIVE_MAX_REQUESTS        (CONFIG_NETUTILS_WEBSERVER_KEEPALIVE_MAX_REQUESTS)
+#else
+#define HTTP_CONF_KEEPALIVE_MAX_REQUESTS        100
+#endif
+
+#if defined(CONFIG_NETUTILS_WEBSERVER_FILE_BUFFER_SIZE)
+#define HTTP_CONF_FILE_BUFFER_SIZE              (CONFIG_NETUTILS_WEBSERVER_FILE_BUFFER_SIZE)
+#else
+#define HTTP_CONF_FILE_BUFFER_SIZE              2048
+#endif
+
 #define HTTP_ERROR_400            "Bad Request"
 #define HTTP_ERROR_404            "Not Found"
 #define HTTP_ERROR_500            "Internal Server Error"
@@ -294,6 +312,50 @@ int http_server_deregister_cb(struct http_server_t *server, int method, const ch
  */
 int http_send_response(struct http_client_t *client, int status, const char *body, struct http_keyvalue_list_t *headers);
 
+/**
+ * @brief http_send_chunked_header() starts a response whose length is not known ahead.
+ *        The entity is sent by http_send_chunk() in chunked transfer encoding.
+ *        For an HTTP/1.0 client, the entity is sent as it is and the
+ *        connection is closed after the response.
+ *
+ * @param[in] client a pointer of HTTP client.
+ * @param[in] status status code of a response.
+ * @param[in] headers HTTP headers of a response, NULL for none.
+ * @return On success, HTTP_OK(0) is returned.
+ *         On failure, HTTP_ERROR(-1) is returned.
+ * @since TizenRT v3.1
+ */
+int http_send_chunked_header(struct http_client_t *client, int status, struct http_keyvalue_list_t *headers);
+
+/**
+ * @brief http_send_chunk() sends a part of the entity started by http_send_chunked_header().
+ *
+ * @param[in] client a pointer of HTTP client.
+ * @param[in] data data of the part.
+ * @param[in] len length of the data, 0 finishes the response.
+ * @return On success, HTTP_OK(0) is returned.
+ *         On failure, HTTP_ERROR(-1) is returned.
+ * @since TizenRT v3.1
+ */
+int http_send_chunk(struct http_client_t *client, const char *data, int len);
+
+/**
+ * @brief http_send_file() sends a file as the response of a GET request.
+ *        The file is sent with an ETag made from its size and modification
+ *        time, and 304 Not Modified is sent instead if the request has
+ *        a matching If-None-Match header. 404 is sent if the file can't be
+ *        opened.
+ *
+ * @param[in] client a pointer of HTTP client.
+ * @param[in] req the request, NULL to skip the If-None-Match check.
+ * @param[in] path path of the file.
+ * @param[in] content_type Content-Type of the file, NULL for application/octet-stream.
+ * @return On success, HTTP_OK(0) is returned.
+ *         On failure, HTTP_ERROR(-1) is returned.
+ * @since TizenRT v3.1
+ */
+int http_send_file(struct http_client_t *client, struct http_req_message *req, const char *path, const char *content_type);
+
 #ifdef CONFIG_NET_SECURITY_TLS
 /**
  * @brief http_tls_init() initializes the TLS configuere for webserver.
@@ -141,7 +141,24 @@
 /**
  * @brief The maximum amount of client to be accepted in server.
  */
+#ifdef CONFIG_NETUTILS_WEBSOCKET_MAX_CLIENT
+#define WEBSOCKET_MAX_CLIENT                         CONFIG_NETUTILS_WEBSOCKET_MAX_CLIENT
+#else
 #define WEBSOCKET_MAX_CLIENT                         (3)
+#endif
+
+/**
+ * @brief The maximum length of messages waiting to be sent in a multiplexed session.
+ *
+ *        The session isn't read until the queue drains below it, and
+ *        websocket_queue_msg() from other threads than the callbacks fails
+ *        with WEBSOCKET_QUEUE_FULL_ERROR beyond it.
+ */
+#ifdef CONFIG_NETUTILS_WEBSOCKET_SEND_QUEUE_SIZE
+#define WEBSOCKET_SEND_QUEUE_SIZE                    CONFIG_NETUTILS_WEBSOCKET_SEND_QUEUE_SIZE
+#else
+#define WEBSOCKET_SEND_QUEUE_SIZE                    (4096)
+#endif
 
 /**
  * @brief The maximun retry of tls handshake.
@@ -302,7 +319,8 @@ typedef enum {
 	WEBSOCKET_SEND_ERROR,		///< message sending fail
 	WEBSOCKET_RECEIVE_ERROR,	///< message reading fail
 	WEBSOCKET_TLS_INIT_ERROR,	///< TLS context init fail
-	WEBSOCKET_TLS_HANDSHAKE_ERROR	///< TLS handshake fail
+	WEBSOCKET_TLS_HANDSHAKE_ERROR,	///< TLS handshake fail
+	WEBSOCKET_QUEUE_FULL_ERROR	///< send queue is full
 } websocket_return_t;
 
 /**
@@ -473,7 +491,11 @@ websocket_return_t websocket_server_open(websocket_t *server);
  * @brief websocket_server_init
  *
  *        This function start message handling loop.\n
- *        It initiates websocket context structure and select() fd to handle the messages.
+ *        It initiates websocket context structure and select() fd to handle the messages.\n
+ *        With CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX, the session is handed over to the
+ *        thread which poll()s all the server sessions, and this function returns at once.
+ *        The socket is then non-blocking, so the recv and send callbacks should call
+ *        websocket_set_error() with WEBSOCKET_ERR_WOULDBLOCK when no data can be transferred.
  * @param[in] server websocket structure manages file descriptor, websocket context and TLS context.
  *               users must give a pointer of websocket callback structure in websocket_t *server
  * @return On success, return WEBSOCKET_SUCCESS. On failure, return values defined in websocket_return_t.
@@ -499,7 +521,9 @@ websocket_return_t websocket_register_cb(websocket_t *websocket, websocket_cb_t
  *        Websocket has a event handler thread and it keeps watching the queue to send or recv events.
  * @param[in] ctx message queue is in websocket context
  * @param[in] frame message frame to be sent
- * @return On success return WEBSOCKET_SUCCESS, On failure return values defined in websocket_return_t
+ * @return On success return WEBSOCKET_SUCCESS, On failure return values defined in websocket_return_t.
+ *         A multiplexed session returns WEBSOCKET_QUEUE_FULL_ERROR when WEBSOCKET_SEND_QUEUE_SIZE would be exceeded,
+ *         unless it's called from the websocket callbacks.
  * @since TizenRT v1.0
  */
 websocket_return_t websocket_queue_msg(websocket_t *websocket, websocket_frame_t *tx_frame);
@@ -202,7 +202,7 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
         {
             cJSON_Delete(item->child);
         }
-        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
+        if (!(item->type & (cJSON_IsReference | cJSON_ValueStringIsConst)) && (item->valuestring != NULL))
         {
             global_hooks.deallocate(item->valuestring);
         }
@@ -210,7 +210,10 @@ CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
         {
             global_hooks.deallocate(item->string);
         }
-        global_hooks.deallocate(item);
+        if (!(item->type & cJSON_ItemInArena))
+        {
+            global_hooks.deallocate(item);
+        }
         item = next;
     }
 }
@@ -223,6 +226,9 @@ typedef struct
     size_t offset;
     size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
     internal_hooks hooks;
+    unsigned char *insitu; /* writable alias of content when parsing in-situ, NULL otherwise */
+    cJSON_Arena *arena; /* allocate the items and strings from this arena instead of the hooks */
+    int item_flags; /* ownership flags of every parsed item */
 } parse_buffer;
 
 /* check if the given size is left to read in a given parse buffer (starting with 1) */
@@ -234,6 +240,130 @@ typedef struct
 /* get a pointer to the buffer at the position */
 #define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
 
+/* The arena is a list of chunks, the newest first, which are only ever bumped */
+typedef struct arena_chunk
+{
+    struct arena_chunk *next;
+    size_t size;
+    size_t used;
+} arena_chunk;
+
+struct cJSON_Arena
+{
+    arena_chunk *chunks;
+    size_t chunk_size;
+};
+
+/* alignment of the items carved out of the arena, enough for the double in cJSON */
+#define ARENA_ALIGNMENT 8
+#define arena_align(size, alignment) (((size) + (alignment) - 1) & ~((size_t)(alignment) - 1))
+#define arena_chunk_data(chunk) ((unsigned char*)(chunk) + arena_align(sizeof(arena_chunk), ARENA_ALIGNMENT))
+
+static void *arena_allocate(cJSON_Arena * const arena, size_t size, size_t alignment)
+{
+    arena_chunk *chunk = arena->chunks;
+    size_t offset = 0;
+
+    if (chunk != NULL)
+    {
+        offset = arena_align(chunk->used, alignment);
+    }
+
+    if ((chunk == NULL) || (offset > chunk->size) || ((chunk->size - offset) < size))
+    {
+        /* start a new chunk, an oversized request gets a chunk of its own */
+        size_t chunk_size = (size > arena->chunk_size) ? size : arena->chunk_size;
+        chunk = (arena_chunk*)global_hooks.allocate(arena_align(sizeof(arena_chunk), ARENA_ALIGNMENT) + chunk_size);
+        if (chunk == NULL)
+        {
+            return NULL;
+        }
+        chunk->size = chunk_size;
+        chunk->used = 0;
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+        offset = 0;
+    }
+
+    chunk->used = offset + size;
+
+    return arena_chunk_data(chunk) + offset;
+}
+
+CJSON_PUBLIC(cJSON_Arena *) cJSON_CreateArena(size_t chunk_size)
+{
+    cJSON_Arena *arena = (cJSON_Arena*)global_hooks.allocate(sizeof(cJSON_Arena));
+    if (arena != NULL)
+    {
+        arena->chunks = NULL;
+        arena->chunk_size = (chunk_size > 0) ? chunk_size : CJSON_ARENA_CHUNK_SIZE;
+    }
+
+    return arena;
+}
+
+CJSON_PUBLIC(void) cJSON_ResetArena(cJSON_Arena *arena)
+{
+    arena_chunk *chunk = NULL;
+
+    if ((arena == NULL) || (arena->chunks == NULL))
+    {
+        return;
+    }
+
+    /* keep the newest chunk so that parsing documents of similar size in a loop doesn't allocate */
+    chunk = arena->chunks->next;
+    while (chunk != NULL)
+    {
+        arena_chunk *next = chunk->next;
+        global_hooks.deallocate(chunk);
+        chunk = next;
+    }
+    arena->chunks->next = NULL;
+    arena->chunks->used = 0;
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteArena(cJSON_Arena *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    cJSON_ResetArena(arena);
+    if (arena->chunks != NULL)
+    {
+        global_hooks.deallocate(arena->chunks);
+    }
+    global_hooks.deallocate(arena);
+}
+
+/* allocate an item for the parser, marked with the ownership flags of the parse mode */
+static cJSON *parse_new_item(parse_buffer * const input_buffer)
+{
+    cJSON *node = NULL;
+
+    if (input_buffer->arena != NULL)
+    {
+        node = (cJSON*)arena_allocate(input_buffer->arena, sizeof(cJSON), ARENA_ALIGNMENT);
+        if (node != NULL)
+        {
+            memset(node, '\0', sizeof(cJSON));
+        }
+    }
+    else
+    {
+        node = cJSON_New_Item(&(input_buffer->hooks));
+    }
+
+    if (node != NULL)
+    {
+        node->type = input_buffer->item_flags;
+    }
+
+    return node;
+}
+
 /* Parse the input text to generate a number, and populate the result into item. */
 static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
 {
@@ -706,7 +836,24 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
 
         /* This is at most how much we need for the output */
         allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+        if (input_buffer->insitu != NULL)
+        {
+            /* unescape in place, the output never gets ahead of the input and ends at the latest on the closing quote */
+            output = input_buffer->insitu + (input_pointer - input_buffer->content);
+            if (skipped_bytes == 0)
+            {
+                output[input_end - input_pointer] = '\0';
+                goto success;
+            }
+        }
+        else if (input_buffer->arena != NULL)
+        {
+            output = (unsigned char*)arena_allocate(input_buffer->arena, allocation_length + sizeof(""), 1);
+        }
+        else
+        {
+            output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+        }
         if (output == NULL)
         {
             goto fail; /* allocation failure */
@@ -773,6 +920,7 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     /* zero terminate the output */
     *output_pointer = '\0';
 
+success:
     item->type = cJSON_String;
     item->valuestring = (char*)output;
 
@@ -782,7 +930,7 @@ static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_bu
     return true;
 
 fail:
-    if (output != NULL)
+    if ((output != NULL) && (input_buffer->insitu == NULL) && (input_buffer->arena == NULL))
     {
         input_buffer->hooks.deallocate(output);
     }
@@ -952,10 +1100,10 @@ static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
     return buffer;
 }
 
-/* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+/* Parse an object - create a new root, and populate. insitu is the writable value when parsing in-situ. */
+static cJSON *parse_document(const char *value, unsigned char *insitu, cJSON_Arena *arena, const char **return_parse_end, cJSON_bool require_null_terminated)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, 0, 0, 0 };
     cJSON *item = NULL;
 
     /* reset error position */
@@ -971,8 +1119,18 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return
     buffer.length = strlen((const char*)value) + sizeof("");
     buffer.offset = 0;
     buffer.hooks = global_hooks;
+    buffer.insitu = insitu;
+    buffer.arena = arena;
+    if ((insitu != NULL) || (arena != NULL))
+    {
+        buffer.item_flags = cJSON_StringIsConst | cJSON_ValueStringIsConst;
+    }
+    if (arena != NULL)
+    {
+        buffer.item_flags |= cJSON_ItemInArena;
+    }
 
-    item = cJSON_New_Item(&global_hooks);
+    item = parse_new_item(&buffer);
     if (item == NULL) /* memory fail */
     {
         goto fail;
@@ -983,6 +1141,7 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return
         /* parse failure. ep is set. */
         goto fail;
     }
+    item->type |= buffer.item_flags;
 
     /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
     if (require_null_terminated)
@@ -1034,12 +1193,47 @@ fail:
     return NULL;
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    return parse_document(value, NULL, NULL, return_parse_end, require_null_terminated);
+}
+
 /* Default options for cJSON_Parse */
 CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
 {
     return cJSON_ParseWithOpts(value, 0, 0);
 }
 
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSituWithOpts(char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    return parse_document(value, (unsigned char*)value, NULL, return_parse_end, require_null_terminated);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSitu(char *value)
+{
+    return cJSON_ParseInSituWithOpts(value, 0, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithArena(cJSON_Arena *arena, const char *value)
+{
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    return parse_document(value, NULL, arena, 0, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseInSituWithArena(cJSON_Arena *arena, char *value)
+{
+    if (arena == NULL)
+    {
+        return NULL;
+    }
+
+    return parse_document(value, (unsigned char*)value, arena, 0, 0);
+}
+
 #define cjson_min(a, b) ((a < b) ? a : b)
 
 static unsigned char *print(const cJSON * const item, cJSON_bool format, const internal_hooks * const hooks)
@@ -1337,7 +1531,7 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
     do
     {
         /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
+        cJSON *new_item = parse_new_item(input_buffer);
         if (new_item == NULL)
         {
             goto fail; /* allocation failure */
@@ -1364,6 +1558,7 @@ static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buf
         {
             goto fail; /* failed to parse value */
         }
+        current_item->type |= input_buffer->item_flags;
         buffer_skip_whitespace(input_buffer);
     }
     while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
@@ -1491,7 +1686,7 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
     do
     {
         /* allocate next item */
-        cJSON *new_item = cJSON_New_Item(&(input_buffer->hooks));
+        cJSON *new_item = parse_new_item(input_buffer);
         if (new_item == NULL)
         {
             goto fail; /* allocation failure */
@@ -1523,6 +1718,7 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         /* swap valuestring and string, because we parsed the name */
         current_item->string = current_item->valuestring;
         current_item->valuestring = NULL;
+        current_item->type = input_buffer->item_flags;
 
         if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
         {
@@ -1536,6 +1732,7 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         {
             goto fail; /* failed to parse value */
         }
+        current_item->type |= input_buffer->item_flags;
         buffer_skip_whitespace(input_buffer);
     }
     while (can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == ','));
@@ -2357,8 +2554,8 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
     {
         goto fail;
     }
-    /* Copy over all vars */
-    newitem->type = item->type & (~cJSON_IsReference);
+    /* Copy over all vars, the copy owns its memory and strings (except a constant key) */
+    newitem->type = item->type & (~(cJSON_IsReference | cJSON_ValueStringIsConst | cJSON_ItemInArena));
     newitem->valueint = item->valueint;
     newitem->valuedouble = item->valuedouble;
     if (item->valuestring)
@@ -2371,7 +2568,16 @@ CJSON_PUBLIC(cJSON *) cJSON_Duplicate(const cJSON *item, cJSON_bool recurse)
     }
     if (item->string)
     {
-        newitem->string = (item->type&cJSON_StringIsConst) ? item->string : (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
+        /* the key of a parsed in-situ or arena item is only borrowed, not constant */
+        if ((item->type & cJSON_StringIsConst) && !(item->type & cJSON_ValueStringIsConst))
+        {
+            newitem->string = item->string;
+        }
+        else
+        {
+            newitem->string = (char*)cJSON_strdup((unsigned char*)item->string, &global_hooks);
+            newitem->type &= ~cJSON_StringIsConst;
+        }
         if (!newitem->string)
         {
             goto fail;
@@ -0,0 +1,484 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * external/json/cJSON_SAX.c
+ *
+ * Byte at a time state machine, so that a token may be split anywhere
+ * between two chunks. Only the current key, string or number is buffered.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+
+#include <json/cJSON_SAX.h>
+
+/* parser states */
+enum
+{
+    sax_value,          /* expecting a value */
+    sax_value_or_end,   /* after '[', expecting a value or ']' */
+    sax_key,            /* after ',' in an object, expecting a key */
+    sax_key_or_end,     /* after '{', expecting a key or '}' */
+    sax_colon,          /* after a key */
+    sax_comma_or_end,   /* after a value inside an array or object */
+    sax_string,         /* inside a key or string */
+    sax_escape,         /* after '\' in a string */
+    sax_unicode,        /* inside the hex digits of \uXXXX */
+    sax_surrogate_escape, /* expecting the '\' of the low surrogate */
+    sax_surrogate_u,    /* expecting the 'u' of the low surrogate */
+    sax_number,
+    sax_literal,        /* inside true, false or null */
+    sax_done,           /* the top level value is complete */
+    sax_error
+};
+
+#define sax_is_whitespace(c) (((c) == ' ') || ((c) == '\t') || ((c) == '\n') || ((c) == '\r'))
+#define sax_in_object(sax) ((sax)->containers[((sax)->depth - 1) / 8] & (1 << (((sax)->depth - 1) % 8)))
+
+static cJSON_bool sax_append(cJSON_SAX * const sax, unsigned char c)
+{
+    /* keep room for the terminator */
+    if ((sax->token_length + 1) >= sax->token_size)
+    {
+        return false;
+    }
+    sax->token[sax->token_length++] = (char)c;
+
+    return true;
+}
+
+static cJSON_bool sax_append_utf8(cJSON_SAX * const sax, unsigned int codepoint)
+{
+    if (codepoint < 0x80)
+    {
+        return sax_append(sax, (unsigned char)codepoint);
+    }
+    if (codepoint < 0x800)
+    {
+        return sax_append(sax, (unsigned char)(0xC0 | (codepoint >> 6)))
+            && sax_append(sax, (unsigned char)(0x80 | (codepoint & 0x3F)));
+    }
+    if (codepoint < 0x10000)
+    {
+        return sax_append(sax, (unsigned char)(0xE0 | (codepoint >> 12)))
+            && sax_append(sax, (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F)))
+            && sax_append(sax, (unsigned char)(0x80 | (codepoint & 0x3F)));
+    }
+
+    return sax_append(sax, (unsigned char)(0xF0 | (codepoint >> 18)))
+        && sax_append(sax, (unsigned char)(0x80 | ((codepoint >> 12) & 0x3F)))
+        && sax_append(sax, (unsigned char)(0x80 | ((codepoint >> 6) & 0x3F)))
+        && sax_append(sax, (unsigned char)(0x80 | (codepoint & 0x3F)));
+}
+
+/* a value was completed, continue in the enclosing container */
+static void sax_value_done(cJSON_SAX * const sax)
+{
+    sax->state = (sax->depth == 0) ? sax_done : sax_comma_or_end;
+}
+
+static cJSON_bool sax_push(cJSON_SAX * const sax, cJSON_bool object)
+{
+    const cJSON_SAX_Callbacks *callbacks = sax->callbacks;
+
+    if (sax->depth >= CJSON_NESTING_LIMIT)
+    {
+        return false; /* too deeply nested */
+    }
+    sax->depth++;
+
+    if (object)
+    {
+        sax->containers[(sax->depth - 1) / 8] |= (unsigned char)(1 << ((sax->depth - 1) % 8));
+        sax->state = sax_key_or_end;
+        return (callbacks->start_object == NULL) || callbacks->start_object(sax->user_data);
+    }
+
+    sax->containers[(sax->depth - 1) / 8] &= (unsigned char)~(1 << ((sax->depth - 1) % 8));
+    sax->state = sax_value_or_end;
+    return (callbacks->start_array == NULL) || callbacks->start_array(sax->user_data);
+}
+
+/* close the innermost container if c ends it */
+static cJSON_bool sax_pop(cJSON_SAX * const sax, unsigned char c)
+{
+    const cJSON_SAX_Callbacks *callbacks = sax->callbacks;
+    cJSON_bool object = sax_in_object(sax) ? true : false;
+
+    if (c != (object ? '}' : ']'))
+    {
+        return false;
+    }
+
+    sax->depth--;
+    sax_value_done(sax);
+    if (object)
+    {
+        return (callbacks->end_object == NULL) || callbacks->end_object(sax->user_data);
+    }
+
+    return (callbacks->end_array == NULL) || callbacks->end_array(sax->user_data);
+}
+
+static cJSON_bool sax_string_done(cJSON_SAX * const sax)
+{
+    const cJSON_SAX_Callbacks *callbacks = sax->callbacks;
+
+    sax->token[sax->token_length] = '\0';
+    if (sax->is_key)
+    {
+        sax->state = sax_colon;
+        return (callbacks->key == NULL) || callbacks->key(sax->user_data, sax->token, sax->token_length);
+    }
+
+    sax_value_done(sax);
+    return (callbacks->string == NULL) || callbacks->string(sax->user_data, sax->token, sax->token_length);
+}
+
+static cJSON_bool sax_number_done(cJSON_SAX * const sax)
+{
+    char *after_end = NULL;
+    double number = 0;
+
+    sax->token[sax->token_length] = '\0';
+    number = strtod(sax->token, &after_end);
+    if ((after_end == sax->token) || (*after_end != '\0'))
+    {
+        return false; /* parse_error */
+    }
+
+    sax_value_done(sax);
+    return (sax->callbacks->number == NULL) || sax->callbacks->number(sax->user_data, number);
+}
+
+static cJSON_bool sax_literal_done(cJSON_SAX * const sax)
+{
+    const cJSON_SAX_Callbacks *callbacks = sax->callbacks;
+
+    sax_value_done(sax);
+    if (sax->literal[0] == 'n')
+    {
+        return (callbacks->null == NULL) || callbacks->null(sax->user_data);
+    }
+
+    return (callbacks->boolean == NULL) || callbacks->boolean(sax->user_data, (sax->literal[0] == 't') ? true : false);
+}
+
+/* start a value with its first character */
+static cJSON_bool sax_start_value(cJSON_SAX * const sax, unsigned char c)
+{
+    switch (c)
+    {
+        case '{':
+            return sax_push(sax, true);
+
+        case '[':
+            return sax_push(sax, false);
+
+        case '\"':
+            sax->token_length = 0;
+            sax->is_key = false;
+            sax->state = sax_string;
+            return true;
+
+        case 't':
+            sax->literal = "true";
+            break;
+
+        case 'f':
+            sax->literal = "false";
+            break;
+
+        case 'n':
+            sax->literal = "null";
+            break;
+
+        default:
+            if ((c == '-') || ((c >= '0') && (c <= '9')))
+            {
+                sax->token_length = 0;
+                sax->state = sax_number;
+                return sax_append(sax, c);
+            }
+            return false;
+    }
+
+    sax->literal_index = 1;
+    sax->state = sax_literal;
+    return true;
+}
+
+/* Process one byte, consumed is cleared when the byte has to be seen again in the next state. */
+static cJSON_bool sax_parse_byte(cJSON_SAX * const sax, unsigned char c, cJSON_bool * const consumed)
+{
+    unsigned int digit = 0;
+
+    switch (sax->state)
+    {
+        case sax_value_or_end:
+            if (c == ']')
+            {
+                return sax_pop(sax, c);
+            }
+            /* fall through */
+        case sax_value:
+            if (sax_is_whitespace(c))
+            {
+                return true;
+            }
+            return sax_start_value(sax, c);
+
+        case sax_key_or_end:
+            if (c == '}')
+            {
+                return sax_pop(sax, c);
+            }
+            /* fall through */
+        case sax_key:
+            if (sax_is_whitespace(c))
+            {
+                return true;
+            }
+            if (c != '\"')
+            {
+                return false;
+            }
+            sax->token_length = 0;
+            sax->is_key = true;
+            sax->state = sax_string;
+            return true;
+
+        case sax_colon:
+            if (sax_is_whitespace(c))
+            {
+                return true;
+            }
+            if (c != ':')
+            {
+                return false;
+            }
+            sax->state = sax_value;
+            return true;
+
+        case sax_comma_or_end:
+            if (sax_is_whitespace(c))
+            {
+                return true;
+            }
+            if (c == ',')
+            {
+                sax->state = sax_in_object(sax) ? sax_key : sax_value;
+                return true;
+            }
+            return sax_pop(sax, c);
+
+        case sax_string:
+            if (c == '\"')
+            {
+                return sax_string_done(sax);
+            }
+            if (c == '\\')
+            {
+                sax->state = sax_escape;
+                return true;
+            }
+            return sax_append(sax, c);
+
+        case sax_escape:
+            sax->state = sax_string;
+            switch (c)
+            {
+                case 'b':
+                    return sax_append(sax, '\b');
+                case 'f':
+                    return sax_append(sax, '\f');
+                case 'n':
+                    return sax_append(sax, '\n');
+                case 'r':
+                    return sax_append(sax, '\r');
+                case 't':
+                    return sax_append(sax, '\t');
+                case '\"':
+                case '\\':
+                case '/':
+                    return sax_append(sax, c);
+                case 'u':
+                    sax->codepoint = 0;
+                    sax->hex_digits = 0;
+                    sax->state = sax_unicode;
+                    return true;
+                default:
+                    return false;
+            }
+
+        case sax_unicode:
+            if ((c >= '0') && (c <= '9'))
+            {
+                digit = (unsigned int)(c - '0');
+            }
+            else if ((c >= 'a') && (c <= 'f'))
+            {
+                digit = (unsigned int)(c - 'a' + 10);
+            }
+            else if ((c >= 'A') && (c <= 'F'))
+            {
+                digit = (unsigned int)(c - 'A' + 10);
+            }
+            else
+            {
+                return false;
+            }
+            sax->codepoint = (sax->codepoint << 4) | digit;
+            if (++sax->hex_digits < 4)
+            {
+                return true;
+            }
+
+            if (sax->high_surrogate != 0)
+            {
+                /* second half of a UTF-16 surrogate pair */
+                if ((sax->codepoint < 0xDC00) || (sax->codepoint > 0xDFFF))
+                {
+                    return false;
+                }
+                sax->codepoint = 0x10000 + (((sax->high_surrogate & 0x3FF) << 10) | (sax->codepoint & 0x3FF));
+                sax->high_surrogate = 0;
+            }
+            else if ((sax->codepoint >= 0xD800) && (sax->codepoint <= 0xDBFF))
+            {
+                sax->high_surrogate = sax->codepoint;
+                sax->state = sax_surrogate_escape;
+                return true;
+            }
+            else if ((sax->codepoint >= 0xDC00) && (sax->codepoint <= 0xDFFF))
+            {
+                return false; /* low surrogate without high surrogate */
+            }
+            sax->state = sax_string;
+            return sax_append_utf8(sax, sax->codepoint);
+
+        case sax_surrogate_escape:
+            sax->state = sax_surrogate_u;
+            return (c == '\\');
+
+        case sax_surrogate_u:
+            sax->codepoint = 0;
+            sax->hex_digits = 0;
+            sax->state = sax_unicode;
+            return (c == 'u');
+
+        case sax_number:
+            if (((c >= '0') && (c <= '9')) || (c == '+') || (c == '-') || (c == '.') || (c == 'e') || (c == 'E'))
+            {
+                return sax_append(sax, c);
+            }
+            /* the number ends before c, which belongs to the next state */
+            *consumed = false;
+            return sax_number_done(sax);
+
+        case sax_literal:
+            if (c != (unsigned char)sax->literal[sax->literal_index])
+            {
+                return false;
+            }
+            if (sax->literal[++sax->literal_index] == '\0')
+            {
+                return sax_literal_done(sax);
+            }
+            return true;
+
+        case sax_done:
+            return sax_is_whitespace(c) ? true : false;
+
+        default:
+            return false;
+    }
+}
+
+CJSON_PUBLIC(void) cJSON_SAX_Init(cJSON_SAX *sax, const cJSON_SAX_Callbacks *callbacks, void *user_data, char *token_buffer, size_t token_buffer_size)
+{
+    if (sax == NULL)
+    {
+        return;
+    }
+
+    memset(sax, '\0', sizeof(cJSON_SAX));
+    sax->callbacks = callbacks;
+    sax->user_data = user_data;
+    sax->token = token_buffer;
+    sax->token_size = token_buffer_size;
+    sax->state = sax_value;
+    if ((callbacks == NULL) || (token_buffer == NULL) || (token_buffer_size == 0))
+    {
+        sax->state = sax_error;
+    }
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_SAX_Feed(cJSON_SAX *sax, const char *chunk, size_t length)
+{
+    size_t i = 0;
+
+    if ((sax == NULL) || (sax->state == sax_error) || ((chunk == NULL) && (length > 0)))
+    {
+        return false;
+    }
+
+    while (i < length)
+    {
+        cJSON_bool consumed = true;
+        if (!sax_parse_byte(sax, (unsigned char)chunk[i], &consumed))
+        {
+            sax->state = sax_error;
+            return false;
+        }
+        if (consumed)
+        {
+            sax->offset++;
+            i++;
+        }
+    }
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_SAX_Finish(cJSON_SAX *sax)
+{
+    if ((sax == NULL) || (sax->state == sax_error))
+    {
+        return false;
+    }
+
+    /* a top level number is only terminated by the end of the document */
+    if ((sax->state == sax_number) && !sax_number_done(sax))
+    {
+        sax->state = sax_error;
+        return false;
+    }
+
+    return (sax->state == sax_done) ? true : false;
+}
+
+CJSON_PUBLIC(size_t) cJSON_SAX_GetOffset(const cJSON_SAX *sax)
+{
+    return (sax != NULL) ? sax->offset : 0;
+}
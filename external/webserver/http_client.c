@@ -17,6 +17,10 @@
  ****************************************************************************/
 
 #include <fcntl.h>
+#include <stdarg.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
 #include <protocols/webserver/http_err.h>
 #include <protocols/webserver/http_keyvalue_list.h>
 #include <protocols/webclient.h>
@@ -33,6 +37,69 @@
 
 #define MIN_WS_HEADER_FIELD 2
 
+/* Interval to check waiting connections while a persistent connection is idle */
+#define HTTP_KEEPALIVE_POLL_MSEC 100
+
+/* Wait for the next request on a persistent connection.
+ * Give up when the connection is idle for the keep-alive timeout,
+ * or as soon as another connection is waiting for a client handler.
+ */
+static int http_client_wait_request(struct http_client_t *client)
+{
+	fd_set readfds;
+	struct timeval tv;
+	struct mq_attr mqattr;
+	int waited;
+	int ret;
+
+#ifdef CONFIG_NET_SECURITY_TLS
+	if (client->server->tls_init && mbedtls_ssl_get_bytes_avail(&client->tls_ssl) > 0) {
+		return HTTP_OK;
+	}
+#endif
+
+	for (waited = 0; waited < HTTP_CONF_KEEPALIVE_TIMEOUT_MSEC; waited += HTTP_KEEPALIVE_POLL_MSEC) {
+		FD_ZERO(&readfds);
+		FD_SET(client->client_fd, &readfds);
+		tv.tv_sec = 0;
+		tv.tv_usec = HTTP_KEEPALIVE_POLL_MSEC * 1000;
+
+		ret = select(client->client_fd + 1, &readfds, NULL, NULL, &tv);
+		if (ret > 0) {
+			return HTTP_OK;
+		} else if (ret < 0) {
+			return HTTP_ERROR;
+		}
+
+		if (mq_getattr(client->msg_q, &mqattr) == OK && mqattr.mq_curmsgs > 0) {
+			HTTP_LOGD("Close idle client %d for waiting connections\n", client->client_fd);
+			return HTTP_ERROR;
+		}
+	}
+
+	HTTP_LOGD("Client %d is idle, close it\n", client->client_fd);
+	return HTTP_ERROR;
+}
+
+/* Decide if the connection is kept after the response, when the request header is read */
+static void http_client_check_keep_alive(struct http_client_t *client)
+{
+	struct mq_attr mqattr;
+
+	if (!client->keep_alive) {
+		return;
+	}
+
+	/* A websocket takes over the connection, and the client handlers are shared
+	 * with other connections, so do not hold one if another connection waits.
+	 */
+	if (client->ws_state >= MIN_WS_HEADER_FIELD ||
+		++client->requests >= HTTP_CONF_KEEPALIVE_MAX_REQUESTS ||
+		(mq_getattr(client->msg_q, &mqattr) == OK && mqattr.mq_curmsgs > 0)) {
+		client->keep_alive = 0;
+	}
+}
+
 pthread_addr_t http_handle_client(pthread_addr_t arg)
 {
 	struct http_server_t *server = (struct http_server_t *)arg;
@@ -83,6 +150,7 @@ pthread_addr_t http_handle_client(pthread_addr_t arg)
 			continue;
 		}
 
+		p->msg_q = msg_q;
 		HTTP_LOGD("Client %d.\n", p->client_fd);
 
 #ifdef CONFIG_NET_SECURITY_TLS
@@ -98,6 +166,17 @@ pthread_addr_t http_handle_client(pthread_addr_t arg)
 		result = http_recv_and_handle_request(p, &request_params);
 		http_keyvalue_list_release(&request_params);
 
+		/* Serve the following requests on a persistent connection */
+		while (result == HTTP_OK && p->keep_alive) {
+			if (http_client_wait_request(p) != HTTP_OK) {
+				close(p->client_fd);
+				break;
+			}
+			http_keyvalue_list_init(&request_params);
+			result = http_recv_and_handle_request(p, &request_params);
+			http_keyvalue_list_release(&request_params);
+		}
+
 		if (result != HTTP_OK) {
 			HTTP_LOGD("Client %d  in error case.\n", sock_fd);
 		} else {
@@ -186,6 +265,11 @@ int http_parse_message(char *buf, int buf_len, int *method, char *url,
 						(*method == HTTP_METHOD_DELETE) ?
 						"DELETE" : "UNKNOWN");
 					req->method = *method;
+					client->http_version = protocol;
+#ifdef CONFIG_NETUTILS_WEBSERVER_KEEPALIVE
+					/* HTTP/1.1 connections are persistent unless the client says close */
+					client->keep_alive = (protocol == HTTP_HTTP_VERSION_11);
+#endif
 					HTTP_LOGD("Request URI : %s\n", url);
 					HTTP_LOGD("Request Protocol : ");
 					if (protocol == HTTP_HTTP_VERSION_09) {
@@ -232,7 +316,20 @@ int http_parse_message(char *buf, int buf_len, int *method, char *url,
 							++client->ws_state;
 						}
 						if (strcmp(key, "Sec-WebSocket-Key") == 0) {
-							strncpy((char *)client->ws_key, value, WEBSOCKET_CLIENT_KEY_LEN);
+							/* ws_key is a fixed-width field, not a string */
+							size_t key_len = strnlen(value, WEBSOCKET_CLIENT_KEY_LEN);
+							memset(client->ws_key, 0, WEBSOCKET_CLIENT_KEY_LEN);
+							memcpy(client->ws_key, value, key_len);
+						}
+						if (strcasecmp(key, "Connection") == 0) {
+							if (strcasecmp(value, "close") == 0) {
+								client->keep_alive = 0;
+							}
+#ifdef CONFIG_NETUTILS_WEBSERVER_KEEPALIVE
+							if (strcasecmp(value, "keep-alive") == 0) {
+								client->keep_alive = 1;
+							}
+#endif
 						}
 					}
 					if (strcmp(key, "Content-Length") == 0) {
@@ -261,6 +358,9 @@ int http_parse_message(char *buf, int buf_len, int *method, char *url,
 					}
 				} else {
 					*state = HTTP_REQUEST_BODY;
+					if (client) {
+						http_client_check_keep_alive(client);
+					}
 				}
 				len->sentence_start = sentence_end + 2;
 			} else {
@@ -452,9 +552,11 @@ int http_recv_and_handle_request(struct http_client_t *client, struct http_keyva
 	int state = HTTP_REQUEST_HEADER;
 	struct http_message_len_t mlen = {0,};
 	struct sockaddr_in addr;
-	socklen_t addr_len;
+	socklen_t addr_len = sizeof(addr);
 
 	client->ws_state = 0;
+	client->keep_alive = 0;
+	client->chunked = 0;
 
 	buf = HTTP_MALLOC(HTTP_CONF_MAX_REQUEST_LENGTH);
 	if (buf == NULL) {
@@ -530,6 +632,17 @@ int http_recv_and_handle_request(struct http_client_t *client, struct http_keyva
 			mbedtls_ssl_set_bio(ws->tls_ssl, &ws->tls_net, mbedtls_net_send, mbedtls_net_recv, NULL);
 		}
 #endif
+#ifdef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
+		/* The multiplexer thread takes over the session, or closes the socket on failure */
+		if (websocket_server_init(ws) != WEBSOCKET_SUCCESS) {
+			HTTP_LOGE("Error: Cannot start websocket session!!\n");
+			HTTP_FREE(buf);
+			if (enc == HTTP_CHUNKED_ENCODING) {
+				HTTP_FREE(body);
+			}
+			return HTTP_ERROR;
+		}
+#else
 		if (pthread_attr_init(&ws->thread_attr) != 0) {
 			HTTP_LOGE("Error: Cannot initialize thread attribute\n");
 			goto errout;
@@ -544,9 +657,10 @@ int http_recv_and_handle_request(struct http_client_t *client, struct http_keyva
 		}
 		pthread_setname_np(ws->thread_id, "websocket handle server");
 		pthread_detach(ws->thread_id);
+#endif
 	} else
 #endif
-	{
+	if (!client->keep_alive) {
 		close(client->client_fd);
 	}
 
@@ -573,16 +687,8 @@ void http_handle_file(struct http_client_t *client, int method, const char *url,
 
 	switch (method) {
 	case HTTP_METHOD_GET:
-		if ((f = fopen(url, "r")) != NULL) {
-			fgets(entity, HTTP_CONF_MAX_ENTITY_LENGTH, f);
-			if (http_send_response(client, 200, entity, NULL) == HTTP_ERROR) {
-				HTTP_LOGE("Error: Fail to send response\n");
-			}
-			fclose(f);
-		} else {
-			if (http_send_response(client, 404, HTTP_ERROR_404, NULL) == HTTP_ERROR) {
-				HTTP_LOGE("Error: Fail to send response\n");
-			}
+		if (http_send_file(client, NULL, url, NULL) == HTTP_ERROR) {
+			HTTP_LOGE("Error: Fail to send response\n");
 		}
 		break;
 	case HTTP_METHOD_POST:
@@ -658,11 +764,93 @@ void http_handle_file(struct http_client_t *client, int method, const char *url,
 	}
 }
 
+static int http_client_send(struct http_client_t *client, const char *buf, int len)
+{
+	int ret;
+
+	while (len > 0) {
+#ifdef CONFIG_NET_SECURITY_TLS
+		if (client->server->tls_init) {
+			ret = mbedtls_ssl_write(&(client->tls_ssl), (const unsigned char *)buf, len);
+		} else
+#endif
+		{
+			ret = send(client->client_fd, buf, len, 0);
+		}
+
+		if (ret < 1) {
+			return HTTP_ERROR;
+		}
+		len -= ret;
+		buf += ret;
+	}
+
+	return HTTP_OK;
+}
+
+/* Append formatted string to buf, the result is truncated at the end of buf */
+static void http_buf_printf(char *buf, int size, int *buflen, const char *fmt, ...)
+{
+	va_list ap;
+	int len;
+
+	if (*buflen >= size - 1) {
+		return;
+	}
+
+	va_start(ap, fmt);
+	len = vsnprintf(buf + *buflen, size - *buflen, fmt, ap);
+	va_end(ap);
+
+	if (len > 0) {
+		*buflen = (*buflen + len < size - 1) ? *buflen + len : size - 1;
+	}
+}
+
+static bool http_has_header(struct http_keyvalue_list_t *headers, const char *key)
+{
+	struct http_keyvalue_t *cur;
+
+	if (headers) {
+		for (cur = headers->head->next; cur != headers->tail; cur = cur->next) {
+			if (strcasecmp(cur->key, key) == 0) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/* Put status line, the given headers and the Connection header */
+static void http_put_headers(struct http_client_t *client, char *buf, int size, int *buflen,
+							 int status, const char *phrase, struct http_keyvalue_list_t *headers)
+{
+	struct http_keyvalue_t *cur;
+	bool has_connection = false;
+
+	http_buf_printf(buf, size, buflen, "HTTP/1.1 %d %s\r\n", status, phrase);
+	if (headers) {
+		for (cur = headers->head->next; cur != headers->tail; cur = cur->next) {
+			if (strcasecmp(cur->key, "Connection") == 0) {
+				has_connection = true;
+				if (strcasecmp(cur->value, "close") == 0) {
+					client->keep_alive = 0;
+				}
+			}
+			http_buf_printf(buf, size, buflen, "%s: %s\r\n", cur->key, cur->value);
+		}
+	}
+
+	if (!has_connection) {
+		http_buf_printf(buf, size, buflen, "Connection: %s\r\n", client->keep_alive ? "keep-alive" : "close");
+	}
+}
+
 int http_send_response(struct http_client_t *client, int status, const char *body, struct http_keyvalue_list_t *headers)
 {
 	char *buf;
-	int buflen = 0, ret, sndlen;
-	struct http_keyvalue_t *cur = NULL;
+	int buflen = 0, ret;
 
 	buf = HTTP_MALLOC(HTTP_CONF_MAX_REQUEST_LENGTH);
 	if (buf == NULL) {
@@ -682,61 +870,170 @@ int http_send_response(struct http_client_t *client, int status, const char *bod
 	} else
 #endif
 	{
-		buflen = snprintf(buf, HTTP_CONF_MAX_REQUEST_LENGTH, "HTTP/1.1 %d %s\r\n",
-						  status, (status == 200) ? "OK" : body);
-		if (headers) {
-			cur = headers->head->next;
-			while (cur != headers->tail) {
-				buflen += snprintf(buf + buflen, HTTP_CONF_MAX_REQUEST_LENGTH - buflen,
-								   "%s: %s\r\n", cur->key, cur->value);
-				cur = cur->next;
-			}
-		}
+		http_put_headers(client, buf, HTTP_CONF_MAX_REQUEST_LENGTH, &buflen,
+						 status, (status == 200) ? "OK" : body, headers);
 
+		/* The entity is always delimited by Content-Length,
+		 * so that the connection can be kept after the response.
+		 */
 		if (status == 200) {
 			if (headers == NULL) {
-				buflen += snprintf(buf + buflen, HTTP_CONF_MAX_REQUEST_LENGTH - buflen,
-								   "Content-type: text/html\r\n"
-								   "Connection: close\r\n");
-				if (body) {
-					buflen += snprintf(buf + buflen,
-									   HTTP_CONF_MAX_REQUEST_LENGTH - buflen,
-									   "Content-Length: %d\r\n"
-									   "\r\n"
-									   "%s",
-									   strlen(body), body);
-				} else {
-					buflen += snprintf(buf + buflen,
-									   HTTP_CONF_MAX_REQUEST_LENGTH - buflen,
-									   "\r\n");
-				}
-			} else {
-				snprintf(buf + buflen, HTTP_CONF_MAX_REQUEST_LENGTH - buflen,
-						 "\r\n%s", body);
+				http_buf_printf(buf, HTTP_CONF_MAX_REQUEST_LENGTH, &buflen, "Content-type: text/html\r\n");
 			}
+			if (!http_has_header(headers, "Content-Length") && !http_has_header(headers, "Transfer-Encoding")) {
+				http_buf_printf(buf, HTTP_CONF_MAX_REQUEST_LENGTH, &buflen, "Content-Length: %d\r\n", body ? (int)strlen(body) : 0);
+			}
+			http_buf_printf(buf, HTTP_CONF_MAX_REQUEST_LENGTH, &buflen, "\r\n%s", body ? body : "");
+		} else {
+			http_buf_printf(buf, HTTP_CONF_MAX_REQUEST_LENGTH, &buflen, "Content-Length: 0\r\n\r\n");
 		}
 	}
 
-	sndlen = strlen(buf);
-	buflen = 0;
-	while (sndlen > 0) {
-#ifdef CONFIG_NET_SECURITY_TLS
-		if (client->server->tls_init) {
-			ret = mbedtls_ssl_write(&(client->tls_ssl), (unsigned char *)buf + buflen, sndlen);
-		} else
-#endif
-		{
-			ret = send(client->client_fd, buf + buflen, sndlen, 0);
+	ret = http_client_send(client, buf, strlen(buf));
+	HTTP_FREE(buf);
+	return ret;
+}
+
+int http_send_chunked_header(struct http_client_t *client, int status, struct http_keyvalue_list_t *headers)
+{
+	char buf[HTTP_CONF_MAX_REQUEST_LINE_LENGTH];
+	int buflen = 0;
+
+	if (client->http_version == HTTP_HTTP_VERSION_11) {
+		client->chunked = 1;
+	} else {
+		/* HTTP/1.0 doesn't know chunked encoding, the entity ends with the connection */
+		client->chunked = 0;
+		client->keep_alive = 0;
+	}
+
+	http_put_headers(client, buf, sizeof(buf), &buflen, status, (status == 200) ? "OK" : "", headers);
+	if (client->chunked) {
+		http_buf_printf(buf, sizeof(buf), &buflen, "Transfer-Encoding: chunked\r\n");
+	}
+	http_buf_printf(buf, sizeof(buf), &buflen, "\r\n");
+
+	return http_client_send(client, buf, buflen);
+}
+
+int http_send_chunk(struct http_client_t *client, const char *data, int len)
+{
+	char size_line[12];
+	int size_len;
+
+	if (!client->chunked) {
+		return http_client_send(client, data, len);
+	}
+
+	if (len == 0) {
+		client->chunked = 0;
+		return http_client_send(client, "0\r\n\r\n", 5);
+	}
+
+	size_len = snprintf(size_line, sizeof(size_line), "%x\r\n", len);
+	if (http_client_send(client, size_line, size_len) != HTTP_OK ||
+		http_client_send(client, data, len) != HTTP_OK) {
+		return HTTP_ERROR;
+	}
+
+	return http_client_send(client, "\r\n", 2);
+}
+
+int http_send_file(struct http_client_t *client, struct http_req_message *req, const char *path, const char *content_type)
+{
+	struct stat st;
+	char etag[24];
+	char *buf;
+	char *match;
+	int buflen = 0;
+	int ret = HTTP_ERROR;
+	int fd;
+	ssize_t len;
+	off_t remain;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0 || fstat(fd, &st) < 0) {
+		HTTP_LOGE("Error: Fail to open %s\n", path);
+		if (fd >= 0) {
+			close(fd);
 		}
+		http_send_response(client, 404, HTTP_ERROR_404, NULL);
+		return HTTP_ERROR;
+	}
 
-		if (ret < 1) {
-			HTTP_FREE(buf);
-			return HTTP_ERROR;
-		} else {
-			sndlen -= ret;
-			buflen += ret;
+	buf = HTTP_MALLOC(HTTP_CONF_FILE_BUFFER_SIZE);
+	if (buf == NULL) {
+		HTTP_LOGE("Error: Fail to malloc buffer\n");
+		close(fd);
+		http_send_response(client, 500, HTTP_ERROR_500, NULL);
+		return HTTP_ERROR;
+	}
+
+	/* The file is not changed as long as its size and modification time are same */
+	snprintf(etag, sizeof(etag), "\"%lx-%lx\"", (unsigned long)st.st_mtime, (unsigned long)st.st_size);
+
+	if (req && req->headers) {
+		match = http_keyvalue_list_find(req->headers, "If-None-Match");
+		if (strstr(match, etag) || strcmp(match, "*") == 0) {
+			http_put_headers(client, buf, HTTP_CONF_FILE_BUFFER_SIZE, &buflen, 304, "Not Modified", NULL);
+			http_buf_printf(buf, HTTP_CONF_FILE_BUFFER_SIZE, &buflen, "ETag: %s\r\n\r\n", etag);
+			ret = http_client_send(client, buf, buflen);
+			goto done;
+		}
+	}
+
+	http_put_headers(client, buf, HTTP_CONF_FILE_BUFFER_SIZE, &buflen, 200, "OK", NULL);
+	http_buf_printf(buf, HTTP_CONF_FILE_BUFFER_SIZE, &buflen,
+					"Content-Type: %s\r\n"
+					"Content-Length: %ld\r\n"
+					"ETag: %s\r\n\r\n",
+					content_type ? content_type : "application/octet-stream", (long)st.st_size, etag);
+
+	/* A small file is sent with the header in one write */
+	remain = st.st_size;
+	if (remain <= HTTP_CONF_FILE_BUFFER_SIZE - buflen) {
+		len = read(fd, buf + buflen, remain);
+		if (len != remain) {
+			goto done;
+		}
+		ret = http_client_send(client, buf, buflen + len);
+		goto done;
+	}
+
+	if (http_client_send(client, buf, buflen) != HTTP_OK) {
+		goto done;
+	}
+
+#ifdef CONFIG_NETUTILS_WEBSERVER_SENDFILE
+	if (!client->server->tls_init) {
+		while (remain > 0) {
+			len = sendfile(client->client_fd, fd, NULL, remain);
+			if (len <= 0) {
+				goto done;
+			}
+			remain -= len;
+		}
+		ret = HTTP_OK;
+		goto done;
+	}
+#endif
+
+	while (remain > 0) {
+		len = read(fd, buf, HTTP_CONF_FILE_BUFFER_SIZE);
+		if (len <= 0 || http_client_send(client, buf, len) != HTTP_OK) {
+			goto done;
 		}
+		remain -= len;
+	}
+	ret = HTTP_OK;
+
+done:
+	if (ret != HTTP_OK) {
+		/* The response is broken, the connection can't be reused */
+		HTTP_LOGE("Error: Fail to send %s\n", path);
+		client->keep_alive = 0;
 	}
 	HTTP_FREE(buf);
-	return HTTP_OK;
+	close(fd);
+	return ret;
 }
@@ -43,6 +43,11 @@ enum {
 struct http_client_t {
 	int client_fd;
 	struct http_server_t *server;
+	mqd_t msg_q;
+	int http_version;
+	int keep_alive;
+	int requests;
+	int chunked;
 	int ws_state;
 	unsigned char ws_key[WEBSOCKET_CLIENT_KEY_LEN];
 
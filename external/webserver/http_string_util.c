@@ -151,7 +151,8 @@ int http_separate_status_line(const char *src, int *httpver, int *status, char *
 
 	/* Get status code */
 	status_start = divide[0] + 1;
-	strncpy(status_code, src + status_start, 4);
+	strncpy(status_code, src + status_start, sizeof(status_code) - 1);
+	status_code[sizeof(status_code) - 1] = '\0';
 	*status = atoi(status_code);
 
 	/* Get reason phrase */
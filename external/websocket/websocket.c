@@ -27,6 +27,8 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <netdb.h>
+#include <poll.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -38,6 +40,7 @@
 #include <sys/socket.h>
 #include <sys/select.h>
 #include <sys/time.h>
+#include <time.h>
 #include "mbedtls/sha1.h"
 #include "mbedtls/base64.h"
 #include <netutils/netlib.h>
@@ -51,16 +54,36 @@
 #define WEBSOCKET_FREE(a) do { if (a != NULL) { free(a); a = NULL; } } while (0)
 #define WEBSOCKET_CLOSE(a) do { if (a >= 0) { close(a); a = -1; } } while (0)
 
+/* Messages a multiplexed session reads before the others are served */
+#define WEBSOCKET_MUX_RECV_BUDGET 8
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
+/* The user_data of the callbacks, freed with the websocket context */
+struct websocket_mux_session_s {
+	struct websocket_info_t info;	/* keep it first for the callbacks */
+	websocket_t *ws;
+	int read_pending;
+	unsigned int last_active;
+};
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 websocket_t ws_srv_table[WEBSOCKET_MAX_CLIENT];
 
+#ifdef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
+static struct websocket_mux_session_s *g_mux_sessions[WEBSOCKET_MAX_CLIENT];
+static pthread_mutex_t g_mux_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t g_mux_tid;
+static int g_mux_running;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -247,6 +270,305 @@ int websocket_handler(websocket_t *websocket)
 	return WEBSOCKET_SUCCESS;
 }
 
+static void websocket_server_release(websocket_t *server)
+{
+	WEBSOCKET_CLOSE(server->fd);
+
+	if (server->ctx) {
+		wslay_event_context_free(server->ctx);
+		server->ctx = NULL;
+	}
+
+	if (server->tls_enabled) {
+		mbedtls_net_free(&(server->tls_net));
+		mbedtls_ssl_free(server->tls_ssl);
+		WEBSOCKET_FREE(server->tls_ssl);
+	}
+
+	websocket_update_state(server, WEBSOCKET_STOP);
+}
+
+#ifdef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
+/****** websocket multiplexer *****/
+
+static unsigned int websocket_mux_msec(void)
+{
+	struct timespec ts;
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+	clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+	return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static int websocket_mux_pending(struct websocket_mux_session_s *s)
+{
+	if (s->read_pending) {
+		return 1;
+	}
+#ifdef CONFIG_NET_SECURITY_TLS
+	/* TLS may have decrypted a record the socket no longer reports */
+	if (s->ws->tls_enabled && mbedtls_ssl_get_bytes_avail(s->ws->tls_ssl) > 0) {
+		return 1;
+	}
+#endif
+	return 0;
+}
+
+static ssize_t websocket_mux_recv(websocket_context_ptr ctx, uint8_t *buf, size_t len, int flags, void *user_data)
+{
+	ssize_t r;
+	struct websocket_mux_session_s *s = user_data;
+
+	/* Stop reading while the replies wait for the peer to read */
+	if (wslay_event_get_queued_msg_length(ctx) >= WEBSOCKET_SEND_QUEUE_SIZE) {
+		s->read_pending = 0;
+		wslay_event_set_error(ctx, WSLAY_ERR_WOULDBLOCK);
+		return -1;
+	}
+
+	r = s->info.data->cb->recv_callback(ctx, buf, len, flags, user_data);
+	if (r < 0) {
+		s->read_pending = 0;
+	}
+
+	return r;
+}
+
+static int websocket_mux_handle(struct websocket_mux_session_s *s, short revents, unsigned int now)
+{
+	int i;
+	int r;
+	websocket_t *ws = s->ws;
+	wslay_event_context_ptr ctx = (wslay_event_context_ptr) ws->ctx;
+
+	if (revents & POLLNVAL) {
+		WEBSOCKET_DEBUG("socket fd %d is not valid, closing\n", ws->fd);
+		return WEBSOCKET_SOCKET_ERROR;
+	}
+
+	if (revents == 0) {
+		if (now - s->last_active >= WEBSOCKET_PING_INTERVAL * 10) {
+			s->last_active = now;
+			return websocket_ping_counter(ws);
+		}
+		return WEBSOCKET_SUCCESS;
+	}
+
+	s->last_active = now;
+
+	if (revents & (POLLIN | POLLERR | POLLHUP)) {
+		/*
+		 * wslay_event_recv() returns after each message, with the next ones left
+		 * in its buffer. Read until the socket would block, a few messages at a
+		 * time so that a busy session doesn't starve the others.
+		 */
+		s->read_pending = 1;
+		for (i = 0; i < WEBSOCKET_MUX_RECV_BUDGET && s->read_pending && wslay_event_want_read(ctx); i++) {
+			r = wslay_event_recv(ctx);
+			if (r != WEBSOCKET_SUCCESS) {
+				WEBSOCKET_DEBUG("fail to process recv event, fd %d result : %d\n", ws->fd, r);
+				return WEBSOCKET_SOCKET_ERROR;
+			}
+		}
+	}
+
+	if ((revents & POLLOUT) || wslay_event_want_write(ctx)) {
+		r = wslay_event_send(ctx);
+		if (r != WEBSOCKET_SUCCESS) {
+			WEBSOCKET_DEBUG("fail to process send event, fd %d result : %d\n", ws->fd, r);
+			return WEBSOCKET_SOCKET_ERROR;
+		}
+	}
+
+	return WEBSOCKET_SUCCESS;
+}
+
+static void *websocket_mux_handler(void *arg)
+{
+	int i;
+	int n;
+	int r;
+	int timeout;
+	unsigned int now;
+	websocket_t *ws;
+	wslay_event_context_ptr ctx;
+	struct websocket_mux_session_s *s;
+	struct websocket_mux_session_s *polled[WEBSOCKET_MAX_CLIENT];
+	struct pollfd fds[WEBSOCKET_MAX_CLIENT];
+
+	while (1) {
+		n = 0;
+		timeout = WEBSOCKET_HANDLER_TIMEOUT;
+
+		pthread_mutex_lock(&g_mux_lock);
+		for (i = 0; i < WEBSOCKET_MAX_CLIENT; i++) {
+			s = g_mux_sessions[i];
+			if (s == NULL) {
+				continue;
+			}
+
+			ws = s->ws;
+			ctx = (wslay_event_context_ptr) ws->ctx;
+			if (ws->state == WEBSOCKET_STOP || ws->state == WEBSOCKET_ERROR ||
+				(!wslay_event_want_read(ctx) && !wslay_event_want_write(ctx))) {
+				WEBSOCKET_DEBUG("websocket session fd %d is closed\n", ws->fd);
+				websocket_server_release(ws);
+				g_mux_sessions[i] = NULL;
+				continue;
+			}
+
+			fds[n].fd = ws->fd;
+			fds[n].events = 0;
+			fds[n].revents = 0;
+
+			/* A session whose peer doesn't read isn't read either */
+			if (wslay_event_want_read(ctx) && wslay_event_get_queued_msg_length(ctx) < WEBSOCKET_SEND_QUEUE_SIZE) {
+				fds[n].events |= POLLIN;
+				if (websocket_mux_pending(s)) {
+					timeout = 0;
+				}
+			}
+			if (wslay_event_want_write(ctx)) {
+				fds[n].events |= POLLOUT;
+			}
+			polled[n++] = s;
+		}
+
+		if (n == 0) {
+			g_mux_running = 0;
+			pthread_mutex_unlock(&g_mux_lock);
+			break;
+		}
+		pthread_mutex_unlock(&g_mux_lock);
+
+		r = poll(fds, n, timeout);
+		if (r < 0) {
+			if (errno != EINTR) {
+				WEBSOCKET_DEBUG("poll function returned errno == %d\n", errno);
+				usleep(WEBSOCKET_HANDLER_TIMEOUT * 1000);
+			}
+			continue;
+		}
+
+		now = websocket_mux_msec();
+		for (i = 0; i < n; i++) {
+			if ((fds[i].events & POLLIN) && websocket_mux_pending(polled[i])) {
+				fds[i].revents |= POLLIN;
+			}
+
+			if (websocket_mux_handle(polled[i], fds[i].revents, now) != WEBSOCKET_SUCCESS) {
+				websocket_update_state(polled[i]->ws, WEBSOCKET_ERROR);
+			}
+		}
+	}
+
+	WEBSOCKET_DEBUG("no websocket session left, multiplexer exits\n");
+	return NULL;
+}
+
+static int websocket_mux_start(void)
+{
+	pthread_attr_t attr;
+	struct sched_param ws_sparam;
+
+	if (pthread_attr_init(&attr) != 0) {
+		WEBSOCKET_DEBUG("fail to init pthread attribute\n");
+		return WEBSOCKET_INIT_ERROR;
+	}
+
+	pthread_attr_setstacksize(&attr, WEBSOCKET_STACKSIZE);
+	ws_sparam.sched_priority = WEBSOCKET_PRI;
+	pthread_attr_setschedparam(&attr, &ws_sparam);
+	pthread_attr_setschedpolicy(&attr, WEBSOCKET_SCHED_POLICY);
+
+	if (pthread_create(&g_mux_tid, &attr, websocket_mux_handler, NULL) != 0) {
+		WEBSOCKET_DEBUG("fail to create websocket multiplexer thread\n");
+		return WEBSOCKET_INIT_ERROR;
+	}
+
+	pthread_setname_np(g_mux_tid, "websocket multiplexer");
+	pthread_detach(g_mux_tid);
+
+	return WEBSOCKET_SUCCESS;
+}
+
+static int websocket_mux_attach(websocket_t *server)
+{
+	int i;
+	int flags;
+	int r = WEBSOCKET_SUCCESS;
+	websocket_cb_t cb;
+	struct websocket_mux_session_s *s = NULL;
+
+	if (server->cb == NULL || server->cb->recv_callback == NULL) {
+		WEBSOCKET_DEBUG("websocket callbacks are not set\n");
+		return WEBSOCKET_INIT_ERROR;
+	}
+
+	pthread_mutex_lock(&g_mux_lock);
+	for (i = 0; i < WEBSOCKET_MAX_CLIENT; i++) {
+		if (g_mux_sessions[i] == NULL) {
+			break;
+		}
+	}
+
+	if (i == WEBSOCKET_MAX_CLIENT) {
+		WEBSOCKET_DEBUG("websocket sessions are too many. limit : %d\n", WEBSOCKET_MAX_CLIENT);
+		r = WEBSOCKET_INIT_ERROR;
+		goto EXIT_MUX_ATTACH;
+	}
+
+	s = calloc(1, sizeof(struct websocket_mux_session_s));
+	if (s == NULL) {
+		WEBSOCKET_DEBUG("fail to allocate memory\n");
+		r = WEBSOCKET_ALLOCATION_ERROR;
+		goto EXIT_MUX_ATTACH;
+	}
+	s->info.data = server;
+	s->ws = server;
+
+	cb = *server->cb;
+	cb.recv_callback = websocket_mux_recv;
+	if (wslay_event_context_server_init(&(server->ctx), &cb, s) != WEBSOCKET_SUCCESS) {
+		WEBSOCKET_DEBUG("fail to initiate websocket server\n");
+		WEBSOCKET_FREE(s);
+		r = WEBSOCKET_INIT_ERROR;
+		goto EXIT_MUX_ATTACH;
+	}
+
+	if (websocket_config_socket(server->fd) != WEBSOCKET_SUCCESS) {
+		r = WEBSOCKET_SOCKET_ERROR;
+		goto EXIT_MUX_ATTACH;
+	}
+
+	flags = fcntl(server->fd, F_GETFL, 0);
+	if (flags == -1 || fcntl(server->fd, F_SETFL, flags | O_NONBLOCK) == -1) {
+		WEBSOCKET_DEBUG("fail to set non-blocking socket\n");
+		r = WEBSOCKET_SOCKET_ERROR;
+		goto EXIT_MUX_ATTACH;
+	}
+
+	if (!g_mux_running) {
+		r = websocket_mux_start();
+		if (r != WEBSOCKET_SUCCESS) {
+			goto EXIT_MUX_ATTACH;
+		}
+		g_mux_running = 1;
+	}
+
+	s->last_active = websocket_mux_msec();
+	g_mux_sessions[i] = s;
+	WEBSOCKET_DEBUG("websocket session fd %d is multiplexed\n", server->fd);
+
+EXIT_MUX_ATTACH:
+	pthread_mutex_unlock(&g_mux_lock);
+	return r;
+}
+#endif
+
 /***** websocket client oriented sources *****/
 
 int websocket_client_handshake(websocket_t *client, char *host, char *port, char *path)
@@ -575,7 +897,9 @@ int websocket_accept_handler(websocket_t *init_server)
 	socklen_t addrlen = sizeof(struct sockaddr);
 	struct timeval tv;
 	struct sockaddr_in clientaddr;
+#ifndef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
 	struct sched_param ws_sparam;
+#endif
 
 	for (i = 0; i < WEBSOCKET_MAX_CLIENT; i++) {
 		ws_srv_table[i].state = WEBSOCKET_STOP;
@@ -634,6 +958,7 @@ int websocket_accept_handler(websocket_t *init_server)
 			/* To copy TLS context and websocket_call backs from init_server to server_handler */
 			memcpy(server_handler, init_server, sizeof(websocket_t));
 
+#ifndef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
 			if (pthread_attr_init(&server_handler->thread_attr) != 0) {
 				WEBSOCKET_DEBUG("fail to init attribute\n");
 				r = WEBSOCKET_INIT_ERROR;
@@ -658,6 +983,7 @@ int websocket_accept_handler(websocket_t *init_server)
 				r = WEBSOCKET_INIT_ERROR;
 				goto EXIT_ACCEPT;
 			}
+#endif
 
 			accept_fd = accept(listen_fd, (struct sockaddr *)&clientaddr, &addrlen);
 			if (accept_fd < 0) {
@@ -675,6 +1001,14 @@ int websocket_accept_handler(websocket_t *init_server)
 			WEBSOCKET_DEBUG("accept client, fd == %d\n", accept_fd);
 			server_handler->fd = accept_fd;
 
+#ifdef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
+			/*
+			 * The handshakes are done here, and the session is handed over to the
+			 * multiplexer. A failed session is released by websocket_server_authenticate.
+			 */
+			websocket_server_authenticate(server_handler);
+			continue;
+#else
 			if (pthread_create(&server_handler->thread_id, &server_handler->thread_attr, (pthread_startroutine_t) websocket_server_authenticate, (pthread_addr_t) server_handler) != 0) {
 				WEBSOCKET_DEBUG("fail to create thread, fd == %d\n", accept_fd);
 				r = WEBSOCKET_INIT_ERROR;
@@ -693,6 +1027,7 @@ int websocket_accept_handler(websocket_t *init_server)
 				r = WEBSOCKET_INIT_ERROR;
 				goto EXIT_ACCEPT;
 			}
+#endif
 EXIT_ACCEPT:
 			if (r != WEBSOCKET_SUCCESS) {
 				WEBSOCKET_CLOSE(accept_fd);
@@ -943,13 +1278,23 @@ websocket_return_t websocket_server_open(websocket_t *init_server)
 websocket_return_t websocket_server_init(websocket_t *server)
 {
 	int r = WEBSOCKET_SUCCESS;
+#ifndef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
 	struct websocket_info_t *socket_data = NULL;
+#endif
 
 	if (server == NULL) {
 		WEBSOCKET_DEBUG("NULL parameter\n");
 		return WEBSOCKET_ALLOCATION_ERROR;
 	}
 
+#ifdef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
+	r = websocket_mux_attach(server);
+	if (r != WEBSOCKET_SUCCESS) {
+		websocket_server_release(server);
+	}
+
+	return r;
+#else
 	socket_data = calloc(1, sizeof(struct websocket_info_t));
 	if (socket_data == NULL) {
 		WEBSOCKET_DEBUG("fail to allocate memory\n");
@@ -973,22 +1318,10 @@ websocket_return_t websocket_server_init(websocket_t *server)
 	r = websocket_handler(server);
 
 EXIT_SERVER_INIT:
-	WEBSOCKET_CLOSE(server->fd);
-
-	if (server->ctx) {
-		wslay_event_context_free(server->ctx);
-		server->ctx = NULL;
-	}
-
-	if (server->tls_enabled) {
-		mbedtls_net_free(&(server->tls_net));
-		mbedtls_ssl_free(server->tls_ssl);
-		WEBSOCKET_FREE(server->tls_ssl);
-	}
-
-	websocket_update_state(server, WEBSOCKET_STOP);
+	websocket_server_release(server);
 
 	return r;
+#endif
 }
 
 websocket_return_t websocket_register_cb(websocket_t *websocket, websocket_cb_t *cb)
@@ -1015,6 +1348,18 @@ websocket_return_t websocket_queue_msg(websocket_t *websocket, websocket_frame_t
 		return WEBSOCKET_INIT_ERROR;
 	}
 
+#ifdef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
+	/*
+	 * The replies queued by the callbacks are bounded as the session isn't read
+	 * over the limit, the messages of the other threads are refused.
+	 */
+	if (websocket->state == WEBSOCKET_RUN_SERVER && !pthread_equal(pthread_self(), g_mux_tid) &&
+		wslay_event_get_queued_msg_count(websocket->ctx) > 0 &&
+		wslay_event_get_queued_msg_length(websocket->ctx) + tx_frame->msg_length > WEBSOCKET_SEND_QUEUE_SIZE) {
+		return WEBSOCKET_QUEUE_FULL_ERROR;
+	}
+#endif
+
 	return wslay_event_queue_msg(websocket->ctx, tx_frame);
 }
 
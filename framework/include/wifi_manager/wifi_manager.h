@@ -182,6 +182,7 @@ typedef struct {
 	void (*softap_sta_joined)(void);	// in softap mode, a station joined
 	void (*softap_sta_left)(void);		// in softap mode, a station left
 	void (*scan_ap_done)(wifi_manager_scan_info_s **, wifi_manager_scan_result_e); // scanning ap is done
+	void (*scan_ap_partial)(wifi_manager_scan_info_s **); // optional, aps found on the channels scanned so far
 } wifi_manager_cb_s;
 
 /**
@@ -242,6 +243,12 @@ typedef struct {
 	uint16_t left;
 	uint16_t scan;
 	uint16_t softap;
+	/* phases of the last (re)connection in ms, 0 if not reached */
+	uint32_t assoc_time;	// from the connect request to the association
+	uint32_t dhcp_time;		// from the association to the IP address
+	uint8_t fast_assoc;		// the driver was asked to join the cached BSSID/channel, only
+							// if it reports WIFI_UTILS_CAP_JOIN_BSSID
+	uint8_t fast_dhcp;		// the DHCP server confirmed the cached IP address (INIT-REBOOT)
 } wifi_manager_stats_s;
 
 /**
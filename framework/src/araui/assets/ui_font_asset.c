@@ -33,7 +33,23 @@
 
 #define DEFAULT_GLYPH_MAP_CAPACITY 256
 
+#if defined(CONFIG_UI_GLYPH_CACHE)
+#define UI_GLYPH_HASH_SIZE 64
+#define UI_GLYPH_HASH(font, size, code) \
+	((((uintptr_t)(font) >> 4) ^ ((size) * 31) ^ ((code) * 2654435761u)) % UI_GLYPH_HASH_SIZE)
+#endif
+
 static void _ui_font_asset_destroy_func(void *userdata);
+#if defined(CONFIG_UI_GLYPH_CACHE)
+static void _ui_font_asset_evict_glyph(ui_glyph_t *glyph);
+#endif
+
+#if defined(CONFIG_UI_GLYPH_CACHE)
+static ui_glyph_t *g_glyph_hash[UI_GLYPH_HASH_SIZE];
+//!< LRU list head: lru_next is the most recently used glyph, lru_prev the least
+static ui_glyph_t g_glyph_lru = { .lru_prev = &g_glyph_lru, .lru_next = &g_glyph_lru };
+static size_t g_glyph_cache_used;
+#endif
 
 ui_asset_t ui_font_asset_create_from_file(const char *filename)
 {
@@ -175,6 +191,114 @@ static void _ui_font_asset_destroy_func(void *userdata)
 
 	body = (ui_font_asset_body_t *)userdata;
 
+#if defined(CONFIG_UI_GLYPH_CACHE)
+	ui_font_asset_purge_glyphs(body);
+#endif
+
 	UI_FREE(body->ttf_buf);
 	UI_FREE(body);
 }
+
+#if defined(CONFIG_UI_GLYPH_CACHE)
+ui_glyph_t *ui_font_asset_get_glyph(ui_font_asset_body_t *font, size_t font_size, uint32_t codepoint)
+{
+	ui_glyph_t *glyph;
+	ui_glyph_t **bucket;
+	size_t size;
+	float scale;
+	int x1;
+	int y1;
+	int x2;
+	int y2;
+
+	bucket = &g_glyph_hash[UI_GLYPH_HASH(font, font_size, codepoint)];
+
+	for (glyph = *bucket; glyph; glyph = glyph->hash_next) {
+		if (glyph->font == font && glyph->font_size == font_size && glyph->codepoint == codepoint) {
+			// Move to the front of the LRU list
+			glyph->lru_prev->lru_next = glyph->lru_next;
+			glyph->lru_next->lru_prev = glyph->lru_prev;
+			glyph->lru_prev = &g_glyph_lru;
+			glyph->lru_next = g_glyph_lru.lru_next;
+			g_glyph_lru.lru_next->lru_prev = glyph;
+			g_glyph_lru.lru_next = glyph;
+			return glyph;
+		}
+	}
+
+	scale = stbtt_ScaleForPixelHeight(&font->ttf_info, font_size);
+	stbtt_GetCodepointBitmapBox(&font->ttf_info, codepoint, scale, scale, &x1, &y1, &x2, &y2);
+
+	size = sizeof(ui_glyph_t) + (x2 - x1) * (y2 - y1);
+	if (size > CONFIG_UI_GLYPH_CACHE_SIZE) {
+		return NULL;
+	}
+
+	while (g_glyph_cache_used + size > CONFIG_UI_GLYPH_CACHE_SIZE) {
+		_ui_font_asset_evict_glyph(g_glyph_lru.lru_prev);
+	}
+
+	glyph = (ui_glyph_t *)UI_ALLOC(size);
+	if (!glyph) {
+		UI_LOGE("error: out of memory!\n");
+		return NULL;
+	}
+
+	glyph->font = font;
+	glyph->font_size = font_size;
+	glyph->codepoint = codepoint;
+	glyph->x_offset = x1;
+	glyph->y_offset = y1;
+	glyph->width = x2 - x1;
+	glyph->height = y2 - y1;
+	glyph->bitmap = (uint8_t *)(glyph + 1);
+
+	if (glyph->width > 0 && glyph->height > 0) {
+		stbtt_MakeCodepointBitmap(&font->ttf_info, glyph->bitmap, glyph->width, glyph->height,
+			glyph->width, scale, scale, codepoint);
+	}
+
+	glyph->hash_next = *bucket;
+	*bucket = glyph;
+
+	glyph->lru_prev = &g_glyph_lru;
+	glyph->lru_next = g_glyph_lru.lru_next;
+	g_glyph_lru.lru_next->lru_prev = glyph;
+	g_glyph_lru.lru_next = glyph;
+
+	g_glyph_cache_used += size;
+
+	return glyph;
+}
+
+void ui_font_asset_purge_glyphs(ui_font_asset_body_t *font)
+{
+	ui_glyph_t *glyph;
+	ui_glyph_t *prev;
+
+	for (glyph = g_glyph_lru.lru_prev; glyph != &g_glyph_lru; glyph = prev) {
+		prev = glyph->lru_prev;
+		if (!font || glyph->font == font) {
+			_ui_font_asset_evict_glyph(glyph);
+		}
+	}
+}
+
+static void _ui_font_asset_evict_glyph(ui_glyph_t *glyph)
+{
+	ui_glyph_t **link;
+
+	link = &g_glyph_hash[UI_GLYPH_HASH(glyph->font, glyph->font_size, glyph->codepoint)];
+	while (*link != glyph) {
+		link = &(*link)->hash_next;
+	}
+	*link = glyph->hash_next;
+
+	glyph->lru_prev->lru_next = glyph->lru_next;
+	glyph->lru_next->lru_prev = glyph->lru_prev;
+
+	g_glyph_cache_used -= sizeof(ui_glyph_t) + glyph->width * glyph->height;
+
+	UI_FREE(glyph);
+}
+#endif // CONFIG_UI_GLYPH_CACHE
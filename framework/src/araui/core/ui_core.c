@@ -68,11 +68,19 @@ typedef struct {
 
 static ui_core_t g_core;
 static ui_widget_body_t *g_quick_panel_info[UI_QUICK_PANEL_TYPE_NUM];
+#if defined(CONFIG_UI_PARTIAL_UPDATE)
+static ui_redraw_stats_t g_redraw_stats;
+#endif
 
 static ui_error_t _ui_process_widget(ui_widget_body_t *widget, uint32_t dt);
 static void _ui_call_anim_finished_cb(void *userdata);
 static void *_ui_core_thread_loop(void *param);
 static bool _ui_core_quick_panel_visible(void);
+#if defined(CONFIG_UI_PARTIAL_UPDATE)
+static bool _ui_widget_is_outside(ui_widget_body_t *widget, ui_rect_t draw_area);
+static bool _ui_widget_occludes(ui_widget_body_t *widget, ui_rect_t draw_area);
+static int _ui_get_occluded_count(ui_widget_body_t *widget, ui_rect_t draw_area);
+#endif
 
 #if defined(CONFIG_UI_ENABLE_TOUCH)
 static void _ui_core_dispatch_touch_event(void);
@@ -198,6 +206,10 @@ ui_error_t ui_stop(void)
 		return UI_OPERATION_FAIL;
 	}
 
+#if defined(CONFIG_UI_GLYPH_CACHE)
+	ui_font_asset_purge_glyphs(NULL);
+#endif
+
 	return UI_OK;
 }
 
@@ -265,6 +277,87 @@ static ui_error_t _ui_process_widget(ui_widget_body_t *widget, uint32_t dt)
 	return UI_OK;
 }
 
+#if defined(CONFIG_UI_PARTIAL_UPDATE)
+static bool _ui_widget_is_outside(ui_widget_body_t *widget, ui_rect_t draw_area)
+{
+	ui_rect_t bbox = widget->global_rect;
+
+	// global_rect is truncated from the transformed vertices, so allow a pixel more
+	bbox.x -= 1;
+	bbox.y -= 1;
+	bbox.width += 2;
+	bbox.height += 2;
+
+	bbox = ui_rect_intersect(draw_area, bbox);
+
+	return (bbox.width <= 0 || bbox.height <= 0);
+}
+
+/**
+ * @brief Whether the widget paints every pixel of draw_area with opaque texels.
+ * Only an RGB888 image widget which is translated by whole pixels can be sure of it.
+ */
+static bool _ui_widget_occludes(ui_widget_body_t *widget, ui_rect_t draw_area)
+{
+	ui_image_widget_body_t *body;
+	ui_mat3_t *mat = &widget->trans_mat;
+
+	if (widget->type != UI_IMAGE_WIDGET || !widget->render_cb) {
+		return false;
+	}
+
+	body = (ui_image_widget_body_t *)widget;
+	if (!body->image || body->image->pixel_format != UI_PIXEL_FORMAT_RGB888) {
+		return false;
+	}
+
+	if (mat->m[0][0] != 1.0f || mat->m[0][1] != 0.0f || mat->m[1][0] != 0.0f || mat->m[1][1] != 1.0f ||
+		mat->m[0][2] != (float)(int32_t)mat->m[0][2] || mat->m[1][2] != (float)(int32_t)mat->m[1][2]) {
+		return false;
+	}
+
+	return (widget->global_rect.x <= draw_area.x && widget->global_rect.y <= draw_area.y &&
+		widget->global_rect.x + widget->global_rect.width >= draw_area.x + draw_area.width &&
+		widget->global_rect.y + widget->global_rect.height >= draw_area.y + draw_area.height);
+}
+
+/**
+ * @brief Number of the visible widgets, in drawing order, which are hidden in draw_area
+ * by the topmost opaque widget covering it.
+ */
+static int _ui_get_occluded_count(ui_widget_body_t *widget, ui_rect_t draw_area)
+{
+	int iter;
+	int index = 0;
+	int occluded = 0;
+	ui_widget_body_t *curr_widget;
+	ui_widget_body_t *child;
+
+	ui_widget_queue_init();
+	ui_widget_queue_enqueue(widget);
+
+	while (!ui_widget_is_queue_empty()) {
+		curr_widget = ui_widget_queue_dequeue();
+		if (!curr_widget) {
+			break;
+		}
+
+		if (curr_widget->visible) {
+			if (_ui_widget_occludes(curr_widget, draw_area)) {
+				occluded = index;
+			}
+			index++;
+
+			vec_foreach(&curr_widget->children, child, iter) {
+				ui_widget_queue_enqueue(child);
+			}
+		}
+	}
+
+	return occluded;
+}
+#endif // CONFIG_UI_PARTIAL_UPDATE
+
 static ui_error_t _ui_render_widget(ui_widget_body_t *widget, ui_rect_t draw_area, uint32_t dt)
 {
 	int iter;
@@ -272,6 +365,7 @@ static ui_error_t _ui_render_widget(ui_widget_body_t *widget, ui_rect_t draw_are
 	ui_widget_body_t *child;
 #if defined(CONFIG_UI_PARTIAL_UPDATE)
 	ui_rect_t new_vp;
+	int occluded;
 #endif
 
 	if (!widget) {
@@ -279,6 +373,10 @@ static ui_error_t _ui_render_widget(ui_widget_body_t *widget, ui_rect_t draw_are
 		return UI_INVALID_PARAM;
 	}
 
+#if defined(CONFIG_UI_PARTIAL_UPDATE)
+	occluded = _ui_get_occluded_count(widget, draw_area);
+#endif
+
 	ui_widget_queue_init();
 	ui_widget_queue_enqueue(widget);
 
@@ -290,16 +388,21 @@ static ui_error_t _ui_render_widget(ui_widget_body_t *widget, ui_rect_t draw_are
 		}
 
 		if (curr_widget->visible) {
-			if (curr_widget->render_cb) {
 #if defined(CONFIG_UI_PARTIAL_UPDATE)
+			// Skip the widgets painted over by an opaque one or out of draw_area
+			if (occluded > 0) {
+				occluded--;
+			} else if (curr_widget->render_cb && !_ui_widget_is_outside(curr_widget, draw_area)) {
 				new_vp = ui_rect_intersect(draw_area, curr_widget->global_rect);
 				ui_dal_set_viewport(new_vp.x, new_vp.y, new_vp.width, new_vp.height);
 				curr_widget->render_cb((ui_widget_t)curr_widget, dt);
 				ui_dal_set_viewport(draw_area.x, draw_area.y, draw_area.width, draw_area.height);
+			}
 #else
+			if (curr_widget->render_cb) {
 				curr_widget->render_cb((ui_widget_t)curr_widget, dt);
-#endif
 			}
+#endif
 
 			vec_foreach(&curr_widget->children, child, iter) {
 				ui_widget_queue_enqueue(child);
@@ -338,7 +441,14 @@ static void _ui_redraw(uint32_t dt)
 	ui_window_body_t *window;
 
 #if defined(CONFIG_UI_PARTIAL_UPDATE)
+	ui_redraw_stats_t stats = { 0, 0, 0 };
+
+	ui_renderer_reset_drawn_pixels();
+
 	vec_foreach(ui_window_get_redraw_list(), redraw_rect, iter) {
+		// Anything drawn outside of the rect is not flushed
+		ui_renderer_set_clip_rect(*redraw_rect);
+
 		window = ui_window_get_current();
 		if (window) {
 			_ui_render_widget(window->root, *redraw_rect, dt);
@@ -350,10 +460,20 @@ static void _ui_redraw(uint32_t dt)
 
 		if (window || _ui_core_quick_panel_visible()) {
 			ui_dal_redraw(redraw_rect->x, redraw_rect->y, redraw_rect->width, redraw_rect->height);
+			stats.rects++;
+			stats.pixels_flushed += redraw_rect->width * redraw_rect->height;
 		}
 	}
 
+	ui_renderer_set_clip_rect((ui_rect_t){ 0, 0, CONFIG_UI_DISPLAY_WIDTH, CONFIG_UI_DISPLAY_HEIGHT });
 	ui_window_redraw_list_clear();
+
+	if (stats.rects) {
+		stats.pixels_drawn = ui_renderer_get_drawn_pixels();
+		g_redraw_stats = stats;
+		UI_LOGD("redraw: %u rects, %u pixels drawn, %u pixels flushed\n",
+			stats.rects, stats.pixels_drawn, stats.pixels_flushed);
+	}
 #else
 	redraw_rect.x = 0;
 	redraw_rect.y = 0;
@@ -505,6 +625,15 @@ bool ui_is_running(void)
 	return (g_core.state != UI_CORE_STATE_STOP);
 }
 
+#if defined(CONFIG_UI_PARTIAL_UPDATE)
+void ui_core_get_redraw_stats(ui_redraw_stats_t *stats)
+{
+	if (stats) {
+		*stats = g_redraw_stats;
+	}
+}
+#endif
+
 #if defined(CONFIG_UI_ENABLE_TOUCH)
 
 static void _ui_deliver_touch_event(ui_widget_body_t *widget, ui_touch_event_t touch_event, ui_coord_t coord)
@@ -31,6 +31,9 @@
 static vec_void_t g_window_list;
 static ui_window_body_t *g_current_window = UI_NULL;
 #if defined(CONFIG_UI_PARTIAL_UPDATE)
+#define _UI_RECT_AREA(r) ((r).width * (r).height)
+#define _UI_TILE_AREA (CONFIG_UI_REDRAW_TILE_SIZE * CONFIG_UI_REDRAW_TILE_SIZE)
+
 static vec_void_t g_window_redraw_list;
 static ui_rect_t g_rect_mempool[CONFIG_UI_UPDATE_MEMPOOL_SIZE];
 static int g_rect_mempool_idx = 0;
@@ -39,6 +42,8 @@ static int g_rect_mempool_idx = 0;
 static void _ui_window_create_func(void *userdata);
 static void _ui_window_destroy_func(void *userdata);
 #if defined(CONFIG_UI_PARTIAL_UPDATE)
+static void _ui_window_snap_to_tile(ui_rect_t *rect);
+static bool _ui_window_rect_touch(ui_rect_t *r1, ui_rect_t *r2);
 static ui_rect_t *_ui_window_get_mempool_rect(void);
 #endif
 
@@ -256,10 +261,11 @@ vec_void_t *ui_window_get_redraw_list(void)
 
 ui_error_t ui_window_add_redraw_list(ui_rect_t redraw_rect)
 {
-	ui_rect_t *window;
+	ui_rect_t *area;
 	ui_rect_t *new_area;
-	ui_rect_t previous;
-	ui_rect_t ret;
+	ui_rect_t merged;
+	int32_t total;
+	bool merging;
 	int iter;
 
 	if (redraw_rect.x < 0) {
@@ -280,48 +286,57 @@ ui_error_t ui_window_add_redraw_list(ui_rect_t redraw_rect)
 		return UI_OK;
 	}
 
-	new_area = _ui_window_get_mempool_rect();
-
-	new_area->x = redraw_rect.x;
-	new_area->y = redraw_rect.y;
-	new_area->width = redraw_rect.width;
-	new_area->height = redraw_rect.height;
-
-	if (new_area->x + new_area->width >= CONFIG_UI_DISPLAY_WIDTH) {
-		new_area->width = CONFIG_UI_DISPLAY_WIDTH - new_area->x;
-	}
-	if (new_area->y + new_area->height >= CONFIG_UI_DISPLAY_HEIGHT) {
-		new_area->height = CONFIG_UI_DISPLAY_HEIGHT - new_area->y;
-	}
+	_ui_window_snap_to_tile(&redraw_rect);
 
-	vec_foreach(&g_window_redraw_list, window, iter) {
-		// window is whole screen case
-		if ((window->x == 0) && (window->y == 0) &&
-			(window->width == CONFIG_UI_DISPLAY_WIDTH) &&
-			(window->height == CONFIG_UI_DISPLAY_HEIGHT)) {
+	// window is whole screen case
+	vec_foreach(&g_window_redraw_list, area, iter) {
+		if ((area->x == 0) && (area->y == 0) &&
+			(area->width == CONFIG_UI_DISPLAY_WIDTH) &&
+			(area->height == CONFIG_UI_DISPLAY_HEIGHT)) {
 			return UI_OK;
 		}
+	}
 
-		previous.x = window->x;
-		previous.y = window->y;
-		previous.width = window->width;
-		previous.height = window->height;
-
-		ret = ui_rect_intersect(previous, *new_area);
-		if (ret.x == 0 && ret.y == 0 && ret.width == 0 && ret.height == 0) {
-			continue;
+	/* Merge with every area it touches as long as the merged area costs no
+	 * more than drawing and flushing both of them (plus one tile for the
+	 * overhead of a flush). Repeat, as the merged area may reach others.
+	 */
+	do {
+		merging = false;
+		vec_foreach(&g_window_redraw_list, area, iter) {
+			if (!_ui_window_rect_touch(area, &redraw_rect)) {
+				continue;
+			}
+
+			merged = ui_get_contain_rect(*area, redraw_rect);
+			if (_UI_RECT_AREA(merged) > _UI_RECT_AREA(*area) + _UI_RECT_AREA(redraw_rect) + _UI_TILE_AREA) {
+				continue;
+			}
+
+			redraw_rect = merged;
+			vec_splice(&g_window_redraw_list, iter, 1);
+			merging = true;
+			break;
 		}
+	} while (merging);
 
-		ret = ui_get_contain_rect(previous, *new_area);
-		new_area->x = ret.x;
-		new_area->y = ret.y;
-		new_area->width = ret.width;
-		new_area->height = ret.height;
+	// If the areas sum up to the whole screen, flush the whole screen once
+	total = _UI_RECT_AREA(redraw_rect);
+	vec_foreach(&g_window_redraw_list, area, iter) {
+		total += _UI_RECT_AREA(*area);
+	}
 
-		vec_remove(&g_window_redraw_list, window);
-		iter--;
+	if (total >= CONFIG_UI_DISPLAY_WIDTH * CONFIG_UI_DISPLAY_HEIGHT) {
+		vec_clear(&g_window_redraw_list);
+		redraw_rect.x = 0;
+		redraw_rect.y = 0;
+		redraw_rect.width = CONFIG_UI_DISPLAY_WIDTH;
+		redraw_rect.height = CONFIG_UI_DISPLAY_HEIGHT;
 	}
 
+	new_area = _ui_window_get_mempool_rect();
+	*new_area = redraw_rect;
+
 	vec_push(&g_window_redraw_list, new_area);
 
 	return UI_OK;
@@ -334,6 +349,26 @@ ui_error_t ui_window_redraw_list_clear(void)
 	return UI_OK;
 }
 
+static void _ui_window_snap_to_tile(ui_rect_t *rect)
+{
+	int32_t x2 = rect->x + rect->width;
+	int32_t y2 = rect->y + rect->height;
+
+	rect->x = (rect->x / CONFIG_UI_REDRAW_TILE_SIZE) * CONFIG_UI_REDRAW_TILE_SIZE;
+	rect->y = (rect->y / CONFIG_UI_REDRAW_TILE_SIZE) * CONFIG_UI_REDRAW_TILE_SIZE;
+	x2 = ((x2 + CONFIG_UI_REDRAW_TILE_SIZE - 1) / CONFIG_UI_REDRAW_TILE_SIZE) * CONFIG_UI_REDRAW_TILE_SIZE;
+	y2 = ((y2 + CONFIG_UI_REDRAW_TILE_SIZE - 1) / CONFIG_UI_REDRAW_TILE_SIZE) * CONFIG_UI_REDRAW_TILE_SIZE;
+
+	rect->width = UI_MIN(x2, CONFIG_UI_DISPLAY_WIDTH) - rect->x;
+	rect->height = UI_MIN(y2, CONFIG_UI_DISPLAY_HEIGHT) - rect->y;
+}
+
+static bool _ui_window_rect_touch(ui_rect_t *r1, ui_rect_t *r2)
+{
+	return (r1->x <= r2->x + r2->width) && (r2->x <= r1->x + r1->width) &&
+		(r1->y <= r2->y + r2->height) && (r2->y <= r1->y + r1->height);
+}
+
 static ui_rect_t *_ui_window_get_mempool_rect(void)
 {
 	int alloc_idx = g_rect_mempool_idx;
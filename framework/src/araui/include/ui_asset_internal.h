@@ -62,6 +62,25 @@ typedef struct {
 	uint8_t *ttf_buf;
 } ui_font_asset_body_t;
 
+#if defined(CONFIG_UI_GLYPH_CACHE)
+/**
+ * @brief Pre-rasterized alpha(A8) bitmap of a glyph, keyed by (font, font_size, codepoint)
+ */
+typedef struct ui_glyph_s {
+	struct ui_glyph_s *hash_next;
+	struct ui_glyph_s *lru_prev;
+	struct ui_glyph_s *lru_next;
+	ui_font_asset_body_t *font;
+	size_t font_size;
+	uint32_t codepoint;
+	int32_t x_offset; //!< Offset of the bitmap from the pen position
+	int32_t y_offset; //!< Offset of the bitmap from the baseline
+	int32_t width;
+	int32_t height;
+	uint8_t *bitmap;
+} ui_glyph_t;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -69,6 +88,20 @@ extern "C" {
 bool ui_asset_check_type(ui_asset_t asset, ui_asset_type_t type);
 bool ui_image_asset_has_alpha(ui_pixel_format_t format);
 
+#if defined(CONFIG_UI_GLYPH_CACHE)
+/**
+ * @brief Get the glyph from the glyph cache, rasterizing it on a miss.
+ * The glyph stays valid until the next call, as it may evict the others.
+ * NULL is returned if the glyph cannot be cached.
+ */
+ui_glyph_t *ui_font_asset_get_glyph(ui_font_asset_body_t *font, size_t font_size, uint32_t codepoint);
+
+/**
+ * @brief Drop the cached glyphs of the font, or all of them if font is NULL.
+ */
+void ui_font_asset_purge_glyphs(ui_font_asset_body_t *font);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
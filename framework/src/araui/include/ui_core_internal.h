@@ -30,12 +30,27 @@ typedef enum {
 	UI_CORE_STATE_RUNNING
 } ui_core_state_t;
 
+#if defined(CONFIG_UI_PARTIAL_UPDATE)
+/**
+ * @brief Redraw counters of the last frame which flushed anything
+ */
+typedef struct {
+	uint32_t rects;          //!< Number of the rectangles flushed
+	uint32_t pixels_drawn;   //!< Number of the pixels rasterized by the renderer
+	uint32_t pixels_flushed; //!< Number of the pixels flushed to the display
+} ui_redraw_stats_t;
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 bool ui_is_running(void);
 
+#if defined(CONFIG_UI_PARTIAL_UPDATE)
+void ui_core_get_redraw_stats(ui_redraw_stats_t *stats);
+#endif
+
 #if defined(CONFIG_UI_ENABLE_TOUCH)
 
 /**
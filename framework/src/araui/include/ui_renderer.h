@@ -76,6 +76,18 @@ void ui_renderer_scale(ui_mat3_t *mat, float x, float y);
 void ui_renderer_set_texture(uint8_t *bitmap, int32_t width, int32_t height, ui_pixel_format_t pf);
 void ui_renderer_set_fill_color(ui_color_t color);
 
+/**
+ * @brief Only the pixels inside of the clip rect are drawn.
+ * It is honored by the fixed-point renderer (CONFIG_UI_RENDERER_FIXED_POINT).
+ */
+void ui_renderer_set_clip_rect(ui_rect_t rect);
+
+/**
+ * @brief Number of pixels rasterized since the last reset
+ */
+uint32_t ui_renderer_get_drawn_pixels(void);
+void ui_renderer_reset_drawn_pixels(void);
+
 /**
  * @brief Rendering geometry functions
  * 
@@ -125,6 +125,12 @@ typedef struct {
 	ui_uv_t uv[4]; // top-left, bottom-left, bottom-right, top-right
 } ui_image_widget_body_t;
 
+typedef struct {
+	uint32_t code;
+	int32_t x;
+	int32_t y;
+} ui_text_layout_t;
+
 typedef struct {
 	ui_widget_body_t base;
 	ui_font_asset_body_t *font;
@@ -136,6 +142,14 @@ typedef struct {
 	size_t line_num;
 	ui_align_t align;
 	bool word_wrap;
+
+	ui_text_layout_t *layout; //!< Pen position of each glyph, computed while layout_valid is false
+	size_t layout_len;
+	int32_t layout_width;
+	int32_t layout_height;
+	int32_t layout_wrap_width;
+	int32_t layout_ascent;
+	bool layout_valid;
 } ui_text_widget_body_t;
 
 typedef struct {
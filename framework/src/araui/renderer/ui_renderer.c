@@ -38,22 +38,49 @@
 #define UI_SUB_DIVIDE_SIZE (1 << UI_SUB_DIVIDE_SHIFT)
 #define UI_SUB_PIX(a) (ceilf(a) - (a))
 
-#define CONFIG_UI_DEFAULT_FILL_COLOR 0x000000
+#define UI_FX_SHIFT (16)
+#define UI_FX_ONE (1 << UI_FX_SHIFT)
+#define UI_FX_FROM_FLOAT(a) ((int32_t)floorf((a) * UI_FX_ONE + 0.5f))
+#define UI_FX_CEIL(a) (((a) + UI_FX_ONE - 1) >> UI_FX_SHIFT)
 
-/****************************************************************************
- * Private function declaration
- ****************************************************************************/
-static void ui_draw_triangle_segment(int32_t y1, int32_t y2);
+#define CONFIG_UI_DEFAULT_FILL_COLOR 0x000000
 
 /****************************************************************************
  * Private types
  ****************************************************************************/
+#if defined(CONFIG_UI_RENDERER_FIXED_POINT)
+/**
+ * @brief Texel coordinates (16.16) as an affine function of the screen pixel.
+ * They are set up once per primitive, so the rasterizer steps integers only.
+ */
+typedef struct {
+	int32_t x0;
+	int32_t y0;
+	int32_t u0;
+	int32_t v0;
+	int32_t dudx;
+	int32_t dudy;
+	int32_t dvdx;
+	int32_t dvdy;
+} ui_tex_plane_t;
+
+/**
+ * @brief Triangle edge walked one scanline at a time (16.16)
+ */
+typedef struct {
+	int32_t x;
+	int32_t dxdy;
+} ui_edge_t;
+#endif
+
 typedef struct {
 	uint8_t          *texture;
 	int32_t           tex_width;
 	int32_t           tex_height;
 	ui_pixel_format_t tex_pf;
 	ui_color_t        fill_color;
+	ui_rect_t         clip;
+	uint32_t          drawn_pixels;
 } ui_render_context_t;
 
 //!< Render context (global instance)
@@ -62,9 +89,24 @@ ui_render_context_t g_rc = {
 	.tex_width = 0,
 	.tex_height = 0,
 	.tex_pf = UI_PIXEL_FORMAT_UNKNOWN,
-	.fill_color = CONFIG_UI_DEFAULT_FILL_COLOR
+	.fill_color = CONFIG_UI_DEFAULT_FILL_COLOR,
+	.clip = { 0, 0, CONFIG_UI_DISPLAY_WIDTH, CONFIG_UI_DISPLAY_HEIGHT },
+	.drawn_pixels = 0
 };
 
+/****************************************************************************
+ * Private function declaration
+ ****************************************************************************/
+#if defined(CONFIG_UI_RENDERER_FIXED_POINT)
+static bool ui_tex_plane_setup(ui_tex_plane_t *plane,
+	ui_vec3_t *p1, ui_vec3_t *p2, ui_vec3_t *p3,
+	ui_uv_t *uv1, ui_uv_t *uv2, ui_uv_t *uv3);
+static void ui_edge_setup(ui_edge_t *edge, int32_t xa, int32_t ya, int32_t xb, int32_t yb, int32_t y);
+static void ui_draw_triangle_segment(ui_tex_plane_t *plane, ui_edge_t *e1, ui_edge_t *e2, int32_t y1, int32_t y2);
+static void ui_draw_span(ui_tex_plane_t *plane, int32_t x, int32_t y, int32_t width);
+#else
+static void ui_draw_triangle_segment(int32_t y1, int32_t y2);
+
 float g_left_dxdy;
 float g_right_dxdy;
 float g_leftx;
@@ -81,6 +123,7 @@ float g_pk_dzdx;
 float g_pk_dudx_;
 float g_pk_dvdx_;
 float g_pk_dzdx_;
+#endif
 
 /****************************************************************************
  * Public function implementation
@@ -190,6 +233,148 @@ void ui_renderer_set_fill_color(ui_color_t color)
 	g_rc.fill_color = color;
 }
 
+void ui_renderer_set_clip_rect(ui_rect_t rect)
+{
+	g_rc.clip = rect;
+}
+
+uint32_t ui_renderer_get_drawn_pixels(void)
+{
+	return g_rc.drawn_pixels;
+}
+
+void ui_renderer_reset_drawn_pixels(void)
+{
+	g_rc.drawn_pixels = 0;
+}
+
+#if defined(CONFIG_UI_RENDERER_FIXED_POINT)
+
+void ui_render_triangle_uv(ui_mat3_t *trans_mat,
+	ui_vec3_t v1, ui_vec3_t v2, ui_vec3_t v3,
+	ui_uv_t uv1, ui_uv_t uv2, ui_uv_t uv3)
+{
+	ui_tex_plane_t plane;
+	ui_edge_t long_edge;
+	ui_edge_t short_edge;
+	int32_t x1;
+	int32_t x2;
+	int32_t x3;
+	int32_t y1;
+	int32_t y2;
+	int32_t y3;
+	int32_t y1i;
+	int32_t y2i;
+	int32_t y3i;
+
+	if (!g_rc.texture) {
+		return;
+	}
+
+	v1 = ui_mat3_vec3_multiply(trans_mat, &v1);
+	v2 = ui_mat3_vec3_multiply(trans_mat, &v2);
+	v3 = ui_mat3_vec3_multiply(trans_mat, &v3);
+
+	// The only floating point math of the triangle: everything below is 16.16
+	if (!ui_tex_plane_setup(&plane, &v1, &v2, &v3, &uv1, &uv2, &uv3)) {
+		return;
+	}
+
+	if (v1.y > v2.y) {
+		UI_SWAP(v1, v2);
+	}
+	if (v1.y > v3.y) {
+		UI_SWAP(v1, v3);
+	}
+	if (v2.y > v3.y) {
+		UI_SWAP(v2, v3);
+	}
+
+	x1 = UI_FX_FROM_FLOAT(v1.x);
+	y1 = UI_FX_FROM_FLOAT(v1.y);
+	x2 = UI_FX_FROM_FLOAT(v2.x);
+	y2 = UI_FX_FROM_FLOAT(v2.y);
+	x3 = UI_FX_FROM_FLOAT(v3.x);
+	y3 = UI_FX_FROM_FLOAT(v3.y);
+
+	y1i = UI_FX_CEIL(y1);
+	y2i = UI_FX_CEIL(y2);
+	y3i = UI_FX_CEIL(y3);
+
+	if (y1i == y3i) {
+		return;
+	}
+
+	ui_edge_setup(&long_edge, x1, y1, x3, y3, y1i);
+
+	if (y1i < y2i) {
+		ui_edge_setup(&short_edge, x1, y1, x2, y2, y1i);
+		ui_draw_triangle_segment(&plane, &long_edge, &short_edge, y1i, y2i);
+	}
+
+	if (y2i < y3i) {
+		ui_edge_setup(&short_edge, x2, y2, x3, y3, y2i);
+		ui_draw_triangle_segment(&plane, &long_edge, &short_edge, y2i, y3i);
+	}
+}
+
+void ui_render_quad_uv(ui_mat3_t *trans_mat,
+	ui_vec3_t v1, ui_vec3_t v2, ui_vec3_t v3, ui_vec3_t v4,
+	ui_uv_t uv1, ui_uv_t uv2, ui_uv_t uv3, ui_uv_t uv4)
+{
+	ui_tex_plane_t plane;
+	ui_vec3_t t1;
+	ui_vec3_t t2;
+	ui_vec3_t t3;
+	ui_vec3_t t4;
+	int32_t x1;
+	int32_t x2;
+	int32_t y1;
+	int32_t y2;
+	int32_t y;
+
+	if (!g_rc.texture) {
+		return;
+	}
+
+	if (trans_mat->m[0][1] != 0.0f || trans_mat->m[1][0] != 0.0f) {
+		ui_render_triangle_uv(trans_mat, v1, v2, v3, uv1, uv2, uv3);
+		ui_render_triangle_uv(trans_mat, v1, v3, v4, uv1, uv3, uv4);
+		return;
+	}
+
+	t1 = ui_mat3_vec3_multiply(trans_mat, &v1);
+	t2 = ui_mat3_vec3_multiply(trans_mat, &v2);
+	t3 = ui_mat3_vec3_multiply(trans_mat, &v3);
+	t4 = ui_mat3_vec3_multiply(trans_mat, &v4);
+
+	/* Translated or scaled only: if the quad and its uv are both axis-aligned
+	 * rectangles (v1, v2, v3, v4 = top-left, bottom-left, bottom-right,
+	 * top-right as the widgets build them), one texel plane covers the whole
+	 * quad and it is blitted row by row without walking any edge.
+	 */
+	if (t1.x != t2.x || t3.x != t4.x || t1.y != t4.y || t2.y != t3.y ||
+		uv1.u != uv2.u || uv3.u != uv4.u || uv1.v != uv4.v || uv2.v != uv3.v) {
+		ui_render_triangle_uv(trans_mat, v1, v2, v3, uv1, uv2, uv3);
+		ui_render_triangle_uv(trans_mat, v1, v3, v4, uv1, uv3, uv4);
+		return;
+	}
+
+	if (!ui_tex_plane_setup(&plane, &t1, &t2, &t3, &uv1, &uv2, &uv3)) {
+		return;
+	}
+
+	x1 = UI_FX_CEIL(UI_FX_FROM_FLOAT(UI_MIN(t1.x, t3.x)));
+	x2 = UI_FX_CEIL(UI_FX_FROM_FLOAT(UI_MAX(t1.x, t3.x)));
+	y1 = UI_MAX(UI_FX_CEIL(UI_FX_FROM_FLOAT(UI_MIN(t1.y, t3.y))), g_rc.clip.y);
+	y2 = UI_MIN(UI_FX_CEIL(UI_FX_FROM_FLOAT(UI_MAX(t1.y, t3.y))), g_rc.clip.y + g_rc.clip.height);
+
+	for (y = y1; y < y2; y++) {
+		ui_draw_span(&plane, x1, y, x2 - x1);
+	}
+}
+
+#else
 void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 	ui_vec3_t v1, ui_vec3_t v2, ui_vec3_t v3,
 	ui_uv_t uv1, ui_uv_t uv2, ui_uv_t uv3)
@@ -399,9 +584,212 @@ void ui_render_quad_uv(ui_mat3_t *trans_mat,
 	ui_render_triangle_uv(trans_mat, v1, v3, v4, uv1, uv3, uv4);
 }
 
+#endif // CONFIG_UI_RENDERER_FIXED_POINT
+
 /****************************************************************************
  * Private function implementation
  ****************************************************************************/
+#if defined(CONFIG_UI_RENDERER_FIXED_POINT)
+
+static bool ui_tex_plane_setup(ui_tex_plane_t *plane,
+	ui_vec3_t *p1, ui_vec3_t *p2, ui_vec3_t *p3,
+	ui_uv_t *uv1, ui_uv_t *uv2, ui_uv_t *uv3)
+{
+	float tw = (float)g_rc.tex_width;
+	float th = (float)g_rc.tex_height;
+	float dx2 = p2->x - p1->x;
+	float dy2 = p2->y - p1->y;
+	float dx3 = p3->x - p1->x;
+	float dy3 = p3->y - p1->y;
+	float du2 = (uv2->u - uv1->u) * tw;
+	float du3 = (uv3->u - uv1->u) * tw;
+	float dv2 = (uv2->v - uv1->v) * th;
+	float dv3 = (uv3->v - uv1->v) * th;
+	float dudx;
+	float dudy;
+	float dvdx;
+	float dvdy;
+	float denom;
+
+	denom = dx2 * dy3 - dx3 * dy2;
+	if (!denom) {
+		return false;
+	}
+
+	denom = 1.0f / denom;
+
+	dudx = (du2 * dy3 - du3 * dy2) * denom;
+	dudy = (du3 * dx2 - du2 * dx3) * denom;
+	dvdx = (dv2 * dy3 - dv3 * dy2) * denom;
+	dvdy = (dv3 * dx2 - dv2 * dx3) * denom;
+
+	/* Texel (u * width, v * height) is sampled at the integer pixel
+	 * coordinate, so an unscaled quad maps to its texture one to one.
+	 */
+	plane->x0 = (int32_t)floorf(p1->x);
+	plane->y0 = (int32_t)floorf(p1->y);
+	plane->u0 = UI_FX_FROM_FLOAT(uv1->u * tw + dudx * (plane->x0 - p1->x) + dudy * (plane->y0 - p1->y));
+	plane->v0 = UI_FX_FROM_FLOAT(uv1->v * th + dvdx * (plane->x0 - p1->x) + dvdy * (plane->y0 - p1->y));
+	plane->dudx = UI_FX_FROM_FLOAT(dudx);
+	plane->dudy = UI_FX_FROM_FLOAT(dudy);
+	plane->dvdx = UI_FX_FROM_FLOAT(dvdx);
+	plane->dvdy = UI_FX_FROM_FLOAT(dvdy);
+
+	return true;
+}
+
+static void ui_edge_setup(ui_edge_t *edge, int32_t xa, int32_t ya, int32_t xb, int32_t yb, int32_t y)
+{
+	edge->dxdy = (int32_t)(((int64_t)(xb - xa) << UI_FX_SHIFT) / (yb - ya));
+	edge->x = xa + (int32_t)(((int64_t)edge->dxdy * ((y << UI_FX_SHIFT) - ya)) >> UI_FX_SHIFT);
+}
+
+static void ui_draw_triangle_segment(ui_tex_plane_t *plane, ui_edge_t *e1, ui_edge_t *e2, int32_t y1, int32_t y2)
+{
+	int32_t x1;
+	int32_t x2;
+	int32_t y;
+
+	for (y = y1; y < y2; y++) {
+		x1 = UI_FX_CEIL(e1->x);
+		x2 = UI_FX_CEIL(e2->x);
+
+		if (x1 > x2) {
+			UI_SWAP(x1, x2);
+		}
+
+		ui_draw_span(plane, x1, y, x2 - x1);
+
+		e1->x += e1->dxdy;
+		e2->x += e2->dxdy;
+	}
+}
+
+static inline void ui_put_texel(int32_t x, int32_t y, const uint8_t *texel)
+{
+	switch (g_rc.tex_pf) {
+	case UI_PIXEL_FORMAT_RGBA8888:
+		if (texel[3]) {
+			ui_dal_put_pixel_rgba8888(x, y, UI_COLOR_RGBA8888(texel[0], texel[1], texel[2], texel[3]));
+		}
+		break;
+	case UI_PIXEL_FORMAT_RGB888:
+		ui_dal_put_pixel_rgb888(x, y, UI_COLOR_RGB888(texel[0], texel[1], texel[2]));
+		break;
+	case UI_PIXEL_FORMAT_A8:
+		if (texel[0]) {
+			ui_dal_put_pixel_rgba8888(x, y, UI_COLOR_RGBA8888(
+				(g_rc.fill_color & 0xff0000) >> 16,
+				(g_rc.fill_color & 0x00ff00) >> 8,
+				(g_rc.fill_color & 0x0000ff) >> 0,
+				texel[0]
+			));
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static void ui_blit_row(int32_t x, int32_t y, int32_t width, const uint8_t *texel)
+{
+	ui_color_t rgb;
+
+	switch (g_rc.tex_pf) {
+	case UI_PIXEL_FORMAT_RGBA8888:
+		for (; width > 0; width--, x++, texel += 4) {
+			if (texel[3]) {
+				ui_dal_put_pixel_rgba8888(x, y, UI_COLOR_RGBA8888(texel[0], texel[1], texel[2], texel[3]));
+			}
+		}
+		break;
+	case UI_PIXEL_FORMAT_RGB888:
+		for (; width > 0; width--, x++, texel += 3) {
+			ui_dal_put_pixel_rgb888(x, y, UI_COLOR_RGB888(texel[0], texel[1], texel[2]));
+		}
+		break;
+	case UI_PIXEL_FORMAT_A8:
+		rgb = UI_COLOR_RGB888(
+			(g_rc.fill_color & 0xff0000) >> 16,
+			(g_rc.fill_color & 0x00ff00) >> 8,
+			(g_rc.fill_color & 0x0000ff) >> 0
+		);
+		for (; width > 0; width--, x++, texel++) {
+			if (texel[0]) {
+				ui_dal_put_pixel_rgba8888(x, y, rgb | ((ui_color_t)texel[0] << 24));
+			}
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static void ui_draw_span(ui_tex_plane_t *plane, int32_t x, int32_t y, int32_t width)
+{
+	int32_t bpp;
+	int32_t u;
+	int32_t v;
+	int32_t iu;
+	int32_t iv;
+
+	// Nothing outside of the clip rect is flushed, so do not sample it at all
+	if (y < g_rc.clip.y || y >= g_rc.clip.y + g_rc.clip.height) {
+		return;
+	}
+	if (x < g_rc.clip.x) {
+		width -= g_rc.clip.x - x;
+		x = g_rc.clip.x;
+	}
+	if (x + width > g_rc.clip.x + g_rc.clip.width) {
+		width = g_rc.clip.x + g_rc.clip.width - x;
+	}
+	if (width <= 0) {
+		return;
+	}
+
+	g_rc.drawn_pixels += width;
+
+	switch (g_rc.tex_pf) {
+	case UI_PIXEL_FORMAT_RGBA8888:
+		bpp = 4;
+		break;
+	case UI_PIXEL_FORMAT_RGB888:
+		bpp = 3;
+		break;
+	case UI_PIXEL_FORMAT_A8:
+		bpp = 1;
+		break;
+	default:
+		return;
+	}
+
+	u = plane->u0 + (int32_t)((int64_t)plane->dudx * (x - plane->x0) + (int64_t)plane->dudy * (y - plane->y0));
+	v = plane->v0 + (int32_t)((int64_t)plane->dvdx * (x - plane->x0) + (int64_t)plane->dvdy * (y - plane->y0));
+
+	// Unscaled row: the texels are consecutive in the texture
+	if (plane->dudx == UI_FX_ONE && plane->dvdx == 0) {
+		iu = u >> UI_FX_SHIFT;
+		iv = v >> UI_FX_SHIFT;
+		if (iu >= 0 && iu + width <= g_rc.tex_width && iv >= 0 && iv < g_rc.tex_height) {
+			ui_blit_row(x, y, width, g_rc.texture + ((iv * g_rc.tex_width) + iu) * bpp);
+			return;
+		}
+	}
+
+	for (; width > 0; width--, x++) {
+		iu = UI_MIN(UI_MAX(u >> UI_FX_SHIFT, 0), g_rc.tex_width - 1);
+		iv = UI_MIN(UI_MAX(v >> UI_FX_SHIFT, 0), g_rc.tex_height - 1);
+
+		ui_put_texel(x, y, g_rc.texture + ((iv * g_rc.tex_width) + iu) * bpp);
+
+		u += plane->dudx;
+		v += plane->dvdx;
+	}
+}
+
+#else
+
 static void ui_draw_triangle_segment(int32_t y1, int32_t y2)
 {
 	float u;
@@ -439,6 +827,10 @@ static void ui_draw_triangle_segment(int32_t y1, int32_t y2)
 		V2 = v * Z;
 		width = x2 - x1;
 
+		if (width > 0) {
+			g_rc.drawn_pixels += width;
+		}
+
 		while (width >= UI_SUB_DIVIDE_SIZE) {
 
 			u += g_pk_dudx_;
@@ -554,3 +946,4 @@ static void ui_draw_triangle_segment(int32_t y1, int32_t y2)
 	}
 }
 
+#endif // CONFIG_UI_RENDERER_FIXED_POINT
@@ -35,6 +35,10 @@ MediaPlayerImpl::MediaPlayerImpl(MediaPlayer &player) : mPlayer(player)
 	mCurState = PLAYER_STATE_NONE;
 	mBuffer = nullptr;
 	mBufSize = 0;
+#ifdef CONFIG_AUDIO_MIXER
+	mStreamId = -1;
+	mFrameSize = 0;
+#endif
 }
 
 player_result_t MediaPlayerImpl::create()
@@ -152,9 +156,7 @@ void MediaPlayerImpl::preparePlayer(player_result_t &ret)
 		return notifySync();
 	}
 
-	auto source = mInputHandler.getDataSource();
-	if (set_audio_stream_out(source->getChannels(), source->getSampleRate(),
-							 source->getPcmFormat()) != AUDIO_MANAGER_SUCCESS) {
+	if (setAudioStreamOut() != AUDIO_MANAGER_SUCCESS) {
 		meddbg("MediaPlayer prepare fail : set_audio_stream_out fail\n");
 		ret = PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
 		return notifySync();
@@ -256,7 +258,7 @@ void MediaPlayerImpl::unpreparePlayer(player_result_t &ret)
 	}
 	mBufSize = 0;
 
-	if (reset_audio_stream_out() != AUDIO_MANAGER_SUCCESS) {
+	if (resetAudioStreamOut() != AUDIO_MANAGER_SUCCESS) {
 		meddbg("MediaPlayer unprepare fail : reset_audio_stream_out fail\n");
 		ret = PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
 		return notifySync();
@@ -297,15 +299,17 @@ void MediaPlayerImpl::startPlayer()
 	}
 
 	if (mCurState == PLAYER_STATE_PAUSED) {
-		auto source = mInputHandler.getDataSource();
-		if (set_audio_stream_out(source->getChannels(), source->getSampleRate(),
-								 source->getPcmFormat()) != AUDIO_MANAGER_SUCCESS) {
+		if (setAudioStreamOut() != AUDIO_MANAGER_SUCCESS) {
 			meddbg("MediaPlayer startPlayer fail : set_audio_stream_out fail\n");
 			notifyObserver(PLAYER_OBSERVER_COMMAND_START_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
 			return;
 		}
 	}
 
+#ifdef CONFIG_AUDIO_MIXER
+	// Players are mixed, the others keep playing
+	mpw.addPlayer(shared_from_this());
+#else
 	auto prevPlayer = mpw.getPlayer();
 	auto curPlayer = shared_from_this();
 	if (prevPlayer != curPlayer) {
@@ -315,6 +319,7 @@ void MediaPlayerImpl::startPlayer()
 		}
 		mpw.setPlayer(curPlayer);
 	}
+#endif
 
 	mCurState = PLAYER_STATE_PLAYING;
 	notifyObserver(PLAYER_OBSERVER_COMMAND_STARTED);
@@ -358,9 +363,13 @@ player_result_t MediaPlayerImpl::stopPlayback()
 	}
 
 	mCurState = PLAYER_STATE_READY;
+#ifdef CONFIG_AUDIO_MIXER
+	mpw.removePlayer(shared_from_this());
+#else
 	mpw.setPlayer(nullptr);
+#endif
 
-	audio_manager_result_t result = stop_audio_stream_out();
+	audio_manager_result_t result = stopAudioStreamOut();
 	if (result != AUDIO_MANAGER_SUCCESS) {
 		meddbg("stop_audio_stream_out failed ret : %d\n", result);
 		return PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
@@ -397,18 +406,22 @@ void MediaPlayerImpl::pausePlayer()
 		return;
 	}
 
-	audio_manager_result_t result = pause_audio_stream_out();
+	audio_manager_result_t result = pauseAudioStreamOut();
 	if (result != AUDIO_MANAGER_SUCCESS) {
 		meddbg("pause_audio_stream_in failed ret : %d\n", result);
 		notifyObserver(PLAYER_OBSERVER_COMMAND_PAUSE_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
 		return;
 	}
 
+#ifdef CONFIG_AUDIO_MIXER
+	mpw.removePlayer(shared_from_this());
+#else
 	auto prevPlayer = mpw.getPlayer();
 	auto curPlayer = shared_from_this();
 	if (prevPlayer == curPlayer) {
 		mpw.setPlayer(nullptr);
 	}
+#endif
 	mCurState = PLAYER_STATE_PAUSED;
 	notifyObserver(PLAYER_OBSERVER_COMMAND_PAUSED);
 }
@@ -711,9 +724,7 @@ void MediaPlayerImpl::notifyAsync(player_event_t event)
 	case PLAYER_EVENT_SOURCE_PREPARED: {
 		// Input handler has been opened successfully by InputHandler::doStandBy().
 		// Now setup audio manager and notify player observer the result.
-		auto source = mInputHandler.getDataSource();
-		if (set_audio_stream_out(source->getChannels(), source->getSampleRate(),
-								 source->getPcmFormat()) != AUDIO_MANAGER_SUCCESS) {
+		if (setAudioStreamOut() != AUDIO_MANAGER_SUCCESS) {
 			meddbg("MediaPlayer prepare fail : set_audio_stream_out fail\n");
 			return notifyObserver(PLAYER_OBSERVER_COMMAND_ASYNC_PREPARED, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
 		}
@@ -749,7 +760,7 @@ void MediaPlayerImpl::playback()
 	ssize_t num_read = mInputHandler.read(mBuffer, (int)mBufSize);
 	medvdbg("num_read : %d\n", num_read);
 	if (num_read > 0) {
-		int ret = start_audio_stream_out(mBuffer, get_user_output_bytes_to_frame((unsigned int)num_read));
+		int ret = writeAudioStreamOut(mBuffer, (unsigned int)num_read);
 		if (ret < 0) {
 			notifyObserver(PLAYER_OBSERVER_COMMAND_PLAYBACK_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
 			PlayerWorker &mpw = PlayerWorker::getWorker();
@@ -779,6 +790,76 @@ void MediaPlayerImpl::playback()
 	}
 }
 
+/*
+ * Output of the player: the output card, or a stream of the software mixer
+ * which the other players share the card with.
+ */
+audio_manager_result_t MediaPlayerImpl::setAudioStreamOut()
+{
+	auto source = mInputHandler.getDataSource();
+#ifdef CONFIG_AUDIO_MIXER
+	if (mStreamId >= 0) {
+		// Resumed, the stream stayed open
+		return AUDIO_MANAGER_SUCCESS;
+	}
+
+	audio_manager_result_t result = open_audio_mixer_stream(source->getChannels(), source->getSampleRate(),
+															  source->getPcmFormat(), &mStreamId);
+	if (result != AUDIO_MANAGER_SUCCESS) {
+		mStreamId = -1;
+		return result;
+	}
+	// Mixer streams are 16-bit
+	mFrameSize = source->getChannels() * sizeof(int16_t);
+	return AUDIO_MANAGER_SUCCESS;
+#else
+	return set_audio_stream_out(source->getChannels(), source->getSampleRate(), source->getPcmFormat());
+#endif
+}
+
+audio_manager_result_t MediaPlayerImpl::resetAudioStreamOut()
+{
+#ifdef CONFIG_AUDIO_MIXER
+	if (mStreamId < 0) {
+		return AUDIO_MANAGER_SUCCESS;
+	}
+
+	audio_manager_result_t result = close_audio_mixer_stream(mStreamId);
+	mStreamId = -1;
+	return result;
+#else
+	return reset_audio_stream_out();
+#endif
+}
+
+audio_manager_result_t MediaPlayerImpl::pauseAudioStreamOut()
+{
+#ifdef CONFIG_AUDIO_MIXER
+	// The mixer stops waiting for the stream once its queued frames are played
+	return AUDIO_MANAGER_SUCCESS;
+#else
+	return pause_audio_stream_out();
+#endif
+}
+
+audio_manager_result_t MediaPlayerImpl::stopAudioStreamOut()
+{
+#ifdef CONFIG_AUDIO_MIXER
+	return AUDIO_MANAGER_SUCCESS;
+#else
+	return stop_audio_stream_out();
+#endif
+}
+
+int MediaPlayerImpl::writeAudioStreamOut(unsigned char *buf, unsigned int size)
+{
+#ifdef CONFIG_AUDIO_MIXER
+	return write_audio_mixer_stream(mStreamId, buf, size / mFrameSize);
+#else
+	return start_audio_stream_out(buf, get_user_output_bytes_to_frame(size));
+#endif
+}
+
 MediaPlayerImpl::~MediaPlayerImpl()
 {
 	player_result_t ret;
@@ -19,6 +19,7 @@
 #ifndef __MEDIA_MEDIAPLAYERIMPL_H
 #define __MEDIA_MEDIAPLAYERIMPL_H
 
+#include <tinyara/config.h>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -29,6 +30,7 @@
 
 #include "PlayerObserverWorker.h"
 #include "InputHandler.h"
+#include "audio/audio_manager.h"
 
 namespace media {
 /**
@@ -131,6 +133,12 @@ private:
 	void setPlayerObserver(std::shared_ptr<MediaPlayerObserverInterface> observer);
 	void setPlayerDataSource(std::shared_ptr<stream::InputDataSource> dataSource, player_result_t &ret);
 
+	audio_manager_result_t setAudioStreamOut();
+	audio_manager_result_t resetAudioStreamOut();
+	audio_manager_result_t pauseAudioStreamOut();
+	audio_manager_result_t stopAudioStreamOut();
+	int writeAudioStreamOut(unsigned char *buf, unsigned int size);
+
 private:
 	MediaPlayer &mPlayer;
 	std::atomic<player_state_t> mCurState;
@@ -141,6 +149,10 @@ private:
 	std::shared_ptr<stream_info_t> mStreamInfo;
 	std::shared_ptr<MediaPlayerObserverInterface> mPlayerObserver;
 	stream::InputHandler mInputHandler;
+#ifdef CONFIG_AUDIO_MIXER
+	int mStreamId;
+	unsigned int mFrameSize;
+#endif
 };
 } // namespace media
 #endif
@@ -47,12 +47,28 @@ PlayerWorker& PlayerWorker::getWorker()
 
 bool PlayerWorker::processLoop()
 {
+#ifdef CONFIG_AUDIO_MIXER
+	bool played = false;
+
+	// Each playing player writes a buffer to its mixer stream in turn.
+	// Iterate a copy, playback() removes the player which reaches the end.
+	auto players = mPlayers;
+	for (auto &player : players) {
+		if (player->getState() == PLAYER_STATE_PLAYING) {
+			player->playback();
+			played = true;
+		}
+	}
+
+	return played;
+#else
 	if (mCurPlayer && (mCurPlayer->getState() == PLAYER_STATE_PLAYING)) {
 		mCurPlayer->playback();
 		return true;
 	}
 
 	return false;
+#endif
 }
 
 void PlayerWorker::setPlayer(std::shared_ptr<MediaPlayerImpl> player)
@@ -65,4 +81,21 @@ std::shared_ptr<MediaPlayerImpl> PlayerWorker::getPlayer()
 	return mCurPlayer;
 }
 
+#ifdef CONFIG_AUDIO_MIXER
+void PlayerWorker::addPlayer(std::shared_ptr<MediaPlayerImpl> player)
+{
+	for (auto &p : mPlayers) {
+		if (p == player) {
+			return;
+		}
+	}
+	mPlayers.push_back(player);
+}
+
+void PlayerWorker::removePlayer(std::shared_ptr<MediaPlayerImpl> player)
+{
+	mPlayers.remove(player);
+}
+#endif
+
 } // namespace media
@@ -19,7 +19,11 @@
 #ifndef __MEDIA_PLAYERWORKER_HPP
 #define __MEDIA_PLAYERWORKER_HPP
 
+#include <tinyara/config.h>
 #include <memory>
+#ifdef CONFIG_AUDIO_MIXER
+#include <list>
+#endif
 #include <media/MediaPlayer.h>
 #include "MediaWorker.h"
 
@@ -31,6 +35,10 @@ public:
 
 	void setPlayer(std::shared_ptr<MediaPlayerImpl>);
 	std::shared_ptr<MediaPlayerImpl> getPlayer();
+#ifdef CONFIG_AUDIO_MIXER
+	void addPlayer(std::shared_ptr<MediaPlayerImpl>);
+	void removePlayer(std::shared_ptr<MediaPlayerImpl>);
+#endif
 
 private:
 	PlayerWorker();
@@ -39,6 +47,9 @@ private:
 
 private:
 	std::shared_ptr<MediaPlayerImpl> mCurPlayer;
+#ifdef CONFIG_AUDIO_MIXER
+	std::list<std::shared_ptr<MediaPlayerImpl>> mPlayers;
+#endif
 };
 } // namespace media
 #endif
@@ -82,6 +82,11 @@ size_t StreamBuffer::copy(unsigned char *buf, size_t size, size_t offset)
 	return rb_read_ext(&mRingBuf, (void *)buf, size, offset);
 }
 
+const unsigned char *StreamBuffer::peek(size_t offset, size_t *size)
+{
+	return (const unsigned char *)rb_peek(&mRingBuf, offset, size);
+}
+
 size_t StreamBuffer::read(unsigned char *buf, size_t size)
 {
 	return rb_read(&mRingBuf, buf, size);
@@ -79,6 +79,12 @@ public:
 	 * And we can give an offset where start to copy.
 	 */
 	size_t copy(unsigned char *buf, size_t size, size_t offset = 0);
+	/**
+	 * Get data at the given offset in stream buffer without copying.
+	 * Returns nullptr if there's no data, otherwise the length of the part
+	 * which is contiguous in memory is returned in 'size'.
+	 */
+	const unsigned char *peek(size_t offset, size_t *size);
 	/**
 	 * Read(pop) data from stream buffer.
 	 */
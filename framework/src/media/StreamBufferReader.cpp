@@ -42,6 +42,14 @@ size_t StreamBufferReader::copy(unsigned char *buf, size_t size, size_t offset)
 	return len;
 }
 
+const unsigned char *StreamBufferReader::peek(size_t offset, size_t *size)
+{
+	// Data before the write index is not touched by the writer,
+	// so it's valid until the reader reads it.
+	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	return mStream->peek(offset, size);
+}
+
 size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 {
 	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
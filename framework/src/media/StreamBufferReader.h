@@ -32,6 +32,7 @@ public:
 
 public:
 	virtual size_t copy(unsigned char *buf, size_t size, size_t offset = 0);
+	virtual const unsigned char *peek(size_t offset, size_t *size);
 	virtual size_t read(unsigned char *buf, size_t size, bool sync = true);
 	virtual size_t sizeOfData();
 
@@ -27,12 +27,16 @@
 #include <sys/ioctl.h>
 #include <sys/time.h>
 #include <sys/stat.h>
+#include <time.h>
 #include <mqueue.h>
 #include <tinyara/audio/audio.h>
 #include <tinyalsa/tinyalsa.h>
 
 #include "audio_manager.h"
 #include "resample/samplerate.h"
+#ifdef CONFIG_AUDIO_MIXER
+#include "mixer/audio_mixer.h"
+#endif
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -98,6 +102,16 @@
 
 #define INVALID_ID -1
 
+#ifdef CONFIG_AUDIO_MIXER
+#ifndef CONFIG_AUDIO_MIXER_STREAM_PERIODS
+#define CONFIG_AUDIO_MIXER_STREAM_PERIODS 2
+#endif
+
+#ifndef CONFIG_AUDIO_MIXER_STACKSIZE
+#define CONFIG_AUDIO_MIXER_STACKSIZE 4096
+#endif
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -159,6 +173,21 @@ typedef enum audio_io_direction_e audio_io_direction_t;
 typedef struct audio_device_config_s audio_config_t;
 typedef struct audio_card_info_s audio_card_info_t;
 
+#ifdef CONFIG_AUDIO_MIXER
+struct audio_mixer_info_s {
+	audio_mixer_t mixer;
+	int16_t *buffer;            // a period mixed for the output card
+	int stream_num;             // number of streams opened
+	bool running;               // mixer thread is running
+	pthread_t thread;
+	pthread_mutex_t lifecycle;  // serializes opening and closing the streams
+	pthread_mutex_t mutex;      // protects the mixer between the producers and the mixer thread
+	pthread_cond_t cond;        // signaled when frames are queued or consumed
+};
+
+static struct audio_mixer_info_s g_audio_mixer;
+#endif
+
 static audio_card_info_t g_audio_in_cards[CONFIG_AUDIO_MAX_INPUT_CARD_NUM];
 static audio_card_info_t g_audio_out_cards[CONFIG_AUDIO_MAX_OUTPUT_CARD_NUM];
 
@@ -640,6 +669,12 @@ audio_manager_result_t audio_manager_init(void)
 		return ret;
 	}
 
+#ifdef CONFIG_AUDIO_MIXER
+	pthread_mutex_init(&g_audio_mixer.lifecycle, NULL);
+	pthread_mutex_init(&g_audio_mixer.mutex, NULL);
+	pthread_cond_init(&g_audio_mixer.cond, NULL);
+#endif
+
 	return AUDIO_MANAGER_SUCCESS;
 }
 
@@ -1899,6 +1934,279 @@ audio_manager_result_t get_stream_out_policy(stream_policy_t *policy)
 	return get_stream_policy(policy, OUTPUT);
 }
 
+#ifdef CONFIG_AUDIO_MIXER
+/*
+ * Mixer thread: mixes a period once every stream has queued a period, and
+ * writes it to the card. A stream which is late for half a period is padded
+ * with silence, so that a stalled producer does not underrun the others.
+ */
+static void *audio_mixer_thread(void *arg)
+{
+	struct audio_mixer_info_s *info = (struct audio_mixer_info_s *)arg;
+	unsigned int period = info->mixer.period_frames;
+	unsigned int min_frames;
+	unsigned int max_frames;
+	struct timespec abstime;
+	long wait_nsec;
+	int frames;
+	int ret;
+
+	// Half a period in nanoseconds
+	wait_nsec = (long)((1000000000LL * period / info->mixer.sample_rate) >> 1);
+
+	pthread_mutex_lock(&info->mutex);
+	while (info->running) {
+		audio_mixer_get_queued_range(&info->mixer, &min_frames, &max_frames);
+		if (max_frames == 0) {
+			pthread_cond_wait(&info->cond, &info->mutex);
+			continue;
+		}
+
+		if (min_frames < period) {
+			clock_gettime(CLOCK_REALTIME, &abstime);
+			abstime.tv_nsec += wait_nsec;
+			if (abstime.tv_nsec >= 1000000000L) {
+				abstime.tv_sec++;
+				abstime.tv_nsec -= 1000000000L;
+			}
+			while (info->running && min_frames < period) {
+				if (pthread_cond_timedwait(&info->cond, &info->mutex, &abstime) == ETIMEDOUT) {
+					break;
+				}
+				audio_mixer_get_queued_range(&info->mixer, &min_frames, &max_frames);
+			}
+			if (!info->running) {
+				break;
+			}
+		}
+
+		frames = audio_mixer_mix(&info->mixer, info->buffer, period);
+		pthread_cond_broadcast(&info->cond);
+		pthread_mutex_unlock(&info->mutex);
+
+		if (frames > 0) {
+			ret = start_audio_stream_out(info->buffer, frames);
+			if (ret < 0) {
+				meddbg("Fail to write mixed frames, ret = %d\n", ret);
+			}
+		}
+
+		pthread_mutex_lock(&info->mutex);
+	}
+	pthread_mutex_unlock(&info->mutex);
+
+	return NULL;
+}
+
+static audio_manager_result_t start_audio_mixer(unsigned int sample_rate)
+{
+	audio_manager_result_t ret;
+	unsigned int channel_num;
+	unsigned int rate;
+	pthread_attr_t attr;
+
+	ret = get_supported_capability(OUTPUT, &channel_num);
+	if (ret != AUDIO_MANAGER_SUCCESS) {
+		return ret;
+	}
+
+	// Mix in the format of the card, so that the card stream needs no resampling
+	rate = get_closest_samprate(sample_rate, OUTPUT);
+	if (channel_num > AUDIO_STREAM_CHANNEL_STEREO) {
+		channel_num = AUDIO_STREAM_CHANNEL_STEREO;
+	}
+
+	ret = set_audio_stream_out(channel_num, rate, PCM_FORMAT_S16_LE);
+	if (ret != AUDIO_MANAGER_SUCCESS) {
+		return ret;
+	}
+
+	if (audio_mixer_init(&g_audio_mixer.mixer, channel_num, rate, get_output_frame_count()) != AUDIO_MIXER_ERR_NO_ERROR) {
+		meddbg("audio_mixer_init failed\n");
+		ret = AUDIO_MANAGER_OPERATION_FAIL;
+		goto error_with_stream;
+	}
+
+	g_audio_mixer.buffer = (int16_t *)malloc(get_card_output_frames_to_byte(get_output_frame_count()));
+	if (!g_audio_mixer.buffer) {
+		meddbg("malloc for a mixer buffer is failed\n");
+		ret = AUDIO_MANAGER_OPERATION_FAIL;
+		goto error_with_mixer;
+	}
+
+	g_audio_mixer.running = true;
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, CONFIG_AUDIO_MIXER_STACKSIZE);
+	if (pthread_create(&g_audio_mixer.thread, &attr, audio_mixer_thread, &g_audio_mixer) != 0) {
+		meddbg("Fail to create the mixer thread\n");
+		g_audio_mixer.running = false;
+		ret = AUDIO_MANAGER_OPERATION_FAIL;
+		goto error_with_buffer;
+	}
+	pthread_setname_np(g_audio_mixer.thread, "AudioMixer");
+
+	return AUDIO_MANAGER_SUCCESS;
+
+error_with_buffer:
+	free(g_audio_mixer.buffer);
+	g_audio_mixer.buffer = NULL;
+error_with_mixer:
+	audio_mixer_deinit(&g_audio_mixer.mixer);
+error_with_stream:
+	reset_audio_stream_out();
+	return ret;
+}
+
+static void stop_audio_mixer(void)
+{
+	pthread_mutex_lock(&g_audio_mixer.mutex);
+	g_audio_mixer.running = false;
+	pthread_cond_broadcast(&g_audio_mixer.cond);
+	pthread_mutex_unlock(&g_audio_mixer.mutex);
+
+	pthread_join(g_audio_mixer.thread, NULL);
+
+	if (stop_audio_stream_out() != AUDIO_MANAGER_SUCCESS) {
+		medvdbg("stop_audio_stream_out failed on stopping the mixer\n");
+	}
+	reset_audio_stream_out();
+
+	audio_mixer_deinit(&g_audio_mixer.mixer);
+	free(g_audio_mixer.buffer);
+	g_audio_mixer.buffer = NULL;
+}
+
+audio_manager_result_t open_audio_mixer_stream(unsigned int channels, unsigned int sample_rate, int format, int *stream_id)
+{
+	audio_manager_result_t ret;
+	int id;
+
+	if ((channels == 0) || (sample_rate == 0) || (stream_id == NULL)) {
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	// The mixer takes 16-bit samples only
+	if ((enum pcm_format)format != PCM_FORMAT_S16_LE) {
+		meddbg("Mixer stream format %d is not supported\n", format);
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	pthread_mutex_lock(&g_audio_mixer.lifecycle);
+
+	if (g_audio_mixer.stream_num == 0) {
+		ret = start_audio_mixer(sample_rate);
+		if (ret != AUDIO_MANAGER_SUCCESS) {
+			pthread_mutex_unlock(&g_audio_mixer.lifecycle);
+			return ret;
+		}
+	}
+
+	pthread_mutex_lock(&g_audio_mixer.mutex);
+	id = audio_mixer_open_stream(&g_audio_mixer.mixer, channels, sample_rate, CONFIG_AUDIO_MIXER_STREAM_PERIODS);
+	pthread_mutex_unlock(&g_audio_mixer.mutex);
+
+	if (id < 0) {
+		meddbg("audio_mixer_open_stream failed : %d\n", id);
+		if (g_audio_mixer.stream_num == 0) {
+			stop_audio_mixer();
+		}
+		pthread_mutex_unlock(&g_audio_mixer.lifecycle);
+		return (id == AUDIO_MIXER_ERR_NO_STREAM) ? AUDIO_MANAGER_DEVICE_ALREADY_IN_USE : AUDIO_MANAGER_RESAMPLE_FAIL;
+	}
+
+	g_audio_mixer.stream_num++;
+	*stream_id = id;
+	medvdbg("mixer stream %d opened, %u channels %uHz\n", id, channels, sample_rate);
+
+	pthread_mutex_unlock(&g_audio_mixer.lifecycle);
+	return AUDIO_MANAGER_SUCCESS;
+}
+
+int write_audio_mixer_stream(int stream_id, void *data, unsigned int frames)
+{
+	unsigned int channels;
+	unsigned int written = 0;
+	int ret;
+
+	if (data == NULL) {
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	pthread_mutex_lock(&g_audio_mixer.mutex);
+
+	if (!g_audio_mixer.running || stream_id < 0 || stream_id >= CONFIG_AUDIO_MIXER_MAX_STREAMS ||
+		!g_audio_mixer.mixer.streams[stream_id].used) {
+		pthread_mutex_unlock(&g_audio_mixer.mutex);
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+	channels = g_audio_mixer.mixer.streams[stream_id].channels;
+
+	while (written < frames) {
+		ret = audio_mixer_write(&g_audio_mixer.mixer, stream_id, (const int16_t *)data + written * channels, frames - written);
+		if (ret < 0) {
+			meddbg("audio_mixer_write failed : %d\n", ret);
+			pthread_mutex_unlock(&g_audio_mixer.mutex);
+			return AUDIO_MANAGER_RESAMPLE_FAIL;
+		}
+
+		written += ret;
+		pthread_cond_broadcast(&g_audio_mixer.cond);
+
+		if (written < frames) {
+			// Queue is full, wait for the mixer thread
+			pthread_cond_wait(&g_audio_mixer.cond, &g_audio_mixer.mutex);
+			if (!g_audio_mixer.mixer.streams[stream_id].used) {
+				break;
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&g_audio_mixer.mutex);
+	return written;
+}
+
+audio_manager_result_t set_audio_mixer_stream_gain(int stream_id, uint16_t gain)
+{
+	int ret;
+
+	pthread_mutex_lock(&g_audio_mixer.mutex);
+	ret = audio_mixer_set_gain(&g_audio_mixer.mixer, stream_id, gain);
+	pthread_mutex_unlock(&g_audio_mixer.mutex);
+
+	return (ret == AUDIO_MIXER_ERR_NO_ERROR) ? AUDIO_MANAGER_SUCCESS : AUDIO_MANAGER_INVALID_PARAM;
+}
+
+audio_manager_result_t close_audio_mixer_stream(int stream_id)
+{
+	int ret;
+
+	pthread_mutex_lock(&g_audio_mixer.lifecycle);
+	pthread_mutex_lock(&g_audio_mixer.mutex);
+
+	// Play out the queued frames first
+	while (g_audio_mixer.running && audio_mixer_queued_frames(&g_audio_mixer.mixer, stream_id) > 0) {
+		pthread_cond_wait(&g_audio_mixer.cond, &g_audio_mixer.mutex);
+	}
+
+	ret = audio_mixer_close_stream(&g_audio_mixer.mixer, stream_id);
+	pthread_cond_broadcast(&g_audio_mixer.cond);
+	pthread_mutex_unlock(&g_audio_mixer.mutex);
+
+	if (ret != AUDIO_MIXER_ERR_NO_ERROR) {
+		pthread_mutex_unlock(&g_audio_mixer.lifecycle);
+		return AUDIO_MANAGER_INVALID_PARAM;
+	}
+
+	medvdbg("mixer stream %d closed\n", stream_id);
+	if (--g_audio_mixer.stream_num == 0) {
+		stop_audio_mixer();
+	}
+
+	pthread_mutex_unlock(&g_audio_mixer.lifecycle);
+	return AUDIO_MANAGER_SUCCESS;
+}
+#endif
+
 #ifdef CONFIG_DEBUG_MEDIA_INFO
 void print_audio_card_info(audio_io_direction_t direct)
 {
@@ -653,6 +653,77 @@ audio_manager_result_t get_stream_in_id(int *card_id, int *device_id);
  ****************************************************************************/
 audio_manager_result_t get_stream_out_id(int *card_id, int *device_id);
 
+#ifdef CONFIG_AUDIO_MIXER
+/****************************************************************************
+ * Name: open_audio_mixer_stream
+ *
+ * Description:
+ *   Add a PCM producer to the software mixer of the output card. The first
+ *   stream opens the output card at the closest sample rate supported, and
+ *   starts the mixer thread. Streams in other sample rates or channels are
+ *   converted when written.
+ *
+ * Input parameters:
+ *   channels: number of channels
+ *   sample_rate: sample rate of the stream
+ *   format: audio format of the stream, PCM_FORMAT_S16_LE only
+ *   stream_id: id of the stream opened
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. AUDIO_MANAGER_INVALID_PARAM for
+ *   another format. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t open_audio_mixer_stream(unsigned int channels, unsigned int sample_rate, int format, int *stream_id);
+
+/****************************************************************************
+ * Name: write_audio_mixer_stream
+ *
+ * Description:
+ *   Queue the frames of a stream to be mixed. It blocks while the queue of the
+ *   stream is full.
+ *
+ * Input parameters:
+ *   stream_id: id of the stream
+ *   data: buffer to transfer the frame data
+ *   frames: number of frames to be written
+ *
+ * Return Value:
+ *   On success, the number of frames written. Otherwise, a negative value.
+ ****************************************************************************/
+int write_audio_mixer_stream(int stream_id, void *data, unsigned int frames);
+
+/****************************************************************************
+ * Name: set_audio_mixer_stream_gain
+ *
+ * Description:
+ *   Set the gain of a stream in 4.12 fixed point, AUDIO_MIXER_UNITY_GAIN(4096)
+ *   by default. Gains above AUDIO_MIXER_MAX_GAIN(8x) are clamped.
+ *
+ * Input parameters:
+ *   stream_id: id of the stream
+ *   gain: gain of the stream
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t set_audio_mixer_stream_gain(int stream_id, uint16_t gain);
+
+/****************************************************************************
+ * Name: close_audio_mixer_stream
+ *
+ * Description:
+ *   Remove a stream from the mixer after its queued frames are played.
+ *   Closing the last stream stops the mixer and the output card.
+ *
+ * Input parameters:
+ *   stream_id: id of the stream
+ *
+ * Return Value:
+ *   On success, AUDIO_MANAGER_SUCCESS. Otherwise, a negative value.
+ ****************************************************************************/
+audio_manager_result_t close_audio_mixer_stream(int stream_id);
+#endif
+
 #ifdef CONFIG_DEBUG_MEDIA_INFO
 /****************************************************************************
  * Name: dump_audio_card_info
@@ -0,0 +1,377 @@
+/******************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "audio_mixer.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#ifndef CONFIG_AUDIO_RESAMPLER_BUFSIZE
+#define CONFIG_AUDIO_RESAMPLER_BUFSIZE 4096
+#endif
+
+#define MINIMUM(a, b)   (((a) < (b)) ? (a) : (b))
+#define MAXIMUM(a, b)   (((a) > (b)) ? (a) : (b))
+
+#define RETURN_VAL_IF_FAIL(condition, val) \
+	do { \
+		if (!(condition)) { \
+			return val; \
+		} \
+	} while (0)
+
+// Bytes of a frame in the given channel number, samples are 16 bits
+#define FRAMES_TO_BYTES(frames, channels) ((frames) * (channels) * sizeof(int16_t))
+
+#define CHECK_STREAM_ID(mixer, id) \
+	(((id) >= 0) && ((id) < CONFIG_AUDIO_MIXER_MAX_STREAMS) && (mixer)->streams[(id)].used)
+
+// Sum of the gains up to which full scale samples cannot overflow the accumulators
+#define ACC_GAIN_LIMIT  ((uint32_t)(INT32_MAX / -INT16_MIN))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+/**
+ * @brief   Accumulate samples multiplied by the gain.
+ * @remarks Plain loop over 32-bit accumulators which the compiler vectorizes,
+ *          the gains of the streams must sum to ACC_GAIN_LIMIT at most.
+ */
+static void accumulate(int32_t *acc, const int16_t *input, int32_t samples, int32_t gain)
+{
+	int32_t i;
+
+	for (i = 0; i < samples; i++) {
+		acc[i] += input[i] * gain;
+	}
+}
+
+/**
+ * @brief   Accumulate samples multiplied by the gain, saturating to 32 bits.
+ * @remarks Used when the gains of the streams sum above ACC_GAIN_LIMIT.
+ */
+static void accumulate_saturate(int32_t *acc, const int16_t *input, int32_t samples, int32_t gain)
+{
+	int32_t i;
+	int64_t v;
+
+	for (i = 0; i < samples; i++) {
+		v = (int64_t)acc[i] + input[i] * gain;
+		v = MAXIMUM(v, INT32_MIN);
+		v = MINIMUM(v, INT32_MAX);
+		acc[i] = (int32_t)v;
+	}
+}
+
+/**
+ * @brief   Scale the accumulators back and saturate them to 16 bits.
+ */
+static void saturate(int16_t *output, const int32_t *acc, int32_t samples)
+{
+	int32_t i;
+	int32_t v;
+
+	for (i = 0; i < samples; i++) {
+		v = acc[i] >> AUDIO_MIXER_GAIN_SHIFT;
+		v = MAXIMUM(v, INT16_MIN);
+		v = MINIMUM(v, INT16_MAX);
+		output[i] = (int16_t)v;
+	}
+}
+
+static void release_stream(struct audio_mixer_stream_s *stream)
+{
+	if (stream->src) {
+		src_destroy(stream->src);
+		stream->src = NULL;
+	}
+	free(stream->convert_buffer);
+	stream->convert_buffer = NULL;
+	rb_free(&stream->rb);
+	stream->used = false;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+int audio_mixer_init(audio_mixer_t *mixer, unsigned int channels, unsigned int sample_rate, unsigned int period_frames)
+{
+	RETURN_VAL_IF_FAIL((mixer != NULL), AUDIO_MIXER_ERR_BAD_PARAMS);
+	RETURN_VAL_IF_FAIL(((channels == 1) || (channels == 2)), AUDIO_MIXER_ERR_BAD_PARAMS);
+	RETURN_VAL_IF_FAIL(((sample_rate > 0) && (period_frames > 0)), AUDIO_MIXER_ERR_BAD_PARAMS);
+
+	memset(mixer, 0, sizeof(audio_mixer_t));
+	mixer->channels = channels;
+	mixer->sample_rate = sample_rate;
+	mixer->period_frames = period_frames;
+
+	mixer->acc = (int32_t *)malloc(period_frames * channels * sizeof(int32_t));
+	mixer->period = (int16_t *)malloc(FRAMES_TO_BYTES(period_frames, channels));
+	if (!mixer->acc || !mixer->period) {
+		free(mixer->acc);
+		free(mixer->period);
+		mixer->acc = NULL;
+		mixer->period = NULL;
+		return AUDIO_MIXER_ERR_MALLOC_FAILED;
+	}
+
+	return AUDIO_MIXER_ERR_NO_ERROR;
+}
+
+void audio_mixer_deinit(audio_mixer_t *mixer)
+{
+	int id;
+
+	if (!mixer) {
+		return;
+	}
+
+	for (id = 0; id < CONFIG_AUDIO_MIXER_MAX_STREAMS; id++) {
+		if (mixer->streams[id].used) {
+			release_stream(&mixer->streams[id]);
+		}
+	}
+
+	free(mixer->acc);
+	free(mixer->period);
+	mixer->acc = NULL;
+	mixer->period = NULL;
+}
+
+int audio_mixer_open_stream(audio_mixer_t *mixer, unsigned int channels, unsigned int sample_rate, unsigned int periods)
+{
+	struct audio_mixer_stream_s *stream = NULL;
+	int id;
+
+	RETURN_VAL_IF_FAIL((mixer != NULL), AUDIO_MIXER_ERR_BAD_PARAMS);
+	RETURN_VAL_IF_FAIL(((channels > 0) && (sample_rate > 0) && (periods > 0)), AUDIO_MIXER_ERR_BAD_PARAMS);
+
+	for (id = 0; id < CONFIG_AUDIO_MIXER_MAX_STREAMS; id++) {
+		if (!mixer->streams[id].used) {
+			stream = &mixer->streams[id];
+			break;
+		}
+	}
+	RETURN_VAL_IF_FAIL((stream != NULL), AUDIO_MIXER_ERR_NO_STREAM);
+
+	memset(stream, 0, sizeof(struct audio_mixer_stream_s));
+	stream->idle = true;
+	stream->channels = channels;
+	stream->sample_rate = sample_rate;
+	stream->gain = AUDIO_MIXER_UNITY_GAIN;
+
+	if ((channels != mixer->channels) || (sample_rate != mixer->sample_rate)) {
+		if (!src_is_valid_ratio((float)mixer->sample_rate / (float)sample_rate)) {
+			return AUDIO_MIXER_ERR_BAD_PARAMS;
+		}
+
+		stream->src = src_init(CONFIG_AUDIO_RESAMPLER_BUFSIZE);
+		stream->convert_buffer = (int16_t *)malloc(FRAMES_TO_BYTES(mixer->period_frames, mixer->channels));
+		if (!stream->src || !stream->convert_buffer) {
+			release_stream(stream);
+			return AUDIO_MIXER_ERR_MALLOC_FAILED;
+		}
+	}
+
+	if (!rb_init(&stream->rb, FRAMES_TO_BYTES(mixer->period_frames * periods, mixer->channels))) {
+		release_stream(stream);
+		return AUDIO_MIXER_ERR_MALLOC_FAILED;
+	}
+
+	stream->used = true;
+	return id;
+}
+
+int audio_mixer_close_stream(audio_mixer_t *mixer, int id)
+{
+	RETURN_VAL_IF_FAIL((mixer != NULL), AUDIO_MIXER_ERR_BAD_PARAMS);
+	RETURN_VAL_IF_FAIL(CHECK_STREAM_ID(mixer, id), AUDIO_MIXER_ERR_BAD_PARAMS);
+
+	release_stream(&mixer->streams[id]);
+	return AUDIO_MIXER_ERR_NO_ERROR;
+}
+
+int audio_mixer_set_gain(audio_mixer_t *mixer, int id, uint16_t gain)
+{
+	RETURN_VAL_IF_FAIL((mixer != NULL), AUDIO_MIXER_ERR_BAD_PARAMS);
+	RETURN_VAL_IF_FAIL(CHECK_STREAM_ID(mixer, id), AUDIO_MIXER_ERR_BAD_PARAMS);
+
+	mixer->streams[id].gain = MINIMUM(gain, AUDIO_MIXER_MAX_GAIN);
+	return AUDIO_MIXER_ERR_NO_ERROR;
+}
+
+int audio_mixer_write(audio_mixer_t *mixer, int id, const int16_t *data, unsigned int frames)
+{
+	struct audio_mixer_stream_s *stream;
+	size_t frame_bytes;
+	unsigned int used = 0;
+	unsigned int room;
+	src_data_t src_data;
+	int ret;
+
+	RETURN_VAL_IF_FAIL((mixer != NULL) && (data != NULL), AUDIO_MIXER_ERR_BAD_PARAMS);
+	RETURN_VAL_IF_FAIL(CHECK_STREAM_ID(mixer, id), AUDIO_MIXER_ERR_BAD_PARAMS);
+
+	stream = &mixer->streams[id];
+	frame_bytes = FRAMES_TO_BYTES(1, mixer->channels);
+	if (frames > 0) {
+		stream->idle = false;
+	}
+
+	if (!stream->src) {
+		room = rb_avail(&stream->rb) / frame_bytes;
+		used = MINIMUM(frames, room);
+		rb_write(&stream->rb, data, used * frame_bytes);
+		return used;
+	}
+
+	memset(&src_data, 0, sizeof(src_data_t));
+	src_data.origin_sample_rate = stream->sample_rate;
+	src_data.origin_sample_width = SAMPLE_WIDTH_16BITS;
+	src_data.origin_channel_num = stream->channels;
+	src_data.desired_sample_rate = mixer->sample_rate;
+	src_data.desired_sample_width = SAMPLE_WIDTH_16BITS;
+	src_data.desired_channel_num = mixer->channels;
+	src_data.data_out = stream->convert_buffer;
+
+	while (used < frames) {
+		room = MINIMUM(rb_avail(&stream->rb) / frame_bytes, mixer->period_frames);
+		if (room == 0) {
+			break;
+		}
+
+		src_data.data_in = data + used * stream->channels;
+		src_data.input_frames = frames - used;
+		src_data.out_buf_length = room * frame_bytes;
+
+		ret = src_simple(stream->src, &src_data);
+		RETURN_VAL_IF_FAIL((ret == SRC_ERR_NO_ERROR), AUDIO_MIXER_ERR_UNKNOWN);
+
+		rb_write(&stream->rb, stream->convert_buffer, src_data.output_frames_gen * frame_bytes);
+		used += src_data.input_frames_used;
+
+		if ((src_data.input_frames_used == 0) && (src_data.output_frames_gen == 0)) {
+			break;
+		}
+	}
+
+	return used;
+}
+
+unsigned int audio_mixer_queued_frames(audio_mixer_t *mixer, int id)
+{
+	RETURN_VAL_IF_FAIL((mixer != NULL), 0);
+	RETURN_VAL_IF_FAIL(CHECK_STREAM_ID(mixer, id), 0);
+
+	return rb_used(&mixer->streams[id].rb) / FRAMES_TO_BYTES(1, mixer->channels);
+}
+
+int audio_mixer_get_queued_range(audio_mixer_t *mixer, unsigned int *min_frames, unsigned int *max_frames)
+{
+	unsigned int queued;
+	int count = 0;
+	int id;
+
+	RETURN_VAL_IF_FAIL((mixer != NULL) && (min_frames != NULL) && (max_frames != NULL), AUDIO_MIXER_ERR_BAD_PARAMS);
+
+	*min_frames = 0;
+	*max_frames = 0;
+
+	for (id = 0; id < CONFIG_AUDIO_MIXER_MAX_STREAMS; id++) {
+		if (!mixer->streams[id].used || mixer->streams[id].idle) {
+			continue;
+		}
+
+		queued = audio_mixer_queued_frames(mixer, id);
+		*min_frames = count ? MINIMUM(*min_frames, queued) : queued;
+		*max_frames = MAXIMUM(*max_frames, queued);
+		count++;
+	}
+
+	return count;
+}
+
+int audio_mixer_mix(audio_mixer_t *mixer, int16_t *output, unsigned int frames)
+{
+	struct audio_mixer_stream_s *stream;
+	struct audio_mixer_stream_s *single = NULL;
+	size_t frame_bytes;
+	unsigned int queued;
+	unsigned int mixed = 0;
+	uint32_t gains = 0;
+	int sources = 0;
+	int id;
+
+	RETURN_VAL_IF_FAIL((mixer != NULL) && (output != NULL), AUDIO_MIXER_ERR_BAD_PARAMS);
+
+	frame_bytes = FRAMES_TO_BYTES(1, mixer->channels);
+	frames = MINIMUM(frames, mixer->period_frames);
+
+	for (id = 0; id < CONFIG_AUDIO_MIXER_MAX_STREAMS; id++) {
+		stream = &mixer->streams[id];
+		if (!stream->used) {
+			continue;
+		}
+		// A paused or stopped producer is not waited for until it writes again
+		if (rb_used(&stream->rb) < frame_bytes) {
+			stream->idle = true;
+		} else {
+			single = stream;
+			mixed = MAXIMUM(mixed, MINIMUM(frames, rb_used(&stream->rb) / frame_bytes));
+			gains += stream->gain;
+			sources++;
+		}
+	}
+
+	if (sources == 0) {
+		return 0;
+	}
+
+	// Only one producer in unity gain, nothing to mix
+	if ((sources == 1) && (single->gain == AUDIO_MIXER_UNITY_GAIN)) {
+		return rb_read(&single->rb, output, mixed * frame_bytes) / frame_bytes;
+	}
+
+	memset(mixer->acc, 0, mixed * mixer->channels * sizeof(int32_t));
+
+	for (id = 0; id < CONFIG_AUDIO_MIXER_MAX_STREAMS; id++) {
+		stream = &mixer->streams[id];
+		if (!stream->used) {
+			continue;
+		}
+
+		queued = rb_read(&stream->rb, mixer->period, mixed * frame_bytes) / frame_bytes;
+		if (queued == 0) {
+			continue;
+		}
+		if (gains <= ACC_GAIN_LIMIT) {
+			accumulate(mixer->acc, mixer->period, queued * mixer->channels, stream->gain);
+		} else {
+			accumulate_saturate(mixer->acc, mixer->period, queued * mixer->channels, stream->gain);
+		}
+	}
+
+	saturate(output, mixer->acc, mixed * mixer->channels);
+
+	return mixed;
+}
@@ -0,0 +1,171 @@
+/******************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef AUDIO_MIXER_H
+#define AUDIO_MIXER_H
+
+#include <tinyara/config.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../resample/samplerate.h"
+#include "../../utils/rb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#ifndef CONFIG_AUDIO_MIXER_MAX_STREAMS
+#define CONFIG_AUDIO_MIXER_MAX_STREAMS 4
+#endif
+
+// Gain of a stream is a 4.12 fixed point value
+#define AUDIO_MIXER_GAIN_SHIFT  (12)
+#define AUDIO_MIXER_UNITY_GAIN  (1 << AUDIO_MIXER_GAIN_SHIFT)
+#define AUDIO_MIXER_MAX_GAIN    (AUDIO_MIXER_UNITY_GAIN * 8)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+/**
+ * @enum  Define error codes.
+ * @brief AUDIO_MIXER_ERR_NO_ERROR means success, negative values mean failure.
+ */
+enum {
+	AUDIO_MIXER_ERR_NO_STREAM = -4,
+	AUDIO_MIXER_ERR_MALLOC_FAILED = -3,
+	AUDIO_MIXER_ERR_BAD_PARAMS = -2,
+	AUDIO_MIXER_ERR_UNKNOWN = -1,
+	AUDIO_MIXER_ERR_NO_ERROR = 0,
+};
+
+/**
+ * @structure audio_mixer_stream_s
+ * @brief     A PCM producer of the mixer. Frames are converted to the mixer
+ *            format when written, and queued until mixed.
+ */
+struct audio_mixer_stream_s {
+	bool used;
+	bool idle;                  // ran dry and not written since, the mixer does not wait for it
+	unsigned int channels;      // channel number of the producer
+	unsigned int sample_rate;   // sample rate of the producer
+	uint16_t gain;              // 4.12 fixed point gain
+	src_handle_t src;           // resampler/rechanneler, NULL if the producer has the mixer format
+	int16_t *convert_buffer;    // a period of converted frames before queued
+	rb_t rb;                    // queue of frames in the mixer format
+};
+
+/**
+ * @structure audio_mixer_s
+ * @brief     Mixer of 16-bit PCM streams in the format of the output card.
+ */
+struct audio_mixer_s {
+	unsigned int channels;      // channel number of the output
+	unsigned int sample_rate;   // sample rate of the output
+	unsigned int period_frames; // maximum frames mixed at once
+	int32_t *acc;               // accumulator of a period
+	int16_t *period;            // a period read from a stream queue
+	struct audio_mixer_stream_s streams[CONFIG_AUDIO_MIXER_MAX_STREAMS];
+};
+
+typedef struct audio_mixer_s audio_mixer_t;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/**
+ * @brief   Initialize the mixer for the output format.
+ * @param   mixer: pointer to a mixer object.
+ * @param   channels: channel number of the output, 1 or 2.
+ * @param   sample_rate: sample rate of the output.
+ * @param   period_frames: number of frames mixed at once, e.g. the period size of the card.
+ * @return  0 on success, otherwise, it means failure.
+ * @see     audio_mixer_deinit()
+ */
+int audio_mixer_init(audio_mixer_t *mixer, unsigned int channels, unsigned int sample_rate, unsigned int period_frames);
+
+/**
+ * @brief   Close all the streams and release the buffers of the mixer.
+ * @param   mixer: pointer to a mixer object.
+ */
+void audio_mixer_deinit(audio_mixer_t *mixer);
+
+/**
+ * @brief   Add a producer to the mixer.
+ * @remarks A resampler is created if the format differs from the output.
+ * @param   mixer: pointer to a mixer object.
+ * @param   channels: channel number of the producer.
+ * @param   sample_rate: sample rate of the producer.
+ * @param   periods: depth of the queue of the stream, in periods of the mixer.
+ * @return  id of the stream on success, otherwise, a negative value.
+ * @see     audio_mixer_close_stream()
+ */
+int audio_mixer_open_stream(audio_mixer_t *mixer, unsigned int channels, unsigned int sample_rate, unsigned int periods);
+
+/**
+ * @brief   Remove a producer from the mixer, its queued frames are dropped.
+ * @return  0 on success, otherwise, it means failure.
+ */
+int audio_mixer_close_stream(audio_mixer_t *mixer, int id);
+
+/**
+ * @brief   Set the gain of a stream, AUDIO_MIXER_UNITY_GAIN by default.
+ * @remarks Gains above AUDIO_MIXER_MAX_GAIN are clamped to it.
+ * @return  0 on success, otherwise, it means failure.
+ */
+int audio_mixer_set_gain(audio_mixer_t *mixer, int id, uint16_t gain);
+
+/**
+ * @brief   Convert and queue the frames of a producer.
+ * @remarks It takes frames as many as the queue of the stream has room for.
+ * @param   data: interleaved 16-bit frames in the format of the producer.
+ * @param   frames: number of frames in data.
+ * @return  number of frames taken, otherwise, a negative value.
+ */
+int audio_mixer_write(audio_mixer_t *mixer, int id, const int16_t *data, unsigned int frames);
+
+/**
+ * @brief   Get the number of frames queued in a stream.
+ */
+unsigned int audio_mixer_queued_frames(audio_mixer_t *mixer, int id);
+
+/**
+ * @brief   Get the least and the most number of frames queued among the open streams.
+ * @remarks Idle streams, which are open but not written, are not counted.
+ * @return  number of streams counted.
+ */
+int audio_mixer_get_queued_range(audio_mixer_t *mixer, unsigned int *min_frames, unsigned int *max_frames);
+
+/**
+ * @brief   Mix the queued frames of all the streams with their gains.
+ * @remarks The result saturates to 16 bits. A stream with less frames queued
+ *          than the others is padded with silence.
+ * @param   output: buffer for the mixed frames in the output format.
+ * @param   frames: maximum frames to mix, up to the period of the mixer.
+ * @return  number of frames mixed, 0 if no frame is queued.
+ */
+int audio_mixer_mix(audio_mixer_t *mixer, int16_t *output, unsigned int frames);
+
+#ifdef __cplusplus
+}		/* extern "C" */
+#endif	/* __cplusplus */
+
+#endif	/* AUDIO_MIXER_H */
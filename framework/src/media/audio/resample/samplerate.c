@@ -24,6 +24,7 @@
 ** file at : https://github.com/erikd/libsamplerate/blob/master/COPYING
 */
 
+#include <tinyara/config.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -32,6 +33,10 @@
 #include "samplerate.h"
 #include "../../utils/remix.h"
 
+#if defined(CONFIG_AUDIO_RESAMPLER_POLYPHASE) && defined(__ARM_FEATURE_DSP)
+#include <arm_acle.h>
+#endif
+
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -93,6 +98,17 @@
 // Check src context initialized or not
 #define CHECK_SRC_CONTEXT_INIT(src) ((src)->in_buffer != NULL)
 
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+// Coefficients of the phase tables are Q15 fixed point values
+#define POLYPHASE_COEFF_BITS    (15)
+
+// Cutoff of the anti-aliasing filter, relative to the lower Nyquist frequency
+#define POLYPHASE_ROLLOFF       (0.9f)
+
+// Kaiser window parameter, about 70dB stopband attenuation
+#define POLYPHASE_KAISER_BETA   (7.0f)
+#endif
+
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
@@ -119,6 +135,14 @@ struct src_context_s {
 	float ratio;            // (float)new_sample_rate / (float)old_sample_rate
 	float inverse_ratio;    // (float)old_sample_rate / (float)new_sample_rate
 	uint32_t fp_frac;       // fraction part value of last fixed point index
+	int out_buffer_frames;  // capability of the external output buffer in frames
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	int16_t *phase_table;   // phase_num x taps Q15 coefficients, NULL if polyphase is not used
+	int32_t taps;           // number of coefficients (input frames) per phase
+	int32_t phase_num;      // L of the reduced ratio L/M = new_sample_rate/old_sample_rate
+	int32_t phase_step;     // M of the reduced ratio
+	int32_t phase;          // current phase in [0, phase_num)
+#endif
 	/**
 	 * @brief   Function pointer to resampling process function
 	 * @param   src_context_t *: pointer to resampler object.
@@ -244,6 +268,231 @@ static int32_t downresample_int(src_context_t *src, int32_t *num_frames_in)
 	return num_frames_out;
 }
 
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+/**
+ * @brief   Dot product of a phase with mono input frames.
+ * @remarks taps is a multiple of 4, the loop is vectorized by the compiler,
+ *          or uses dual 16-bit MAC (SMLAD) on the ARM cores with DSP extension.
+ */
+static inline int32_t polyphase_dot_mono(const int16_t *input, const int16_t *coeff, int32_t taps)
+{
+	int32_t sum = 1 << (POLYPHASE_COEFF_BITS - 1);
+	int32_t i;
+#ifdef __ARM_FEATURE_DSP
+	uint32_t x;
+	uint32_t c;
+
+	for (i = 0; i < taps; i += 2) {
+		memcpy(&x, input + i, sizeof(x));
+		memcpy(&c, coeff + i, sizeof(c));
+		sum = __smlad(x, c, sum);
+	}
+#else
+	for (i = 0; i < taps; i++) {
+		sum += input[i] * coeff[i];
+	}
+#endif
+	return sum >> POLYPHASE_COEFF_BITS;
+}
+
+/**
+ * @brief   Dot product of a phase with interleaved stereo input frames.
+ * @remarks Both channels share the coefficient loads.
+ */
+static inline void polyphase_dot_stereo(const int16_t *input, const int16_t *coeff, int32_t taps, int32_t *left, int32_t *right)
+{
+	int32_t sum_l = 1 << (POLYPHASE_COEFF_BITS - 1);
+	int32_t sum_r = 1 << (POLYPHASE_COEFF_BITS - 1);
+	int32_t i;
+#ifdef __ARM_FEATURE_DSP
+	uint32_t f0;
+	uint32_t f1;
+	uint32_t c;
+
+	for (i = 0; i < taps; i += 2) {
+		memcpy(&f0, input + 2 * i, sizeof(f0));
+		memcpy(&f1, input + 2 * i + 2, sizeof(f1));
+		memcpy(&c, coeff + i, sizeof(c));
+		sum_l = __smlabb(f0, c, sum_l);
+		sum_l = __smlabt(f1, c, sum_l);
+		sum_r = __smlatb(f0, c, sum_r);
+		sum_r = __smlatt(f1, c, sum_r);
+	}
+#else
+	for (i = 0; i < taps; i++) {
+		sum_l += input[2 * i] * coeff[i];
+		sum_r += input[2 * i + 1] * coeff[i];
+	}
+#endif
+	*left = sum_l >> POLYPHASE_COEFF_BITS;
+	*right = sum_r >> POLYPHASE_COEFF_BITS;
+}
+
+/**
+ * It handles all the ratios whose reduced fraction L/M has no more than
+ * CONFIG_AUDIO_RESAMPLER_POLYPHASE_MAX_PHASES phases, e.g. 44.1K<->48K,
+ * 44.1K<->16K, 48K<->16K, 16K<->8K.
+ * Output frame k is the dot product of phase (k * M) % L with the input frames
+ * from (k * M) / L, so the filtering is done only for the generated frames.
+ */
+static int32_t resample_polyphase(src_context_t *src, int32_t *num_frames_in)
+{
+	const int16_t *input = src->in_buffer;
+	int16_t *output = src->out_buffer;
+	int32_t taps = src->taps;
+	int32_t phase_num = src->phase_num;
+	int32_t step_int = src->phase_step / phase_num;
+	int32_t step_frac = src->phase_step % phase_num;
+	int32_t phase = src->phase;
+	int32_t frames = *num_frames_in;
+	int32_t num_frames_out = 0;
+	int32_t base = 0;
+	int32_t left;
+	int32_t right;
+	const int16_t *coeff;
+
+	if (src->new_channel_num == 2) {
+		while (base < frames && num_frames_out < src->out_buffer_frames) {
+			coeff = src->phase_table + phase * taps;
+			polyphase_dot_stereo(input + base * 2, coeff, taps, &left, &right);
+			*output++ = clip(left);
+			*output++ = clip(right);
+			num_frames_out++;
+
+			base += step_int;
+			phase += step_frac;
+			if (phase >= phase_num) {
+				phase -= phase_num;
+				base++;
+			}
+		}
+	} else {
+		while (base < frames && num_frames_out < src->out_buffer_frames) {
+			coeff = src->phase_table + phase * taps;
+			*output++ = clip(polyphase_dot_mono(input + base, coeff, taps));
+			num_frames_out++;
+
+			base += step_int;
+			phase += step_frac;
+			if (phase >= phase_num) {
+				phase -= phase_num;
+				base++;
+			}
+		}
+	}
+
+	// base may pass the given frames by the step, but not the overlap frames reserved
+	*num_frames_in = base;
+	src->phase = phase;
+	return num_frames_out;
+}
+
+/**
+ * @brief   Zeroth order modified Bessel function of the first kind, for Kaiser window.
+ */
+static float bessel_i0(float x)
+{
+	float sum = 1.0f;
+	float term = 1.0f;
+	int k;
+
+	for (k = 1; k < 32; k++) {
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+		if (term < sum * FLOAT_ACCURACY) {
+			break;
+		}
+	}
+	return sum;
+}
+
+static int32_t gcd(int32_t a, int32_t b)
+{
+	int32_t t;
+
+	while (b) {
+		t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
+
+/**
+ * @brief   Build the phase tables of the Kaiser windowed sinc filter for polyphase resampling.
+ * @remarks The prototype filter runs at L * old_sample_rate. Phase p holds the taps
+ *          p, p + L, p + 2L, ... in reverse order, so that it is applied forward to the input.
+ * @param   src: pointer to resampler object.
+ * @return  0 on success, SRC_ERR_NOT_SUPPORT if the ratio needs too many phases,
+ *          SRC_ERR_MALLOC_FAILED if the tables cannot be allocated.
+ */
+static int init_polyphase(src_context_t *src)
+{
+	int32_t divisor = gcd(src->new_sample_rate, src->old_sample_rate);
+	int32_t phase_num = src->new_sample_rate / divisor;
+	int32_t phase_step = src->old_sample_rate / divisor;
+	int32_t taps = CONFIG_AUDIO_RESAMPLER_POLYPHASE_TAPS;
+	int32_t p, i, j;
+	float cutoff;
+	float center;
+	float i0_beta;
+	float x;
+	float sum;
+	float coeff;
+
+	RETURN_VAL_IF_FAIL((phase_num <= CONFIG_AUDIO_RESAMPLER_POLYPHASE_MAX_PHASES), SRC_ERR_NOT_SUPPORT);
+
+	// Down resampling narrows the passband, it takes more input frames for the same transition band
+	if (phase_step > phase_num) {
+		taps = (taps * phase_step + phase_num - 1) / phase_num;
+	}
+	// Multiple of 4 for the vectorized dot products
+	taps = (taps + 3) & ~3;
+
+	src->phase_table = (int16_t *)malloc(phase_num * taps * sizeof(int16_t));
+	RETURN_VAL_IF_FAIL((src->phase_table != NULL), SRC_ERR_MALLOC_FAILED);
+
+	src->taps = taps;
+	src->phase_num = phase_num;
+	src->phase_step = phase_step;
+	src->phase = 0;
+
+	// Cutoff in cycles per sample of the prototype filter
+	cutoff = POLYPHASE_ROLLOFF * 0.5f / (float)MAXIMUM(phase_num, phase_step);
+	center = (float)(phase_num * taps - 1) / 2.0f;
+	i0_beta = bessel_i0(POLYPHASE_KAISER_BETA);
+
+	for (p = 0; p < phase_num; p++) {
+		// Twice for each phase: sum of the phase first, then normalize it to unity DC gain
+		sum = 0.0f;
+		for (j = 0; j < 2; j++) {
+			for (i = 0; i < taps; i++) {
+				x = (float)(p + (taps - 1 - i) * phase_num) - center;
+				coeff = 2.0f * cutoff;
+				if (!FLOAT_EQUAL(x, 0.0f)) {
+					coeff = sinf(2.0f * (float)M_PI * cutoff * x) / ((float)M_PI * x);
+				}
+				x /= center + 1.0f;
+				coeff *= bessel_i0(POLYPHASE_KAISER_BETA * sqrtf(MAXIMUM(0.0f, 1.0f - x * x))) / i0_beta;
+
+				if (j == 0) {
+					sum += coeff;
+				} else {
+					// LRINTPF() rounds positive values only
+					src->phase_table[p * taps + i] = clip(LRINTPF(coeff / sum * (1 << POLYPHASE_COEFF_BITS) + 32768.0f) - 32768);
+				}
+			}
+		}
+	}
+
+	src->overlap_frames = taps - 1;
+	src->filter_coeff = NULL;
+	src->src_func = resample_polyphase;
+
+	return SRC_ERR_NO_ERROR;
+}
+#endif
+
 /**
  * @brief   Do filtering once new frames added to internal buffer.
  * @param   src: pointer to resampler object.
@@ -314,6 +563,10 @@ static int check_src_data(src_context_t *src, src_data_t *src_data)
  */
 static int init_src_context(src_context_t *src, src_data_t *src_data)
 {
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	int ret;
+#endif
+
 	// Allocate internal buffer
 	src->in_buffer = (int16_t *)malloc(src->in_buffer_bytes);
 	RETURN_VAL_IF_FAIL((src->in_buffer != NULL), SRC_ERR_MALLOC_FAILED);
@@ -334,6 +587,19 @@ static int init_src_context(src_context_t *src, src_data_t *src_data)
 	src->ratio = (float)src->new_sample_rate / (float)src->old_sample_rate;
 	src->inverse_ratio = (float)src->old_sample_rate / (float)src->new_sample_rate;
 
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	src->phase_table = NULL;
+	ret = init_polyphase(src);
+	if (ret != SRC_ERR_NOT_SUPPORT) {
+		if (ret != SRC_ERR_NO_ERROR) {
+			free(src->in_buffer);
+			src->in_buffer = NULL;
+		}
+		return ret;
+	}
+	// Too many phases for the ratio, fall back to the interpolation below
+#endif
+
 	// Set overlap frame number and converting function as per converting ratio
 	if (src->old_sample_rate > src->new_sample_rate) {
 		// down resampling
@@ -378,6 +644,9 @@ src_handle_t src_init(int size)
 	src->in_buffer_bytes = (((size + max_frame_size - 1) / max_frame_size) * max_frame_size);
 	src->in_buffer_frames = 0;
 	src->in_buffer = NULL;
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	src->phase_table = NULL;
+#endif
 	// Other members will be initilized before first use,
 	// as soon as in_buffer allocated in init_src_context().
 
@@ -392,6 +661,11 @@ int src_destroy(src_handle_t handle)
 	free(src->in_buffer);
 	src->in_buffer = NULL;
 
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	free(src->phase_table);
+	src->phase_table = NULL;
+#endif
+
 	free(src);
 	return SRC_ERR_NO_ERROR;
 }
@@ -442,12 +716,15 @@ int src_simple(src_handle_t handle, src_data_t *src_data)
 
 	// Update output buffer to src context (used in converting proccess functions)
 	src->out_buffer = (int16_t *)src_data->data_out;
-
-	// Move remaining frames in internal buffer
-	if ((src->used_frames > 0) && (src->left_frames > 0)) {
-		memcpy((void *)src->in_buffer, \
-			(const void *)((int8_t *)src->in_buffer + NEW_FRAMES_TO_BYTES(src, src->used_frames)), \
-			NEW_FRAMES_TO_BYTES(src, src->left_frames));
+	src->out_buffer_frames = out_buffer_frames;
+
+	// Move remaining frames in internal buffer, the regions may overlap
+	if (src->used_frames > 0) {
+		if (src->left_frames > 0) {
+			memmove((void *)src->in_buffer, \
+				(const void *)((int8_t *)src->in_buffer + NEW_FRAMES_TO_BYTES(src, src->used_frames)), \
+				NEW_FRAMES_TO_BYTES(src, src->left_frames));
+		}
 		src->used_frames = 0;
 	}
 
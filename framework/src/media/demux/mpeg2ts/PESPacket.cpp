@@ -23,7 +23,7 @@
 #define PACKET_LENGTH(buffer)   ((buffer[4] << 8) | buffer[5])
 #define PES_PACKET_HEAD_BYTES   (6) // packet_start_code_prefix + stream_id + PES_packet_length
 
-std::shared_ptr<PESPacket> PESPacket::create(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size)
+std::shared_ptr<PESPacket> PESPacket::create(ts_pid_t pid, uint8_t continuityCounter, const uint8_t *pData, uint16_t size)
 {
 	auto instance = std::make_shared<PESPacket>();
 	if (instance && instance->initialize(pid, continuityCounter, pData, size)) {
@@ -34,7 +34,7 @@ std::shared_ptr<PESPacket> PESPacket::create(ts_pid_t pid, uint8_t continuityCou
 	return nullptr;
 }
 
-uint16_t PESPacket::parseLengthField(uint8_t *pData, uint16_t size)
+uint16_t PESPacket::parseLengthField(const uint8_t *pData, uint16_t size)
 {
 	return (PES_PACKET_HEAD_BYTES + PACKET_LENGTH(pData));
 }
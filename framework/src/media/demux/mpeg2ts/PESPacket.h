@@ -27,7 +27,7 @@ class PESPacket : public Section
 {
 public:
 	// should always use this static method to create a new PESPacket instance
-	static std::shared_ptr<PESPacket> create(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size);
+	static std::shared_ptr<PESPacket> create(ts_pid_t pid, uint8_t continuityCounter, const uint8_t *pData, uint16_t size);
 	// constructor and destructor
 	PESPacket() {}
 	virtual ~PESPacket() {}
@@ -35,7 +35,7 @@ public:
 protected:
 	// parse length field from the given data
 	// return length value of the PES packet.
-	virtual uint16_t parseLengthField(uint8_t *pData, uint16_t size) override;
+	virtual uint16_t parseLengthField(const uint8_t *pData, uint16_t size) override;
 };
 
 #endif /* __PES_PACKET_H */
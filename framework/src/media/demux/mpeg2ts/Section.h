@@ -26,14 +26,17 @@ class Section
 {
 public:
 	// should always use this static method to create a new section instance
-	static std::shared_ptr<Section> create(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size);
+	static std::shared_ptr<Section> create(ts_pid_t pid, uint8_t continuityCounter, const uint8_t *pData, uint16_t size);
 	// constructor and destructor
 	Section();
 	virtual ~Section();
-	// initialize section member and allocate data buffer
-	bool initialize(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size);
+	// initialize section member and allocate data buffer,
+	// the data buffer is reused if it's big enough, so a section object can be recycled.
+	bool initialize(ts_pid_t pid, uint8_t continuityCounter, const uint8_t *pData, uint16_t size);
+	// allocate data buffer of the given size ahead, to avoid allocation in initialize()
+	bool reserve(uint16_t size);
 	// append new section data from ts packet payload
-	bool appendData(ts_pid_t pid, uint8_t continuityCounter, uint8_t *pData, uint16_t size);
+	bool appendData(ts_pid_t pid, uint8_t continuityCounter, const uint8_t *pData, uint16_t size);
 	// verify mpeg2 crc32
 	bool verifyCrc32(void);
 	// check if section is completed
@@ -49,7 +52,7 @@ protected:
 	// parse length field from the given data
 	// return length value of the object, in this class it's section_length
 	// derived class can override this method to get it's own length field.
-	virtual uint16_t parseLengthField(uint8_t *pData, uint16_t size);
+	virtual uint16_t parseLengthField(const uint8_t *pData, uint16_t size);
 	// calculates the MPEG2 32 bit CRC
 	uint32_t crc32(uint8_t *data, uint32_t length);
 
@@ -60,6 +63,8 @@ private:
 	uint8_t mContinuityCounter;
 	// section data buffer allocated
 	uint8_t *mSectionData;
+	// size in bytes of section data buffer allocated
+	uint16_t mSectionBufferSize;
 	// total data length in bytes of a completed section
 	uint16_t mSectionDataLen;
 	// present data length in section data buffer
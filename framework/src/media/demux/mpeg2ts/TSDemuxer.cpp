@@ -40,10 +40,20 @@
 // threshold is not used, we don't have any buffer observer now.
 #define TS_DEMUX_BUFFER_THRESHOLD   (CONFIG_DEMUX_BUFFER_SIZE / 2)
 
+#ifndef CONFIG_CONTAINER_MPEG2TS_PES_ARENA_SIZE
+#define CONFIG_CONTAINER_MPEG2TS_PES_ARENA_SIZE (8192)
+#endif
+
 namespace media {
 
 TSDemuxer::TSDemuxer()
 	: Demuxer(AUDIO_TYPE_MP2T)
+#ifdef CONFIG_CONTAINER_MPEG2TS_INPLACE
+	, mPESStarted(false)
+	, mPeekData(nullptr)
+	, mPeekLen(0)
+	, mPeekOffset(0)
+#endif
 	, mPESPid(INVALID_PID)
 	, mPESDataUsed(0)
 {
@@ -102,6 +112,16 @@ bool TSDemuxer::initialize(void)
 		return false;
 	}
 
+#ifdef CONFIG_CONTAINER_MPEG2TS_INPLACE
+	// PES packets are reassembled in this packet, allocate the buffer ahead.
+	// It grows only if a bigger PES packet comes.
+	mPESPacket = std::make_shared<PESPacket>();
+	if (!mPESPacket || !mPESPacket->reserve(CONFIG_CONTAINER_MPEG2TS_PES_ARENA_SIZE)) {
+		meddbg("mPESPacket is nullptr!\n");
+		return false;
+	}
+#endif
+
 	return true;
 }
 
@@ -274,11 +294,11 @@ int TSDemuxer::resync(uint8_t *pPacketData, size_t readOffset)
 	return DEMUXER_ERROR_SYNC_FAILED;
 }
 
-std::shared_ptr<Section> TSDemuxer::PSIUnpack(std::shared_ptr<TSPacket> pTSPacket)
+std::shared_ptr<Section> TSDemuxer::PSIUnpack(const std::shared_ptr<TSPacket> &pTSPacket)
 {
 	std::shared_ptr<Section> pSection = nullptr;
 	uint8_t  lenPayload = 0;
-	uint8_t *ptrPayload = pTSPacket->getPayloadData(&lenPayload);
+	const uint8_t *ptrPayload = pTSPacket->getPayloadData(&lenPayload);
 
 	if (!ptrPayload) {
 		// no payload
@@ -333,17 +353,34 @@ std::shared_ptr<Section> TSDemuxer::PSIUnpack(std::shared_ptr<TSPacket> pTSPacke
 	return pSection;
 }
 
-std::shared_ptr<PESPacket> TSDemuxer::PESUnpack(std::shared_ptr<TSPacket> pTSPacket)
+std::shared_ptr<PESPacket> TSDemuxer::PESUnpack(const std::shared_ptr<TSPacket> &pTSPacket)
 {
 	std::shared_ptr<PESPacket> pPESPacket = nullptr;
 	uint8_t  lenPayload = 0;
-	uint8_t *ptrPayload = pTSPacket->getPayloadData(&lenPayload);
+	const uint8_t *ptrPayload = pTSPacket->getPayloadData(&lenPayload);
 
 	if (!ptrPayload) {
 		// no payload
 		return pPESPacket;
 	}
 
+#ifdef CONFIG_CONTAINER_MPEG2TS_INPLACE
+	// Only the audio PID is unpacked, so one PES packet object is reused.
+	// The previous PES packet has been consumed by the PES parser before
+	// a new one is requested, see pullData().
+	if (pTSPacket->payloadUnitStartIndicator()) {
+		medvdbg("new PES packet (PID:%u) start...\n", pTSPacket->getPid());
+		mPESStarted = mPESPacket->initialize(pTSPacket->getPid(), pTSPacket->continuityCounter(), ptrPayload, lenPayload);
+	} else if (mPESStarted) {
+		mPESPacket->appendData(pTSPacket->getPid(), pTSPacket->continuityCounter(), ptrPayload, lenPayload);
+	}
+
+	if (mPESStarted && mPESPacket->isCompleted()) {
+		medvdbg("PES packet (PID:%u) complete\n", pTSPacket->getPid());
+		mPESStarted = false;
+		pPESPacket = mPESPacket;
+	}
+#else
 	if (pTSPacket->payloadUnitStartIndicator()) {
 		// new PES packet start
 		medvdbg("new PES packet (PID:%u) start...\n", pTSPacket->getPid());
@@ -372,6 +409,7 @@ std::shared_ptr<PESPacket> TSDemuxer::PESUnpack(std::shared_ptr<TSPacket> pTSPac
 			}
 		}
 	}
+#endif
 
 	return pPESPacket;
 }
@@ -391,7 +429,7 @@ bool TSDemuxer::isPESPid(uint16_t pid)
 	return (pid == mPESPid);
 }
 
-int TSDemuxer::loadTSPacket(std::shared_ptr<TSPacket> pTSPacket, bool sync, size_t *offset)
+int TSDemuxer::loadTSPacket(const std::shared_ptr<TSPacket> &pTSPacket, bool sync, size_t *offset)
 {
 	int syncOffset = 0;
 	uint8_t buffLen; // TSPacket::PACKET_SIZE
@@ -431,21 +469,62 @@ int TSDemuxer::loadTSPacket(std::shared_ptr<TSPacket> pTSPacket, bool sync, size
 	return DEMUXER_ERROR_NONE;
 }
 
+#ifdef CONFIG_CONTAINER_MPEG2TS_INPLACE
+int TSDemuxer::loadTSPacketInPlace(const std::shared_ptr<TSPacket> &pTSPacket)
+{
+	if (mPeekLen < TSPacket::PACKET_SIZE) {
+		// get next contiguous data in stream buffer
+		mPeekData = mBufferReader->peek(mPeekOffset, &mPeekLen);
+	}
+
+	if (mPeekLen < TSPacket::PACKET_SIZE || !pTSPacket->parse(mPeekData)) {
+		// packet wraps around the end of stream buffer, data is not enough
+		// or sync is lost, load the packet by copy.
+		releaseTSPackets();
+		return loadTSPacket(pTSPacket);
+	}
+
+	mPeekData += TSPacket::PACKET_SIZE;
+	mPeekLen -= TSPacket::PACKET_SIZE;
+	mPeekOffset += TSPacket::PACKET_SIZE;
+	return DEMUXER_ERROR_NONE;
+}
+
+void TSDemuxer::releaseTSPackets(void)
+{
+	if (mPeekOffset > 0) {
+		mBufferReader->read(NULL, mPeekOffset, false);
+	}
+
+	mPeekData = nullptr;
+	mPeekLen = 0;
+	mPeekOffset = 0;
+}
+#endif
+
 // return demuxer_error_e
 int TSDemuxer::getPESPacket(std::shared_ptr<PESPacket> &pPESPacket)
 {
 	int ret;
 
+#ifdef CONFIG_CONTAINER_MPEG2TS_INPLACE
+	while ((ret = loadTSPacketInPlace(mTSPacket)) == DEMUXER_ERROR_NONE) {
+#else
 	while ((ret = loadTSPacket(mTSPacket)) == DEMUXER_ERROR_NONE) {
+#endif
 		if (isPESPid(mTSPacket->getPid())) {
 			pPESPacket = PESUnpack(mTSPacket);
 			if (pPESPacket) {
 				medvdbg("got new PES packet\n");
-				return DEMUXER_ERROR_NONE;
+				break;
 			}
 		}
 	}
 
+#ifdef CONFIG_CONTAINER_MPEG2TS_INPLACE
+	// Payloads have been copied into the PES packet, remove them all at once.
+	releaseTSPackets();
+#endif
 	return ret;
 }
 
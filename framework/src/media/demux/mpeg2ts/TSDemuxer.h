@@ -87,11 +87,20 @@ private:
 	// return value:
 	// on success, return 0
 	// on failure, return negative value (see demuxer_error_e)
-	int loadTSPacket(std::shared_ptr<TSPacket> pTSPacket, bool sync = false, size_t *offset = nullptr);
+	int loadTSPacket(const std::shared_ptr<TSPacket> &pTSPacket, bool sync = false, size_t *offset = nullptr);
+#ifdef CONFIG_CONTAINER_MPEG2TS_INPLACE
+	// load a valid TS packet in place, the packet is parsed in the stream buffer
+	// and stays there until releaseTSPackets() is called.
+	// on success, return 0
+	// on failure, return negative value (see demuxer_error_e)
+	int loadTSPacketInPlace(const std::shared_ptr<TSPacket> &pTSPacket);
+	// remove TS packets loaded in place from the stream buffer
+	void releaseTSPackets(void);
+#endif
 	// Unpack a TS packet and return a section if get a completed one
-	std::shared_ptr<Section> PSIUnpack(std::shared_ptr<TSPacket> pTSPacket);
+	std::shared_ptr<Section> PSIUnpack(const std::shared_ptr<TSPacket> &pTSPacket);
 	// Unpack a TS packet and return a PES packet if get a completed one
-	std::shared_ptr<PESPacket> PESUnpack(std::shared_ptr<TSPacket> pTSPacket);
+	std::shared_ptr<PESPacket> PESUnpack(const std::shared_ptr<TSPacket> &pTSPacket);
 	// resync TS packet by TSPacket::SYNC_BYTE
 	int resync(uint8_t *pPacketData, size_t offset);
 
@@ -112,6 +121,17 @@ private:
 	std::shared_ptr<PESParser> mPESParser;
 	// TS packet
 	std::shared_ptr<TSPacket> mTSPacket;
+#ifdef CONFIG_CONTAINER_MPEG2TS_INPLACE
+	// PES packet of the audio PID, its data buffer is reused for every PES packet
+	std::shared_ptr<PESPacket> mPESPacket;
+	// if a PES packet is started in mPESPacket
+	bool mPESStarted;
+	// contiguous data in stream buffer at mPeekOffset, not loaded yet
+	const uint8_t *mPeekData;
+	size_t mPeekLen;
+	// bytes of TS packets loaded in place, to be removed from stream buffer
+	size_t mPeekOffset;
+#endif
 	uint16_t mPESPid;
 	size_t mPESDataUsed;
 };
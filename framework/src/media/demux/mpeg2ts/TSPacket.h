@@ -69,6 +69,9 @@ public:
 	// parse transport packet stored in packet data buffer
 	// get packet buffer and put data in the buffer firstly
 	bool parse(void);
+	// parse transport packet in place, without copying it to packet data buffer
+	// pData must stay valid while the payload data is used
+	bool parse(const uint8_t *pData);
 
 	// getters
 	ts_pid_t getPid(void) { return mPid; }
@@ -81,12 +84,14 @@ public:
 	uint8_t *getPacketBuffer(uint8_t *packetBuffLen);
 	// get pointer to the payload data start address
 	// return nullptr if there's no payload
-	uint8_t *getPayloadData(uint8_t *payloadDataLen);
+	const uint8_t *getPayloadData(uint8_t *payloadDataLen);
 	// add more getters if necessary...
 
 private:
 	// packet data array
 	uint8_t mData[PACKET_SIZE];
+	// packet parsed, mData or the packet parsed in place
+	const uint8_t *mPacketData;
 	// sync byte
 	uint8_t mSyncByte;
 	// transport error indicator
@@ -155,6 +155,24 @@ size_t rb_read_ext(rb_p rbp, void *ptr, size_t len, size_t offset)
 	return len;
 }
 
+const void *rb_peek(rb_p rbp, size_t offset, size_t *len)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, NULL);
+	RETURN_VAL_IF_FAIL(len != NULL, NULL);
+
+	*len = SIZE_ZERO;
+	size_t used = rb_used(rbp);
+	RETURN_VAL_IF_FAIL(offset < used, NULL);
+
+	size_t rd_idx = rbp->rd_idx;
+	_incr(rbp, &rd_idx, offset);
+	rd_idx = (rd_idx & IDX_MASK);
+
+	// Data is contiguous up to the end of the buffer memory
+	*len = MINIMUM(used - offset, rbp->depth - rd_idx);
+	return (const void *)((uint8_t *)rbp->buf + rd_idx);
+}
+
 bool rb_reset(rb_p rbp)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, false);
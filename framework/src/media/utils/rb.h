@@ -102,6 +102,19 @@ size_t rb_read(rb_p rbp, void *ptr, size_t len);
  */
 size_t rb_read_ext(rb_p rbp, void *ptr, size_t len, size_t offset);
 
+/**
+ * @brief  Get the data at an offset position in place, without copying.
+ *         rd_idx will not be increased, so the data stays valid until it is
+ *         read (or rd_idx is increased) by the reader.
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  offset: offset from rd_idx of the data
+ * @param  len: Pointer to save the length of the data which is contiguous in
+ *              memory from the returned pointer, it may be shorter than the
+ *              data available when the data wraps around the buffer end.
+ * @return pointer to the data, NULL if there's no data at the offset.
+ */
+const void *rb_peek(rb_p rbp, size_t offset, size_t *len);
+
 /**
  * @brief  Reset ring-buffer, data in ring-buffer will be dropped.
  * @param  rbp: Pointer to the ring-buffer object
@@ -156,18 +156,13 @@ int messaging_parse_packet(char *packet, char *buf, int buflen, pid_t *sender_pi
  * Name : messaging_set_notification
  * 
  * Description:
- *  This function calls mq_notify to set message queue notification.
+ *  This function sets one-shot notification of the message port.
  ****************************************************************************/
 int messaging_set_notification(int signo, msg_recv_info_t *data)
 {
 	int ret;
-	struct sigevent notification;
 
-	notification.sigev_notify = SIGEV_SIGNAL;
-	notification.sigev_signo = signo;
-	notification.sigev_value.sival_ptr = data;
-
-	ret = mq_notify(data->mqdes, &notification);
+	ret = messaging_port_notify(data->port, signo, data);
 	if (ret < 0) {
 		msgdbg("[Messaging] set notification fail. errno %d\n", errno);
 		MSG_FREE(data);
@@ -184,10 +179,7 @@ int messaging_set_notification(int signo, msg_recv_info_t *data)
 void messaging_run_callback(int signo, siginfo_t *data)
 {
 	int ret;
-	ssize_t size;
 	msg_recv_info_t *recv_info;
-	struct mq_attr attr;
-	char *recv_packet;
 	int msg_type;
 
 	if (data == NULL) {
@@ -195,62 +187,48 @@ void messaging_run_callback(int signo, siginfo_t *data)
 		return;
 	}
 
-	/* recv_info is passed through signal. It has mqdes, buflen and callback information. */
+	/* recv_info is passed through signal. It has message port, buflen and callback information. */
 	recv_info = (msg_recv_info_t *)data->si_value.sival_ptr;
 	if (recv_info == NULL) {
 		msgdbg("[Messaging] recv fail : wrong param for wrapper callback(info).\n");
 		return;
 	}
 
-	ret = mq_getattr(recv_info->mqdes, &attr);
+	ret = messaging_port_pending(recv_info->port);
 	if (ret < 0) {
 		msgdbg("[Messaging] recv fail : get attribute fail.\n");
 		goto errout_with_recv_info;
 	}
 
 	while (1) {
-		/* recv_packet is used for receiving message including header. */
-		recv_packet = (char *)MSG_ALLOC(attr.mq_msgsize);
-		if (recv_packet == NULL) {
-			msgdbg("[Messaging] recv fail : out of memory for including header.\n");
+		/* Receive the packet and parse the received data to user message buffer. */
+		ret = messaging_port_recv(recv_info->port, recv_info->msg->buf, recv_info->msg->buflen, &(recv_info->msg->sender_pid), &msg_type);
+		if (ret < 0) {
+			msgdbg("[Messaging] recv fail : errno %d\n", errno);
 			goto errout_with_recv_info;
 		}
 
-		size = mq_receive(recv_info->mqdes, (char *)recv_packet, attr.mq_msgsize, 0);
-		if (size < 0) {
-			msgdbg("[Messaging] recv fail : mq_receive, errno %d\n", errno);
-			goto errout_with_recv_packet;
-		}
-
-		/* Parsing the received data to user message buffer. */
-		ret = messaging_parse_packet(recv_packet, recv_info->msg->buf, recv_info->msg->buflen, &(recv_info->msg->sender_pid), &msg_type);
-		if (ret != OK) {
-			msgdbg("[Messaging] Not supported version, received version : %d.\n", ret);
-			goto errout_with_recv_packet;
-		}
-
 		/* Call user callback */
 		(*recv_info->user_cb)(msg_type, recv_info->msg, recv_info->cb_data);
-		MSG_FREE(recv_packet);
 		if (msg_type == MSG_SEND_REPLY) {
 			/* This is only for async-reply msg. In this case, callback registration is removed after one-time use. */
-			ret = mq_close(recv_info->mqdes);
+			ret = messaging_port_close(recv_info->port);
 			if (ret != OK) {
 				msgdbg("[Messaging] Mq_close fail for async-reply.\n");
 			}
-			ret = mq_unlink(recv_info->port_name);
+			ret = messaging_port_unlink(recv_info->port_name);
 			if (ret != OK) {
 				msgdbg("[Messaging] Unlink fail for async-reply, errno %d\n", errno);
 			}
 			goto errout_with_recv_info;
 		}
 
-		ret = mq_getattr(recv_info->mqdes, &attr);
+		ret = messaging_port_pending(recv_info->port);
 		if (ret < 0) {
-			msgdbg("[Messaging] recv fail : mq_getattr fail, mqdes is not correct.\n");
+			msgdbg("[Messaging] recv fail : pending check fail, port is not correct.\n");
 			MSG_FREE(data);
 			goto errout_with_mq_close;
-		} else if (attr.mq_curmsgs == 0) {
+		} else if (ret == 0) {
 			/* All requests are handled. Register notification again. */
 			messaging_set_notification(SIGMSG_MESSAGING, recv_info);
 			break;
@@ -258,10 +236,8 @@ void messaging_run_callback(int signo, siginfo_t *data)
 	}
 	return;
 
-errout_with_recv_packet:
-	MSG_FREE(recv_packet);
 errout_with_mq_close:
-	mq_close(recv_info->mqdes);
+	messaging_port_close(recv_info->port);
 errout_with_recv_info:
 	MSG_FREE(recv_info);
 }
@@ -17,9 +17,12 @@
  ****************************************************************************/
 #include <tinyara/compiler.h>
 #include <mqueue.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <queue.h>
+#include <semaphore.h>
 #include <messaging/messaging.h>
 
 
@@ -48,6 +51,61 @@ typedef struct messaging_packet_s messaging_packet_t;
 
 #define MAX_PORT_NAME_SIZE 64
 
+#ifdef CONFIG_MESSAGING_SHM_RING
+/**
+ * @brief The ring which carries packets from one sender to one receiver port
+ * @details Only the sender writes tail and only the receiver writes head, so the
+ * data path does not need any lock. Each record is a 4-byte packet length followed
+ * by the packet and padded up to 4 bytes.
+ */
+struct msg_ring_s {
+	struct msg_ring_s *flink;
+	pid_t sender_pid;
+	int users;
+	volatile uint32_t head;
+	volatile uint32_t tail;
+	volatile bool writer_waiting;
+	sem_t space_sem;
+	char *data;
+};
+typedef struct msg_ring_s msg_ring_t;
+
+/**
+ * @brief The receiver side of a ring port. It is shared by all senders of the port.
+ */
+struct msg_ring_port_s {
+	struct msg_ring_port_s *flink;
+	char name[MAX_PORT_NAME_SIZE];
+	int refs;
+	bool unlinked;
+	int msgsize;
+	sq_queue_t rings;
+	int nrings;
+	msg_ring_t *cursor;
+	volatile bool reader_waiting;
+	sem_t doorbell;
+	bool notify_armed;
+	pid_t notify_pid;
+	int notify_signo;
+	void *notify_data;
+};
+typedef struct msg_ring_port_s msg_ring_port_t;
+
+/**
+ * @brief The handle returned by messaging_port_open for the ring transport
+ */
+struct msg_port_s {
+	msg_ring_port_t *rport;
+	msg_ring_t *ring;
+	int oflags;
+};
+typedef struct msg_port_s *msg_port_t;
+#define MSG_PORT_INVALID ((msg_port_t)NULL)
+#else
+typedef mqd_t msg_port_t;
+#define MSG_PORT_INVALID ((msg_port_t)ERROR)
+#endif
+
 /**
  * @brief The type of handling message internally
  * @details MSG_INFO_SAVE    : For saving receiver information\n
@@ -86,7 +144,7 @@ typedef enum msg_send_type_e msg_send_type_t;
  * @brief The internal structure for callback information and mq descriptor
  */
 struct msg_recv_info_s {
-	mqd_t mqdes;
+	msg_port_t port;
 	msg_recv_buf_t *msg;
 	msg_callback_t user_cb;
 	char *cb_data;
@@ -100,12 +158,16 @@ typedef struct msg_recv_info_s msg_recv_info_t;
 struct msg_port_info_s {
 	struct msg_port_info_s *flink;
 	char name[MAX_PORT_NAME_SIZE];
-	mqd_t mqdes;
+	msg_port_t port;
 	void *data;
 	pid_t pid;
 };
 typedef struct msg_port_info_s msg_port_info_t;
 
+/**
+ * @brief Internal function for getting the packet version of this messaging.
+ */
+int messaging_get_version(void);
 /**
  * @brief Internal function for setting callback function to the messaging signal.
  */
@@ -142,6 +204,35 @@ int messaging_parse_packet(char *packet, char *buf, int buflen, pid_t *sender_pi
  * @brief Internal function for getting g_port_info_list
  */
 sq_queue_t *messaging_get_port_info_list(void);
+/**
+ * @brief Internal transport function for opening a message port. It follows the mq_open semantics.
+ */
+msg_port_t messaging_port_open(const char *name, int oflags, int msgsize);
+/**
+ * @brief Internal transport function for closing a message port.
+ */
+int messaging_port_close(msg_port_t port);
+/**
+ * @brief Internal transport function for removing a message port name.
+ */
+int messaging_port_unlink(const char *name);
+/**
+ * @brief Internal transport function for sending a packet which has the header and message.
+ */
+int messaging_port_send(msg_port_t port, messaging_packet_t *header, const char *msg, int msglen, int priority);
+/**
+ * @brief Internal transport function for receiving a packet and parsing it to the user buffer.
+ * @return On success, the size of received packet is returned. On failure, -1 (ERROR) is returned and errno is set.
+ */
+int messaging_port_recv(msg_port_t port, char *buf, int buflen, pid_t *sender_pid, int *msg_type);
+/**
+ * @brief Internal transport function for checking whether there are unread messages.
+ */
+int messaging_port_pending(msg_port_t port);
+/**
+ * @brief Internal transport function for setting one-shot notification of the port.
+ */
+int messaging_port_notify(msg_port_t port, int signo, void *data);
 /*
  *@endcond
  */
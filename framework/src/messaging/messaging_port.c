@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <debug.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <mqueue.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <messaging/messaging.h>
+#include "messaging_internal.h"
+
+/****************************************************************************
+ * functions
+ ****************************************************************************/
+/****************************************************************************
+ * Name : messaging_port_open
+ *
+ * Description:
+ *  Open the mqueue which is used as a message port.
+ ****************************************************************************/
+msg_port_t messaging_port_open(const char *name, int oflags, int msgsize)
+{
+	struct mq_attr internal_attr;
+
+	internal_attr.mq_maxmsg = CONFIG_MESSAGING_MAXMSG;
+	internal_attr.mq_msgsize = msgsize;
+	internal_attr.mq_flags = 0;
+
+	return mq_open(name, oflags, 0666, &internal_attr);
+}
+
+/****************************************************************************
+ * Name : messaging_port_close
+ ****************************************************************************/
+int messaging_port_close(msg_port_t port)
+{
+	return mq_close(port);
+}
+
+/****************************************************************************
+ * Name : messaging_port_unlink
+ ****************************************************************************/
+int messaging_port_unlink(const char *name)
+{
+	return mq_unlink(name);
+}
+
+/****************************************************************************
+ * Name : messaging_port_send
+ *
+ * Description:
+ *  Build the packet which has the header and message, and send it through mqueue.
+ ****************************************************************************/
+int messaging_port_send(msg_port_t port, messaging_packet_t *header, const char *msg, int msglen, int priority)
+{
+	int ret;
+	char *send_packet;
+	int send_size;
+
+	send_size = MSG_HEADER_SIZE + msglen;
+	send_packet = (char *)MSG_ALLOC(send_size);
+	if (send_packet == NULL) {
+		msgdbg("[Messaging] send fail : out of memory for including header.\n");
+		errno = ENOMEM;
+		return ERROR;
+	}
+
+	memcpy(send_packet, header, MSG_HEADER_SIZE);
+	memcpy(send_packet + header->offset, msg, msglen);
+
+	ret = mq_send(port, send_packet, send_size, priority);
+	MSG_FREE(send_packet);
+
+	return ret;
+}
+
+/****************************************************************************
+ * Name : messaging_port_recv
+ *
+ * Description:
+ *  Receive the packet from mqueue and parse it to the user buffer.
+ ****************************************************************************/
+int messaging_port_recv(msg_port_t port, char *buf, int buflen, pid_t *sender_pid, int *msg_type)
+{
+	int ret;
+	ssize_t size;
+	char *recv_packet;
+	int recv_size;
+
+	recv_size = MSG_HEADER_SIZE + buflen;
+	recv_packet = (char *)MSG_ALLOC(recv_size);
+	if (recv_packet == NULL) {
+		msgdbg("[Messaging] recv fail : out of memory for packet.\n");
+		errno = ENOMEM;
+		return ERROR;
+	}
+
+	size = mq_receive(port, recv_packet, recv_size, 0);
+	if (size < 0) {
+		MSG_FREE(recv_packet);
+		return ERROR;
+	}
+
+	ret = messaging_parse_packet(recv_packet, buf, buflen, sender_pid, msg_type);
+	MSG_FREE(recv_packet);
+	if (ret != OK) {
+		errno = EINVAL;
+		return ERROR;
+	}
+
+	return (int)size;
+}
+
+/****************************************************************************
+ * Name : messaging_port_pending
+ ****************************************************************************/
+int messaging_port_pending(msg_port_t port)
+{
+	int ret;
+	struct mq_attr attr;
+
+	ret = mq_getattr(port, &attr);
+	if (ret < 0) {
+		return ERROR;
+	}
+
+	return attr.mq_curmsgs;
+}
+
+/****************************************************************************
+ * Name : messaging_port_notify
+ ****************************************************************************/
+int messaging_port_notify(msg_port_t port, int signo, void *data)
+{
+	struct sigevent notification;
+
+	notification.sigev_notify = SIGEV_SIGNAL;
+	notification.sigev_signo = signo;
+	notification.sigev_value.sival_ptr = data;
+
+	return mq_notify(port, &notification);
+}
@@ -44,12 +44,12 @@ sq_queue_t *messaging_get_port_info_list(void)
  * Name : messaging_recv_nonblock
  * 
  * Description:
- *  This function is for non-blocking mq_receive.
+ *  This function is for non-blocking receive.
  * If there is a message in the queue, this function calls the callback with msg.
  * If there is no message, then calls the notification function to register callback. 
  *
  * Input Parameters:
- *  mqdes     : Message queue descriptor
+ *  port      : Message port
  *  port_name : The message port name to receive
  *  msg       : The message buffer to receive the message
  *  msglen    : The length of message to receive
@@ -61,32 +61,22 @@ sq_queue_t *messaging_get_port_info_list(void)
  *  On success, 0 (OK) is returned.; On failure, -1 (ERROR) is returned.
  *  Sender pid is passed to callback function as 3rd argument.
  ****************************************************************************/
-static int messaging_rcv_nonblock(mqd_t mqdes, const char *port_name, msg_recv_buf_t *recv_buf, msg_callback_info_t *cb_info)
+static int messaging_rcv_nonblock(msg_port_t port, const char *port_name, msg_recv_buf_t *recv_buf, msg_callback_info_t *cb_info)
 {
 	int ret;
-	ssize_t recv_size_chk;
+	int recv_size_chk;
 	msg_recv_info_t *nonblock_data;
 	msg_port_info_t *port_info = NULL;
 	int recv_size;
-	char *recv_packet;
 	int msg_type;
 	char *internal_portname;
 
 	recv_size = recv_buf->buflen + MSG_HEADER_SIZE;
-	recv_packet = (char *)MSG_ALLOC(recv_size);
-	if (recv_packet == NULL) {
-		msgdbg("[Messaging] recv fail : out of memory for packet.\n");
-		goto errout_with_mq;
-	}
+
 	/* Check there were messages already before setting notification */
 	while (1) {
-		recv_size_chk = mq_receive(mqdes, (char *)recv_packet, recv_size, 0);
+		recv_size_chk = messaging_port_recv(port, recv_buf->buf, recv_buf->buflen, &recv_buf->sender_pid, &msg_type);
 		if (recv_size_chk > 0 && recv_size_chk <= recv_size) {
-			ret = messaging_parse_packet(recv_packet, recv_buf->buf, recv_buf->buflen, &recv_buf->sender_pid, &msg_type);
-			if (ret != OK) {
-				MSG_FREE(recv_packet);
-				goto errout_with_mq;
-			}
 			recv_buf->buflen = recv_size_chk;
 			(*cb_info->cb_func)(msg_type, recv_buf, cb_info->cb_data);
 		} else if (recv_size_chk == ERROR && errno == EAGAIN) {
@@ -94,11 +84,9 @@ static int messaging_rcv_nonblock(mqd_t mqdes, const char *port_name, msg_recv_b
 			break;
 		} else {
 			msgdbg("[Messaging] recv fail : errno %d, size %d.\n", errno, recv_size_chk);
-			MSG_FREE(recv_packet);
 			goto errout_with_mq;
 		}
 	}
-	MSG_FREE(recv_packet);
 
 	/* There was no msg, then set notification. */
 	ret = messaging_set_notify_signal(SIGMSG_MESSAGING, (_sa_sigaction_t)messaging_run_callback);
@@ -112,7 +100,7 @@ static int messaging_rcv_nonblock(mqd_t mqdes, const char *port_name, msg_recv_b
 		msgdbg("[Messaging] recv fail : out of memory.\n");
 		goto errout_with_msg;
 	}
-	nonblock_data->mqdes = mqdes;
+	nonblock_data->port = port;
 	nonblock_data->msg = recv_buf;
 	nonblock_data->user_cb = cb_info->cb_func;
 	nonblock_data->cb_data = cb_info->cb_data;
@@ -126,7 +114,7 @@ static int messaging_rcv_nonblock(mqd_t mqdes, const char *port_name, msg_recv_b
 		goto errout_with_mq;
 	}
 
-	port_info->mqdes = mqdes;
+	port_info->port = port;
 	port_info->data = nonblock_data;
 	port_info->pid = getpid();
 	strncpy(port_info->name, port_name, strlen(port_name) + 1);
@@ -143,9 +131,9 @@ errout_with_msg:
 	sq_rem((FAR sq_entry_t *)port_info, &g_port_info_list);
 	MSG_FREE(port_info);
 errout_with_mq:
-	mq_close(mqdes);
+	messaging_port_close(port);
 	MSG_ASPRINTF(&internal_portname, "%s%d", port_name, getpid());
-	mq_unlink(internal_portname);
+	messaging_port_unlink(internal_portname);
 	MSG_FREE(internal_portname);
 	return ERROR;
 }
@@ -154,10 +142,10 @@ errout_with_mq:
  * Name : messaging_rcv_block
  * 
  * Description:
- *  This function calls mq_receive with block mode.
+ *  This function receives the message with block mode.
  *
  * Input Parameters:
- *  mqdes     : Message queue descriptor
+ *  port      : Message port
  *  port_name : The message port name to receive
  *  msg       : The message buffer to receive the message
  *  msglen    : The length of message to receive
@@ -165,40 +153,21 @@ errout_with_mq:
  * Return Value:
  *  On success, sender pid (>=0) is returned.; On failure, -1 (ERROR) is returned.
  ****************************************************************************/
-static int messaging_rcv_block(mqd_t mqdes, const char *port_name, msg_recv_buf_t *recv_buf)
+static int messaging_rcv_block(msg_port_t port, const char *port_name, msg_recv_buf_t *recv_buf)
 {
 	int ret = OK;
-	int recv_size;
-	char *recv_packet;
 	int msg_type = OK;
 	char *internal_portname;
 
-	recv_size = MSG_HEADER_SIZE + recv_buf->buflen;
-	recv_packet = (char *)MSG_ALLOC(recv_size);
-	if (recv_packet == NULL) {
-		msgdbg("[Messaging] recv fail : out of memory for packet.\n");
-		ret = ERROR;
-		goto cleanup_return;
-	}
-
-	ret = mq_receive(mqdes, (char *)recv_packet, recv_size, 0);
+	ret = messaging_port_recv(port, recv_buf->buf, recv_buf->buflen, &recv_buf->sender_pid, &msg_type);
 	if (ret < 0) {
 		msgdbg("[Messaging] recv fail : errno %d, %s.\n", errno, port_name);
-		ret = ERROR;
-		goto cleanup_return;
-	}
-
-	ret = messaging_parse_packet(recv_packet, recv_buf->buf, recv_buf->buflen, &recv_buf->sender_pid, &msg_type);
-	if (ret != OK) {
 		msg_type = ERROR;
-		goto cleanup_return;
 	}
 
-cleanup_return:
-	MSG_FREE(recv_packet);
-	mq_close(mqdes);
+	messaging_port_close(port);
 	MSG_ASPRINTF(&internal_portname, "%s%d", port_name, getpid());
-	mq_unlink(internal_portname);
+	messaging_port_unlink(internal_portname);
 	MSG_FREE(internal_portname);
 	return msg_type;
 }
@@ -222,25 +191,23 @@ cleanup_return:
 int messaging_recv_internal(const char *port_name, msg_recv_buf_t *recv_buf, msg_callback_info_t *cb_info)
 {
 	int ret = OK;
-	mqd_t mqdes;
-	struct mq_attr internal_attr;
+	msg_port_t port;
+	int recv_size;
 	char *internal_portname;
 
 	MSG_ASPRINTF(&internal_portname, "%s%d", port_name, getpid());
 
-	internal_attr.mq_maxmsg = CONFIG_MESSAGING_MAXMSG;
-	internal_attr.mq_msgsize = recv_buf->buflen + MSG_HEADER_SIZE;
-	internal_attr.mq_flags = 0;
+	recv_size = recv_buf->buflen + MSG_HEADER_SIZE;
 
 	if (cb_info == NULL) {
 		/* This is block receive case. */
-		mqdes = mq_open(internal_portname, O_RDONLY | O_CREAT, 0666, &internal_attr);
+		port = messaging_port_open(internal_portname, O_RDONLY | O_CREAT, recv_size);
 	} else {
 		/* This is non-block receive case. */
-		mqdes = mq_open(internal_portname, O_RDONLY | O_CREAT | O_NONBLOCK, 0666, &internal_attr);
+		port = messaging_port_open(internal_portname, O_RDONLY | O_CREAT | O_NONBLOCK, recv_size);
 	}
 
-	if (mqdes == (mqd_t)ERROR) {
+	if (port == MSG_PORT_INVALID) {
 		MSG_FREE(internal_portname);
 		msgdbg("[Messaging] recv fail : open fail, errno %d.\n", errno);
 		return ERROR;
@@ -249,16 +216,16 @@ int messaging_recv_internal(const char *port_name, msg_recv_buf_t *recv_buf, msg
 	/* Save the receivers information. It will be used by sender to check the receivers. */
 	ret = SAVE_MSG_RECEIVER(port_name);
 	if (ret != OK) {
-		mq_close(mqdes);
-		mq_unlink(internal_portname);
+		messaging_port_close(port);
+		messaging_port_unlink(internal_portname);
 		MSG_FREE(internal_portname);
 		return ERROR;
 	}
 
 	if (cb_info == NULL) {
-		ret = messaging_rcv_block(mqdes, port_name, recv_buf);
+		ret = messaging_rcv_block(port, port_name, recv_buf);
 	} else {
-		ret = messaging_rcv_nonblock(mqdes, port_name, recv_buf, cb_info);
+		ret = messaging_rcv_nonblock(port, port_name, recv_buf, cb_info);
 	}
 
 	MSG_FREE(internal_portname);
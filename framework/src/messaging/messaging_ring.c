@@ -0,0 +1,588 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <queue.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <messaging/messaging.h>
+#include "messaging_internal.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#define MSG_RING_SIZE      CONFIG_MESSAGING_RING_SIZE
+#define MSG_RING_MASK      (MSG_RING_SIZE - 1)
+#define MSG_RING_LEN_SIZE  sizeof(uint32_t)
+#define MSG_RING_ALIGN(n)  (((n) + 3) & ~3)
+#define MSG_RING_RECORD_SIZE(pkt_size) (MSG_RING_LEN_SIZE + MSG_RING_ALIGN(pkt_size))
+
+#if (MSG_RING_SIZE & MSG_RING_MASK) != 0
+#error "CONFIG_MESSAGING_RING_SIZE should be a power of two"
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+/* All ring ports are in the shared user heap, so one list is visible for every task. */
+static sq_queue_t g_ring_port_list;
+static sem_t g_ring_lock = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * private functions
+ ****************************************************************************/
+static void messaging_ring_lock(void)
+{
+	while (sem_wait(&g_ring_lock) != OK) {
+		ASSERT(get_errno() == EINTR);
+	}
+}
+
+static void messaging_ring_unlock(void)
+{
+	sem_post(&g_ring_lock);
+}
+
+static void messaging_ring_wait(sem_t *sem)
+{
+	while (sem_wait(sem) != OK) {
+		ASSERT(get_errno() == EINTR);
+	}
+}
+
+static uint32_t messaging_ring_used(msg_ring_t *ring)
+{
+	return ring->tail - ring->head;
+}
+
+/* Copy into the ring with at most two memcpy, the second one only when the record wraps. */
+static void messaging_ring_copyin(msg_ring_t *ring, uint32_t pos, const void *src, uint32_t len)
+{
+	uint32_t off = pos & MSG_RING_MASK;
+	uint32_t first = MSG_RING_SIZE - off;
+
+	if (first >= len) {
+		memcpy(ring->data + off, src, len);
+	} else {
+		memcpy(ring->data + off, src, first);
+		memcpy(ring->data, (const char *)src + first, len - first);
+	}
+}
+
+static void messaging_ring_copyout(msg_ring_t *ring, uint32_t pos, void *dst, uint32_t len)
+{
+	uint32_t off = pos & MSG_RING_MASK;
+	uint32_t first = MSG_RING_SIZE - off;
+
+	if (first >= len) {
+		memcpy(dst, ring->data + off, len);
+	} else {
+		memcpy(dst, ring->data + off, first);
+		memcpy((char *)dst + first, ring->data, len - first);
+	}
+}
+
+static msg_ring_port_t *messaging_ring_find_port(const char *name)
+{
+	msg_ring_port_t *rport;
+
+	for (rport = (msg_ring_port_t *)sq_peek(&g_ring_port_list); rport != NULL; rport = (msg_ring_port_t *)sq_next(rport)) {
+		if (strncmp(rport->name, name, MAX_PORT_NAME_SIZE) == 0) {
+			return rport;
+		}
+	}
+	return NULL;
+}
+
+static void messaging_ring_free_ring(msg_ring_t *ring)
+{
+	sem_destroy(&ring->space_sem);
+	MSG_FREE(ring->data);
+	MSG_FREE(ring);
+}
+
+static void messaging_ring_free_port(msg_ring_port_t *rport)
+{
+	msg_ring_t *ring;
+
+	while ((ring = (msg_ring_t *)sq_remfirst(&rport->rings)) != NULL) {
+		messaging_ring_free_ring(ring);
+	}
+	sem_destroy(&rport->doorbell);
+	MSG_FREE(rport);
+}
+
+/*
+ * Free the oldest idle ring of the port. A ring is idle when no sender has it open
+ * and the receiver has consumed all of it. The ring at the cursor is kept, because
+ * the receiver may still be touching it after it advanced the head.
+ * The caller should hold g_ring_lock.
+ */
+static void messaging_ring_evict(msg_ring_port_t *rport)
+{
+	msg_ring_t *ring;
+
+	for (ring = (msg_ring_t *)sq_peek(&rport->rings); ring != NULL; ring = (msg_ring_t *)sq_next(ring)) {
+		if (ring->users == 0 && messaging_ring_used(ring) == 0 && ring != rport->cursor) {
+			sq_rem((FAR sq_entry_t *)ring, &rport->rings);
+			rport->nrings--;
+			messaging_ring_free_ring(ring);
+			return;
+		}
+	}
+}
+
+/* Drop one reference of the port. The caller should hold g_ring_lock. */
+static void messaging_ring_release_port(msg_ring_port_t *rport)
+{
+	rport->refs--;
+	if (rport->refs == 0 && rport->unlinked) {
+		messaging_ring_free_port(rport);
+	}
+}
+
+/* Find the ring of the calling sender, or create it. The caller should hold g_ring_lock. */
+static msg_ring_t *messaging_ring_attach(msg_ring_port_t *rport)
+{
+	msg_ring_t *ring;
+	pid_t my_pid = getpid();
+
+	for (ring = (msg_ring_t *)sq_peek(&rport->rings); ring != NULL; ring = (msg_ring_t *)sq_next(ring)) {
+		if (ring->sender_pid == my_pid) {
+			ring->users++;
+			return ring;
+		}
+	}
+
+	if (rport->nrings >= CONFIG_MESSAGING_RING_MAX_SENDERS) {
+		messaging_ring_evict(rport);
+	}
+
+	ring = (msg_ring_t *)MSG_ALLOC(sizeof(msg_ring_t));
+	if (ring == NULL) {
+		return NULL;
+	}
+	ring->data = (char *)MSG_ALLOC(MSG_RING_SIZE);
+	if (ring->data == NULL) {
+		MSG_FREE(ring);
+		return NULL;
+	}
+	ring->sender_pid = my_pid;
+	ring->users = 1;
+	ring->head = 0;
+	ring->tail = 0;
+	ring->writer_waiting = false;
+	sem_init(&ring->space_sem, 0, 0);
+	sem_setprotocol(&ring->space_sem, SEM_PRIO_NONE);
+	sq_addlast((FAR sq_entry_t *)ring, &rport->rings);
+	rport->nrings++;
+
+	return ring;
+}
+
+/* Find the next ring which has a packet, starting after the last served ring so that senders are served in turn. */
+static msg_ring_t *messaging_ring_next_ready(msg_ring_port_t *rport)
+{
+	msg_ring_t *start;
+	msg_ring_t *ring;
+
+	start = (rport->cursor != NULL) ? (msg_ring_t *)sq_next(rport->cursor) : NULL;
+	if (start == NULL) {
+		start = (msg_ring_t *)sq_peek(&rport->rings);
+	}
+
+	ring = start;
+	while (ring != NULL) {
+		if (messaging_ring_used(ring) != 0) {
+			rport->cursor = ring;
+			return ring;
+		}
+		ring = (msg_ring_t *)sq_next(ring);
+		if (ring == NULL) {
+			ring = (msg_ring_t *)sq_peek(&rport->rings);
+		}
+		if (ring == start) {
+			break;
+		}
+	}
+	return NULL;
+}
+
+static int messaging_ring_signal(pid_t pid, int signo, union sigval value)
+{
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	return sigqueue(pid, signo, value);
+#else
+	return sigqueue(pid, signo, value.sival_ptr);
+#endif
+}
+
+/* Wake the receiver once per batch. Receiver sets reader_waiting or arms the notification only when it found every ring empty. */
+static void messaging_ring_kick(msg_ring_port_t *rport)
+{
+	union sigval value;
+
+	if (rport->reader_waiting) {
+		rport->reader_waiting = false;
+		sem_post(&rport->doorbell);
+	}
+
+	if (rport->notify_armed) {
+		messaging_ring_lock();
+		if (rport->notify_armed) {
+			rport->notify_armed = false;
+			value.sival_ptr = rport->notify_data;
+			(void)messaging_ring_signal(rport->notify_pid, rport->notify_signo, value);
+		}
+		messaging_ring_unlock();
+	}
+}
+
+/****************************************************************************
+ * functions
+ ****************************************************************************/
+/****************************************************************************
+ * Name : messaging_port_open
+ *
+ * Description:
+ *  Open the ring port. Receiver creates the port with O_CREAT, and each sender
+ *  gets its own single-producer/single-consumer ring for the port.
+ ****************************************************************************/
+msg_port_t messaging_port_open(const char *name, int oflags, int msgsize)
+{
+	msg_port_t port;
+	msg_ring_port_t *rport;
+
+	if (strlen(name) >= MAX_PORT_NAME_SIZE) {
+		set_errno(ENAMETOOLONG);
+		return MSG_PORT_INVALID;
+	}
+
+	port = (msg_port_t)MSG_ALLOC(sizeof(struct msg_port_s));
+	if (port == NULL) {
+		set_errno(ENOMEM);
+		return MSG_PORT_INVALID;
+	}
+	port->oflags = oflags;
+	port->ring = NULL;
+
+	messaging_ring_lock();
+	rport = messaging_ring_find_port(name);
+	if (rport == NULL) {
+		if ((oflags & O_CREAT) == 0) {
+			messaging_ring_unlock();
+			MSG_FREE(port);
+			set_errno(ENOENT);
+			return MSG_PORT_INVALID;
+		}
+
+		if (MSG_RING_RECORD_SIZE(msgsize) > MSG_RING_SIZE) {
+			msgdbg("[Messaging] ring open fail : message size %d is too big for ring.\n", msgsize);
+			messaging_ring_unlock();
+			MSG_FREE(port);
+			set_errno(EMSGSIZE);
+			return MSG_PORT_INVALID;
+		}
+
+		rport = (msg_ring_port_t *)MSG_ALLOC(sizeof(msg_ring_port_t));
+		if (rport == NULL) {
+			messaging_ring_unlock();
+			MSG_FREE(port);
+			set_errno(ENOMEM);
+			return MSG_PORT_INVALID;
+		}
+		memset(rport, 0, sizeof(msg_ring_port_t));
+		strncpy(rport->name, name, MAX_PORT_NAME_SIZE);
+		rport->msgsize = msgsize;
+		sq_init(&rport->rings);
+		sem_init(&rport->doorbell, 0, 0);
+		sem_setprotocol(&rport->doorbell, SEM_PRIO_NONE);
+		sq_addlast((FAR sq_entry_t *)rport, &g_ring_port_list);
+	}
+
+	if ((oflags & O_WROK) != 0) {
+		port->ring = messaging_ring_attach(rport);
+		if (port->ring == NULL) {
+			if (rport->refs == 0) {
+				sq_rem((FAR sq_entry_t *)rport, &g_ring_port_list);
+				messaging_ring_free_port(rport);
+			}
+			messaging_ring_unlock();
+			MSG_FREE(port);
+			set_errno(ENOMEM);
+			return MSG_PORT_INVALID;
+		}
+	}
+
+	rport->refs++;
+	port->rport = rport;
+	messaging_ring_unlock();
+
+	return port;
+}
+
+/****************************************************************************
+ * Name : messaging_port_close
+ ****************************************************************************/
+int messaging_port_close(msg_port_t port)
+{
+	if (port == MSG_PORT_INVALID) {
+		set_errno(EBADF);
+		return ERROR;
+	}
+
+	messaging_ring_lock();
+	if (port->rport->notify_armed && port->rport->notify_pid == getpid()) {
+		port->rport->notify_armed = false;
+	}
+	if (port->ring != NULL) {
+		port->ring->users--;
+	}
+	messaging_ring_release_port(port->rport);
+	messaging_ring_unlock();
+
+	MSG_FREE(port);
+	return OK;
+}
+
+/****************************************************************************
+ * Name : messaging_port_unlink
+ *
+ * Description:
+ *  Remove the port name. Like mq_unlink, the port itself is freed
+ *  after the last user closes it.
+ ****************************************************************************/
+int messaging_port_unlink(const char *name)
+{
+	msg_ring_port_t *rport;
+
+	messaging_ring_lock();
+	rport = messaging_ring_find_port(name);
+	if (rport == NULL) {
+		messaging_ring_unlock();
+		set_errno(ENOENT);
+		return ERROR;
+	}
+
+	sq_rem((FAR sq_entry_t *)rport, &g_ring_port_list);
+	rport->unlinked = true;
+	if (rport->refs == 0) {
+		messaging_ring_free_port(rport);
+	}
+	messaging_ring_unlock();
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name : messaging_port_send
+ *
+ * Description:
+ *  Write the header and message directly into the sender's ring.
+ *  Message priority is not used, because each ring keeps the order of one sender.
+ ****************************************************************************/
+int messaging_port_send(msg_port_t port, messaging_packet_t *header, const char *msg, int msglen, int priority)
+{
+	msg_ring_t *ring;
+	uint32_t pkt_size;
+	uint32_t record_size;
+	uint32_t tail;
+
+	if (port == MSG_PORT_INVALID || port->ring == NULL) {
+		set_errno(EBADF);
+		return ERROR;
+	}
+
+	ring = port->ring;
+	pkt_size = MSG_HEADER_SIZE + msglen;
+	record_size = MSG_RING_RECORD_SIZE(pkt_size);
+	if ((int)pkt_size > port->rport->msgsize || record_size > MSG_RING_SIZE) {
+		set_errno(EMSGSIZE);
+		return ERROR;
+	}
+
+	while (MSG_RING_SIZE - messaging_ring_used(ring) < record_size) {
+		if ((port->oflags & O_NONBLOCK) != 0) {
+			set_errno(EAGAIN);
+			return ERROR;
+		}
+		ring->writer_waiting = true;
+		if (MSG_RING_SIZE - messaging_ring_used(ring) >= record_size) {
+			ring->writer_waiting = false;
+			break;
+		}
+		messaging_ring_wait(&ring->space_sem);
+	}
+
+	tail = ring->tail;
+	messaging_ring_copyin(ring, tail, &pkt_size, MSG_RING_LEN_SIZE);
+	messaging_ring_copyin(ring, tail + MSG_RING_LEN_SIZE, header, MSG_HEADER_SIZE);
+	messaging_ring_copyin(ring, tail + MSG_RING_LEN_SIZE + MSG_HEADER_SIZE, msg, msglen);
+
+	/* Publish the record only after its contents are in the ring. */
+	ring->tail = tail + record_size;
+
+	messaging_ring_kick(port->rport);
+	return OK;
+}
+
+/****************************************************************************
+ * Name : messaging_port_recv
+ *
+ * Description:
+ *  Parse the next packet directly from the ring to the user buffer.
+ *  All queued packets are consumed without another wakeup.
+ ****************************************************************************/
+int messaging_port_recv(msg_port_t port, char *buf, int buflen, pid_t *sender_pid, int *msg_type)
+{
+	msg_ring_port_t *rport;
+	msg_ring_t *ring;
+	messaging_packet_t header;
+	uint32_t pkt_size;
+	uint32_t head;
+	uint32_t copy_len;
+
+	if (port == MSG_PORT_INVALID) {
+		set_errno(EBADF);
+		return ERROR;
+	}
+	rport = port->rport;
+
+	while (1) {
+		messaging_ring_lock();
+		ring = messaging_ring_next_ready(rport);
+		if (ring == NULL && (port->oflags & O_NONBLOCK) == 0) {
+			rport->reader_waiting = true;
+			/* Check again, a sender may have written before it saw reader_waiting. */
+			ring = messaging_ring_next_ready(rport);
+			if (ring != NULL) {
+				rport->reader_waiting = false;
+			}
+		}
+		messaging_ring_unlock();
+
+		if (ring != NULL) {
+			break;
+		}
+
+		if ((port->oflags & O_NONBLOCK) != 0) {
+			set_errno(EAGAIN);
+			return ERROR;
+		}
+		messaging_ring_wait(&rport->doorbell);
+	}
+
+	head = ring->head;
+	messaging_ring_copyout(ring, head, &pkt_size, MSG_RING_LEN_SIZE);
+	messaging_ring_copyout(ring, head + MSG_RING_LEN_SIZE, &header, MSG_HEADER_SIZE);
+
+	*sender_pid = header.sender_pid;
+	*msg_type = header.msg_type;
+	copy_len = pkt_size - header.offset;
+	if (copy_len > (uint32_t)buflen) {
+		copy_len = buflen;
+	}
+	messaging_ring_copyout(ring, head + MSG_RING_LEN_SIZE + header.offset, buf, copy_len);
+
+	ring->head = head + MSG_RING_RECORD_SIZE(pkt_size);
+	if (ring->writer_waiting) {
+		ring->writer_waiting = false;
+		sem_post(&ring->space_sem);
+	}
+
+	return (int)pkt_size;
+}
+
+/****************************************************************************
+ * Name : messaging_port_pending
+ *
+ * Description:
+ *  Return the number of rings which have unread packets.
+ ****************************************************************************/
+int messaging_port_pending(msg_port_t port)
+{
+	int count = 0;
+	msg_ring_t *ring;
+
+	if (port == MSG_PORT_INVALID) {
+		set_errno(EBADF);
+		return ERROR;
+	}
+
+	messaging_ring_lock();
+	for (ring = (msg_ring_t *)sq_peek(&port->rport->rings); ring != NULL; ring = (msg_ring_t *)sq_next(ring)) {
+		if (messaging_ring_used(ring) != 0) {
+			count++;
+		}
+	}
+	messaging_ring_unlock();
+
+	return count;
+}
+
+/****************************************************************************
+ * Name : messaging_port_notify
+ *
+ * Description:
+ *  Arm the one-shot notification. If packets were queued before arming,
+ *  the signal is raised at once so that they are not left behind.
+ ****************************************************************************/
+int messaging_port_notify(msg_port_t port, int signo, void *data)
+{
+	msg_ring_port_t *rport;
+	union sigval value;
+	bool ready;
+
+	if (port == MSG_PORT_INVALID) {
+		set_errno(EBADF);
+		return ERROR;
+	}
+	rport = port->rport;
+
+	messaging_ring_lock();
+	if (rport->notify_armed && rport->notify_pid != getpid()) {
+		messaging_ring_unlock();
+		set_errno(EBUSY);
+		return ERROR;
+	}
+	rport->notify_pid = getpid();
+	rport->notify_signo = signo;
+	rport->notify_data = data;
+	ready = (messaging_ring_next_ready(rport) != NULL);
+	rport->notify_armed = !ready;
+	messaging_ring_unlock();
+
+	if (ready) {
+		value.sival_ptr = data;
+		(void)messaging_ring_signal(rport->notify_pid, signo, value);
+	}
+
+	return OK;
+}
@@ -40,10 +40,9 @@ static int messaging_set_async_callback(const char *port_name, msg_recv_buf_t *r
 {
 	int ret;
 	msg_recv_info_t *data;
-	struct mq_attr internal_attr;
 	int recv_size;
 	char *reply_portname;
-	mqd_t mqdes;
+	msg_port_t port;
 
 	ret = messaging_set_notify_signal(SIGMSG_MESSAGING, (_sa_sigaction_t)messaging_run_callback);
 	if (ret != OK) {
@@ -52,10 +51,6 @@ static int messaging_set_async_callback(const char *port_name, msg_recv_buf_t *r
 
 	recv_size = MSG_HEADER_SIZE + recv_data->buflen;
 
-	internal_attr.mq_maxmsg = CONFIG_MESSAGING_MAXMSG;
-	internal_attr.mq_msgsize = recv_size;
-	internal_attr.mq_flags = 0;
-
 	/* Sender waits the reply with "port_name + sender_pid + _r". */
 	MSG_ASPRINTF(&reply_portname, "%s%d%s", port_name, getpid(), "_r");
 	if (reply_portname == NULL) {
@@ -63,8 +58,8 @@ static int messaging_set_async_callback(const char *port_name, msg_recv_buf_t *r
 		return ERROR;
 	}
 
-	mqdes = mq_open(reply_portname, O_RDONLY | O_CREAT, 0666, &internal_attr);
-	if (mqdes == (mqd_t)ERROR) {
+	port = messaging_port_open(reply_portname, O_RDONLY | O_CREAT, recv_size);
+	if (port == MSG_PORT_INVALID) {
 		msgdbg("[Messaging] send fail : open fail, errno %d.\n", errno);
 		MSG_FREE(reply_portname);
 		return ERROR;
@@ -76,7 +71,7 @@ static int messaging_set_async_callback(const char *port_name, msg_recv_buf_t *r
 		MSG_FREE(reply_portname);
 		return ERROR;
 	}
-	data->mqdes = mqdes;
+	data->port = port;
 	data->msg = recv_data;
 	data->user_cb = param->cb_func;
 	data->cb_data = param->cb_data;
@@ -107,38 +102,23 @@ static int messaging_set_async_callback(const char *port_name, msg_recv_buf_t *r
 int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_send_data_t *send_data, msg_callback_info_t *cb_info)
 {
 	int ret = OK;
-	mqd_t mqdes;
-	struct mq_attr internal_attr;
-	char *send_packet;
+	msg_port_t port;
+	messaging_packet_t header;
 	int send_size;
 	uint32_t send_type;
-	uint32_t msg_offset;
-	uint32_t msg_version;
 
 	send_size = MSG_HEADER_SIZE + send_data->msglen;
 
-	internal_attr.mq_maxmsg = CONFIG_MESSAGING_MAXMSG;
-	internal_attr.mq_msgsize = send_size;
-	internal_attr.mq_flags = 0;
-
-	mqdes = mq_open(port_name, O_WRONLY, 0666, &internal_attr);
-	if (mqdes == (mqd_t)ERROR) {
+	port = messaging_port_open(port_name, O_WRONLY, send_size);
+	if (port == MSG_PORT_INVALID) {
 		if (errno == ENOENT) {
-			msgdbg("[Messagmemcpying] send fail : no receiver.\n");
+			msgdbg("[Messaging] send fail : no receiver.\n");
 		} else {
 			msgdbg("[Messaging] send fail : open fail, errno %d.\n", errno);
 		}
 		return ERROR;
 	}
 
-	send_packet = (char *)MSG_ALLOC(send_size);
-	if (send_packet == NULL) {
-		msgdbg("[Messaging] send fail : out of memory for including header.\n");
-		mq_close(mqdes);
-		mq_unlink(port_name);
-		return ERROR;
-	}
-
 	/* Send packet(version 1) is like below.
 	 * +--------------------------------------------------------------------------------------------------------+
 	 * | version(4bytes) | msg_offset(4bytes) | sender_pid(4bytes) | msg type(4bytes) | message(Max 65515bytes) |
@@ -146,13 +126,11 @@ int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_s
 	 */
 
 	/* Add data header for message version and msg offset. */
-	msg_version = messaging_get_version();
-	((messaging_packet_t *)send_packet)->version = msg_version;
-	msg_offset = MSG_HEADER_SIZE;
-	((messaging_packet_t *)send_packet)->offset = msg_offset;
+	header.version = messaging_get_version();
+	header.offset = MSG_HEADER_SIZE;
 
 	/* Add data header for sender pid. */
-	((messaging_packet_t *)send_packet)->sender_pid = getpid();
+	header.sender_pid = getpid();
 
 	/* Add data header for send type. */
 	if (msg_type == MSG_SEND_NOREPLY || msg_type == MSG_SEND_MULTI) {
@@ -162,22 +140,18 @@ int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_s
 	} else {
 		send_type = MSG_REPLY_REQUIRED;
 	}
-	((messaging_packet_t *)send_packet)->msg_type = send_type;
-
-	/* Copy the real send message. */
-	memcpy(send_packet + msg_offset, send_data->msg, send_data->msglen);
+	header.msg_type = send_type;
 
-	ret = mq_send(mqdes, (char *)send_packet, send_size, send_data->priority);
+	/* The transport copies the header and the real send message into the port. */
+	ret = messaging_port_send(port, &header, send_data->msg, send_data->msglen, send_data->priority);
 	if (ret != OK) {
 		msgdbg("[Messaging] send fail : errno %d.\n", errno);
-		MSG_FREE(send_packet);
-		mq_close(mqdes);
-		mq_unlink(port_name);
+		messaging_port_close(port);
+		messaging_port_unlink(port_name);
 		return ERROR;
 	}
 
-	MSG_FREE(send_packet);
-	mq_close(mqdes);
+	messaging_port_close(port);
 	return ret;
 }
 
@@ -50,54 +50,36 @@ static int messaging_send_param_validation(const char *port_name, msg_send_data_
 static int messaging_sync_recv(const char *port_name, msg_recv_buf_t *reply_buf)
 {
 	int ret = OK;
-	mqd_t sync_mqdes;
+	msg_port_t sync_port;
 	char *sync_portname;
-	struct mq_attr internal_attr;
-	char *reply_data;
 	int reply_size;
 	int msg_type;
 
 	reply_size = reply_buf->buflen + MSG_HEADER_SIZE;
 
-	internal_attr.mq_maxmsg = CONFIG_MESSAGING_MAXMSG;
-	internal_attr.mq_msgsize = reply_size;
-	internal_attr.mq_flags = 0;
-
 	/* sender waits the reply with "port_name + sender_pid + _r". */
 	MSG_ASPRINTF(&sync_portname, "%s%d%s", port_name, getpid(), "_r");
 	if (sync_portname == NULL) {
 		msgdbg("message send fail : sync portname allocation fail.\n");
 		return ERROR;
 	}
-	sync_mqdes = mq_open(sync_portname, O_RDONLY | O_CREAT, 0666, &internal_attr);
-	if (sync_mqdes == (mqd_t)ERROR) {
+	sync_port = messaging_port_open(sync_portname, O_RDONLY | O_CREAT, reply_size);
+	if (sync_port == MSG_PORT_INVALID) {
 		msgdbg("message send fail : sync open fail %d.\n", errno);
 		MSG_FREE(sync_portname);
 		return ERROR;
 	}
 
-	reply_data = (char *)MSG_ALLOC(reply_size);
-	if (reply_data == NULL) {
-		msgdbg("message send fail : out of memory for including header\n");
-		mq_close(sync_mqdes);
-		mq_unlink(sync_portname);
-		return ERROR;
-	}
-
-	ret = mq_receive(sync_mqdes, reply_data, reply_size, 0);
+	ret = messaging_port_recv(sync_port, reply_buf->buf, reply_buf->buflen, &reply_buf->sender_pid, &msg_type);
 	if (ret < 0) {
 		msgdbg("message send fail : sync recv fail %d.\n", errno);
 		ret = ERROR;
 	} else {
-		ret = messaging_parse_packet(reply_data, reply_buf->buf, reply_buf->buflen, &reply_buf->sender_pid, &msg_type);
-		if (ret != OK) {
-			ret = ERROR;
-		}
+		ret = OK;
 	}
 
-	mq_close(sync_mqdes);
-	mq_unlink(sync_portname);
-	MSG_FREE(reply_data);
+	messaging_port_close(sync_port);
+	messaging_port_unlink(sync_portname);
 	MSG_FREE(sync_portname);
 
 	return ret;
@@ -22,9 +22,151 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <errno.h>
+#include <pthread.h>
 #include <tinyara/wifi/wifi_utils.h>
 
+#define VWIFI_NUM_CHANNELS 13
+#define VWIFI_ASSOC_MSEC 50
+
+#ifndef CONFIG_WIFIMGR_VIRTUAL_SCAN_DWELL
+#define CONFIG_WIFIMGR_VIRTUAL_SCAN_DWELL 100
+#endif
+
+#ifndef CONFIG_WIFIMGR_VIRTUAL_SCAN_APS
+#define CONFIG_WIFIMGR_VIRTUAL_SCAN_APS 2
+#endif
+
+static wifi_utils_cb_s g_cbk = {NULL, NULL, NULL, NULL, NULL, NULL};
+static volatile int g_scanning = 0;
+static char g_scan_ssid[WIFI_UTILS_SSID_LEN + 1];
+static volatile int g_connecting = 0;
+static wifi_utils_ap_config_s g_conn_config;
+
+/*
+ * Emulate a scan: every channel takes CONFIG_WIFIMGR_VIRTUAL_SCAN_DWELL ms,
+ * its access points are reported with scan_partial as soon as the channel
+ * is done and all of them once more with scan_done at the end
+ */
+static wifi_utils_scan_list_s *_vwifi_scan_channel(int channel)
+{
+	wifi_utils_scan_list_s *head = NULL, *item;
+	int i;
+
+	for (i = CONFIG_WIFIMGR_VIRTUAL_SCAN_APS - 1; i >= 0; i--) {
+		char ssid[WIFI_UTILS_SSID_LEN + 1];
+		snprintf(ssid, sizeof(ssid), "vwifi_%d_%d", channel, i);
+		if (g_scan_ssid[0] != '\0' && strcmp(ssid, g_scan_ssid) != 0) {
+			continue;
+		}
+
+		item = (wifi_utils_scan_list_s *)calloc(1, sizeof(wifi_utils_scan_list_s));
+		if (!item) {
+			break;
+		}
+		item->ap_info.channel = channel;
+		strncpy(item->ap_info.ssid, ssid, WIFI_UTILS_SSID_LEN);
+		item->ap_info.ssid_length = strlen(ssid);
+		snprintf((char *)item->ap_info.bssid, sizeof(item->ap_info.bssid), "02:00:00:00:%02x:%02x", channel, i);
+		item->ap_info.max_rate = 72200;
+		item->ap_info.rssi = -40 - ((channel * 7 + i * 13) % 50);
+		item->ap_info.phy_mode = WIFI_UTILS_IEEE_80211_N;
+		item->ap_info.ap_auth_type = WIFI_UTILS_AUTH_WPA2_PSK;
+		item->ap_info.ap_crypto_type = WIFI_UTILS_CRYPTO_AES;
+		item->next = head;
+		head = item;
+	}
+
+	return head;
+}
+
+static void *_vwifi_scan_worker(void *arg)
+{
+	wifi_utils_scan_list_s *result = NULL, **tail = &result;
+	int channel;
+
+	for (channel = 1; channel <= VWIFI_NUM_CHANNELS; channel++) {
+		usleep(CONFIG_WIFIMGR_VIRTUAL_SCAN_DWELL * 1000);
+
+		wifi_utils_scan_list_s *found = _vwifi_scan_channel(channel);
+		if (!found) {
+			continue;
+		}
+		if (g_cbk.scan_partial) {
+			g_cbk.scan_partial(found, NULL);
+		}
+
+		/* callbacks copy the list, so the nodes go on to the full result */
+		*tail = found;
+		while (*tail) {
+			tail = &(*tail)->next;
+		}
+	}
+
+	g_scanning = 0;
+	if (g_cbk.scan_done) {
+		g_cbk.scan_done(result ? WIFI_UTILS_SUCCESS : WIFI_UTILS_FAIL, result, NULL);
+	}
+
+	while (result) {
+		wifi_utils_scan_list_s *next = result->next;
+		free(result);
+		result = next;
+	}
+
+	return NULL;
+}
+
+
+static int _vwifi_find_ap(int channel, const char *ssid, const char *bssid)
+{
+	char name[WIFI_UTILS_SSID_LEN + 1];
+	char addr[WIFI_UTILS_MACADDR_STR_LEN + 1];
+	int i;
+
+	for (i = 0; i < CONFIG_WIFIMGR_VIRTUAL_SCAN_APS; i++) {
+		snprintf(name, sizeof(name), "vwifi_%d_%d", channel, i);
+		snprintf(addr, sizeof(addr), "02:00:00:00:%02x:%02x", channel, i);
+		if (strcmp(name, ssid) == 0 && (bssid[0] == '\0' || strcmp(addr, bssid) == 0)) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Emulate an association: given a BSSID and channel only that channel is
+ * probed and the connection fails if the AP isn't there. Otherwise every
+ * channel is scanned for the SSID first, like a driver does.
+ */
+static void *_vwifi_connect_worker(void *arg)
+{
+	const char *bssid = (const char *)g_conn_config.bssid;
+	int found = 0;
+	int channel;
+
+	if (bssid[0] != '\0' && g_conn_config.channel > 0 && g_conn_config.channel <= VWIFI_NUM_CHANNELS) {
+		usleep(CONFIG_WIFIMGR_VIRTUAL_SCAN_DWELL * 1000);
+		found = _vwifi_find_ap(g_conn_config.channel, g_conn_config.ssid, bssid);
+	} else {
+		for (channel = 1; channel <= VWIFI_NUM_CHANNELS; channel++) {
+			usleep(CONFIG_WIFIMGR_VIRTUAL_SCAN_DWELL * 1000);
+			found |= _vwifi_find_ap(channel, g_conn_config.ssid, "");
+		}
+	}
+	if (found) {
+		usleep(VWIFI_ASSOC_MSEC * 1000);
+	}
+
+	g_connecting = 0;
+	if (g_cbk.sta_connected) {
+		g_cbk.sta_connected(found ? WIFI_UTILS_SUCCESS : WIFI_UTILS_FAIL, NULL);
+	}
+
+	return NULL;
+}
+
 
 wifi_utils_result_e wifi_utils_init(void)
 {
@@ -40,12 +182,54 @@ wifi_utils_result_e wifi_utils_deinit(void)
 
 wifi_utils_result_e wifi_utils_scan_ap(void *arg)
 {
+	pthread_t tid;
+	wifi_utils_ap_config_s *config = (wifi_utils_ap_config_s *)arg;
+
+	if (g_scanning) {
+		return WIFI_UTILS_BUSY;
+	}
+
+	g_scan_ssid[0] = '\0';
+	if (config) {
+		strncpy(g_scan_ssid, config->ssid, WIFI_UTILS_SSID_LEN);
+		g_scan_ssid[WIFI_UTILS_SSID_LEN] = '\0';
+	}
+
+	g_scanning = 1;
+	if (pthread_create(&tid, NULL, _vwifi_scan_worker, NULL) != 0) {
+		g_scanning = 0;
+		return WIFI_UTILS_FAIL;
+	}
+	pthread_setname_np(tid, "vwifi scan");
+	pthread_detach(tid);
+
 	return WIFI_UTILS_SUCCESS;
 }
 
 
 wifi_utils_result_e wifi_utils_connect_ap(wifi_utils_ap_config_s *ap_connect_config, void *arg)
 {
+	pthread_t tid;
+
+	if (!ap_connect_config) {
+		return WIFI_UTILS_INVALID_ARGS;
+	}
+	if (g_connecting) {
+		return WIFI_UTILS_BUSY;
+	}
+
+	g_conn_config = *ap_connect_config;
+	g_conn_config.ssid[WIFI_UTILS_SSID_LEN] = '\0';
+	g_conn_config.bssid[WIFI_UTILS_MACADDR_STR_LEN] = '\0';
+
+	g_connecting = 1;
+	if (pthread_create(&tid, NULL, _vwifi_connect_worker, NULL) != 0) {
+		g_connecting = 0;
+		return WIFI_UTILS_FAIL;
+	}
+	pthread_setname_np(tid, "vwifi connect");
+	pthread_detach(tid);
+
 	return WIFI_UTILS_SUCCESS;
 }
 
@@ -58,12 +242,22 @@ wifi_utils_result_e wifi_utils_disconnect_ap(void *arg)
 
 wifi_utils_result_e wifi_utils_get_info(wifi_utils_info_s *wifi_info)
 {
+	if (!wifi_info) {
+		return WIFI_UTILS_INVALID_ARGS;
+	}
+	wifi_info->capability = WIFI_UTILS_CAP_JOIN_BSSID;
+
 	return WIFI_UTILS_SUCCESS;
 }
 
 
 wifi_utils_result_e wifi_utils_register_callback(wifi_utils_cb_s *cbk)
 {
+	if (!cbk) {
+		return WIFI_UTILS_INVALID_ARGS;
+	}
+	g_cbk = *cbk;
+
 	return WIFI_UTILS_SUCCESS;
 }
 
@@ -151,6 +151,18 @@ void _handle_user_cb(_wifimgr_usr_cb_type_e evt, void *arg)
 				cbk->scan_ap_done(NULL, WIFI_SCAN_FAIL);
 			}
 			break;
+		case CB_SCAN_PARTIAL:
+			/* optional, applications built before it was added leave it NULL */
+			if (cbk->scan_ap_partial && arg) {
+				WM_LOG_VERBOSE("[WM] call sta scan partial event\n");
+				wifi_manager_scan_info_s *info = NULL;
+				WIFIMGR_CHECK_RESULT_CLEANUP(
+					_convert_scan_info(&info, (wifi_utils_scan_list_s *)arg),
+					"parse error", , );
+				cbk->scan_ap_partial(&info);
+				_free_scan_info(info);
+			}
+			break;
 		default:
 			WIFIADD_ERR_RECORD(ERR_WIFIMGR_INVALID_EVENT);
 			WM_LOG_ERROR("[WM] Invalid State\n");
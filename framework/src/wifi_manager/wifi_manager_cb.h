@@ -27,6 +27,7 @@ enum _wifimgr_usr_cb_type {
 	CB_STA_JOINED,
 	CB_STA_LEFT,
 	CB_SCAN_DONE,
+	CB_SCAN_PARTIAL,
 	CB_SOFTAP_DONE, /* This callback does not exist, but is used for stats management. */
 	CB_MAX,
 	CB_EVT_NONE = -1
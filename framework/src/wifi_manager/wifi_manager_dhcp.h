@@ -74,7 +74,11 @@ void dhcps_del_node(void);
 #endif
 
 #ifndef CONFIG_WIFIMGR_DISABLE_DHCPC
-wifi_manager_result_e dhcpc_get_ipaddr(void);
+/*
+ * lease: the lease of the last connection to the same network to ask for
+ * again (ipaddr 0 to discover a new one). It is updated with the lease got.
+ */
+wifi_manager_result_e dhcpc_get_ipaddr(struct dhcpc_lease *lease);
 #endif
 
 void dhcpc_close_ipaddr(void);
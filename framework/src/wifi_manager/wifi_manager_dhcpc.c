@@ -31,13 +31,20 @@
  * Internal DHCP client APIs
  */
 #ifndef CONFIG_WIFIMGR_DISABLE_DHCPC
-wifi_manager_result_e dhcpc_get_ipaddr(void)
+wifi_manager_result_e dhcpc_get_ipaddr(struct dhcpc_lease *lease)
 {
 	int ret;
 	struct in_addr ip;
 	wifi_manager_result_e wret = WIFI_MANAGER_FAIL;
 
-	ret = dhcp_client_start(WIFIMGR_STA_IFNAME);
+	if (lease && lease->ipaddr.s_addr != WIFIMGR_IP4_ZERO) {
+		/* INIT-REBOOT, the DHCP client goes on to DISCOVER by itself
+		 * if the server doesn't confirm the address */
+		WM_LOG_VERBOSE("[DHCPC] request the last IP address %s\n", inet_ntoa(lease->ipaddr));
+		ret = dhcp_client_start_reboot(WIFIMGR_STA_IFNAME, lease);
+	} else {
+		ret = dhcp_client_start(WIFIMGR_STA_IFNAME);
+	}
 	if (ret != OK) {
 		WIFIADD_ERR_RECORD(ERR_WIFIMGR_CONNECT_DHCPC_FAIL);
 		WM_LOG_ERROR("[DHCPC] get IP address fail\n");
@@ -52,6 +59,10 @@ wifi_manager_result_e dhcpc_get_ipaddr(void)
 	}
 	WM_LOG_VERBOSE("[DHCPC] get IP address %s\n", inet_ntoa(ip));
 
+	if (lease && dhcp_client_get_lease(WIFIMGR_STA_IFNAME, lease) != OK) {
+		memset(lease, 0, sizeof(struct dhcpc_lease));
+	}
+
 	return WIFI_MANAGER_SUCCESS;
 }
 #endif //CONFIG_WIFIMGR_DISABLE_DHCPC
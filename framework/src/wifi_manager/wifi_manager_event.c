@@ -46,6 +46,7 @@ static char *wifimgr_evt_str[] = {
 #endif
 	"EVT_LEFT",
 	"EVT_SCAN_DONE",
+	"EVT_SCAN_PARTIAL",
 	"EVT_NONE",
 };
 
@@ -57,6 +58,7 @@ static void _wifi_utils_disconnect_event(void *arg);
 static void _wifi_utils_join_event(void *arg); // it needs arg which contains sta infomation joined
 static void _wifi_utils_leave_event(void *arg); // it needs arg which contains a sta info left
 static void _wifi_utils_scan_done(wifi_utils_result_e result, wifi_utils_scan_list_s *slist, void *arg);
+static void _wifi_utils_scan_partial(wifi_utils_scan_list_s *slist, void *arg);
 #ifndef CONFIG_WIFIMGR_DISABLE_DHCPS
 static void _wifi_dhcps_event(dhcp_evt_type_e type, void *data);
 #endif
@@ -119,6 +121,14 @@ void _wifi_utils_scan_done(wifi_utils_result_e result, wifi_utils_scan_list_s *s
 }
 
 
+void _wifi_utils_scan_partial(wifi_utils_scan_list_s *slist, void *arg)
+{
+	WM_ENTER;
+	wifimgr_msg_s msg = {EVT_SCAN_PARTIAL, (void *)slist, NULL};
+	WIFIMGR_CHECK_RESULT_NORET(wifimgr_post_message(&msg), "[WM] handle scan partial event fail\n");
+}
+
+
 /*
 * Public functions
 */
@@ -134,6 +144,7 @@ int wifimgr_get_evthandler(wifimgr_evt_handler_s *evt)
 	evt->wifi_evt.softap_sta_joined = _wifi_utils_join_event;
 	evt->wifi_evt.softap_sta_left = _wifi_utils_leave_event;
 	evt->wifi_evt.scan_done = _wifi_utils_scan_done;
+	evt->wifi_evt.scan_partial = _wifi_utils_scan_partial;
 #ifndef CONFIG_WIFIMGR_DISABLE_DHCPS
 	evt->dhcps_sta_joined = _wifi_dhcps_event;
 #endif
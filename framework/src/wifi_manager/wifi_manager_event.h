@@ -19,7 +19,7 @@
 #ifndef _WIFI_MANAGER_EVENT_H__
 #define _WIFI_MANAGER_EVENT_H__
 
-#define WIFIMGR_EVENT_INITIALIZER {NULL, {NULL, NULL, NULL, NULL, NULL} }
+#define WIFIMGR_EVENT_INITIALIZER {NULL, {NULL, NULL, NULL, NULL, NULL, NULL} }
 
 enum _wifimgr_evt {
 	EVT_INIT_CMD,				// Command to initialize WiFi Manager
@@ -41,6 +41,7 @@ enum _wifimgr_evt {
 #endif
 	EVT_LEFT,				// Event that external STA device left softAP
 	EVT_SCAN_DONE,			// Event that WiFi scanning over WLAN channels is done
+	EVT_SCAN_PARTIAL,		// Event that some WLAN channels are scanned, EVT_SCAN_DONE follows
 	EVT_NONE,
 };
 typedef enum _wifimgr_evt wifimgr_evt_e;
@@ -17,16 +17,19 @@
  ****************************************************************************/
 #include <tinyara/config.h>
 #include <debug.h>
+#include <stdlib.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <errno.h>
 #include <net/if.h>
+#include <sys/ioctl.h>
+#include <tinyara/fs/ioctl.h>
 #include <tinyara/lwnl/lwnl.h>
 #include <tinyara/wifi/wifi_utils.h>
 #include "wifi_manager_lwnl_listener.h"
 #include "wifi_manager_log.h"
 
-static wifi_utils_cb_s g_cbk = {NULL, NULL, NULL, NULL, NULL};
+static wifi_utils_cb_s g_cbk = {NULL, NULL, NULL, NULL, NULL, NULL};
 static sem_t g_lwnl_signal;
 
 static void _close_cb_handler(void)
@@ -35,7 +38,16 @@ static void _close_cb_handler(void)
 	return;
 }
 
-static int _wifi_utils_convert_scan(wifi_utils_scan_list_s **scan_list, void *input, int len)
+static void _wifi_utils_free_scan(wifi_utils_scan_list_s *scan_list)
+{
+	while (scan_list) {
+		wifi_utils_scan_list_s *next = scan_list->next;
+		free(scan_list);
+		scan_list = next;
+	}
+}
+
+static int _wifi_utils_convert_scan(wifi_utils_scan_list_s **scan_list, const void *input, int len)
 {
 	WM_LOG_VERBOSE("[WU] T%d %s len(%d)\n", getpid(), __FUNCTION__, len);
 	int remain = len;
@@ -44,7 +56,8 @@ static int _wifi_utils_convert_scan(wifi_utils_scan_list_s **scan_list, void *in
 	while (remain > 0) {
 		wifi_utils_scan_list_s *item = (wifi_utils_scan_list_s *)malloc(sizeof(wifi_utils_scan_list_s));
 		if (!item) {
-			// To Do
+			_wifi_utils_free_scan(*scan_list);
+			*scan_list = NULL;
 			return -1;
 		}
 		// definition of wifi_utils_scan_list_s and lwnl80211_scan_list shoud be same
@@ -67,19 +80,32 @@ static int _wifi_utils_convert_scan(wifi_utils_scan_list_s **scan_list, void *in
 
 static wifi_utils_scan_list_s *_handle_scan(int fd, int len)
 {
+	wifi_utils_scan_list_s *scan_list = NULL;
+	int res;
+
+	/* convert the results in place if lwnl shares them, else read a copy */
+	lwnl_scan_buf sbuf = {NULL, 0};
+	if (ioctl(fd, LWNLIOC_GETSCAN, (unsigned long)&sbuf) == 0) {
+		res = _wifi_utils_convert_scan(&scan_list, sbuf.data, sbuf.data_len);
+		ioctl(fd, LWNLIOC_PUTSCAN, (unsigned long)&sbuf);
+		if (res < 0) {
+			return NULL;
+		}
+		return scan_list;
+	}
+
 	char *buf = (char *)malloc(len);
 	if (!buf) {
 		return NULL;
 	}
 
-	int res = read(fd, buf, len);
+	res = read(fd, buf, len);
 	if (res != len) {
 		WM_LOG_ERROR("read error\n");
 		free(buf);
 		return NULL;
 	}
 
-	wifi_utils_scan_list_s *scan_list = NULL;
 	res = _wifi_utils_convert_scan(&scan_list, buf, len);
 	free(buf);
 	if (res < 0) {
@@ -129,11 +155,25 @@ static int _wifi_utils_call_event(int fd, lwnl_cb_status status, int len)
 		wifi_utils_scan_list_s *scan_list = _handle_scan(fd, len);
 		if (scan_list) {
 			g_cbk.scan_done(WIFI_UTILS_SUCCESS, scan_list, 0);
+			_wifi_utils_free_scan(scan_list);
 		} else {
 			g_cbk.scan_done(WIFI_UTILS_FAIL, NULL, NULL);
 		}
 		break;
 	}
+	case LWNL_SCAN_PARTIAL:
+	{
+		/* the payload has to be consumed even if nobody wants it */
+		if (len == 0) {
+			break;
+		}
+		wifi_utils_scan_list_s *scan_list = _handle_scan(fd, len);
+		if (scan_list && g_cbk.scan_partial) {
+			g_cbk.scan_partial(scan_list, NULL);
+		}
+		_wifi_utils_free_scan(scan_list);
+		break;
+	}
 	default:
 		WM_LOG_ERROR("Bad status received (%d)\n", status);
 		WM_ERR;
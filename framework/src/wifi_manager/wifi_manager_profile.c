@@ -45,7 +45,8 @@
 #define DELIMITER "\t"
 #define DELI_LEN 1
 
-#define WIFI_PROFILE_BUFSIZE 128
+/* the connected AP profile also carries wifi_profile_cache_s */
+#define WIFI_PROFILE_BUFSIZE 192
 
 #ifdef CONFIG_WIFI_PROFILE_SECURESTORAGE
 #define WIFI_PROFILE_SS_INDEX 1
@@ -87,7 +88,7 @@
  * Internal Functions
  */
 
-static int _wifi_profile_serialize(char *buf, uint32_t buf_size, wifi_manager_ap_config_s *config)
+static int _wifi_profile_serialize(char *buf, uint32_t buf_size, wifi_manager_ap_config_s *config, wifi_profile_cache_s *cache)
 {
 	memset(buf, 0, buf_size);
 	int pos = 0;
@@ -96,20 +97,36 @@ static int _wifi_profile_serialize(char *buf, uint32_t buf_size, wifi_manager_ap
 	int auth_type = (int)config->ap_auth_type;
 	ENCODE_INTEGER(buf, buf_size, auth_type, pos);
 
-	if (config->ap_auth_type == WIFI_MANAGER_AUTH_OPEN) {
-		return strlen(buf) + 1;
-	}
+	if (config->ap_auth_type != WIFI_MANAGER_AUTH_OPEN) {
+		ENCODE_INTEGER(buf, buf_size, config->passphrase_length, pos);
+		ENCODE_STRING(buf, buf_size, config->passphrase, pos);
 
-	ENCODE_INTEGER(buf, buf_size, config->passphrase_length, pos);
-	ENCODE_STRING(buf, buf_size, config->passphrase, pos);
+		int crypto_type = (int)config->ap_crypto_type;
+		ENCODE_INTEGER(buf, buf_size, crypto_type, pos);
+	}
 
-	int crypto_type = (int)config->ap_crypto_type;
-	ENCODE_INTEGER(buf, buf_size, crypto_type, pos);
+	if (cache) {
+		/* addresses are stored as they are in memory, the lease time
+		 * is unsigned. Both come back the same through int */
+		int bssid_length = strlen(cache->bssid);
+		int channel = (int)cache->channel;
+		int ipaddr = (int)cache->lease.ipaddr.s_addr;
+		int serverid = (int)cache->lease.serverid.s_addr;
+		int lease_time = (int)cache->lease.lease_time;
+		int lease_start = (int)cache->lease_start;
+		ENCODE_INTEGER(buf, buf_size, bssid_length, pos);
+		ENCODE_STRING(buf, buf_size, cache->bssid, pos);
+		ENCODE_INTEGER(buf, buf_size, channel, pos);
+		ENCODE_INTEGER(buf, buf_size, ipaddr, pos);
+		ENCODE_INTEGER(buf, buf_size, serverid, pos);
+		ENCODE_INTEGER(buf, buf_size, lease_time, pos);
+		ENCODE_INTEGER(buf, buf_size, lease_start, pos);
+	}
 
 	return strlen(buf) + 1;
 }
 
-static int _wifi_profile_deserialize(wifi_manager_ap_config_s *config, char *buf)
+static int _wifi_profile_deserialize(wifi_manager_ap_config_s *config, wifi_profile_cache_s *cache, char *buf)
 {
 	int pos = 0;
 	DECODE_INTEGER(buf, config->ssid_length, pos);
@@ -121,18 +138,50 @@ static int _wifi_profile_deserialize(wifi_manager_ap_config_s *config, char *buf
 	int auth_type = 0;
 	DECODE_INTEGER(buf, auth_type, pos);
 	config->ap_auth_type = (wifi_manager_ap_auth_type_e)auth_type;
-	if (config->ap_auth_type == WIFI_MANAGER_AUTH_OPEN) {
+	if (config->ap_auth_type != WIFI_MANAGER_AUTH_OPEN) {
+		DECODE_INTEGER(buf, config->passphrase_length, pos);
+		if (config->passphrase_length > WIFIMGR_PASSPHRASE_LEN) {
+			return -1;
+		}
+		DECODE_STRING(buf, config->passphrase, pos, config->passphrase_length);
+
+		int crypto_type = 0;
+		DECODE_INTEGER(buf, crypto_type, pos);
+		config->ap_crypto_type = (wifi_manager_ap_crypto_type_e)crypto_type;
+	}
+
+	if (!cache) {
+		return 0;
+	}
+	memset(cache, 0, sizeof(wifi_profile_cache_s));
+	/* profiles stored before the cache was added end here */
+	if (buf[pos] == '\0') {
 		return 0;
 	}
-	DECODE_INTEGER(buf, config->passphrase_length, pos);
-	if (config->passphrase_length > WIFIMGR_PASSPHRASE_LEN) {
+	int bssid_length = 0;
+	int channel = 0;
+	int ipaddr = 0;
+	int serverid = 0;
+	int lease_time = 0;
+	int lease_start = 0;
+	DECODE_INTEGER(buf, bssid_length, pos);
+	if (bssid_length < 0 || bssid_length > WIFIMGR_MACADDR_STR_LEN) {
 		return -1;
 	}
-	DECODE_STRING(buf, config->passphrase, pos, config->passphrase_length);
-
-	int crypto_type = 0;
-	DECODE_INTEGER(buf, crypto_type, pos);
-	config->ap_crypto_type = (wifi_manager_ap_crypto_type_e)crypto_type;
+	DECODE_STRING(buf, cache->bssid, pos, bssid_length);
+	DECODE_INTEGER(buf, channel, pos);
+	DECODE_INTEGER(buf, ipaddr, pos);
+	DECODE_INTEGER(buf, serverid, pos);
+	DECODE_INTEGER(buf, lease_time, pos);
+	/* and before the lease start was added, it's left 0 */
+	if (buf[pos] != '\0') {
+		DECODE_INTEGER(buf, lease_start, pos);
+	}
+	cache->channel = (unsigned int)channel;
+	cache->lease.ipaddr.s_addr = (in_addr_t)ipaddr;
+	cache->lease.serverid.s_addr = (in_addr_t)serverid;
+	cache->lease.lease_time = (uint32_t)lease_time;
+	cache->lease_start = (uint32_t)lease_start;
 
 	return 0;
 }
@@ -181,7 +230,7 @@ static int _wifi_profile_read_file(char *buf, unsigned int buf_size, int interna
 		WM_LOG_ERROR("fread fail\n");
 		fclose(fp);
 		return -1;
-	} else if (ret > 107) {
+	} else if (ret >= WIFI_PROFILE_BUFSIZE) {
 		WM_LOG_ERROR("file is corrupted\n");
 		fclose(fp);
 		return -1;
@@ -191,78 +240,13 @@ static int _wifi_profile_read_file(char *buf, unsigned int buf_size, int interna
 }
 #endif
 
-/*
- * Public Functions
- */
-
-wifi_utils_result_e wifi_profile_init(void)
-{
-#ifndef CONFIG_WIFI_PROFILE_SECURESTORAGE
-#ifdef WIFI_PROFILE_USE_ETC
-	DIR *dir = opendir(WIFI_PROFILE_PATH);
-	if (!dir) {
-		WM_LOG_ERROR("error reason (%d)\n", errno);
-		if (errno == ENOENT || errno == ENOTDIR) {
-			ret = mkdir(WIFI_PROFILE_PATH, 0777);
-			if (ret < 0) {
-				return WIFI_UTILS_FILE_ERROR;
-			}
-		} else {
-			return WIFI_UTILS_FILE_ERROR;
-		}
-	}
-	closedir(dir);
-#endif
-#endif
-	return WIFI_UTILS_SUCCESS;
-}
-
-wifi_utils_result_e wifi_profile_reset(int internal)
-{
-	int ret = -1;
-#ifdef CONFIG_WIFI_PROFILE_SECURESTORAGE
-	char buf = '\0';
-	security_handle hnd;
-	security_error err = security_init(&hnd);
-	if (err != SECURITY_OK) {
-		WM_LOG_ERROR("Reset wi-fi profile in SS fail\n", ret);
-		return WIFI_UTILS_FILE_ERROR;
-	}
-	security_data data = {&buf, 1};
-	char ss_name[7] = {0,};
-	int index = WIFI_PROFILE_SS_INDEX;
-	if (internal > 0) {
-		index = WIFI_PROFILE_SS_INDEX_INTERNAL;
-	}
-	snprintf(ss_name, 7, "ss/%d", index);
-	err = ss_write_secure_storage(hnd, ss_name, 0, &data);
-	if (err != SECURITY_OK) {
-		security_deinit(hnd);
-		return WIFI_UTILS_FILE_ERROR;
-	}
-
-	security_deinit(hnd);
 
-#else
-	if (internal > 0) {
-		ret = unlink(WIFI_PROFILE_PATH WIFI_PROFILE_FILENAME_INTERNAL);
-	} else {
-		ret = unlink(WIFI_PROFILE_PATH WIFI_PROFILE_FILENAME);
-	}
-	if (ret < 0) {
-		WM_LOG_ERROR("Delete Wi-Fi profile fail(%d)\n", errno);
-		return WIFI_UTILS_FILE_ERROR;
-	}
-#endif
-	return WIFI_UTILS_SUCCESS;
-}
-
-wifi_utils_result_e wifi_profile_write(wifi_manager_ap_config_s *config, int internal)
+static wifi_utils_result_e _wifi_profile_write(wifi_manager_ap_config_s *config, wifi_profile_cache_s *cache, int internal)
 {
 	char buf[WIFI_PROFILE_BUFSIZE];
 	int ret = 0;
 	int len = 0;
-	len = _wifi_profile_serialize(buf, WIFI_PROFILE_BUFSIZE	, config);
+	len = _wifi_profile_serialize(buf, WIFI_PROFILE_BUFSIZE, config, cache);
 	if (len < 0) {
 		return WIFI_UTILS_FAIL;
 	}
@@ -302,7 +286,7 @@ wifi_utils_result_e wifi_profile_write(wifi_manager_ap_config_s *config, int int
 }
 
 
-wifi_utils_result_e wifi_profile_read(wifi_manager_ap_config_s *config, int internal)
+static wifi_utils_result_e _wifi_profile_read(wifi_manager_ap_config_s *config, wifi_profile_cache_s *cache, int internal)
 {
 	char buf[WIFI_PROFILE_BUFSIZE] = {0,};
 	int ret = -1;
@@ -314,6 +298,9 @@ wifi_utils_result_e wifi_profile_read(wifi_manager_ap_config_s *config, int inte
 	// passphrase(63) + tab(1) + passphrase length(2) + tab(1) + crypto type(1) == 105
 	// file size of wifi.conf should not exceed 107(+EOF)
 	// ssid_length and passphrase length are stored as character.
+	// wifi_connected.conf adds the cache:
+	// bssid_length(2) + tab(1) + bssid(17) + tab(1) + channel(3) + tab(1) +
+	// 3 * (int(11) + tab(1)) == 62, so it should not exceed 169(+EOF)
 	//
 	/////////////////////////////////////////////////////////////////////////////////////////
 
@@ -331,7 +318,7 @@ wifi_utils_result_e wifi_profile_read(wifi_manager_ap_config_s *config, int inte
 	}
 	snprintf(ss_name, 7, "ss/%d", index);
 
-	security_data data = {buf, WIFI_PROFILE_BUFSIZE};
+	security_data data = {buf, WIFI_PROFILE_BUFSIZE - 1};
 
 	err = ss_read_secure_storage(hnd, ss_name, 0, &data);
 	if (err != SECURITY_OK) {
@@ -352,10 +339,101 @@ wifi_utils_result_e wifi_profile_read(wifi_manager_ap_config_s *config, int inte
 		return WIFI_UTILS_FILE_ERROR;
 	}
 #endif
-	ret = _wifi_profile_deserialize(config, buf);
+	ret = _wifi_profile_deserialize(config, cache, buf);
 	if (ret < 0) {
 		return WIFI_UTILS_FILE_ERROR;
 	}
 
 	return WIFI_UTILS_SUCCESS;
 }
+
+
+/*
+ * Public Functions
+ */
+
+wifi_utils_result_e wifi_profile_init(void)
+{
+#ifndef CONFIG_WIFI_PROFILE_SECURESTORAGE
+#ifdef WIFI_PROFILE_USE_ETC
+	DIR *dir = opendir(WIFI_PROFILE_PATH);
+	if (!dir) {
+		WM_LOG_ERROR("error reason (%d)\n", errno);
+		if (errno == ENOENT || errno == ENOTDIR) {
+			ret = mkdir(WIFI_PROFILE_PATH, 0777);
+			if (ret < 0) {
+				return WIFI_UTILS_FILE_ERROR;
+			}
+		} else {
+			return WIFI_UTILS_FILE_ERROR;
+		}
+	}
+	closedir(dir);
+#endif
+#endif
+	return WIFI_UTILS_SUCCESS;
+}
+
+wifi_utils_result_e wifi_profile_reset(int internal)
+{
+	int ret = -1;
+#ifdef CONFIG_WIFI_PROFILE_SECURESTORAGE
+	char buf = '\0';
+	security_handle hnd;
+	security_error err = security_init(&hnd);
+	if (err != SECURITY_OK) {
+		WM_LOG_ERROR("Reset wi-fi profile in SS fail\n", ret);
+		return WIFI_UTILS_FILE_ERROR;
+	}
+	security_data data = {&buf, 1};
+	char ss_name[7] = {0,};
+	int index = WIFI_PROFILE_SS_INDEX;
+	if (internal > 0) {
+		index = WIFI_PROFILE_SS_INDEX_INTERNAL;
+	}
+	snprintf(ss_name, 7, "ss/%d", index);
+	err = ss_write_secure_storage(hnd, ss_name, 0, &data);
+	if (err != SECURITY_OK) {
+		security_deinit(hnd);
+		return WIFI_UTILS_FILE_ERROR;
+	}
+
+	security_deinit(hnd);
+
+#else
+	if (internal > 0) {
+		ret = unlink(WIFI_PROFILE_PATH WIFI_PROFILE_FILENAME_INTERNAL);
+	} else {
+		ret = unlink(WIFI_PROFILE_PATH WIFI_PROFILE_FILENAME);
+	}
+	if (ret < 0) {
+		WM_LOG_ERROR("Delete Wi-Fi profile fail(%d)\n", errno);
+		return WIFI_UTILS_FILE_ERROR;
+	}
+#endif
+	return WIFI_UTILS_SUCCESS;
+}
+
+
+wifi_utils_result_e wifi_profile_write(wifi_manager_ap_config_s *config, int internal)
+{
+	return _wifi_profile_write(config, NULL, internal);
+}
+
+
+wifi_utils_result_e wifi_profile_read(wifi_manager_ap_config_s *config, int internal)
+{
+	return _wifi_profile_read(config, NULL, internal);
+}
+
+
+wifi_utils_result_e wifi_profile_write_connected(wifi_manager_ap_config_s *config, wifi_profile_cache_s *cache)
+{
+	return _wifi_profile_write(config, cache, 1);
+}
+
+
+wifi_utils_result_e wifi_profile_read_connected(wifi_manager_ap_config_s *config, wifi_profile_cache_s *cache)
+{
+	return _wifi_profile_read(config, cache, 1);
+}
@@ -19,9 +19,24 @@
 #ifndef _WIFI_PROFILE_H__
 #define _WIFI_PROFILE_H__
 
+#include <protocols/dhcpc.h>
+
+/*
+ * What the last connection learned about its AP and network. It is kept
+ * with the connected AP profile to rejoin the same AP fast.
+ */
+typedef struct {
+	char bssid[WIFIMGR_MACADDR_STR_LEN + 1]; // empty if unknown
+	unsigned int channel; // 0 if unknown
+	struct dhcpc_lease lease; // ipaddr is 0 if unknown
+	uint32_t lease_start; // time() when the lease was bound
+} wifi_profile_cache_s;
+
 wifi_utils_result_e wifi_profile_init(void);
 wifi_utils_result_e wifi_profile_reset(int internal);
 wifi_utils_result_e wifi_profile_write(wifi_manager_ap_config_s *config, int internal);
 wifi_utils_result_e wifi_profile_read(wifi_manager_ap_config_s *config, int internal);
+wifi_utils_result_e wifi_profile_write_connected(wifi_manager_ap_config_s *config, wifi_profile_cache_s *cache);
+wifi_utils_result_e wifi_profile_read_connected(wifi_manager_ap_config_s *config, wifi_profile_cache_s *cache);
 
 #endif //_WIFI_PROFILE_H__
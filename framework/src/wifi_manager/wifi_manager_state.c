@@ -18,6 +18,7 @@
 #include <tinyara/config.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <pthread.h>
 #include <sys/types.h>
 #include <sys/select.h>
@@ -146,6 +147,7 @@ struct _wifimgr_state_handle {
 	int terminate;	// it is protected by g_reconn_mutex to sync between the callback task and reconn_worker
 	int conn_tries; // to do: set  it by Kconfig
 	int max_tries;
+	int conn_pending; // connect request received while scanning, it starts on scan done
 };
 typedef struct _wifimgr_state_handle _wifimgr_state_handle_s;
 
@@ -165,7 +167,24 @@ static _wifimgr_state_handle_s g_manager_info = {
 										 0,
 										 WM_APINFO_INITIALIZER,
 										 WM_RECONN_INITIALIZER,
-										 0, 0, 10};
+										 0, 0, 10,
+										 0};
+
+#ifdef CONFIG_WIFIMGR_FAST_RECONNECT
+/*
+ * what the last connection learned about its AP: BSSID/channel picked from
+ * scan results and the DHCP lease. A connection to the same SSID asks the
+ * driver for that BSSID on that channel, if it can join a given BSSID, and
+ * DHCP for that address first if the lease hasn't expired.
+ */
+static struct {
+	char ssid[WIFIMGR_SSID_LEN + 1];
+	wifi_profile_cache_s info;
+	int fast_assoc; // the association in progress was asked with info.bssid
+} g_conn_cache;
+/* the driver joins a given BSSID on a given channel (WIFI_UTILS_CAP_JOIN_BSSID) */
+static int g_join_bssid;
+#endif
 
 /*  Auto connect variable */
 #if WIFIDRIVER_SUPPORT_AUTOCONNECT == 0
@@ -208,11 +227,17 @@ static pthread_cond_t g_reconn_signal = PTHREAD_COND_INITIALIZER;
 static wifi_manager_result_e _wifimgr_deinit(void);
 static wifi_manager_result_e _wifimgr_run_sta(void);
 static wifi_manager_result_e _wifimgr_connect_ap(wifi_manager_ap_config_s *config);
+static wifi_manager_result_e _wifimgr_join_ap(wifi_manager_ap_config_s *config);
 static wifi_manager_result_e _wifimgr_save_connected_config(wifi_manager_ap_config_s *config);
 static wifi_manager_result_e _wifimgr_disconnect_ap(void);
 static wifi_manager_result_e _wifimgr_run_softap(wifi_manager_softap_config_s *config);
 static wifi_manager_result_e _wifimgr_stop_softap(void);
 static wifi_manager_result_e _wifimgr_scan(wifi_manager_ap_config_s *config);
+static void _wifimgr_cache_load(void);
+static int _wifimgr_cache_get_hint(const char *ssid, wifi_utils_ap_config_s *util_config);
+static void _wifimgr_cache_learn_ap(wifi_utils_scan_list_s *slist);
+static void _wifimgr_cache_forget_ap(void);
+static wifi_manager_result_e _wifimgr_get_ipaddr(void);
 
 //
 // functions managing a state machine
@@ -325,7 +350,11 @@ wifi_manager_result_e _wifimgr_save_connected_config(wifi_manager_ap_config_s *c
 {
 #ifdef CONFIG_WIFI_MANAGER_SAVE_CONFIG
 	WM_ENTER;
+#ifdef CONFIG_WIFIMGR_FAST_RECONNECT
+	wifi_utils_result_e ret = wifi_profile_write_connected(config, &g_conn_cache.info);
+#else
 	wifi_utils_result_e ret = wifi_profile_write(config, 1);
+#endif
 	if (ret != WIFI_UTILS_SUCCESS) {
 		WM_LOG_ERROR("[WM] Failed to save the connected AP configuration in file system\n");
 		return WIFI_MANAGER_FAIL;
@@ -338,6 +367,17 @@ wifi_manager_result_e _wifimgr_save_connected_config(wifi_manager_ap_config_s *c
 wifi_manager_result_e _wifimgr_connect_ap(wifi_manager_ap_config_s *config)
 {
 	WM_ENTER;
+	wifimgr_stats_conn_start();
+	return _wifimgr_join_ap(config);
+}
+
+
+/*
+ * ask the driver to associate, the connection timing started by
+ * _wifimgr_connect_ap() keeps running across a fallback retry
+ */
+wifi_manager_result_e _wifimgr_join_ap(wifi_manager_ap_config_s *config)
+{
 	wifi_utils_ap_config_s util_config;
 	strncpy(util_config.ssid, config->ssid, WIFIMGR_SSID_LEN);
 	util_config.ssid[WIFIMGR_SSID_LEN] = '\0';
@@ -347,6 +387,7 @@ wifi_manager_result_e _wifimgr_connect_ap(wifi_manager_ap_config_s *config)
 	util_config.passphrase_length = config->passphrase_length;
 	util_config.ap_auth_type = config->ap_auth_type;
 	util_config.ap_crypto_type = config->ap_crypto_type;
+	wifimgr_stats_conn_hint(_wifimgr_cache_get_hint(config->ssid, &util_config));
 
 	wifi_utils_result_e wres = wifi_utils_connect_ap(&util_config, NULL);
 	if (wres == WIFI_UTILS_ALREADY_CONNECTED) {
@@ -441,6 +482,8 @@ wifi_manager_result_e _wifimgr_scan(wifi_manager_ap_config_s *config)
 	}
 	uconf.ap_auth_type = config->ap_auth_type;
 	uconf.ap_crypto_type = config->ap_crypto_type;
+	uconf.bssid[0] = '\0';
+	uconf.channel = 0;
 	WIFIMGR_CHECK_UTILRESULT(wifi_utils_scan_ap((void *)&uconf),
 							 "[WM] request scan to wifi utils is fail\n", WIFI_MANAGER_FAIL);
 
@@ -448,6 +491,186 @@ wifi_manager_result_e _wifimgr_scan(wifi_manager_ap_config_s *config)
 }
 
 
+void _wifimgr_cache_load(void)
+{
+#ifdef CONFIG_WIFIMGR_FAST_RECONNECT
+	/* drivers which don't report capabilities leave it 0 */
+	wifi_utils_info_s uinfo;
+	memset(&uinfo, 0, sizeof(uinfo));
+	g_join_bssid = (wifi_utils_get_info(&uinfo) == WIFI_UTILS_SUCCESS
+					&& (uinfo.capability & WIFI_UTILS_CAP_JOIN_BSSID));
+	WM_LOG_VERBOSE("[WM] driver %s BSSID/channel join\n", g_join_bssid ? "supports" : "doesn't support");
+#endif
+#if defined(CONFIG_WIFIMGR_FAST_RECONNECT) && defined(CONFIG_WIFI_MANAGER_SAVE_CONFIG)
+	wifi_manager_ap_config_s config;
+	memset(&g_conn_cache, 0, sizeof(g_conn_cache));
+	if (wifi_profile_read_connected(&config, &g_conn_cache.info) != WIFI_UTILS_SUCCESS) {
+		memset(&g_conn_cache, 0, sizeof(g_conn_cache));
+		return;
+	}
+	strncpy(g_conn_cache.ssid, config.ssid, WIFIMGR_SSID_LEN);
+	g_conn_cache.ssid[WIFIMGR_SSID_LEN] = '\0';
+#endif
+}
+
+
+#ifdef CONFIG_WIFIMGR_FAST_RECONNECT
+static void _wifimgr_cache_set_ssid(const char *ssid)
+{
+	if (strncmp(g_conn_cache.ssid, ssid, WIFIMGR_SSID_LEN) != 0) {
+		memset(&g_conn_cache, 0, sizeof(g_conn_cache));
+		strncpy(g_conn_cache.ssid, ssid, WIFIMGR_SSID_LEN);
+	}
+}
+#endif
+
+
+/*
+ * fill the BSSID/channel to join if the last connection to ssid learned them
+ * and the driver can join them, it returns 1 if it did
+ */
+int _wifimgr_cache_get_hint(const char *ssid, wifi_utils_ap_config_s *util_config)
+{
+	util_config->bssid[0] = '\0';
+	util_config->channel = 0;
+#ifdef CONFIG_WIFIMGR_FAST_RECONNECT
+	_wifimgr_cache_set_ssid(ssid);
+	g_conn_cache.fast_assoc = (g_join_bssid && g_conn_cache.info.bssid[0] != '\0'
+								&& g_conn_cache.info.channel != 0);
+	if (g_conn_cache.fast_assoc) {
+		WM_LOG_VERBOSE("[WM] join %s on channel %u\n", g_conn_cache.info.bssid, g_conn_cache.info.channel);
+		strncpy((char *)util_config->bssid, g_conn_cache.info.bssid, WIFIMGR_MACADDR_STR_LEN);
+		util_config->bssid[WIFIMGR_MACADDR_STR_LEN] = '\0';
+		util_config->channel = g_conn_cache.info.channel;
+	}
+	return g_conn_cache.fast_assoc;
+#else
+	return 0;
+#endif
+}
+
+
+/*
+ * remember the strongest BSSID of the AP to connect to or the last one
+ * connected, it is the one a full connect would most likely pick
+ */
+void _wifimgr_cache_learn_ap(wifi_utils_scan_list_s *slist)
+{
+#ifdef CONFIG_WIFIMGR_FAST_RECONNECT
+	wifi_utils_scan_list_s *best = NULL;
+
+	if (g_manager_info.connected_ap.ssid[0] != '\0') {
+		_wifimgr_cache_set_ssid(g_manager_info.connected_ap.ssid);
+	}
+	if (g_conn_cache.ssid[0] == '\0') {
+		return;
+	}
+	for (; slist; slist = slist->next) {
+		if (strncmp(slist->ap_info.ssid, g_conn_cache.ssid, WIFIMGR_SSID_LEN) != 0) {
+			continue;
+		}
+		if (!best || slist->ap_info.rssi > best->ap_info.rssi) {
+			best = slist;
+		}
+	}
+	if (best) {
+		strncpy(g_conn_cache.info.bssid, (char *)best->ap_info.bssid, WIFIMGR_MACADDR_STR_LEN);
+		g_conn_cache.info.bssid[WIFIMGR_MACADDR_STR_LEN] = '\0';
+		g_conn_cache.info.channel = best->ap_info.channel;
+	}
+#endif
+}
+
+
+/*
+ * the cached BSSID didn't answer, the next try scans all channels
+ */
+void _wifimgr_cache_forget_ap(void)
+{
+#ifdef CONFIG_WIFIMGR_FAST_RECONNECT
+	if (g_conn_cache.fast_assoc) {
+		WM_LOG_VERBOSE("[WM] forget %s on channel %u\n", g_conn_cache.info.bssid, g_conn_cache.info.channel);
+		g_conn_cache.info.bssid[0] = '\0';
+		g_conn_cache.info.channel = 0;
+		g_conn_cache.fast_assoc = 0;
+	}
+#endif
+}
+
+
+#if defined(CONFIG_WIFIMGR_FAST_RECONNECT) && !defined(CONFIG_WIFIMGR_DISABLE_DHCPC)
+/*
+ * the seconds of the cached lease which have run since it was bound. It's
+ * 0 if the clock went back, e.g. it wasn't kept across a reboot
+ */
+static uint32_t _wifimgr_cache_lease_age(time_t now)
+{
+	if (now < (time_t)g_conn_cache.info.lease_start) {
+		return 0;
+	}
+	return (uint32_t)(now - g_conn_cache.info.lease_start);
+}
+
+
+/*
+ * the cached lease has clearly expired, an infinite (or unknown) lease
+ * never does
+ */
+static int _wifimgr_cache_lease_expired(time_t now)
+{
+	uint32_t lease_time = g_conn_cache.info.lease.lease_time;
+
+	if (lease_time == 0 || lease_time == 0xffffffff) {
+		return 0;
+	}
+	return _wifimgr_cache_lease_age(now) >= lease_time;
+}
+#endif
+
+
+wifi_manager_result_e _wifimgr_get_ipaddr(void)
+{
+#ifndef CONFIG_WIFIMGR_DISABLE_DHCPC
+	wifi_manager_result_e wret;
+#ifdef CONFIG_WIFIMGR_FAST_RECONNECT
+	struct dhcpc_lease lease = g_conn_cache.info.lease;
+	time_t now = time(NULL);
+
+	if (lease.ipaddr.s_addr != WIFIMGR_IP4_ZERO && _wifimgr_cache_lease_expired(now)) {
+		/* INIT-REBOOT would only be refused, discover a new address */
+		WM_LOG_VERBOSE("[WM] the lease of %s has expired\n", inet_ntoa(lease.ipaddr));
+		memset(&g_conn_cache.info.lease, 0, sizeof(struct dhcpc_lease));
+		lease = g_conn_cache.info.lease;
+	}
+	wret = dhcpc_get_ipaddr(&lease);
+	if (wret != WIFI_MANAGER_SUCCESS) {
+		/* the next connection discovers a new address */
+		memset(&g_conn_cache.info.lease, 0, sizeof(struct dhcpc_lease));
+		return wret;
+	}
+	wifimgr_stats_conn_dhcp(g_conn_cache.info.lease.ipaddr.s_addr != WIFIMGR_IP4_ZERO &&
+							g_conn_cache.info.lease.ipaddr.s_addr == lease.ipaddr.s_addr);
+	/* the lease was (re)bound now. The profile is written again once half
+	 * of the stored lease has run, so that it isn't taken as expired while
+	 * it's still renewed */
+	if (memcmp(&g_conn_cache.info.lease, &lease, sizeof(struct dhcpc_lease)) != 0
+		|| (lease.ipaddr.s_addr != WIFIMGR_IP4_ZERO && _wifimgr_cache_lease_age(now) >= lease.lease_time / 2)) {
+		g_conn_cache.info.lease = lease;
+		g_conn_cache.info.lease_start = (uint32_t)now;
+		(void)_wifimgr_save_connected_config(&g_manager_info.connected_ap);
+	}
+#else
+	wret = dhcpc_get_ipaddr(NULL);
+	if (wret != WIFI_MANAGER_SUCCESS) {
+		return wret;
+	}
+	wifimgr_stats_conn_dhcp(0);
+#endif
+#endif
+	return WIFI_MANAGER_SUCCESS;
+}
+
+
 /*
  * State Functions
  */
@@ -469,6 +692,7 @@ wifi_manager_result_e _handler_on_uninitialized_state(wifimgr_msg_s *msg)
 #ifdef CONFIG_WIFI_MANAGER_SAVE_CONFIG
 	WIFIMGR_CHECK_UTILRESULT(wifi_profile_init(), "[WM] wifi_profile init fail\n", WIFI_MANAGER_FAIL);
 #endif
+	_wifimgr_cache_load();
 	/*  get event function pointers from event handler */
 	int res = wifimgr_get_evthandler(&g_manager_info.cbk);
 	if (res < 0) {
@@ -579,19 +803,27 @@ wifi_manager_result_e _handler_on_connecting_state(wifimgr_msg_s *msg)
 {
 	WM_LOG_HANDLER_START;
 	if (msg->event == EVT_STA_CONNECTED) {
-#ifndef CONFIG_WIFIMGR_DISABLE_DHCPC
+		wifimgr_stats_conn_assoc();
 		wifi_manager_result_e wret;
-		wret = dhcpc_get_ipaddr();
+		wret = _wifimgr_get_ipaddr();
 		if (wret != WIFI_MANAGER_SUCCESS) {
 			WIFIMGR_CHECK_RESULT(_wifimgr_disconnect_ap(), "[WM] critical error: DHCP failure\n", WIFI_MANAGER_FAIL);
 			WIFIMGR_SET_SUBSTATE(WIFIMGR_DISCONN_INTERNAL_ERROR, NULL);
 			WIFIMGR_SET_STATE(WIFIMGR_STA_DISCONNECTING);
 			return wret;
 		}
-#endif
 		wifimgr_call_cb(CB_STA_CONNECTED, NULL);
 		WIFIMGR_SET_STATE(WIFIMGR_STA_CONNECTED);
 	} else if (msg->event == EVT_STA_CONNECT_FAILED) {
+#ifdef CONFIG_WIFIMGR_FAST_RECONNECT
+		if (g_conn_cache.fast_assoc) {
+			/* the AP may have moved to another channel or BSSID, fall back to a full connect */
+			_wifimgr_cache_forget_ap();
+			if (_wifimgr_join_ap(&g_manager_info.connected_ap) == WIFI_MANAGER_SUCCESS) {
+				return WIFI_MANAGER_SUCCESS;
+			}
+		}
+#endif
 		wifimgr_call_cb(CB_STA_CONNECT_FAILED, NULL);
 		WIFIMGR_SET_STATE(WIFIMGR_STA_DISCONNECTED);
 	} else {
@@ -760,6 +992,7 @@ wifi_manager_result_e _handler_on_reconnecting_state(wifimgr_msg_s *msg)
 #if WIFIDRIVER_SUPPORT_AUTOCONNECT == 0
 	if (msg->event == EVT_STA_CONNECT_FAILED) {
 		WM_LOG_VERBOSE("[WM] reconnect fail\n");
+		_wifimgr_cache_forget_ap();
 		if (g_manager_info.conn_tries == g_manager_info.max_tries) {
 			WM_LOG_ERROR("[WM] Stop to reconnect because of reaching to max tries\n");
 			WIFIMGR_TERMINATE_RECONN_WORKER;
@@ -772,6 +1005,7 @@ wifi_manager_result_e _handler_on_reconnecting_state(wifimgr_msg_s *msg)
 		WIFIMGR_TERMINATE_RECONN_WORKER;
 		WIFIMGR_SET_STATE(WIFIMGR_STA_CONNECT_CANCEL);
 	} else if (msg->event == EVT_STA_CONNECTED) {
+		wifimgr_stats_conn_assoc();
 		WIFIMGR_TERMINATE_RECONN_WORKER;
 		wifimgr_call_cb(CB_STA_CONNECTED, NULL);
 		WIFIMGR_SET_STATE(WIFIMGR_STA_CONNECTED);
@@ -848,9 +1082,29 @@ wifi_manager_result_e _handler_on_scanning_state(wifimgr_msg_s *msg)
 	WM_LOG_HANDLER_START;
 	wifi_manager_result_e wret = WIFI_MANAGER_FAIL;
 	if (msg->event == EVT_SCAN_DONE) {
+		_wifimgr_cache_learn_ap((wifi_utils_scan_list_s *)msg->param);
 		wifimgr_call_cb(CB_SCAN_DONE, msg->param);
 		WIFIMGR_RESTORE_STATE;
 		wret = WIFI_MANAGER_SUCCESS;
+		if (g_manager_info.conn_pending) {
+			g_manager_info.conn_pending = 0;
+			if (_wifimgr_connect_ap(&g_manager_info.connected_ap) == WIFI_MANAGER_SUCCESS) {
+				WIFIMGR_SET_STATE(WIFIMGR_STA_CONNECTING);
+			} else {
+				wifimgr_call_cb(CB_STA_CONNECT_FAILED, NULL);
+			}
+		}
+	} else if (msg->event == EVT_SCAN_PARTIAL) {
+		wifimgr_call_cb(CB_SCAN_PARTIAL, msg->param);
+		wret = WIFI_MANAGER_SUCCESS;
+	} else if (msg->event == EVT_CONNECT_CMD && WIFIMGR_GET_PREVSTATE == WIFIMGR_STA_DISCONNECTED) {
+		/* an application which picked its AP from partial results doesn't
+		 * have to wait for the scan to finish before it asks to connect */
+		_wifimgr_conn_info_msg_s *conn_msg = (_wifimgr_conn_info_msg_s *)msg->param;
+		WIFIMGR_COPY_AP_INFO(g_manager_info.connected_ap, *(conn_msg->config));
+		WIFIMGR_COPY_RECONN_INFO(g_manager_info.conn_config, *(conn_msg->conn_config));
+		g_manager_info.conn_pending = 1;
+		wret = WIFI_MANAGER_SUCCESS;
 	} else {
 		WIFIADD_ERR_RECORD(ERR_WIFIMGR_INVALID_EVENT);
 	}
@@ -19,11 +19,60 @@
 #include <tinyara/config.h>
 
 #include <stdint.h>
+#include <time.h>
 #include <wifi_manager/wifi_manager.h>
 #include "wifi_manager_cb.h"
 
 static uint16_t g_wifimgr_stats[CB_MAX];
 
+/* the last (re)connection, it is only updated by the wifi manager task */
+static struct {
+	uint32_t start;
+	uint32_t assoc;
+	uint32_t assoc_time;
+	uint32_t dhcp_time;
+	uint8_t fast_assoc;
+	uint8_t fast_dhcp;
+} g_wifimgr_conn_stats;
+
+static uint32_t _wifimgr_get_msec(void)
+{
+	struct timespec ts;
+#ifdef CONFIG_CLOCK_MONOTONIC
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+	clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+	return (uint32_t)ts.tv_sec * 1000 + (uint32_t)(ts.tv_nsec / 1000000);
+}
+
+void wifimgr_stats_conn_start(void)
+{
+	g_wifimgr_conn_stats.start = _wifimgr_get_msec();
+	g_wifimgr_conn_stats.assoc = 0;
+	g_wifimgr_conn_stats.assoc_time = 0;
+	g_wifimgr_conn_stats.dhcp_time = 0;
+	g_wifimgr_conn_stats.fast_assoc = 0;
+	g_wifimgr_conn_stats.fast_dhcp = 0;
+}
+
+void wifimgr_stats_conn_hint(int fast_assoc)
+{
+	g_wifimgr_conn_stats.fast_assoc = fast_assoc ? 1 : 0;
+}
+
+void wifimgr_stats_conn_assoc(void)
+{
+	g_wifimgr_conn_stats.assoc = _wifimgr_get_msec();
+	g_wifimgr_conn_stats.assoc_time = g_wifimgr_conn_stats.assoc - g_wifimgr_conn_stats.start;
+}
+
+void wifimgr_stats_conn_dhcp(int fast_dhcp)
+{
+	g_wifimgr_conn_stats.dhcp_time = _wifimgr_get_msec() - g_wifimgr_conn_stats.assoc;
+	g_wifimgr_conn_stats.fast_dhcp = fast_dhcp ? 1 : 0;
+}
+
 void wifimgr_inc_stats(int cb)
 {
 	g_wifimgr_stats[cb]++;
@@ -42,4 +91,9 @@ void wifimgr_get_stats(wifi_manager_stats_s *stats)
 
 	/* SoftAP mode has no callback */
 	stats->softap = g_wifimgr_stats[CB_SOFTAP_DONE];
+
+	stats->assoc_time = g_wifimgr_conn_stats.assoc_time;
+	stats->dhcp_time = g_wifimgr_conn_stats.dhcp_time;
+	stats->fast_assoc = g_wifimgr_conn_stats.fast_assoc;
+	stats->fast_dhcp = g_wifimgr_conn_stats.fast_dhcp;
 }
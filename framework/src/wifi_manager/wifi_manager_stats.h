@@ -22,5 +22,12 @@
 #define WIFIMGR_STATS_INC(s) wifimgr_inc_stats(s)
 
 void wifimgr_inc_stats(int stats);
+void wifimgr_get_stats(wifi_manager_stats_s *stats);
+
+/* timing of the connection phases */
+void wifimgr_stats_conn_start(void);
+void wifimgr_stats_conn_hint(int fast_assoc);
+void wifimgr_stats_conn_assoc(void);
+void wifimgr_stats_conn_dhcp(int fast_dhcp);
 
 #endif // _WIFI_MANAGER_STATS_H__
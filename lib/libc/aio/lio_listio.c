@@ -307,7 +307,6 @@ static int lio_sigsetup(FAR struct aiocb *const *list, int nent, FAR struct sige
 
 	/* Attach our signal handler */
 
-	printf("waiter_main: Registering signal handler\n");
 	act.sa_sigaction = lio_sighandler;
 	act.sa_flags = SA_SIGINFO;
 
@@ -549,7 +548,9 @@ int lio_listio(int mode, FAR struct aiocb *const list[], int nent, FAR struct si
 
 	/* Lock the scheduler so that no I/O events can complete on the worker
 	 * thread until we set our wait set up.  Pre-emption will, of course, be
-	 * re-enabled while we are waiting for the signal.
+	 * re-enabled while we are waiting for the signal.  With CONFIG_FS_AIO_POOL
+	 * this also hands the whole list to the AIO threads at once, so that its
+	 * adjacent requests to a file are merged.
 	 */
 
 	sched_lock();
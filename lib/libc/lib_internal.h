@@ -80,6 +80,18 @@
 #define CONFIG_LIB_HOMEDIR "/"
 #endif
 
+/* Number of lookup tables used by the CRC routines in libc/misc.  With more
+ * tables, more input bytes are folded into the CRC in each loop iteration.
+ */
+
+#if defined(CONFIG_LIBC_CRC_SLICE_BY_8)
+#define LIB_CRC_NSLICES 8
+#elif defined(CONFIG_LIBC_CRC_SLICE_BY_4)
+#define LIB_CRC_NSLICES 4
+#else
+#define LIB_CRC_NSLICES 1
+#endif
+
 /* If C std I/O buffering is not supported, then we don't need its semaphore
  * protection.
  */
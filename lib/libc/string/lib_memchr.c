@@ -57,6 +57,7 @@
 #include <tinyara/config.h>
 
 #include <string.h>
+#include "lib_string.h"
 
 /****************************************************************************
  * Global Functions
@@ -76,11 +77,32 @@
  *
  ****************************************************************************/
 
+#ifndef CONFIG_ARCH_MEMCHR
 FAR void *memchr(FAR const void *s, int c, size_t n)
 {
 	FAR const unsigned char *p = (FAR const unsigned char *)s;
+#ifdef CONFIG_MEMCHR_OPTSPEED
+	FAR const uintptr_t *wp;
+	uintptr_t pattern;
+#endif
 
 	if (s) {
+#ifdef CONFIG_MEMCHR_OPTSPEED
+		/* Skip whole words which do not contain 'c' */
+
+		for (; n > 0 && !LIB_WORD_ALIGNED(p); p++, n--) {
+			if (*p == (unsigned char)c) {
+				return (FAR void *)p;
+			}
+		}
+
+		pattern = LIB_WORD_REPEAT(c);
+		for (wp = (FAR const uintptr_t *)p; n >= LIB_WORD_SIZE && !LIB_WORD_HASZERO(*wp ^ pattern); wp++) {
+			n -= LIB_WORD_SIZE;
+		}
+		p = (FAR const unsigned char *)wp;
+#endif
+
 		while (n--) {
 			if (*p == (unsigned char)c) {
 				return (FAR void *)p;
@@ -92,3 +114,4 @@ FAR void *memchr(FAR const void *s, int c, size_t n)
 
 	return NULL;
 }
+#endif
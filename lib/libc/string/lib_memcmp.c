@@ -61,6 +61,7 @@
 #include <tinyara/config.h>
 #include <sys/types.h>
 #include <string.h>
+#include "lib_string.h"
 
 /************************************************************
  * Global Functions
@@ -72,6 +73,29 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
 	unsigned char *p1 = (unsigned char *)s1;
 	unsigned char *p2 = (unsigned char *)s2;
 
+#ifdef CONFIG_MEMCMP_OPTSPEED
+	/* Skip the equal words when both buffers have the same alignment.  The
+	 * first different word is compared again byte by byte below.
+	 */
+
+	if (n >= 2 * LIB_WORD_SIZE && (((uintptr_t)p1 ^ (uintptr_t)p2) & LIB_WORD_MASK) == 0) {
+		while (!LIB_WORD_ALIGNED(p1)) {
+			if (*p1 != *p2) {
+				return (*p1 < *p2) ? -1 : 1;
+			}
+			p1++;
+			p2++;
+			n--;
+		}
+
+		while (n >= LIB_WORD_SIZE && *(uintptr_t *)p1 == *(uintptr_t *)p2) {
+			p1 += LIB_WORD_SIZE;
+			p2 += LIB_WORD_SIZE;
+			n -= LIB_WORD_SIZE;
+		}
+	}
+#endif
+
 	while (n-- > 0) {
 		if (*p1 < *p2) {
 			return -1;
@@ -61,6 +61,7 @@
 #include <tinyara/config.h>
 #include <sys/types.h>
 #include <string.h>
+#include "lib_string.h"
 
 /****************************************************************************
  * Global Functions
@@ -75,6 +76,73 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
 	FAR unsigned char *pout = (FAR unsigned char *)dest;
 	FAR unsigned char *pin = (FAR unsigned char *)src;
+
+#ifdef CONFIG_MEMCPY_OPTSPEED
+	/* This version copies whole words once the destination is word aligned.
+	 * If the source has a different alignment, aligned source words are
+	 * read and merged with shifts, so no unaligned access is ever made.
+	 */
+
+	FAR uintptr_t *wout;
+	FAR const uintptr_t *win;
+	uintptr_t prev;
+	uintptr_t next;
+	unsigned int shift;
+
+	if (n >= 2 * LIB_WORD_SIZE) {
+		/* Align the destination to a word boundary */
+
+		while (!LIB_WORD_ALIGNED(pout)) {
+			*pout++ = *pin++;
+			n--;
+		}
+
+		wout = (FAR uintptr_t *)pout;
+		if (LIB_WORD_ALIGNED(pin)) {
+			win = (FAR const uintptr_t *)pin;
+
+			while (n >= 4 * LIB_WORD_SIZE) {
+				wout[0] = win[0];
+				wout[1] = win[1];
+				wout[2] = win[2];
+				wout[3] = win[3];
+				wout += 4;
+				win += 4;
+				n -= 4 * LIB_WORD_SIZE;
+			}
+
+			while (n >= LIB_WORD_SIZE) {
+				*wout++ = *win++;
+				n -= LIB_WORD_SIZE;
+			}
+
+			pin = (FAR unsigned char *)win;
+		} else {
+			shift = ((uintptr_t)pin & LIB_WORD_MASK) * 8;
+			win = (FAR const uintptr_t *)((uintptr_t)pin & ~LIB_WORD_MASK);
+			prev = *win++;
+
+			/* The last aligned word read here still holds a byte which is
+			 * copied, so nothing beyond the source buffer's last word is read.
+			 */
+
+			while (n >= LIB_WORD_SIZE) {
+				next = *win++;
+#ifdef CONFIG_ENDIAN_BIG
+				*wout++ = (prev << shift) | (next >> (8 * LIB_WORD_SIZE - shift));
+#else
+				*wout++ = (prev >> shift) | (next << (8 * LIB_WORD_SIZE - shift));
+#endif
+				prev = next;
+				pin += LIB_WORD_SIZE;
+				n -= LIB_WORD_SIZE;
+			}
+		}
+
+		pout = (FAR unsigned char *)wout;
+	}
+#endif
+
 	while (n-- > 0) {
 		*pout++ = *pin++;
 	}
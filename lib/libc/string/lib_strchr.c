@@ -57,6 +57,7 @@
 #include <tinyara/config.h>
 
 #include <string.h>
+#include "lib_string.h"
 
 /****************************************************************************
  * Global Functions
@@ -79,6 +80,37 @@
 #ifndef CONFIG_ARCH_STRCHR
 FAR char *strchr(FAR const char *s, int c)
 {
+#ifdef CONFIG_STRCHR_OPTSPEED
+	FAR const uintptr_t *ws;
+	uintptr_t pattern;
+
+	if (s) {
+		/* Skip whole words which have neither 'c' nor the terminator */
+
+		for (; !LIB_WORD_ALIGNED(s); s++) {
+			if (*s == (char)c) {
+				return (FAR char *)s;
+			}
+
+			if (!*s) {
+				return NULL;
+			}
+		}
+
+		pattern = LIB_WORD_REPEAT(c);
+		for (ws = (FAR const uintptr_t *)s; !LIB_WORD_HASZERO(*ws) && !LIB_WORD_HASZERO(*ws ^ pattern); ws++);
+
+		for (s = (FAR const char *)ws;; s++) {
+			if (*s == (char)c) {
+				return (FAR char *)s;
+			}
+
+			if (!*s) {
+				break;
+			}
+		}
+	}
+#else
 	if (s) {
 		for (;; s++) {
 			if (*s == c) {
@@ -90,6 +122,7 @@ FAR char *strchr(FAR const char *s, int c)
 			}
 		}
 	}
+#endif
 
 	return NULL;
 }
@@ -57,6 +57,7 @@
 #include <tinyara/config.h>
 
 #include <string.h>
+#include "lib_string.h"
 
 /****************************************************************************
  * Public Functions
@@ -65,6 +66,41 @@
 #ifndef CONFIG_ARCH_STRCMP
 int strcmp(const char *cs, const char *ct)
 {
+#ifdef CONFIG_STRCMP_OPTSPEED
+	/* Compare a word at a time while both strings have the same alignment and
+	 * the words are equal and have no terminator.  The rest is compared as
+	 * unsigned char, as required by the C standard.
+	 */
+
+	const uintptr_t *w1;
+	const uintptr_t *w2;
+	unsigned char c1;
+	unsigned char c2;
+
+	if ((((uintptr_t)cs ^ (uintptr_t)ct) & LIB_WORD_MASK) == 0) {
+		for (; !LIB_WORD_ALIGNED(cs); cs++, ct++) {
+			if (*cs != *ct || *cs == '\0') {
+				return (unsigned char)*cs - (unsigned char)*ct;
+			}
+		}
+
+		w1 = (const uintptr_t *)cs;
+		w2 = (const uintptr_t *)ct;
+		while (*w1 == *w2 && !LIB_WORD_HASZERO(*w1)) {
+			w1++;
+			w2++;
+		}
+		cs = (const char *)w1;
+		ct = (const char *)w2;
+	}
+
+	do {
+		c1 = (unsigned char)*cs++;
+		c2 = (unsigned char)*ct++;
+	} while (c1 == c2 && c1 != '\0');
+
+	return c1 - c2;
+#else
 	register signed char result;
 	for (;;) {
 		if ((result = *cs - *ct++) != 0 || !*cs++) {
@@ -72,5 +108,6 @@ int strcmp(const char *cs, const char *ct)
 		}
 	}
 	return result;
+#endif
 }
 #endif
@@ -0,0 +1,53 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * libc/string/lib_string.h
+ ****************************************************************************/
+
+#ifndef __LIB_LIBC_STRING_LIB_STRING_H
+#define __LIB_LIBC_STRING_LIB_STRING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Helpers for the word-at-a-time versions of the string functions which are
+ * selected by the *_OPTSPEED options.  A word is the natural register size of
+ * the CPU.  Words are only read from word-aligned addresses, so a word never
+ * crosses into a memory region which the byte-wise version would not touch.
+ *
+ * LIB_WORD_HASZERO(w) is non-zero if and only if one of the bytes of w is
+ * zero.  LIB_WORD_REPEAT(c) fills every byte of a word with the byte c, so
+ * LIB_WORD_HASZERO(w ^ LIB_WORD_REPEAT(c)) finds the byte c in w.
+ */
+
+#define LIB_WORD_SIZE          sizeof(uintptr_t)
+#define LIB_WORD_MASK          (LIB_WORD_SIZE - 1)
+#define LIB_WORD_ALIGNED(p)    (((uintptr_t)(p) & LIB_WORD_MASK) == 0)
+#define LIB_WORD_ONES          ((uintptr_t)-1 / 0xff)
+#define LIB_WORD_HIGHS         (LIB_WORD_ONES * 0x80)
+#define LIB_WORD_HASZERO(w)    (((w) - LIB_WORD_ONES) & ~(w) & LIB_WORD_HIGHS)
+#define LIB_WORD_REPEAT(c)     (LIB_WORD_ONES * (unsigned char)(c))
+
+#endif /* __LIB_LIBC_STRING_LIB_STRING_H */
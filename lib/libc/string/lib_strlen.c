@@ -57,6 +57,7 @@
 #include <tinyara/config.h>
 #include <sys/types.h>
 #include <string.h>
+#include "lib_string.h"
 
 /****************************************************************************
  * Global Functions
@@ -66,7 +67,25 @@
 size_t strlen(const char *s)
 {
 	const char *sc;
-	for (sc = s; *sc != '\0'; ++sc);
+#ifdef CONFIG_STRLEN_OPTSPEED
+	const uintptr_t *wc;
+
+	/* Check byte by byte up to a word boundary, then a word at a time until
+	 * the word which holds the terminator.
+	 */
+
+	for (sc = s; !LIB_WORD_ALIGNED(sc); ++sc) {
+		if (*sc == '\0') {
+			return sc - s;
+		}
+	}
+
+	for (wc = (const uintptr_t *)sc; !LIB_WORD_HASZERO(*wc); ++wc);
+	sc = (const char *)wc;
+#else
+	sc = s;
+#endif
+	for (; *sc != '\0'; ++sc);
 	return sc - s;
 }
 #endif
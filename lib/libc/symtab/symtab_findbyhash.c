@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <string.h>
+#include <assert.h>
+
+#include <tinyara/symtab.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: symtab_hash
+ *
+ * Description:
+ *   Hash a symbol name for a perfect hash symbol table index.  This is
+ *   FNV-1a with the seed folded into the offset basis, followed by a final
+ *   avalanche so that the low bits used by the modulo depend on every byte.
+ *   tools/mksymtab.c carries a copy which must be kept identical.
+ *
+ ****************************************************************************/
+
+uint32_t symtab_hash(FAR const char *name, uint32_t seed)
+{
+	uint32_t hash = 2166136261u ^ seed;
+
+	while (*name != '\0') {
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619u;
+	}
+
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bu;
+	hash ^= hash >> 13;
+	return hash;
+}
+
+/****************************************************************************
+ * Name: symtab_findbyhash
+ *
+ * Description:
+ *   Find the symbol in the symbol table with the matching name using a
+ *   perfect hash index generated by tools/mksymtab.  Access time does not
+ *   depend upon the number of symbols: the name is hashed once to select
+ *   a bucket, hashed again with the seed of that bucket to select the only
+ *   slot that can hold it, and compared once.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *symtab_findbyhash(FAR const struct symtab_hash_s *hash, FAR const char *name)
+{
+	FAR const struct symtab_s *symbol;
+	uint32_t seed;
+
+	DEBUGASSERT(hash != NULL && name != NULL);
+
+	if (hash->nsyms == 0 || hash->nseeds == 0) {
+		return NULL;
+	}
+
+	seed = hash->seeds[symtab_hash(name, 0) % hash->nseeds];
+	symbol = &hash->symtab[symtab_hash(name, seed) % hash->nsyms];
+
+	/* Names which are not in the table land on an arbitrary slot, and
+	 * symbols which are configured out keep their slot with no value.
+	 */
+
+	if (symbol->sym_value == NULL || strcmp(name, symbol->sym_name) != 0) {
+		return NULL;
+	}
+
+	return symbol;
+}
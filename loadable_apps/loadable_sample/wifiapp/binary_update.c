@@ -188,6 +188,14 @@ static void print_binary_info_list(binary_update_info_list_t *binary_info_list)
 		binary_info_list->bin_info[bin_idx].name, binary_info_list->bin_info[bin_idx].active_ver, \
 		binary_info_list->bin_info[bin_idx].inactive_partsize, binary_info_list->bin_info[bin_idx].active_dev, binary_info_list->bin_info[bin_idx].inactive_dev);
 	}
+	printf(" -------------------------------------------------------------------- \n");
+	printf(" %4s | %6s | %8s | %8s | %8s | %8s (msec)\n", "Idx", "Name", "Verify", "Wait", "Load", "Start");
+	printf(" -------------------------------------------------------------------- \n");
+	for (bin_idx = 0; bin_idx < binary_info_list->bin_count; bin_idx++) {
+		printf(" %4d | %6s | %8u | %8u | %8u | %8u\n", bin_idx, binary_info_list->bin_info[bin_idx].name, \
+		binary_info_list->bin_info[bin_idx].load_time.verify, binary_info_list->bin_info[bin_idx].load_time.wait, \
+		binary_info_list->bin_info[bin_idx].load_time.load, binary_info_list->bin_info[bin_idx].load_time.start);
+	}
 	printf(" ==================================================================== \n");
 }
 
@@ -65,6 +65,9 @@
 #if defined(CONFIG_BLUETOOTH) && defined(CONFIG_BLUETOOTH_NULL)
 #include <tinyara/bluetooth/bt_null.h>
 #endif
+#ifdef CONFIG_SERIAL_LOOPBACK
+#include <tinyara/serial/serial.h>
+#endif
 
 #include <arch/board/board.h>
 
@@ -244,6 +247,10 @@ void up_initialize(void)
 	devzero_register();			/* Standard /dev/zero */
 #endif
 
+#if defined(CONFIG_SERIAL_LOOPBACK)
+	uart_loopback_register();	/* Serial loopback /dev/ttyLB0 */
+#endif
+
 #endif							/* CONFIG_NFILE_DESCRIPTORS */
 
 	/* Initialize the serial device driver */
@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/sched.h>
+#include <arch/irq.h>
+
+#include "sched/sched.h"
+#include "up_internal.h"
+
+#ifdef CONFIG_SCHED_PROFILE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The APCS frames below are only built by code in the ARM state.  Thumb-2
+ * code, which is all the Cortex-M cores run, uses r7 as its frame pointer
+ * with a different layout, so only the interrupted pc is recorded there.
+ */
+
+#if defined(CONFIG_FRAME_POINTER) && defined(CONFIG_ARCH_CORTEXR4)
+#define PROFILE_APCS_FRAMES 1
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_profile_backtrace
+ *
+ * Description:
+ *   Return the program counter the timer interrupt stopped at and the
+ *   return addresses of its callers.  On the ARMv7-R cores, the callers
+ *   are found through the APCS frames built with CONFIG_FRAME_POINTER, the
+ *   layout the call stack dump of armv7-r/arm_assert.c walks as well: fp
+ *   points at the saved pc, below it are the saved lr, sp and the fp of
+ *   the caller.
+ *
+ ****************************************************************************/
+
+int up_profile_backtrace(FAR uintptr_t *pcs, int depth)
+{
+#ifdef PROFILE_APCS_FRAMES
+	FAR struct tcb_s *rtcb = this_task();
+	uintptr_t high;
+	uintptr_t low;
+	uintptr_t fp;
+#endif
+	int n;
+
+	if (current_regs == NULL || depth < 1) {
+		return 0;
+	}
+
+	pcs[0] = current_regs[REG_PC];
+	n = 1;
+
+#ifdef PROFILE_APCS_FRAMES
+	/* Only follow frames within the stack of the interrupted thread, and
+	 * only towards its top.  Anything else means the interrupted code did
+	 * not have a frame (yet) and ends the chain.
+	 */
+
+	high = (uintptr_t)rtcb->adj_stack_ptr;
+	low  = high - rtcb->adj_stack_size;
+	fp   = current_regs[REG_FP];
+
+	while (n < depth) {
+		if ((fp & 3) != 0 || fp < low + 12 || fp > high - 4) {
+			break;
+		}
+
+		pcs[n++] = ((FAR uint32_t *)fp)[-1] & ~1;
+
+		if (((FAR uint32_t *)fp)[-3] <= fp) {
+			break;
+		}
+
+		fp = ((FAR uint32_t *)fp)[-3];
+	}
+#endif
+
+	return n;
+}
+
+#endif /* CONFIG_SCHED_PROFILE */
@@ -63,6 +63,9 @@
 #include <tinyara/net/telnet.h>
 #include <tinyara/syslog/syslog.h>
 #include <tinyara/syslog/syslog_console.h>
+#ifdef CONFIG_SERIAL_LOOPBACK
+#include <tinyara/serial/serial.h>
+#endif
 #include <arch/board/board.h>
 
 #include "xtensa.h"
@@ -202,6 +205,10 @@ void up_initialize(void)
 	devzero_register();			/* Standard /dev/zero */
 #endif
 
+#if defined(CONFIG_SERIAL_LOOPBACK)
+	uart_loopback_register();	/* Serial loopback /dev/ttyLB0 */
+#endif
+
 #if defined(CONFIG_DEV_LOOP)
 	loop_register();			/* Standard /dev/loop */
 #endif
@@ -0,0 +1,106 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stddef.h>
+
+#include <tinyara/binfmt/symtab.h>
+
+#ifdef CONFIG_SYMTAB_PERFECTHASH
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR const struct symtab_hash_s *g_exec_hashtab;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: exec_gethashtab
+ *
+ * Description:
+ *   Get the perfect hash index registered by exec_sethashtab().
+ *
+ * Returned Value:
+ *   The registered index or NULL if there is none.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_hash_s *exec_gethashtab(void)
+{
+	return g_exec_hashtab;
+}
+
+/****************************************************************************
+ * Name: exec_sethashtab
+ *
+ * Description:
+ *   Register the perfect hash index generated by tools/mksymtab -p for an
+ *   exported symbol table.  The loaders use it instead of searching by name
+ *   whenever they bind against the symbol table that it indexes.
+ *
+ * Input Parameters:
+ *   hash - The perfect hash index or NULL to remove it.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void exec_sethashtab(FAR const struct symtab_hash_s *hash)
+{
+	g_exec_hashtab = hash;
+}
+
+/****************************************************************************
+ * Name: exec_findsymbol
+ *
+ * Description:
+ *   Find an exported symbol by name, using the registered perfect hash index
+ *   if it indexes 'exports' or a search of 'exports' otherwise.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *exec_findsymbol(FAR const struct symtab_s *exports, int nexports, FAR const char *name)
+{
+	FAR const struct symtab_hash_s *hash = g_exec_hashtab;
+
+	if (hash != NULL && hash->symtab == exports && hash->nsyms == nexports) {
+		return symtab_findbyhash(hash, name);
+	}
+
+#ifdef CONFIG_SYMTAB_ORDEREDBYNAME
+	return symtab_findorderedbyname(exports, name, nexports);
+#else
+	return symtab_findbyname(exports, name, nexports);
+#endif
+}
+
+#endif							/* CONFIG_SYMTAB_PERFECTHASH */
@@ -59,6 +59,7 @@
 #include <tinyara/binfmt/binfmt.h>
 #include <tinyara/binfmt/builtin.h>
 #include <tinyara/binfmt/elf.h>
+#include <tinyara/binfmt/symtab.h>
 
 #ifdef CONFIG_BINFMT_ENABLE
 
@@ -106,6 +107,13 @@ void binfmt_initialize(void)
 	}
 #endif
 
+#ifdef CONFIG_SYMTAB_PERFECTHASH
+	/* Export the generated symbol table to exec[l|v] together with its index */
+
+	exec_setsymtab(g_symtab_hash.symtab, g_symtab_hash.nsyms);
+	exec_sethashtab(&g_symtab_hash);
+#endif
+
 	UNUSED(ret);
 }
 
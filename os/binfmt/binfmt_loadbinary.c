@@ -30,6 +30,7 @@
 #endif
 
 #include <tinyara/kmalloc.h>
+#include <tinyara/clock.h>
 #include <tinyara/sched.h>
 #include <tinyara/binfmt/binfmt.h>
 #include <tinyara/binary_manager.h>
@@ -71,6 +72,7 @@
 int load_binary(int binary_idx, FAR const char *filename, load_attr_t *load_attr)
 {
 	FAR struct binary_s *bin = NULL;
+	clock_t start_time;
 	int pid;
 	int errcode;
 	int ret;
@@ -82,6 +84,8 @@ int load_binary(int binary_idx, FAR const char *filename, load_attr_t *load_attr
 		goto errout;
 	}
 
+	start_time = clock_systimer();
+
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
 	bin = load_attr->binp;
 	/* If we find a non-null value for bin, it means that
@@ -112,6 +116,11 @@ int load_binary(int binary_idx, FAR const char *filename, load_attr_t *load_attr
 		/* Initialize the binary structure */
 
 		bin->filename = filename;
+
+		/* The binaries of the binary manager run unprivileged and are linked
+		 * with their own libraries, so no kernel symbol is exported to them.
+		 */
+
 		bin->exports = NULL;
 		bin->nexports = 0;
 		bin->filelen = load_attr->bin_size;
@@ -147,6 +156,11 @@ int load_binary(int binary_idx, FAR const char *filename, load_attr_t *load_attr
 	}
 #endif
 
+	if (load_attr->load_time) {
+		load_attr->load_time->load = TICK2MSEC(clock_systimer() - start_time);
+		start_time = clock_systimer();
+	}
+
 	/* Start the module */
 	pid = exec_module(bin);
 	if (pid < 0) {
@@ -155,6 +169,10 @@ int load_binary(int binary_idx, FAR const char *filename, load_attr_t *load_attr
 		goto errout_with_unload;
 	}
 
+	if (load_attr->load_time) {
+		load_attr->load_time->start = TICK2MSEC(clock_systimer() - start_time);
+	}
+
 	return pid;
 
 errout_with_unload:
@@ -160,6 +160,19 @@ int elf_findsymtab(FAR struct elf_loadinfo_s *loadinfo);
 
 void elf_readsymtab(FAR struct elf_loadinfo_s *loadinfo);
 
+/****************************************************************************
+ * Name: elf_readstrtab
+ *
+ * Description:
+ *   Read the string table of the symbol table into memory.
+ *
+ * Input Parameters:
+ *   loadinfo - Load state information
+ *
+ ****************************************************************************/
+
+void elf_readstrtab(FAR struct elf_loadinfo_s *loadinfo);
+
 /****************************************************************************
  * Name: elf_readsym
  *
@@ -206,6 +219,30 @@ int elf_readsym(FAR struct elf_loadinfo_s *loadinfo, int index, FAR Elf32_Sym *s
 
 int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf32_Sym *sym, FAR const struct symtab_s *exports, int nexports);
 
+/****************************************************************************
+ * Name: elf_symcache_bind
+ *
+ * Description:
+ *   Resolve every named undefined symbol of the in-memory symbol table.  The
+ *   values are taken from the symbol cache file of the binary if it matches
+ *   the ELF file and 'exports'; otherwise they are looked up by name and the
+ *   cache file is rewritten for the next load.
+ *
+ * Input Parameters:
+ *   loadinfo - Load state information
+ *   exports  - The symbol table to use for resolving undefined symbols.
+ *   nexports - Number of symbols in the symbol table.
+ *
+ * Returned Value:
+ *   None.  Symbols which cannot be resolved are left for elf_symvalue() to
+ *   report when a relocation uses them.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_SYMCACHE
+void elf_symcache_bind(FAR struct elf_loadinfo_s *loadinfo, FAR const struct symtab_s *exports, int nexports);
+#endif
+
 /****************************************************************************
  * Name: elf_freebuffers
  *
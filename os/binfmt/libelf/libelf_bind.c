@@ -309,8 +309,9 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo, FAR const struct symtab_s *exp
 		return ret;
 	}
 
-	/* Read the symbol table into memory */
+	/* Read the symbol table and its names into memory */
 	elf_readsymtab(loadinfo);
+	elf_readstrtab(loadinfo);
 
 	/* Allocate an I/O buffer.  This buffer is used by elf_symname() to
 	 * accumulate the variable length symbol name.
@@ -321,6 +322,13 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo, FAR const struct symtab_s *exp
 		berr("elf_allocbuffer failed: %d\n", ret);
 		goto ret_err;
 	}
+
+#ifdef CONFIG_ELF_SYMCACHE
+	/* Resolve the imported symbols once, from the cache when possible */
+
+	elf_symcache_bind(loadinfo, exports, nexports);
+#endif
+
 #ifdef CONFIG_ARCH_ADDRENV
 	/* If CONFIG_ARCH_ADDRENV=y, then the loaded ELF lies in a virtual address
 	 * space that may not be in place now.  elf_addrenv_select() will
@@ -401,5 +409,7 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo, FAR const struct symtab_s *exp
 ret_err:
 	kmm_free(loadinfo->symtab);
 	loadinfo->symtab = NULL;
+	kmm_free((FAR void *)loadinfo->strtab);
+	loadinfo->strtab = 0;
 	return ret;
 }
@@ -178,6 +178,9 @@ int elf_init(FAR const char *filename, FAR struct elf_loadinfo_s *loadinfo)
 
 	/* Open the binary file for reading (only) */
 
+#ifdef CONFIG_ELF_SYMCACHE
+	loadinfo->filename = filename;
+#endif
 	loadinfo->filfd = open(filename, O_RDONLY);
 	if (loadinfo->filfd < 0) {
 		ret = loadinfo->filfd;
@@ -83,7 +83,9 @@
  * Name: elf_symname
  *
  * Description:
- *   Get the symbol name in loadinfo->iobuffer[].
+ *   Get the symbol name.  It points into the in-memory copy of the string
+ *   table if elf_readstrtab() could allocate one, or into
+ *   loadinfo->iobuffer[] otherwise.
  *
  * Returned Value:
  *   0 (OK) is returned on success and a negated errno is returned on
@@ -95,8 +97,9 @@
  *
  ****************************************************************************/
 
-static int elf_symname(FAR struct elf_loadinfo_s *loadinfo, FAR const Elf32_Sym *sym)
+static int elf_symname(FAR struct elf_loadinfo_s *loadinfo, FAR const Elf32_Sym *sym, FAR const char **name)
 {
+	FAR Elf32_Shdr *strtab = &loadinfo->shdr[loadinfo->strtabidx];
 	FAR uint8_t *buffer;
 	off_t offset;
 	size_t readlen;
@@ -112,7 +115,19 @@ static int elf_symname(FAR struct elf_loadinfo_s *loadinfo, FAR const Elf32_Sym
 		return -ESRCH;
 	}
 
-	offset = loadinfo->shdr[loadinfo->strtabidx].sh_offset + sym->st_name;
+	/* The string table is usually in memory already */
+
+	if (loadinfo->strtab) {
+		if (sym->st_name >= strtab->sh_size) {
+			berr("Symbol name offset %u out of range\n", sym->st_name);
+			return -EINVAL;
+		}
+
+		*name = (FAR const char *)loadinfo->strtab + sym->st_name;
+		return OK;
+	}
+
+	offset = strtab->sh_offset + sym->st_name;
 
 	/* Loop until we get the entire symbol name into memory */
 
@@ -147,6 +162,7 @@ static int elf_symname(FAR struct elf_loadinfo_s *loadinfo, FAR const Elf32_Sym
 		if (memchr(buffer, '\0', readlen) != NULL) {
 			/* Yes, the buffer contains a NUL terminator. */
 
+			*name = (FAR const char *)loadinfo->iobuffer;
 			return OK;
 		}
 
@@ -230,6 +246,45 @@ void elf_readsymtab(FAR struct elf_loadinfo_s *loadinfo)
 	}
 }
 
+/****************************************************************************
+ * Name: elf_readstrtab
+ *
+ * Description:
+ *   Read the string table of the symbol table into memory, so that symbol
+ *   names do not have to be read from the file one I/O buffer at a time.
+ *   On allocation failure the names are read from the file as before.
+ *
+ * Input Parameters:
+ *   loadinfo - Load state information
+ *
+ ****************************************************************************/
+
+void elf_readstrtab(FAR struct elf_loadinfo_s *loadinfo)
+{
+	FAR Elf32_Shdr *strtab = &loadinfo->shdr[loadinfo->strtabidx];
+
+	if (loadinfo->strtabidx == 0 || strtab->sh_size == 0) {
+		return;
+	}
+
+	loadinfo->strtab = (uintptr_t)kmm_malloc(strtab->sh_size + 1);
+	if (!loadinfo->strtab) {
+		binfo("No space for string table, reading names from file. Size = %u\n", strtab->sh_size);
+		return;
+	}
+
+	if (elf_read(loadinfo, (FAR uint8_t *)loadinfo->strtab, strtab->sh_size, strtab->sh_offset) < 0) {
+		berr("ERROR: Failed to load string table into memory\n");
+		kmm_free((FAR void *)loadinfo->strtab);
+		loadinfo->strtab = 0;
+		return;
+	}
+
+	/* Terminate the last name even if the file is corrupted */
+
+	((FAR char *)loadinfo->strtab)[strtab->sh_size] = '\0';
+}
+
 /****************************************************************************
  * Name: elf_readsym
  *
@@ -292,6 +347,7 @@ int elf_readsym(FAR struct elf_loadinfo_s *loadinfo, int index, FAR Elf32_Sym *s
 int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf32_Sym *sym, FAR const struct symtab_s *exports, int nexports)
 {
 	FAR const struct symtab_s *symbol;
+	FAR const char *name;
 	uintptr_t secbase;
 	int ret;
 
@@ -313,7 +369,7 @@ int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf32_Sym *sym, FAR co
 	case SHN_UNDEF: {
 		/* Get the name of the undefined symbol */
 
-		ret = elf_symname(loadinfo, sym);
+		ret = elf_symname(loadinfo, sym, &name);
 		if (ret < 0) {
 			/* There are a few relocations for a few architectures that do
 			 * no depend upon a named symbol.  We don't know if that is the
@@ -327,19 +383,21 @@ int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf32_Sym *sym, FAR co
 
 		/* Check if the base code exports a symbol of this name */
 
-#ifdef CONFIG_SYMTAB_ORDEREDBYNAME
-		symbol = symtab_findorderedbyname(exports, (FAR char *)loadinfo->iobuffer, nexports);
+#if defined(CONFIG_SYMTAB_PERFECTHASH)
+		symbol = exec_findsymbol(exports, nexports, name);
+#elif defined(CONFIG_SYMTAB_ORDEREDBYNAME)
+		symbol = symtab_findorderedbyname(exports, name, nexports);
 #else
-		symbol = symtab_findbyname(exports, (FAR char *)loadinfo->iobuffer, nexports);
+		symbol = symtab_findbyname(exports, name, nexports);
 #endif
 		if (!symbol) {
-			berr("SHN_UNDEF: Exported symbol \"%s\" not found\n", loadinfo->iobuffer);
+			berr("SHN_UNDEF: Exported symbol \"%s\" not found\n", name);
 			return -ENOENT;
 		}
 
 		/* Yes... add the exported symbol value to the ELF symbol table entry */
 
-		binfo("SHN_UNDEF: name=%s %08x+%08x=%08x\n", loadinfo->iobuffer, sym->st_value, symbol->sym_value, sym->st_value + symbol->sym_value);
+		binfo("SHN_UNDEF: name=%s %08x+%08x=%08x\n", name, sym->st_value, symbol->sym_value, sym->st_value + symbol->sym_value);
 
 		sym->st_value += (Elf32_Word)((uintptr_t)symbol->sym_value);
 		sym->st_shndx = SHN_ABS;
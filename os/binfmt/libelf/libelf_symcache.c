@@ -0,0 +1,282 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <debug.h>
+#include <crc32.h>
+
+#include <tinyara/binfmt/elf.h>
+#include <tinyara/binfmt/symtab.h>
+#include <tinyara/kmalloc.h>
+
+#include "libelf.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ELF_SYMCACHE_MAGIC   0x43595345	/* "ESYC" */
+#define ELF_SYMCACHE_SUFFIX  ".sym"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The symbol cache file holds this header followed by one Elf32_Addr per
+ * entry of the ELF symbol table.  Only the entries of named undefined
+ * symbols are meaningful.  The cache is valid as long as the ELF symbol
+ * table and the exported symbol table are unchanged.
+ */
+
+struct elf_symcache_hdr_s {
+	uint32_t magic;				/* ELF_SYMCACHE_MAGIC */
+	uint32_t filelen;			/* Length of the ELF file */
+	uint32_t nsyms;				/* Number of ELF symbol table entries */
+	uint32_t symtabcrc;			/* CRC32 of the ELF symbol table */
+	uint32_t nexports;			/* Number of exported symbols */
+	uint32_t exportscrc;		/* CRC32 of the exported symbol table */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: elf_symcache_path
+ *
+ * Description:
+ *   Allocate the path of the symbol cache of the ELF file.  The cache is
+ *   kept next to the ELF file, or in CONFIG_ELF_SYMCACHE_DIR if that is set
+ *   (binaries loaded from a partition cannot have a file next to them).
+ *
+ ****************************************************************************/
+
+static FAR char *elf_symcache_path(FAR const char *filename)
+{
+	FAR const char *dir = CONFIG_ELF_SYMCACHE_DIR;
+	FAR const char *base;
+	FAR char *path;
+	size_t len;
+
+	if (dir[0] == '\0') {
+		len = strlen(filename);
+		path = (FAR char *)kmm_malloc(len + sizeof(ELF_SYMCACHE_SUFFIX));
+		if (path) {
+			strcpy(path, filename);
+			strcpy(path + len, ELF_SYMCACHE_SUFFIX);
+		}
+
+		return path;
+	}
+
+	base = strrchr(filename, '/');
+	base = base ? base + 1 : filename;
+
+	len = strlen(dir);
+	path = (FAR char *)kmm_malloc(len + 1 + strlen(base) + sizeof(ELF_SYMCACHE_SUFFIX));
+	if (path) {
+		strcpy(path, dir);
+		path[len] = '/';
+		strcpy(path + len + 1, base);
+		strcat(path, ELF_SYMCACHE_SUFFIX);
+	}
+
+	return path;
+}
+
+/****************************************************************************
+ * Name: elf_symcache_read
+ *
+ * Description:
+ *   Read the cached symbol values if the cache file matches 'hdr'.
+ *
+ ****************************************************************************/
+
+static int elf_symcache_read(FAR const char *path, FAR const struct elf_symcache_hdr_s *hdr, FAR Elf32_Addr *values)
+{
+	struct elf_symcache_hdr_s filehdr;
+	size_t size = hdr->nsyms * sizeof(Elf32_Addr);
+	int fd;
+	int ret = -ESTALE;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return -get_errno();
+	}
+
+	if (read(fd, &filehdr, sizeof(filehdr)) == sizeof(filehdr) && memcmp(&filehdr, hdr, sizeof(filehdr)) == 0) {
+		if (read(fd, values, size) == size) {
+			ret = OK;
+		}
+	}
+
+	close(fd);
+	return ret;
+}
+
+/****************************************************************************
+ * Name: elf_symcache_write
+ *
+ * Description:
+ *   Replace the symbol cache file.  Failures only cost the cache.
+ *
+ ****************************************************************************/
+
+static void elf_symcache_write(FAR const char *path, FAR const struct elf_symcache_hdr_s *hdr, FAR const Elf32_Addr *values)
+{
+	size_t size = hdr->nsyms * sizeof(Elf32_Addr);
+	int fd;
+
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (fd < 0) {
+		binfo("Cannot create symbol cache %s: %d\n", path, get_errno());
+		return;
+	}
+
+	if (write(fd, hdr, sizeof(*hdr)) != sizeof(*hdr) || write(fd, values, size) != size) {
+		berr("Failed to write symbol cache %s: %d\n", path, get_errno());
+		close(fd);
+		unlink(path);
+		return;
+	}
+
+	close(fd);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: elf_symcache_bind
+ *
+ * Description:
+ *   Resolve every named undefined symbol of the in-memory symbol table.  The
+ *   values are taken from the symbol cache file of the binary if it matches
+ *   the ELF file and 'exports'; otherwise they are looked up by name and the
+ *   cache file is rewritten for the next load.
+ *
+ *   A resolved symbol becomes SHN_ABS, so elf_symvalue() does not look it
+ *   up again for each relocation which uses it.
+ *
+ * Input Parameters:
+ *   loadinfo - Load state information
+ *   exports  - The symbol table to use for resolving undefined symbols.
+ *   nexports - Number of symbols in the symbol table.
+ *
+ * Returned Value:
+ *   None.  Symbols which cannot be resolved are left for elf_symvalue() to
+ *   report when a relocation uses them.
+ *
+ ****************************************************************************/
+
+void elf_symcache_bind(FAR struct elf_loadinfo_s *loadinfo, FAR const struct symtab_s *exports, int nexports)
+{
+	FAR Elf32_Shdr *symsec = &loadinfo->shdr[loadinfo->symtabidx];
+	FAR Elf32_Sym *syms = (FAR Elf32_Sym *)loadinfo->symtab;
+	struct elf_symcache_hdr_s hdr;
+	FAR Elf32_Addr *values;
+	FAR char *path;
+	bool complete;
+	int nundef;
+	int i;
+
+	if (syms == NULL || loadinfo->filename == NULL) {
+		return;
+	}
+
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.magic = ELF_SYMCACHE_MAGIC;
+	hdr.filelen = loadinfo->filelen;
+	hdr.nsyms = symsec->sh_size / sizeof(Elf32_Sym);
+
+	/* Nothing to cache if the binary does not import anything */
+
+	nundef = 0;
+	for (i = 0; i < hdr.nsyms; i++) {
+		if (syms[i].st_shndx == SHN_UNDEF && syms[i].st_name != 0) {
+			nundef++;
+		}
+	}
+
+	if (nundef == 0) {
+		return;
+	}
+
+	hdr.symtabcrc = crc32((FAR const uint8_t *)syms, symsec->sh_size);
+	hdr.nexports = nexports;
+	hdr.exportscrc = exports ? crc32((FAR const uint8_t *)exports, nexports * sizeof(struct symtab_s)) : 0;
+
+	path = elf_symcache_path(loadinfo->filename);
+	values = (FAR Elf32_Addr *)kmm_malloc(hdr.nsyms * sizeof(Elf32_Addr));
+	if (path == NULL || values == NULL) {
+		goto errout;
+	}
+
+	if (elf_symcache_read(path, &hdr, values) == OK) {
+		binfo("Symbol cache hit: %s, %d symbols\n", path, nundef);
+
+		for (i = 0; i < hdr.nsyms; i++) {
+			if (syms[i].st_shndx == SHN_UNDEF && syms[i].st_name != 0) {
+				syms[i].st_value = values[i];
+				syms[i].st_shndx = SHN_ABS;
+			}
+		}
+
+		goto errout;
+	}
+
+	/* Cache miss.  Look up every imported symbol now and save the values
+	 * only if all of them were found.
+	 */
+
+	binfo("Symbol cache miss: %s, %d symbols\n", path, nundef);
+
+	complete = true;
+	memset(values, 0, hdr.nsyms * sizeof(Elf32_Addr));
+	for (i = 0; i < hdr.nsyms; i++) {
+		if (syms[i].st_shndx == SHN_UNDEF && syms[i].st_name != 0) {
+			if (elf_symvalue(loadinfo, &syms[i], exports, nexports) < 0) {
+				complete = false;
+				continue;
+			}
+
+			values[i] = syms[i].st_value;
+		}
+	}
+
+	if (complete) {
+		elf_symcache_write(path, &hdr, values);
+	}
+
+errout:
+	kmm_free(values);
+	kmm_free(path);
+}
@@ -30,6 +30,7 @@
 #include <net/if.h>
 #include <tinyara/kmalloc.h>
 #include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
 #include <tinyara/lwnl/lwnl.h>
 #include "lwnl_evt_queue.h"
 
@@ -213,8 +214,28 @@ static ssize_t lwnl_write(struct file *filep, const char *buffer, size_t len)
 static int lwnl_ioctl(struct file *filep, int cmd, unsigned long arg)
 {
 	LWNL_ENTER;
+	int ret = OK;
 
-	return 0;
+	switch (cmd) {
+#ifdef CONFIG_LWNL80211_SHARED_SCAN
+	case LWNLIOC_GETSCAN:
+		ret = lwnl_get_scan(filep, (lwnl_scan_buf *)arg);
+		break;
+	case LWNLIOC_PUTSCAN:
+		ret = lwnl_put_scan(filep, (lwnl_scan_buf *)arg);
+		break;
+#else
+	case LWNLIOC_GETSCAN:
+	case LWNLIOC_PUTSCAN:
+		ret = -ENOTTY;
+		break;
+#endif
+	default:
+		break;
+	}
+
+	LWNL_LEAVE;
+	return ret;
 }
 
 
@@ -18,14 +18,24 @@
 
 #include <tinyara/config.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <semaphore.h>
 #include <errno.h>
+#include <assert.h>
 #include <debug.h>
 #include <net/if.h>
 #include <tinyara/net/if/wifi.h>
 #include "lwnl_evt_queue.h"
 
-#define LWQ_LOCK
-#define LWQ_UNLOCK
+#define LWQ_LOCK									\
+	do {											\
+		while (sem_wait(&g_lwq_lock) != OK) {		\
+			ASSERT(get_errno() == EINTR);			\
+		}											\
+	} while (0)
+
+#define LWQ_UNLOCK sem_post(&g_lwq_lock)
 
 #define LWQ_ENTRY										\
 	do {												\
@@ -33,8 +43,17 @@
 			 __FUNCTION__, __FILE__, __LINE__);			\
 	} while (0)
 
+/*
+ * An event is allocated once and linked into the queue of every listener,
+ * flink[i] is its link in g_queue[i]. The payload (scan results) follows
+ * the structure in the same allocation; it's freed when the last queue
+ * or LWNLIOC_GETSCAN reference is dropped.
+ * An event taken by LWNLIOC_GETSCAN is moved to the scan list of the
+ * listener through the same flink[i], so the references left by a
+ * listener which is closed without LWNLIOC_PUTSCAN can be dropped.
+ */
 struct lwnl_event {
-	struct lwnl_event *flink;
+	struct lwnl_event *flink[LWNL_NPOLLWAITERS];
 	lwnl_cb_data data;
 	int8_t refs;
 };
@@ -44,11 +63,15 @@ struct lwnl_queue {
 	int8_t check_header;
 	struct lwnl_event *front;
 	struct lwnl_event *rear;
+#ifdef CONFIG_LWNL80211_SHARED_SCAN
+	struct lwnl_event *scan; // events held by LWNLIOC_GETSCAN
+#endif
 };
 
 // both data should be protected by LWQ_LOCK
 static struct lwnl_queue g_queue[LWNL_NPOLLWAITERS];
 static int g_connected = 0;
+static sem_t g_lwq_lock;
 
 /*
  * private
@@ -56,22 +79,25 @@ static int g_connected = 0;
 int _lwnl_add_event(struct lwnl_event *event)
 {
 	LWQ_ENTRY;
-	event->flink = NULL;
-
 	LWQ_LOCK;
 
 	for (int i = 0; i < LWNL_NPOLLWAITERS; i++) {
+		event->flink[i] = NULL;
 		if (g_queue[i].filep) {
-			event->refs = g_connected;
+			event->refs++;
 			if (g_queue[i].front == NULL) {
 				g_queue[i].front = event;
 				g_queue[i].rear = event;
 			} else {
-				g_queue[i].rear->flink = event;
+				g_queue[i].rear->flink[i] = event;
 				g_queue[i].rear = event;
 			}
 		}
 	}
+	if (event->refs == 0) {
+		// nobody is listening
+		free(event);
+	}
 	LWQ_UNLOCK;
 	return 0;
 }
@@ -86,16 +112,24 @@ int _lwnl_remove_event(struct lwnl_event *evt)
 		return 0;
 	}
 
-	// it's not refered.
-	if (evt->data.data) {
-		free(evt->data.data);
-		evt->data.data = NULL;
-	}
+	// it's not refered. the payload is in the same allocation
 	free(evt);
 
 	return 0;
 }
 
+// this function is protected by LWQ_LOCK;
+static inline void _lwnl_dequeue_event(int idx)
+{
+	struct lwnl_event *evt = g_queue[idx].front;
+
+	g_queue[idx].front = evt->flink[idx];
+	if (!g_queue[idx].front) {
+		g_queue[idx].rear = NULL;
+	}
+	g_queue[idx].check_header = 0;
+}
+
 
 int lwnl_get_event(struct file *filep, char *buf, int len)
 {
@@ -107,6 +141,7 @@ int lwnl_get_event(struct file *filep, char *buf, int len)
 		}
 
 		if (!g_queue[i].front) {
+			LWQ_UNLOCK;
 			return 0;
 		}
 		struct lwnl_event *evt = g_queue[i].front;
@@ -114,6 +149,7 @@ int lwnl_get_event(struct file *filep, char *buf, int len)
 
 		if (g_queue[i].check_header == 0) {
 			if (len < sizeof(lwnl_cb_status) + sizeof(uint32_t)) {
+				LWQ_UNLOCK;
 				return -1;
 			}
 			memcpy(buf, &evt->data.status, sizeof(lwnl_cb_status));
@@ -127,14 +163,14 @@ int lwnl_get_event(struct file *filep, char *buf, int len)
 			}
 		} else {
 			if (len < evt->data.data_len) {
+				LWQ_UNLOCK;
 				return -1;
 			}
 			memcpy(buf, evt->data.data, evt->data.data_len);
-			g_queue[i].check_header = 0;
 			written = evt->data.data_len;
 		}
 
-		g_queue[i].front = evt->flink;
+		_lwnl_dequeue_event(i);
 		_lwnl_remove_event(evt);
 		LWQ_UNLOCK;
 		return written;
@@ -144,40 +180,112 @@ int lwnl_get_event(struct file *filep, char *buf, int len)
 }
 
 
-int _lwnl_copy_scan_info(char **buffer, trwifi_scan_list_s *scan_list)
+#ifdef CONFIG_LWNL80211_SHARED_SCAN
+int lwnl_get_scan(struct file *filep, lwnl_scan_buf *sbuf)
+{
+	LWQ_ENTRY;
+	LWQ_LOCK;
+	for (int i = 0; i < LWNL_NPOLLWAITERS; i++) {
+		if (g_queue[i].filep != filep) {
+			continue;
+		}
+
+		struct lwnl_event *evt = g_queue[i].front;
+
+		/* only the payload of a scan event whose header was read */
+		if (!evt || g_queue[i].check_header == 0 ||
+			(evt->data.status != LWNL_SCAN_DONE && evt->data.status != LWNL_SCAN_PARTIAL)) {
+			LWQ_UNLOCK;
+			return -EINVAL;
+		}
+
+		/* the queue's reference moves to the caller */
+		_lwnl_dequeue_event(i);
+		evt->flink[i] = g_queue[i].scan;
+		g_queue[i].scan = evt;
+		sbuf->data = evt->data.data;
+		sbuf->data_len = evt->data.data_len;
+		LWQ_UNLOCK;
+		return 0;
+	}
+	LWQ_UNLOCK;
+	return -EINVAL;
+}
+
+
+int lwnl_put_scan(struct file *filep, lwnl_scan_buf *sbuf)
+{
+	LWQ_ENTRY;
+	if (!sbuf->data) {
+		return -EINVAL;
+	}
+
+	LWQ_LOCK;
+	for (int i = 0; i < LWNL_NPOLLWAITERS; i++) {
+		if (g_queue[i].filep != filep) {
+			continue;
+		}
+
+		/* only a buffer this listener took by LWNLIOC_GETSCAN */
+		struct lwnl_event **link = &g_queue[i].scan;
+		while (*link && (*link)->data.data != sbuf->data) {
+			link = &(*link)->flink[i];
+		}
+		if (!*link) {
+			break;
+		}
+
+		struct lwnl_event *evt = *link;
+		*link = evt->flink[i];
+		_lwnl_remove_event(evt);
+		LWQ_UNLOCK;
+		sbuf->data = NULL;
+		sbuf->data_len = 0;
+		return 0;
+	}
+	LWQ_UNLOCK;
+	return -EINVAL;
+}
+#endif
+
+
+struct lwnl_event *_lwnl_alloc_scan_event(lwnl_cb_status type, trwifi_scan_list_s *scan_list)
 {
 	trwifi_scan_list_s *item = scan_list;
-	int cnt = 0, total = 0;
+	int cnt = 0;
 	while (item) {
 		item = item->next;
 		cnt++;
 	}
-	total = cnt;
-	ndbg("total size(%d) (%d)\n", sizeof(trwifi_ap_scan_info_s), sizeof(trwifi_ap_scan_info_s) * total);
-	*buffer = (char *)malloc(sizeof(trwifi_ap_scan_info_s) * total);
-	if (!(*buffer)) {
-		return -1;
+
+	/* a scan without results is reported as failed */
+	if (cnt == 0 && type == LWNL_SCAN_DONE) {
+		type = LWNL_SCAN_FAILED;
 	}
-	item = scan_list;
-	cnt = 0;
-	while (item) {
-		memcpy(*buffer + (sizeof(trwifi_ap_scan_info_s) * cnt), &item->ap_info, sizeof(trwifi_ap_scan_info_s));
-		item = item->next;
-		cnt++;
+
+	uint32_t len = sizeof(trwifi_ap_scan_info_s) * cnt;
+	ndbg("total size(%d) (%d)\n", sizeof(trwifi_ap_scan_info_s), len);
+	struct lwnl_event *evt = (struct lwnl_event *)malloc(sizeof(struct lwnl_event) + len);
+	if (!evt) {
+		return NULL;
+	}
+
+	trwifi_ap_scan_info_s *info = (trwifi_ap_scan_info_s *)(evt + 1);
+	for (item = scan_list; item; item = item->next) {
+		*info++ = item->ap_info;
 	}
-	return total * sizeof(trwifi_ap_scan_info_s);
+
+	evt->data.status = type;
+	evt->data.data = len ? (void *)(evt + 1) : NULL;
+	evt->data.data_len = len;
+	return evt;
 }
 
 
 int lwnl_add_event(lwnl_cb_status type, void *buffer)
 {
 	LWQ_ENTRY;
-	struct lwnl_event *evt = (struct lwnl_event *)malloc(sizeof(struct lwnl_event));
-	if (!evt) {
-		return -1;
-	}
-	evt->flink = NULL;
-	evt->refs = 0;
+	struct lwnl_event *evt = NULL;
 
 	switch (type) {
 	case LWNL_STA_CONNECTED:
@@ -187,25 +295,22 @@ int lwnl_add_event(lwnl_cb_status type, void *buffer)
 	case LWNL_SOFTAP_STA_LEFT:
 	case LWNL_SCAN_FAILED:
 	{
+		evt = (struct lwnl_event *)malloc(sizeof(struct lwnl_event));
+		if (!evt) {
+			return -1;
+		}
 		evt->data.status = type;
 		evt->data.data = NULL;
 		evt->data.data_len = 0;
 		break;
 	}
 	case LWNL_SCAN_DONE:
+	case LWNL_SCAN_PARTIAL:
 	{
-		// ToDo
-		char *output = NULL;
-		int res = _lwnl_copy_scan_info(&output, (trwifi_scan_list_s *)buffer);
-		if (res < 0) {
-			evt->data.status = LWNL_SCAN_FAILED;
-			evt->data.data = NULL;
-			evt->data.data_len = 0;
-			break;
+		evt = _lwnl_alloc_scan_event(type, (trwifi_scan_list_s *)buffer);
+		if (!evt) {
+			return -1;
 		}
-		evt->data.status = LWNL_SCAN_DONE;
-		evt->data.data = output;
-		evt->data.data_len = res;
 		break;
 	}
 	case LWNL_UNKNOWN:
@@ -213,6 +318,7 @@ int lwnl_add_event(lwnl_cb_status type, void *buffer)
 		LWNL_ERR;
 		return -3;
 	}
+	evt->refs = 0;
 
 	int res = _lwnl_add_event(evt);
 	if (res < 0) {
@@ -232,8 +338,12 @@ void lwnl_queue_initialize(void)
 		g_queue[i].front = NULL;
 		g_queue[i].rear = NULL;
 		g_queue[i].check_header = 0;
+#ifdef CONFIG_LWNL80211_SHARED_SCAN
+		g_queue[i].scan = NULL;
+#endif
 	}
 	g_connected = 0;
+	sem_init(&g_lwq_lock, 0, 1);
 }
 
 
@@ -264,11 +374,19 @@ int lwnl_remove_listener(struct file *filep)
 			struct lwnl_event *evt;
 			while (g_queue[i].front) {
 				evt = g_queue[i].front;
-				g_queue[i].front = evt->flink;
+				g_queue[i].front = evt->flink[i];
 				_lwnl_remove_event(evt);
 			}
 			g_queue[i].front = g_queue[i].rear = NULL;
 			g_queue[i].check_header = 0;
+#ifdef CONFIG_LWNL80211_SHARED_SCAN
+			// drop the scan results which weren't put back
+			while (g_queue[i].scan) {
+				evt = g_queue[i].scan;
+				g_queue[i].scan = evt->flink[i];
+				_lwnl_remove_event(evt);
+			}
+#endif
 			g_connected--;
 
 			LWQ_UNLOCK;
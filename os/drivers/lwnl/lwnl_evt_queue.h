@@ -32,4 +32,8 @@ void lwnl_queue_initialize(void);
 int lwnl_add_listener(struct file *filep);
 int lwnl_remove_listener(struct file *filep);
 int lwnl_get_event(struct file *filep, char *buf, int len);
+#ifdef CONFIG_LWNL80211_SHARED_SCAN
+int lwnl_get_scan(struct file *filep, lwnl_scan_buf *sbuf);
+int lwnl_put_scan(struct file *filep, lwnl_scan_buf *sbuf);
+#endif
 #endif // _LWNL_EVT_QUEUE_H__
@@ -77,6 +77,10 @@
 #include <tinyara/semaphore.h>
 #include <tinyara/fs/fs.h>
 #include <tinyara/fs/ioctl.h>
+#include <tinyara/pipe.h>
+#if defined(CONFIG_NET_LWIP) && CONFIG_NSOCKET_DESCRIPTORS > 0
+#include <sys/socket.h>
+#endif
 
 #include "pipe_common.h"
 
@@ -153,6 +157,409 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev, pollevent_t events
 #define pipecommon_pollnotify(dev, event)
 #endif
 
+/****************************************************************************
+ * Name: pipecommon_wakeup
+ *
+ * Description:
+ *   Wake up one thread waiting on the read or write semaphore.  A batch of
+ *   data (or space) wakes a single waiter, which passes the wake up on if
+ *   it leaves something for the next one.
+ *
+ ****************************************************************************/
+
+static void pipecommon_wakeup(FAR sem_t *sem)
+{
+	int sval;
+
+	if (sem_getvalue(sem, &sval) == 0 && sval < 0) {
+		sem_post(sem);
+	}
+}
+
+/****************************************************************************
+ * Name: pipecommon_roundup
+ *
+ * Description:
+ *   Round the pipe size up to a power of two.
+ *
+ ****************************************************************************/
+
+static pipe_ndx_t pipecommon_roundup(size_t size)
+{
+	pipe_ndx_t ringsize = 1;
+
+	while (ringsize < size) {
+		ringsize <<= 1;
+	}
+
+	return ringsize;
+}
+
+/****************************************************************************
+ * Name: pipecommon_copyout
+ *
+ * Description:
+ *   Copy up to len buffered bytes out of the ring, in at most two segments.
+ *
+ ****************************************************************************/
+
+static size_t pipecommon_copyout(FAR struct pipe_dev_s *dev, FAR char *buffer, size_t len)
+{
+	pipe_ndx_t offset = PIPE_OFFSET(dev, dev->d_rdndx);
+	size_t first;
+
+	if (len > PIPE_NBYTES(dev)) {
+		len = PIPE_NBYTES(dev);
+	}
+
+	first = dev->d_size - offset;
+	if (first > len) {
+		first = len;
+	}
+
+	memcpy(buffer, &dev->d_buffer[offset], first);
+	memcpy(buffer + first, dev->d_buffer, len - first);
+	dev->d_rdndx += len;
+
+	return len;
+}
+
+/****************************************************************************
+ * Name: pipecommon_copyin
+ *
+ * Description:
+ *   Copy up to len bytes into the free space of the ring, in at most two
+ *   segments.
+ *
+ ****************************************************************************/
+
+static size_t pipecommon_copyin(FAR struct pipe_dev_s *dev, FAR const char *buffer, size_t len)
+{
+	pipe_ndx_t offset = PIPE_OFFSET(dev, dev->d_wrndx);
+	size_t first;
+
+	if (len > PIPE_NFREE(dev)) {
+		len = PIPE_NFREE(dev);
+	}
+
+	first = dev->d_size - offset;
+	if (first > len) {
+		first = len;
+	}
+
+	memcpy(&dev->d_buffer[offset], buffer, first);
+	memcpy(dev->d_buffer, buffer + first, len - first);
+	dev->d_wrndx += len;
+
+	return len;
+}
+
+/****************************************************************************
+ * Name: pipecommon_waitdata
+ *
+ * Description:
+ *   Wait until the pipe holds data and no splice is reading from it.
+ *   Called with d_bfsem held, which is still held only if a positive number
+ *   of buffered bytes is returned.  Otherwise zero is returned at end of
+ *   file, -EAGAIN for O_NONBLOCK or ERROR if the wait was interrupted.
+ *
+ ****************************************************************************/
+
+static ssize_t pipecommon_waitdata(FAR struct file *filep, FAR struct pipe_dev_s *dev)
+{
+	int ret;
+
+	while (dev->d_wrndx == dev->d_rdndx || (dev->d_flags & PIPE_FLAG_SPLICERD) != 0) {
+		/* If O_NONBLOCK was set, then return EGAIN */
+
+		if (filep->f_oflags & O_NONBLOCK) {
+			sem_post(&dev->d_bfsem);
+			return -EAGAIN;
+		}
+
+		/* If there are no writers on the empty pipe, then return end of file */
+
+		if (dev->d_nwriters <= 0 && dev->d_wrndx == dev->d_rdndx) {
+			sem_post(&dev->d_bfsem);
+			return 0;
+		}
+
+		/* Otherwise, wait for something to be written to the pipe */
+
+		sched_lock();
+		sem_post(&dev->d_bfsem);
+		ret = sem_wait(&dev->d_rdsem);
+		sched_unlock();
+
+		if (ret < 0 || sem_wait(&dev->d_bfsem) < 0) {
+			/* Interrupted.  This reader may have taken the single wake up
+			 * of a batch, so pass it on before giving up.
+			 */
+
+			pipecommon_wakeup(&dev->d_rdsem);
+			return ERROR;
+		}
+	}
+
+	return PIPE_NBYTES(dev);
+}
+
+/****************************************************************************
+ * Name: pipecommon_waitspace
+ *
+ * Description:
+ *   Wait until the pipe has free space and no splice is writing into it.
+ *   Called with d_bfsem held, which is still held only if a positive number
+ *   of free bytes is returned.  Otherwise -EAGAIN is returned for
+ *   O_NONBLOCK.  Signals do not end the wait, so a woken writer always gets
+ *   to pass the wake up on.
+ *
+ ****************************************************************************/
+
+static ssize_t pipecommon_waitspace(FAR struct file *filep, FAR struct pipe_dev_s *dev)
+{
+	while (PIPE_NFREE(dev) == 0 || (dev->d_flags & PIPE_FLAG_SPLICEWR) != 0) {
+		/* If O_NONBLOCK was set, then return EGAIN */
+
+		if (filep->f_oflags & O_NONBLOCK) {
+			sem_post(&dev->d_bfsem);
+			return -EAGAIN;
+		}
+
+		/* Wait for data to be removed from the pipe */
+
+		sched_lock();
+		sem_post(&dev->d_bfsem);
+		pipecommon_semtake(&dev->d_wrsem);
+		sched_unlock();
+		pipecommon_semtake(&dev->d_bfsem);
+	}
+
+	return PIPE_NFREE(dev);
+}
+
+/****************************************************************************
+ * Name: pipecommon_fdio
+ *
+ * Description:
+ *   Read from or write to the file or socket descriptor at the other end of
+ *   a splice.  Returns the number of bytes transferred or a negated errno.
+ *
+ ****************************************************************************/
+
+static ssize_t pipecommon_fdio(FAR struct inode *inode, int fd, FAR void *buffer, size_t len, bool out)
+{
+	ssize_t ret;
+#if CONFIG_NFILE_DESCRIPTORS > 0
+	FAR struct file *filep;
+
+	if ((unsigned int)fd < CONFIG_NFILE_DESCRIPTORS) {
+		ret = fs_getfilep(fd, &filep);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* A pipe cannot be spliced into itself */
+
+		if (filep->f_inode == inode) {
+			return -EINVAL;
+		}
+
+		return out ? file_write(filep, buffer, len) : file_read(filep, buffer, len);
+	}
+#endif
+
+#if defined(CONFIG_NET_LWIP) && CONFIG_NSOCKET_DESCRIPTORS > 0
+	ret = out ? send(fd, buffer, len, 0) : recv(fd, buffer, len, 0);
+	return ret < 0 ? -get_errno() : ret;
+#else
+	return -EBADF;
+#endif
+}
+
+/****************************************************************************
+ * Name: pipecommon_splice
+ *
+ * Description:
+ *   Move data between the ring and another descriptor, passing the
+ *   contiguous segments of the ring straight to the other driver.
+ *
+ *   The segment is reserved by a splice flag and d_bfsem is released while
+ *   the other driver runs, so a peer which blocks stalls only the readers
+ *   (or writers) of this side of the pipe.  The indices are committed when
+ *   d_bfsem is taken again.
+ *
+ ****************************************************************************/
+
+static int pipecommon_splice(FAR struct file *filep, FAR struct pipe_splice_s *splice)
+{
+	FAR struct inode *inode = filep->f_inode;
+	FAR struct pipe_dev_s *dev = inode->i_private;
+	bool topipe = (splice->ps_flags & PIPE_SPLICE_TOPIPE) != 0;
+	uint8_t flag = topipe ? PIPE_FLAG_SPLICEWR : PIPE_FLAG_SPLICERD;
+	FAR uint8_t *segment;
+	size_t moved = 0;
+	size_t seg;
+	ssize_t ret;
+	int sval;
+
+	if ((filep->f_oflags & (topipe ? O_WROK : O_RDOK)) == 0) {
+		return -EBADF;
+	}
+
+	if (splice->ps_len == 0) {
+		return 0;
+	}
+
+	if (sem_wait(&dev->d_bfsem) < 0) {
+		return -get_errno();
+	}
+
+	/* Wait like write (or read) does, which also waits for another splice
+	 * of the same side to finish.
+	 */
+
+	ret = topipe ? pipecommon_waitspace(filep, dev) : pipecommon_waitdata(filep, dev);
+	if (ret <= 0) {
+		return ret == ERROR ? -get_errno() : ret;
+	}
+
+	dev->d_flags |= flag;
+
+	while (moved < splice->ps_len) {
+		if (topipe) {
+			seg = dev->d_size - PIPE_OFFSET(dev, dev->d_wrndx);
+			if (seg > PIPE_NFREE(dev)) {
+				seg = PIPE_NFREE(dev);
+			}
+			segment = &dev->d_buffer[PIPE_OFFSET(dev, dev->d_wrndx)];
+		} else {
+			seg = dev->d_size - PIPE_OFFSET(dev, dev->d_rdndx);
+			if (seg > PIPE_NBYTES(dev)) {
+				seg = PIPE_NBYTES(dev);
+			}
+			segment = &dev->d_buffer[PIPE_OFFSET(dev, dev->d_rdndx)];
+		}
+
+		if (seg > splice->ps_len - moved) {
+			seg = splice->ps_len - moved;
+		}
+
+		if (seg == 0) {
+			break;
+		}
+
+		/* The other side only moves its own index and the flag keeps the
+		 * buffer from being resized, so the segment stays put without
+		 * d_bfsem.
+		 */
+
+		sem_post(&dev->d_bfsem);
+		ret = pipecommon_fdio(inode, splice->ps_fd, segment, seg, !topipe);
+		pipecommon_semtake(&dev->d_bfsem);
+
+		if (ret <= 0) {
+			break;
+		}
+
+		/* Commit the indices and wake up the other side for what was moved */
+
+		if (topipe) {
+			dev->d_wrndx += ret;
+			pipecommon_wakeup(&dev->d_rdsem);
+			pipecommon_pollnotify(dev, POLLIN);
+		} else {
+			dev->d_rdndx += ret;
+			pipecommon_wakeup(&dev->d_wrsem);
+			pipecommon_pollnotify(dev, POLLOUT);
+		}
+		moved += ret;
+
+		/* A short transfer means that the other end has no more for now */
+
+		if ((size_t)ret < seg) {
+			break;
+		}
+	}
+
+	dev->d_flags &= ~flag;
+
+	/* Pass the wake up on like read and write do if space (or data) is left
+	 * for this side.  Readers held back by the splice after the last writer
+	 * closed must all see the end of file of an empty pipe.
+	 */
+
+	if (topipe) {
+		if (PIPE_NFREE(dev) > 0) {
+			pipecommon_wakeup(&dev->d_wrsem);
+		}
+	} else if (PIPE_NBYTES(dev) > 0) {
+		pipecommon_wakeup(&dev->d_rdsem);
+	} else if (dev->d_nwriters <= 0) {
+		while (sem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0) {
+			sem_post(&dev->d_rdsem);
+		}
+	}
+
+	sem_post(&dev->d_bfsem);
+	return moved > 0 ? (int)moved : (int)ret;
+}
+
+/****************************************************************************
+ * Name: pipecommon_resize
+ ****************************************************************************/
+
+static int pipecommon_resize(FAR struct pipe_dev_s *dev, unsigned long size)
+{
+	FAR uint8_t *buffer;
+	pipe_ndx_t nbytes;
+	pipe_ndx_t ringsize;
+
+	if (size == 0 || size > CONFIG_DEV_PIPE_MAXSIZE) {
+		return -EINVAL;
+	}
+
+	ringsize = pipecommon_roundup(size);
+
+	pipecommon_semtake(&dev->d_bfsem);
+
+	/* A splice in progress works on the current buffer without d_bfsem */
+
+	nbytes = PIPE_NBYTES(dev);
+	if (ringsize < nbytes || (dev->d_flags & (PIPE_FLAG_SPLICERD | PIPE_FLAG_SPLICEWR)) != 0) {
+		sem_post(&dev->d_bfsem);
+		return -EBUSY;
+	}
+
+	/* Move the buffered data to the start of the new buffer */
+
+	if (dev->d_buffer && ringsize != dev->d_size) {
+		buffer = (FAR uint8_t *)kmm_malloc(ringsize);
+		if (!buffer) {
+			sem_post(&dev->d_bfsem);
+			return -ENOMEM;
+		}
+
+		pipecommon_copyout(dev, (FAR char *)buffer, nbytes);
+		kmm_free(dev->d_buffer);
+		dev->d_buffer = buffer;
+		dev->d_rdndx = 0;
+		dev->d_wrndx = nbytes;
+	}
+
+	dev->d_size = ringsize;
+
+	/* A writer may be waiting for the space just added */
+
+	if (nbytes < ringsize) {
+		pipecommon_wakeup(&dev->d_wrsem);
+		pipecommon_pollnotify(dev, POLLOUT);
+	}
+
+	sem_post(&dev->d_bfsem);
+	return OK;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -172,6 +579,7 @@ FAR struct pipe_dev_s *pipecommon_allocdev(void)
 		/* Initialize the private structure */
 
 		memset(dev, 0, sizeof(struct pipe_dev_s));
+		dev->d_size = pipecommon_roundup(CONFIG_DEV_PIPE_SIZE);
 		sem_init(&dev->d_bfsem, 0, 1);
 		sem_init(&dev->d_rdsem, 0, 0);
 		sem_init(&dev->d_wrsem, 0, 0);
@@ -229,7 +637,7 @@ int pipecommon_open(FAR struct file *filep)
 	 */
 
 	if (dev->d_refs == 0 && dev->d_buffer == NULL) {
-		dev->d_buffer = (uint8_t *)kmm_malloc(CONFIG_DEV_PIPE_SIZE);
+		dev->d_buffer = (uint8_t *)kmm_malloc(dev->d_size);
 		if (!dev->d_buffer) {
 			(void)sem_post(&dev->d_bfsem);
 			return -ENOMEM;
@@ -367,10 +775,13 @@ int pipecommon_close(FAR struct file *filep)
 		kmm_free(dev->d_buffer);
 		dev->d_buffer = NULL;
 
-		/* And reset all counts and indices */
+		/* And reset all counts and indices, and the size changed by
+		 * PIPEIOC_SETSIZE.
+		 */
 
 		dev->d_wrndx = 0;
 		dev->d_rdndx = 0;
+		dev->d_size = pipecommon_roundup(CONFIG_DEV_PIPE_SIZE);
 		dev->d_refs = 0;
 		dev->d_nwriters = 0;
 
@@ -401,8 +812,6 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 	FAR uint8_t *start = (uint8_t *)buffer;
 #endif
 	ssize_t nread = 0;
-	int sval;
-	int ret;
 
 	DEBUGASSERT(dev);
 
@@ -418,48 +827,22 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
 	/* If the pipe is empty, then wait for something to be written to it */
 
-	while (dev->d_wrndx == dev->d_rdndx) {
-		/* If O_NONBLOCK was set, then return EGAIN */
-
-		if (filep->f_oflags & O_NONBLOCK) {
-			sem_post(&dev->d_bfsem);
-			return -EAGAIN;
-		}
-
-		/* If there are no writers on the pipe, then return end of file */
-
-		if (dev->d_nwriters <= 0) {
-			sem_post(&dev->d_bfsem);
-			return 0;
-		}
-
-		/* Otherwise, wait for something to be written to the pipe */
-
-		sched_lock();
-		sem_post(&dev->d_bfsem);
-		ret = sem_wait(&dev->d_rdsem);
-		sched_unlock();
-
-		if (ret < 0 || sem_wait(&dev->d_bfsem) < 0) {
-			return ERROR;
-		}
+	nread = pipecommon_waitdata(filep, dev);
+	if (nread <= 0) {
+		return nread;
 	}
 
 	/* Then return whatever is available in the pipe (which is at least one byte) */
 
-	nread = 0;
-	while (nread < len && dev->d_wrndx != dev->d_rdndx) {
-		*buffer++ = dev->d_buffer[dev->d_rdndx];
-		if (++dev->d_rdndx >= CONFIG_DEV_PIPE_SIZE) {
-			dev->d_rdndx = 0;
-		}
-		nread++;
-	}
+	nread = pipecommon_copyout(dev, buffer, len);
 
-	/* Notify all waiting writers that bytes have been removed from the buffer */
+	/* Wake up a waiting writer for the space made, and pass the wake up on
+	 * to another reader if data is left.
+	 */
 
-	while (sem_getvalue(&dev->d_wrsem, &sval) == 0 && sval < 0) {
-		sem_post(&dev->d_wrsem);
+	pipecommon_wakeup(&dev->d_wrsem);
+	if (dev->d_wrndx != dev->d_rdndx) {
+		pipecommon_wakeup(&dev->d_rdsem);
 	}
 
 	/* Notify all poll/select waiters that they can write to the FIFO */
@@ -480,9 +863,8 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer, size_t
 	struct inode *inode = filep->f_inode;
 	struct pipe_dev_s *dev = inode->i_private;
 	ssize_t nwritten = 0;
-	ssize_t last;
-	int nxtwrndx;
-	int sval;
+	size_t ncopied;
+	ssize_t ret;
 
 	DEBUGASSERT(dev);
 	pipe_dumpbuffer("To PIPE:", (uint8_t *)buffer, len);
@@ -512,70 +894,42 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer, size_t
 
 	/* Loop until all of the bytes have been written */
 
-	last = 0;
 	for (;;) {
-		/* Calculate the write index AFTER the next byte is written */
+		/* Copy as much as fits, unless a splice is writing into the ring */
 
-		nxtwrndx = dev->d_wrndx + 1;
-		if (nxtwrndx >= CONFIG_DEV_PIPE_SIZE) {
-			nxtwrndx = 0;
+		ncopied = 0;
+		if ((dev->d_flags & PIPE_FLAG_SPLICEWR) == 0) {
+			ncopied = pipecommon_copyin(dev, buffer + nwritten, len - nwritten);
 		}
+		nwritten += ncopied;
 
-		/* Would the next write overflow the circular buffer? */
-
-		if (nxtwrndx != dev->d_rdndx) {
-			/* No... copy the byte */
-
-			dev->d_buffer[dev->d_wrndx] = *buffer++;
-			dev->d_wrndx = nxtwrndx;
-
-			/* Is the write complete? */
+		/* Notify a waiting reader and the poll/select waiters once for the batch */
 
-			if (++nwritten >= len) {
-				/* Yes.. Notify all of the waiting readers that more data is available */
-
-				while (sem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0) {
-					sem_post(&dev->d_rdsem);
-				}
-
-				/* Notify all poll/select waiters that they can write to the FIFO */
-
-				pipecommon_pollnotify(dev, POLLIN);
-
-				/* Return the number of bytes written */
+		if (ncopied > 0) {
+			pipecommon_wakeup(&dev->d_rdsem);
+			pipecommon_pollnotify(dev, POLLIN);
+		}
 
-				sem_post(&dev->d_bfsem);
-				return len;
-			}
-		} else {
-			/* There is not enough room for the next byte. Was anything written in this pass? */
+		/* Is the write complete? */
 
-			if (last < nwritten) {
-				/* Yes.. Notify all of the waiting readers that more data is available */
+		if (nwritten >= len) {
+			/* Pass the wake up on to another writer if space is left */
 
-				while (sem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0) {
-					sem_post(&dev->d_rdsem);
-				}
+			if (PIPE_NFREE(dev) > 0) {
+				pipecommon_wakeup(&dev->d_wrsem);
 			}
-			last = nwritten;
-
-			/* If O_NONBLOCK was set, then return partial bytes written or EGAIN */
 
-			if (filep->f_oflags & O_NONBLOCK) {
-				if (nwritten == 0) {
-					nwritten = -EAGAIN;
-				}
-				sem_post(&dev->d_bfsem);
-				return nwritten;
-			}
+			sem_post(&dev->d_bfsem);
+			return len;
+		}
 
-			/* There is more to be written.. wait for data to be removed from the pipe */
+		/* There is more to be written.. wait for data to be removed from the
+		 * pipe, or return the partial bytes written or EGAIN for O_NONBLOCK.
+		 */
 
-			sched_lock();
-			sem_post(&dev->d_bfsem);
-			pipecommon_semtake(&dev->d_wrsem);
-			sched_unlock();
-			pipecommon_semtake(&dev->d_bfsem);
+		ret = pipecommon_waitspace(filep, dev);
+		if (ret < 0) {
+			return nwritten > 0 ? nwritten : ret;
 		}
 	}
 }
@@ -590,7 +944,6 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 	FAR struct inode *inode = filep->f_inode;
 	FAR struct pipe_dev_s *dev = inode->i_private;
 	pollevent_t eventset;
-	pipe_ndx_t nbytes;
 	int ret = OK;
 	int i;
 
@@ -625,25 +978,17 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 		}
 
 		/* Should immediately notify on any of the requested events?
-		 * First, determine how many bytes are in the buffer
+		 * Notify the POLLOUT event if the pipe is not full
 		 */
 
-		if (dev->d_wrndx >= dev->d_rdndx) {
-			nbytes = dev->d_wrndx - dev->d_rdndx;
-		} else {
-			nbytes = (CONFIG_DEV_PIPE_SIZE - 1) + dev->d_wrndx - dev->d_rdndx;
-		}
-
-		/* Notify the POLLOUT event if the pipe is not full */
-
 		eventset = 0;
-		if (nbytes < (CONFIG_DEV_PIPE_SIZE - 1)) {
+		if (PIPE_NFREE(dev) > 0) {
 			eventset |= POLLOUT;
 		}
 
 		/* Notify the POLLIN event if the pipe is not empty */
 
-		if (nbytes > 0) {
+		if (PIPE_NBYTES(dev) > 0) {
 			eventset |= POLLIN;
 		}
 
@@ -684,9 +1029,8 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 	FAR struct inode *inode = filep->f_inode;
 	FAR struct pipe_dev_s *dev = inode->i_private;
 
-	/* Only one command supported */
-
-	if (cmd == PIPEIOC_POLICY) {
+	switch (cmd) {
+	case PIPEIOC_POLICY:
 		if (arg != 0) {
 			PIPE_POLICY_1(dev->d_flags);
 		} else {
@@ -694,6 +1038,27 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 		}
 
 		return OK;
+
+	case PIPEIOC_GETSIZE:
+		if (!arg) {
+			return -EINVAL;
+		}
+
+		*(FAR size_t *)((uintptr_t)arg) = dev->d_size;
+		return OK;
+
+	case PIPEIOC_SETSIZE:
+		return pipecommon_resize(dev, arg);
+
+	case PIPEIOC_SPLICE:
+		if (!arg) {
+			return -EINVAL;
+		}
+
+		return pipecommon_splice(filep, (FAR struct pipe_splice_s *)((uintptr_t)arg));
+
+	default:
+		break;
 	}
 
 	return -ENOTTY;
@@ -68,6 +68,10 @@
 #define CONFIG_DEV_PIPE_SIZE 1024
 #endif
 
+#ifndef CONFIG_DEV_PIPE_MAXSIZE
+#define CONFIG_DEV_PIPE_MAXSIZE 65536
+#endif
+
 #if CONFIG_DEV_PIPE_SIZE > 0
 
 /****************************************************************************
@@ -88,6 +92,8 @@
 
 #define PIPE_FLAG_POLICY    (1 << 0)	/* Bit 0: Policy=Free buffer when empty */
 #define PIPE_FLAG_UNLINKED  (1 << 1)	/* Bit 1: The driver has been unlinked */
+#define PIPE_FLAG_SPLICERD  (1 << 2)	/* Bit 2: A splice is reading from the ring */
+#define PIPE_FLAG_SPLICEWR  (1 << 3)	/* Bit 3: A splice is writing into the ring */
 
 #define PIPE_POLICY_0(f)    do { (f) &= ~PIPE_FLAG_POLICY; } while (0)
 #define PIPE_POLICY_1(f)    do { (f) |= PIPE_FLAG_POLICY; } while (0)
@@ -97,19 +103,21 @@
 #define PIPE_UNLINK(f)      do { (f) |= PIPE_FLAG_UNLINKED; } while (0)
 #define PIPE_IS_UNLINKED(f) (((f) & PIPE_FLAG_UNLINKED) != 0)
 
+/* The ring indices run freely and are masked with the power of two size
+ * only to address d_buffer, so the whole buffer can be filled.
+ */
+
+#define PIPE_NBYTES(d)      ((pipe_ndx_t)((d)->d_wrndx - (d)->d_rdndx))
+#define PIPE_NFREE(d)       ((d)->d_size - PIPE_NBYTES(d))
+#define PIPE_OFFSET(d, n)   ((n) & ((d)->d_size - 1))
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
-/* Make the buffer index as small as possible for the configured pipe size */
+/* The pipe size may be changed at runtime up to CONFIG_DEV_PIPE_MAXSIZE */
 
-#if CONFIG_DEV_PIPE_SIZE > 65535
-typedef uint32_t pipe_ndx_t;	/* 32-bit index */
-#elif CONFIG_DEV_PIPE_SIZE > 255
-typedef uint16_t pipe_ndx_t;	/* 16-bit index */
-#else
-typedef uint8_t pipe_ndx_t;		/*  8-bit index */
-#endif
+typedef uint32_t pipe_ndx_t;
 
 /* This structure represents the state of one pipe.  A reference to this
  * structure is retained in the i_private field of the inode whenthe pipe/fifo
@@ -120,8 +128,9 @@ struct pipe_dev_s {
 	sem_t d_bfsem;				/* Used to serialize access to d_buffer and indices */
 	sem_t d_rdsem;				/* Empty buffer - Reader waits for data write */
 	sem_t d_wrsem;				/* Full buffer - Writer waits for data read */
-	pipe_ndx_t d_wrndx;			/* Index in d_buffer to save next byte written */
-	pipe_ndx_t d_rdndx;			/* Index in d_buffer to return the next byte read */
+	pipe_ndx_t d_wrndx;			/* Free running count of the bytes written */
+	pipe_ndx_t d_rdndx;			/* Free running count of the bytes read */
+	pipe_ndx_t d_size;			/* Size of d_buffer, a power of two */
 	uint8_t d_refs;				/* References counts on pipe (limited to 255) */
 	uint8_t d_nwriters;			/* Number of reference counts for write access */
 	uint8_t d_pipeno;			/* Pipe minor number */
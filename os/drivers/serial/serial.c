@@ -88,6 +88,20 @@
 #define HALF_SECOND_MSEC 500
 #define HALF_SECOND_USEC 500000L
 
+/* Tell the lower half that data was added to the TX buffer.  A lower half
+ * without TX DMA is only driven by the TX interrupt.
+ */
+
+#ifdef CONFIG_SERIAL_TXDMA
+#define uart_xmitavail(dev) \
+	do { \
+		uart_dmatxavail(dev); \
+		uart_enabletxint(dev); \
+	} while (0)
+#else
+#define uart_xmitavail(dev) uart_enabletxint(dev)
+#endif
+
 /************************************************************************************
  * Private Types
  ************************************************************************************/
@@ -109,6 +123,12 @@ static int uart_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
  * Private Variables
  ************************************************************************************/
 
+#ifdef CONFIG_SERIAL_STATS
+/* The registered devices, for /proc/serial */
+
+static FAR uart_dev_t *g_uart_devs;
+#endif
+
 static const struct file_operations g_serialops = {
 	uart_open,					/* open */
 	uart_close,					/* close */
@@ -187,13 +207,107 @@ static void uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset)
 #define uart_pollnotify(dev, event)
 #endif
 
+/************************************************************************************
+ * Name: uart_waitxmit
+ *
+ * Description:
+ *   Wait until the lower half has removed some data from a full TX buffer.
+ *   Returns OK when there is space again, or a negated errno value if the caller
+ *   may not block, if a signal was received or if the device was removed.
+ *
+ ************************************************************************************/
+
+static int uart_waitxmit(FAR uart_dev_t *dev, bool oktoblock)
+{
+	irqstate_t flags;
+	int nexthead;
+	int ret;
+
+	/* The caller has request that we not block for data.  So return the
+	 * EAGAIN error to signal this situation.
+	 */
+
+	if (!oktoblock) {
+		return -EAGAIN;
+	}
+
+	/* Inform the interrupt level logic that we are waiting. This and
+	 * the following steps must be atomic.
+	 */
+
+	flags = irqsave();
+
+	/* Check again...  In certain race conditions an interrupt may
+	 * have occurred between the test made by the caller and entering
+	 * the critical section and the TX buffer may no longer be full.
+	 *
+	 * NOTE: On certain devices, such as USB CDC/ACM, the entire TX
+	 * buffer may have been emptied in this race condition.  In that
+	 * case, the logic would hang below waiting for space in the TX
+	 * buffer without this test.
+	 */
+
+	nexthead = dev->xmit.head + 1;
+	if (nexthead >= dev->xmit.size) {
+		nexthead = 0;
+	}
+
+	if (nexthead != dev->xmit.tail) {
+		ret = OK;
+	}
+#ifdef CONFIG_SERIAL_REMOVABLE
+	/* Check if the removable device is no longer connected while we
+	 * have interrupts off.  We do not want the transition to occur
+	 * as a race condition before we begin the wait.
+	 */
+
+	else if (dev->disconnected) {
+		ret = -ENOTCONN;
+	}
+#endif
+	else {
+		/* Wait for some characters to be sent from the buffer with
+		 * the TX interrupt enabled.  When the TX interrupt is
+		 * enabled, uart_xmitchars should execute and remove some
+		 * of the data from the TX buffer.
+		 */
+
+		dev->xmitwaiting = true;
+		uart_xmitavail(dev);
+		ret = uart_takesem(&dev->xmitsem, true);
+		uart_disabletxint(dev);
+	}
+
+	irqrestore(flags);
+
+#ifdef CONFIG_SERIAL_REMOVABLE
+	/* Check if the removable device was disconnected while we were
+	 * waiting.
+	 */
+
+	if (dev->disconnected) {
+		return -ENOTCONN;
+	}
+#endif
+	/* Check if we were awakened by signal. */
+
+	if (ret < 0) {
+		/* A signal received while waiting for the xmit buffer to become
+		 * non-full will abort the transfer.
+		 */
+
+		return -EINTR;
+	}
+
+	return OK;
+}
+
 /************************************************************************************
  * Name: uart_putxmitchar
  ************************************************************************************/
 
 static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
 {
-	irqstate_t flags;
 	int nexthead;
 	int ret;
 
@@ -220,86 +334,68 @@ static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
 		 * buffer?
 		 */
 
-		else if (oktoblock) {
-			/* Inform the interrupt level logic that we are waiting. This and
-			 * the following steps must be atomic.
-			 */
-
-			flags = irqsave();
-
-			/* Check again...  In certain race conditions an interrupt may
-			 * have occurred between the test at the top of the loop and
-			 * entering the critical section and the TX buffer may no longer
-			 * be full.
-			 *
-			 * NOTE: On certain devices, such as USB CDC/ACM, the entire TX
-			 * buffer may have been emptied in this race condition.  In that
-			 * case, the logic would hang below waiting for space in the TX
-			 * buffer without this test.
-			 */
-
-			if (nexthead != dev->xmit.tail) {
-				ret = OK;
-			}
-#ifdef CONFIG_SERIAL_REMOVABLE
-			/* Check if the removable device is no longer connected while we
-			 * have interrupts off.  We do not want the transition to occur
-			 * as a race condition before we begin the wait.
-			 */
+		ret = uart_waitxmit(dev, oktoblock);
+		if (ret < 0) {
+			return ret;
+		}
+	}
 
-			else if (dev->disconnected) {
-				ret = -ENOTCONN;
-			}
-#endif
-			else {
-				/* Wait for some characters to be sent from the buffer with
-				 * the TX interrupt enabled.  When the TX interrupt is
-				 * enabled, uart_xmitchars should execute and remove some
-				 * of the data from the TX buffer.
-				 */
+	/* We won't get here.  Some compilers may complain that this code is
+	 * unreachable.
+	 */
 
-				dev->xmitwaiting = true;
-				uart_enabletxint(dev);
-				ret = uart_takesem(&dev->xmitsem, true);
-				uart_disabletxint(dev);
-			}
+	return OK;
+}
 
-			irqrestore(flags);
+/************************************************************************************
+ * Name: uart_copyxmit
+ *
+ * Description:
+ *   Copy as much of 'buffer' as fits into the free space of the TX buffer, one
+ *   contiguous segment at a time.  Returns the number of bytes copied.
+ *
+ ************************************************************************************/
 
-#ifdef CONFIG_SERIAL_REMOVABLE
-			/* Check if the removable device was disconnected while we were
-			 * waiting.
-			 */
+static size_t uart_copyxmit(FAR uart_dev_t *dev, FAR const char *buffer, size_t buflen)
+{
+	FAR struct uart_buffer_s *txbuf = &dev->xmit;
+	int16_t head = txbuf->head;
+	int16_t tail = txbuf->tail;
+	size_t ncopied = 0;
+	size_t nfree;
+
+	while (buflen > 0) {
+		/* One byte is always left free so that a full buffer can be told from
+		 * an empty one.
+		 */
 
-			if (dev->disconnected) {
-				return -ENOTCONN;
-			}
-#endif
-			/* Check if we were awakened by signal. */
+		if (head < tail) {
+			nfree = tail - head - 1;
+		} else {
+			nfree = txbuf->size - head - (tail == 0 ? 1 : 0);
+		}
 
-			if (ret < 0) {
-				/* A signal received while waiting for the xmit buffer to become
-				 * non-full will abort the transfer.
-				 */
+		if (nfree == 0) {
+			break;
+		}
 
-				return -EINTR;
-			}
+		if (nfree > buflen) {
+			nfree = buflen;
 		}
 
-		/* The caller has request that we not block for data.  So return the
-		 * EAGAIN error to signal this situation.
-		 */
+		memcpy(&txbuf->buffer[head], buffer, nfree);
+		buffer += nfree;
+		buflen -= nfree;
+		ncopied += nfree;
 
-		else {
-			return -EAGAIN;
+		head += nfree;
+		if (head >= txbuf->size) {
+			head = 0;
 		}
 	}
 
-	/* We won't get here.  Some compilers may complain that this code is
-	 * unreachable.
-	 */
-
-	return OK;
+	txbuf->head = head;
+	return ncopied;
 }
 
 /************************************************************************************
@@ -408,6 +504,47 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer, size_t
 	 */
 
 	uart_disabletxint(dev);
+
+	/* Without any output processing, the data is copied a whole segment of the
+	 * TX buffer at a time.
+	 */
+
+#ifdef CONFIG_SERIAL_TERMIOS
+	if ((dev->tc_oflag & OPOST) == 0 || (dev->tc_oflag & (OCRNL | ONLCR | ONLRET)) == 0)
+#else
+	if (!dev->isconsole)
+#endif
+	{
+		while (buflen > 0) {
+			size_t ncopied = uart_copyxmit(dev, buffer, buflen);
+
+			buffer += ncopied;
+			buflen -= ncopied;
+			if (buflen == 0) {
+				break;
+			}
+
+			/* The buffer is full.  Wait for the lower half to send some of it */
+
+			ret = uart_waitxmit(dev, oktoblock);
+			if (ret < 0) {
+				/* Return the number of bytes that were successfully transferred
+				 * or, if none, the negated errno value.
+				 */
+
+				if (buflen < nwritten) {
+					nwritten -= buflen;
+				} else {
+					nwritten = ret;
+				}
+
+				break;
+			}
+		}
+
+		buflen = 0;
+	}
+
 	for (; buflen; buflen--) {
 		ch = *buffer++;
 		ret = OK;
@@ -489,7 +626,7 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer, size_t
 	}
 
 	if (dev->xmit.head != dev->xmit.tail) {
-		uart_enabletxint(dev);
+		uart_xmitavail(dev);
 	}
 
 	uart_givesem(&dev->xmit.sem);
@@ -508,10 +645,17 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
 	unsigned int nbuffered;
 	unsigned int watermark;
+#endif
+#ifdef CONFIG_SERIAL_TERMIOS
+	bool rawin = (dev->tc_iflag & (INLCR | IGNCR | ICRNL)) == 0;
+#else
+	bool rawin = true;
 #endif
 	irqstate_t flags;
 	ssize_t recvd = 0;
+	int16_t head;
 	int16_t tail;
+	size_t nbytes;
 	char ch;
 	int ret;
 
@@ -559,7 +703,28 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 		 */
 
 		tail = rxbuf->tail;
-		if (rxbuf->head != tail) {
+		head = rxbuf->head;
+		if (head != tail && rawin) {
+			/* Without any input processing, take the whole contiguous segment
+			 * at the tail of the buffer.
+			 */
+
+			nbytes = (head > tail ? head : rxbuf->size) - tail;
+			if (nbytes > buflen - recvd) {
+				nbytes = buflen - recvd;
+			}
+
+			memcpy(buffer, &rxbuf->buffer[tail], nbytes);
+			buffer += nbytes;
+			recvd += nbytes;
+
+			tail += nbytes;
+			if (tail >= rxbuf->size) {
+				tail = 0;
+			}
+
+			rxbuf->tail = tail;
+		} else if (head != tail) {
 			/* Take the next character from the tail of the buffer */
 
 			ch = rxbuf->buffer[tail];
@@ -682,6 +847,16 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 				if (dev->disconnected) {
 					ret = -ENOTCONN;
 				} else
+#endif
+#ifdef CONFIG_SERIAL_RXDMA
+				/* A DMA transfer is not stopped by disabling the Rx
+				 * interrupt and may have completed before the interrupts
+				 * were disabled.  Check again before waiting.
+				 */
+
+				if (rxbuf->head != rxbuf->tail) {
+					ret = OK;
+				} else
 #endif
 				{
 					/* Now wait with the Rx interrupt re-enabled.  TinyAra will
@@ -737,6 +912,14 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 		}
 	}
 
+#ifdef CONFIG_SERIAL_RXDMA
+	/* Let a lower half which paused on a full buffer receive again */
+
+	if (recvd > 0) {
+		uart_dmarxfree(dev);
+	}
+#endif
+
 #ifdef CONFIG_SERIAL_IFLOWCONTROL
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
 	/* How many bytes are now buffered */
@@ -840,6 +1023,9 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 					break;
 				}
 				dev->recv.tail = dev->recv.head;
+#ifdef CONFIG_SERIAL_RXDMA
+				uart_dmarxfree(dev);
+#endif
 #ifdef CONFIG_SERIAL_IFLOWCONTROL
 				uart_rxflowcontrol(dev, 0, false);
 #endif
@@ -1267,6 +1453,11 @@ errout_with_sem:
 
 int uart_register(FAR const char *path, FAR uart_dev_t *dev)
 {
+#ifdef CONFIG_SERIAL_STATS
+	FAR uart_dev_t *prev;
+	irqstate_t flags;
+#endif
+
 	/* Initialize semaphores */
 	sem_init(&dev->xmit.sem, 0, 1);
 	sem_init(&dev->recv.sem, 0, 1);
@@ -1284,6 +1475,27 @@ int uart_register(FAR const char *path, FAR uart_dev_t *dev)
 	sem_setprotocol(&dev->xmitsem, SEM_PRIO_NONE);
 	sem_setprotocol(&dev->recvsem, SEM_PRIO_NONE);
 
+#ifdef CONFIG_SERIAL_STATS
+	/* Remember the device for /proc/serial.  The console is registered a second
+	 * time as a ttyS device and keeps its first path.
+	 */
+
+	prev = g_uart_devs;
+	while (prev != NULL && prev != dev) {
+		prev = prev->flink;
+	}
+
+	if (prev == NULL) {
+		strncpy(dev->path, path, CONFIG_SERIAL_STATS_PATHLEN - 1);
+		dev->path[CONFIG_SERIAL_STATS_PATHLEN - 1] = '\0';
+
+		flags = irqsave();
+		dev->flink = g_uart_devs;
+		g_uart_devs = dev;
+		irqrestore(flags);
+	}
+#endif
+
 	/* Register the serial driver */
 	dbg("Registering %s\n", path);
 	return register_driver(path, &g_serialops, 0666, dev);
@@ -1404,3 +1616,26 @@ void uart_connected(FAR uart_dev_t *dev, bool connected)
 	irqrestore(flags);
 }
 #endif
+
+/************************************************************************************
+ * Name: uart_foreach
+ *
+ * Description:
+ *   Call 'handler' for each registered serial device until it returns non-zero.
+ *   Devices are only ever added to the list, so it may be walked without a lock.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_STATS
+int uart_foreach(uart_foreach_t handler, FAR void *arg)
+{
+	FAR uart_dev_t *dev;
+	int ret = OK;
+
+	for (dev = g_uart_devs; dev != NULL && ret == OK; dev = dev->flink) {
+		ret = handler(dev, arg);
+	}
+
+	return ret;
+}
+#endif
@@ -0,0 +1,237 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/************************************************************************************
+ * drivers/serial/serial_dma.c
+ *
+ * Block transfers between the serial I/O buffers and a DMA capable lower half.
+ * The free or pending part of a circular buffer is handed to the lower half as
+ * up to two contiguous segments, and the indices are moved once per completed
+ * transfer instead of once per character.
+ *
+ ************************************************************************************/
+
+/************************************************************************************
+ * Included Files
+ ************************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <debug.h>
+#include <tinyara/serial/serial.h>
+
+#ifdef CONFIG_SERIAL_DMA
+
+/************************************************************************************
+ * Private Functions
+ ************************************************************************************/
+
+/************************************************************************************
+ * Name: uart_advance
+ *
+ * Description:
+ *   Return the index 'nbytes' past 'ndx' in a circular buffer of 'size' bytes.
+ *   The transfers never cover more than one lap of the buffer.
+ *
+ ************************************************************************************/
+
+static inline int16_t uart_advance(int16_t ndx, size_t nbytes, int16_t size)
+{
+	size_t next = ndx + nbytes;
+
+	if (next >= (size_t)size) {
+		next -= size;
+	}
+
+	return (int16_t)next;
+}
+
+/************************************************************************************
+ * Public Functions
+ ************************************************************************************/
+
+/************************************************************************************
+ * Name: uart_xmitchars_dma
+ *
+ * Description:
+ *   Set up dev->dmatx with the data pending in the xmit buffer and start the
+ *   transfer with the dmasend() method.  Nothing is done if the buffer is empty.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_TXDMA
+void uart_xmitchars_dma(FAR uart_dev_t *dev)
+{
+	FAR struct uart_dmaxfer_s *xfer = &dev->dmatx;
+	FAR struct uart_buffer_s *txbuf = &dev->xmit;
+	int16_t head = txbuf->head;
+	int16_t tail = txbuf->tail;
+
+	if (head == tail) {
+		return;
+	}
+
+	xfer->buffer = &txbuf->buffer[tail];
+	if (tail < head) {
+		/* The pending data is contiguous */
+
+		xfer->length = head - tail;
+		xfer->nbuffer = NULL;
+		xfer->nlength = 0;
+	} else {
+		/* The pending data wraps to the start of the buffer */
+
+		xfer->length = txbuf->size - tail;
+		xfer->nbuffer = txbuf->buffer;
+		xfer->nlength = head;
+	}
+
+	xfer->nbytes = 0;
+	uart_dmasend(dev);
+}
+
+/************************************************************************************
+ * Name: uart_xmitchars_done
+ *
+ * Description:
+ *   Remove the dev->dmatx.nbytes bytes sent by the lower half from the xmit
+ *   buffer and wake up the writers.
+ *
+ ************************************************************************************/
+
+void uart_xmitchars_done(FAR uart_dev_t *dev)
+{
+	FAR struct uart_dmaxfer_s *xfer = &dev->dmatx;
+	FAR struct uart_buffer_s *txbuf = &dev->xmit;
+	size_t nbytes = xfer->nbytes;
+
+	DEBUGASSERT(nbytes <= xfer->length + xfer->nlength);
+
+	txbuf->tail = uart_advance(txbuf->tail, nbytes, txbuf->size);
+
+	xfer->nbytes = 0;
+	xfer->length = 0;
+	xfer->nlength = 0;
+
+#ifdef CONFIG_SERIAL_STATS
+	dev->stats.txbytes += nbytes;
+	dev->stats.txcalls++;
+#endif
+
+	/* If any bytes were removed from the buffer, inform any waiters there there is
+	 * space available.
+	 */
+
+	if (nbytes) {
+		uart_datasent(dev);
+	}
+}
+#endif							/* CONFIG_SERIAL_TXDMA */
+
+/************************************************************************************
+ * Name: uart_recvchars_dma
+ *
+ * Description:
+ *   Set up dev->dmarx with the free space of the recv buffer and start the
+ *   transfer with the dmareceive() method.  One byte is always left free so
+ *   that a full buffer can be told from an empty one.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA
+void uart_recvchars_dma(FAR uart_dev_t *dev)
+{
+	FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
+	FAR struct uart_buffer_s *rxbuf = &dev->recv;
+	int16_t head = rxbuf->head;
+	int16_t tail = rxbuf->tail;
+
+	xfer->buffer = &rxbuf->buffer[head];
+	xfer->nbuffer = NULL;
+	xfer->nlength = 0;
+	xfer->nbytes = 0;
+
+	if (tail > head) {
+		/* The free space is contiguous */
+
+		xfer->length = tail - head - 1;
+	} else if (tail == 0) {
+		/* The free space ends one byte before the end of the buffer */
+
+		xfer->length = rxbuf->size - head - 1;
+	} else {
+		/* The free space wraps to the start of the buffer */
+
+		xfer->length = rxbuf->size - head;
+		xfer->nbuffer = rxbuf->buffer;
+		xfer->nlength = tail - 1;
+	}
+
+#ifdef CONFIG_SERIAL_IFLOWCONTROL
+	/* Let the lower half hold off the sender while the buffer is full */
+
+	if (xfer->length == 0 && xfer->nlength == 0) {
+		(void)uart_rxflowcontrol(dev, rxbuf->size - 1, true);
+	}
+#endif
+
+	uart_dmareceive(dev);
+}
+
+/************************************************************************************
+ * Name: uart_recvchars_done
+ *
+ * Description:
+ *   Add the dev->dmarx.nbytes bytes received by the lower half to the recv
+ *   buffer and wake up the readers.
+ *
+ ************************************************************************************/
+
+void uart_recvchars_done(FAR uart_dev_t *dev)
+{
+	FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
+	FAR struct uart_buffer_s *rxbuf = &dev->recv;
+	size_t nbytes = xfer->nbytes;
+
+	DEBUGASSERT(nbytes <= xfer->length + xfer->nlength);
+
+	rxbuf->head = uart_advance(rxbuf->head, nbytes, rxbuf->size);
+
+	xfer->nbytes = 0;
+	xfer->length = 0;
+	xfer->nlength = 0;
+
+#ifdef CONFIG_SERIAL_STATS
+	dev->stats.rxbytes += nbytes;
+	dev->stats.rxcalls++;
+#endif
+
+	/* If any bytes were added to the buffer, inform any waiters there there is new
+	 * incoming data available.
+	 */
+
+	if (nbytes) {
+		uart_datareceived(dev);
+	}
+}
+#endif							/* CONFIG_SERIAL_RXDMA */
+
+#endif							/* CONFIG_SERIAL_DMA */
@@ -0,0 +1,339 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * drivers/serial/serial_procfs.c
+ *
+ * /proc/serial reports the throughput counters of the registered serial
+ * devices: the bytes moved by the lower half in each direction, the bytes
+ * dropped on a full RX buffer and the interrupts or DMA completions that
+ * moved them.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+#include <tinyara/serial/serial.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+	!defined(CONFIG_FS_PROCFS_EXCLUDE_SERIAL)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define SERIAL_LINELEN 96
+
+#define SERIAL_INFO_TITLE_FMT " %-15s | %10s | %10s | %10s | %8s | %8s \n"
+#define SERIAL_INFO_LINE " ----------------|------------|------------|------------|----------|----------\n"
+#define SERIAL_INFO_TITLE "DEVICE", "TX_BYTES", "RX_BYTES", "RX_DROPPED", "TX_IRQS", "RX_IRQS"
+#define SERIAL_INFO_FMT " %-15s | %10u | %10u | %10u | %8u | %8u \n"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct serial_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	char line[SERIAL_LINELEN];	/* Pre-allocated buffer for formatted lines */
+};
+
+/* The state of one read() while the devices are walked */
+
+struct serial_read_s {
+	FAR struct serial_file_s *attr;
+	FAR char *buffer;			/* Where the next line goes */
+	size_t buflen;				/* Size of the user buffer */
+	size_t totalsize;			/* Bytes returned so far */
+	off_t offset;				/* Bytes still to be skipped */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int serial_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int serial_close(FAR struct file *filep);
+static ssize_t serial_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+static int serial_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int serial_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations serial_operations = {
+	serial_open,				/* open */
+	serial_close,				/* close */
+	serial_read,				/* read */
+	NULL,						/* write */
+
+	serial_dup,					/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	serial_stat					/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: serial_open
+ ****************************************************************************/
+
+static int serial_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct serial_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "serial" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "serial") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct serial_file_s *)kmm_zalloc(sizeof(struct serial_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: serial_close
+ ****************************************************************************/
+
+static int serial_close(FAR struct file *filep)
+{
+	FAR struct serial_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct serial_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: serial_putline
+ *
+ * Description:
+ *   Copy the formatted line to the user buffer.  Returns non-zero when the
+ *   buffer is full.
+ *
+ ****************************************************************************/
+
+static int serial_putline(FAR struct serial_read_s *rd, size_t linesize)
+{
+	size_t copysize;
+
+	copysize = procfs_memcpy(rd->attr->line, linesize, rd->buffer, rd->buflen - rd->totalsize, &rd->offset);
+	rd->totalsize += copysize;
+	rd->buffer += copysize;
+
+	return rd->totalsize >= rd->buflen;
+}
+
+/****************************************************************************
+ * Name: serial_putdev
+ ****************************************************************************/
+
+static int serial_putdev(FAR uart_dev_t *dev, FAR void *arg)
+{
+	FAR struct serial_read_s *rd = (FAR struct serial_read_s *)arg;
+	struct uart_stats_s stats;
+	irqstate_t flags;
+	size_t linesize;
+
+	/* Take a consistent snapshot of counters updated from interrupts */
+
+	flags = irqsave();
+	stats = dev->stats;
+	irqrestore(flags);
+
+	linesize = snprintf(rd->attr->line, SERIAL_LINELEN, SERIAL_INFO_FMT, dev->path,
+						(unsigned int)stats.txbytes, (unsigned int)stats.rxbytes,
+						(unsigned int)stats.rxdropped, (unsigned int)stats.txcalls,
+						(unsigned int)stats.rxcalls);
+
+	return serial_putline(rd, linesize);
+}
+
+/****************************************************************************
+ * Name: serial_read
+ ****************************************************************************/
+
+static ssize_t serial_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	struct serial_read_s rd;
+	size_t linesize;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	rd.attr = (FAR struct serial_file_s *)filep->f_priv;
+	DEBUGASSERT(rd.attr);
+
+	rd.buffer = buffer;
+	rd.buflen = buflen;
+	rd.totalsize = 0;
+	rd.offset = filep->f_pos;
+
+	linesize = snprintf(rd.attr->line, SERIAL_LINELEN, SERIAL_INFO_TITLE_FMT, SERIAL_INFO_TITLE);
+	if (serial_putline(&rd, linesize) == 0) {
+		linesize = snprintf(rd.attr->line, SERIAL_LINELEN, SERIAL_INFO_LINE);
+		if (serial_putline(&rd, linesize) == 0) {
+			(void)uart_foreach(serial_putdev, &rd);
+		}
+	}
+
+	/* Update the file position */
+
+	if (rd.totalsize > 0) {
+		filep->f_pos += rd.totalsize;
+	}
+
+	return rd.totalsize;
+}
+
+/****************************************************************************
+ * Name: serial_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int serial_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct serial_file_s *oldattr;
+	FAR struct serial_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct serial_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct serial_file_s *)kmm_malloc(sizeof(struct serial_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct serial_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: serial_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int serial_stat(const char *relpath, struct stat *buf)
+{
+	/* "serial" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "serial") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "serial" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS && !CONFIG_FS_PROCFS_EXCLUDE_SERIAL */
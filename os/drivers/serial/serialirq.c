@@ -129,6 +129,11 @@ void uart_xmitchars(FAR uart_dev_t *dev)
 		uart_disabletxint(dev);
 	}
 
+#ifdef CONFIG_SERIAL_STATS
+	dev->stats.txbytes += nbytes;
+	dev->stats.txcalls++;
+#endif
+
 	/* If any bytes were removed from the buffer, inform any waiters there there is
 	 * space available.
 	 */
@@ -239,8 +244,18 @@ void uart_recvchars(FAR uart_dev_t *dev)
 				nexthead = 0;
 			}
 		}
+#ifdef CONFIG_SERIAL_STATS
+		else {
+			dev->stats.rxdropped++;
+		}
+#endif
 	}
 
+#ifdef CONFIG_SERIAL_STATS
+	dev->stats.rxbytes += nbytes;
+	dev->stats.rxcalls++;
+#endif
+
 	/* If any bytes were added to the buffer, inform any waiters there there is new
 	 * incoming data available.
 	 */
@@ -0,0 +1,650 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * drivers/serial/uart_loopback.c
+ *
+ * A serial lower half without hardware: what is sent on /dev/ttyLB0 is
+ * received on /dev/ttyLB0.  The wire is a 16 byte FIFO like the one of a
+ * 16550, and the interrupts are emulated on the high priority work queue.
+ * Without DMA, each interrupt moves at most one FIFO of data through
+ * uart_xmitchars() and uart_recvchars().  With CONFIG_SERIAL_TXDMA or
+ * CONFIG_SERIAL_RXDMA, the transfers of the upper half are moved through
+ * the same FIFO and each one completes with a single interrupt; a receive
+ * also completes when the line goes idle.
+ *
+ * The wire has hardware flow control: the FIFO is only drained while the
+ * receive buffer has room, so that no data is lost on a slow reader.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/irq.h>
+#include <tinyara/wqueue.h>
+#include <tinyara/serial/serial.h>
+
+#ifdef CONFIG_SERIAL_LOOPBACK
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LOOPBACK_FIFOSIZE 16
+
+#ifndef CONFIG_SERIAL_LOOPBACK_RXBUFSIZE
+#define CONFIG_SERIAL_LOOPBACK_RXBUFSIZE 256
+#endif
+
+#ifndef CONFIG_SERIAL_LOOPBACK_TXBUFSIZE
+#define CONFIG_SERIAL_LOOPBACK_TXBUFSIZE 256
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct loopback_s {
+	struct work_s work;			/* Emulated interrupt */
+	bool pending;				/* The interrupt handler is scheduled or running */
+	bool txint;					/* TX interrupt enabled */
+	bool rxint;					/* RX interrupt enabled */
+#ifdef CONFIG_SERIAL_TXDMA
+	bool txdma;					/* A TX transfer is in progress */
+#endif
+#ifdef CONFIG_SERIAL_RXDMA
+	bool rxdma;					/* An RX transfer is in progress */
+#endif
+	uint8_t head;				/* FIFO index of the next byte sent */
+	uint8_t tail;				/* FIFO index of the next byte received */
+	uint8_t count;				/* Bytes in the FIFO */
+	uint8_t fifo[LOOPBACK_FIFOSIZE];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int loopback_setup(FAR struct uart_dev_s *dev);
+static void loopback_shutdown(FAR struct uart_dev_s *dev);
+static int loopback_attach(FAR struct uart_dev_s *dev);
+static void loopback_detach(FAR struct uart_dev_s *dev);
+static int loopback_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
+static int loopback_receive(FAR struct uart_dev_s *dev, FAR unsigned int *status);
+static void loopback_rxint(FAR struct uart_dev_s *dev, bool enable);
+static bool loopback_rxavailable(FAR struct uart_dev_s *dev);
+static void loopback_send(FAR struct uart_dev_s *dev, int ch);
+static void loopback_txint(FAR struct uart_dev_s *dev, bool enable);
+static bool loopback_txready(FAR struct uart_dev_s *dev);
+static bool loopback_txempty(FAR struct uart_dev_s *dev);
+#ifdef CONFIG_SERIAL_RXDMA
+static void loopback_dmareceive(FAR struct uart_dev_s *dev);
+static void loopback_dmarxfree(FAR struct uart_dev_s *dev);
+#endif
+#ifdef CONFIG_SERIAL_TXDMA
+static void loopback_dmasend(FAR struct uart_dev_s *dev);
+static void loopback_dmatxavail(FAR struct uart_dev_s *dev);
+#endif
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+
+static const struct uart_ops_s g_loopback_ops = {
+	.setup = loopback_setup,
+	.shutdown = loopback_shutdown,
+	.attach = loopback_attach,
+	.detach = loopback_detach,
+	.ioctl = loopback_ioctl,
+	.receive = loopback_receive,
+	.rxint = loopback_rxint,
+	.rxavailable = loopback_rxavailable,
+#ifdef CONFIG_SERIAL_IFLOWCONTROL
+	.rxflowcontrol = NULL,
+#endif
+	.send = loopback_send,
+	.txint = loopback_txint,
+	.txready = loopback_txready,
+	.txempty = loopback_txempty,
+#ifdef CONFIG_SERIAL_RXDMA
+	.dmareceive = loopback_dmareceive,
+	.dmarxfree = loopback_dmarxfree,
+#endif
+#ifdef CONFIG_SERIAL_TXDMA
+	.dmasend = loopback_dmasend,
+	.dmatxavail = loopback_dmatxavail,
+#endif
+};
+
+static char g_loopback_rxbuffer[CONFIG_SERIAL_LOOPBACK_RXBUFSIZE];
+static char g_loopback_txbuffer[CONFIG_SERIAL_LOOPBACK_TXBUFSIZE];
+
+static struct loopback_s g_loopback_priv;
+
+static uart_dev_t g_loopback_dev = {
+	.recv = {
+		.size = CONFIG_SERIAL_LOOPBACK_RXBUFSIZE,
+		.buffer = g_loopback_rxbuffer,
+	},
+	.xmit = {
+		.size = CONFIG_SERIAL_LOOPBACK_TXBUFSIZE,
+		.buffer = g_loopback_txbuffer,
+	},
+	.ops = &g_loopback_ops,
+	.priv = &g_loopback_priv,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: loopback_recvfull
+ *
+ * Description:
+ *   Return true if the receive buffer of the upper half has no room left.
+ *   This is the RTS line of the receiver.
+ *
+ ****************************************************************************/
+
+static bool loopback_recvfull(FAR struct uart_dev_s *dev)
+{
+	int nexthead = dev->recv.head + 1;
+
+	if (nexthead >= dev->recv.size) {
+		nexthead = 0;
+	}
+
+	return nexthead == dev->recv.tail;
+}
+
+/****************************************************************************
+ * Name: loopback_push / loopback_pull
+ *
+ * Description:
+ *   Move up to 'len' bytes into or out of the FIFO.  Return the number of
+ *   bytes moved.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SERIAL_TXDMA) || defined(CONFIG_SERIAL_RXDMA)
+static size_t loopback_push(FAR struct loopback_s *priv, FAR const char *buf, size_t len)
+{
+	size_t n = 0;
+
+	while (n < len && priv->count < LOOPBACK_FIFOSIZE) {
+		priv->fifo[priv->head] = buf[n++];
+		priv->head = (priv->head + 1) & (LOOPBACK_FIFOSIZE - 1);
+		priv->count++;
+	}
+
+	return n;
+}
+
+static size_t loopback_pull(FAR struct loopback_s *priv, FAR char *buf, size_t len)
+{
+	size_t n = 0;
+
+	while (n < len && priv->count > 0) {
+		buf[n++] = priv->fifo[priv->tail];
+		priv->tail = (priv->tail + 1) & (LOOPBACK_FIFOSIZE - 1);
+		priv->count--;
+	}
+
+	return n;
+}
+#endif
+
+/****************************************************************************
+ * Name: loopback_xfer
+ *
+ * Description:
+ *   Move data between a DMA transfer and the FIFO, continuing where the
+ *   transfer stopped.  Return the number of bytes moved.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SERIAL_TXDMA) || defined(CONFIG_SERIAL_RXDMA)
+static size_t loopback_xfer(FAR struct loopback_s *priv, FAR struct uart_dmaxfer_s *xfer, bool send)
+{
+	size_t moved = 0;
+	size_t n;
+
+	for (;;) {
+		FAR char *buf;
+		size_t len;
+
+		if (xfer->nbytes < xfer->length) {
+			buf = xfer->buffer + xfer->nbytes;
+			len = xfer->length - xfer->nbytes;
+		} else if (xfer->nbytes < xfer->length + xfer->nlength) {
+			buf = xfer->nbuffer + (xfer->nbytes - xfer->length);
+			len = xfer->length + xfer->nlength - xfer->nbytes;
+		} else {
+			break;
+		}
+
+		n = send ? loopback_push(priv, buf, len) : loopback_pull(priv, buf, len);
+		if (n == 0) {
+			break;
+		}
+
+		xfer->nbytes += n;
+		moved += n;
+	}
+
+	return moved;
+}
+#endif
+
+/****************************************************************************
+ * Name: loopback_txidle
+ *
+ * Description:
+ *   Return true if the transmitter will put nothing more on the wire.
+ *
+ ****************************************************************************/
+
+static bool loopback_txidle(FAR struct uart_dev_s *dev)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+
+#ifdef CONFIG_SERIAL_TXDMA
+	return !priv->txdma;
+#else
+	return !priv->txint || dev->xmit.head == dev->xmit.tail;
+#endif
+}
+
+/****************************************************************************
+ * Name: loopback_interrupt
+ *
+ * Description:
+ *   The emulated interrupt handler.  It runs until neither side of the wire
+ *   can make progress.
+ *
+ ****************************************************************************/
+
+static void loopback_interrupt(FAR void *arg)
+{
+	FAR struct uart_dev_s *dev = (FAR struct uart_dev_s *)arg;
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+	irqstate_t flags;
+	bool progress;
+
+	flags = irqsave();
+	do {
+		progress = false;
+
+		/* Transmitter */
+
+#ifdef CONFIG_SERIAL_TXDMA
+		if (priv->txdma) {
+			FAR struct uart_dmaxfer_s *xfer = &dev->dmatx;
+
+			if (loopback_xfer(priv, xfer, true) > 0) {
+				progress = true;
+			}
+
+			if (xfer->nbytes == xfer->length + xfer->nlength) {
+				/* Transfer complete.  Start the next one, if any */
+
+				priv->txdma = false;
+				uart_xmitchars_done(dev);
+				uart_xmitchars_dma(dev);
+				progress = true;
+			}
+		}
+#else
+		if (priv->txint && priv->count < LOOPBACK_FIFOSIZE && dev->xmit.head != dev->xmit.tail) {
+			uart_xmitchars(dev);
+			progress = true;
+		}
+#endif
+
+		/* Receiver */
+
+#ifdef CONFIG_SERIAL_RXDMA
+		if (priv->rxdma) {
+			FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
+
+			if (loopback_xfer(priv, xfer, false) > 0) {
+				progress = true;
+			}
+
+			/* Complete when the buffer is full or when the line goes idle */
+
+			if (xfer->nbytes == xfer->length + xfer->nlength ||
+				(xfer->nbytes > 0 && priv->count == 0 && loopback_txidle(dev))) {
+				priv->rxdma = false;
+				uart_recvchars_done(dev);
+				uart_recvchars_dma(dev);
+				progress = true;
+			}
+		}
+#else
+		if (priv->rxint && priv->count > 0 && !loopback_recvfull(dev)) {
+			uart_recvchars(dev);
+			progress = true;
+		}
+#endif
+
+		/* Nothing is received on a closed port, the data is lost as it would
+		 * be on a line without a listener.  This lets close() drain the TX
+		 * buffer.
+		 */
+
+		if (dev->open_count == 0 && priv->count > 0) {
+			priv->tail = priv->head;
+			priv->count = 0;
+			progress = true;
+		}
+	} while (progress);
+
+	priv->pending = false;
+	irqrestore(flags);
+}
+
+/****************************************************************************
+ * Name: loopback_kick
+ *
+ * Description:
+ *   Raise the emulated interrupt.
+ *
+ ****************************************************************************/
+
+static void loopback_kick(FAR struct uart_dev_s *dev)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+	irqstate_t flags;
+
+	flags = irqsave();
+	if (!priv->pending) {
+		priv->pending = true;
+		if (work_queue(HPWORK, &priv->work, loopback_interrupt, dev, 0) < 0) {
+			priv->pending = false;
+		}
+	}
+
+	irqrestore(flags);
+}
+
+/****************************************************************************
+ * Name: loopback_setup
+ ****************************************************************************/
+
+static int loopback_setup(FAR struct uart_dev_s *dev)
+{
+	return OK;
+}
+
+/****************************************************************************
+ * Name: loopback_shutdown
+ ****************************************************************************/
+
+static void loopback_shutdown(FAR struct uart_dev_s *dev)
+{
+}
+
+/****************************************************************************
+ * Name: loopback_attach
+ *
+ * Description:
+ *   Empty the wire.  Nothing is attached to a real interrupt.
+ *
+ ****************************************************************************/
+
+static int loopback_attach(FAR struct uart_dev_s *dev)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+
+	priv->head = 0;
+	priv->tail = 0;
+	priv->count = 0;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: loopback_detach
+ ****************************************************************************/
+
+static void loopback_detach(FAR struct uart_dev_s *dev)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+
+	priv->txint = false;
+	priv->rxint = false;
+#ifdef CONFIG_SERIAL_TXDMA
+	priv->txdma = false;
+#endif
+#ifdef CONFIG_SERIAL_RXDMA
+	priv->rxdma = false;
+#endif
+}
+
+/****************************************************************************
+ * Name: loopback_ioctl
+ ****************************************************************************/
+
+static int loopback_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+	return -ENOTTY;
+}
+
+/****************************************************************************
+ * Name: loopback_receive
+ ****************************************************************************/
+
+static int loopback_receive(FAR struct uart_dev_s *dev, FAR unsigned int *status)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+	int ch;
+
+	*status = 0;
+	if (priv->count == 0) {
+		return 0;
+	}
+
+	ch = priv->fifo[priv->tail];
+	priv->tail = (priv->tail + 1) & (LOOPBACK_FIFOSIZE - 1);
+	priv->count--;
+	return ch;
+}
+
+/****************************************************************************
+ * Name: loopback_rxint
+ ****************************************************************************/
+
+static void loopback_rxint(FAR struct uart_dev_s *dev, bool enable)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+
+	priv->rxint = enable;
+	if (enable) {
+#ifdef CONFIG_SERIAL_RXDMA
+		/* Start receiving if no transfer is set up yet */
+
+		loopback_dmarxfree(dev);
+#else
+		loopback_kick(dev);
+#endif
+	}
+}
+
+/****************************************************************************
+ * Name: loopback_rxavailable
+ *
+ * Description:
+ *   Data is available while the FIFO is not empty and the receive buffer has
+ *   room for it.
+ *
+ ****************************************************************************/
+
+static bool loopback_rxavailable(FAR struct uart_dev_s *dev)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+
+	return priv->count > 0 && !loopback_recvfull(dev);
+}
+
+/****************************************************************************
+ * Name: loopback_send
+ ****************************************************************************/
+
+static void loopback_send(FAR struct uart_dev_s *dev, int ch)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+
+	priv->fifo[priv->head] = (uint8_t)ch;
+	priv->head = (priv->head + 1) & (LOOPBACK_FIFOSIZE - 1);
+	priv->count++;
+}
+
+/****************************************************************************
+ * Name: loopback_txint
+ ****************************************************************************/
+
+static void loopback_txint(FAR struct uart_dev_s *dev, bool enable)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+
+	priv->txint = enable;
+#ifndef CONFIG_SERIAL_TXDMA
+	if (enable) {
+		loopback_kick(dev);
+	}
+#endif
+}
+
+/****************************************************************************
+ * Name: loopback_txready
+ ****************************************************************************/
+
+static bool loopback_txready(FAR struct uart_dev_s *dev)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+
+	return priv->count < LOOPBACK_FIFOSIZE;
+}
+
+/****************************************************************************
+ * Name: loopback_txempty
+ ****************************************************************************/
+
+static bool loopback_txempty(FAR struct uart_dev_s *dev)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+
+	return priv->count == 0 && loopback_txidle(dev);
+}
+
+/****************************************************************************
+ * Name: loopback_dmareceive
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA
+static void loopback_dmareceive(FAR struct uart_dev_s *dev)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+
+	/* Pause while the receive buffer is full, until dmarxfree() */
+
+	priv->rxdma = dev->dmarx.length + dev->dmarx.nlength > 0;
+	if (priv->rxdma && priv->count > 0) {
+		loopback_kick(dev);
+	}
+}
+
+/****************************************************************************
+ * Name: loopback_dmarxfree
+ ****************************************************************************/
+
+static void loopback_dmarxfree(FAR struct uart_dev_s *dev)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+	irqstate_t flags;
+
+	flags = irqsave();
+	if (priv->rxint && !priv->rxdma) {
+		uart_recvchars_dma(dev);
+	}
+
+	irqrestore(flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: loopback_dmasend
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_TXDMA
+static void loopback_dmasend(FAR struct uart_dev_s *dev)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+
+	priv->txdma = true;
+	loopback_kick(dev);
+}
+
+/****************************************************************************
+ * Name: loopback_dmatxavail
+ ****************************************************************************/
+
+static void loopback_dmatxavail(FAR struct uart_dev_s *dev)
+{
+	FAR struct loopback_s *priv = (FAR struct loopback_s *)dev->priv;
+	irqstate_t flags;
+
+	flags = irqsave();
+	if (!priv->txdma) {
+		uart_xmitchars_dma(dev);
+	}
+
+	irqrestore(flags);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: uart_loopback_register
+ *
+ * Description:
+ *   Register /dev/ttyLB0, a serial device whose output is looped back to its
+ *   input.
+ *
+ ****************************************************************************/
+
+int uart_loopback_register(void)
+{
+	return uart_register("/dev/ttyLB0", &g_loopback_dev);
+}
+
+#endif							/* CONFIG_SERIAL_LOOPBACK */
@@ -80,6 +80,32 @@
 #define CONFIG_FS_NAIOC 8
 #endif
 
+/* Dedicated AIO threads */
+
+#ifdef CONFIG_FS_AIO_POOL
+#ifndef CONFIG_FS_AIO_POOL_NTHREADS
+#define CONFIG_FS_AIO_POOL_NTHREADS 2
+#endif
+
+#ifndef CONFIG_FS_AIO_POOL_PRIORITY
+#define CONFIG_FS_AIO_POOL_PRIORITY 100
+#endif
+
+#ifndef CONFIG_FS_AIO_POOL_STACKSIZE
+#define CONFIG_FS_AIO_POOL_STACKSIZE 2048
+#endif
+
+#ifndef CONFIG_FS_AIO_POOL_MERGESIZE
+#define CONFIG_FS_AIO_POOL_MERGESIZE 1024
+#endif
+
+/* Operations of the AIO containers */
+
+#define AIO_OP_READ     1
+#define AIO_OP_WRITE    2
+#define AIO_OP_FSYNC    3
+#endif
+
 #undef AIO_HAVE_FILEP
 
 #if CONFIG_NFILE_DESCRIPTORS > 0
@@ -110,6 +136,9 @@ struct aio_container_s {
 	} u;
 	struct work_s aioc_work;	/* Used to defer I/O to the work thread */
 	pid_t aioc_pid;				/* ID of the waiting task */
+#ifdef CONFIG_FS_AIO_POOL
+	uint8_t aioc_op;			/* AIO_OP_* operation to perform */
+#endif
 #ifdef CONFIG_PRIORITY_INHERITANCE
 	uint8_t aioc_prio;			/* Priority of the waiting task */
 #endif
@@ -250,7 +279,8 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Schedule the asynchronous I/O on the low priority work queue or, with
+ *   CONFIG_FS_AIO_POOL, on the dedicated AIO threads
  *
  * Input Parameters:
  *   arg - Worker argument.  In this case, a pointer to an instance of
@@ -264,6 +294,27 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
 
 int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
 
+/****************************************************************************
+ * Name: aio_pool_submit
+ *
+ * Description:
+ *   Hand the asynchronous I/O to the AIO threads, starting them on the
+ *   first call.  The threads perform the operation given by aioc->aioc_op;
+ *   'worker' only marks the container as queued.
+ *
+ * Input Parameters:
+ *   aioc   - The AIO container, already on the list of pending I/O
+ *   worker - The work queue worker of the operation
+ *
+ * Returned Value:
+ *   Zero (OK) on success.  Otherwise, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_AIO_POOL
+int aio_pool_submit(FAR struct aio_container_s *aioc, worker_t worker);
+#endif
+
 /****************************************************************************
  * Name: aio_signal
  *
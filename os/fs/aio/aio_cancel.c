@@ -88,6 +88,28 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: aio_cancelwork
+ *
+ * Description:
+ *   Remove the I/O of a pending container from the queue it waits on.
+ *   Returns -ENOENT if the I/O has already started.
+ *
+ ****************************************************************************/
+
+static inline int aio_cancelwork(FAR struct aio_container_s *aioc)
+{
+#ifdef CONFIG_FS_AIO_POOL
+	/* The AIO threads take the containers off the pending list before they
+	 * start the I/O, so any container still on the list can be cancelled.
+	 */
+
+	return OK;
+#else
+	return work_cancel(LPWORK, &aioc->aioc_work);
+#endif
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -170,7 +192,7 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
 				 * first case.
 				 */
 
-				status = work_cancel(LPWORK, &aioc->aioc_work);
+				status = aio_cancelwork(aioc);
 				if (status >= 0) {
 					aiocbp->aio_result = -ECANCELED;
 					ret = AIO_CANCELED;
@@ -205,7 +227,7 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
 				 * first case.
 				 */
 
-				status = work_cancel(LPWORK, &aioc->aioc_work);
+				status = aio_cancelwork(aioc);
 
 				/* Remove the container from the list of pending transfers */
 
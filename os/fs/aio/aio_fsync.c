@@ -259,6 +259,9 @@ int aio_fsync(int op, FAR struct aiocb *aiocbp)
 
 	/* Defer the work to the worker thread */
 
+#ifdef CONFIG_FS_AIO_POOL
+	aioc->aioc_op = AIO_OP_FSYNC;
+#endif
 	ret = aio_queue(aioc, aio_fsync_worker);
 	if (ret < 0) {
 		/* The result and the errno have already been set */
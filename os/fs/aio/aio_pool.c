@@ -0,0 +1,447 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sched.h>
+#include <aio.h>
+#include <fcntl.h>
+#include <string.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/fs/fs.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/kthread.h>
+#include <tinyara/semaphore.h>
+
+#include "aio/aio.h"
+
+#ifdef CONFIG_FS_AIO_POOL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The most requests served by one merged transfer */
+
+#define AIO_POOL_MAXGROUP 8
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The requests taken by an AIO thread for one transfer.  They all go to the
+ * same file and, if more than one, are adjacent reads or writes.
+ */
+
+struct aio_group_s {
+	FAR struct file *filep;		/* The file of all requests */
+	uint8_t op;					/* AIO_OP_* operation of all requests */
+	uint8_t nreqs;				/* Number of requests in the group */
+	off_t offset;				/* File offset of the first request */
+	size_t nbytes;				/* Total length of the requests */
+	FAR struct aiocb *aiocbp[AIO_POOL_MAXGROUP];
+	pid_t pid[AIO_POOL_MAXGROUP];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The file each AIO thread is working on, NULL if none.  A request is not
+ * started while another thread works on its file, which keeps the requests
+ * of each file in order.  Protected by aio_lock().
+ */
+
+static FAR struct file *g_aio_busy[CONFIG_FS_AIO_POOL_NTHREADS];
+
+/* Idle AIO threads wait on this semaphore */
+
+static sem_t g_aio_idlesem;
+static uint8_t g_aio_nidle;
+
+/* Number of AIO threads started */
+
+static uint8_t g_aio_nthreads;
+static bool g_aio_started;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_pool_ready
+ *
+ * Description:
+ *   Return true if the container has been queued and no other thread works
+ *   on its file.
+ *
+ ****************************************************************************/
+
+static bool aio_pool_ready(FAR struct aio_container_s *aioc)
+{
+	int i;
+
+	if (aioc->aioc_work.worker == NULL) {
+		return false;
+	}
+
+	for (i = 0; i < g_aio_nthreads; i++) {
+		if (g_aio_busy[i] == aioc->u.aioc_filep) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/****************************************************************************
+ * Name: aio_pool_wakeup
+ *
+ * Description:
+ *   Wake up an idle thread if there is a request it could start.
+ *
+ ****************************************************************************/
+
+static void aio_pool_wakeup(void)
+{
+	FAR struct aio_container_s *aioc;
+
+	if (g_aio_nidle == 0) {
+		return;
+	}
+
+	for (aioc = (FAR struct aio_container_s *)g_aio_pending.head; aioc; aioc = (FAR struct aio_container_s *)aioc->aioc_link.flink) {
+		if (aio_pool_ready(aioc)) {
+			g_aio_nidle--;
+			sem_post(&g_aio_idlesem);
+			return;
+		}
+	}
+}
+
+/****************************************************************************
+ * Name: aio_pool_add
+ *
+ * Description:
+ *   Add the request of a container to the group and release the container.
+ *
+ ****************************************************************************/
+
+static void aio_pool_add(FAR struct aio_group_s *group, FAR struct aio_container_s *aioc)
+{
+	group->pid[group->nreqs] = aioc->aioc_pid;
+	group->aiocbp[group->nreqs] = aioc_decant(aioc);
+	group->nreqs++;
+}
+
+/****************************************************************************
+ * Name: aio_pool_take
+ *
+ * Description:
+ *   Take the oldest request that may be started and the requests queued
+ *   after it which continue it on the same file, up to 'maxmerge' bytes.
+ *   Returns false if no request may be started.  Called with aio_lock()
+ *   held.
+ *
+ ****************************************************************************/
+
+static bool aio_pool_take(FAR struct aio_group_s *group, size_t maxmerge)
+{
+	FAR struct aio_container_s *aioc;
+	FAR struct aio_container_s *next;
+	FAR struct aiocb *aiocbp;
+
+	for (aioc = (FAR struct aio_container_s *)g_aio_pending.head; aioc; aioc = (FAR struct aio_container_s *)aioc->aioc_link.flink) {
+		if (aio_pool_ready(aioc)) {
+			break;
+		}
+	}
+
+	if (aioc == NULL) {
+		return false;
+	}
+
+	next = (FAR struct aio_container_s *)aioc->aioc_link.flink;
+	aiocbp = aioc->aioc_aiocbp;
+
+	group->filep = aioc->u.aioc_filep;
+	group->op = aioc->aioc_op;
+	group->offset = aiocbp->aio_offset;
+	group->nbytes = aiocbp->aio_nbytes;
+	group->nreqs = 0;
+	aio_pool_add(group, aioc);
+
+	/* Appending writes ignore the offsets and cannot be merged */
+
+	if ((group->op != AIO_OP_READ && group->op != AIO_OP_WRITE) ||
+		(group->filep->f_oflags & O_APPEND) != 0) {
+		return true;
+	}
+
+	/* Merge the requests which continue the first one.  Stop at the first
+	 * other request to the same file, it must not be passed.
+	 */
+
+	for (aioc = next; aioc && group->nreqs < AIO_POOL_MAXGROUP; aioc = next) {
+		next = (FAR struct aio_container_s *)aioc->aioc_link.flink;
+		if (aioc->u.aioc_filep != group->filep) {
+			continue;
+		}
+
+		aiocbp = aioc->aioc_aiocbp;
+		if (aioc->aioc_work.worker == NULL || aioc->aioc_op != group->op ||
+			aiocbp->aio_offset != group->offset + (off_t)group->nbytes ||
+			group->nbytes + aiocbp->aio_nbytes > maxmerge) {
+			break;
+		}
+
+		group->nbytes += aiocbp->aio_nbytes;
+		aio_pool_add(group, aioc);
+	}
+
+	return true;
+}
+
+/****************************************************************************
+ * Name: aio_pool_perform
+ *
+ * Description:
+ *   Perform the I/O of a group and signal the client of each request.  A
+ *   merged transfer goes through 'buffer'.
+ *
+ ****************************************************************************/
+
+static void aio_pool_perform(FAR struct aio_group_s *group, FAR char *buffer)
+{
+	FAR struct aiocb *aiocbp = group->aiocbp[0];
+	FAR char *data = (FAR char *)aiocbp->aio_buf;
+	ssize_t ret = ERROR;
+	size_t remaining;
+	size_t nbytes;
+	int i;
+
+	if (group->nreqs > 1) {
+		data = buffer;
+	}
+
+	switch (group->op) {
+	case AIO_OP_READ:
+		ret = file_pread(group->filep, data, group->nbytes, group->offset);
+		break;
+
+	case AIO_OP_WRITE:
+		if (group->nreqs > 1) {
+			for (i = 0, nbytes = 0; i < group->nreqs; i++) {
+				memcpy(buffer + nbytes, (FAR const void *)group->aiocbp[i]->aio_buf, group->aiocbp[i]->aio_nbytes);
+				nbytes += group->aiocbp[i]->aio_nbytes;
+			}
+		}
+
+		/* Check if O_APPEND is set in the file open flags */
+
+		if ((group->filep->f_oflags & O_APPEND) != 0) {
+			ret = file_write(group->filep, data, group->nbytes);
+		} else {
+			ret = file_pwrite(group->filep, data, group->nbytes, group->offset);
+		}
+		break;
+
+	case AIO_OP_FSYNC:
+		ret = file_fsync(group->filep);
+		break;
+
+	default:
+		set_errno(EINVAL);
+		break;
+	}
+
+	if (ret < 0) {
+		ret = -get_errno();
+		fdbg("ERROR: AIO operation %d failed: %d\n", group->op, (int)ret);
+	}
+
+	/* Split the result between the requests in their order in the file and
+	 * signal the clients.
+	 */
+
+	remaining = ret > 0 ? ret : 0;
+	for (i = 0, data = buffer; i < group->nreqs; i++) {
+		aiocbp = group->aiocbp[i];
+		if (ret < 0 || group->op == AIO_OP_FSYNC) {
+			aiocbp->aio_result = ret < 0 ? ret : OK;
+		} else {
+			nbytes = remaining < aiocbp->aio_nbytes ? remaining : aiocbp->aio_nbytes;
+			if (group->op == AIO_OP_READ && group->nreqs > 1) {
+				memcpy((FAR void *)aiocbp->aio_buf, data, nbytes);
+			}
+
+			aiocbp->aio_result = nbytes;
+			remaining -= nbytes;
+			data += aiocbp->aio_nbytes;
+		}
+
+		(void)aio_signal(group->pid[i], aiocbp);
+	}
+}
+
+/****************************************************************************
+ * Name: aio_pool_thread
+ *
+ * Description:
+ *   An AIO thread.  It serves the pending requests in order, skipping those
+ *   of files served by other threads, and waits when there is none left.
+ *
+ ****************************************************************************/
+
+static int aio_pool_thread(int argc, FAR char *argv[])
+{
+	struct aio_group_s group;
+	FAR char *buffer = NULL;
+	size_t maxmerge = 0;
+	int ndx;
+
+	/* Without a buffer, the requests are served one at a time */
+
+#if CONFIG_FS_AIO_POOL_MERGESIZE > 0
+	buffer = (FAR char *)kmm_malloc(CONFIG_FS_AIO_POOL_MERGESIZE);
+	if (buffer != NULL) {
+		maxmerge = CONFIG_FS_AIO_POOL_MERGESIZE;
+	}
+#endif
+
+	aio_lock();
+	ndx = g_aio_nthreads++;
+
+	for (;;) {
+		g_aio_busy[ndx] = NULL;
+		if (!aio_pool_take(&group, maxmerge)) {
+			/* Nothing to do.  Wait for aio_pool_wakeup() */
+
+			g_aio_nidle++;
+			aio_unlock();
+
+			while (sem_wait(&g_aio_idlesem) < 0) {
+				DEBUGASSERT(get_errno() == EINTR);
+			}
+
+			aio_lock();
+			continue;
+		}
+
+		/* Let an idle thread start on the next file, if any */
+
+		g_aio_busy[ndx] = group.filep;
+		aio_pool_wakeup();
+		aio_unlock();
+
+		aio_pool_perform(&group, buffer);
+
+		aio_lock();
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: aio_pool_start
+ *
+ * Description:
+ *   Start the AIO threads.  Called with aio_lock() held.
+ *
+ ****************************************************************************/
+
+static int aio_pool_start(void)
+{
+	int errcode;
+	int pid;
+	int i;
+
+	(void)sem_init(&g_aio_idlesem, 0, 0);
+	(void)sem_setprotocol(&g_aio_idlesem, SEM_PRIO_NONE);
+
+	for (i = 0; i < CONFIG_FS_AIO_POOL_NTHREADS; i++) {
+		pid = kernel_thread("aio", CONFIG_FS_AIO_POOL_PRIORITY, CONFIG_FS_AIO_POOL_STACKSIZE, aio_pool_thread, (FAR char *const *)NULL);
+		if (pid < 0) {
+			errcode = get_errno();
+			fdbg("ERROR: Failed to start AIO thread %d: %d\n", i, errcode);
+
+			/* Go on with the threads already started, if any */
+
+			if (i == 0) {
+				sem_destroy(&g_aio_idlesem);
+				return -errcode;
+			}
+
+			break;
+		}
+	}
+
+	g_aio_started = true;
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_pool_submit
+ *
+ * Description:
+ *   Hand the asynchronous I/O to the AIO threads, starting them on the
+ *   first call.  The threads perform the operation given by aioc->aioc_op;
+ *   'worker' only marks the container as queued.
+ *
+ * Input Parameters:
+ *   aioc   - The AIO container, already on the list of pending I/O
+ *   worker - The work queue worker of the operation
+ *
+ * Returned Value:
+ *   Zero (OK) on success.  Otherwise, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int aio_pool_submit(FAR struct aio_container_s *aioc, worker_t worker)
+{
+	int ret = OK;
+
+	DEBUGASSERT(aioc && worker);
+
+	aio_lock();
+	if (!g_aio_started) {
+		ret = aio_pool_start();
+	}
+
+	if (ret == OK) {
+		aioc->aioc_work.worker = worker;
+		aio_pool_wakeup();
+	}
+
+	aio_unlock();
+	return ret;
+}
+
+#endif							/* CONFIG_FS_AIO_POOL */
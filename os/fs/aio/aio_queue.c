@@ -91,7 +91,8 @@
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Schedule the asynchronous I/O on the low priority work queue or, with
+ *   CONFIG_FS_AIO_POOL, on the dedicated AIO threads
  *
  * Input Parameters:
  *   arg - Worker argument.  In this case, a pointer to an instance of
@@ -107,6 +108,21 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
 {
 	int ret;
 
+#ifdef CONFIG_FS_AIO_POOL
+	/* Hand the work to the AIO threads */
+
+	ret = aio_pool_submit(aioc, worker);
+	if (ret < 0) {
+		FAR struct aiocb *aiocbp = aioc_decant(aioc);
+		DEBUGASSERT(aiocbp);
+
+		aiocbp->aio_result = ret;
+		set_errno(-ret);
+		ret = ERROR;
+	}
+
+	return ret;
+#else
 #ifdef CONFIG_PRIORITY_INHERITANCE
 	/* Prohibit context switches until we complete the queuing */
 
@@ -136,6 +152,7 @@ int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
 	sched_unlock();
 #endif
 	return ret;
+#endif
 }
 
 #endif							/* CONFIG_FS_AIO */
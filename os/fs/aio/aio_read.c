@@ -289,6 +289,9 @@ int aio_read(FAR struct aiocb *aiocbp)
 
 	/* Defer the work to the worker thread */
 
+#ifdef CONFIG_FS_AIO_POOL
+	aioc->aioc_op = AIO_OP_READ;
+#endif
 	ret = aio_queue(aioc, aio_read_worker);
 	if (ret < 0) {
 		/* The result and the errno have already been set */
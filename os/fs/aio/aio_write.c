@@ -333,6 +333,9 @@ int aio_write(FAR struct aiocb *aiocbp)
 
 	/* Defer the work to the worker thread */
 
+#ifdef CONFIG_FS_AIO_POOL
+	aioc->aioc_op = AIO_OP_WRITE;
+#endif
 	ret = aio_queue(aioc, aio_write_worker);
 	if (ret < 0) {
 		/* The result and the errno have already been set */
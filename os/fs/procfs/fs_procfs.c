@@ -94,6 +94,7 @@
 
 extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations cpuload_operations;
+extern const struct procfs_operations profile_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
 
@@ -107,6 +108,7 @@ extern const struct procfs_operations smartfs_procfsoperations;
 extern const struct procfs_operations power_procfsoperations;
 extern const struct procfs_operations cm_operations;
 extern const struct procfs_operations irqs_operations;
+extern const struct procfs_operations serial_operations;
 extern const struct procfs_operations ereport_operations;
 
 /* And even worse, this one is specific to the STM32.  The solution to
@@ -149,6 +151,14 @@ static const struct procfs_entry_s g_procfsentries[] = {
 	{"power/domains**", &power_procfsoperations},
 #endif
 
+#if defined(CONFIG_SCHED_PROFILE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_PROFILE)
+	{"profile", &profile_operations},
+#endif
+
+#if defined(CONFIG_SERIAL_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SERIAL)
+	{"serial", &serial_operations},
+#endif
+
 #if !defined(CONFIG_FS_PROCFS_EXCLUDE_UPTIME)
 	{"uptime", &uptime_operations},
 #endif
@@ -0,0 +1,377 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * fs/procfs/fs_procfsprofile.c
+ *
+ * /proc/profile controls the PC sampling profiler of sched_profile.c and
+ * returns its histogram.  Writing "start", "stop" or "clear" starts,
+ * stops or resets the profiler.  Reading returns one line per thread and
+ * call chain:
+ *
+ *   <pid> <samples> <task name> <pc> [<return address> ...]
+ *
+ * after a '#' line with the sample counts.  tools/profile/profile_fold.py
+ * turns it into folded stacks.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/sched.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_SCHED_PROFILE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_PROFILE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#if CONFIG_TASK_NAME_SIZE > 0
+#define PROFILE_NAMELEN CONFIG_TASK_NAME_SIZE
+#else
+#define PROFILE_NAMELEN 1
+#endif
+
+#define PROFILE_LINELEN (64 + PROFILE_NAMELEN + 11 * CONFIG_SCHED_PROFILE_DEPTH)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct profile_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	char line[PROFILE_LINELEN];	/* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int profile_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int profile_close(FAR struct file *filep);
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+static ssize_t profile_write(FAR struct file *filep, FAR const char *buffer, size_t buflen);
+
+static int profile_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int profile_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations profile_operations = {
+	profile_open,				/* open */
+	profile_close,				/* close */
+	profile_read,				/* read */
+	profile_write,				/* write */
+
+	profile_dup,				/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	profile_stat				/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: profile_open
+ ****************************************************************************/
+
+static int profile_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct profile_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* "profile" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "profile") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct profile_file_s *)kmm_zalloc(sizeof(struct profile_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: profile_close
+ ****************************************************************************/
+
+static int profile_close(FAR struct file *filep)
+{
+	FAR struct profile_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct profile_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: profile_format
+ *
+ * Description:
+ *   Format one histogram entry.  The task name is looked up now, so it is
+ *   "-" for a thread which has exited since.
+ *
+ ****************************************************************************/
+
+static size_t profile_format(FAR char *line, FAR const struct sched_profile_entry_s *entry)
+{
+	FAR const char *name = "-";
+	size_t linesize;
+	char *ptr;
+	int i;
+#if CONFIG_TASK_NAME_SIZE > 0
+	char tmpname[CONFIG_TASK_NAME_SIZE + 1];
+	FAR struct tcb_s *tcb;
+	irqstate_t flags;
+
+	flags = irqsave();
+	tcb = sched_gettcb(entry->pid);
+	if (tcb != NULL && tcb->name[0] != '\0') {
+		strncpy(tmpname, tcb->name, CONFIG_TASK_NAME_SIZE);
+		tmpname[CONFIG_TASK_NAME_SIZE] = '\0';
+		name = tmpname;
+	}
+	irqrestore(flags);
+#endif
+
+	linesize = snprintf(line, PROFILE_LINELEN, "%d %u ", (int)entry->pid, (unsigned int)entry->count);
+
+	/* Keep the name one field: no blanks */
+
+	ptr = line + linesize;
+	for (; *name != '\0' && linesize < PROFILE_LINELEN - 1; name++, linesize++) {
+		*ptr++ = (*name == ' ' || *name == '\t') ? '_' : *name;
+	}
+
+	for (i = 0; i < entry->depth; i++) {
+		linesize += snprintf(line + linesize, PROFILE_LINELEN - linesize, " %08lx", (unsigned long)entry->pc[i]);
+	}
+
+	linesize += snprintf(line + linesize, PROFILE_LINELEN - linesize, "\n");
+	return linesize;
+}
+
+/****************************************************************************
+ * Name: profile_read
+ ****************************************************************************/
+
+static ssize_t profile_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct profile_file_s *attr;
+	struct sched_profile_status_s status;
+	struct sched_profile_entry_s entry;
+	size_t totalsize = 0;
+	size_t linesize;
+	size_t copysize;
+	off_t offset;
+	int index;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct profile_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* The whole text is regenerated on each read and the part before
+	 * f_pos skipped.  The histogram changes while the profiler runs, so
+	 * stop it before reading in several pieces.
+	 */
+
+	offset = filep->f_pos;
+
+	sched_profile_status(&status);
+	linesize = snprintf(attr->line, PROFILE_LINELEN, "# samples %u dropped %u entries %u depth %d %s\n",
+						(unsigned int)status.nsamples, (unsigned int)status.ndropped,
+						(unsigned int)status.nentries, CONFIG_SCHED_PROFILE_DEPTH,
+						status.running ? "running" : "stopped");
+	copysize = procfs_memcpy(attr->line, linesize, buffer, buflen, &offset);
+	totalsize += copysize;
+
+	for (index = 0; totalsize < buflen && sched_profile_get(index, &entry) == OK; index++) {
+		if (entry.count == 0) {
+			continue;
+		}
+
+		linesize = profile_format(attr->line, &entry);
+		copysize = procfs_memcpy(attr->line, linesize, buffer + totalsize, buflen - totalsize, &offset);
+		totalsize += copysize;
+	}
+
+	/* Update the file offset */
+
+	if (totalsize > 0) {
+		filep->f_pos += totalsize;
+	}
+
+	return totalsize;
+}
+
+/****************************************************************************
+ * Name: profile_write
+ ****************************************************************************/
+
+static ssize_t profile_write(FAR struct file *filep, FAR const char *buffer, size_t buflen)
+{
+	size_t len = buflen;
+	int ret = OK;
+
+	/* Ignore the line end "echo" adds */
+
+	while (len > 0 && (buffer[len - 1] == '\n' || buffer[len - 1] == '\r')) {
+		len--;
+	}
+
+	if (len == 5 && strncmp(buffer, "start", 5) == 0) {
+		ret = sched_profile_start();
+	} else if (len == 4 && strncmp(buffer, "stop", 4) == 0) {
+		sched_profile_stop();
+	} else if (len == 5 && strncmp(buffer, "clear", 5) == 0) {
+		sched_profile_clear();
+	} else {
+		fdbg("ERROR: Unknown command\n");
+		ret = -EINVAL;
+	}
+
+	return ret < 0 ? ret : buflen;
+}
+
+/****************************************************************************
+ * Name: profile_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int profile_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct profile_file_s *oldattr;
+	FAR struct profile_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct profile_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct profile_file_s *)kmm_malloc(sizeof(struct profile_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct profile_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: profile_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int profile_stat(const char *relpath, struct stat *buf)
+{
+	/* "profile" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "profile") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "profile" is the name for a read/write file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+#endif							/* CONFIG_SCHED_PROFILE && !CONFIG_FS_PROCFS_EXCLUDE_PROFILE */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
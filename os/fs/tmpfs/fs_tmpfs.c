@@ -63,6 +63,7 @@
 #include <fcntl.h>
 #include <dirent.h>
 #include <semaphore.h>
+#include <sched.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -87,6 +88,15 @@
 #  warning CONFIG_FS_TMPFS_FILE_FREEGUARD needs to be > ALLOCGUARD
 #endif
 
+#if defined(CONFIG_FS_TMPFS_CHUNKED) && \
+	CONFIG_FS_TMPFS_CHUNKSIZE < 16
+#  error CONFIG_FS_TMPFS_CHUNKSIZE is too small
+#endif
+
+#ifndef CONFIG_FS_TMPFS_CHUNKPOOL
+#  define CONFIG_FS_TMPFS_CHUNKPOOL 0
+#endif
+
 #define tmpfs_lock_file(tfo) \
 	(tmpfs_lock_object((FAR struct tmpfs_object_s *)tfo))
 #define tmpfs_lock_directory(tdo) \
@@ -96,6 +106,25 @@
 #define tmpfs_unlock_directory(tdo) \
 	(tmpfs_unlock_object((FAR struct tmpfs_object_s *)tdo))
 
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+/* The dedicated chunk pool is shared by all TMPFS instances.  Free chunks
+ * are linked through their first word.  The region is freed when no
+ * instance is mounted and all of its chunks are back in the pool.
+ */
+
+struct tmpfs_chunkpool_s {
+	FAR uint8_t *tcp_base;  /* Start of the pre-allocated region */
+	FAR uint8_t *tcp_end;   /* End of the pre-allocated region */
+	FAR void *tcp_free;     /* List of free chunks in the region */
+	uint8_t tcp_nmounts;    /* Number of TMPFS instances using the pool */
+	int tcp_nused;          /* Number of chunks taken from the region */
+};
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -111,6 +140,20 @@ static int  tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo,
 		unsigned int nentries);
 static int  tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
 		size_t newsize);
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+static FAR uint8_t *tmpfs_alloc_chunk(void);
+static void tmpfs_free_chunk(FAR uint8_t *chunk);
+static void tmpfs_pool_initialize(void);
+static FAR uint8_t *tmpfs_pool_detach(void);
+static void tmpfs_pool_release(void);
+static void tmpfs_release_data(FAR struct tmpfs_file_s *tfo);
+static void tmpfs_read_chunks(FAR struct tmpfs_file_s *tfo,
+		FAR char *buffer, off_t startpos, size_t nread);
+static ssize_t tmpfs_write_chunks(FAR struct tmpfs_file_s *tfo,
+		FAR const char *buffer, off_t startpos, size_t nwritten);
+#else
+#define tmpfs_release_data(tfo)
+#endif
 static void tmpfs_release_lockedobject(FAR struct tmpfs_object_s *to);
 static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo);
 static int  tmpfs_find_dirent(FAR struct tmpfs_directory_s *tdo,
@@ -210,6 +253,10 @@ const struct mountpt_operations tmpfs_operations = {
 	tmpfs_stat,       /* stat */
 };
 
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+static struct tmpfs_chunkpool_s g_tmpfs_pool;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -347,6 +394,19 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo,
 	if (newtdo == NULL) {
 		return -ENOMEM;
 	}
+	/* If the directory moved, so did its entries.  Adjust the backward
+	 * links of the objects in it.
+	 */
+
+	if (newtdo != oldtdo) {
+		int index;
+
+		for (index = 0; index < ret; index++) {
+			newtdo->tdo_entry[index].tde_object->to_dirent =
+				&newtdo->tdo_entry[index];
+		}
+	}
+
 	/* Adjust the reference in the parent directory entry */
 
 	DEBUGASSERT(newtdo->tdo_dirent);
@@ -372,6 +432,79 @@ static int tmpfs_realloc_directory(FAR struct tmpfs_directory_s **tdo,
  * Name: tmpfs_realloc_file
  ****************************************************************************/
 
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
+		size_t newsize)
+{
+	FAR struct tmpfs_file_s *tmptfo = *tfo;
+	FAR uint8_t **chunks;
+	unsigned int nchunks;
+	unsigned int newtab;
+	unsigned int index;
+	size_t offset;
+
+	nchunks = TMPFS_NCHUNKS(newsize);
+
+	if (newsize < tmptfo->tfo_size || newsize == 0) {
+		/* Shrinking ... Free the chunks beyond the new end of the file.  The
+		 * tail of the last chunk is cleared so that the file reads back as
+		 * zeros if it is extended again.
+		 */
+
+		for (index = nchunks; index < tmptfo->tfo_nchunks; index++) {
+			if (tmptfo->tfo_chunks[index] != NULL) {
+				tmpfs_free_chunk(tmptfo->tfo_chunks[index]);
+				tmptfo->tfo_chunks[index] = NULL;
+				tmptfo->tfo_alloc -= CONFIG_FS_TMPFS_CHUNKSIZE;
+			}
+		}
+
+		offset = newsize % CONFIG_FS_TMPFS_CHUNKSIZE;
+		if (offset > 0 && tmptfo->tfo_chunks[nchunks - 1] != NULL) {
+			memset(tmptfo->tfo_chunks[nchunks - 1] + offset, 0,
+				   CONFIG_FS_TMPFS_CHUNKSIZE - offset);
+		}
+
+		/* The chunk table itself is only released with the last chunk */
+
+		if (newsize == 0 && tmptfo->tfo_chunks != NULL) {
+			kmm_free(tmptfo->tfo_chunks);
+			tmptfo->tfo_alloc  -= tmptfo->tfo_nchunks * sizeof(FAR uint8_t *);
+			tmptfo->tfo_chunks  = NULL;
+			tmptfo->tfo_nchunks = 0;
+		}
+	} else if (nchunks > tmptfo->tfo_nchunks) {
+		/* Growing ... Only the chunk table is extended here.  Chunks are
+		 * allocated when they are first written.  Double the table so that
+		 * appending does not reallocate it on every chunk.
+		 */
+
+		newtab = tmptfo->tfo_nchunks << 1;
+		if (newtab < nchunks) {
+			newtab = nchunks;
+		}
+
+		chunks = (FAR uint8_t **)kmm_realloc(tmptfo->tfo_chunks,
+											 newtab * sizeof(FAR uint8_t *));
+		if (chunks == NULL) {
+			return -ENOMEM;
+		}
+
+		memset(&chunks[tmptfo->tfo_nchunks], 0,
+			   (newtab - tmptfo->tfo_nchunks) * sizeof(FAR uint8_t *));
+
+		tmptfo->tfo_alloc  += (newtab - tmptfo->tfo_nchunks) *
+							  sizeof(FAR uint8_t *);
+		tmptfo->tfo_chunks  = chunks;
+		tmptfo->tfo_nchunks = newtab;
+	}
+
+	/* The file object never moves */
+
+	tmptfo->tfo_size = newsize;
+	return OK;
+}
+#else
 static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
 		size_t newsize)
 {
@@ -429,6 +562,256 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
 	*tfo              = newtfo;
 	return OK;
 }
+#endif
+
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+/****************************************************************************
+ * Name: tmpfs_alloc_chunk
+ ****************************************************************************/
+
+static FAR uint8_t *tmpfs_alloc_chunk(void)
+{
+	FAR uint8_t *chunk;
+
+	/* Try the dedicated pool first */
+
+	sched_lock();
+	chunk = (FAR uint8_t *)g_tmpfs_pool.tcp_free;
+	if (chunk != NULL) {
+		g_tmpfs_pool.tcp_free = *(FAR void **)chunk;
+		g_tmpfs_pool.tcp_nused++;
+	}
+	sched_unlock();
+
+	/* Then fall back to the heap */
+
+	if (chunk == NULL) {
+		chunk = (FAR uint8_t *)kmm_malloc(CONFIG_FS_TMPFS_CHUNKSIZE);
+	}
+
+	return chunk;
+}
+
+/****************************************************************************
+ * Name: tmpfs_free_chunk
+ ****************************************************************************/
+
+static void tmpfs_free_chunk(FAR uint8_t *chunk)
+{
+	FAR uint8_t *region = NULL;
+
+	/* Chunks from the pool go back to the pool, the others to the heap.  A
+	 * file which was still open when the last instance was unmounted may
+	 * return the last chunk of the region.
+	 */
+
+	sched_lock();
+	if (chunk >= g_tmpfs_pool.tcp_base && chunk < g_tmpfs_pool.tcp_end) {
+		*(FAR void **)chunk   = g_tmpfs_pool.tcp_free;
+		g_tmpfs_pool.tcp_free = chunk;
+		g_tmpfs_pool.tcp_nused--;
+		region = tmpfs_pool_detach();
+		chunk  = NULL;
+	}
+	sched_unlock();
+
+	if (chunk != NULL) {
+		kmm_free(chunk);
+	}
+
+	if (region != NULL) {
+		kmm_free(region);
+	}
+}
+
+/****************************************************************************
+ * Name: tmpfs_pool_initialize
+ ****************************************************************************/
+
+static void tmpfs_pool_initialize(void)
+{
+#if CONFIG_FS_TMPFS_CHUNKPOOL > 0
+	FAR uint8_t *chunk;
+	bool ready;
+	int i;
+
+	/* The region may have outlived the last unmount */
+
+	sched_lock();
+	ready = g_tmpfs_pool.tcp_nmounts++ > 0 || g_tmpfs_pool.tcp_base != NULL;
+	sched_unlock();
+
+	if (ready) {
+		return;
+	}
+
+	/* Failing to set up the pool is not fatal.  All chunks then come from
+	 * the heap.
+	 */
+
+	g_tmpfs_pool.tcp_base = (FAR uint8_t *)
+		kmm_malloc(CONFIG_FS_TMPFS_CHUNKPOOL * CONFIG_FS_TMPFS_CHUNKSIZE);
+	if (g_tmpfs_pool.tcp_base == NULL) {
+		fdbg("ERROR: Failed to allocate the chunk pool\n");
+		return;
+	}
+
+	g_tmpfs_pool.tcp_end = g_tmpfs_pool.tcp_base +
+						   CONFIG_FS_TMPFS_CHUNKPOOL * CONFIG_FS_TMPFS_CHUNKSIZE;
+
+	for (i = CONFIG_FS_TMPFS_CHUNKPOOL - 1; i >= 0; i--) {
+		chunk = g_tmpfs_pool.tcp_base + i * CONFIG_FS_TMPFS_CHUNKSIZE;
+		*(FAR void **)chunk   = g_tmpfs_pool.tcp_free;
+		g_tmpfs_pool.tcp_free = chunk;
+	}
+#endif
+}
+
+/****************************************************************************
+ * Name: tmpfs_pool_detach
+ *
+ * Description:
+ *   Return the region of the pool, to be freed by the caller, if no TMPFS
+ *   instance is mounted and no chunk of the region is in use.  Called with
+ *   the scheduler locked.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *tmpfs_pool_detach(void)
+{
+	FAR uint8_t *region = g_tmpfs_pool.tcp_base;
+
+	if (region == NULL || g_tmpfs_pool.tcp_nmounts > 0 ||
+		g_tmpfs_pool.tcp_nused > 0) {
+		return NULL;
+	}
+
+	g_tmpfs_pool.tcp_base = NULL;
+	g_tmpfs_pool.tcp_end  = NULL;
+	g_tmpfs_pool.tcp_free = NULL;
+	return region;
+}
+
+/****************************************************************************
+ * Name: tmpfs_pool_release
+ ****************************************************************************/
+
+static void tmpfs_pool_release(void)
+{
+#if CONFIG_FS_TMPFS_CHUNKPOOL > 0
+	FAR uint8_t *region;
+
+	/* Files which were unlinked but are still open keep their chunks after
+	 * the last unmount.  The region is then freed by tmpfs_free_chunk()
+	 * when the last of them comes back.
+	 */
+
+	sched_lock();
+	g_tmpfs_pool.tcp_nmounts--;
+	region = tmpfs_pool_detach();
+	sched_unlock();
+
+	if (region != NULL) {
+		kmm_free(region);
+	}
+#endif
+}
+
+/****************************************************************************
+ * Name: tmpfs_release_data
+ ****************************************************************************/
+
+static void tmpfs_release_data(FAR struct tmpfs_file_s *tfo)
+{
+	/* Truncating to zero length frees all chunks and the chunk table */
+
+	(void)tmpfs_realloc_file(&tfo, 0);
+}
+
+/****************************************************************************
+ * Name: tmpfs_read_chunks
+ ****************************************************************************/
+
+static void tmpfs_read_chunks(FAR struct tmpfs_file_s *tfo,
+		FAR char *buffer, off_t startpos, size_t nread)
+{
+	FAR uint8_t *chunk;
+	unsigned int index;
+	size_t offset;
+	size_t ncopy;
+
+	while (nread > 0) {
+		index  = startpos / CONFIG_FS_TMPFS_CHUNKSIZE;
+		offset = startpos % CONFIG_FS_TMPFS_CHUNKSIZE;
+		ncopy  = CONFIG_FS_TMPFS_CHUNKSIZE - offset;
+		if (ncopy > nread) {
+			ncopy = nread;
+		}
+
+		/* Holes that were never written read back as zeros */
+
+		chunk = tfo->tfo_chunks[index];
+		if (chunk != NULL) {
+			memcpy(buffer, chunk + offset, ncopy);
+		} else {
+			memset(buffer, 0, ncopy);
+		}
+
+		buffer   += ncopy;
+		startpos += ncopy;
+		nread    -= ncopy;
+	}
+}
+
+/****************************************************************************
+ * Name: tmpfs_write_chunks
+ ****************************************************************************/
+
+static ssize_t tmpfs_write_chunks(FAR struct tmpfs_file_s *tfo,
+		FAR const char *buffer, off_t startpos, size_t nwritten)
+{
+	FAR uint8_t *chunk;
+	unsigned int index;
+	size_t offset;
+	size_t ncopy;
+	ssize_t ret = 0;
+
+	while (nwritten > 0) {
+		index  = startpos / CONFIG_FS_TMPFS_CHUNKSIZE;
+		offset = startpos % CONFIG_FS_TMPFS_CHUNKSIZE;
+		ncopy  = CONFIG_FS_TMPFS_CHUNKSIZE - offset;
+		if (ncopy > nwritten) {
+			ncopy = nwritten;
+		}
+
+		chunk = tfo->tfo_chunks[index];
+		if (chunk == NULL) {
+			chunk = tmpfs_alloc_chunk();
+			if (chunk == NULL) {
+				return ret > 0 ? ret : -ENOMEM;
+			}
+
+			/* Clear whatever part of a new chunk is not written now */
+
+			if (ncopy < CONFIG_FS_TMPFS_CHUNKSIZE) {
+				memset(chunk, 0, CONFIG_FS_TMPFS_CHUNKSIZE);
+			}
+
+			tfo->tfo_chunks[index] = chunk;
+			tfo->tfo_alloc += CONFIG_FS_TMPFS_CHUNKSIZE;
+		}
+
+		memcpy(chunk + offset, buffer, ncopy);
+
+		buffer   += ncopy;
+		startpos += ncopy;
+		nwritten -= ncopy;
+		ret      += ncopy;
+	}
+
+	return ret;
+}
+#endif /* CONFIG_FS_TMPFS_CHUNKED */
 
 /****************************************************************************
  * Name: tmpfs_release_lockedobject
@@ -462,6 +845,7 @@ static void tmpfs_release_lockedfile(FAR struct tmpfs_file_s *tfo)
 
 	if (tfo->tfo_refs == 1 && (tfo->tfo_flags & TFO_FLAG_UNLINKED) != 0) {
 		sem_destroy(&tfo->tfo_exclsem.ts_sem);
+		tmpfs_release_data(tfo);
 		kmm_free(tfo);
 	}
 
@@ -617,6 +1001,10 @@ static FAR struct tmpfs_file_s *tmpfs_alloc_file(void)
 	tfo->tfo_refs  = 1;
 	tfo->tfo_flags = 0;
 	tfo->tfo_size  = 0;
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+	tfo->tfo_nchunks = 0;
+	tfo->tfo_chunks  = NULL;
+#endif
 
 	tfo->tfo_exclsem.ts_holder = getpid();
 	tfo->tfo_exclsem.ts_count  = 1;
@@ -1199,6 +1587,8 @@ static int tmpfs_free_callout(FAR struct tmpfs_directory_s *tdo,
 			tfo->tfo_flags |= TFO_FLAG_UNLINKED;
 			return TMPFS_UNLINKED;
 		}
+
+		tmpfs_release_data(tfo);
 	}
 
 	/* Free the object now */
@@ -1448,6 +1838,7 @@ static int tmpfs_close(FAR struct file *filep)
 		 * have any other references.
 		 */
 
+		tmpfs_release_data(tfo);
 		kmm_free(tfo);
 		return OK;
 	}
@@ -1488,14 +1879,20 @@ static ssize_t tmpfs_read(FAR struct file *filep, FAR char *buffer,
 	nread    = buflen;
 	endpos   = startpos + buflen;
 
-	if (endpos > tfo->tfo_size) {
+	if (startpos >= tfo->tfo_size) {
+		nread  = 0;
+	} else if (endpos > tfo->tfo_size) {
 		endpos = tfo->tfo_size;
 		nread  = endpos - startpos;
 	}
 
 	/* Copy data from the memory object to the user buffer */
 
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+	tmpfs_read_chunks(tfo, buffer, startpos, nread);
+#else
 	memcpy(buffer, &tfo->tfo_data[startpos], nread);
+#endif
 	filep->f_pos += nread;
 
 	/* Release the lock on the file */
@@ -1515,6 +1912,7 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
 	ssize_t nwritten;
 	off_t startpos;
 	off_t endpos;
+	size_t oldsize;
 	int ret;
 
 	fvdbg("filep: %p buffer: %p buflen: %lu\n",
@@ -1534,6 +1932,7 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
 	startpos = filep->f_pos;
 	nwritten = buflen;
 	endpos   = startpos + buflen;
+	oldsize  = tfo->tfo_size;
 
 	if (endpos > tfo->tfo_size) {
 		/* Reallocate the file to handle the write past the end of the file. */
@@ -1545,9 +1944,32 @@ static ssize_t tmpfs_write(FAR struct file *filep, FAR const char *buffer,
 		filep->f_priv = tfo;
 	}
 
-	/* Copy data from the memory object to the user buffer */
+	/* Copy data from the user buffer to the memory object */
+
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+	nwritten = tmpfs_write_chunks(tfo, buffer, startpos, buflen);
+	if (nwritten < (ssize_t)buflen && endpos > oldsize) {
+		/* Out of memory for chunks.  Don't extend the file beyond what
+		 * was actually written.
+		 */
+
+		endpos = nwritten > 0 ? startpos + nwritten : 0;
+		(void)tmpfs_realloc_file(&tfo, endpos > oldsize ? endpos : oldsize);
+	}
+
+	if (nwritten < 0) {
+		ret = nwritten;
+		goto errout_with_lock;
+	}
+#else
+	/* A write beyond the end of the file leaves a gap that reads as zeros */
+
+	if (startpos > oldsize) {
+		memset(&tfo->tfo_data[oldsize], 0, startpos - oldsize);
+	}
 
 	memcpy(&tfo->tfo_data[startpos], buffer, nwritten);
+#endif
 	filep->f_pos += nwritten;
 
 	/* Release the lock on the file */
@@ -1643,7 +2065,19 @@ static int tmpfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 		 * the file.
 		 */
 
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+		/* Only a file held in a single chunk is contiguous in memory */
+
+		if (tfo->tfo_size > CONFIG_FS_TMPFS_CHUNKSIZE ||
+			tfo->tfo_chunks == NULL || tfo->tfo_chunks[0] == NULL) {
+			fdbg("ERROR: File is not contiguous\n");
+			return -ENOTTY;
+		}
+
+		*ppv = (FAR void *)tfo->tfo_chunks[0];
+#else
 		*ppv = (FAR void *)tfo->tfo_data;
+#endif
 		return OK;
 	}
 
@@ -1916,6 +2350,10 @@ static int tmpfs_bind(FAR struct inode *blkdriver, FAR const void *data,
 	fs->tfs_exclsem.ts_count  = 0;
 	sem_init(&fs->tfs_exclsem.ts_sem, 0, 1);
 
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+	tmpfs_pool_initialize();
+#endif
+
 	/* Return the new file system handle */
 
 	*handle = (FAR void *)fs;
@@ -1950,6 +2388,10 @@ static int tmpfs_unbind(FAR void *handle, FAR struct inode **blkdriver)
 
 	sem_destroy(&fs->tfs_exclsem.ts_sem);
 	kmm_free(fs);
+
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+	tmpfs_pool_release();
+#endif
 	return ret;
 }
 
@@ -2094,6 +2536,7 @@ static int tmpfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
 
 	else {
 		sem_destroy(&tfo->tfo_exclsem.ts_sem);
+		tmpfs_release_data(tfo);
 		kmm_free(tfo);
 	}
 
@@ -174,10 +174,25 @@ struct tmpfs_file_s {
 
 	uint8_t  tfo_flags;    /* See TFO_FLAG_* definitions */
 	size_t   tfo_size;     /* Valid file size */
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+	unsigned int tfo_nchunks;  /* Number of entries in tfo_chunks[] */
+	FAR uint8_t **tfo_chunks;  /* File data chunks, NULL for holes */
+#else
 	uint8_t  tfo_data[1];  /* File data starts here */
+#endif
 };
 
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+/* With the chunked layout the file data lives in separately allocated,
+ * fixed-size chunks so the file object itself never grows.
+ */
+
+#define SIZEOF_TMPFS_FILE(n) (sizeof(struct tmpfs_file_s))
+#define TMPFS_NCHUNKS(n) \
+	(((n) + CONFIG_FS_TMPFS_CHUNKSIZE - 1) / CONFIG_FS_TMPFS_CHUNKSIZE)
+#else
 #define SIZEOF_TMPFS_FILE(n) (sizeof(struct tmpfs_file_s) + (n) - 1)
+#endif
 
 /* This structure represents one instance of a TMPFS file system */
 
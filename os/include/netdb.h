@@ -137,8 +137,12 @@ typedef enum {
 	DHCPDSTART,
 	DHCPDSTOP,
 	DHCPDSTATUS,
+	DHCPCREBOOT,
+	DHCPCLEASE,
 } req_type;
 
+struct dhcpc_lease;
+
 /* To send a request to lwip stack by ioctl() use */
 struct req_lwip_data {
 	req_type type;
@@ -157,6 +161,7 @@ struct req_lwip_data {
 	int flags;
 	u8_t num_dns;
 	ip_addr_t *dns_server;
+	struct dhcpc_lease *lease;
 };
 //#endif // CONFIG_NET_NETMGR
 #endif
@@ -170,6 +170,22 @@ struct msghdr {
 */
 int socket(int domain, int type, int protocol);
 
+/**
+* @brief creates a pair of connected sockets.
+*
+* @details @b #include <sys/socket.h>\n
+* SYSTEM CALL API\n
+* POSIX API (refer to : http://pubs.opengroup.org/onlinepubs/9699919799/)\n
+* Only AF_UNIX SOCK_STREAM sockets are supported, with CONFIG_NET_LOCAL_STREAM_DIRECT.
+* @param[in] domain the communications domain, AF_UNIX.
+* @param[in] type  the type of the sockets, SOCK_STREAM
+* @param[in] protocol the protocol to be used with the sockets, 0
+* @param[out] sv the file descriptors of the two sockets
+* @return On success, 0 is returned. On failure, -1 is returned.
+* @since TizenRT v3.1
+*/
+int socketpair(int domain, int type, int protocol, int sv[2]);
+
 /**
 * @brief  assigns an address to an unnamed socket.
 *
@@ -469,7 +469,8 @@
 #define SYS_setsockopt                 (__SYS_network + 12)
 #define SYS_shutdown                   (__SYS_network + 13)
 #define SYS_socket                     (__SYS_network + 14)
-#define __SYS_prctl                    (__SYS_network + 15)
+#define SYS_socketpair                 (__SYS_network + 15)
+#define __SYS_prctl                    (__SYS_network + 16)
 #else
 #define __SYS_prctl                    __SYS_network
 #endif
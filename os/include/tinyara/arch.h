@@ -1317,6 +1317,29 @@ int up_shmat(FAR uintptr_t *pages, unsigned int npages, uintptr_t vaddr);
 int up_shmdt(uintptr_t vaddr, unsigned int npages);
 #endif
 
+/****************************************************************************
+ * Name: up_profile_backtrace
+ *
+ * Description:
+ *   Called from the timer interrupt by the PC sampling profiler.  Return
+ *   the program counter the interrupt stopped at in pcs[0] and, where the
+ *   frames of the interrupted code can be walked, the return addresses of
+ *   its callers in pcs[1..depth-1].
+ *
+ * Input Parameters:
+ *   pcs   - Receives the program counters
+ *   depth - Size of pcs[]
+ *
+ * Returned Value:
+ *   The number of program counters stored, zero if not called from an
+ *   interrupt.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_PROFILE
+int up_profile_backtrace(FAR uintptr_t *pcs, int depth);
+#endif
+
 /****************************************************************************
  * Name: up_interrupt_context
  *
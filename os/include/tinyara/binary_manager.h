@@ -108,6 +108,15 @@ enum binmgr_response_result_type {
 /****************************************************************************
  * Public Data
  ****************************************************************************/
+/* The structure of the time spent in each phase of the last load of a binary, in msec */
+struct binary_load_time_s {
+	uint32_t verify;			/* Reading the headers and checking the CRC of the partitions */
+	uint32_t wait;				/* Waiting for a loader after verification (pipelined loading) */
+	uint32_t load;				/* Reading, decompressing and relocating the ELF */
+	uint32_t start;				/* Creating and starting the main task */
+};
+typedef struct binary_load_time_s binary_load_time_t;
+
 /* The structure of binary update information */
 struct binary_update_info_s {
 	int inactive_partsize;
@@ -115,6 +124,7 @@ struct binary_update_info_s {
 	char active_ver[BIN_VERSION_MAX];
 	char active_dev[BINMGR_DEVNAME_LEN];
 	char inactive_dev[BINMGR_DEVNAME_LEN];
+	binary_load_time_t load_time;
 };
 typedef struct binary_update_info_s binary_update_info_t;
 
@@ -137,6 +147,7 @@ struct load_attr_s {
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
 	void *binp;			/* Binary info pointer */
 #endif
+	binary_load_time_t *load_time;	/* If not NULL, load_binary() records the load and start time */
 };
 typedef struct load_attr_s load_attr_t;
 
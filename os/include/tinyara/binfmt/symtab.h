@@ -106,6 +106,60 @@ void exec_getsymtab(FAR const struct symtab_s **symtab, FAR int *nsymbols);
 
 void exec_setsymtab(FAR const struct symtab_s *symtab, int nsymbols);
 
+#ifdef CONFIG_SYMTAB_PERFECTHASH
+/* The exported symbol table and its perfect hash index.  They are generated
+ * into binfmt/binfmt_symtab.c at build time.
+ */
+
+EXTERN const struct symtab_hash_s g_symtab_hash;
+
+/****************************************************************************
+ * Name: exec_sethashtab
+ *
+ * Description:
+ *   Register the perfect hash index generated by tools/mksymtab -p for an
+ *   exported symbol table.  The loaders use it instead of searching by name
+ *   whenever they bind against the symbol table that it indexes.
+ *
+ * Input Parameters:
+ *   hash - The perfect hash index or NULL to remove it.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void exec_sethashtab(FAR const struct symtab_hash_s *hash);
+
+/****************************************************************************
+ * Name: exec_gethashtab
+ *
+ * Description:
+ *   Get the perfect hash index registered by exec_sethashtab().
+ *
+ * Returned Value:
+ *   The registered index or NULL if there is none.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_hash_s *exec_gethashtab(void);
+
+/****************************************************************************
+ * Name: exec_findsymbol
+ *
+ * Description:
+ *   Find an exported symbol by name, using the registered perfect hash index
+ *   if it indexes 'exports' or a search of 'exports' otherwise.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *exec_findsymbol(FAR const struct symtab_s *exports, int nexports, FAR const char *name);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -344,6 +344,22 @@
 											 *       (default)
 											 *     1=fre when empty
 											 * OUT: None */
+#define PIPEIOC_GETSIZE    _PIPEIOC(0x0002)	/* Get the size of the ring buffer
+											 * IN: Pointer to size_t
+											 * OUT: Size in bytes */
+#define PIPEIOC_SETSIZE    _PIPEIOC(0x0003)	/* Resize the ring buffer
+											 * IN: unsigned long integer,
+											 *     rounded up to a power of
+											 *     two, no smaller than the
+											 *     buffered data and at most
+											 *     CONFIG_DEV_PIPE_MAXSIZE
+											 * OUT: None */
+#define PIPEIOC_SPLICE     _PIPEIOC(0x0004)	/* Move data between the pipe
+											 * and a file or socket
+											 * IN: Pointer to struct
+											 *     pipe_splice_s (see
+											 *     tinyara/pipe.h)
+											 * OUT: Bytes moved */
 /* RTC driver ioctl definitions *********************************************/
 /* (see include/tinyara/rtc.h */
 
@@ -53,6 +53,18 @@
 
 /* IOCTL commands ***********************************************************/
 
+/* Take a reference to the scan result whose header was just read and
+ * dequeue it, instead of read()ing a private copy of it.
+ * arg: lwnl_scan_buf * which receives the shared buffer
+ */
+#define LWNLIOC_GETSCAN _LWNLIOC(0x0001)
+
+/* Drop the reference taken by LWNLIOC_GETSCAN on the same file, the
+ * references still held are dropped when the file is closed.
+ * arg: lwnl_scan_buf * filled by LWNLIOC_GETSCAN
+ */
+#define LWNLIOC_PUTSCAN _LWNLIOC(0x0002)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -105,6 +117,7 @@ typedef enum {
 	LWNL_SOFTAP_STA_LEFT,
 	LWNL_SCAN_DONE,
 	LWNL_SCAN_FAILED,
+	LWNL_SCAN_PARTIAL,	/* results of the channels scanned so far, LWNL_SCAN_DONE follows */
 	LWNL_EXIT,
 	LWNL_UNKNOWN,
 } lwnl_cb_status;
@@ -116,6 +129,13 @@ typedef struct {
 	bool md;
 } lwnl_cb_data;
 
+/* Scan result shared by every listener, an array of trwifi_ap_scan_info_s.
+ * It's read-only and stays valid until LWNLIOC_PUTSCAN */
+typedef struct {
+	const void *data;
+	uint32_t data_len;
+} lwnl_scan_buf;
+
 struct lwnl_lowerhalf_s;
 struct lwnl_upperhalf_s;
 
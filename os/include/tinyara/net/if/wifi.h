@@ -6,6 +6,9 @@
 #define TRWIFI_SSID_LEN				  32
 #define TRWIFI_PASSPHRASE_LEN		  64
 
+/* trwifi_info.capability flags */
+#define TRWIFI_CAP_JOIN_BSSID		  0x01	/* connect_ap() joins trwifi_ap_config_s.bssid on .channel */
+
 typedef enum {
 	TRWIFI_FAIL = -1,
 	TRWIFI_SUCCESS,
@@ -67,6 +70,8 @@ typedef struct {
 	unsigned int passphrase_length;					/**<  ap passphrase length				 */
 	trwifi_ap_auth_type_e ap_auth_type;			 /**<  @ref trwifi_ap_auth_type		   */
 	trwifi_ap_crypto_type_e ap_crypto_type;		 /**<  @ref trwifi_ap_crypto_type	   */
+	unsigned char bssid[TRWIFI_MACADDR_STR_LEN + 1];	/**<  optional, AP to join (xx:xx:xx:xx:xx:xx), empty for any */
+	unsigned int channel;							/**<  optional, channel of bssid, 0 if unknown */
 } trwifi_ap_config_s;
 
 typedef struct {
@@ -102,6 +107,7 @@ typedef struct {
 	unsigned char mac_address[TRWIFI_MACADDR_LEN];		/**<  MAC address of wifi interface				*/
 	int rssi;											   /**<	 Receive Signal Strength Indication in dBm */
 	trwifi_status_e wifi_status;						/**<  @ref trwifi_status					 */
+	unsigned int capability;							/**<  optional, TRWIFI_CAP_* flags, 0 if not reported */
 } trwifi_info;
 
 struct netdev;
@@ -0,0 +1,67 @@
+/****************************************************************************
+ *
+ * Copyright 2017 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * include/tinyara/pipe.h
+ *
+ * Argument of the pipe/FIFO ioctl commands, see PIPEIOC_* in
+ * tinyara/fs/ioctl.h
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_TINYARA_PIPE_H
+#define __INCLUDE_TINYARA_PIPE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <sys/types.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* pipe_splice_s ps_flags values */
+
+#define PIPE_SPLICE_FROMPIPE 0			/* Move the data out of the pipe into ps_fd */
+#define PIPE_SPLICE_TOPIPE   (1 << 0)	/* Move the data read from ps_fd into the pipe */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* PIPEIOC_SPLICE moves up to ps_len bytes between the ring buffer of the
+ * pipe and a file or socket descriptor, without an intermediate user buffer.
+ * It waits like read() (or write()) on the pipe when it is empty (or full)
+ * unless O_NONBLOCK is set, then copies what is available with at most two
+ * calls of the driver or the socket of ps_fd.  While those run, only the
+ * readers (or writers) of the pipe wait for the splice, and PIPEIOC_SETSIZE
+ * fails with EBUSY.  The ioctl returns the number of bytes moved, 0 at the
+ * end of file of the source, or a negated errno.
+ */
+
+struct pipe_splice_s {
+	int ps_fd;					/* File or socket descriptor at the other end */
+	size_t ps_len;				/* Maximum number of bytes to move */
+	uint8_t ps_flags;			/* See PIPE_SPLICE_* definitions */
+};
+
+#endif							/* __INCLUDE_TINYARA_PIPE_H */
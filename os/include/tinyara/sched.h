@@ -752,6 +752,29 @@ struct stkmon_save_s {
 };
 
 void stkmon_copy_log(struct stkmon_save_s *dest_arr);
+
+#ifdef CONFIG_SCHED_PROFILE
+/* One histogram entry of the PC sampling profiler: the number of samples
+ * taken in a thread with the same call chain.  pc[0] is the interrupted
+ * program counter, pc[1..depth-1] the return addresses of its callers.
+ */
+
+struct sched_profile_entry_s {
+	pid_t pid;
+	uint8_t depth;
+	uint32_t count;
+	uintptr_t pc[CONFIG_SCHED_PROFILE_DEPTH];
+};
+
+/* State of the profiler as returned by sched_profile_status() */
+
+struct sched_profile_status_s {
+	bool running;
+	uint16_t nentries;       /* Entries in use */
+	uint32_t nsamples;       /* Samples taken */
+	uint32_t ndropped;       /* Samples that found no free entry */
+};
+#endif
 /* 
  * }
  * @endcond
@@ -853,6 +876,14 @@ void sched_clear_cpuload_snapshot(void);
 void sched_get_cpuload_snapshot(pid_t *result_addr);
 #endif
 
+#ifdef CONFIG_SCHED_PROFILE
+int sched_profile_start(void);
+void sched_profile_stop(void);
+void sched_profile_clear(void);
+void sched_profile_status(FAR struct sched_profile_status_s *status);
+int sched_profile_get(int index, FAR struct sched_profile_entry_s *entry);
+#endif
+
 /********************************************************************************
  * Name: task_starthook
  *
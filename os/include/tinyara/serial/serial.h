@@ -126,6 +126,32 @@
 	(dev->ops->rxflowcontrol && dev->ops->rxflowcontrol(dev, n, u))
 #endif
 
+/* The DMA methods are optional.  A lower half without them is driven by the
+ * TX and RX interrupts only, as without CONFIG_SERIAL_TXDMA/RXDMA.
+ */
+
+#ifdef CONFIG_SERIAL_TXDMA
+#define uart_dmasend(dev) \
+	do { if (dev->ops->dmasend) { dev->ops->dmasend(dev); } } while (0)
+#define uart_dmatxavail(dev) \
+	do { if (dev->ops->dmatxavail) { dev->ops->dmatxavail(dev); } } while (0)
+#endif
+
+#ifdef CONFIG_SERIAL_RXDMA
+#define uart_dmareceive(dev) \
+	do { if (dev->ops->dmareceive) { dev->ops->dmareceive(dev); } } while (0)
+#define uart_dmarxfree(dev) \
+	do { if (dev->ops->dmarxfree) { dev->ops->dmarxfree(dev); } } while (0)
+#endif
+
+#if defined(CONFIG_SERIAL_TXDMA) || defined(CONFIG_SERIAL_RXDMA)
+#define CONFIG_SERIAL_DMA 1
+#endif
+
+#ifndef CONFIG_SERIAL_STATS_PATHLEN
+#define CONFIG_SERIAL_STATS_PATHLEN 16
+#endif
+
 /************************************************************************************
  * Public Types
  ************************************************************************************/
@@ -143,9 +169,38 @@ struct uart_buffer_s {
 	FAR char *buffer;			/* Pointer to the allocated buffer memory */
 };
 
+/* This structure describes one DMA transfer between the lower half and a serial
+ * I/O buffer.  The free or the pending part of the circular buffer may wrap, so
+ * it is given as up to two contiguous segments.  The upper half sets up the
+ * segments, the lower half moves the data and reports the number of bytes
+ * transferred in 'nbytes'.
+ */
+
+#ifdef CONFIG_SERIAL_DMA
+struct uart_dmaxfer_s {
+	FAR char *buffer;			/* First segment */
+	FAR char *nbuffer;			/* Second segment, at the start of the buffer */
+	size_t length;				/* Length of the first segment */
+	size_t nlength;				/* Length of the second segment */
+	size_t nbytes;				/* Bytes actually transferred */
+};
+#endif
+
+/* Throughput counters of one serial device, reported by /proc/serial */
+
+#ifdef CONFIG_SERIAL_STATS
+struct uart_stats_s {
+	uint32_t txbytes;			/* Bytes taken from xmit.buffer by the lower half */
+	uint32_t rxbytes;			/* Bytes added to recv.buffer by the lower half */
+	uint32_t rxdropped;			/* Bytes lost because recv.buffer was full */
+	uint32_t txcalls;			/* TX interrupts or DMA completions serviced */
+	uint32_t rxcalls;			/* RX interrupts or DMA completions serviced */
+};
+#endif
+
 /* This structure defines all of the operations providd by the architecture specific
  * logic.  All fields must be provided with non-NULL function pointers by the
- * caller of uart_register().
+ * caller of uart_register(), except rxflowcontrol and the DMA methods.
  */
 
 struct uart_dev_s;
@@ -234,6 +289,44 @@ struct uart_ops_s {
 	 */
 
 	CODE bool(*txempty)(FAR struct uart_dev_s *dev);
+
+#ifdef CONFIG_SERIAL_RXDMA
+	/* The RX DMA methods are provided together or not at all.
+	 *
+	 * Start receiving into the free segments described by dev->dmarx.  When
+	 * the transfer completes, or when the line has been idle for the RX
+	 * timeout of the hardware, the lower half sets dev->dmarx.nbytes and calls
+	 * uart_recvchars_done().  Both lengths are zero when recv.buffer is full;
+	 * the lower half then pauses until dmarxfree() is called.
+	 */
+
+	CODE void (*dmareceive)(FAR struct uart_dev_s *dev);
+
+	/* Called by the upper half when data was removed from recv.buffer.  A
+	 * lower half which paused on a full buffer restarts with
+	 * uart_recvchars_dma().
+	 */
+
+	CODE void (*dmarxfree)(FAR struct uart_dev_s *dev);
+#endif
+
+#ifdef CONFIG_SERIAL_TXDMA
+	/* The TX DMA methods are provided together or not at all.
+	 *
+	 * Start sending the segments described by dev->dmatx.  When the transfer
+	 * completes, the lower half sets dev->dmatx.nbytes and calls
+	 * uart_xmitchars_done().
+	 */
+
+	CODE void (*dmasend)(FAR struct uart_dev_s *dev);
+
+	/* Called by the upper half when data was added to xmit.buffer.  If no
+	 * transfer is in progress, the lower half starts one with
+	 * uart_xmitchars_dma().
+	 */
+
+	CODE void (*dmatxavail)(FAR struct uart_dev_s *dev);
+#endif
 };
 
 /* This is the device structure used by the driver.  The caller of
@@ -279,6 +372,13 @@ struct uart_dev_s {
 	struct uart_buffer_s xmit;	/* Describes transmit buffer */
 	struct uart_buffer_s recv;	/* Describes receive buffer */
 
+#ifdef CONFIG_SERIAL_TXDMA
+	struct uart_dmaxfer_s dmatx;	/* Describes the TX DMA transfer */
+#endif
+#ifdef CONFIG_SERIAL_RXDMA
+	struct uart_dmaxfer_s dmarx;	/* Describes the RX DMA transfer */
+#endif
+
 	/* Driver interface */
 
 	FAR const struct uart_ops_s *ops;	/* Arch-specific operations */
@@ -292,6 +392,12 @@ struct uart_dev_s {
 #ifndef CONFIG_DISABLE_POLL
 	struct pollfd *fds[CONFIG_SERIAL_NPOLLWAITERS];
 #endif
+
+#ifdef CONFIG_SERIAL_STATS
+	struct uart_stats_s stats;	/* Throughput counters */
+	FAR struct uart_dev_s *flink;	/* Next registered device */
+	char path[CONFIG_SERIAL_STATS_PATHLEN];	/* Path it was first registered at */
+#endif
 };
 
 typedef struct uart_dev_s uart_dev_t;
@@ -348,6 +454,61 @@ void uart_xmitchars(FAR uart_dev_t *dev);
 
 void uart_recvchars(FAR uart_dev_t *dev);
 
+/************************************************************************************
+ * Name: uart_xmitchars_dma
+ *
+ * Description:
+ *   Set up dev->dmatx with the data pending in the xmit buffer and start the
+ *   transfer with the dmasend() method.  Nothing is done if the buffer is empty.
+ *   Called by the lower half from dmatxavail() and after uart_xmitchars_done().
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_TXDMA
+void uart_xmitchars_dma(FAR uart_dev_t *dev);
+#endif
+
+/************************************************************************************
+ * Name: uart_xmitchars_done
+ *
+ * Description:
+ *   Remove the dev->dmatx.nbytes bytes sent by the lower half from the xmit
+ *   buffer and wake up the writers.  Called from the DMA completion interrupt.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_TXDMA
+void uart_xmitchars_done(FAR uart_dev_t *dev);
+#endif
+
+/************************************************************************************
+ * Name: uart_recvchars_dma
+ *
+ * Description:
+ *   Set up dev->dmarx with the free space of the recv buffer and start the
+ *   transfer with the dmareceive() method.  Called by the lower half when the
+ *   port is attached and after each uart_recvchars_done().
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA
+void uart_recvchars_dma(FAR uart_dev_t *dev);
+#endif
+
+/************************************************************************************
+ * Name: uart_recvchars_done
+ *
+ * Description:
+ *   Add the dev->dmarx.nbytes bytes received by the lower half to the recv
+ *   buffer and wake up the readers.  Called from the DMA completion or the RX
+ *   idle line interrupt.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA
+void uart_recvchars_done(FAR uart_dev_t *dev);
+#endif
+
 /************************************************************************************
  * Name: uart_datareceived
  *
@@ -397,6 +558,34 @@ void uart_datasent(FAR uart_dev_t *dev);
 void uart_connected(FAR uart_dev_t *dev, bool connected);
 #endif
 
+/************************************************************************************
+ * Name: uart_foreach
+ *
+ * Description:
+ *   Call 'handler' for each registered serial device until it returns non-zero.
+ *   Used by /proc/serial to report the throughput counters.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_STATS
+typedef int (*uart_foreach_t)(FAR uart_dev_t *dev, FAR void *arg);
+int uart_foreach(uart_foreach_t handler, FAR void *arg);
+#endif
+
+/************************************************************************************
+ * Name: uart_loopback_register
+ *
+ * Description:
+ *   Register /dev/ttyLB0, a serial device whose output is looped back to its
+ *   input through a software lower half.  It exercises the byte and the DMA paths
+ *   of the upper half without any UART hardware.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_LOOPBACK
+int uart_loopback_register(void);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
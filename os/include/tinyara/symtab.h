@@ -59,6 +59,8 @@
 
 #include <tinyara/config.h>
 
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -86,6 +88,23 @@ struct symtab_s {
 	FAR const void *sym_value;	/* The value associated witht the string */
 };
 
+/* struct symtab_hash_s is a minimal perfect hash index over a symbol table,
+ * generated at build time by tools/mksymtab -p.  The symbol table entries
+ * are placed so that the entry for 'name' is always found at
+ *
+ *   symtab[symtab_hash(name, seeds[symtab_hash(name, 0) % nseeds]) % nsyms]
+ *
+ * and a lookup costs two hashes and a single strcmp().  Symbols which are
+ * configured out keep their slot with a NULL sym_value.
+ */
+
+struct symtab_hash_s {
+	FAR const struct symtab_s *symtab;	/* Symbol table ordered by hash slot */
+	FAR const uint16_t *seeds;	/* Per-bucket seeds of the second hash */
+	uint16_t nseeds;			/* Number of buckets in seeds[] */
+	uint16_t nsyms;				/* Number of entries in symtab[] */
+};
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -162,6 +181,33 @@ FAR const struct symtab_s *symtab_findbyvalue(FAR const struct symtab_s *symtab,
 
 FAR const struct symtab_s *symtab_findorderedbyvalue(FAR const struct symtab_s *symtab, FAR void *value, int nsyms);
 
+/****************************************************************************
+ * Name: symtab_hash
+ *
+ * Description:
+ *   Hash a symbol name for a perfect hash symbol table index.  This must
+ *   give the same result as the hash used by tools/mksymtab.
+ *
+ ****************************************************************************/
+
+uint32_t symtab_hash(FAR const char *name, uint32_t seed);
+
+/****************************************************************************
+ * Name: symtab_findbyhash
+ *
+ * Description:
+ *   Find the symbol in the symbol table with the matching name using a
+ *   perfect hash index generated by tools/mksymtab.  Access time does not
+ *   depend upon the number of symbols.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *symtab_findbyhash(FAR const struct symtab_hash_s *hash, FAR const char *name);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
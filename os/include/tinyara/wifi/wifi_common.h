@@ -34,6 +34,9 @@
 #define WIFI_UTILS_SSID_LEN           32
 #define WIFI_UTILS_PASSPHRASE_LEN     64
 
+/* wifi_utils_info_s.capability flags */
+#define WIFI_UTILS_CAP_JOIN_BSSID     0x01	/* wifi_utils_connect_ap() joins the given bssid on its channel */
+
 /****************************************************************************
  * Enums
  ****************************************************************************/
@@ -145,6 +148,8 @@ struct wifi_utils_ap_config {
 	unsigned int passphrase_length;                          /**<  ap passphrase length                    */
 	wifi_utils_ap_auth_type_e ap_auth_type;                  /**<  @ref wifi_utils_ap_auth_type            */
 	wifi_utils_ap_crypto_type_e ap_crypto_type;              /**<  @ref wifi_utils_ap_crypto_type          */
+	unsigned char bssid[WIFI_UTILS_MACADDR_STR_LEN + 1];     /**<  optional, AP to join (xx:xx:xx:xx:xx:xx), empty for any */
+	unsigned int channel;                                    /**<  optional, channel of bssid, 0 if unknown */
 };
 typedef struct wifi_utils_ap_config wifi_utils_ap_config_s;
 
@@ -174,6 +179,7 @@ typedef void (*wifi_utils_sta_disconnected)(void *arg);
 typedef void (*wifi_utils_softap_sta_joined)(void *arg);
 typedef void (*wifi_utils_softap_sta_left)(void *arg);
 typedef void (*wifi_utils_scan_done)(wifi_utils_result_e res, wifi_utils_scan_list_s *slist, void *arg);
+typedef void (*wifi_utils_scan_partial)(wifi_utils_scan_list_s *slist, void *arg);
 
 struct wifi_utils_cb {
 	wifi_utils_sta_connected sta_connected;
@@ -181,6 +187,7 @@ struct wifi_utils_cb {
 	wifi_utils_softap_sta_joined softap_sta_joined;
 	wifi_utils_softap_sta_left softap_sta_left;
 	wifi_utils_scan_done scan_done;
+	wifi_utils_scan_partial scan_partial;	/* optional, results of the channels scanned so far */
 };
 typedef struct wifi_utils_cb wifi_utils_cb_s;
 
@@ -192,6 +199,7 @@ struct wifi_utils_info {
 	unsigned char mac_address[WIFI_UTILS_MACADDR_LEN];    /**<  MAC address of wifi interface             */
 	int rssi;                                             /**<  Receive Signal Strength Indication in dBm */
 	wifi_utils_status_e wifi_status;                      /**<  @ref wifi_utils_status                    */
+	unsigned int capability;                              /**<  optional, WIFI_UTILS_CAP_* flags, 0 if not reported */
 };
 typedef struct wifi_utils_info wifi_utils_info_s;
 
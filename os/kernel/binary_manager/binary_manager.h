@@ -56,6 +56,11 @@
 #define LOADINGTHD_STACKSIZE       2048                        /* Loading thread stack size */
 #define LOADINGTHD_PRIORITY        200                         /* Loading thread priority */
 
+/* Verifying Thread information, used by pipelined loading */
+#define VERIFYTHD_NAME             "bm_verifier"               /* Verifying thread name */
+#define VERIFYTHD_STACKSIZE        2048                        /* Verifying thread stack size */
+#define VERIFYTHD_PRIORITY         LOADINGTHD_PRIORITY         /* Verifying thread priority */
+
 /* Supported binary types */
 #define BIN_TYPE_BIN               0                          /* 'bin' type for kernel binary */
 #define BIN_TYPE_ELF               1                          /* 'elf' type for user binary */
@@ -129,6 +134,7 @@ struct binmgr_bininfo_s {
 	part_info_t part_info[PARTS_PER_BIN];
 	char bin_ver[BIN_VER_MAX];
 	char kernel_ver[KERNEL_VER_MAX];
+	binary_load_time_t load_time;
 	sq_queue_t cb_list; // list node type : statecb_node_t
 };
 typedef struct binmgr_bininfo_s binmgr_bininfo_t;
@@ -152,6 +158,7 @@ binmgr_bininfo_t *binary_manager_get_binary_data(uint32_t bin_idx);
 #define BIN_VER(bin_idx)                                binary_manager_get_binary_data(bin_idx)->bin_ver
 #define BIN_KERNEL_VER(bin_idx)                         binary_manager_get_binary_data(bin_idx)->kernel_ver
 #define BIN_CBLIST(bin_idx)                             binary_manager_get_binary_data(bin_idx)->cb_list
+#define BIN_LOADTIME(bin_idx)                           binary_manager_get_binary_data(bin_idx)->load_time
 
 #define BIN_LOAD_ATTR(bin_idx)                          binary_manager_get_binary_data(bin_idx)->load_attr
 #define BIN_NAME(bin_idx)                               binary_manager_get_binary_data(bin_idx)->load_attr.bin_name
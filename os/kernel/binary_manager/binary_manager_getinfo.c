@@ -128,6 +128,7 @@ void binary_manager_get_info_with_name(int requester_pid, char *bin_name)
 			response_msg.data.inactive_partsize = BIN_PARTSIZE(bin_idx, (BIN_USEIDX(bin_idx) ^ 1));
 			strncpy(response_msg.data.name, BIN_NAME(bin_idx) , BIN_NAME_MAX);
 			strncpy(response_msg.data.active_ver, BIN_VER(bin_idx), BIN_VER_MAX);
+			response_msg.data.load_time = BIN_LOADTIME(bin_idx);
 			snprintf(response_msg.data.active_dev, BINMGR_DEVNAME_LEN, BINMGR_DEVNAME_FMT, BIN_PARTNUM(bin_idx, BIN_USEIDX(bin_idx)));
 			if (BIN_PARTNUM(bin_idx, (BIN_USEIDX(bin_idx) ^ 1)) != -1) {
 				snprintf(response_msg.data.inactive_dev, BINMGR_DEVNAME_LEN, BINMGR_DEVNAME_FMT, BIN_PARTNUM(bin_idx, (BIN_USEIDX(bin_idx) ^ 1)));
@@ -167,6 +168,7 @@ void binary_manager_get_info_all(int requester_pid)
 			response_msg.data.bin_info[bin_idx].inactive_partsize = BIN_PARTSIZE(bin_idx, (BIN_USEIDX(bin_idx) ^ 1));
 			strncpy(response_msg.data.bin_info[bin_idx].name, BIN_NAME(bin_idx) , BIN_NAME_MAX);
 			strncpy(response_msg.data.bin_info[bin_idx].active_ver, BIN_VER(bin_idx), BIN_VER_MAX);
+			response_msg.data.bin_info[bin_idx].load_time = BIN_LOADTIME(bin_idx);
 			snprintf(response_msg.data.bin_info[bin_idx].active_dev, BINMGR_DEVNAME_LEN, BINMGR_DEVNAME_FMT, BIN_PARTNUM(bin_idx, BIN_USEIDX(bin_idx)));
 			if (BIN_PARTNUM(bin_idx, (BIN_USEIDX(bin_idx) ^ 1)) != -1) {
 				snprintf(response_msg.data.bin_info[bin_idx].inactive_dev, BINMGR_DEVNAME_LEN, BINMGR_DEVNAME_FMT, BIN_PARTNUM(bin_idx, (BIN_USEIDX(bin_idx) ^ 1)));
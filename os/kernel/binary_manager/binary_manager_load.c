@@ -36,6 +36,13 @@
 #include <tinyara/mm/mm.h>
 #include <tinyara/sched.h>
 #include <tinyara/init.h>
+#include <tinyara/clock.h>
+#include <tinyara/kmalloc.h>
+#ifdef CONFIG_BINMGR_PIPELINED_LOAD
+#include <assert.h>
+#include <semaphore.h>
+#include <tinyara/semaphore.h>
+#endif
 
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
 #include <tinyara/binfmt/binfmt.h>
@@ -49,6 +56,17 @@
 /****************************************************************************
  * Private Definitions
  ****************************************************************************/
+#ifdef CONFIG_BINMGR_PIPELINED_LOAD
+/* The ELF read cache and decompression keep global state, so binaries
+ * cannot be loaded concurrently with them.
+ */
+#if defined(CONFIG_ELF_CACHE_READ) || defined(CONFIG_COMPRESSED_BINARY)
+#define BINMGR_LOADERS             1
+#else
+#define BINMGR_LOADERS             CONFIG_BINMGR_LOADERS
+#endif
+#endif
+
 struct binary_header_s {
 	uint16_t header_size;
 	uint8_t bin_type;
@@ -64,6 +82,34 @@ struct binary_header_s {
 } __attribute__((__packed__));
 typedef struct binary_header_s binary_header_t;
 
+#ifdef CONFIG_BINMGR_PIPELINED_LOAD
+/* A binary handed over from the verifying thread to the loaders */
+struct binmgr_pipeline_bin_s {
+	sem_t ready;                /* Posted when the binary is verified */
+	int latest_idx;             /* Partition with the latest version */
+	int valid_bin_count;        /* Number of valid partitions or ERROR */
+	clock_t verified_time;      /* When verification finished */
+	binary_header_t header_data[PARTS_PER_BIN];
+};
+typedef struct binmgr_pipeline_bin_s binmgr_pipeline_bin_t;
+
+struct binmgr_pipeline_s {
+	sem_t exclsem;              /* Protects next_idx and load_cnt */
+	sem_t done;                 /* Posted by the verifying and extra loader threads */
+	int bin_count;
+	int next_idx;               /* Next binary to be taken by a loader */
+	int load_cnt;               /* Number of binaries loaded */
+	binmgr_pipeline_bin_t bins[BINARY_COUNT];
+};
+typedef struct binmgr_pipeline_s binmgr_pipeline_t;
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+/* The pipeline of binary_manager_load_all(), shared with its threads */
+static binmgr_pipeline_t *g_pipeline;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -144,43 +190,27 @@ errout_with_fd:
 }
 
 /****************************************************************************
- * Name: binary_manager_load_binary
+ * Name: binary_manager_verify_binary
  *
  * Description:
- *	 This function loads binary with index in binary table.
+ *	 This function reads and verifies the headers of all partitions of a binary
+ *	 and finds the partition with the latest version.  It returns the number
+ *	 of valid partitions, or ERROR if there is none.
  *
  ****************************************************************************/
-#ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
-int binary_manager_load_binary(int bin_idx, void *binp)
-#else
-int binary_manager_load_binary(int bin_idx)
-#endif
+static int binary_manager_verify_binary(int bin_idx, binary_header_t *header_data, int *latest_idx)
 {
 	int ret;
 	int version;
 	int part_idx;
 	int latest_ver;
-	int latest_idx;
-	int retry_count;
 	int valid_bin_count;
-	load_attr_t load_attr;
-	char devname[BINMGR_DEVNAME_LEN];
-	binary_header_t header_data[PARTS_PER_BIN];
+	clock_t start_time;
 
 	latest_ver = -1;
-	latest_idx = -1;
+	*latest_idx = -1;
 	valid_bin_count = 0;
-
-	if (bin_idx < 0) {
-		bmdbg("Invalid bin idx %d\n", bin_idx);
-		return ERROR;
-	}
-
-	/* Check binary state */
-	if (BIN_STATE(bin_idx) != BINARY_INACTIVE) {
-		bmdbg("Invalid binary state %d\n", BIN_STATE(bin_idx));
-		return ERROR;
-	}
+	start_time = clock_systimer();
 
 	/* Read header data of binary partitions */
 	for (part_idx = 0; part_idx < PARTS_PER_BIN; part_idx++) {
@@ -194,16 +224,37 @@ int binary_manager_load_binary(int bin_idx)
 			bmvdbg("Found valid header in part %d, version %d\n", part_idx, version);
 			if (version > latest_ver) {
 				latest_ver = version;
-				latest_idx = part_idx;
+				*latest_idx = part_idx;
 			}
 		}
 	}
 
+	BIN_LOADTIME(bin_idx).verify = TICK2MSEC(clock_systimer() - start_time);
+
 	if (valid_bin_count == 0) {
 		bmdbg("Failed to find valid header of binary %s\n", BIN_NAME(bin_idx));
 		return ERROR;
 	}
 
+	return valid_bin_count;
+}
+
+/****************************************************************************
+ * Name: binary_manager_start_binary
+ *
+ * Description:
+ *	 This function loads and starts a verified binary from the partition with
+ *	 the latest version, and falls back to the other valid partition if that
+ *	 fails.
+ *
+ ****************************************************************************/
+static int binary_manager_start_binary(int bin_idx, binary_header_t *header_data, int latest_idx, int valid_bin_count, void *binp)
+{
+	int ret;
+	int retry_count;
+	load_attr_t load_attr;
+	char devname[BINMGR_DEVNAME_LEN];
+
 	/* Load binary */
 	do {
 		strncpy(load_attr.bin_name, header_data[latest_idx].bin_name, BIN_NAME_MAX);
@@ -217,6 +268,7 @@ int binary_manager_load_binary(int bin_idx)
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
 		load_attr.binp = binp;
 #endif
+		load_attr.load_time = &BIN_LOADTIME(bin_idx);
 
 		bmvdbg("BIN[%d] %s %d %d\n", bin_idx, devname, load_attr.bin_size, load_attr.offset);
 
@@ -233,6 +285,7 @@ int binary_manager_load_binary(int bin_idx)
 				strncpy(BIN_KERNEL_VER(bin_idx), header_data[latest_idx].kernel_ver, KERNEL_VER_MAX);
 				strncpy(BIN_NAME(bin_idx), header_data[latest_idx].bin_name, BIN_NAME_MAX);
 				bmvdbg("BIN TABLE[%d] %d %d %s %s %s\n", bin_idx, BIN_SIZE(bin_idx), BIN_RAMSIZE(bin_idx), BIN_VER(bin_idx), BIN_KERNEL_VER(bin_idx), BIN_NAME(bin_idx));
+				bmvdbg("BIN TIME[%d] verify %u wait %u load %u start %u ms\n", bin_idx, BIN_LOADTIME(bin_idx).verify, BIN_LOADTIME(bin_idx).wait, BIN_LOADTIME(bin_idx).load, BIN_LOADTIME(bin_idx).start);
 				return OK;
 			} else if (errno == ENOMEM) {
 				/* Sleep for a moment to get available memory */
@@ -257,6 +310,225 @@ int binary_manager_load_binary(int bin_idx)
 	return ERROR;
 }
 
+#ifdef CONFIG_BINMGR_PIPELINED_LOAD
+/****************************************************************************
+ * Name: binary_manager_verifying_thread
+ *
+ * Description:
+ *	 This thread verifies all user binaries in order, so that reading and
+ *	 checking the CRC of the next binary overlaps with loading the current
+ *	 one.  Each verified binary is handed over through its 'ready' semaphore.
+ *
+ ****************************************************************************/
+static int binary_manager_verifying_thread(int argc, char *argv[])
+{
+	int bin_idx;
+	binmgr_pipeline_bin_t *bin;
+	binmgr_pipeline_t *pipeline = g_pipeline;
+
+	for (bin_idx = 1; bin_idx <= pipeline->bin_count; bin_idx++) {
+		bin = &pipeline->bins[bin_idx];
+		bin->valid_bin_count = ERROR;
+		if (BIN_STATE(bin_idx) == BINARY_INACTIVE) {
+			bin->valid_bin_count = binary_manager_verify_binary(bin_idx, bin->header_data, &bin->latest_idx);
+		} else {
+			bmdbg("Invalid binary state %d\n", BIN_STATE(bin_idx));
+		}
+		bin->verified_time = clock_systimer();
+		sem_post(&bin->ready);
+	}
+
+	sem_post(&pipeline->done);
+	return OK;
+}
+
+/****************************************************************************
+ * Name: binary_manager_pipeline_loader
+ *
+ * Description:
+ *	 Each loader takes the next binary in order, waits until it is verified
+ *	 and loads it.  With more than one loader, independent binaries are
+ *	 loaded concurrently.
+ *
+ ****************************************************************************/
+static void binary_manager_pipeline_loader(binmgr_pipeline_t *pipeline)
+{
+	int ret;
+	int bin_idx;
+	binmgr_pipeline_bin_t *bin;
+
+	for (;;) {
+		while (sem_wait(&pipeline->exclsem) != OK) {
+			ASSERT(get_errno() == EINTR);
+		}
+		bin_idx = pipeline->next_idx++;
+		sem_post(&pipeline->exclsem);
+
+		if (bin_idx > pipeline->bin_count) {
+			break;
+		}
+
+		bin = &pipeline->bins[bin_idx];
+		while (sem_wait(&bin->ready) != OK) {
+			ASSERT(get_errno() == EINTR);
+		}
+
+		if (bin->valid_bin_count <= 0) {
+			continue;
+		}
+
+		BIN_LOADTIME(bin_idx).wait = TICK2MSEC(clock_systimer() - bin->verified_time);
+		ret = binary_manager_start_binary(bin_idx, bin->header_data, bin->latest_idx, bin->valid_bin_count, NULL);
+		if (ret == OK) {
+			while (sem_wait(&pipeline->exclsem) != OK) {
+				ASSERT(get_errno() == EINTR);
+			}
+			pipeline->load_cnt++;
+			sem_post(&pipeline->exclsem);
+		}
+	}
+}
+
+#if BINMGR_LOADERS > 1
+/****************************************************************************
+ * Name: binary_manager_loader_thread
+ *
+ * Description:
+ *	 An additional loader thread for concurrent loading.
+ *
+ ****************************************************************************/
+static int binary_manager_loader_thread(int argc, char *argv[])
+{
+	binmgr_pipeline_t *pipeline = g_pipeline;
+
+	binary_manager_pipeline_loader(pipeline);
+	sem_post(&pipeline->done);
+	return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: binary_manager_load_all
+ *
+ * Description:
+ *	 This function loads all user binaries in binary table.  Verification
+ *	 runs on its own thread ahead of the loaders.
+ *
+ ****************************************************************************/
+static int binary_manager_load_all(void)
+{
+	int ret;
+	int bin_idx;
+	int nthreads;
+	int load_cnt;
+	binmgr_pipeline_t *pipeline;
+
+	pipeline = (binmgr_pipeline_t *)kmm_zalloc(sizeof(binmgr_pipeline_t));
+	if (pipeline == NULL) {
+		bmdbg("Failed to allocate pipeline\n");
+		return BINMGR_OUT_OF_MEMORY;
+	}
+
+	pipeline->bin_count = binary_manager_get_binary_count();
+	pipeline->next_idx = 1;
+	sem_init(&pipeline->exclsem, 0, 1);
+	sem_init(&pipeline->done, 0, 0);
+	sem_setprotocol(&pipeline->done, SEM_PRIO_NONE);
+	for (bin_idx = 1; bin_idx <= pipeline->bin_count; bin_idx++) {
+		sem_init(&pipeline->bins[bin_idx].ready, 0, 0);
+		sem_setprotocol(&pipeline->bins[bin_idx].ready, SEM_PRIO_NONE);
+	}
+	g_pipeline = pipeline;
+
+	ret = kernel_thread(VERIFYTHD_NAME, VERIFYTHD_PRIORITY, VERIFYTHD_STACKSIZE, binary_manager_verifying_thread, NULL);
+	if (ret < 0) {
+		/* Verify in this thread instead.  The loaders then find every binary verified */
+		bmdbg("Failed to create verifying thread, errno %d\n", errno);
+		(void)binary_manager_verifying_thread(0, NULL);
+	}
+	nthreads = 1;
+
+#if BINMGR_LOADERS > 1
+	for (bin_idx = 1; bin_idx < BINMGR_LOADERS && bin_idx < pipeline->bin_count; bin_idx++) {
+		ret = kernel_thread(LOADINGTHD_NAME, LOADINGTHD_PRIORITY, LOADINGTHD_STACKSIZE, binary_manager_loader_thread, NULL);
+		if (ret < 0) {
+			bmdbg("Failed to create loader thread, errno %d\n", errno);
+			break;
+		}
+		nthreads++;
+	}
+#endif
+
+	/* This thread is a loader as well */
+	binary_manager_pipeline_loader(pipeline);
+
+	/* Wait for the verifying thread and the other loaders */
+	while (nthreads > 0) {
+		while (sem_wait(&pipeline->done) != OK) {
+			ASSERT(get_errno() == EINTR);
+		}
+		nthreads--;
+	}
+
+	load_cnt = pipeline->load_cnt;
+	g_pipeline = NULL;
+	for (bin_idx = 1; bin_idx <= pipeline->bin_count; bin_idx++) {
+		sem_destroy(&pipeline->bins[bin_idx].ready);
+	}
+	sem_destroy(&pipeline->exclsem);
+	sem_destroy(&pipeline->done);
+	kmm_free(pipeline);
+
+	if (load_cnt > 0) {
+		return load_cnt;
+	}
+
+	return BINMGR_OPERATION_FAIL;
+}
+#endif							/* CONFIG_BINMGR_PIPELINED_LOAD */
+
+/****************************************************************************
+ * Name: binary_manager_load_binary
+ *
+ * Description:
+ *	 This function loads binary with index in binary table.
+ *
+ ****************************************************************************/
+#ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
+int binary_manager_load_binary(int bin_idx, void *binp)
+#else
+int binary_manager_load_binary(int bin_idx)
+#endif
+{
+	int latest_idx;
+	int valid_bin_count;
+	binary_header_t header_data[PARTS_PER_BIN];
+
+	if (bin_idx < 0) {
+		bmdbg("Invalid bin idx %d\n", bin_idx);
+		return ERROR;
+	}
+
+	/* Check binary state */
+	if (BIN_STATE(bin_idx) != BINARY_INACTIVE) {
+		bmdbg("Invalid binary state %d\n", BIN_STATE(bin_idx));
+		return ERROR;
+	}
+
+	valid_bin_count = binary_manager_verify_binary(bin_idx, header_data, &latest_idx);
+	if (valid_bin_count <= 0) {
+		return ERROR;
+	}
+
+	BIN_LOADTIME(bin_idx).wait = 0;
+#ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
+	return binary_manager_start_binary(bin_idx, header_data, latest_idx, valid_bin_count, binp);
+#else
+	return binary_manager_start_binary(bin_idx, header_data, latest_idx, valid_bin_count, NULL);
+#endif
+}
+
+#ifndef CONFIG_BINMGR_PIPELINED_LOAD
 /****************************************************************************
  * Name: binary_manager_load_all
  *
@@ -291,6 +563,7 @@ static int binary_manager_load_all(void)
 
 	return BINMGR_OPERATION_FAIL;
 }
+#endif							/* !CONFIG_BINMGR_PIPELINED_LOAD */
 
 /****************************************************************************
  * Name: binary_manager_terminate_binary
@@ -271,6 +271,10 @@ void weak_function sched_process_cpuload(void);
 void sched_clear_cpuload(pid_t pid);
 #endif
 
+#ifdef CONFIG_SCHED_PROFILE
+void sched_profile_sample(FAR struct tcb_s *rtcb);
+#endif
+
 bool sched_verifytcb(FAR struct tcb_s *tcb);
 int sched_releasetcb(FAR struct tcb_s *tcb, uint8_t ttype);
 
@@ -0,0 +1,297 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/sched.h>
+#include <tinyara/kmalloc.h>
+#include <arch/irq.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PROFILE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Number of histogram slots tried for a sample before it is dropped */
+
+#define PROFILE_NPROBES 8
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The histogram is an open addressed hash table of (pid, call chain)
+ * entries.  It is only touched with interrupts disabled.
+ */
+
+static FAR struct sched_profile_entry_s *g_profile;
+static bool g_profile_running;
+static uint16_t g_profile_nentries;
+static uint32_t g_profile_nsamples;
+static uint32_t g_profile_ndropped;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_profile_hash
+ ****************************************************************************/
+
+static unsigned int sched_profile_hash(pid_t pid, FAR const uintptr_t *pcs,
+									   int depth)
+{
+	uint32_t hash = (uint32_t)pid;
+	int i;
+
+	for (i = 0; i < depth; i++) {
+		hash = (hash ^ (uint32_t)pcs[i]) * 0x01000193;
+	}
+
+	return (hash ^ (hash >> 16)) % CONFIG_SCHED_PROFILE_NENTRIES;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_profile_sample
+ *
+ * Description:
+ *   Count one sample of the interrupted thread.  Called from
+ *   sched_process_cpuload() in the timer interrupt.
+ *
+ * Input Parameters:
+ *   rtcb - The thread which was running when the timer expired
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from the timer interrupt handler with interrupts disabled.
+ *
+ ****************************************************************************/
+
+void sched_profile_sample(FAR struct tcb_s *rtcb)
+{
+	FAR struct sched_profile_entry_s *entry;
+	uintptr_t pcs[CONFIG_SCHED_PROFILE_DEPTH];
+	unsigned int index;
+	int depth;
+	int probe;
+
+	if (!g_profile_running) {
+		return;
+	}
+
+	depth = up_profile_backtrace(pcs, CONFIG_SCHED_PROFILE_DEPTH);
+	if (depth <= 0) {
+		return;
+	}
+
+	g_profile_nsamples++;
+
+	/* Count the sample in the entry of this call chain, or take a free
+	 * entry for it.
+	 */
+
+	index = sched_profile_hash(rtcb->pid, pcs, depth);
+	for (probe = 0; probe < PROFILE_NPROBES; probe++) {
+		entry = &g_profile[index];
+
+		if (entry->count == 0) {
+			entry->pid   = rtcb->pid;
+			entry->depth = depth;
+			entry->count = 1;
+			memcpy(entry->pc, pcs, depth * sizeof(uintptr_t));
+			g_profile_nentries++;
+			return;
+		}
+
+		if (entry->pid == rtcb->pid && entry->depth == depth &&
+			memcmp(entry->pc, pcs, depth * sizeof(uintptr_t)) == 0) {
+			entry->count++;
+			return;
+		}
+
+		if (++index >= CONFIG_SCHED_PROFILE_NENTRIES) {
+			index = 0;
+		}
+	}
+
+	g_profile_ndropped++;
+}
+
+/****************************************************************************
+ * Name: sched_profile_start
+ *
+ * Description:
+ *   Start sampling.  The histogram is allocated on the first start and
+ *   keeps accumulating until sched_profile_clear().
+ *
+ * Returned Value:
+ *   OK on success; -ENOMEM if the histogram cannot be allocated.
+ *
+ ****************************************************************************/
+
+int sched_profile_start(void)
+{
+	FAR struct sched_profile_entry_s *profile = NULL;
+	irqstate_t flags;
+
+	if (g_profile == NULL) {
+		profile = (FAR struct sched_profile_entry_s *)
+			kmm_zalloc(CONFIG_SCHED_PROFILE_NENTRIES *
+					   sizeof(struct sched_profile_entry_s));
+		if (profile == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	flags = irqsave();
+	if (g_profile == NULL) {
+		g_profile = profile;
+		profile   = NULL;
+	}
+
+	g_profile_running = true;
+	irqrestore(flags);
+
+	/* Somebody else was faster */
+
+	if (profile != NULL) {
+		kmm_free(profile);
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: sched_profile_stop
+ *
+ * Description:
+ *   Stop sampling.  The histogram is kept for reading.
+ *
+ ****************************************************************************/
+
+void sched_profile_stop(void)
+{
+	g_profile_running = false;
+}
+
+/****************************************************************************
+ * Name: sched_profile_clear
+ *
+ * Description:
+ *   Stop sampling and release the histogram.
+ *
+ ****************************************************************************/
+
+void sched_profile_clear(void)
+{
+	FAR struct sched_profile_entry_s *profile;
+	irqstate_t flags;
+
+	flags = irqsave();
+	profile            = g_profile;
+	g_profile          = NULL;
+	g_profile_running  = false;
+	g_profile_nentries = 0;
+	g_profile_nsamples = 0;
+	g_profile_ndropped = 0;
+	irqrestore(flags);
+
+	if (profile != NULL) {
+		kmm_free(profile);
+	}
+}
+
+/****************************************************************************
+ * Name: sched_profile_status
+ *
+ * Description:
+ *   Return the state and the sample counts of the profiler.
+ *
+ ****************************************************************************/
+
+void sched_profile_status(FAR struct sched_profile_status_s *status)
+{
+	irqstate_t flags;
+
+	DEBUGASSERT(status != NULL);
+
+	flags = irqsave();
+	status->running  = g_profile_running;
+	status->nentries = g_profile_nentries;
+	status->nsamples = g_profile_nsamples;
+	status->ndropped = g_profile_ndropped;
+	irqrestore(flags);
+}
+
+/****************************************************************************
+ * Name: sched_profile_get
+ *
+ * Description:
+ *   Copy one slot of the histogram.  Slots which are not in use are
+ *   returned with a zero count.
+ *
+ * Input Parameters:
+ *   index - Slot number, 0 to CONFIG_SCHED_PROFILE_NENTRIES - 1
+ *   entry - Receives the slot
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if index is past the last slot or there is no
+ *   histogram.
+ *
+ ****************************************************************************/
+
+int sched_profile_get(int index, FAR struct sched_profile_entry_s *entry)
+{
+	irqstate_t flags;
+	int ret = -ENOENT;
+
+	DEBUGASSERT(entry != NULL);
+
+	flags = irqsave();
+	if (g_profile != NULL && index >= 0 &&
+		index < CONFIG_SCHED_PROFILE_NENTRIES) {
+		memcpy(entry, &g_profile[index], sizeof(struct sched_profile_entry_s));
+		ret = OK;
+	}
+
+	irqrestore(flags);
+	return ret;
+}
+
+#endif /* CONFIG_SCHED_PROFILE */
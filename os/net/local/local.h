@@ -91,6 +91,16 @@
 #define LOCAL_SYNC_BYTE 0x42 /* Byte in sync sequence */
 #define LOCAL_END_BYTE 0xbd  /* End of sync seqence */
 
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+#ifndef CONFIG_NET_LOCAL_STREAM_BUFSIZE
+#define CONFIG_NET_LOCAL_STREAM_BUFSIZE 1024
+#endif
+
+/* Bytes buffered in a ring of a directly connected stream */
+
+#define LOCAL_RING_NBYTES(r) ((r)->lr_wrndx - (r)->lr_rdndx)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -123,6 +133,39 @@ enum local_state_s {
 	LOCAL_STATE_DISCONNECTED /* Peer disconnected */
 };
 
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+/* One direction of a directly connected stream.  The indices run freely
+ * and are masked with the ring size, so the ring is full when they are
+ * lp_size apart.
+ */
+
+struct local_ring_s {
+	FAR uint8_t *lr_buffer; /* Ring buffer of lp_size bytes */
+	uint32_t lr_rdndx;		/* Bytes read from the ring so far */
+	uint32_t lr_wrndx;		/* Bytes written to the ring so far */
+	sem_t lr_rdsem;			/* Readers waiting for data */
+	sem_t lr_wrsem;			/* Writers waiting for space */
+};
+
+/* The rings shared by the two ends of a stream connected by connect() and
+ * accept() or created by socketpair().  End n receives from lp_ring[n] and
+ * sends to the other ring.
+ */
+
+struct local_pair_s {
+	struct local_ring_s lp_ring[2];
+	uint32_t lp_size;  /* Size of each ring, a power of two */
+	uint8_t lp_crefs;  /* Number of ends attached to the pair */
+	uint8_t lp_closed; /* Bit n is set when end n has been released */
+
+#ifdef HAVE_LOCAL_POLL
+	/* Poll structures of the threads waiting for events on each end */
+
+	struct pollfd *lp_fds[2][LOCAL_NPOLLWAITERS];
+#endif
+};
+#endif /* CONFIG_NET_LOCAL_STREAM_DIRECT */
+
 /* Representation of a local connection.  There are four types of
  * connection structures:
  *
@@ -170,6 +213,15 @@ struct local_conn_s {
 
 	sem_t lc_waitsem; /* Use to wait for a connection to be accepted */
 
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+	/* The rings of a directly connected peer (or of a client waiting in
+	 * connect()) and the index of this end in them.
+	 */
+
+	FAR struct local_pair_s *lc_pair;
+	uint8_t lc_side;
+#endif
+
 #ifdef HAVE_LOCAL_POLL
 	/* The following is a list if poll structures of threads waiting for
 	 * socket events.
@@ -303,6 +355,29 @@ int psock_local_bind(FAR struct socket *psock,
 int psock_local_connect(FAR struct socket *psock,
 						FAR const struct sockaddr *addr);
 
+/****************************************************************************
+ * Name: psock_local_socketpair
+ *
+ * Description:
+ *   Connect two new, unbound Unix domain stream sockets to each other
+ *   through a pair of rings, without a listener and without any file
+ *   system object.  This is the low-level part of socketpair().
+ *
+ * Input Parameters:
+ *   psock0 - The first socket, set up by psock_socket()
+ *   psock1 - The second socket, set up by psock_socket()
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+int psock_local_socketpair(FAR struct socket *psock0,
+						   FAR struct socket *psock1);
+#endif
+
 /****************************************************************************
  * Name: local_release
  *
@@ -662,6 +737,99 @@ int local_open_sender(FAR struct local_conn_s *conn, FAR const char *path,
 					  bool nonblock);
 #endif
 
+/****************************************************************************
+ * Name: local_pair_alloc
+ *
+ * Description:
+ *   Allocate the rings of a direct stream connection and attach conn to
+ *   them as the first end.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOMEM if the rings could not be
+ *   allocated.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+int local_pair_alloc(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_pair_attach
+ *
+ * Description:
+ *   Attach conn as the other end of the rings allocated by peer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+void local_pair_attach(FAR struct local_conn_s *conn,
+					   FAR struct local_conn_s *peer);
+#endif
+
+/****************************************************************************
+ * Name: local_pair_release
+ *
+ * Description:
+ *   Detach conn from its rings.  The peer then reads the end of the stream
+ *   and fails to send with EPIPE.  The rings are freed with the last end.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+void local_pair_release(FAR struct local_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: local_pair_send
+ *
+ * Description:
+ *   Copy data into the ring of the peer.  A blocking send returns when all
+ *   of the data is in the ring.
+ *
+ * Returned Value:
+ *   The number of bytes sent; or a negated errno value (-EAGAIN, -EPIPE
+ *   or -EINTR) if nothing was sent.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+ssize_t local_pair_send(FAR struct local_conn_s *conn, FAR const void *buf,
+						size_t len, bool nonblock);
+#endif
+
+/****************************************************************************
+ * Name: local_pair_recv
+ *
+ * Description:
+ *   Copy up to len bytes out of the ring of conn, waiting for data if the
+ *   ring is empty and the socket is blocking.
+ *
+ * Returned Value:
+ *   The number of bytes received, zero at the end of the stream; or a
+ *   negated errno value (-EAGAIN or -EINTR).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+ssize_t local_pair_recv(FAR struct local_conn_s *conn, FAR void *buf,
+						size_t len, bool nonblock);
+#endif
+
+/****************************************************************************
+ * Name: local_pair_poll
+ *
+ * Description:
+ *   Setup or teardown the monitoring of the rings of a directly connected
+ *   stream.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_LOCAL_STREAM_DIRECT) && defined(HAVE_LOCAL_POLL)
+int local_pair_poll(FAR struct local_conn_s *conn, FAR struct pollfd *fds,
+					bool setup);
+#endif
+
 /****************************************************************************
  * Name: local_accept_pollnotify
  ****************************************************************************/
@@ -157,6 +157,18 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
 	server->u.server.lc_pending++;
 	DEBUGASSERT(server->u.server.lc_pending != 0);
 
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+	/* Allocate the rings of the connection.  The server attaches the
+	 * accepted connection to them.
+	 */
+
+	ret = local_pair_alloc(client);
+	if (ret < 0) {
+		server->u.server.lc_pending--;
+		net_unlock();
+		return ret;
+	}
+#else
 	/* Create the FIFOs needed for the connection */
 
 	ret = local_create_fifos(client);
@@ -182,6 +194,7 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
 	}
 
 	DEBUGASSERT(client->lc_outfile.f_inode != NULL);
+#endif
 
 	/* Set the busy "result" before giving the semaphore. */
 
@@ -208,6 +221,19 @@ static int inline local_stream_connect(FAR struct local_conn_s *client,
 
 	/* Did we successfully connect? */
 
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+	if (ret < 0) {
+		ndbg("ERROR: Failed to connect: %d\n", ret);
+		local_pair_release(client);
+		client->lc_state = LOCAL_STATE_BOUND;
+		return ret;
+	}
+
+	/* Yes.. the accepted connection is attached to the other end */
+
+	client->lc_state = LOCAL_STATE_CONNECTED;
+	return OK;
+#else
 	if (ret < 0) {
 		ndbg("ERROR: Failed to connect: %d\n", ret);
 		goto errout_with_outfd;
@@ -234,6 +260,7 @@ errout_with_fifos:
 	local_release_fifos(client);
 	client->lc_state = LOCAL_STATE_BOUND;
 	return ret;
+#endif
 }
 
 /****************************************************************************
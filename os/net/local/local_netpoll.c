@@ -197,6 +197,12 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 		return local_accept_pollsetup(conn, fds, true);
 	}
 
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+	if (conn->lc_state == LOCAL_STATE_CONNECTED) {
+		return local_pair_poll(conn, fds, true);
+	}
+#endif
+
 	if (conn->lc_state == LOCAL_STATE_DISCONNECTED) {
 		fds->priv = NULL;
 		goto pollerr;
@@ -327,6 +333,12 @@ int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds)
 		return local_accept_pollsetup(conn, fds, false);
 	}
 
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+	if (conn->lc_state == LOCAL_STATE_CONNECTED) {
+		return local_pair_poll(conn, fds, false);
+	}
+#endif
+
 	if (conn->lc_state == LOCAL_STATE_DISCONNECTED) {
 		return OK;
 	}
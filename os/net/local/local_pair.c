@@ -0,0 +1,584 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * net/local/local_pair.c
+ *
+ * Direct transport of connected Unix domain stream sockets.  The two ends
+ * share a reference counted pair of rings, one per direction, and wait on
+ * the semaphores of the rings.  Nothing is created in the file system and
+ * the data is copied once into the ring and once out of it.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_LOCAL_STREAM_DIRECT)
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/semaphore.h>
+#include <tinyara/net/net.h>
+
+#include "socket/socket.h"
+#include "local/local.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Bit of lp_closed for the end n */
+
+#define LOCAL_PAIR_CLOSED(n) (1 << (n))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_pair_wakeup
+ *
+ * Description:
+ *   Wake up one thread waiting on the semaphore of a ring.  Data (or
+ *   space) wakes a single waiter, which passes the wake up on if it leaves
+ *   something for the next one.
+ *
+ ****************************************************************************/
+
+static void local_pair_wakeup(FAR sem_t *sem)
+{
+	int sval;
+
+	if (sem_getvalue(sem, &sval) == 0 && sval < 0) {
+		sem_post(sem);
+	}
+}
+
+/****************************************************************************
+ * Name: local_pair_wakeall
+ *
+ * Description:
+ *   Wake up every thread waiting on the semaphore of a ring.
+ *
+ ****************************************************************************/
+
+static void local_pair_wakeall(FAR sem_t *sem)
+{
+	int sval;
+
+	while (sem_getvalue(sem, &sval) == 0 && sval < 0) {
+		sem_post(sem);
+	}
+}
+
+/****************************************************************************
+ * Name: local_pair_pollnotify
+ *
+ * Description:
+ *   Report events to the threads polling one end of the pair.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LOCAL_POLL
+static void local_pair_pollnotify(FAR struct local_pair_s *pair, int side,
+								  pollevent_t eventset)
+{
+	int i;
+
+	for (i = 0; i < LOCAL_NPOLLWAITERS; i++) {
+		FAR struct pollfd *fds = pair->lp_fds[side][i];
+		if (fds) {
+			/* POLLHUP is reported whether it was requested or not */
+
+			fds->revents |= (fds->events & eventset) | (eventset & POLLHUP);
+			if (fds->revents != 0) {
+				nvdbg("Report events: %02x\n", fds->revents);
+				sem_post(fds->sem);
+			}
+		}
+	}
+}
+#else
+#define local_pair_pollnotify(pair, side, eventset)
+#endif
+
+/****************************************************************************
+ * Name: local_pair_copyout
+ *
+ * Description:
+ *   Copy up to len buffered bytes out of a ring, in at most two segments.
+ *
+ ****************************************************************************/
+
+static size_t local_pair_copyout(FAR struct local_pair_s *pair,
+								 FAR struct local_ring_s *ring,
+								 FAR uint8_t *buf, size_t len)
+{
+	uint32_t offset = ring->lr_rdndx & (pair->lp_size - 1);
+	size_t first;
+
+	if (len > LOCAL_RING_NBYTES(ring)) {
+		len = LOCAL_RING_NBYTES(ring);
+	}
+
+	first = pair->lp_size - offset;
+	if (first > len) {
+		first = len;
+	}
+
+	memcpy(buf, &ring->lr_buffer[offset], first);
+	memcpy(buf + first, ring->lr_buffer, len - first);
+	ring->lr_rdndx += len;
+
+	return len;
+}
+
+/****************************************************************************
+ * Name: local_pair_copyin
+ *
+ * Description:
+ *   Copy up to len bytes into the free space of a ring, in at most two
+ *   segments.
+ *
+ ****************************************************************************/
+
+static size_t local_pair_copyin(FAR struct local_pair_s *pair,
+								FAR struct local_ring_s *ring,
+								FAR const uint8_t *buf, size_t len)
+{
+	uint32_t offset = ring->lr_wrndx & (pair->lp_size - 1);
+	size_t nfree = pair->lp_size - LOCAL_RING_NBYTES(ring);
+	size_t first;
+
+	if (len > nfree) {
+		len = nfree;
+	}
+
+	first = pair->lp_size - offset;
+	if (first > len) {
+		first = len;
+	}
+
+	memcpy(&ring->lr_buffer[offset], buf, first);
+	memcpy(ring->lr_buffer, buf + first, len - first);
+	ring->lr_wrndx += len;
+
+	return len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_pair_alloc
+ *
+ * Description:
+ *   Allocate the rings of a direct stream connection and attach conn to
+ *   them as the first end.
+ *
+ ****************************************************************************/
+
+int local_pair_alloc(FAR struct local_conn_s *conn)
+{
+	FAR struct local_pair_s *pair;
+	FAR uint8_t *buffer;
+	uint32_t size = 1;
+	int i;
+
+	DEBUGASSERT(conn->lc_pair == NULL);
+
+	while (size < CONFIG_NET_LOCAL_STREAM_BUFSIZE) {
+		size <<= 1;
+	}
+
+	/* The rings follow the pair structure in the same allocation */
+
+	pair = (FAR struct local_pair_s *)
+		kmm_zalloc(sizeof(struct local_pair_s) + 2 * size);
+	if (pair == NULL) {
+		ndbg("ERROR: Failed to allocate the stream rings\n");
+		return -ENOMEM;
+	}
+
+	buffer = (FAR uint8_t *)(pair + 1);
+	for (i = 0; i < 2; i++) {
+		FAR struct local_ring_s *ring = &pair->lp_ring[i];
+
+		ring->lr_buffer = buffer + i * size;
+
+		/* These semaphores are used for signaling and, hence, should not
+		 * have priority inheritance enabled.
+		 */
+
+		sem_init(&ring->lr_rdsem, 0, 0);
+		sem_setprotocol(&ring->lr_rdsem, SEM_PRIO_NONE);
+		sem_init(&ring->lr_wrsem, 0, 0);
+		sem_setprotocol(&ring->lr_wrsem, SEM_PRIO_NONE);
+	}
+
+	pair->lp_size = size;
+	pair->lp_crefs = 1;
+
+	conn->lc_pair = pair;
+	conn->lc_side = 0;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: local_pair_attach
+ *
+ * Description:
+ *   Attach conn as the other end of the rings allocated by peer.
+ *
+ ****************************************************************************/
+
+void local_pair_attach(FAR struct local_conn_s *conn,
+					   FAR struct local_conn_s *peer)
+{
+	FAR struct local_pair_s *pair = peer->lc_pair;
+
+	DEBUGASSERT(pair != NULL && pair->lp_crefs == 1);
+	DEBUGASSERT(conn->lc_pair == NULL);
+
+	net_lock();
+	pair->lp_crefs++;
+	conn->lc_pair = pair;
+	conn->lc_side = peer->lc_side ^ 1;
+	net_unlock();
+}
+
+/****************************************************************************
+ * Name: local_pair_release
+ *
+ * Description:
+ *   Detach conn from its rings.  The peer then reads the end of the stream
+ *   and fails to send with EPIPE.  The rings are freed with the last end.
+ *
+ ****************************************************************************/
+
+void local_pair_release(FAR struct local_conn_s *conn)
+{
+	FAR struct local_pair_s *pair = conn->lc_pair;
+	int side = conn->lc_side;
+	int i;
+
+	if (pair == NULL) {
+		return;
+	}
+
+	net_lock();
+
+	/* Wake up the peer blocked in recv() for the end of the stream and in
+	 * send() for EPIPE.
+	 */
+
+	pair->lp_closed |= LOCAL_PAIR_CLOSED(side);
+	local_pair_wakeall(&pair->lp_ring[side ^ 1].lr_rdsem);
+	local_pair_wakeall(&pair->lp_ring[side].lr_wrsem);
+	local_pair_pollnotify(pair, side ^ 1, POLLIN | POLLOUT | POLLHUP);
+
+	conn->lc_pair = NULL;
+	if (--pair->lp_crefs == 0) {
+		for (i = 0; i < 2; i++) {
+			sem_destroy(&pair->lp_ring[i].lr_rdsem);
+			sem_destroy(&pair->lp_ring[i].lr_wrsem);
+		}
+
+		kmm_free(pair);
+	}
+
+	net_unlock();
+}
+
+/****************************************************************************
+ * Name: local_pair_send
+ *
+ * Description:
+ *   Copy data into the ring of the peer.  A blocking send returns when all
+ *   of the data is in the ring.
+ *
+ ****************************************************************************/
+
+ssize_t local_pair_send(FAR struct local_conn_s *conn, FAR const void *buf,
+						size_t len, bool nonblock)
+{
+	FAR struct local_pair_s *pair = conn->lc_pair;
+	FAR struct local_ring_s *ring;
+	int peer = conn->lc_side ^ 1;
+	size_t nsent = 0;
+	int ret = OK;
+
+	DEBUGASSERT(pair != NULL);
+	ring = &pair->lp_ring[peer];
+
+	net_lock();
+	while (nsent < len) {
+		size_t ncopied;
+
+		/* Nobody will ever read what is sent to a released end */
+
+		if ((pair->lp_closed & LOCAL_PAIR_CLOSED(peer)) != 0) {
+			ret = -EPIPE;
+			break;
+		}
+
+		ncopied = local_pair_copyin(pair, ring,
+									(FAR const uint8_t *)buf + nsent,
+									len - nsent);
+		if (ncopied > 0) {
+			nsent += ncopied;
+			local_pair_wakeup(&ring->lr_rdsem);
+			local_pair_pollnotify(pair, peer, POLLIN);
+			continue;
+		}
+
+		/* The ring is full.  Return what was sent or wait for the reader */
+
+		if (nonblock) {
+			ret = -EAGAIN;
+			break;
+		}
+
+		ret = net_lockedwait(&ring->lr_wrsem);
+		if (ret < 0) {
+			ret = -EINTR;
+			break;
+		}
+	}
+
+	/* Pass the wake up on if space is left for another writer */
+
+	if (LOCAL_RING_NBYTES(ring) < pair->lp_size) {
+		local_pair_wakeup(&ring->lr_wrsem);
+	}
+
+	net_unlock();
+	return nsent > 0 ? (ssize_t)nsent : ret;
+}
+
+/****************************************************************************
+ * Name: local_pair_recv
+ *
+ * Description:
+ *   Copy up to len bytes out of the ring of conn, waiting for data if the
+ *   ring is empty and the socket is blocking.
+ *
+ ****************************************************************************/
+
+ssize_t local_pair_recv(FAR struct local_conn_s *conn, FAR void *buf,
+						size_t len, bool nonblock)
+{
+	FAR struct local_pair_s *pair = conn->lc_pair;
+	FAR struct local_ring_s *ring;
+	int side = conn->lc_side;
+	size_t nread;
+	int ret;
+
+	DEBUGASSERT(pair != NULL);
+	ring = &pair->lp_ring[side];
+
+	net_lock();
+	while (LOCAL_RING_NBYTES(ring) == 0) {
+		/* The buffered data is read before the end of the stream */
+
+		if ((pair->lp_closed & LOCAL_PAIR_CLOSED(side ^ 1)) != 0) {
+			net_unlock();
+			return 0;
+		}
+
+		if (nonblock) {
+			net_unlock();
+			return -EAGAIN;
+		}
+
+		ret = net_lockedwait(&ring->lr_rdsem);
+		if (ret < 0) {
+			net_unlock();
+			return -EINTR;
+		}
+	}
+
+	nread = local_pair_copyout(pair, ring, (FAR uint8_t *)buf, len);
+	local_pair_wakeup(&ring->lr_wrsem);
+	local_pair_pollnotify(pair, side ^ 1, POLLOUT);
+
+	/* Pass the wake up on if data is left for another reader */
+
+	if (LOCAL_RING_NBYTES(ring) > 0) {
+		local_pair_wakeup(&ring->lr_rdsem);
+	}
+
+	net_unlock();
+	return nread;
+}
+
+/****************************************************************************
+ * Name: local_pair_poll
+ *
+ * Description:
+ *   Setup or teardown the monitoring of the rings of a directly connected
+ *   stream.
+ *
+ ****************************************************************************/
+
+#ifdef HAVE_LOCAL_POLL
+int local_pair_poll(FAR struct local_conn_s *conn, FAR struct pollfd *fds,
+					bool setup)
+{
+	FAR struct local_pair_s *pair = conn->lc_pair;
+	FAR struct local_ring_s *ring;
+	pollevent_t eventset;
+	int side = conn->lc_side;
+	int ret = OK;
+	int i;
+
+	net_lock();
+	if (!setup) {
+		/* This is a request to tear down the poll. */
+
+		FAR struct pollfd **slot = (FAR struct pollfd **)fds->priv;
+
+		if (slot != NULL) {
+			*slot = NULL;
+			fds->priv = NULL;
+		}
+
+		goto errout;
+	}
+
+	if (pair == NULL) {
+		/* The rings were released, the socket can only fail */
+
+		fds->priv = NULL;
+		fds->revents |= POLLERR;
+		sem_post(fds->sem);
+		goto errout;
+	}
+
+	/* Find an available slot for the poll structure reference */
+
+	for (i = 0; i < LOCAL_NPOLLWAITERS; i++) {
+		if (!pair->lp_fds[side][i]) {
+			pair->lp_fds[side][i] = fds;
+			fds->priv = &pair->lp_fds[side][i];
+			break;
+		}
+	}
+
+	if (i >= LOCAL_NPOLLWAITERS) {
+		fds->priv = NULL;
+		ret = -EBUSY;
+		goto errout;
+	}
+
+	/* Report the events which are already pending */
+
+	eventset = 0;
+	if ((pair->lp_closed & LOCAL_PAIR_CLOSED(side ^ 1)) != 0) {
+		eventset |= POLLIN | POLLOUT | POLLHUP;
+	} else {
+		if (LOCAL_RING_NBYTES(&pair->lp_ring[side]) > 0) {
+			eventset |= POLLIN;
+		}
+
+		ring = &pair->lp_ring[side ^ 1];
+		if (LOCAL_RING_NBYTES(ring) < pair->lp_size) {
+			eventset |= POLLOUT;
+		}
+	}
+
+	if (eventset) {
+		local_pair_pollnotify(pair, side, eventset);
+	}
+
+errout:
+	net_unlock();
+	return ret;
+}
+#endif /* HAVE_LOCAL_POLL */
+
+/****************************************************************************
+ * Name: psock_local_socketpair
+ *
+ * Description:
+ *   Connect two new, unbound Unix domain stream sockets to each other
+ *   through a pair of rings, without a listener and without any file
+ *   system object.  This is the low-level part of socketpair().
+ *
+ ****************************************************************************/
+
+int psock_local_socketpair(FAR struct socket *psock0,
+						   FAR struct socket *psock1)
+{
+	FAR struct local_conn_s *conns[2];
+	FAR struct socket *psocks[2];
+	int ret;
+	int i;
+
+	DEBUGASSERT(psock0 && psock0->s_conn && psock1 && psock1->s_conn);
+
+	/* Only the stream sockets have a direct transport */
+
+	if (psock0->s_type != SOCK_STREAM || psock1->s_type != SOCK_STREAM) {
+		return -EOPNOTSUPP;
+	}
+
+	psocks[0] = psock0;
+	psocks[1] = psock1;
+	conns[0] = (FAR struct local_conn_s *)psock0->s_conn;
+	conns[1] = (FAR struct local_conn_s *)psock1->s_conn;
+
+	if (conns[0]->lc_state != LOCAL_STATE_UNBOUND ||
+		conns[1]->lc_state != LOCAL_STATE_UNBOUND) {
+		return -EISCONN;
+	}
+
+	net_lock();
+	ret = local_pair_alloc(conns[0]);
+	if (ret < 0) {
+		net_unlock();
+		return ret;
+	}
+
+	local_pair_attach(conns[1], conns[0]);
+
+	for (i = 0; i < 2; i++) {
+		conns[i]->lc_proto = SOCK_STREAM;
+		conns[i]->lc_type = LOCAL_TYPE_UNNAMED;
+		conns[i]->lc_state = LOCAL_STATE_CONNECTED;
+		conns[i]->lc_instance_id = -1;
+		psocks[i]->s_flags |= _SF_CONNECTED;
+	}
+
+	net_unlock();
+	return OK;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_LOCAL_STREAM_DIRECT */
@@ -26,6 +26,9 @@ void uds_net_releaselist(FAR struct socketlist *list);
 int uds_checksd(int fd, int oflags);
 
 int uds_socket(int domain, int type, int protocol);
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+int uds_socketpair(int domain, int type, int protocol, int sv[2]);
+#endif
 int uds_bind(int sockfd, const struct sockaddr *addr, socklen_t addrlen);
 int uds_connect(int sockfd, FAR const struct sockaddr *addr, socklen_t addrlen);
 int uds_listen(int sockfd, int backlog);
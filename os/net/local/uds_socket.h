@@ -143,6 +143,7 @@
  ****************************************************************************/
 
 FAR struct socket *sockfd_socket(int sockfd);
+int psock_close(FAR struct socket *psock);
 FAR const struct sock_intf_s *
 net_sockif(sa_family_t family, int type, int protocol);
 
@@ -0,0 +1,126 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/socket.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include "local/uds_socket.h"
+#include "local/uds_net.h"
+#include "local/local.h"
+
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: uds_socketpair
+ *
+ * Description:
+ *   socketpair() creates two Unix domain stream sockets connected to each
+ *   other.  The data written to one of them is read from the other one.
+ *   The sockets have no name and no file system object is created for
+ *   them.
+ *
+ * Input Parameters:
+ *   domain   AF_UNIX
+ *   type     SOCK_STREAM
+ *   protocol 0
+ *   sv       Receives the two socket descriptors
+ *
+ * Returned Value:
+ *   0 on success; -1 on error with errno set appropriately
+ *
+ *   EAFNOSUPPORT
+ *     The implementation does not support the specified address family.
+ *   EFAULT
+ *     sv is NULL.
+ *   EOPNOTSUPP
+ *     The type of socket does not support socket pairs.
+ *   ENFILE
+ *     The socket descriptor table of the task is full.
+ *   ENOMEM
+ *     Insufficient memory is available for the sockets or their buffers.
+ *
+ ****************************************************************************/
+
+int uds_socketpair(int domain, int type, int protocol, int sv[2])
+{
+	int errcode;
+	int ret;
+
+	if (sv == NULL) {
+		errcode = EFAULT;
+		goto errout;
+	}
+
+	if (domain != AF_UNIX) {
+		errcode = EAFNOSUPPORT;
+		goto errout;
+	}
+
+	if (type != SOCK_STREAM) {
+		errcode = EOPNOTSUPP;
+		goto errout;
+	}
+
+	/* Create the two sockets */
+
+	sv[0] = uds_socket(domain, type, protocol);
+	if (sv[0] < 0) {
+		return ERROR;
+	}
+
+	sv[1] = uds_socket(domain, type, protocol);
+	if (sv[1] < 0) {
+		errcode = get_errno();
+		goto errout_with_sv0;
+	}
+
+	/* And connect them to each other */
+
+	ret = psock_local_socketpair(sockfd_socket(sv[0]), sockfd_socket(sv[1]));
+	if (ret < 0) {
+		ndbg("ERROR: psock_local_socketpair() failed: %d\n", ret);
+		errcode = -ret;
+		goto errout_with_sv1;
+	}
+
+	return OK;
+
+errout_with_sv1:
+	psock_close(sockfd_socket(sv[1]));
+
+errout_with_sv0:
+	psock_close(sockfd_socket(sv[0]));
+
+errout:
+	set_errno(errcode);
+	return ERROR;
+}
+
+#endif /* CONFIG_NET_LOCAL_STREAM_DIRECT */
@@ -96,6 +96,32 @@ static err_t netifapi_do_netif_set_addr(struct tcpip_api_call_data *m)
 }
 #endif							/* LWIP_IPV4 */
 
+#if LWIP_IPV4 && LWIP_DHCP && LWIP_DHCP_TCPIP_THREAD
+/**
+ * Call dhcp_start_reboot() inside the tcpip_thread context.
+ */
+static err_t netifapi_do_dhcp_start_reboot(struct tcpip_api_call_data *m)
+{
+	/* cast through void* to silence alignment warnings.
+	 * We know it works because the structs have been instantiated as struct netifapi_msg */
+	struct netifapi_msg *msg = (struct netifapi_msg *)(void *)m;
+
+	return dhcp_start_reboot(msg->netif, API_EXPR_REF(msg->msg.add.ipaddr));
+}
+
+/**
+ * Call dhcp_get_lease() inside the tcpip_thread context.
+ */
+static err_t netifapi_do_dhcp_get_lease(struct tcpip_api_call_data *m)
+{
+	/* cast through void* to silence alignment warnings.
+	 * We know it works because the structs have been instantiated as struct netifapi_msg */
+	struct netifapi_msg *msg = (struct netifapi_msg *)(void *)m;
+
+	return dhcp_get_lease(msg->netif, msg->msg.lease.addr, msg->msg.lease.server, msg->msg.lease.lease_time);
+}
+#endif							/* LWIP_IPV4 && LWIP_DHCP && LWIP_DHCP_TCPIP_THREAD */
+
 /**
  * Call the "errtfunc" (or the "voidfunc" if "errtfunc" is NULL) inside the
  * tcpip_thread context.
@@ -189,6 +215,51 @@ err_t netifapi_netif_set_addr(struct netif *netif, const ip4_addr_t *ipaddr, con
 }
 #endif							/* LWIP_IPV4 */
 
+#if LWIP_IPV4 && LWIP_DHCP && LWIP_DHCP_TCPIP_THREAD
+/**
+ * @ingroup netifapi_dhcp4
+ * Call dhcp_start_reboot() in a thread-safe way by running that function
+ * inside the tcpip_thread context.
+ *
+ * @note for params @see dhcp_start_reboot()
+ */
+err_t netifapi_dhcp_start_reboot(struct netif *netif, const ip4_addr_t *addr)
+{
+	err_t err;
+	NETIFAPI_VAR_DECLARE(msg);
+	NETIFAPI_VAR_ALLOC(msg);
+
+	NETIFAPI_VAR_REF(msg).netif = netif;
+	NETIFAPI_VAR_REF(msg).msg.add.ipaddr = NETIFAPI_VAR_REF(addr);
+	err = tcpip_api_call(netifapi_do_dhcp_start_reboot, &API_VAR_REF(msg).call);
+	NETIFAPI_VAR_FREE(msg);
+	return err;
+}
+
+/**
+ * @ingroup netifapi_dhcp4
+ * Call dhcp_get_lease() in a thread-safe way by running that function
+ * inside the tcpip_thread context, so the lease isn't read while the
+ * DHCP client updates it.
+ *
+ * @note for params @see dhcp_get_lease()
+ */
+err_t netifapi_dhcp_get_lease(struct netif *netif, ip4_addr_t *addr, ip4_addr_t *server, u32_t *lease_time)
+{
+	err_t err;
+	NETIFAPI_VAR_DECLARE(msg);
+	NETIFAPI_VAR_ALLOC(msg);
+
+	NETIFAPI_VAR_REF(msg).netif = netif;
+	NETIFAPI_VAR_REF(msg).msg.lease.addr = addr;
+	NETIFAPI_VAR_REF(msg).msg.lease.server = server;
+	NETIFAPI_VAR_REF(msg).msg.lease.lease_time = lease_time;
+	err = tcpip_api_call(netifapi_do_dhcp_get_lease, &API_VAR_REF(msg).call);
+	NETIFAPI_VAR_FREE(msg);
+	return err;
+}
+#endif							/* LWIP_IPV4 && LWIP_DHCP && LWIP_DHCP_TCPIP_THREAD */
+
 /**
  * call the "errtfunc" (or the "voidfunc" if "errtfunc" is NULL) in a thread-safe
  * way by running that function inside the tcpip_thread context.
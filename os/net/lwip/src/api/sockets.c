@@ -1083,16 +1083,31 @@ int lwip_sendmsg(int s, const struct msghdr *msg, int flags)
 		} else {
 			/* flatten the IO vectors */
 			size_t offset = 0;
+#if LWIP_CHECKSUM_ON_COPY
+			/* checksum each IO vector while copying it, as inet_chksum_pbuf()
+			   aggregates the checksums of the pbufs in a chain */
+			u32_t acc = 0;
+			u8_t swapped = 0;
+#endif							/* LWIP_CHECKSUM_ON_COPY */
 			for (i = 0; i < msg->msg_iovlen; i++) {
+#if LWIP_CHECKSUM_ON_COPY
+				acc += LWIP_CHKSUM_COPY(&((u8_t *) chain_buf->p->payload)[offset], msg->msg_iov[i].iov_base, msg->msg_iov[i].iov_len);
+				acc = FOLD_U32T(acc);
+				if (msg->msg_iov[i].iov_len % 2 != 0) {
+					swapped = 1 - swapped;
+					acc = SWAP_BYTES_IN_WORD(acc);
+				}
+#else							/* LWIP_CHECKSUM_ON_COPY */
 				MEMCPY(&((u8_t *) chain_buf->p->payload)[offset], msg->msg_iov[i].iov_base, msg->msg_iov[i].iov_len);
+#endif							/* LWIP_CHECKSUM_ON_COPY */
 				offset += msg->msg_iov[i].iov_len;
 			}
 #if LWIP_CHECKSUM_ON_COPY
-			{
-				/* This can be improved by using LWIP_CHKSUM_COPY() and aggregating the checksum for each IO vector */
-				u16_t chksum = ~inet_chksum_pbuf(chain_buf->p);
-				netbuf_set_chksum(chain_buf, chksum);
+			acc = FOLD_U32T(acc);
+			if (swapped) {
+				acc = SWAP_BYTES_IN_WORD(acc);
 			}
+			netbuf_set_chksum(chain_buf, (u16_t)acc);
 #endif							/* LWIP_CHECKSUM_ON_COPY */
 			err = ERR_OK;
 		}
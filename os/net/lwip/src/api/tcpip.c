@@ -140,13 +140,13 @@ static void tcpip_thread(void *arg)
 			break;
 #endif							/* !LWIP_TCPIP_CORE_LOCKING */
 
-#if !LWIP_TCPIP_CORE_LOCKING_INPUT
 		case TCPIP_MSG_INPKT:
+			/* Also used with LWIP_TCPIP_CORE_LOCKING_INPUT for the packets
+			   that could not be processed in the caller's context */
 			LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_thread: PACKET %p\n", (void *)msg));
 			msg->msg.inp.input_fn(msg->msg.inp.p, msg->msg.inp.netif);
 			memp_free(MEMP_TCPIP_MSG_INPKT, msg);
 			break;
-#endif							/* !LWIP_TCPIP_CORE_LOCKING_INPUT */
 
 #if LWIP_TCPIP_TIMEOUT			// && LWIP_TIMERS
 		case TCPIP_MSG_TIMEOUT:
@@ -191,16 +191,19 @@ static void tcpip_thread(void *arg)
 err_t tcpip_inpkt(struct pbuf *p, struct netif *inp, netif_input_fn input_fn)
 {
 	//LWIP_DEBUGF(TCPIP_DEBUG, ("Entry tcpip_input"));
-#if LWIP_TCPIP_CORE_LOCKING_INPUT
-	err_t ret;
-	LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_inpkt: PACKET %p/%p\n", (void *)p, (void *)inp));
-	LOCK_TCPIP_CORE();
-	ret = input_fn(p, inp);
-	UNLOCK_TCPIP_CORE();
-	return ret;
-#else							/* LWIP_TCPIP_CORE_LOCKING_INPUT */
 	struct tcpip_msg *msg;
 
+#if LWIP_TCPIP_CORE_LOCKING_INPUT
+	if (LWIP_TCPIP_INPUT_CAN_LOCK()) {
+		err_t ret;
+		LWIP_DEBUGF(TCPIP_DEBUG, ("tcpip_inpkt: PACKET %p/%p\n", (void *)p, (void *)inp));
+		LOCK_TCPIP_CORE();
+		ret = input_fn(p, inp);
+		UNLOCK_TCPIP_CORE();
+		return ret;
+	}
+#endif							/* LWIP_TCPIP_CORE_LOCKING_INPUT */
+
 	LWIP_ASSERT("Invalid mbox", sys_mbox_valid_val(mbox));
 
 	msg = (struct tcpip_msg *)memp_malloc(MEMP_TCPIP_MSG_INPKT);
@@ -217,7 +220,6 @@ err_t tcpip_inpkt(struct pbuf *p, struct netif *inp, netif_input_fn input_fn)
 		return ERR_MEM;
 	}
 	return ERR_OK;
-#endif							/* LWIP_TCPIP_CORE_LOCKING_INPUT */
 }
 
 /**
@@ -27,7 +27,7 @@
  * \#define LWIP_CHKSUM your_checksum_routine
  *
  * Or you can select from the implementations below by defining
- * LWIP_CHKSUM_ALGORITHM to 1, 2 or 3.
+ * LWIP_CHKSUM_ALGORITHM to 1, 2, 3 or 4.
  */
 
 /*
@@ -269,6 +269,202 @@ u16_t lwip_standard_chksum(const void *dataptr, int len)
 }
 #endif
 
+#if (LWIP_CHKSUM_ALGORITHM == 4) || (LWIP_CHKSUM_COPY_ALGORITHM == 2)
+/* The assembly loop is opt-in (LWIP_CHKSUM_ARM_ASM).  Thumb-1 (e.g.
+ * Cortex-M0) has no 32-bit adc with immediate, so it uses C there anyway.
+ */
+#if !defined(LWIP_CHKSUM_ARM_ASM) || !defined(__GNUC__) || !defined(__arm__) || (defined(__thumb__) && !defined(__thumb2__))
+#undef LWIP_CHKSUM_ARM_ASM
+#define LWIP_CHKSUM_ARM_ASM 0
+#endif
+
+/** Add up 32-bit aligned words with end-around carry, 4 words per round.
+ * If dst is not NULL, the words are also copied there (dst must be
+ * 32-bit aligned, too).
+ *
+ * @return sum + all words, carries folded back into bit 0
+ */
+static u32_t lwip_chksum_words(u32_t *dst, const u32_t *src, int nwords, u32_t sum)
+{
+	int nblocks = nwords >> 2;
+
+	nwords &= 3;
+#if LWIP_CHKSUM_ARM_ASM
+	if (nblocks > 0) {
+		if (dst == NULL) {
+			__asm__ volatile("1:	ldmia	%[src]!, {r3, r4, r5, r6}\n\t"
+							 "	adds	%[sum], %[sum], r3\n\t"
+							 "	adcs	%[sum], %[sum], r4\n\t"
+							 "	adcs	%[sum], %[sum], r5\n\t"
+							 "	adcs	%[sum], %[sum], r6\n\t"
+							 "	adc	%[sum], %[sum], #0\n\t"
+							 "	subs	%[n], %[n], #1\n\t"
+							 "	bne	1b\n\t"
+							 : [src] "+r"(src), [sum] "+r"(sum), [n] "+r"(nblocks)
+							 :
+							 : "r3", "r4", "r5", "r6", "cc", "memory");
+		} else {
+			__asm__ volatile("1:	ldmia	%[src]!, {r3, r4, r5, r6}\n\t"
+							 "	stmia	%[dst]!, {r3, r4, r5, r6}\n\t"
+							 "	adds	%[sum], %[sum], r3\n\t"
+							 "	adcs	%[sum], %[sum], r4\n\t"
+							 "	adcs	%[sum], %[sum], r5\n\t"
+							 "	adcs	%[sum], %[sum], r6\n\t"
+							 "	adc	%[sum], %[sum], #0\n\t"
+							 "	subs	%[n], %[n], #1\n\t"
+							 "	bne	1b\n\t"
+							 : [src] "+r"(src), [dst] "+r"(dst), [sum] "+r"(sum), [n] "+r"(nblocks)
+							 :
+							 : "r3", "r4", "r5", "r6", "cc", "memory");
+		}
+	}
+#else							/* LWIP_CHKSUM_ARM_ASM */
+	/* Count the carries out of the 32-bit sum instead of testing each
+	   one; at most 4 per block, so the counter can't overflow for the
+	   4k blocks of a 64k buffer */
+	{
+		u32_t carry = 0, t, w0, w1, w2, w3;
+
+		while (nblocks-- > 0) {
+			w0 = src[0];
+			w1 = src[1];
+			w2 = src[2];
+			w3 = src[3];
+			src += 4;
+			if (dst != NULL) {
+				dst[0] = w0;
+				dst[1] = w1;
+				dst[2] = w2;
+				dst[3] = w3;
+				dst += 4;
+			}
+			t = sum + w0;
+			carry += (t < sum);
+			sum = t + w1;
+			carry += (sum < t);
+			t = sum + w2;
+			carry += (t < sum);
+			sum = t + w3;
+			carry += (sum < t);
+		}
+		sum += carry;
+		if (sum < carry) {
+			sum++;				/* add back carry */
+		}
+	}
+#endif							/* LWIP_CHKSUM_ARM_ASM */
+
+	while (nwords-- > 0) {
+		u32_t w = *src++;
+		if (dst != NULL) {
+			*dst++ = w;
+		}
+		sum += w;
+		if (sum < w) {
+			sum++;				/* add back carry */
+		}
+	}
+
+	return sum;
+}
+
+/** Checksum len bytes at src, copying them to dst if that is not NULL.
+ * src and dst must have the same alignment modulo 4.
+ *
+ * @return host order (!) lwip checksum (non-inverted Internet sum)
+ */
+static u16_t lwip_chksum_copy_words(u8_t *dst, const u8_t *src, int len)
+{
+	u16_t t = 0;
+	u16_t w;
+	u32_t sum = 0;
+	int nwords;
+	/* starts at odd byte address? */
+	int odd = ((mem_ptr_t) src & 1);
+
+	if (odd && len > 0) {
+		((u8_t *)&t)[1] = *src;
+		if (dst != NULL) {
+			*dst++ = *src;
+		}
+		src++;
+		len--;
+	}
+
+	if (((mem_ptr_t) src & 2) && len > 1) {
+		w = *(const u16_t *)(const void *)src;
+		if (dst != NULL) {
+			*(u16_t *)(void *)dst = w;
+			dst += 2;
+		}
+		sum += w;
+		src += 2;
+		len -= 2;
+	}
+
+	nwords = len >> 2;
+	if (nwords > 0) {
+		sum = lwip_chksum_words((u32_t *)(void *)dst, (const u32_t *)(const void *)src, nwords, sum);
+		src += nwords << 2;
+		if (dst != NULL) {
+			dst += nwords << 2;
+		}
+		len &= 3;
+	}
+
+	/* make room in upper bits */
+	sum = FOLD_U32T(sum);
+	sum = FOLD_U32T(sum);
+
+	/* 16-bit aligned word remaining? */
+	if (len > 1) {
+		w = *(const u16_t *)(const void *)src;
+		if (dst != NULL) {
+			*(u16_t *)(void *)dst = w;
+			dst += 2;
+		}
+		sum += w;
+		src += 2;
+		len -= 2;
+	}
+
+	/* dangling tail byte remaining? */
+	if (len > 0) {
+		((u8_t *)&t)[0] = *src;
+		if (dst != NULL) {
+			*dst = *src;
+		}
+	}
+
+	sum += t;					/* add end bytes */
+
+	sum = FOLD_U32T(sum);
+	sum = FOLD_U32T(sum);
+
+	if (odd) {
+		sum = SWAP_BYTES_IN_WORD(sum);
+	}
+
+	return (u16_t) sum;
+}
+#endif							/* (LWIP_CHKSUM_ALGORITHM == 4) || (LWIP_CHKSUM_COPY_ALGORITHM == 2) */
+
+#if (LWIP_CHKSUM_ALGORITHM == 4)	/* Alternative version #4 */
+/**
+ * Like version #3, but sums 16 bytes per loop, with an ARM assembly
+ * inner loop (ldmia + adcs chain) if LWIP_CHKSUM_ARM_ASM is set and the
+ * target is ARM or Thumb-2.
+ *
+ * @param dataptr points to start of data to be summed at any boundary
+ * @param len length of data to be summed
+ * @return host order (!) lwip checksum (non-inverted Internet sum)
+ */
+u16_t lwip_standard_chksum(const void *dataptr, int len)
+{
+	return lwip_chksum_copy_words(NULL, (const u8_t *)dataptr, len);
+}
+#endif
+
 /** Parts of the pseudo checksum which are common to IPv4 and IPv6 */
 static u16_t inet_cksum_pseudo_base(struct pbuf *p, u8_t proto, u16_t proto_len, u32_t acc)
 {
@@ -601,3 +797,19 @@ u16_t lwip_chksum_copy(void *dst, const void *src, u16_t len)
 	return LWIP_CHKSUM(dst, len);
 }
 #endif							/* (LWIP_CHKSUM_COPY_ALGORITHM == 1) */
+
+#if (LWIP_CHKSUM_COPY_ALGORITHM == 2)	/* Version #2 */
+/** Copy and checksum in one pass over the data, with the word loop of
+ * LWIP_CHKSUM_ALGORITHM 4. Falls back to version #1 if src and dst are not
+ * equally aligned, which word copies cannot handle.
+ */
+u16_t lwip_chksum_copy(void *dst, const void *src, u16_t len)
+{
+	if ((((mem_ptr_t) dst ^ (mem_ptr_t) src) & 3) != 0) {
+		MEMCPY(dst, src, len);
+		return LWIP_CHKSUM(dst, len);
+	}
+	return lwip_chksum_copy_words((u8_t *)dst, (const u8_t *)src, len);
+}
+#endif							/* (LWIP_CHKSUM_COPY_ALGORITHM == 2) */
+
@@ -600,6 +600,10 @@ static void dhcp_handle_ack(struct netif *netif)
 	ip4_addr_set_zero(&dhcp->offered_si_addr);
 #endif /* LWIP_DHCP_BOOTP_FILE */
 
+	/* an INIT-REBOOT exchange has no OFFER, take the server from the ACK */
+	if (dhcp_option_given(dhcp, DHCP_OPTION_IDX_SERVER_ID)) {
+		ip_addr_set_ip4_u32(&dhcp->server_ip_addr, lwip_htonl(dhcp_get_option_value(dhcp, DHCP_OPTION_IDX_SERVER_ID)));
+	}
 	/* lease time given? */
 	if (dhcp_option_given(dhcp, DHCP_OPTION_IDX_LEASE_TIME)) {
 		/* remember offered lease time */
@@ -725,19 +729,15 @@ void dhcp_hostname(struct netif *netif, char *name)
 #endif
 
 /**
- * @ingroup dhcp4
- * Start DHCP negotiation for a network interface.
- *
- * If no DHCP client instance was attached to this interface,
- * a new client is created first. If a DHCP client instance
- * was already present, it restarts negotiation.
+ * Start DHCP negotiation for a network interface, either from scratch
+ * (DISCOVER) or, when a previously leased address is given, by asking
+ * the server to confirm it in the INIT-REBOOT state.
  *
  * @param netif The lwIP network interface
+ * @param addr previously leased address to reboot with, NULL to discover
  * @return lwIP error code
- * - ERR_OK - No error
- * - ERR_MEM - Out of memory
  */
-err_t dhcp_start(struct netif *netif)
+static err_t dhcp_start_client(struct netif *netif, const ip4_addr_t *addr)
 {
 	struct dhcp *dhcp;
 	err_t result;
@@ -792,16 +792,26 @@ err_t dhcp_start(struct netif *netif)
 	}
 	dhcp->pcb_allocated = 1;
 
+	if (addr != NULL) {
+		ip4_addr_copy(dhcp->offered_ip_addr, *addr);
+	}
+
 #if LWIP_DHCP_CHECK_LINK_UP
 	if (!netif_is_link_up(netif)) {
-		/* set state INIT and wait for dhcp_network_changed() to call dhcp_discover() */
-		dhcp_set_state(dhcp, DHCP_STATE_INIT);
+		/* set state INIT (or REBOOTING) and wait for dhcp_network_changed()
+		   to call dhcp_discover() (or dhcp_reboot()) */
+		dhcp_set_state(dhcp, addr != NULL ? DHCP_STATE_REBOOTING : DHCP_STATE_INIT);
 		return ERR_OK;
 	}
 #endif /* LWIP_DHCP_CHECK_LINK_UP */
 
-	/* (re)start the DHCP negotiation */
-	result = dhcp_discover(netif);
+	/* (re)start the DHCP negotiation. A REBOOTING client that gets a NAK
+	   or no answer after REBOOT_TRIES falls back to dhcp_discover() */
+	if (addr != NULL) {
+		result = dhcp_reboot(netif);
+	} else {
+		result = dhcp_discover(netif);
+	}
 	if (result != ERR_OK) {
 		/* free resources allocated above */
 		dhcp_stop(netif);
@@ -810,6 +820,46 @@ err_t dhcp_start(struct netif *netif)
 	return result;
 }
 
+/**
+ * @ingroup dhcp4
+ * Start DHCP negotiation for a network interface.
+ *
+ * If no DHCP client instance was attached to this interface,
+ * a new client is created first. If a DHCP client instance
+ * was already present, it restarts negotiation.
+ *
+ * @param netif The lwIP network interface
+ * @return lwIP error code
+ * - ERR_OK - No error
+ * - ERR_MEM - Out of memory
+ */
+err_t dhcp_start(struct netif *netif)
+{
+	return dhcp_start_client(netif, NULL);
+}
+
+/**
+ * @ingroup dhcp4
+ * Start DHCP for a network interface by requesting a previously leased
+ * address (INIT-REBOOT, RFC 2131 4.3.2) instead of discovering a new one.
+ * This saves the DISCOVER/OFFER round trip when rejoining a known network.
+ * If the server NAKs the address or does not answer, the client falls
+ * back to the full DISCOVER sequence on its own.
+ *
+ * @param netif The lwIP network interface
+ * @param addr the address leased on the previous connection
+ * @return lwIP error code
+ * - ERR_OK - No error
+ * - ERR_MEM - Out of memory
+ * - ERR_ARG - addr is NULL or any
+ */
+err_t dhcp_start_reboot(struct netif *netif, const ip4_addr_t *addr)
+{
+	LWIP_ERROR("dhcp_start_reboot: invalid addr", (addr != NULL) && !ip4_addr_isany(addr), return ERR_ARG;);
+
+	return dhcp_start_client(netif, addr);
+}
+
 /**
  * @ingroup dhcp4
  * Inform a DHCP server of our manual configuration.
@@ -1937,6 +1987,34 @@ u8_t dhcp_supplied_address(const struct netif *netif)
 	return 0;
 }
 
+/**
+ * @ingroup dhcp4
+ * Get the lease DHCP supplied netif->ip_addr with, to request the same
+ * address later with dhcp_start_reboot()
+ *
+ * @param netif the netif to check
+ * @param addr the leased address
+ * @param server the address of the server which granted it
+ * @param lease_time the lease time in seconds
+ * @return ERR_OK, or ERR_VAL if DHCP didn't supply netif->ip_addr
+ */
+err_t dhcp_get_lease(const struct netif *netif, ip4_addr_t *addr, ip4_addr_t *server, u32_t *lease_time)
+{
+	struct dhcp *dhcp;
+
+	LWIP_ERROR("dhcp_get_lease: invalid args", (addr != NULL) && (server != NULL) && (lease_time != NULL), return ERR_ARG;);
+
+	if (!dhcp_supplied_address(netif)) {
+		return ERR_VAL;
+	}
+	dhcp = netif_dhcp_data(netif);
+	ip4_addr_copy(*addr, dhcp->offered_ip_addr);
+	ip4_addr_copy(*server, *ip_2_ip4(&dhcp->server_ip_addr));
+	*lease_time = dhcp->offered_t0_lease;
+
+	return ERR_OK;
+}
+
 /** check if DHCP supplied netif->ip_addr
  *
  * @param netif the netif to check
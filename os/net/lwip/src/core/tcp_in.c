@@ -988,6 +988,9 @@ static void tcp_receive(struct tcp_pcb *pcb)
 	u32_t right_wnd_edge;
 	u16_t new_tot_len;
 	int found_dupack = 0;
+#if LWIP_TCP_SACK
+	int partial_ack = 0;
+#endif							/* LWIP_TCP_SACK */
 #if TCP_OOSEQ_MAX_BYTES || TCP_OOSEQ_MAX_PBUFS
 	u32_t ooseq_blen;
 	u16_t ooseq_qlen;
@@ -1061,6 +1064,13 @@ static void tcp_receive(struct tcp_pcb *pcb)
 							if ((u8_t)(pcb->dupacks + 1) > pcb->dupacks) {
 								++pcb->dupacks;
 							}
+#if LWIP_TCP_SACK
+							if ((pcb->flags & (TF_SACK | TF_INFR)) == (TF_SACK | TF_INFR) && tcp_rexmit_sack(pcb)) {
+								/* In SACK recovery each duplicate ACK stands for one more
+								   segment that left the network: spend it on the next hole
+								   rather than on inflating the window for new data. */
+							} else
+#endif							/* LWIP_TCP_SACK */
 							if (pcb->dupacks > 3) {
 								/* Inflate the congestion window, but not if it means that
 								   the value overflows. */
@@ -1087,8 +1097,17 @@ static void tcp_receive(struct tcp_pcb *pcb)
 			   in fast retransmit. Also reset the congestion window to the
 			   slow start threshold. */
 			if (pcb->flags & TF_INFR) {
-				pcb->flags &= ~TF_INFR;
-				pcb->cwnd = pcb->ssthresh;
+#if LWIP_TCP_SACK
+				if ((pcb->flags & TF_SACK) && TCP_SEQ_LT(ackno, pcb->recover)) {
+					/* Partial ACK: there are more holes to repair, stay in
+					   fast recovery (RFC 6675, section 5). */
+					partial_ack = 1;
+				} else
+#endif							/* LWIP_TCP_SACK */
+				{
+					pcb->flags &= ~TF_INFR;
+					pcb->cwnd = pcb->ssthresh;
+				}
 			}
 
 			/* Reset the number of retransmissions. */
@@ -1148,6 +1167,12 @@ static void tcp_receive(struct tcp_pcb *pcb)
 				pcb->rtime = 0;
 			}
 
+#if LWIP_TCP_SACK
+			if (partial_ack) {
+				tcp_rexmit_sack(pcb);
+			}
+#endif							/* LWIP_TCP_SACK */
+
 			pcb->polltmr = 0;
 
 #if LWIP_IPV6 && LWIP_ND6_TCP_REACHABILITY_HINTS
@@ -1452,6 +1477,13 @@ static void tcp_receive(struct tcp_pcb *pcb)
 #endif							/* TCP_QUEUE_OOSEQ */
 
 				/* Acknowledge the segment(s). */
+#if LWIP_TCP_SACK
+				if (pcb->ooseq != NULL) {
+					/* A hole was filled but data is still missing: tell the
+					   sender right away, with up to date SACK blocks. */
+					tcp_ack_now(pcb);
+				} else
+#endif							/* LWIP_TCP_SACK */
 				tcp_ack(pcb);
 
 #if LWIP_IPV6 && LWIP_ND6_TCP_REACHABILITY_HINTS
@@ -1463,7 +1495,9 @@ static void tcp_receive(struct tcp_pcb *pcb)
 
 			} else {
 				/* We get here if the incoming segment is out-of-sequence. */
+#if !LWIP_TCP_SACK
 				tcp_send_empty_ack(pcb);
+#endif							/* !LWIP_TCP_SACK */
 #if TCP_QUEUE_OOSEQ
 				/* We queue the segment on the ->ooseq queue. */
 				if (pcb->ooseq == NULL) {
@@ -1604,6 +1638,12 @@ static void tcp_receive(struct tcp_pcb *pcb)
 					}
 				}
 #endif							/* TCP_OOSEQ_MAX_BYTES || TCP_OOSEQ_MAX_PBUFS */
+#if LWIP_TCP_SACK
+				/* Only acknowledge now that the segment is on ->ooseq, so that
+				   the duplicate ACK reports it in its first SACK block. */
+				pcb->sack_recent = seqno;
+				tcp_send_empty_ack(pcb);
+#endif							/* LWIP_TCP_SACK */
 #endif							/* TCP_QUEUE_OOSEQ */
 			}
 		} else {
@@ -1630,6 +1670,55 @@ static u8_t tcp_getoptbyte(void)
 	}
 }
 
+#if LWIP_TCP_SACK
+/** Read a 32-bit value in network byte order from the options */
+static u32_t tcp_getoptlong(void)
+{
+	u32_t val;
+
+	val = (u32_t) tcp_getoptbyte() << 24;
+	val |= (u32_t) tcp_getoptbyte() << 16;
+	val |= (u32_t) tcp_getoptbyte() << 8;
+	val |= tcp_getoptbyte();
+	return val;
+}
+
+/**
+ * Enter one SACK block received from the remote host into the scoreboard:
+ * unacked segments it covers completely are marked as SACKed and the
+ * highest SACKed sequence number is updated.
+ *
+ * @param pcb the tcp_pcb the SACK block was received for
+ * @param left first sequence number of the block
+ * @param right sequence number following the block
+ */
+static void tcp_sack_update(struct tcp_pcb *pcb, u32_t left, u32_t right)
+{
+	struct tcp_seg *seg;
+	u32_t seg_seqno;
+
+	/* Ignore blocks that are empty or cover data we never sent */
+	if (!TCP_SEQ_LT(left, right) || TCP_SEQ_GT(right, pcb->snd_nxt)) {
+		return;
+	}
+
+	/* unacked is sorted and its headers are in network byte order */
+	for (seg = pcb->unacked; seg != NULL; seg = seg->next) {
+		seg_seqno = lwip_ntohl(seg->tcphdr->seqno);
+		if (TCP_SEQ_GEQ(seg_seqno, right)) {
+			break;
+		}
+		if (TCP_SEQ_GEQ(seg_seqno, left) && TCP_SEQ_LEQ(seg_seqno + TCP_TCPLEN(seg), right)) {
+			seg->flags |= TF_SEG_SACKED;
+		}
+	}
+
+	if (!TCP_SEQ_BETWEEN(pcb->sack_high, pcb->lastack, pcb->snd_nxt) || TCP_SEQ_GT(right, pcb->sack_high)) {
+		pcb->sack_high = right;
+	}
+}
+#endif							/* LWIP_TCP_SACK */
+
 /**
  * Parses the options contained in the incoming segment.
  *
@@ -1645,6 +1734,10 @@ static void tcp_parseopt(struct tcp_pcb *pcb)
 #if LWIP_TCP_TIMESTAMPS
 	u32_t tsval;
 #endif
+#if LWIP_TCP_SACK
+	u32_t left;
+	u32_t right;
+#endif
 
 	/* Parse the TCP MSS option, if present. */
 	if (tcphdr_optlen != 0) {
@@ -1698,6 +1791,38 @@ static void tcp_parseopt(struct tcp_pcb *pcb)
 				}
 				break;
 #endif
+#if LWIP_TCP_SACK
+			case LWIP_TCP_OPT_SACK_PERM:
+				LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: SACK_PERM\n"));
+				if (tcp_getoptbyte() != LWIP_TCP_OPT_LEN_SACK_PERM || (tcp_optidx - 2 + LWIP_TCP_OPT_LEN_SACK_PERM) > tcphdr_optlen) {
+					/* Bad length */
+					LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: bad length\n"));
+					return;
+				}
+				/* SACK may only be used if both ends asked for it in the SYNs */
+				if (flags & TCP_SYN) {
+					pcb->flags |= TF_SACK;
+				}
+				break;
+			case LWIP_TCP_OPT_SACK:
+				LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: SACK\n"));
+				data = tcp_getoptbyte();
+				if (data < 2 + 8 || ((data - 2) & 7) != 0 || (tcp_optidx - 2 + data) > tcphdr_optlen) {
+					/* Bad length */
+					LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: bad length\n"));
+					return;
+				}
+				if ((pcb->flags & TF_SACK) && (flags & TCP_ACK) && !(flags & TCP_SYN)) {
+					for (data = (data - 2) / 8; data > 0; data--) {
+						left = tcp_getoptlong();
+						right = tcp_getoptlong();
+						tcp_sack_update(pcb, left, right);
+					}
+				} else {
+					tcp_optidx += data - 2;
+				}
+				break;
+#endif
 #if LWIP_TCP_TIMESTAMPS
 			case LWIP_TCP_OPT_TS:
 				LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: TS\n"));
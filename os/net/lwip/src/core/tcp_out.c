@@ -112,6 +112,18 @@
 /* Forward declarations.*/
 static err_t tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb, struct netif *netif);
 
+#if LWIP_TCP_SACK
+/* A hole retransmitted during SACK recovery is sent regardless of the window:
+   it lies below snd_nxt and the duplicate ACK that revealed it has already
+   taken a segment out of the network. */
+#define TCP_SEG_FITS_WND(pcb, seg, wnd) \
+		(((seg)->flags & TF_SEG_SACK_REXMIT) || \
+		 (lwip_ntohl((seg)->tcphdr->seqno) - (pcb)->lastack + (seg)->len <= (wnd)))
+#else
+#define TCP_SEG_FITS_WND(pcb, seg, wnd) \
+		(lwip_ntohl((seg)->tcphdr->seqno) - (pcb)->lastack + (seg)->len <= (wnd))
+#endif
+
 /** Allocate a pbuf and create a tcphdr at p->payload, used for output
  * functions other than the default tcp_output -> tcp_output_segment
  * (e.g. tcp_send_empty_ack, etc.)
@@ -781,6 +793,12 @@ err_t tcp_enqueue_flags(struct tcp_pcb *pcb, u8_t flags)
 			optflags |= TF_SEG_OPTS_WND_SCALE;
 		}
 #endif							/* LWIP_WND_SCALE */
+#if LWIP_TCP_SACK
+		if ((pcb->state != SYN_RCVD) || (pcb->flags & TF_SACK)) {
+			/* Same for SACK: only offer it in a <SYN,ACK> if the remote host did. */
+			optflags |= TF_SEG_OPTS_SACK_PERM;
+		}
+#endif							/* LWIP_TCP_SACK */
 	}
 #if LWIP_TCP_TIMESTAMPS
 	if ((pcb->flags & TF_TIMESTAMP)) {
@@ -869,6 +887,87 @@ static void tcp_build_wnd_scale_option(u32_t *opts)
 }
 #endif
 
+#if LWIP_TCP_SACK
+/** Build a SACK permitted option (2 bytes long) at the specified options pointer
+ *
+ * @param opts option pointer where to store the SACK permitted option
+ */
+static void tcp_build_sack_perm_option(u32_t *opts)
+{
+	/* Pad with two NOP options to make everything nicely aligned */
+	opts[0] = PP_HTONL(0x01010402);
+}
+
+/** Collect the SACK blocks to report for the data queued on ooseq
+ *
+ * Contiguous segments are merged into one block. The block holding the
+ * segment received last comes first, the others follow in sequence order
+ * (RFC 2018, section 4).
+ *
+ * @param pcb tcp_pcb
+ * @param blocks receives the left and right edge of each block
+ * @return number of blocks stored (at most LWIP_TCP_MAX_SACK_NUM)
+ */
+static u8_t tcp_get_sack_blocks(struct tcp_pcb *pcb, u32_t *blocks)
+{
+	struct tcp_seg *seg;
+	u32_t left;
+	u32_t right;
+	u8_t num = 0;
+	u8_t i;
+
+	if (!(pcb->flags & TF_SACK)) {
+		return 0;
+	}
+
+	/* ooseq headers were converted to host byte order by tcp_input() */
+	seg = pcb->ooseq;
+	while (seg != NULL) {
+		left = seg->tcphdr->seqno;
+		right = left + TCP_TCPLEN(seg);
+		for (seg = seg->next; seg != NULL && seg->tcphdr->seqno == right; seg = seg->next) {
+			right += TCP_TCPLEN(seg);
+		}
+
+		if (TCP_SEQ_BETWEEN(pcb->sack_recent, left, right - 1)) {
+			/* Move the others up, dropping the last one if the option is full */
+			i = (num < LWIP_TCP_MAX_SACK_NUM) ? num : LWIP_TCP_MAX_SACK_NUM - 1;
+			for (; i > 0; i--) {
+				blocks[2 * i] = blocks[2 * i - 2];
+				blocks[2 * i + 1] = blocks[2 * i - 1];
+			}
+			blocks[0] = left;
+			blocks[1] = right;
+			if (num < LWIP_TCP_MAX_SACK_NUM) {
+				num++;
+			}
+		} else if (num < LWIP_TCP_MAX_SACK_NUM) {
+			blocks[2 * num] = left;
+			blocks[2 * num + 1] = right;
+			num++;
+		}
+	}
+	return num;
+}
+
+/** Build a SACK option at the specified options pointer
+ *
+ * @param blocks left and right edges returned by tcp_get_sack_blocks()
+ * @param num number of blocks
+ * @param opts option pointer where to store the SACK option
+ */
+static void tcp_build_sack_option(const u32_t *blocks, u8_t num, u32_t *opts)
+{
+	u8_t i;
+
+	/* Pad with two NOP options to make everything nicely aligned */
+	opts[0] = lwip_htonl(0x01010500 | (2 + 8 * num));
+	for (i = 0; i < 2 * num; i++) {
+		opts[i + 1] = lwip_htonl(blocks[i]);
+	}
+}
+#endif							/* LWIP_TCP_SACK */
+
 /**
  * Send an ACK without data.
  *
@@ -880,15 +979,23 @@ err_t tcp_send_empty_ack(struct tcp_pcb *pcb)
 	struct pbuf *p;
 	u8_t optlen = 0;
 	struct netif *netif;
-#if LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP
+#if LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP || LWIP_TCP_SACK
 	struct tcp_hdr *tcphdr;
-#endif							/* LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP */
+#endif							/* LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP || LWIP_TCP_SACK */
+#if LWIP_TCP_SACK
+	u32_t sack_blocks[2 * LWIP_TCP_MAX_SACK_NUM];
+	u8_t num_sacks;
+#endif
 
 #if LWIP_TCP_TIMESTAMPS
 	if (pcb->flags & TF_TIMESTAMP) {
 		optlen = LWIP_TCP_OPT_LENGTH(TF_SEG_OPTS_TS);
 	}
 #endif
+#if LWIP_TCP_SACK
+	num_sacks = tcp_get_sack_blocks(pcb, sack_blocks);
+	optlen += LWIP_TCP_OPT_LEN_SACK_OUT(num_sacks);
+#endif
 
 	p = tcp_output_alloc_header(pcb, optlen, 0, lwip_htonl(pcb->snd_nxt));
 	if (p == NULL) {
@@ -897,9 +1004,9 @@ err_t tcp_send_empty_ack(struct tcp_pcb *pcb)
 		LWIP_DEBUGF(TCP_OUTPUT_DEBUG, ("tcp_output: (ACK) could not allocate pbuf\n"));
 		return ERR_BUF;
 	}
-#if LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP
+#if LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP || LWIP_TCP_SACK
 	tcphdr = (struct tcp_hdr *)p->payload;
-#endif							/* LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP */
+#endif							/* LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP || LWIP_TCP_SACK */
 	LWIP_DEBUGF(TCP_OUTPUT_DEBUG, ("tcp_output: sending ACK for %" U32_F "\n", pcb->rcv_nxt));
 
 	/* NB. MSS option is only sent on SYNs, so ignore it here */
@@ -910,6 +1017,12 @@ err_t tcp_send_empty_ack(struct tcp_pcb *pcb)
 		tcp_build_timestamp_option(pcb, (u32_t *)(tcphdr + 1));
 	}
 #endif
+#if LWIP_TCP_SACK
+	if (num_sacks > 0) {
+		/* the SACK option follows the timestamp option, if any */
+		tcp_build_sack_option(sack_blocks, num_sacks, (u32_t *)(void *)((u8_t *)(tcphdr + 1) + optlen - LWIP_TCP_OPT_LEN_SACK_OUT(num_sacks)));
+	}
+#endif
 
 	netif = ip_route(&pcb->local_ip, &pcb->remote_ip);
 	if (netif == NULL) {
@@ -966,6 +1079,15 @@ err_t tcp_output(struct tcp_pcb *pcb)
 	}
 
 	wnd = LWIP_MIN(pcb->snd_wnd, pcb->cwnd);
+#if LWIP_TCP_LIMITED_TRANSMIT
+	/* Limited transmit (RFC 3042): each of the first two duplicate ACKs lets
+	   one new segment out beyond cwnd, so that a small flight still produces
+	   enough duplicate ACKs to enter fast recovery instead of waiting for
+	   the retransmission timer. */
+	if (!(pcb->flags & TF_INFR) && pcb->dupacks > 0 && pcb->dupacks < 3) {
+		wnd = (tcpwnd_size_t)LWIP_MIN((u32_t)pcb->snd_wnd, (u32_t)pcb->cwnd + (u32_t)pcb->dupacks * pcb->mss);
+	}
+#endif
 
 	seg = pcb->unsent;
 
@@ -975,7 +1097,7 @@ err_t tcp_output(struct tcp_pcb *pcb)
 	 *
 	 * If data is to be sent, we will just piggyback the ACK (see below).
 	 */
-	if (pcb->flags & TF_ACK_NOW && (seg == NULL || lwip_ntohl(seg->tcphdr->seqno) - pcb->lastack + seg->len > wnd)) {
+	if (pcb->flags & TF_ACK_NOW && (seg == NULL || !TCP_SEG_FITS_WND(pcb, seg, wnd))) {
 		return tcp_send_empty_ack(pcb);
 	}
 
@@ -1027,7 +1149,7 @@ err_t tcp_output(struct tcp_pcb *pcb)
 		goto output_done;
 	}
 	/* data available and window allows it to be sent? */
-	while (seg != NULL && lwip_ntohl(seg->tcphdr->seqno) - pcb->lastack + seg->len <= wnd) {
+	while (seg != NULL && TCP_SEG_FITS_WND(pcb, seg, wnd)) {
 		LWIP_ASSERT("RST not expected here!", (TCPH_FLAGS(seg->tcphdr) & TCP_RST) == 0);
 		/* Stop sending if the nagle algorithm would prevent it
 		 * Don't stop:
@@ -1173,6 +1295,12 @@ static err_t tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb, struct
 		opts += 1;
 	}
 #endif
+#if LWIP_TCP_SACK
+	if (seg->flags & TF_SEG_OPTS_SACK_PERM) {
+		tcp_build_sack_perm_option(opts);
+		opts += 1;
+	}
+#endif
 
 	/* Set retransmission timer running if it is not currently enabled
 	   This must be set before checking the route. */
@@ -1333,6 +1461,15 @@ void tcp_rexmit_rto(struct tcp_pcb *pcb)
 	/* unacked queue is now empty */
 	pcb->unacked = NULL;
 
+#if LWIP_TCP_SACK
+	/* The remote host is allowed to discard data it has SACKed (RFC 2018,
+	   section 8), so everything is sent again and recovery starts over. */
+	for (seg = pcb->unsent; seg != NULL; seg = seg->next) {
+		seg->flags &= (u8_t)~(TF_SEG_SACKED | TF_SEG_SACK_REXMIT);
+	}
+	pcb->flags &= ~TF_INFR;
+#endif							/* LWIP_TCP_SACK */
+
 	/* increment number of retransmissions */
 	if (pcb->nrtx < 0xFF) {
 		++pcb->nrtx;
@@ -1346,26 +1483,20 @@ void tcp_rexmit_rto(struct tcp_pcb *pcb)
 }
 
 /**
- * Requeue the first unacked segment for retransmission
- *
- * Called by tcp_receive() for fast retramsmit.
+ * Move an unacked segment to the unsent queue
  *
- * @param pcb the tcp_pcb for which to retransmit the first unacked segment
+ * @param pcb the tcp_pcb owning the segment
+ * @param segp link on the unacked queue pointing to the segment
  */
-void tcp_rexmit(struct tcp_pcb *pcb)
+static void tcp_rexmit_unacked(struct tcp_pcb *pcb, struct tcp_seg **segp)
 {
 	struct tcp_seg *seg;
 	struct tcp_seg **cur_seg;
 
-	if (pcb->unacked == NULL) {
-		return;
-	}
+	seg = *segp;
+	*segp = seg->next;
 
-	/* Move the first unacked segment to the unsent queue */
 	/* Keep the unsent queue sorted. */
-	seg = pcb->unacked;
-	pcb->unacked = seg->next;
-
 	cur_seg = &(pcb->unsent);
 	while (*cur_seg && TCP_SEQ_LT(lwip_ntohl((*cur_seg)->tcphdr->seqno), lwip_ntohl(seg->tcphdr->seqno))) {
 		cur_seg = &((*cur_seg)->next);
@@ -1392,6 +1523,58 @@ void tcp_rexmit(struct tcp_pcb *pcb)
 	   and thus tcp_output directly returns. */
 }
 
+/**
+ * Requeue the first unacked segment for retransmission
+ *
+ * Called by tcp_receive() for fast retramsmit.
+ *
+ * @param pcb the tcp_pcb for which to retransmit the first unacked segment
+ */
+void tcp_rexmit(struct tcp_pcb *pcb)
+{
+	if (pcb->unacked == NULL) {
+		return;
+	}
+
+	/* Move the first unacked segment to the unsent queue */
+	tcp_rexmit_unacked(pcb, &pcb->unacked);
+}
+
+#if LWIP_TCP_SACK
+/**
+ * Requeue the first unacked segment the remote host is known to miss
+ *
+ * Called by tcp_receive() during fast recovery on a SACK connection. A
+ * segment is taken as lost when the remote host has SACKed data above it.
+ * Segments that were SACKed or already retransmitted in this recovery are
+ * skipped.
+ *
+ * @param pcb the tcp_pcb for which to retransmit a segment
+ * @return 1 if a segment was requeued, 0 if there is no hole to repair
+ */
+u8_t tcp_rexmit_sack(struct tcp_pcb *pcb)
+{
+	struct tcp_seg **cur_seg;
+
+	if (!TCP_SEQ_BETWEEN(pcb->sack_high, pcb->lastack + 1, pcb->snd_nxt)) {
+		return 0;
+	}
+
+	for (cur_seg = &(pcb->unacked); *cur_seg != NULL; cur_seg = &((*cur_seg)->next)) {
+		if (!TCP_SEQ_LT(lwip_ntohl((*cur_seg)->tcphdr->seqno), pcb->sack_high)) {
+			break;
+		}
+		if (((*cur_seg)->flags & (TF_SEG_SACKED | TF_SEG_SACK_REXMIT)) == 0) {
+			LWIP_DEBUGF(TCP_FR_DEBUG, ("tcp_rexmit_sack: retransmit %" U32_F ", highest SACKed %" U32_F "\n", lwip_ntohl((*cur_seg)->tcphdr->seqno), pcb->sack_high));
+			(*cur_seg)->flags |= TF_SEG_SACK_REXMIT;
+			tcp_rexmit_unacked(pcb, cur_seg);
+			return 1;
+		}
+	}
+	return 0;
+}
+#endif							/* LWIP_TCP_SACK */
+
 /**
  * Handle retransmission after three dupacks received
  *
@@ -1402,6 +1585,13 @@ void tcp_rexmit_fast(struct tcp_pcb *pcb)
 	if (pcb->unacked != NULL && !(pcb->flags & TF_INFR)) {
 		/* This is fast retransmit. Retransmit the first unacked segment. */
 		LWIP_DEBUGF(TCP_FR_DEBUG, ("tcp_receive: dupacks %" U16_F " (%" U32_F "), fast retransmit %" U32_F "\n", (u16_t) pcb->dupacks, pcb->lastack, lwip_ntohl(pcb->unacked->tcphdr->seqno)));
+#if LWIP_TCP_SACK
+		/* Recovery lasts until everything sent so far is acknowledged */
+		pcb->recover = pcb->snd_nxt;
+		if (pcb->flags & TF_SACK) {
+			pcb->unacked->flags |= TF_SEG_SACK_REXMIT;
+		}
+#endif							/* LWIP_TCP_SACK */
 		tcp_rexmit(pcb);
 
 		/* Set ssthresh to half of the minimum of the current
@@ -54,4 +54,12 @@ struct sys_mbox {
 
 typedef struct sys_mbox sys_mbox_t;
 
+// === CORE LOCK ===
+
+#ifdef CONFIG_NET_TCPIP_CORE_LOCKING
+void sys_lock_tcpip_core(void);
+void sys_unlock_tcpip_core(void);
+int sys_tcpip_core_can_lock(void);
+#endif
+
 #endif							/* __ARCH_SYS_ARCH_H__ */
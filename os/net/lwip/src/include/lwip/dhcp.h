@@ -123,6 +123,20 @@ void dhcp_cleanup(struct netif *netif);
 */
 err_t dhcp_start(struct netif *netif);
 
+/**
+ * @brief Start DHCP by requesting a previously leased address (INIT-REBOOT).
+ *	Falls back to DISCOVER if the server refuses the address or does not answer.
+ *
+ * @param netif The lwIP network interface
+ * @param addr the address leased on the previous connection
+ * @return lwIP error code
+ * - ERR_OK - No error
+ * - ERR_MEM - Out of memory
+ * - ERR_ARG - Invalid address
+ * @since TizenRT v3.1
+*/
+err_t dhcp_start_reboot(struct netif *netif, const ip4_addr_t *addr);
+
 /// @cond
 /** enforce early lease renewal (not needed normally)*/
 err_t dhcp_renew(struct netif *netif);
@@ -165,6 +179,7 @@ void dhcp_network_changed(struct netif *netif);
 void dhcp_arp_reply(struct netif *netif, const ip4_addr_t * addr);
 #endif
 u8_t dhcp_supplied_address(const struct netif *netif);
+err_t dhcp_get_lease(const struct netif *netif, ip4_addr_t *addr, ip4_addr_t *server, u32_t *lease_time);
 err_t dhcp_address_valid(struct netif *netif);
 /* to be called every minute */
 void dhcp_coarse_tmr(void);
@@ -432,6 +432,14 @@
 #define TCP_TIMESTAMPS	CONFIG_NET_TCP_TIMESTAMPS
 #endif
 
+#ifdef CONFIG_NET_TCP_SACK
+#define LWIP_TCP_SACK	CONFIG_NET_TCP_SACK
+#endif
+
+#ifdef CONFIG_NET_TCP_LIMITED_TRANSMIT
+#define LWIP_TCP_LIMITED_TRANSMIT	CONFIG_NET_TCP_LIMITED_TRANSMIT
+#endif
+
 #ifdef CONFIG_NET_TCP_KEEPALIVE
 #define LWIP_TCP_KEEPALIVE              CONFIG_NET_TCP_KEEPALIVE
 #endif
@@ -767,10 +775,14 @@
 
 #ifdef CONFIG_NET_TCPIP_CORE_LOCKING
 #define LWIP_TCPIP_CORE_LOCKING CONFIG_NET_TCPIP_CORE_LOCKING
+/* The core lock remembers its holder, see sys_arch.c */
+#define LOCK_TCPIP_CORE()	sys_lock_tcpip_core()
+#define UNLOCK_TCPIP_CORE()	sys_unlock_tcpip_core()
 #endif
 
 #ifdef CONFIG_NET_TCPIP_CORE_LOCKING_INPUT
 #define LWIP_TCPIP_CORE_LOCKING_INPUT CONFIG_NET_TCPIP_CORE_LOCKING_INPUT
+#define LWIP_TCPIP_INPUT_CAN_LOCK()	sys_tcpip_core_can_lock()
 #endif
 
 #ifdef CONFIG_NET_TCPIP_THREAD_NAME
@@ -787,6 +799,8 @@
 
 #ifdef CONFIG_NET_COMPAT_MUTEX
 #define LWIP_COMPAT_MUTEX	CONFIG_NET_COMPAT_MUTEX
+#else
+#define LWIP_COMPAT_MUTEX	0
 #endif
 
 #ifdef CONFIG_NET_SYS_LIGHTWEIGHT_PROT
@@ -1174,4 +1188,16 @@
 #define LWIP_NETIF_TX_SINGLE_PBUF             1
 #endif
 
+/* Word-at-a-time Internet checksum, see inet_chksum.c */
+#define LWIP_CHKSUM_ALGORITHM                 4
+
+#ifdef CONFIG_NET_LWIP_CHECKSUM_ARM_ASM
+#define LWIP_CHKSUM_ARM_ASM                   1
+#endif
+
+#ifdef CONFIG_NET_LWIP_CHECKSUM_ON_COPY
+#define LWIP_CHECKSUM_ON_COPY                 1
+#define LWIP_CHKSUM_COPY_ALGORITHM            2
+#endif
+
 #endif							/* __LWIP_LWIPOPTS_H__ */
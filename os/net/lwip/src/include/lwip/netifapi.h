@@ -85,6 +85,13 @@ struct netifapi_msg {
 			netifapi_void_fn voidfunc;
 			netifapi_errt_fn errtfunc;
 		} common;
+#if LWIP_IPV4 && LWIP_DHCP
+		struct {
+			ip4_addr_t *addr;
+			ip4_addr_t *server;
+			u32_t *lease_time;
+		} lease;
+#endif							/* LWIP_IPV4 && LWIP_DHCP */
 	} msg;
 };
 
@@ -101,6 +108,11 @@ err_t netifapi_netif_set_addr(struct netif *netif, const ip4_addr_t * ipaddr, co
 
 err_t netifapi_netif_common(struct netif *netif, netifapi_void_fn voidfunc, netifapi_errt_fn errtfunc);
 
+#if LWIP_IPV4 && LWIP_DHCP && LWIP_DHCP_TCPIP_THREAD
+err_t netifapi_dhcp_start_reboot(struct netif *netif, const ip4_addr_t * addr);
+err_t netifapi_dhcp_get_lease(struct netif *netif, ip4_addr_t * addr, ip4_addr_t * server, u32_t * lease_time);
+#endif							/* LWIP_IPV4 && LWIP_DHCP && LWIP_DHCP_TCPIP_THREAD */
+
 /** @ingroup netifapi_netif */
 #define netifapi_netif_remove(n)        netifapi_netif_common(n, netif_remove, NULL)
 /** @ingroup netifapi_netif */
@@ -140,6 +152,10 @@ err_t netifapi_netif_common(struct netif *netif, netifapi_void_fn voidfunc, neti
 /** @ingroup netifapi_dhcp4 */
 #define netifapi_dhcp_start(n)        dhcp_start(n)
 /** @ingroup netifapi_dhcp4 */
+#define netifapi_dhcp_start_reboot(n, a) dhcp_start_reboot(n, a)
+/** @ingroup netifapi_dhcp4 */
+#define netifapi_dhcp_get_lease(n, a, s, t) dhcp_get_lease(n, a, s, t)
+/** @ingroup netifapi_dhcp4 */
 #define netifapi_dhcp_stop(n)         dhcp_stop(n)
 /** @ingroup netifapi_dhcp4 */
 #define netifapi_dhcp_inform(n)       dhcp_inform(n)
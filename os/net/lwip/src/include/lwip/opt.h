@@ -179,12 +179,23 @@
  * instead of allocating a message and passing it to tcpip_thread.
  *
  * ATTENTION: this does not work when tcpip_input() is called from
- * interrupt context!
+ * interrupt context, unless LWIP_TCPIP_INPUT_CAN_LOCK() catches it.
  */
 #ifndef LWIP_TCPIP_CORE_LOCKING_INPUT
 #define LWIP_TCPIP_CORE_LOCKING_INPUT   0
 #endif
 
+/**
+ * LWIP_TCPIP_INPUT_CAN_LOCK(): with LWIP_TCPIP_CORE_LOCKING_INPUT, tcpip_input()
+ * only grabs the mutex and processes the packet itself if this evaluates to
+ * nonzero. Otherwise the packet is passed to tcpip_thread as if
+ * LWIP_TCPIP_CORE_LOCKING_INPUT was disabled. Ports use it to defer packets
+ * received in interrupt context or by a thread that already holds the mutex.
+ */
+#ifndef LWIP_TCPIP_INPUT_CAN_LOCK
+#define LWIP_TCPIP_INPUT_CAN_LOCK()     1
+#endif
+
 /**
  * SYS_LIGHTWEIGHT_PROT==1: enable inter-task protection (and task-vs-interrupt
  * protection) for certain critical regions during buffer allocation, deallocation
@@ -1277,6 +1288,29 @@
 #define LWIP_TCP_TIMESTAMPS             0
 #endif
 
+/**
+ * LWIP_TCP_SACK==1: support TCP Selective Acknowledgment (RFC 2018).
+ * SACK is negotiated in the SYN exchange. As a receiver, the segments on the
+ * ooseq queue are reported in the ACKs sent while a hole is outstanding. As a
+ * sender, SACKed segments are not retransmitted during fast recovery, and the
+ * holes below the highest SACKed sequence number are retransmitted one per
+ * duplicate ACK instead of waiting for the retransmission timer.
+ * Requires TCP_QUEUE_OOSEQ==1.
+ */
+#ifndef LWIP_TCP_SACK
+#define LWIP_TCP_SACK                   0
+#endif
+
+/**
+ * LWIP_TCP_LIMITED_TRANSMIT==1: send one new segment beyond cwnd for each of
+ * the first two duplicate ACKs (RFC 3042), so that small windows still
+ * produce enough duplicate ACKs to enter fast recovery instead of waiting
+ * for the retransmission timer.
+ */
+#ifndef LWIP_TCP_LIMITED_TRANSMIT
+#define LWIP_TCP_LIMITED_TRANSMIT       0
+#endif
+
 /**
  * TCP_WND_UPDATE_THRESHOLD: difference in window to trigger an
  * explicit window update
@@ -118,8 +118,6 @@ typedef void (*lwip_thread_fn)(void *arg);
 
 /** Define LWIP_COMPAT_MUTEX if the port has no mutexes and binary semaphores
     should be used instead */
-#define LWIP_COMPAT_MUTEX_ALLOWED
-
 #ifndef LWIP_COMPAT_MUTEX
 #define LWIP_COMPAT_MUTEX 1
 #endif
@@ -154,7 +154,7 @@ typedef u32_t tcpwnd_size_t;
 typedef u16_t tcpwnd_size_t;
 #endif
 
-#if LWIP_WND_SCALE || TCP_LISTEN_BACKLOG || LWIP_TCP_TIMESTAMPS
+#if LWIP_WND_SCALE || TCP_LISTEN_BACKLOG || LWIP_TCP_TIMESTAMPS || LWIP_TCP_SACK
 typedef u16_t tcpflags_t;
 #else
 typedef u8_t tcpflags_t;
@@ -230,6 +230,9 @@ struct tcp_pcb {
 #endif
 #if LWIP_TCP_TIMESTAMPS
 #define TF_TIMESTAMP   0x0400U	/* Timestamp option enabled */
+#endif
+#if LWIP_TCP_SACK
+#define TF_SACK        0x0800U	/* Selective Acknowledgment permitted by both ends */
 #endif
 
 	/* the rest of the fields are in host byte order
@@ -262,6 +265,11 @@ struct tcp_pcb {
 	/* fast retransmit/recovery */
 	u8_t dupacks;
 	u32_t lastack;			/* Highest acknowledged seqno. */
+#if LWIP_TCP_SACK
+	u32_t recover;			/* snd_nxt when fast recovery was entered */
+	u32_t sack_high;		/* Highest seqno SACKed by the remote host */
+	u32_t sack_recent;		/* seqno of the latest segment put on ooseq */
+#endif							/* LWIP_TCP_SACK */
 
 	/* congestion avoidance/control variables */
 	tcpwnd_size_t cwnd;
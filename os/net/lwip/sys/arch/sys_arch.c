@@ -32,6 +32,7 @@
 #include <tinyara/kthread.h>
 #include <tinyara/semaphore.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 /* lwIP includes. */
 #include "lwip/stats.h"
@@ -42,6 +43,7 @@
 #include "lwip/mem.h"
 #include "lwip/memp.h"
 #include "lwip/pbuf.h"
+#include "lwip/tcpip.h"
 #include "lwip/arch/cc.h"
 
 /* TinyAra RTOS implementation of the lwip operating system abstraction */
@@ -576,19 +578,30 @@ void sys_init(void)
 /* Create a new mutex*/
 err_t sys_mutex_new(sys_mutex_t *mutex)
 {
+	pthread_mutexattr_t attr;
 	int status = 0;
 
-	if (NULL == mutex) {
-		mutex = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
-	}
 	if (mutex == NULL) {
 #if SYS_STATS
 		SYS_STATS_INC(mutex.err);
 #endif							/* SYS_STATS */
-		return ERR_MEM;
+		return ERR_VAL;
 	}
-	status = pthread_mutex_init(mutex, NULL);
+
+	/* The tcpip core lock is taken by every socket call when
+	 * LWIP_TCPIP_CORE_LOCKING is enabled, so a low priority thread holding
+	 * it must not be able to stall a high priority one.
+	 */
+	pthread_mutexattr_init(&attr);
+#ifdef CONFIG_PRIORITY_INHERITANCE
+	pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+#endif
+	status = pthread_mutex_init(mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
 	if (status) {
+#if SYS_STATS
+		SYS_STATS_INC(mutex.err);
+#endif							/* SYS_STATS */
 		return ERR_MEM;
 	}
 #if SYS_STATS
@@ -639,6 +652,40 @@ void sys_mutex_unlock(sys_mutex_t *mutex)
 #endif							/*LWIP_COMPAT_MUTEX */
 /*-----------------------------------------------------------------------------------*/
 
+#if LWIP_TCPIP_CORE_LOCKING
+/* Thread holding the tcpip core lock, -1 if none */
+static volatile pid_t g_core_lock_holder = -1;
+
+/*-----------------------------------------------------------------------------------*/
+/* Lock the tcpip core and remember the holder*/
+void sys_lock_tcpip_core(void)
+{
+	sys_mutex_lock(&lock_tcpip_core);
+	g_core_lock_holder = getpid();
+}
+
+/*-----------------------------------------------------------------------------------*/
+/* Unlock the tcpip core*/
+void sys_unlock_tcpip_core(void)
+{
+	g_core_lock_holder = -1;
+	sys_mutex_unlock(&lock_tcpip_core);
+}
+
+/*-----------------------------------------------------------------------------------*/
+/* Check whether the caller may block on the tcpip core lock.
+ * Drivers pass received packets to netdev_input() from interrupt handlers,
+ * from their own threads and sometimes from their linkoutput, i.e. from
+ * inside lwIP with the lock already held. Only the second case may take
+ * the lock, the others queue the packet to tcpip_thread.
+ */
+int sys_tcpip_core_can_lock(void)
+{
+	return !up_interrupt_context() && g_core_lock_holder != getpid();
+}
+#endif							/* LWIP_TCPIP_CORE_LOCKING */
+/*-----------------------------------------------------------------------------------*/
+
 u32_t sys_now(void)
 {
 	return TICK2MSEC(clock_systimer());
@@ -0,0 +1,247 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include "test_chksum.h"
+
+#include "lwip/inet_chksum.h"
+#include "lwip/pbuf.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if !LWIP_CHECKSUM_ON_COPY || (LWIP_CHKSUM_COPY_ALGORITHM != 2)
+#error "This test needs LWIP_CHECKSUM_ON_COPY with LWIP_CHKSUM_COPY_ALGORITHM 2"
+#endif
+
+/* not exported by inet_chksum.h, the default LWIP_CHKSUM */
+u16_t lwip_standard_chksum(const void *dataptr, int len);
+
+#define CHK_MAX_LEN      1600	/* lengths up to a bit more than an ethernet frame */
+#define CHK_GUARD        0xa5
+#define CHK_BENCH_LEN    1460	/* a TCP segment */
+#define CHK_BENCH_BYTES  (64 * 1024 * 1024)
+
+/* 4 bytes of slack to move the start to every alignment, 1 guard byte */
+static u32_t chk_src_words[(CHK_MAX_LEN + 8) / 4];
+static u32_t chk_dst_words[(CHK_MAX_LEN + 8) / 4];
+static u8_t *const chk_src = (u8_t *)chk_src_words;
+static u8_t *const chk_dst = (u8_t *)chk_dst_words;
+
+/** RFC 1071 one octet pair at a time, as LWIP_CHKSUM_ALGORITHM 1 */
+static u16_t chk_reference(const u8_t *data, int len)
+{
+	u32_t acc = 0;
+
+	while (len > 1) {
+		acc += (data[0] << 8) | data[1];
+		data += 2;
+		len -= 2;
+	}
+	if (len > 0) {
+		acc += data[0] << 8;
+	}
+	while (acc >> 16) {
+		acc = (acc >> 16) + (acc & 0xffff);
+	}
+	return lwip_htons((u16_t)acc);
+}
+
+static void chk_fill(u8_t *buf, int len, u32_t seed)
+{
+	int i;
+
+	for (i = 0; i < len; i++) {
+		seed = seed * 1103515245 + 12345;
+		buf[i] = (u8_t)(seed >> 16);
+	}
+}
+
+/* Setups/teardown functions */
+
+static void chksum_setup(void)
+{
+}
+
+static void chksum_teardown(void)
+{
+}
+
+/* Test functions */
+
+/** lwip_standard_chksum() against the reference for every start alignment
+ * and length, on random data and on all-ones data that carries out of
+ * every add
+ */
+START_TEST(test_chksum_aligned_lengths)
+{
+	int pattern, align, len;
+	LWIP_UNUSED_ARG(_i);
+
+	for (pattern = 0; pattern < 3; pattern++) {
+		if (pattern == 0) {
+			chk_fill(chk_src, CHK_MAX_LEN + 4, 0x1234);
+		} else {
+			memset(chk_src, pattern == 1 ? 0xff : 0x00, CHK_MAX_LEN + 4);
+		}
+		for (align = 0; align < 4; align++) {
+			for (len = 0; len <= CHK_MAX_LEN; len++) {
+				u16_t expected = chk_reference(chk_src + align, len);
+				u16_t sum = lwip_standard_chksum(chk_src + align, len);
+				if (sum != expected) {
+					printf("chksum mismatch: align %d len %d: %04x != %04x\n", align, len, sum, expected);
+				}
+				EXPECT_RET(sum == expected);
+			}
+		}
+	}
+}
+
+END_TEST
+/** lwip_chksum_copy() for every src and dst alignment: the checksum, the
+ * copied data and the bytes around it
+ */
+START_TEST(test_chksum_copy)
+{
+	int src_align, dst_align, len;
+	LWIP_UNUSED_ARG(_i);
+
+	chk_fill(chk_src, CHK_MAX_LEN + 4, 0x5678);
+	for (src_align = 0; src_align < 4; src_align++) {
+		for (dst_align = 0; dst_align < 4; dst_align++) {
+			for (len = 0; len <= CHK_MAX_LEN; len += (len < 64 ? 1 : 61)) {
+				u16_t expected = chk_reference(chk_src + src_align, len);
+				u16_t sum;
+				int i;
+
+				memset(chk_dst, CHK_GUARD, CHK_MAX_LEN + 8);
+				sum = lwip_chksum_copy(chk_dst + dst_align, chk_src + src_align, (u16_t)len);
+				EXPECT_RET(sum == expected);
+				EXPECT_RET(memcmp(chk_dst + dst_align, chk_src + src_align, len) == 0);
+				for (i = 0; i < dst_align; i++) {
+					EXPECT_RET(chk_dst[i] == CHK_GUARD);
+				}
+				EXPECT_RET(chk_dst[dst_align + len] == CHK_GUARD);
+			}
+		}
+	}
+}
+
+END_TEST
+/** inet_chksum_pbuf() over a chain of odd-sized pbufs, and
+ * pbuf_fill_chksum() (UDP checksum-on-copy) of the same pieces at odd
+ * offsets, equal the checksum of the flat data
+ */
+START_TEST(test_chksum_pbuf_chain)
+{
+	static const u16_t lens[] = { 1, 7, 64, 3, 2, 255, 1000 };
+	struct pbuf *p = NULL;
+	struct pbuf *q;
+	u16_t chksum = 0;
+	u16_t total = 0;
+	size_t i;
+	LWIP_UNUSED_ARG(_i);
+
+	chk_fill(chk_src, CHK_MAX_LEN, 0x9abc);
+	for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+		q = pbuf_alloc(PBUF_RAW, lens[i], PBUF_RAM);
+		EXPECT_RET(q != NULL);
+		MEMCPY(q->payload, chk_src + total, lens[i]);
+		total += lens[i];
+		if (p == NULL) {
+			p = q;
+		} else {
+			pbuf_cat(p, q);
+		}
+	}
+	EXPECT(inet_chksum_pbuf(p) == (u16_t)~chk_reference(chk_src, total));
+	pbuf_free(p);
+
+	p = pbuf_alloc(PBUF_RAW, total, PBUF_RAM);
+	EXPECT_RET(p != NULL);
+	total = 0;
+	for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+		EXPECT(pbuf_fill_chksum(p, total, chk_src + total, lens[i], &chksum) == ERR_OK);
+		total += lens[i];
+	}
+	EXPECT(chksum == chk_reference(chk_src, total));
+	EXPECT(memcmp(p->payload, chk_src, total) == 0);
+	pbuf_free(p);
+}
+
+END_TEST
+/** Not a pass/fail test: checksum throughput of the byte pair reference,
+ * lwip_standard_chksum(), MEMCPY followed by lwip_standard_chksum() and
+ * the fused lwip_chksum_copy() for each alignment of a TCP segment
+ */
+START_TEST(test_chksum_benchmark)
+{
+	int align, rounds, i;
+	volatile u16_t sink = 0;
+	clock_t start;
+	double mbps[4];
+	LWIP_UNUSED_ARG(_i);
+
+	rounds = CHK_BENCH_BYTES / CHK_BENCH_LEN;
+	chk_fill(chk_src, CHK_MAX_LEN + 4, 0xdef0);
+
+	printf("\nchecksum throughput over %d byte buffers (MB/s)\n", CHK_BENCH_LEN);
+	printf("align    reference  lwip_chksum  memcpy+chksum  chksum_copy\n");
+	for (align = 0; align < 4; align++) {
+		start = clock();
+		for (i = 0; i < rounds; i++) {
+			sink += chk_reference(chk_src + align, CHK_BENCH_LEN);
+		}
+		mbps[0] = CHK_BENCH_BYTES / 1048576.0 / ((double)(clock() - start + 1) / CLOCKS_PER_SEC);
+
+		start = clock();
+		for (i = 0; i < rounds; i++) {
+			sink += lwip_standard_chksum(chk_src + align, CHK_BENCH_LEN);
+		}
+		mbps[1] = CHK_BENCH_BYTES / 1048576.0 / ((double)(clock() - start + 1) / CLOCKS_PER_SEC);
+
+		start = clock();
+		for (i = 0; i < rounds; i++) {
+			MEMCPY(chk_dst + align, chk_src + align, CHK_BENCH_LEN);
+			sink += lwip_standard_chksum(chk_dst + align, CHK_BENCH_LEN);
+		}
+		mbps[2] = CHK_BENCH_BYTES / 1048576.0 / ((double)(clock() - start + 1) / CLOCKS_PER_SEC);
+
+		start = clock();
+		for (i = 0; i < rounds; i++) {
+			sink += lwip_chksum_copy(chk_dst + align, chk_src + align, CHK_BENCH_LEN);
+		}
+		mbps[3] = CHK_BENCH_BYTES / 1048576.0 / ((double)(clock() - start + 1) / CLOCKS_PER_SEC);
+
+		printf("%5d %12.0f %12.0f %14.0f %12.0f\n", align, mbps[0], mbps[1], mbps[2], mbps[3]);
+	}
+	LWIP_UNUSED_ARG(sink);
+}
+
+END_TEST
+/** Create the suite including all tests for this module */
+Suite *chksum_suite(void)
+{
+	TFun tests[] = {
+		test_chksum_aligned_lengths,
+		test_chksum_copy,
+		test_chksum_pbuf_chain,
+		test_chksum_benchmark
+	};
+	return create_suite("CHKSUM", tests, sizeof(tests) / sizeof(TFun), chksum_setup, chksum_teardown);
+}
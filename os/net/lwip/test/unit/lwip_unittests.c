@@ -21,7 +21,9 @@
 #include "udp/test_udp.h"
 #include "tcp/test_tcp.h"
 #include "tcp/test_tcp_oos.h"
+#include "tcp/test_tcp_sack.h"
 #include "core/test_mem.h"
+#include "core/test_chksum.h"
 #include "etharp/test_etharp.h"
 
 #include "lwip/init.h"
@@ -35,7 +37,13 @@ int main()
 		udp_suite,
 		tcp_suite,
 		tcp_oos_suite,
+#if LWIP_TCP_SACK
+		tcp_sack_suite,
+#endif
 		mem_suite,
+#if LWIP_CHECKSUM_ON_COPY && (LWIP_CHKSUM_COPY_ALGORITHM == 2)
+		chksum_suite,
+#endif
 		etharp_suite
 	};
 	size_t num = sizeof(suites) / sizeof(void *);
@@ -0,0 +1,41 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/* Options of the tcp_sack and chksum suites, added to the shared lwipopts.h
+ * with "-include lwipopts_sack.h".  Those suites are built into a test
+ * binary of their own, so that the other suites still run against the
+ * shared options.  lwip_unittests.c only registers the suites which the
+ * options of its binary support.
+ */
+
+#ifndef __LWIPOPTS_SACK_H__
+#define __LWIPOPTS_SACK_H__
+
+/* tcp_sack suite.  Limited transmit is on for both of the variants it
+ * compares: without it, a window rarely produces the duplicate ACKs which
+ * SACK recovery needs.
+ */
+#define LWIP_TCP_SACK                   1
+#define LWIP_TCP_LIMITED_TRANSMIT       1
+
+/* chksum suite */
+#define LWIP_CHKSUM_ALGORITHM           4
+#define LWIP_CHECKSUM_ON_COPY           1
+#define LWIP_CHKSUM_COPY_ALGORITHM      2
+
+#endif							/* __LWIPOPTS_SACK_H__ */
@@ -0,0 +1,499 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include "test_tcp_sack.h"
+
+#include "lwip/priv/tcp_priv.h"
+#include "lwip/stats.h"
+#include "lwip/netif.h"
+#include "lwip/ip.h"
+#include "lwip/inet_chksum.h"
+
+#if !LWIP_STATS || !TCP_STATS || !MEMP_STATS
+#error "This tests needs TCP- and MEMP-statistics enabled"
+#endif
+#if !LWIP_TCP_SACK
+#error "This tests needs LWIP_TCP_SACK enabled"
+#endif
+
+/* Both ends of the connection live in this stack and talk through a
+ * simulated link: whatever the netif sends is queued and fed back to
+ * ip4_input() once its delivery time has come. Data segments are
+ * serialized one after the other and are lost at a configurable rate,
+ * ACKs only see the propagation delay. Time is simulated, so a test
+ * run takes no real time and its outcome does not depend on the host.
+ */
+#define SACK_LINK_DELAY_MS      10	/* one way propagation delay */
+#define SACK_LINK_SEG_MS        1	/* serialization time of a data segment */
+#define SACK_LINK_QUEUE         64	/* packets in flight on the link */
+#define SACK_LINK_MAX_DROPS     4
+
+#define SACK_XFER_LEN           (128 * 1024)
+#define SACK_XFER_TIMEOUT_MS    (600 * 1000)
+#define SACK_SERVER_PORT        7777
+#define SACK_RUNS               3	/* seeds averaged per loss rate */
+
+struct sack_pkt {
+	struct pbuf *p;
+	u32_t due;
+	u32_t id;
+};
+
+struct sack_link {
+	struct sack_pkt pkts[SACK_LINK_QUEUE];
+	u16_t count;
+	u32_t next_id;
+	u32_t busy_until;
+	u32_t loss_permille;
+	u32_t rand;
+	u8_t strip_sack_perm;
+	u32_t drop[SACK_LINK_MAX_DROPS];	/* data segments to lose, by number */
+	u32_t tx_data;			/* data segments sent */
+	u32_t lost;
+	u32_t tx_sack_acks;		/* ACKs carrying a SACK option */
+};
+
+static struct netif sack_netif;
+static struct sack_link sack_link;
+static u32_t sack_now;
+static u8_t sack_tmr_count;
+
+static struct tcp_pcb *sack_client;
+static struct tcp_pcb *sack_server;
+static u32_t sack_sent;
+static u32_t sack_received;
+static u8_t sack_rx_error;
+
+/* helper functions */
+
+static u8_t sack_pattern(u32_t offset)
+{
+	return (u8_t)(offset + (offset >> 8) + (offset >> 16));
+}
+
+static u32_t sack_link_random(struct sack_link *link)
+{
+	link->rand = link->rand * 1103515245 + 12345;
+	return (link->rand >> 16) % 1000;
+}
+
+/** Replace the SACK permitted option of a SYN by NOPs, like a middlebox
+ * that does not know about SACK would */
+static void sack_strip_sack_perm(struct pbuf *p, u16_t iphlen)
+{
+	struct ip_hdr *iphdr = (struct ip_hdr *)p->payload;
+	struct tcp_hdr *tcphdr = (struct tcp_hdr *)((u8_t *)p->payload + iphlen);
+	u8_t *opts = (u8_t *)(tcphdr + 1);
+	u16_t optlen = TCPH_HDRLEN(tcphdr) * 4 - TCP_HLEN;
+	u16_t i = 0;
+	ip_addr_t src;
+	ip_addr_t dest;
+
+	while (i < optlen && opts[i] != LWIP_TCP_OPT_EOL) {
+		if (opts[i] == LWIP_TCP_OPT_NOP) {
+			i++;
+			continue;
+		}
+		if (i + 1 >= optlen || opts[i + 1] < 2) {
+			return;
+		}
+		if (opts[i] == LWIP_TCP_OPT_SACK_PERM) {
+			opts[i] = LWIP_TCP_OPT_NOP;
+			opts[i + 1] = LWIP_TCP_OPT_NOP;
+		}
+		i += opts[i + 1] < 2 ? 2 : opts[i + 1];
+	}
+
+	ip_addr_copy_from_ip4(src, iphdr->src);
+	ip_addr_copy_from_ip4(dest, iphdr->dest);
+	pbuf_header(p, -(s16_t)iphlen);
+	tcphdr->chksum = 0;
+	tcphdr->chksum = ip_chksum_pseudo(p, IP_PROTO_TCP, p->tot_len, &src, &dest);
+	pbuf_header(p, (s16_t)iphlen);
+}
+
+/** Count ACKs that carry a SACK option */
+static void sack_count_sack_option(struct sack_link *link, struct tcp_hdr *tcphdr)
+{
+	u8_t *opts = (u8_t *)(tcphdr + 1);
+	u16_t optlen = TCPH_HDRLEN(tcphdr) * 4 - TCP_HLEN;
+	u16_t i = 0;
+
+	while (i + 1 < optlen && opts[i] != LWIP_TCP_OPT_EOL) {
+		if (opts[i] == LWIP_TCP_OPT_NOP) {
+			i++;
+		} else if (opts[i] == LWIP_TCP_OPT_SACK) {
+			link->tx_sack_acks++;
+			return;
+		} else {
+			i += opts[i + 1] < 2 ? 2 : opts[i + 1];
+		}
+	}
+}
+
+static err_t sack_link_output(struct netif *netif, struct pbuf *p, const ip4_addr_t *ipaddr)
+{
+	struct sack_link *link = (struct sack_link *)netif->state;
+	struct ip_hdr *iphdr;
+	struct tcp_hdr *tcphdr;
+	struct pbuf *q;
+	u16_t iphlen;
+	u16_t datalen;
+	u32_t due;
+	int i;
+	LWIP_UNUSED_ARG(ipaddr);
+
+	/* the stack keeps p, so the link needs its own copy */
+	q = pbuf_alloc(PBUF_RAW, p->tot_len, PBUF_RAM);
+	EXPECT_RETX(q != NULL, ERR_MEM);
+	EXPECT(pbuf_copy(q, p) == ERR_OK);
+
+	iphdr = (struct ip_hdr *)q->payload;
+	iphlen = IPH_HL(iphdr) * 4;
+	tcphdr = (struct tcp_hdr *)((u8_t *)q->payload + iphlen);
+	datalen = q->tot_len - iphlen - TCPH_HDRLEN(tcphdr) * 4;
+
+	if (link->strip_sack_perm && (TCPH_FLAGS(tcphdr) & TCP_SYN)) {
+		sack_strip_sack_perm(q, iphlen);
+	}
+
+	due = sack_now + SACK_LINK_DELAY_MS;
+	if (datalen > 0) {
+		/* data segments queue up behind each other, lost ones included */
+		if (link->busy_until < sack_now) {
+			link->busy_until = sack_now;
+		}
+		link->busy_until += SACK_LINK_SEG_MS;
+		due = link->busy_until + SACK_LINK_DELAY_MS;
+		link->tx_data++;
+		for (i = 0; i < SACK_LINK_MAX_DROPS; i++) {
+			if (link->drop[i] == link->tx_data) {
+				break;
+			}
+		}
+		if (i < SACK_LINK_MAX_DROPS || sack_link_random(link) < link->loss_permille) {
+			link->lost++;
+			pbuf_free(q);
+			return ERR_OK;
+		}
+	} else {
+		sack_count_sack_option(link, tcphdr);
+	}
+
+	if (link->count == SACK_LINK_QUEUE) {
+		/* tail drop */
+		link->lost++;
+		pbuf_free(q);
+		return ERR_OK;
+	}
+	link->pkts[link->count].p = q;
+	link->pkts[link->count].due = due;
+	link->pkts[link->count].id = link->next_id++;
+	link->count++;
+	return ERR_OK;
+}
+
+/** Index of the packet to deliver next, -1 if the link is empty */
+static int sack_link_next(struct sack_link *link)
+{
+	int next = -1;
+	int i;
+
+	for (i = 0; i < link->count; i++) {
+		if (next < 0 || link->pkts[i].due < link->pkts[next].due || (link->pkts[i].due == link->pkts[next].due && link->pkts[i].id < link->pkts[next].id)) {
+			next = i;
+		}
+	}
+	return next;
+}
+
+/** Deliver the packets due until the current time */
+static void sack_link_deliver(struct sack_link *link)
+{
+	struct pbuf *p;
+	int i;
+
+	while ((i = sack_link_next(link)) >= 0 && link->pkts[i].due <= sack_now) {
+		p = link->pkts[i].p;
+		link->pkts[i] = link->pkts[--link->count];
+		ip4_input(p, &sack_netif);
+	}
+}
+
+static void sack_link_flush(struct sack_link *link)
+{
+	while (link->count > 0) {
+		pbuf_free(link->pkts[--link->count].p);
+	}
+}
+
+/* our own version of tcp_tmr so we can reset fast/slow timer state */
+static void sack_tcp_tmr(void)
+{
+	tcp_fasttmr();
+	if (++sack_tmr_count & 1) {
+		tcp_slowtmr();
+	}
+}
+
+/** Queue as much of the transfer as the send buffer takes, in full segments */
+static void sack_client_fill(struct tcp_pcb *pcb)
+{
+	u8_t buf[TCP_MSS];
+	u16_t len;
+	u16_t i;
+
+	while (sack_sent < SACK_XFER_LEN) {
+		len = LWIP_MIN(tcp_mss(pcb), SACK_XFER_LEN - sack_sent);
+		if (tcp_sndbuf(pcb) < len || tcp_sndqueuelen(pcb) >= TCP_SND_QUEUELEN - 1) {
+			break;
+		}
+		for (i = 0; i < len; i++) {
+			buf[i] = sack_pattern(sack_sent + i);
+		}
+		if (tcp_write(pcb, buf, len, TCP_WRITE_FLAG_COPY) != ERR_OK) {
+			break;
+		}
+		sack_sent += len;
+	}
+	tcp_output(pcb);
+}
+
+static err_t sack_client_connected(void *arg, struct tcp_pcb *pcb, err_t err)
+{
+	LWIP_UNUSED_ARG(arg);
+	EXPECT(err == ERR_OK);
+	sack_client_fill(pcb);
+	return ERR_OK;
+}
+
+static err_t sack_client_sent(void *arg, struct tcp_pcb *pcb, u16_t len)
+{
+	LWIP_UNUSED_ARG(arg);
+	LWIP_UNUSED_ARG(len);
+	sack_client_fill(pcb);
+	return ERR_OK;
+}
+
+static err_t sack_server_recv(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err)
+{
+	struct pbuf *q;
+	u16_t i;
+	LWIP_UNUSED_ARG(arg);
+	EXPECT(err == ERR_OK);
+
+	if (p == NULL) {
+		return ERR_OK;
+	}
+	for (q = p; q != NULL; q = q->next) {
+		for (i = 0; i < q->len; i++) {
+			if (((u8_t *)q->payload)[i] != sack_pattern(sack_received + i)) {
+				sack_rx_error = 1;
+			}
+		}
+		sack_received += q->len;
+	}
+	tcp_recved(pcb, p->tot_len);
+	pbuf_free(p);
+	return ERR_OK;
+}
+
+static err_t sack_server_accept(void *arg, struct tcp_pcb *newpcb, err_t err)
+{
+	LWIP_UNUSED_ARG(arg);
+	EXPECT_RETX(err == ERR_OK, ERR_VAL);
+	sack_server = newpcb;
+	tcp_recv(newpcb, sack_server_recv);
+	return ERR_OK;
+}
+
+/** Run one transfer over the simulated link
+ *
+ * @param loss_permille random loss rate of data segments
+ * @param seed seed of the loss pattern
+ * @param strip_sack_perm nonzero to hide SACK from the other end
+ * @param sack_used receives whether both ends agreed on SACK
+ * @return duration of the transfer in ms
+ */
+static u32_t sack_run_transfer(u32_t loss_permille, u32_t seed, u8_t strip_sack_perm, u8_t *sack_used)
+{
+	struct tcp_pcb *lpcb;
+	u32_t next_tmr = TCP_TMR_INTERVAL;
+	u32_t next;
+	int i;
+
+	sack_link.loss_permille = loss_permille;
+	sack_link.rand = seed;
+	sack_link.strip_sack_perm = strip_sack_perm;
+	sack_now = 0;
+	sack_tmr_count = 0;
+	sack_sent = 0;
+	sack_received = 0;
+	sack_rx_error = 0;
+	sack_server = NULL;
+
+	lpcb = tcp_new();
+	EXPECT_RETX(lpcb != NULL, 0);
+	EXPECT(tcp_bind(lpcb, &sack_netif.ip_addr, SACK_SERVER_PORT) == ERR_OK);
+	lpcb = tcp_listen(lpcb);
+	EXPECT_RETX(lpcb != NULL, 0);
+	tcp_accept(lpcb, sack_server_accept);
+
+	sack_client = tcp_new();
+	EXPECT_RETX(sack_client != NULL, 0);
+	tcp_sent(sack_client, sack_client_sent);
+	EXPECT(tcp_connect(sack_client, &sack_netif.ip_addr, SACK_SERVER_PORT, sack_client_connected) == ERR_OK);
+
+	while (sack_received < SACK_XFER_LEN && !sack_rx_error && sack_now < SACK_XFER_TIMEOUT_MS) {
+		/* advance to the next packet arrival or timer tick */
+		next = next_tmr;
+		i = sack_link_next(&sack_link);
+		if (i >= 0 && sack_link.pkts[i].due < next) {
+			next = sack_link.pkts[i].due;
+		}
+		sack_now = next;
+		sack_link_deliver(&sack_link);
+		if (sack_now >= next_tmr) {
+			sack_tcp_tmr();
+			next_tmr += TCP_TMR_INTERVAL;
+		}
+	}
+
+	EXPECT(sack_rx_error == 0);
+	EXPECT(sack_received == SACK_XFER_LEN);
+	EXPECT_RETX(sack_server != NULL, 0);
+	*sack_used = (sack_client->flags & TF_SACK) && (sack_server->flags & TF_SACK);
+
+	tcp_abort(sack_client);
+	tcp_abort(sack_server);
+	tcp_close(lpcb);
+	sack_link_flush(&sack_link);
+	return sack_now;
+}
+
+/* Setups/teardown functions */
+
+static void tcp_sack_setup(void)
+{
+	memset(&sack_link, 0, sizeof(sack_link));
+	memset(&sack_netif, 0, sizeof(sack_netif));
+	IP4_ADDR(ip_2_ip4(&sack_netif.ip_addr), 192, 168, 1, 1);
+	IP4_ADDR(ip_2_ip4(&sack_netif.netmask), 255, 255, 255, 0);
+	sack_netif.output = sack_link_output;
+	sack_netif.state = &sack_link;
+	sack_netif.mtu = 1500;
+	sack_netif.flags = NETIF_FLAG_UP | NETIF_FLAG_LINK_UP;
+	sack_netif.next = NULL;
+	netif_list = &sack_netif;
+}
+
+static void tcp_sack_teardown(void)
+{
+	sack_link_flush(&sack_link);
+	netif_list = NULL;
+	EXPECT(lwip_stats.memp[MEMP_TCP_PCB]->used == 0);
+	EXPECT(lwip_stats.memp[MEMP_TCP_SEG]->used == 0);
+}
+
+/* Test functions */
+
+/** SACK is used when both SYNs carry SACK permitted, and only then */
+START_TEST(test_tcp_sack_negotiate)
+{
+	u8_t sack_used;
+	LWIP_UNUSED_ARG(_i);
+
+	sack_run_transfer(0, 1, 0, &sack_used);
+	EXPECT(sack_used);
+
+	sack_run_transfer(0, 1, 1, &sack_used);
+	EXPECT(!sack_used);
+}
+
+END_TEST
+/** Two segments lost from the same window are repaired by two fast
+ * retransmissions, without a timeout and without resending data the
+ * receiver already has */
+START_TEST(test_tcp_sack_two_losses)
+{
+	u32_t nsegs = (SACK_XFER_LEN + TCP_MSS - 1) / TCP_MSS;
+	u32_t duration;
+	u8_t sack_used;
+	LWIP_UNUSED_ARG(_i);
+
+	sack_link.drop[0] = 40;
+	sack_link.drop[1] = 43;
+	duration = sack_run_transfer(0, 1, 0, &sack_used);
+	EXPECT(sack_used);
+	EXPECT(sack_link.tx_sack_acks > 0);
+	EXPECT(sack_link.lost == 2);
+	EXPECT(sack_link.tx_data == nsegs + 2);
+	/* the retransmission timer never fired */
+	EXPECT(duration < TCP_SLOW_INTERVAL * 2 + nsegs * SACK_LINK_SEG_MS);
+}
+
+END_TEST
+/** Goodput against loss rate, with and without SACK */
+START_TEST(test_tcp_sack_goodput)
+{
+	static const u32_t loss_permille[] = { 0, 5, 10, 20, 50, 100 };
+	u32_t duration[2];
+	u32_t goodput[2];
+	u8_t sack_used;
+	size_t i;
+	int sack;
+	int run;
+	LWIP_UNUSED_ARG(_i);
+
+	printf("\nTCP goodput over a lossy link, %u kB per transfer\n", SACK_XFER_LEN / 1024);
+	printf("loss     no SACK (kbit/s)    SACK (kbit/s)\n");
+	for (i = 0; i < sizeof(loss_permille) / sizeof(loss_permille[0]); i++) {
+		for (sack = 0; sack < 2; sack++) {
+			duration[sack] = 0;
+			for (run = 0; run < SACK_RUNS; run++) {
+				memset(&sack_link, 0, sizeof(sack_link));
+				duration[sack] += sack_run_transfer(loss_permille[i], 0x5eed + run, !sack, &sack_used);
+				EXPECT(sack_used == sack);
+			}
+			goodput[sack] = SACK_XFER_LEN * 8 * SACK_RUNS / duration[sack];
+		}
+		printf("%2u.%u%%   %16u %16u\n", (unsigned)(loss_permille[i] / 10), (unsigned)(loss_permille[i] % 10), (unsigned)goodput[0], (unsigned)goodput[1]);
+
+		/* An isolated loss is repaired by fast retransmit alone and costs
+		 * both variants the same; SACK pays off once a window loses more
+		 * than one segment.
+		 */
+		if (loss_permille[i] >= 20) {
+			EXPECT(goodput[1] > goodput[0]);
+		} else {
+			EXPECT(goodput[1] >= goodput[0]);
+		}
+	}
+}
+
+END_TEST
+/** Create the suite including all tests for this module */
+Suite *tcp_sack_suite(void)
+{
+	TFun tests[] = {
+		test_tcp_sack_negotiate,
+		test_tcp_sack_two_losses,
+		test_tcp_sack_goodput
+	};
+	return create_suite("TCP_SACK", tests, sizeof(tests) / sizeof(TFun), tcp_sack_setup, tcp_sack_teardown);
+}
@@ -175,6 +175,16 @@ void netdev_ipv6_rxnotify(FAR const net_ipv6addr_t ripaddr);
 #endif							/* CONFIG_NET_IPv6 */
 #endif
 
+/* netdev_dhcpc.c ************************************************************/
+
+#if defined(CONFIG_NET_LWIP_DHCP) && defined(CONFIG_LWIP_DHCPC)
+struct dhcpc_lease;
+int netdev_dhcp_client_start(const char *intf);
+int netdev_dhcp_client_start_reboot(const char *intf, const struct dhcpc_lease *lease);
+int netdev_dhcp_client_get_lease(const char *intf, struct dhcpc_lease *lease);
+void netdev_dhcp_client_stop(const char *intf);
+#endif
+
 /* netdev_count.c ************************************************************/
 
 #if CONFIG_NSOCKET_DESCRIPTORS > 0
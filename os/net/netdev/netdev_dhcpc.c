@@ -73,6 +73,7 @@
 #include <netutils/netlib.h>
 #include "lwip/netif.h"
 #include "lwip/netifapi.h"
+#include "lwip/dhcp.h"
 #include "netdev/netdev.h"
 
 /****************************************************************************
@@ -187,15 +188,8 @@ static int _netlib_set_dripv4addr(FAR const char *ifname, FAR const struct in_ad
 	return OK;
 }
 
-/****************************************************************************
- * Public Functions
- ****************************************************************************/
-/****************************************************************************
- * Name: dhcp_client_start
- ****************************************************************************/
-int netdev_dhcp_client_start(const char *intf)
+static int _netdev_dhcp_client_run(const char *intf, const struct dhcpc_lease *lease)
 {
-	nvdbg("LWIP DHCPC started\n");
 	struct netif *cur_netif;
 	cur_netif = netif_find(intf);
 	if (cur_netif == NULL) {
@@ -206,6 +200,7 @@ int netdev_dhcp_client_start(const char *intf)
 	struct in_addr local_ipaddr;
 	struct in_addr local_netmask;
 	struct in_addr local_gateway;
+	err_t res;
 
 	/* Initialize dhcp structure if exists */
 	if (netif_dhcp_data(cur_netif)) {
@@ -216,7 +211,13 @@ int netdev_dhcp_client_start(const char *intf)
 	local_netmask.s_addr = IPADDR_BROADCAST;
 	local_gateway.s_addr = IPADDR_ANY;
 	DHCPC_SET_IP4ADDR(intf, local_ipaddr, local_netmask, local_gateway);
-	err_t res = netifapi_dhcp_start(cur_netif);
+	if (lease) {
+		ip4_addr_t addr;
+		ip4_addr_set_u32(&addr, lease->ipaddr.s_addr);
+		res = netifapi_dhcp_start_reboot(cur_netif, &addr);
+	} else {
+		res = netifapi_dhcp_start(cur_netif);
+	}
 	if (res) {
 		ndbg("dhcpc_start failure %d\n", res);
 		return ERROR;
@@ -235,6 +236,59 @@ int netdev_dhcp_client_start(const char *intf)
 	return OK;
 }
 
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+/****************************************************************************
+ * Name: dhcp_client_start
+ ****************************************************************************/
+int netdev_dhcp_client_start(const char *intf)
+{
+	nvdbg("LWIP DHCPC started\n");
+	return _netdev_dhcp_client_run(intf, NULL);
+}
+
+/****************************************************************************
+ * Name: dhcp_client_start_reboot
+ ****************************************************************************/
+int netdev_dhcp_client_start_reboot(const char *intf, const struct dhcpc_lease *lease)
+{
+	if (lease == NULL || lease->ipaddr.s_addr == INADDR_ANY || lease->ipaddr.s_addr == INADDR_NONE) {
+		return ERROR;
+	}
+	nvdbg("LWIP DHCPC started, requesting %08x\n", ntohl(lease->ipaddr.s_addr));
+	return _netdev_dhcp_client_run(intf, lease);
+}
+
+/****************************************************************************
+ * Name: dhcp_client_get_lease
+ ****************************************************************************/
+int netdev_dhcp_client_get_lease(const char *intf, struct dhcpc_lease *lease)
+{
+	struct netif *cur_netif;
+	ip4_addr_t addr;
+	ip4_addr_t server;
+	u32_t lease_time;
+
+	if (lease == NULL) {
+		return ERROR;
+	}
+	cur_netif = netif_find(intf);
+	if (cur_netif == NULL) {
+		ndbg("No network interface for dhcpc\n");
+		return ERROR;
+	}
+
+	if (netifapi_dhcp_get_lease(cur_netif, &addr, &server, &lease_time) != ERR_OK) {
+		return ERROR;
+	}
+	lease->ipaddr.s_addr = ip4_addr_get_u32(&addr);
+	lease->serverid.s_addr = ip4_addr_get_u32(&server);
+	lease->lease_time = lease_time;
+
+	return OK;
+}
+
 /****************************************************************************
  * Name: dhcp_client_stop
  ****************************************************************************/
@@ -1288,6 +1288,23 @@ int lwip_func_ioctl(int s, int cmd, void *arg)
 		in_arg->req_res = 0;
 		ret = OK;
 		break;
+	case DHCPCREBOOT:
+		in_arg->req_res = netdev_dhcp_client_start_reboot((const char *)in_arg->intf, in_arg->lease);
+		if (in_arg->req_res != 0) {
+			ret = -EINVAL;
+			ndbg("reboot dhcp fail\n");
+		} else {
+			ret = OK;
+		}
+		break;
+	case DHCPCLEASE:
+		in_arg->req_res = netdev_dhcp_client_get_lease((const char *)in_arg->intf, in_arg->lease);
+		if (in_arg->req_res != 0) {
+			ret = -EINVAL;
+		} else {
+			ret = OK;
+		}
+		break;
 #endif
 #if defined(CONFIG_LWIP_DHCPS)
 	case DHCPDSTART:
@@ -30,8 +30,12 @@
 #include <sys/types.h>
 #include <netinet/in.h>
 #include <net/if.h>
+#include <errno.h>
 #include <tinyara/lwnl/lwnl.h>
 #include "netstack.h"
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+#include "local/uds_net.h"
+#endif
 
 /**
  * Public
@@ -194,4 +198,15 @@ int socket(int domain, int type, int protocol)
 	NETSTACK_CALL(stk, socket, (domain, type, protocol));
 }
 
+int socketpair(int domain, int type, int protocol, int sv[2])
+{
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+	if (domain == AF_UNIX) {
+		return uds_socketpair(domain, type, protocol, sv);
+	}
+#endif
+	set_errno(EAFNOSUPPORT);
+	return -1;
+}
+
 #endif // CONFIG_NET
@@ -341,6 +341,7 @@ SYSCALL_LOOKUP(sendto,                  6, STUB_sendto)
 SYSCALL_LOOKUP(setsockopt,              5, STUB_setsockopt)
 SYSCALL_LOOKUP(shutdown,                2, STUB_shutdown)
 SYSCALL_LOOKUP(socket,                  3, STUB_socket)
+SYSCALL_LOOKUP(socketpair,              4, STUB_socketpair)
 #endif
 
 /* The following is defined only if CONFIG_TASK_NAME_SIZE > 0 */
@@ -358,6 +358,8 @@ uintptr_t STUB_setsockopt(int nbr, uintptr_t parm1, uintptr_t parm2,
 uintptr_t STUB_shutdown(int nbr, uintptr_t parm1, uintptr_t parm2);
 uintptr_t STUB_socket(int nbr, uintptr_t parm1, uintptr_t parm2,
 					  uintptr_t parm3);
+uintptr_t STUB_socketpair(int nbr, uintptr_t parm1, uintptr_t parm2,
+						  uintptr_t parm3, uintptr_t parm4);
 
 /* The following is defined only if CONFIG_TASK_NAME_SIZE > 0 */
 
@@ -55,6 +55,7 @@
  ****************************************************************************/
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -70,10 +71,23 @@
 #define MAX_HEADER_FILES 500
 #define SYMTAB_NAME      "g_symtab"
 
+/* Perfect hash generation: about four symbols share a bucket, and each
+ * bucket gets the first seed which moves all of its symbols to free slots.
+ */
+
+#define HASH_BUCKET_LOAD 4
+#define HASH_MAX_SEED    65535
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+struct symbol_s {
+	char *name;
+	char *cond;
+	uint32_t hash0;
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -81,17 +95,21 @@
 static const char *g_hdrfiles[MAX_HEADER_FILES];
 static int nhdrfiles;
 
+static struct symbol_s *g_symbols;
+static int g_nsymbols;
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
 static void show_usage(const char *progname)
 {
-	fprintf(stderr, "USAGE: %s <cvs-file> <symtab-file>\n\n", progname);
+	fprintf(stderr, "USAGE: %s [-d] [-p] <cvs-file> <symtab-file>\n\n", progname);
 	fprintf(stderr, "Where:\n\n");
 	fprintf(stderr, "  <cvs-file>   : The path to the input CSV file\n");
 	fprintf(stderr, "  <symtab-file>: The path to the output symbol table file\n");
 	fprintf(stderr, "  -d           : Enable debug output\n");
+	fprintf(stderr, "  -p           : Order the table by a perfect hash and output its index\n");
 	exit(EXIT_FAILURE);
 }
 
@@ -122,6 +140,211 @@ static void add_hdrfile(const char *hdrfile)
 	}
 }
 
+static void add_symbol(const char *name, const char *cond)
+{
+	int i;
+
+	/* A symbol may be listed in more than one of the concatenated CSV files */
+
+	for (i = 0; i < g_nsymbols; i++) {
+		if (strcmp(g_symbols[i].name, name) == 0)
+			return;
+	}
+
+	g_symbols = realloc(g_symbols, (g_nsymbols + 1) * sizeof(struct symbol_s));
+	if (!g_symbols) {
+		fprintf(stderr, "ERROR:  Out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	g_symbols[g_nsymbols].name = strdup(name);
+	g_symbols[g_nsymbols].cond = (cond && strlen(cond) > 0) ? strdup(cond) : NULL;
+	g_nsymbols++;
+}
+
+/* This must give the same result as symtab_hash() in libc/symtab */
+
+static uint32_t symtab_hash(const char *name, uint32_t seed)
+{
+	uint32_t hash = 2166136261u ^ seed;
+
+	while (*name != '\0') {
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619u;
+	}
+
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bu;
+	hash ^= hash >> 13;
+	return hash;
+}
+
+static int *g_bucketsize;
+
+static int compare_buckets(const void *a, const void *b)
+{
+	return g_bucketsize[*(const int *)b] - g_bucketsize[*(const int *)a];
+}
+
+/* Build a minimal perfect hash over g_symbols[] by hash and displace:
+ * symbols are split into buckets by symtab_hash(name, 0), then, from the
+ * largest bucket down, each bucket gets the first seed which places all of
+ * its symbols into free slots.  slots[] returns the symbol of each slot.
+ */
+
+static bool make_perfecthash(int nseeds, uint16_t *seeds, int *slots)
+{
+	int *order;
+	int *members;
+	int nmembers;
+	int bucket;
+	uint32_t seed;
+	bool found = true;
+	int i;
+	int j;
+	int k;
+
+	g_bucketsize = calloc(nseeds, sizeof(int));
+	order = malloc(nseeds * sizeof(int));
+	members = malloc(g_nsymbols * sizeof(int));
+	if (!g_bucketsize || !order || !members) {
+		fprintf(stderr, "ERROR:  Out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < g_nsymbols; i++) {
+		g_symbols[i].hash0 = symtab_hash(g_symbols[i].name, 0);
+		g_bucketsize[g_symbols[i].hash0 % nseeds]++;
+		slots[i] = -1;
+	}
+
+	for (i = 0; i < nseeds; i++) {
+		order[i] = i;
+		seeds[i] = 0;
+	}
+
+	qsort(order, nseeds, sizeof(int), compare_buckets);
+
+	for (i = 0; i < nseeds && g_bucketsize[order[i]] > 0; i++) {
+		bucket = order[i];
+		nmembers = 0;
+		for (j = 0; j < g_nsymbols; j++) {
+			if (g_symbols[j].hash0 % nseeds == bucket) {
+				members[nmembers++] = j;
+			}
+		}
+
+		for (seed = 1; seed <= HASH_MAX_SEED; seed++) {
+			for (j = 0; j < nmembers; j++) {
+				int slot = symtab_hash(g_symbols[members[j]].name, seed) % g_nsymbols;
+				if (slots[slot] >= 0) {
+					break;
+				}
+
+				slots[slot] = members[j];
+			}
+
+			if (j == nmembers) {
+				break;
+			}
+
+			/* Undo the partial placement and try the next seed */
+
+			for (k = 0; k < j; k++) {
+				slots[symtab_hash(g_symbols[members[k]].name, seed) % g_nsymbols] = -1;
+			}
+		}
+
+		if (seed > HASH_MAX_SEED) {
+			found = false;
+			break;
+		}
+
+		seeds[bucket] = seed;
+	}
+
+	free(g_bucketsize);
+	free(order);
+	free(members);
+	return found;
+}
+
+static void output_entry(FILE *outstream, const struct symbol_s *symbol)
+{
+	if (symbol->cond) {
+		fprintf(outstream, "#if %s\n", symbol->cond);
+		fprintf(outstream, "  { \"%s\", (FAR const void *)%s },\n", symbol->name, symbol->name);
+		fprintf(outstream, "#else\n");
+		fprintf(outstream, "  { \"%s\", NULL },\n", symbol->name);
+		fprintf(outstream, "#endif\n");
+	} else {
+		fprintf(outstream, "  { \"%s\", (FAR const void *)%s },\n", symbol->name, symbol->name);
+	}
+}
+
+static void output_perfecthash(FILE *outstream)
+{
+	uint16_t *seeds;
+	int *slots;
+	int nseeds;
+	int i;
+
+	if (g_nsymbols == 0 || g_nsymbols > UINT16_MAX) {
+		fprintf(stderr, "ERROR:  %d symbols cannot be hashed\n", g_nsymbols);
+		exit(EXIT_FAILURE);
+	}
+
+	slots = malloc(g_nsymbols * sizeof(int));
+	seeds = malloc(g_nsymbols * sizeof(uint16_t));
+	if (!slots || !seeds) {
+		fprintf(stderr, "ERROR:  Out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/* Fewer buckets give a smaller index; add buckets until it is solvable */
+
+	for (nseeds = (g_nsymbols + HASH_BUCKET_LOAD - 1) / HASH_BUCKET_LOAD; nseeds <= g_nsymbols; nseeds++) {
+		if (make_perfecthash(nseeds, seeds, slots)) {
+			break;
+		}
+	}
+
+	if (nseeds > g_nsymbols) {
+		fprintf(stderr, "ERROR:  No perfect hash found\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/* Symbols which are configured out keep their slot with a NULL value so
+	 * that the index stays valid for every configuration.
+	 */
+
+	fprintf(outstream, "\nstruct symtab_s %s[] =\n", SYMTAB_NAME);
+	fprintf(outstream, "{\n");
+
+	for (i = 0; i < g_nsymbols; i++) {
+		output_entry(outstream, &g_symbols[slots[i]]);
+	}
+
+	fprintf(outstream, "};\n\n");
+	fprintf(outstream, "#define NSYMBOLS (sizeof(%s) / sizeof (struct symtab_s))\n\n", SYMTAB_NAME);
+
+	fprintf(outstream, "static const uint16_t %s_seeds[%d] =\n", SYMTAB_NAME, nseeds);
+	fprintf(outstream, "{");
+
+	for (i = 0; i < nseeds; i++) {
+		fprintf(outstream, "%s%u,", (i % 12) == 0 ? "\n  " : " ", seeds[i]);
+	}
+
+	fprintf(outstream, "\n};\n\n");
+	fprintf(outstream, "const struct symtab_hash_s %s_hash =\n", SYMTAB_NAME);
+	fprintf(outstream, "{\n");
+	fprintf(outstream, "  %s, %s_seeds, %d, %d\n", SYMTAB_NAME, SYMTAB_NAME, nseeds, g_nsymbols);
+	fprintf(outstream, "};\n");
+
+	free(slots);
+	free(seeds);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -134,6 +357,7 @@ int main(int argc, char **argv, char **envp)
 	char *finalterm;
 	char *ptr;
 	bool cond;
+	bool perfecthash;
 	FILE *instream;
 	FILE *outstream;
 	int ch;
@@ -142,13 +366,18 @@ int main(int argc, char **argv, char **envp)
 	/* Parse command line options */
 
 	set_debug(false);
+	perfecthash = false;
 
-	while ((ch = getopt(argc, argv, ":d")) > 0) {
+	while ((ch = getopt(argc, argv, ":dp")) > 0) {
 		switch (ch) {
 		case 'd':
 			set_debug(true);
 			break;
 
+		case 'p':
+			perfecthash = true;
+			break;
+
 		case '?':
 			fprintf(stderr, "Unrecognized option: %c\n", optopt);
 			show_usage(argv[0]);
@@ -214,6 +443,10 @@ int main(int argc, char **argv, char **envp)
 		/* Add the header file to the list of header files we need to include */
 
 		add_hdrfile(get_parm(HEADER_INDEX));
+
+		if (perfecthash) {
+			add_symbol(get_parm(NAME_INDEX), get_parm(COND_INDEX));
+		}
 	}
 
 	/* Back to the beginning */
@@ -226,11 +459,25 @@ int main(int argc, char **argv, char **envp)
 	fprintf(outstream, "#include <tinyara/config.h>\n");
 	fprintf(outstream, "#include <tinyara/compiler.h>\n");
 
+	if (perfecthash) {
+		fprintf(outstream, "#include <stddef.h>\n");
+		fprintf(outstream, "#include <tinyara/symtab.h>\n");
+	}
+
 	/* Output all of the require header files */
 
 	for (i = 0; i < nhdrfiles; i++)
 		fprintf(outstream, "#include <%s>\n", g_hdrfiles[i]);
 
+	/* A perfect hash table is output in slot order with its index */
+
+	if (perfecthash) {
+		output_perfecthash(outstream);
+		fclose(instream);
+		fclose(outstream);
+		return EXIT_SUCCESS;
+	}
+
 	/* Now the symbol table itself */
 
 	fprintf(outstream, "\nstruct symtab_s %s[] =\n", SYMTAB_NAME);
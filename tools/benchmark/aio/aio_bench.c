@@ -0,0 +1,459 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/*
+ * Host benchmark of the asynchronous I/O of os/fs/aio.
+ *
+ * The AIO sources are built unchanged on top of the small TizenRT shims of
+ * include/.  Without CONFIG_FS_AIO_POOL each request is one job of the low
+ * priority work queue, emulated by one thread; with it the requests are
+ * served by the AIO threads, which merge the adjacent reads of a file.
+ *
+ * The file systems are emulated behind file_pread(): "tmpfs" copies from
+ * memory under its mount lock with a small CPU cost per call, "smartfs"
+ * also waits for a flash read of 100us per call under its mount lock, the
+ * way the SPI transfer of a sector blocks the caller.  Several clients keep
+ * a batch of small aio_read()s pending on a file each, with the work queue
+ * idle and with other jobs taking half of it.
+ */
+
+#include <tinyara/config.h>
+
+#include <aio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/kthread.h>
+#include <tinyara/wqueue.h>
+
+#include "aio/aio.h"
+
+#define NFILES        8
+#define FILE_SIZE     (32 * 1024)
+#define READ_SIZE     64
+#define QDEPTH        8
+
+#ifdef CONFIG_FS_AIO_POOL
+#define BUILD_NAME    "pool"
+#else
+#define BUILD_NAME    "lpwork"
+#endif
+
+struct bench_fs {
+	const char *name;
+	pthread_mutex_t lock;		/* Mount lock */
+	unsigned int spin_ns;		/* CPU time per call */
+	unsigned int wait_us;		/* Device wait per call */
+};
+
+struct bench_file {
+	struct file file;
+	struct bench_fs *fs;
+	uint8_t data[FILE_SIZE];
+};
+
+struct client_s {
+	int fd;
+	sem_t done;
+	pthread_t thread;
+};
+
+static struct bench_fs g_tmpfs = { "tmpfs", PTHREAD_MUTEX_INITIALIZER, 3000, 0 };
+static struct bench_fs g_smartfs = { "smartfs", PTHREAD_MUTEX_INITIALIZER, 20000, 100 };
+
+static struct bench_file g_files[NFILES];
+static unsigned long g_fscalls;
+
+/* Low priority work queue */
+
+static pthread_mutex_t g_wqlock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_wqcond = PTHREAD_COND_INITIALIZER;
+static struct work_s *g_wqhead;
+static struct work_s *g_wqtail;
+
+static volatile bool g_loaded;
+static volatile bool g_stop;
+
+static double now_sec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void spin_ns(unsigned int ns)
+{
+	double end = now_sec() + ns / 1e9;
+
+	while (now_sec() < end) {
+	}
+}
+
+static void fail(const char *what, long value)
+{
+	fprintf(stderr, "%s: %s failed: %ld\n", BUILD_NAME, what, value);
+	exit(1);
+}
+
+int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay)
+{
+	pthread_mutex_lock(&g_wqlock);
+	work->worker = worker;
+	work->arg = arg;
+	work->next = NULL;
+	if (g_wqtail != NULL) {
+		g_wqtail->next = work;
+	} else {
+		g_wqhead = work;
+	}
+	g_wqtail = work;
+	pthread_cond_signal(&g_wqcond);
+	pthread_mutex_unlock(&g_wqlock);
+	return OK;
+}
+
+int work_cancel(int qid, FAR struct work_s *work)
+{
+	struct work_s *prev = NULL;
+	struct work_s *curr;
+	int ret = -ENOENT;
+
+	pthread_mutex_lock(&g_wqlock);
+	for (curr = g_wqhead; curr != NULL; prev = curr, curr = curr->next) {
+		if (curr == work) {
+			if (prev != NULL) {
+				prev->next = curr->next;
+			} else {
+				g_wqhead = curr->next;
+			}
+			if (g_wqtail == curr) {
+				g_wqtail = prev;
+			}
+			ret = OK;
+			break;
+		}
+	}
+	pthread_mutex_unlock(&g_wqlock);
+	return ret;
+}
+
+static void *lpwork_thread(void *arg)
+{
+	struct work_s *work;
+
+	pthread_mutex_lock(&g_wqlock);
+	for (;;) {
+		while (g_wqhead == NULL) {
+			pthread_cond_wait(&g_wqcond, &g_wqlock);
+		}
+
+		work = g_wqhead;
+		g_wqhead = work->next;
+		if (g_wqhead == NULL) {
+			g_wqtail = NULL;
+		}
+
+		pthread_mutex_unlock(&g_wqlock);
+		work->worker(work->arg);
+		pthread_mutex_lock(&g_wqlock);
+	}
+
+	return NULL;
+}
+
+/* Other deferred jobs: 500us of work every millisecond */
+
+static struct work_s g_loadwork;
+static volatile bool g_loadpending;
+
+static void load_worker(FAR void *arg)
+{
+	spin_ns(500000);
+	g_loadpending = false;
+}
+
+static void *load_thread(void *arg)
+{
+	while (!g_stop) {
+		if (g_loaded && !g_loadpending) {
+			g_loadpending = true;
+			work_queue(LPWORK, &g_loadwork, load_worker, NULL, 0);
+		}
+		usleep(1000);
+	}
+
+	return NULL;
+}
+
+/* Kernel */
+
+struct kthread_s {
+	main_t entry;
+};
+
+static void *kthread_start(void *arg)
+{
+	struct kthread_s *kt = arg;
+	main_t entry = kt->entry;
+
+	free(kt);
+	entry(0, NULL);
+	return NULL;
+}
+
+int kernel_thread(FAR const char *name, int priority, int stack_size, main_t entry, FAR char *const argv[])
+{
+	static int pid = 100;
+	struct kthread_s *kt = malloc(sizeof(*kt));
+	pthread_t thread;
+
+	kt->entry = entry;
+	if (pthread_create(&thread, NULL, kthread_start, kt) != 0) {
+		free(kt);
+		set_errno(EAGAIN);
+		return ERROR;
+	}
+	pthread_detach(thread);
+	return pid++;
+}
+
+int aio_signal(pid_t pid, FAR struct aiocb *aiocbp)
+{
+	struct client_s *client = aiocbp->aio_sigevent.sigev_value.sival_ptr;
+
+	sem_post(&client->done);
+	return OK;
+}
+
+/* File systems */
+
+int fs_getfilep(int fd, FAR struct file **filep)
+{
+	if (fd < 0 || fd >= NFILES) {
+		return -EBADF;
+	}
+
+	*filep = &g_files[fd].file;
+	return OK;
+}
+
+static ssize_t bench_io(FAR struct file *filep, FAR void *buf, size_t nbytes, off_t offset, bool write)
+{
+	struct bench_file *bf = filep->f_priv;
+	struct bench_fs *fs = bf->fs;
+
+	pthread_mutex_lock(&fs->lock);
+	__atomic_fetch_add(&g_fscalls, 1, __ATOMIC_RELAXED);
+	spin_ns(fs->spin_ns);
+	if (fs->wait_us > 0) {
+		usleep(fs->wait_us);
+	}
+
+	if (offset >= FILE_SIZE) {
+		nbytes = 0;
+	} else if (nbytes > FILE_SIZE - offset) {
+		nbytes = FILE_SIZE - offset;
+	}
+
+	if (write) {
+		memcpy(bf->data + offset, buf, nbytes);
+	} else {
+		memcpy(buf, bf->data + offset, nbytes);
+	}
+	pthread_mutex_unlock(&fs->lock);
+	return nbytes;
+}
+
+ssize_t file_pread(FAR struct file *filep, FAR void *buf, size_t nbytes, off_t offset)
+{
+	return bench_io(filep, buf, nbytes, offset, false);
+}
+
+ssize_t file_pwrite(FAR struct file *filep, FAR const void *buf, size_t nbytes, off_t offset)
+{
+	return bench_io(filep, (FAR void *)buf, nbytes, offset, true);
+}
+
+ssize_t file_write(FAR struct file *filep, FAR const void *buf, size_t nbytes)
+{
+	set_errno(ENOSYS);
+	return ERROR;
+}
+
+int file_fsync(FAR struct file *filep)
+{
+	return OK;
+}
+
+int file_vfcntl(FAR struct file *filep, int cmd, va_list ap)
+{
+	return cmd == F_GETFL ? filep->f_oflags : OK;
+}
+
+static void mount_files(struct bench_fs *fs)
+{
+	int i;
+	int j;
+
+	for (i = 0; i < NFILES; i++) {
+		g_files[i].file.f_oflags = O_RDWR;
+		g_files[i].file.f_priv = &g_files[i];
+		g_files[i].fs = fs;
+		for (j = 0; j < FILE_SIZE; j++) {
+			g_files[i].data[j] = (uint8_t)(i * 7 + j);
+		}
+	}
+}
+
+/* Clients */
+
+static void submit(struct client_s *client, struct aiocb *cb, uint8_t *buf, off_t offset, bool write)
+{
+	memset(cb, 0, sizeof(*cb));
+	cb->aio_fildes = client->fd;
+	cb->aio_buf = buf;
+	cb->aio_nbytes = READ_SIZE;
+	cb->aio_offset = offset;
+	cb->aio_sigevent.sigev_value.sival_ptr = client;
+	if ((write ? aio_write(cb) : aio_read(cb)) < 0) {
+		fail(write ? "aio_write" : "aio_read", errno);
+	}
+}
+
+static void wait_all(struct client_s *client, struct aiocb *cb, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		while (sem_wait(&client->done) < 0) {
+		}
+	}
+
+	for (i = 0; i < n; i++) {
+		if (cb[i].aio_result != READ_SIZE) {
+			fail("aio result", cb[i].aio_result);
+		}
+	}
+}
+
+static void *client_thread(void *arg)
+{
+	struct client_s *client = arg;
+	struct aiocb cb[QDEPTH];
+	static __thread uint8_t buf[QDEPTH][READ_SIZE];
+	off_t offset;
+	int i;
+	int j;
+
+	for (offset = 0; offset < FILE_SIZE; offset += QDEPTH * READ_SIZE) {
+		for (i = 0; i < QDEPTH; i++) {
+			submit(client, &cb[i], buf[i], offset + i * READ_SIZE, false);
+		}
+
+		wait_all(client, cb, QDEPTH);
+		for (i = 0; i < QDEPTH; i++) {
+			for (j = 0; j < READ_SIZE; j++) {
+				if (buf[i][j] != (uint8_t)(client->fd * 7 + offset + i * READ_SIZE + j)) {
+					fail("content check", offset + i * READ_SIZE + j);
+				}
+			}
+		}
+	}
+
+	return NULL;
+}
+
+/* Adjacent writes and reads back of one file, merged by the AIO threads */
+
+static void check_writes(void)
+{
+	struct client_s client = { .fd = 0 };
+	struct aiocb cb[QDEPTH];
+	uint8_t buf[QDEPTH][READ_SIZE];
+	uint8_t back[QDEPTH][READ_SIZE];
+	int i;
+
+	sem_init(&client.done, 0, 0);
+	for (i = 0; i < QDEPTH; i++) {
+		memset(buf[i], 0xa0 + i, READ_SIZE);
+		submit(&client, &cb[i], buf[i], i * READ_SIZE, true);
+	}
+	wait_all(&client, cb, QDEPTH);
+
+	for (i = 0; i < QDEPTH; i++) {
+		submit(&client, &cb[i], back[i], i * READ_SIZE, false);
+	}
+	wait_all(&client, cb, QDEPTH);
+
+	if (memcmp(buf, back, sizeof(buf)) != 0) {
+		fail("write check", 0);
+	}
+	sem_destroy(&client.done);
+}
+
+static void bench_reads(struct bench_fs *fs, bool loaded)
+{
+	struct client_s clients[NFILES];
+	unsigned long calls;
+	double start;
+	double elapsed;
+	int nreads = NFILES * FILE_SIZE / READ_SIZE;
+	int i;
+
+	mount_files(fs);
+	g_loaded = loaded;
+	calls = g_fscalls;
+
+	start = now_sec();
+	for (i = 0; i < NFILES; i++) {
+		clients[i].fd = i;
+		sem_init(&clients[i].done, 0, 0);
+		pthread_create(&clients[i].thread, NULL, client_thread, &clients[i]);
+	}
+	for (i = 0; i < NFILES; i++) {
+		pthread_join(clients[i].thread, NULL);
+		sem_destroy(&clients[i].done);
+	}
+	elapsed = now_sec() - start;
+	g_loaded = false;
+
+	printf("%-6s %-7s %-11s %9.0f reads/s %6.2f file system calls/read\n", BUILD_NAME, fs->name,
+		   loaded ? "lpwork busy" : "lpwork idle", nreads / elapsed, (double)(g_fscalls - calls) / nreads);
+}
+
+int main(int argc, char **argv)
+{
+	pthread_t lpwork;
+	pthread_t load;
+
+	pthread_create(&lpwork, NULL, lpwork_thread, NULL);
+	pthread_create(&load, NULL, load_thread, NULL);
+	aio_initialize();
+
+	mount_files(&g_tmpfs);
+	check_writes();
+
+	bench_reads(&g_tmpfs, false);
+	bench_reads(&g_tmpfs, true);
+	bench_reads(&g_smartfs, false);
+	bench_reads(&g_smartfs, true);
+
+	g_stop = true;
+	pthread_join(load, NULL);
+	return 0;
+}
@@ -0,0 +1,72 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/* TizenRT definitions the AIO sources use, mapped to Linux.
+ * This header is included ahead of every source of the host build.
+ */
+
+#ifndef __TOOLS_BENCHMARK_AIO_HOST_PORT_H
+#define __TOOLS_BENCHMARK_AIO_HOST_PORT_H
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#define FAR
+#define CODE
+
+#ifndef OK
+#define OK    0
+#endif
+#ifndef ERROR
+#define ERROR -1
+#endif
+
+#define DEBUGASSERT(f) do { } while (0)
+#define DEBUGVERIFY(f) ((void)(f))
+#define get_errno()    errno
+#define set_errno(e)   do { errno = (e); } while (0)
+
+/* The reentrant AIO lock is keyed by the ID of the calling thread */
+
+#define INVALID_PROCESS_ID 0
+#define getpid()           ((pid_t)syscall(SYS_gettid))
+
+static inline int sched_lock(void)
+{
+	return 0;
+}
+
+static inline int sched_unlock(void)
+{
+	return 0;
+}
+
+#include <debug.h>
+
+#endif
@@ -0,0 +1,30 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_AIO_CONFIG_H
+#define __TOOLS_BENCHMARK_AIO_CONFIG_H
+
+/* Host build of os/fs/aio.  CONFIG_FS_AIO_POOL is given by the Makefile. */
+
+#define CONFIG_FS_AIO 1
+#define CONFIG_SCHED_WORKQUEUE 1
+#define CONFIG_SCHED_LPWORK 1
+#define CONFIG_NFILE_DESCRIPTORS 16
+#define CONFIG_NSOCKET_DESCRIPTORS 0
+#define CONFIG_FS_NAIOC 64
+
+#endif
@@ -0,0 +1,35 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_AIO_FS_H
+#define __TOOLS_BENCHMARK_AIO_FS_H
+
+#include <stdarg.h>
+
+struct file {
+	int f_oflags;
+	FAR void *f_priv;
+};
+
+int fs_getfilep(int fd, FAR struct file **filep);
+ssize_t file_write(FAR struct file *filep, FAR const void *buf, size_t nbytes);
+ssize_t file_pread(FAR struct file *filep, FAR void *buf, size_t nbytes, off_t offset);
+ssize_t file_pwrite(FAR struct file *filep, FAR const void *buf, size_t nbytes, off_t offset);
+int file_fsync(FAR struct file *filep);
+int file_vfcntl(FAR struct file *filep, int cmd, va_list ap);
+
+#endif
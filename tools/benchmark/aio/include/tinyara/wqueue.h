@@ -0,0 +1,38 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_AIO_WQUEUE_H
+#define __TOOLS_BENCHMARK_AIO_WQUEUE_H
+
+#include <time.h>
+
+/* One work queue thread stands for the low priority work queue */
+
+#define LPWORK 1
+
+typedef void (*worker_t)(FAR void *arg);
+
+struct work_s {
+	struct work_s *next;
+	worker_t worker;
+	FAR void *arg;
+};
+
+int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay);
+int work_cancel(int qid, FAR struct work_s *work);
+
+#endif
@@ -0,0 +1,350 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * tools/benchmark/araui/araui_bench.c
+ *
+ * Host benchmark of the AraUI renderer.  Typical widget scenes (an image
+ * screen, a text screen and zoomed/rotated images) are drawn with the same
+ * vertex/uv layout as the image and text widgets into a RGB888 frame buffer
+ * behind a stub DAL, and the frame rate is reported.  Every scene is also
+ * drawn as two ui_render_triangle_uv() calls per quad, which must produce the
+ * same frame as ui_render_quad_uv().
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <araui/ui_commons.h>
+#include "ui_commons_internal.h"
+#include "ui_renderer.h"
+#include "dal/ui_dal.h"
+
+#define FB_WIDTH      CONFIG_UI_DISPLAY_WIDTH
+#define FB_HEIGHT     CONFIG_UI_DISPLAY_HEIGHT
+#define FB_SIZE       (FB_WIDTH * FB_HEIGHT * 3)
+
+#define ICON_SIZE     (64)
+#define GLYPH_WIDTH   (12)
+#define GLYPH_HEIGHT  (16)
+#define NGLYPHS       (16)
+
+#define BENCH_SECONDS (0.5)
+
+#ifdef CONFIG_UI_RENDERER_FIXED_POINT
+#define RENDERER_NAME "fixed"
+#else
+#define RENDERER_NAME "float"
+#endif
+
+struct scene_s {
+	const char *name;
+	void (*draw)(void);
+};
+
+static uint8_t g_fb[FB_SIZE];
+static uint8_t g_check_fb[FB_SIZE];
+static uint8_t g_wallpaper[FB_WIDTH * FB_HEIGHT * 3];
+static uint8_t g_icon[ICON_SIZE * ICON_SIZE * 4];
+static uint8_t g_glyphs[NGLYPHS][GLYPH_WIDTH * GLYPH_HEIGHT];
+static bool g_split_quads;
+static unsigned long g_pixels;
+
+/****************************************************************************
+ * Stub DAL: blend into the frame buffer like the simulator does
+ ****************************************************************************/
+
+UI_DAL void ui_dal_put_pixel_rgba8888(int32_t x, int32_t y, ui_color_t color)
+{
+	ui_color_rgba8888_t *fg;
+	ui_color_rgb888_t *bg;
+
+	if (x < 0 || x >= FB_WIDTH || y < 0 || y >= FB_HEIGHT) {
+		return;
+	}
+
+	fg = (ui_color_rgba8888_t *)&color;
+	bg = (ui_color_rgb888_t *)&g_fb[(y * FB_WIDTH + x) * 3];
+
+	bg->r = ((fg->r * fg->a) + (bg->r * (255 - fg->a))) / 255;
+	bg->g = ((fg->g * fg->a) + (bg->g * (255 - fg->a))) / 255;
+	bg->b = ((fg->b * fg->a) + (bg->b * (255 - fg->a))) / 255;
+	g_pixels++;
+}
+
+UI_DAL void ui_dal_put_pixel_rgb888(int32_t x, int32_t y, ui_color_t color)
+{
+	ui_color_rgb888_t *fg;
+	ui_color_rgb888_t *bg;
+
+	if (x < 0 || x >= FB_WIDTH || y < 0 || y >= FB_HEIGHT) {
+		return;
+	}
+
+	fg = (ui_color_rgb888_t *)&color;
+	bg = (ui_color_rgb888_t *)&g_fb[(y * FB_WIDTH + x) * 3];
+	bg->r = fg->r;
+	bg->g = fg->g;
+	bg->b = fg->b;
+	g_pixels++;
+}
+
+/****************************************************************************
+ * Scenes
+ ****************************************************************************/
+
+static void make_textures(void)
+{
+	int x;
+	int y;
+	int g;
+	int dx;
+	int dy;
+	uint8_t *p;
+
+	for (y = 0; y < FB_HEIGHT; y++) {
+		for (x = 0; x < FB_WIDTH; x++) {
+			p = &g_wallpaper[(y * FB_WIDTH + x) * 3];
+			p[0] = x * 255 / FB_WIDTH;
+			p[1] = y * 255 / FB_HEIGHT;
+			p[2] = ((x / 8) ^ (y / 8)) & 1 ? 0xc0 : 0x40;
+		}
+	}
+
+	// A round icon: opaque inside, anti-aliased edge, transparent corners
+	for (y = 0; y < ICON_SIZE; y++) {
+		for (x = 0; x < ICON_SIZE; x++) {
+			p = &g_icon[(y * ICON_SIZE + x) * 4];
+			dx = 2 * x + 1 - ICON_SIZE;
+			dy = 2 * y + 1 - ICON_SIZE;
+			p[0] = 0xff;
+			p[1] = x * 4;
+			p[2] = y * 4;
+			p[3] = UI_MAX(0, UI_MIN(255, (ICON_SIZE * ICON_SIZE - (dx * dx + dy * dy)) / 4));
+		}
+	}
+
+	// Pseudo glyphs: strokes with soft edges, mostly empty like real text
+	for (g = 0; g < NGLYPHS; g++) {
+		for (y = 2; y < GLYPH_HEIGHT - 2; y++) {
+			for (x = 1; x < GLYPH_WIDTH - 1; x++) {
+				if (x == 2 + (g % 4) || y == 3 + (g % 9) || (g & 1 && x == y - 2)) {
+					g_glyphs[g][y * GLYPH_WIDTH + x] = 0xff;
+				} else if (x == 3 + (g % 4) || y == 4 + (g % 9)) {
+					g_glyphs[g][y * GLYPH_WIDTH + x] = 0x60;
+				}
+			}
+		}
+	}
+}
+
+/* Draw a texture like ui_image_widget_render_func() does: the quad is
+ * (-pivot) ~ (-pivot + size) in local space, and trans_mat carries the
+ * position, rotation and scale of the widget.
+ */
+static void draw_image(ui_mat3_t *mat, float pivot_x, float pivot_y, float width, float height)
+{
+	ui_vec3_t v1 = { -pivot_x, -pivot_y, 1.0f };
+	ui_vec3_t v2 = { -pivot_x, -pivot_y + height, 1.0f };
+	ui_vec3_t v3 = { -pivot_x + width, -pivot_y + height, 1.0f };
+	ui_vec3_t v4 = { -pivot_x + width, -pivot_y, 1.0f };
+	ui_uv_t uv1 = { 0.0f, 0.0f };
+	ui_uv_t uv2 = { 0.0f, 1.0f };
+	ui_uv_t uv3 = { 1.0f, 1.0f };
+	ui_uv_t uv4 = { 1.0f, 0.0f };
+
+	if (g_split_quads) {
+		ui_render_triangle_uv(mat, v1, v2, v3, uv1, uv2, uv3);
+		ui_render_triangle_uv(mat, v1, v3, v4, uv1, uv3, uv4);
+	} else {
+		ui_render_quad_uv(mat, v1, v2, v3, v4, uv1, uv2, uv3, uv4);
+	}
+}
+
+static void widget_matrix(ui_mat3_t *mat, float x, float y, int32_t deg, float scale)
+{
+	ui_mat3_t identity = ui_mat3_identity();
+
+	ui_renderer_translate(&identity, mat, x, y);
+	if (deg) {
+		ui_renderer_rotate(mat, deg);
+	}
+	if (scale != 1.0f) {
+		ui_renderer_scale(mat, scale, scale);
+	}
+}
+
+static void draw_icons(int32_t deg, float scale)
+{
+	ui_mat3_t mat;
+	int i;
+
+	ui_renderer_set_texture(g_icon, ICON_SIZE, ICON_SIZE, UI_PIXEL_FORMAT_RGBA8888);
+	for (i = 0; i < 16; i++) {
+		widget_matrix(&mat, 45 + (i % 4) * 90, 45 + (i / 4) * 90, deg, scale);
+		draw_image(&mat, ICON_SIZE / 2, ICON_SIZE / 2, ICON_SIZE, ICON_SIZE);
+	}
+	ui_renderer_set_texture(NULL, 0, 0, UI_PIXEL_FORMAT_UNKNOWN);
+}
+
+static void draw_wallpaper(int32_t deg, float scale)
+{
+	ui_mat3_t mat;
+
+	widget_matrix(&mat, FB_WIDTH / 2, FB_HEIGHT / 2, deg, scale);
+	ui_renderer_set_texture(g_wallpaper, FB_WIDTH, FB_HEIGHT, UI_PIXEL_FORMAT_RGB888);
+	draw_image(&mat, FB_WIDTH / 2, FB_HEIGHT / 2, FB_WIDTH, FB_HEIGHT);
+	ui_renderer_set_texture(NULL, 0, 0, UI_PIXEL_FORMAT_UNKNOWN);
+}
+
+static void scene_image(void)
+{
+	draw_wallpaper(0, 1.0f);
+	draw_icons(0, 1.0f);
+}
+
+/* Like ui_text_widget_render_func(): one A8 quad per glyph, translated from
+ * the widget matrix by the pen position.
+ */
+static void scene_text(void)
+{
+	ui_mat3_t widget_mat;
+	ui_mat3_t text_mat;
+	int line;
+	int col;
+	int g;
+
+	widget_matrix(&widget_mat, 8, 4, 0, 1.0f);
+	ui_renderer_set_fill_color(0xffffff);
+	for (line = 0; line < 20; line++) {
+		for (col = 0; col < 28; col++) {
+			g = (line * 7 + col) % NGLYPHS;
+			ui_renderer_translate(&widget_mat, &text_mat, (float)(col * GLYPH_WIDTH), (float)(line * (GLYPH_HEIGHT + 2)));
+			ui_renderer_set_texture(g_glyphs[g], GLYPH_WIDTH, GLYPH_HEIGHT, UI_PIXEL_FORMAT_A8);
+			draw_image(&text_mat, 0.0f, 0.0f, GLYPH_WIDTH, GLYPH_HEIGHT);
+		}
+	}
+	ui_renderer_set_texture(NULL, 0, 0, UI_PIXEL_FORMAT_UNKNOWN);
+	ui_renderer_set_fill_color(0x000000);
+}
+
+static void scene_scaled(void)
+{
+	draw_wallpaper(0, 1.25f);
+	draw_icons(0, 0.75f);
+}
+
+static void scene_rotated(void)
+{
+	draw_wallpaper(10, 1.0f);
+	draw_icons(30, 1.0f);
+}
+
+static const struct scene_s g_scenes[] = {
+	{"image", scene_image},
+	{"text", scene_text},
+	{"scaled", scene_scaled},
+	{"rotated", scene_rotated},
+};
+
+#define NSCENES (sizeof(g_scenes) / sizeof(g_scenes[0]))
+
+/****************************************************************************
+ * Main
+ ****************************************************************************/
+
+static double now_sec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void render_frame(const struct scene_s *scene)
+{
+	memset(g_fb, 0, FB_SIZE);
+	scene->draw();
+}
+
+static int check_scene(const struct scene_s *scene)
+{
+	int mismatch = 0;
+	int i;
+
+	g_split_quads = true;
+	render_frame(scene);
+	memcpy(g_check_fb, g_fb, FB_SIZE);
+
+	g_split_quads = false;
+	render_frame(scene);
+
+	for (i = 0; i < FB_SIZE; i += 3) {
+		if (memcmp(&g_fb[i], &g_check_fb[i], 3)) {
+			mismatch++;
+		}
+	}
+
+	return mismatch;
+}
+
+int main(void)
+{
+	const struct scene_s *scene;
+	unsigned int i;
+	unsigned long frames;
+	double start;
+	double elapsed;
+	int mismatch;
+	int ret = 0;
+
+	make_textures();
+
+	printf("%s renderer, %dx%d RGB888\n", RENDERER_NAME, FB_WIDTH, FB_HEIGHT);
+	printf("%-8s %10s %12s %s\n", "scene", "fps", "pixels", "quad vs triangles");
+
+	for (i = 0; i < NSCENES; i++) {
+		scene = &g_scenes[i];
+
+		mismatch = check_scene(scene);
+		if (mismatch) {
+			ret = 1;
+		}
+
+		frames = 0;
+		g_pixels = 0;
+		start = now_sec();
+		do {
+			render_frame(scene);
+			frames++;
+			elapsed = now_sec() - start;
+		} while (elapsed < BENCH_SECONDS);
+
+		printf("%-8s %10.1f %12lu ", scene->name, frames / elapsed, g_pixels / frames);
+		if (mismatch) {
+			printf("%d pixels differ\n", mismatch);
+		} else {
+			printf("identical\n");
+		}
+	}
+
+	return ret;
+}
@@ -0,0 +1,228 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * tools/benchmark/araui/araui_text_bench.c
+ *
+ * Host benchmark of the AraUI text widget.  A word wrapped paragraph is
+ * redrawn through the render callback of the text widget into a RGB888 frame
+ * buffer behind a stub DAL, and the redraws per second are reported.  The
+ * "relayout" case drops the layout of the widget before every redraw, like a
+ * text whose string changes every frame.  The checksum of the first frame
+ * must be the same with and without CONFIG_UI_GLYPH_CACHE.
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <araui/ui_commons.h>
+#include <araui/ui_asset.h>
+#include <araui/ui_widget.h>
+#include "ui_request_callback.h"
+#include "ui_widget_internal.h"
+#include "ui_asset_internal.h"
+#include "ui_renderer.h"
+#include "dal/ui_dal.h"
+
+#define FB_WIDTH      CONFIG_UI_DISPLAY_WIDTH
+#define FB_HEIGHT     CONFIG_UI_DISPLAY_HEIGHT
+#define FB_SIZE       (FB_WIDTH * FB_HEIGHT * 3)
+
+#define TEXT_MARGIN   (10)
+#define FONT_SIZE     (16)
+#define DEFAULT_FONT  "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf"
+
+#define BENCH_SECONDS (0.5)
+
+#ifdef CONFIG_UI_GLYPH_CACHE
+#define CACHE_NAME "glyph cache"
+#else
+#define CACHE_NAME "no glyph cache"
+#endif
+
+static const char g_paragraph[] =
+	"TizenRT is a lightweight RTOS-based platform to support low-end IoT devices. "
+	"It provides an easy-to-use, full-stack IoT development environment, including "
+	"the OS kernel, the network stack, the file system and the graphic framework. "
+	"AraUI draws the widgets of the screen, and the text widget breaks a paragraph "
+	"into lines which fit the width of the widget.\n"
+	"The quick brown fox jumps over the lazy dog. 0123456789 !?@#$%&*()";
+
+static uint8_t g_fb[FB_SIZE];
+
+/****************************************************************************
+ * Stubs of the UI core, the widget and the asset modules
+ ****************************************************************************/
+
+bool ui_is_running(void)
+{
+	return true;
+}
+
+ui_error_t ui_request_callback(request_callback func, void *userdata)
+{
+	func(userdata);
+	return UI_OK;
+}
+
+bool ui_asset_check_type(ui_asset_t asset, ui_asset_type_t type)
+{
+	return (((ui_asset_body_t *)asset)->type == type);
+}
+
+bool ui_widget_check_widget_type(ui_widget_t widget, ui_widget_type_t type)
+{
+	return (((ui_widget_body_t *)widget)->type == type);
+}
+
+void ui_widget_init(ui_widget_body_t *body, int32_t width, int32_t height)
+{
+	body->visible = true;
+	body->local_rect.width = width;
+	body->local_rect.height = height;
+	body->global_rect = body->local_rect;
+	body->scale_x = 1.0f;
+	body->scale_y = 1.0f;
+	body->trans_mat = ui_mat3_identity();
+}
+
+void ui_widget_deinit(ui_widget_body_t *body)
+{
+}
+
+/****************************************************************************
+ * Stub DAL: blend into the frame buffer like the simulator does
+ ****************************************************************************/
+
+UI_DAL void ui_dal_put_pixel_rgba8888(int32_t x, int32_t y, ui_color_t color)
+{
+	ui_color_rgba8888_t *fg;
+	ui_color_rgb888_t *bg;
+
+	if (x < 0 || x >= FB_WIDTH || y < 0 || y >= FB_HEIGHT) {
+		return;
+	}
+
+	fg = (ui_color_rgba8888_t *)&color;
+	bg = (ui_color_rgb888_t *)&g_fb[(y * FB_WIDTH + x) * 3];
+
+	bg->r = ((fg->r * fg->a) + (bg->r * (255 - fg->a))) / 255;
+	bg->g = ((fg->g * fg->a) + (bg->g * (255 - fg->a))) / 255;
+	bg->b = ((fg->b * fg->a) + (bg->b * (255 - fg->a))) / 255;
+}
+
+UI_DAL void ui_dal_put_pixel_rgb888(int32_t x, int32_t y, ui_color_t color)
+{
+	ui_color_rgb888_t *fg;
+	ui_color_rgb888_t *bg;
+
+	if (x < 0 || x >= FB_WIDTH || y < 0 || y >= FB_HEIGHT) {
+		return;
+	}
+
+	fg = (ui_color_rgb888_t *)&color;
+	bg = (ui_color_rgb888_t *)&g_fb[(y * FB_WIDTH + x) * 3];
+	bg->r = fg->r;
+	bg->g = fg->g;
+	bg->b = fg->b;
+}
+
+/****************************************************************************
+ * Benchmark
+ ****************************************************************************/
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static uint32_t checksum(void)
+{
+	uint32_t sum = 0;
+	int i;
+
+	for (i = 0; i < FB_SIZE; i++) {
+		sum = sum * 31 + g_fb[i];
+	}
+
+	return sum;
+}
+
+static void bench(ui_text_widget_body_t *body, const char *name, bool relayout)
+{
+	double start;
+	double elapsed;
+	unsigned long frames = 0;
+
+	start = now();
+	do {
+		if (relayout) {
+			body->layout_valid = false;
+		}
+		body->base.render_cb((ui_widget_t)body, 0);
+		frames++;
+		elapsed = now() - start;
+	} while (elapsed < BENCH_SECONDS);
+
+	printf("  %-10s %9.1f redraws/s\n", name, frames / elapsed);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *path = argc > 1 ? argv[1] : DEFAULT_FONT;
+	ui_asset_t font;
+	ui_widget_t widget;
+	ui_text_widget_body_t *body;
+	ui_mat3_t identity = ui_mat3_identity();
+
+	font = ui_font_asset_create_from_file(path);
+	if (!font) {
+		printf("skipped: cannot load the font %s\n", path);
+		return 0;
+	}
+
+	widget = ui_text_widget_create(FB_WIDTH - 2 * TEXT_MARGIN, FB_HEIGHT - 2 * TEXT_MARGIN, font, g_paragraph, FONT_SIZE);
+	if (!widget) {
+		printf("failed to create the text widget\n");
+		return 1;
+	}
+
+	ui_text_widget_set_word_wrap(widget, true);
+	ui_text_widget_set_align(widget, UI_ALIGN_LEFT | UI_ALIGN_TOP);
+
+	body = (ui_text_widget_body_t *)widget;
+	body->base.global_rect.x = TEXT_MARGIN;
+	body->base.global_rect.y = TEXT_MARGIN;
+	ui_renderer_translate(&identity, &body->base.trans_mat, TEXT_MARGIN, TEXT_MARGIN);
+
+	body->base.render_cb(widget, 0);
+
+	printf("text widget, %s: %u glyphs in %u lines, checksum %08x\n", CACHE_NAME,
+		(unsigned)body->layout_len, (unsigned)body->line_num, checksum());
+
+	bench(body, "relayout", true);
+	bench(body, "layout", false);
+
+	return 0;
+}
@@ -0,0 +1,31 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_ARAUI_CONFIG_H
+#define __TOOLS_BENCHMARK_ARAUI_CONFIG_H
+
+/* Host build of the AraUI renderer: a 360x360 RGB888 display */
+
+#define OK 0
+
+#define CONFIG_UI
+#define CONFIG_UI_DISPLAY_RGB888
+#define CONFIG_UI_DISPLAY_WIDTH       (360)
+#define CONFIG_UI_DISPLAY_HEIGHT      (360)
+#define CONFIG_UI_UPDATE_MEMPOOL_SIZE (128)
+
+#endif
@@ -0,0 +1,160 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * tools/benchmark/crc/crc_bench.c
+ *
+ * Host benchmark of crc32part(), crc16part() and crc8part() in libc/misc.
+ * Every sliced build is checked against the byte-wise build for random
+ * lengths, seeds and source alignments before it is timed.
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CRC_DECLARE(s) \
+	uint32_t crc32part_s##s(const uint8_t *src, size_t len, uint32_t crc32val); \
+	uint16_t crc16part_s##s(const uint8_t *src, size_t len, uint16_t crc16val); \
+	uint8_t crc8part_s##s(const uint8_t *src, size_t len, uint8_t crc8val);
+
+CRC_DECLARE(1)
+CRC_DECLARE(4)
+CRC_DECLARE(8)
+
+#define CHECK_ROUNDS  20000
+#define CHECK_MAXLEN  1024
+#define BENCH_BYTES   (64 * 1024 * 1024)
+
+struct crc_impl_s {
+	const char *name;
+	int slices;
+	uint32_t (*fn)(const uint8_t *src, size_t len, uint32_t crc);
+};
+
+#define CRC_WRAP(bits, s) \
+	static uint32_t crc##bits##_wrap_s##s(const uint8_t *src, size_t len, uint32_t crc) \
+	{ \
+		return crc##bits##part_s##s(src, len, crc); \
+	}
+
+CRC_WRAP(32, 1) CRC_WRAP(32, 4) CRC_WRAP(32, 8)
+CRC_WRAP(16, 1) CRC_WRAP(16, 4) CRC_WRAP(16, 8)
+CRC_WRAP(8, 1) CRC_WRAP(8, 4) CRC_WRAP(8, 8)
+
+static const struct crc_impl_s g_impls[] = {
+	{"crc32", 1, crc32_wrap_s1}, {"crc32", 4, crc32_wrap_s4}, {"crc32", 8, crc32_wrap_s8},
+	{"crc16", 1, crc16_wrap_s1}, {"crc16", 4, crc16_wrap_s4}, {"crc16", 8, crc16_wrap_s8},
+	{"crc8", 1, crc8_wrap_s1}, {"crc8", 4, crc8_wrap_s4}, {"crc8", 8, crc8_wrap_s8},
+};
+
+#define NIMPLS (sizeof(g_impls) / sizeof(g_impls[0]))
+
+static double now_sec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int crc_check(void)
+{
+	static uint8_t buf[CHECK_MAXLEN + 8];
+	unsigned int i;
+	int round;
+	size_t len;
+	size_t off;
+	uint32_t seed;
+	uint32_t ref = 0;
+	uint32_t val;
+
+	for (round = 0; round < CHECK_ROUNDS; round++) {
+		len = rand() % CHECK_MAXLEN;
+		off = rand() % 8;
+		seed = ((uint32_t)rand() << 16) ^ rand();
+		for (i = 0; i < len + off; i++) {
+			buf[i] = rand();
+		}
+
+		for (i = 0; i < NIMPLS; i++) {
+			/* The first entry of every CRC is the byte-wise reference. */
+			if (g_impls[i].slices == 1) {
+				ref = g_impls[i].fn(buf + off, len, seed);
+				continue;
+			}
+			val = g_impls[i].fn(buf + off, len, seed);
+			if (val != ref) {
+				printf("FAIL %s slice-by-%d : len %zu off %zu seed 0x%08x : 0x%08x != 0x%08x\n",
+					   g_impls[i].name, g_impls[i].slices, len, off, seed, val, ref);
+				return -1;
+			}
+		}
+	}
+
+	printf("cross-check : %d random buffers match the byte-wise CRCs\n", CHECK_ROUNDS);
+	return 0;
+}
+
+static void crc_bench(size_t chunk)
+{
+	uint8_t *buf;
+	unsigned int i;
+	size_t done;
+	double start;
+	double elapsed;
+	volatile uint32_t sink = 0;
+
+	buf = malloc(chunk + 1);
+	if (buf == NULL) {
+		return;
+	}
+	for (done = 0; done < chunk + 1; done++) {
+		buf[done] = rand();
+	}
+
+	printf("\n%zu byte buffers\n", chunk);
+	for (i = 0; i < NIMPLS; i++) {
+		start = now_sec();
+		for (done = 0; done < BENCH_BYTES; done += chunk) {
+			/* Use an odd address to include the unaligned case. */
+			sink += g_impls[i].fn(buf + ((done / chunk) & 1), chunk, sink);
+		}
+		elapsed = now_sec() - start;
+		printf("  %-6s slice-by-%d : %8.1f MB/s\n", g_impls[i].name, g_impls[i].slices, BENCH_BYTES / elapsed / (1024 * 1024));
+	}
+
+	free(buf);
+}
+
+int main(int argc, char **argv)
+{
+	srand(1);
+
+	if (crc_check() != 0) {
+		return 1;
+	}
+
+	/* 32 bytes is a binary header, 512/4096 bytes are SmartFS sectors. */
+	crc_bench(32);
+	crc_bench(512);
+	crc_bench(4096);
+
+	return 0;
+}
@@ -0,0 +1,3 @@
+/* Host replacement of lib/libc/lib_internal.h.
+ * LIB_CRC_NSLICES is given on the command line by the Makefile.
+ */
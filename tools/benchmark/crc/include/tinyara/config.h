@@ -0,0 +1 @@
+/* Host build of the libc CRC routines does not need any configuration. */
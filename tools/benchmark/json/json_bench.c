@@ -0,0 +1,451 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * tools/benchmark/json/json_bench.c
+ *
+ * Host benchmark of the cJSON parse modes on a generated device shadow
+ * document. Every tree is compared with the cJSON_Parse() tree and the SAX
+ * events with a walk of that tree, also for chunks split at every byte,
+ * before the throughput and the peak heap of each mode are measured.
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <json/cJSON.h>
+#include <json/cJSON_SAX.h>
+
+#define DOC_DEVICES   120
+#define DOC_SIZE      (DOC_DEVICES * 1024)
+#define BENCH_BYTES   (256 * 1024 * 1024)
+#define SAX_CHUNK     536
+#define SAX_TOKEN     256
+
+/* header of a heap block, as the mm_allocnode of the TizenRT heap */
+#define HEAP_OVERHEAD 8
+
+/* Heap accounting through cJSON_InitHooks */
+
+struct heap_hdr {
+	size_t size;
+	size_t pad;
+};
+
+static size_t g_heap_cur;
+static size_t g_heap_peak;
+static unsigned long g_heap_allocs;
+
+static void *count_malloc(size_t size)
+{
+	struct heap_hdr *hdr = malloc(sizeof(struct heap_hdr) + size);
+
+	if (!hdr) {
+		return NULL;
+	}
+	hdr->size = size + HEAP_OVERHEAD;
+	g_heap_cur += hdr->size;
+	g_heap_allocs++;
+	if (g_heap_cur > g_heap_peak) {
+		g_heap_peak = g_heap_cur;
+	}
+	return hdr + 1;
+}
+
+static void count_free(void *ptr)
+{
+	struct heap_hdr *hdr;
+
+	if (!ptr) {
+		return;
+	}
+	hdr = (struct heap_hdr *)ptr - 1;
+	g_heap_cur -= hdr->size;
+	free(hdr);
+}
+
+static void heap_reset(void)
+{
+	g_heap_peak = g_heap_cur;
+	g_heap_allocs = 0;
+}
+
+static double now_sec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* A shadow document like the ones of the cloud services, with escapes */
+
+static size_t make_doc(char *doc, size_t size)
+{
+	size_t len = 0;
+	int i;
+
+	len += snprintf(doc + len, size - len, "{\"state\":{\"reported\":{\"firmware\":\"TizenRT 3.0\",\"uptime\":123456,\"devices\":[");
+	for (i = 0; i < DOC_DEVICES; i++) {
+		len += snprintf(doc + len, size - len,
+			"%s\n  {\"id\":\"dev-%04d\",\"name\":\"Living room \\\"lamp\\\" %d \\u00e9\\ud83d\\ude00\",\"on\":%s,"
+			"\"level\":%d,\"temperature\":%d.%d,\"energy\":%de-3,\"owner\":null,"
+			"\"tags\":[\"light\",\"dimmable\",\"zone\\/%d\"],\"schedule\":[{\"at\":\"07:00\",\"level\":80},"
+			"{\"at\":\"23:30\",\"level\":0}],\"path\":\"C:\\\\devices\\\\%d\\n\"}",
+			i ? "," : "", i, i, (i & 1) ? "true" : "false", i % 101, 18 + i % 10, i % 10, i * 37, i % 8, i);
+	}
+	len += snprintf(doc + len, size - len, "]},\"desired\":{\"level\":-42.5e1,\"scene\":\"night\"}},\"version\":%d,\"timestamp\":1588000000}", DOC_DEVICES);
+
+	return len;
+}
+
+/* Event digest, computed from the SAX callbacks and from a tree walk */
+
+static uint32_t g_digest;
+static unsigned long g_events;
+
+static void digest(const void *data, size_t len)
+{
+	const unsigned char *p = data;
+
+	while (len--) {
+		g_digest = (g_digest ^ *p++) * 16777619u;
+	}
+	g_events++;
+}
+
+static void digest_event(char ev, const void *data, size_t len)
+{
+	digest(&ev, 1);
+	if (data) {
+		digest(data, len);
+	}
+}
+
+static cJSON_bool sax_start_object(void *user)
+{
+	digest_event('{', NULL, 0);
+	return true;
+}
+
+static cJSON_bool sax_end_object(void *user)
+{
+	digest_event('}', NULL, 0);
+	return true;
+}
+
+static cJSON_bool sax_start_array(void *user)
+{
+	digest_event('[', NULL, 0);
+	return true;
+}
+
+static cJSON_bool sax_end_array(void *user)
+{
+	digest_event(']', NULL, 0);
+	return true;
+}
+
+static cJSON_bool sax_key(void *user, const char *key, size_t length)
+{
+	digest_event('k', key, length);
+	return true;
+}
+
+static cJSON_bool sax_string(void *user, const char *value, size_t length)
+{
+	digest_event('s', value, length);
+	return true;
+}
+
+static cJSON_bool sax_number(void *user, double value)
+{
+	digest_event('n', &value, sizeof(value));
+	return true;
+}
+
+static cJSON_bool sax_boolean(void *user, cJSON_bool value)
+{
+	digest_event(value ? 't' : 'f', NULL, 0);
+	return true;
+}
+
+static cJSON_bool sax_null(void *user)
+{
+	digest_event('0', NULL, 0);
+	return true;
+}
+
+static const cJSON_SAX_Callbacks g_sax_callbacks = {
+	sax_start_object, sax_end_object, sax_start_array, sax_end_array,
+	sax_key, sax_string, sax_number, sax_boolean, sax_null
+};
+
+static void walk(const cJSON *item)
+{
+	const cJSON *child;
+
+	if (item->string) {
+		digest_event('k', item->string, strlen(item->string));
+	}
+	switch (item->type & 0xFF) {
+	case cJSON_Object:
+	case cJSON_Array:
+		digest_event(cJSON_IsObject(item) ? '{' : '[', NULL, 0);
+		cJSON_ArrayForEach(child, item) {
+			walk(child);
+		}
+		digest_event(cJSON_IsObject(item) ? '}' : ']', NULL, 0);
+		break;
+	case cJSON_String:
+		digest_event('s', item->valuestring, strlen(item->valuestring));
+		break;
+	case cJSON_Number:
+		digest_event('n', &item->valuedouble, sizeof(item->valuedouble));
+		break;
+	case cJSON_True:
+		digest_event('t', NULL, 0);
+		break;
+	case cJSON_False:
+		digest_event('f', NULL, 0);
+		break;
+	default:
+		digest_event('0', NULL, 0);
+		break;
+	}
+}
+
+static int sax_parse(const char *doc, size_t len, size_t chunk)
+{
+	static char token[SAX_TOKEN];
+	cJSON_SAX sax;
+	size_t off;
+	size_t n;
+
+	cJSON_SAX_Init(&sax, &g_sax_callbacks, NULL, token, sizeof(token));
+	for (off = 0; off < len; off += n) {
+		n = (len - off < chunk) ? len - off : chunk;
+		if (!cJSON_SAX_Feed(&sax, doc + off, n)) {
+			return -1;
+		}
+	}
+	return cJSON_SAX_Finish(&sax) ? 0 : -1;
+}
+
+/* Checks */
+
+static const char *g_good[] = {
+	"0", "-1.5e3", "\"x\"", "true", " null ", "[]", "{}", "[[],{}]", "{\"a\":[1,{\"b\":\"\\u0041\"}]}",
+};
+
+static const char *g_bad[] = {
+	"", "[", "{\"a\"}", "{\"a\":}", "[1,]x", "tru", "\"abc", "\"\\x\"", "\"\\ud800\"", "[1 2]", "{1:2}", "[1]]", "-", "{\"a\":1,}",
+};
+
+static int check(const char *doc, size_t len)
+{
+	char *work = malloc(len + 1);
+	cJSON_Arena *arena = cJSON_CreateArena(0);
+	cJSON *ref;
+	cJSON *tree;
+	uint32_t want;
+	size_t chunk;
+	unsigned int i;
+	int ret = -1;
+
+	ref = cJSON_Parse(doc);
+	if (!ref) {
+		printf("cJSON_Parse failed\n");
+		goto out;
+	}
+
+	memcpy(work, doc, len + 1);
+	tree = cJSON_ParseInSitu(work);
+	if (!tree || !cJSON_Compare(ref, tree, true)) {
+		printf("in-situ tree differs\n");
+		goto out;
+	}
+	cJSON_Delete(tree);
+
+	tree = cJSON_ParseWithArena(arena, doc);
+	if (!tree || !cJSON_Compare(ref, tree, true)) {
+		printf("arena tree differs\n");
+		goto out;
+	}
+	/* a copy of an arena tree must survive the arena */
+	tree = cJSON_Duplicate(tree, true);
+	cJSON_ResetArena(arena);
+	memcpy(work, doc, len + 1);
+	if (!tree || !cJSON_Compare(ref, tree, true) || !cJSON_Compare(ref, cJSON_ParseInSituWithArena(arena, work), true)) {
+		printf("in-situ arena tree differs\n");
+		goto out;
+	}
+	cJSON_Delete(tree);
+
+	g_digest = 2166136261u;
+	g_events = 0;
+	walk(ref);
+	want = g_digest;
+	printf("%lu events per document\n", g_events);
+	for (chunk = 1; chunk <= SAX_CHUNK; chunk = chunk < 16 ? chunk + 1 : chunk * 2) {
+		g_digest = 2166136261u;
+		if (sax_parse(doc, len, chunk) < 0 || g_digest != want) {
+			printf("SAX events differ with %zu byte chunks\n", chunk);
+			goto out;
+		}
+	}
+
+	for (i = 0; i < sizeof(g_good) / sizeof(g_good[0]); i++) {
+		cJSON *good = cJSON_Parse(g_good[i]);
+
+		g_digest = 2166136261u;
+		walk(good);
+		want = g_digest;
+		cJSON_Delete(good);
+		for (chunk = 1; chunk <= 2; chunk++) {
+			g_digest = 2166136261u;
+			if (sax_parse(g_good[i], strlen(g_good[i]), chunk) < 0 || g_digest != want) {
+				printf("SAX rejects '%s'\n", g_good[i]);
+				goto out;
+			}
+		}
+	}
+	for (i = 0; i < sizeof(g_bad) / sizeof(g_bad[0]); i++) {
+		strcpy(work, g_bad[i]);
+		if (sax_parse(g_bad[i], strlen(g_bad[i]), 1) == 0 || cJSON_ParseWithOpts(g_bad[i], NULL, true) || cJSON_ParseInSituWithOpts(work, NULL, true)) {
+			printf("'%s' is accepted\n", g_bad[i]);
+			goto out;
+		}
+	}
+
+	printf("checks passed\n");
+	ret = 0;
+
+out:
+	cJSON_Delete(ref);
+	cJSON_DeleteArena(arena);
+	free(work);
+	if (ret == 0 && g_heap_cur != 0) {
+		printf("%zu bytes leaked\n", g_heap_cur);
+		ret = -1;
+	}
+	return ret;
+}
+
+/* Measurements */
+
+enum {
+	MODE_PARSE,
+	MODE_INSITU,
+	MODE_ARENA,
+	MODE_INSITU_ARENA,
+	MODE_SAX,
+	MODE_MAX
+};
+
+static const char *g_mode_names[MODE_MAX] = {
+	"cJSON_Parse", "in-situ", "arena", "in-situ + arena", "SAX 536B chunks"
+};
+
+static void bench(int mode, const char *doc, size_t len)
+{
+	char *work = malloc(len + 1);
+	cJSON_Arena *arena = NULL;
+	unsigned long allocs = 0;
+	size_t peak = 0;
+	double start;
+	double elapsed;
+	int iters = BENCH_BYTES / len;
+	int i;
+
+	if (mode == MODE_ARENA || mode == MODE_INSITU_ARENA) {
+		arena = cJSON_CreateArena(16 * 1024);
+	}
+
+	heap_reset();
+	start = now_sec();
+	for (i = 0; i < iters; i++) {
+		cJSON *tree = NULL;
+
+		switch (mode) {
+		case MODE_PARSE:
+			tree = cJSON_Parse(doc);
+			break;
+		case MODE_INSITU:
+			memcpy(work, doc, len + 1);
+			tree = cJSON_ParseInSitu(work);
+			break;
+		case MODE_ARENA:
+			tree = cJSON_ParseWithArena(arena, doc);
+			break;
+		case MODE_INSITU_ARENA:
+			memcpy(work, doc, len + 1);
+			tree = cJSON_ParseInSituWithArena(arena, work);
+			break;
+		case MODE_SAX:
+			sax_parse(doc, len, SAX_CHUNK);
+			break;
+		}
+		if (i == 0) {
+			/* the first parse of the arena allocates the chunks, later ones reuse them */
+			peak = g_heap_peak;
+			allocs = g_heap_allocs;
+		}
+		if (arena) {
+			cJSON_ResetArena(arena);
+		} else {
+			cJSON_Delete(tree);
+		}
+	}
+	elapsed = now_sec() - start;
+
+	cJSON_DeleteArena(arena);
+	free(work);
+
+	if (mode == MODE_SAX) {
+		peak = sizeof(cJSON_SAX) + SAX_TOKEN;
+	}
+	printf("%-16s %8.1f MB/s %9zu B peak (%4.2fx doc) %7lu allocs/parse\n", g_mode_names[mode],
+		   (double)len * iters / elapsed / 1e6, peak, (double)peak / len, allocs);
+}
+
+int main(void)
+{
+	cJSON_Hooks hooks = { count_malloc, count_free };
+	char *doc = malloc(DOC_SIZE);
+	size_t len;
+	int mode;
+
+	cJSON_InitHooks(&hooks);
+	len = make_doc(doc, DOC_SIZE);
+	printf("document: %zu bytes\n", len);
+
+	if (check(doc, len) < 0) {
+		return 1;
+	}
+
+	for (mode = 0; mode < MODE_MAX; mode++) {
+		bench(mode, doc, len);
+	}
+	printf("peak counts %d bytes of heap overhead per allocation, the SAX peak is its state and token buffer\n", HEAP_OVERHEAD);
+
+	free(doc);
+	return 0;
+}
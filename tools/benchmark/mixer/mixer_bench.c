@@ -0,0 +1,288 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * tools/benchmark/mixer/mixer_bench.c
+ *
+ * Host benchmark of the software mixer of the audio manager.  The mixer runs
+ * in 44.1KHz stereo with 1024 frame periods like the media stream of a card.
+ * For 1 to 8 streams, the time to queue and mix a period is measured:
+ *   - "mix": the streams are in the mixer format, gain and saturation only,
+ *   - "convert+mix": the extra streams are 16KHz mono and 48KHz stereo, and
+ *     are resampled when written.
+ * The saturation, the gains, the padding and the idle streams are checked first.
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "audio_mixer.h"
+
+#define MIX_RATE       (44100)
+#define MIX_CHANNELS   (2)
+#define PERIOD_FRAMES  (1024)
+#define MAX_STREAMS    CONFIG_AUDIO_MIXER_MAX_STREAMS
+#define BENCH_SECONDS  (0.3)
+
+struct producer_s {
+	unsigned int rate;
+	unsigned int channels;
+	int16_t *data;
+	unsigned int frames;    // frames of a mixer period in this format
+};
+
+static int16_t g_output[PERIOD_FRAMES * MIX_CHANNELS];
+
+/****************************************************************************
+ * Stubs of the media remix utility: mono and stereo only
+ ****************************************************************************/
+
+uint32_t ch2layout(uint32_t nb_chs)
+{
+	return nb_chs;
+}
+
+uint32_t layout2ch(uint32_t layout)
+{
+	return layout;
+}
+
+int32_t rechannel(uint32_t in_layout, uint32_t out_layout, const int16_t *input, uint32_t in_frames, int16_t *output, uint32_t max_frames)
+{
+	uint32_t i;
+
+	if (in_frames > max_frames) {
+		return -1;
+	}
+
+	if (in_layout == out_layout) {
+		memmove(output, input, in_frames * in_layout * sizeof(int16_t));
+	} else if (in_layout == 1 && out_layout == 2) {
+		for (i = in_frames; i-- > 0;) {
+			output[2 * i] = output[2 * i + 1] = input[i];
+		}
+	} else if (in_layout == 2 && out_layout == 1) {
+		for (i = 0; i < in_frames; i++) {
+			output[i] = (input[2 * i] + input[2 * i + 1]) / 2;
+		}
+	} else {
+		return -1;
+	}
+
+	return in_frames;
+}
+
+/****************************************************************************
+ * Tests
+ ****************************************************************************/
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int check(const char *name, bool ok)
+{
+	printf("  %-32s %s\n", name, ok ? "ok" : "FAILED");
+	return ok ? 0 : 1;
+}
+
+static int test_mix(void)
+{
+	audio_mixer_t mixer;
+	int16_t a[PERIOD_FRAMES * MIX_CHANNELS];
+	int16_t b[PERIOD_FRAMES * MIX_CHANNELS];
+	int16_t c[PERIOD_FRAMES * MIX_CHANNELS];
+	unsigned int min_frames;
+	unsigned int max_frames;
+	int ids[4];
+	int failed = 0;
+	int ida;
+	int idb;
+	int i;
+
+	for (i = 0; i < PERIOD_FRAMES * MIX_CHANNELS; i++) {
+		a[i] = (i & 1) ? -20000 : 20000;
+		b[i] = (int16_t)(i * 7);
+		c[i] = (i & 1) ? INT16_MIN : INT16_MAX;
+	}
+
+	audio_mixer_init(&mixer, MIX_CHANNELS, MIX_RATE, PERIOD_FRAMES);
+	ida = audio_mixer_open_stream(&mixer, MIX_CHANNELS, MIX_RATE, 2);
+
+	// One stream in unity gain is passed through
+	audio_mixer_write(&mixer, ida, a, PERIOD_FRAMES);
+	failed += check("single stream pass-through",
+					audio_mixer_mix(&mixer, g_output, PERIOD_FRAMES) == PERIOD_FRAMES &&
+					!memcmp(g_output, a, sizeof(a)));
+
+	// Two loud streams saturate
+	idb = audio_mixer_open_stream(&mixer, MIX_CHANNELS, MIX_RATE, 2);
+	audio_mixer_write(&mixer, ida, a, PERIOD_FRAMES);
+	audio_mixer_write(&mixer, idb, a, PERIOD_FRAMES);
+	audio_mixer_mix(&mixer, g_output, PERIOD_FRAMES);
+	failed += check("saturation", g_output[0] == INT16_MAX && g_output[1] == INT16_MIN);
+
+	// Half gains sum back to the original
+	audio_mixer_set_gain(&mixer, ida, AUDIO_MIXER_UNITY_GAIN / 2);
+	audio_mixer_set_gain(&mixer, idb, AUDIO_MIXER_UNITY_GAIN / 2);
+	audio_mixer_write(&mixer, ida, a, PERIOD_FRAMES);
+	audio_mixer_write(&mixer, idb, a, PERIOD_FRAMES);
+	audio_mixer_mix(&mixer, g_output, PERIOD_FRAMES);
+	failed += check("gain", !memcmp(g_output, a, sizeof(a)));
+
+	// Loud streams in high gains saturate instead of overflowing the accumulators
+	for (i = 0; i < 4; i++) {
+		ids[i] = (i < 2) ? ((i == 0) ? ida : idb) : audio_mixer_open_stream(&mixer, MIX_CHANNELS, MIX_RATE, 2);
+		audio_mixer_set_gain(&mixer, ids[i], UINT16_MAX);
+		audio_mixer_write(&mixer, ids[i], c, PERIOD_FRAMES);
+	}
+	failed += check("gain clamp", mixer.streams[ida].gain == AUDIO_MIXER_MAX_GAIN);
+	audio_mixer_mix(&mixer, g_output, PERIOD_FRAMES);
+	failed += check("saturation in high gains", g_output[0] == INT16_MAX && g_output[1] == INT16_MIN);
+	audio_mixer_close_stream(&mixer, ids[2]);
+	audio_mixer_close_stream(&mixer, ids[3]);
+
+	// A shorter stream is padded with silence
+	audio_mixer_set_gain(&mixer, ida, AUDIO_MIXER_UNITY_GAIN);
+	audio_mixer_set_gain(&mixer, idb, AUDIO_MIXER_UNITY_GAIN);
+	audio_mixer_write(&mixer, ida, b, PERIOD_FRAMES);
+	audio_mixer_write(&mixer, idb, b, PERIOD_FRAMES / 2);
+	audio_mixer_mix(&mixer, g_output, PERIOD_FRAMES);
+	failed += check("padding of a late stream",
+					g_output[2] == 2 * b[2] && g_output[PERIOD_FRAMES + 2] == b[PERIOD_FRAMES + 2]);
+
+	// The queue takes no more than its depth
+	failed += check("queue depth", audio_mixer_write(&mixer, ida, a, PERIOD_FRAMES) == PERIOD_FRAMES &&
+					audio_mixer_write(&mixer, ida, a, PERIOD_FRAMES) == PERIOD_FRAMES &&
+					audio_mixer_write(&mixer, ida, a, PERIOD_FRAMES) == 0);
+
+	// A stream which ran dry is not waited for until it is written again
+	audio_mixer_mix(&mixer, g_output, PERIOD_FRAMES);
+	failed += check("idle stream not waited for",
+					audio_mixer_get_queued_range(&mixer, &min_frames, &max_frames) == 1 && min_frames == PERIOD_FRAMES);
+	audio_mixer_write(&mixer, idb, a, PERIOD_FRAMES / 2);
+	failed += check("written stream waited for",
+					audio_mixer_get_queued_range(&mixer, &min_frames, &max_frames) == 2 && min_frames == PERIOD_FRAMES / 2);
+
+	audio_mixer_deinit(&mixer);
+	return failed;
+}
+
+static void make_producer(struct producer_s *p, unsigned int rate, unsigned int channels, double freq)
+{
+	unsigned int i;
+	unsigned int j;
+
+	p->rate = rate;
+	p->channels = channels;
+	p->frames = (unsigned int)((double)PERIOD_FRAMES * rate / MIX_RATE);
+	p->data = malloc(p->frames * channels * sizeof(int16_t));
+	for (i = 0; i < p->frames; i++) {
+		for (j = 0; j < channels; j++) {
+			p->data[i * channels + j] = (int16_t)(8000.0 * sin(2.0 * M_PI * freq * i / rate));
+		}
+	}
+}
+
+/* Microseconds to queue and mix a period of the given producers */
+static double bench(struct producer_s *producers, int num)
+{
+	audio_mixer_t mixer;
+	int ids[MAX_STREAMS];
+	unsigned long periods = 0;
+	double start;
+	double elapsed;
+	int i;
+
+	audio_mixer_init(&mixer, MIX_CHANNELS, MIX_RATE, PERIOD_FRAMES);
+	for (i = 0; i < num; i++) {
+		ids[i] = audio_mixer_open_stream(&mixer, producers[i].channels, producers[i].rate, 4);
+		audio_mixer_set_gain(&mixer, ids[i], AUDIO_MIXER_UNITY_GAIN * 3 / 4);
+	}
+
+	start = now();
+	do {
+		for (i = 0; i < num; i++) {
+			audio_mixer_write(&mixer, ids[i], producers[i].data, producers[i].frames);
+		}
+		audio_mixer_mix(&mixer, g_output, PERIOD_FRAMES);
+		periods++;
+		elapsed = now() - start;
+	} while (elapsed < BENCH_SECONDS);
+
+	audio_mixer_deinit(&mixer);
+	return elapsed * 1e6 / periods;
+}
+
+int main(void)
+{
+	struct producer_s same[MAX_STREAMS];
+	struct producer_s mixed[MAX_STREAMS];
+	double period_us = 1e6 * PERIOD_FRAMES / MIX_RATE;
+	double mix_us;
+	double convert_us;
+	double base_mix = 0;
+	double base_convert = 0;
+	int failed;
+	int i;
+
+	printf("mixer checks\n");
+	failed = test_mix();
+
+	for (i = 0; i < MAX_STREAMS; i++) {
+		make_producer(&same[i], MIX_RATE, MIX_CHANNELS, 440.0 * (i + 1));
+		if (i == 0) {
+			make_producer(&mixed[i], MIX_RATE, MIX_CHANNELS, 440.0);
+		} else if (i & 1) {
+			make_producer(&mixed[i], 16000, 1, 440.0 * (i + 1));
+		} else {
+			make_producer(&mixed[i], 48000, 2, 440.0 * (i + 1));
+		}
+	}
+
+	printf("mixer %dHz %dch, %d frame periods (%.0fus)\n", MIX_RATE, MIX_CHANNELS, PERIOD_FRAMES, period_us);
+	printf("  %-8s %12s %12s %16s %16s\n", "streams", "mix", "+stream", "convert+mix", "+stream");
+	for (i = 1; i <= MAX_STREAMS; i++) {
+		mix_us = bench(same, i);
+		convert_us = bench(mixed, i);
+		if (i == 1) {
+			printf("  %-8d %9.1fus %12s %13.1fus %16s\n", i, mix_us, "-", convert_us, "-");
+		} else {
+			printf("  %-8d %9.1fus %9.1fus %13.1fus %13.1fus\n", i, mix_us, (mix_us - base_mix) / (i - 1),
+				   convert_us, (convert_us - base_convert) / (i - 1));
+		}
+		if (i == 1) {
+			base_mix = mix_us;
+			base_convert = convert_us;
+		}
+	}
+
+	for (i = 0; i < MAX_STREAMS; i++) {
+		free(same[i].data);
+		free(mixed[i].data);
+	}
+
+	return failed;
+}
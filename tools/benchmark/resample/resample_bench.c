@@ -0,0 +1,306 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * tools/benchmark/resample/resample_bench.c
+ *
+ * Host benchmark and quality test of the media resampler.  Sine waves are
+ * converted through src_simple() in periods of PERIOD_FRAMES frames, like the
+ * audio manager does, for the common rate pairs.  The reports are:
+ *   - SNR of a 1KHz tone and of a high tone at 40% of the lower sample rate,
+ *     measured against the least squares fit of the tone to the output,
+ *   - alias level of a tone above the output Nyquist frequency on down
+ *     resampling, relative to the input level,
+ *   - speed of stereo conversion in times of real time.
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "samplerate.h"
+#include "../../utils/remix.h"
+
+#define PERIOD_FRAMES  (256)
+#define BUFFER_SIZE    (4096)
+#define TONE_SECONDS   (1)
+#define SKIP_FRAMES    (512)
+#define BENCH_SECONDS  (0.3)
+#define AMPLITUDE      (16384.0)
+
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+#define RESAMPLER_NAME "polyphase"
+#else
+#define RESAMPLER_NAME "linear"
+#endif
+
+struct rate_pair_s {
+	int in_rate;
+	int out_rate;
+};
+
+static const struct rate_pair_s g_pairs[] = {
+	{ 44100, 16000 },
+	{ 48000, 16000 },
+	{ 48000, 44100 },
+	{ 44100, 48000 },
+	{ 16000, 44100 },
+	{ 16000, 48000 },
+	{ 16000, 8000 },
+	{ 8000, 16000 },
+};
+
+/****************************************************************************
+ * Stubs of the media remix utility: mono and stereo only
+ ****************************************************************************/
+
+uint32_t ch2layout(uint32_t nb_chs)
+{
+	return nb_chs;
+}
+
+uint32_t layout2ch(uint32_t layout)
+{
+	return layout;
+}
+
+int32_t rechannel(uint32_t in_layout, uint32_t out_layout, const int16_t *input, uint32_t in_frames, int16_t *output, uint32_t max_frames)
+{
+	if (in_layout != out_layout || in_frames > max_frames) {
+		return -1;
+	}
+
+	memmove(output, input, in_frames * in_layout * sizeof(int16_t));
+	return in_frames;
+}
+
+/****************************************************************************
+ * Tests
+ ****************************************************************************/
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void make_tone(int16_t *buf, int frames, int channels, double freq, int rate)
+{
+	int i;
+	int j;
+
+	for (i = 0; i < frames; i++) {
+		for (j = 0; j < channels; j++) {
+			buf[i * channels + j] = (int16_t)lrint(AMPLITUDE * sin(2.0 * M_PI * freq * i / rate + j));
+		}
+	}
+}
+
+/* Convert the whole input, period by period, returns the output frames */
+static int convert(src_handle_t handle, const struct rate_pair_s *pair, int channels,
+				   const int16_t *in, int in_frames, int16_t *out, int out_frames)
+{
+	src_data_t data;
+	int used = 0;
+	int gen = 0;
+	int ret;
+
+	memset(&data, 0, sizeof(data));
+	data.origin_sample_rate = pair->in_rate;
+	data.origin_sample_width = SAMPLE_WIDTH_16BITS;
+	data.origin_channel_num = channels;
+	data.desired_sample_rate = pair->out_rate;
+	data.desired_sample_width = SAMPLE_WIDTH_16BITS;
+	data.desired_channel_num = channels;
+
+	while (used < in_frames) {
+		int period = in_frames - used < PERIOD_FRAMES ? in_frames - used : PERIOD_FRAMES;
+		int done = 0;
+
+		// Feed a period until it is taken, the internal buffer may be full
+		while (done < period) {
+			data.data_in = in + (used + done) * channels;
+			data.input_frames = period - done;
+			data.data_out = out + gen * channels;
+			data.out_buf_length = (out_frames - gen) * channels * sizeof(int16_t);
+
+			ret = src_simple(handle, &data);
+			if (ret != SRC_ERR_NO_ERROR) {
+				printf("src_simple failed: %d\n", ret);
+				exit(1);
+			}
+
+			if (!data.input_frames_used && !data.output_frames_gen) {
+				printf("src_simple stalled at %d/%d\n", used + done, in_frames);
+				exit(1);
+			}
+
+			done += data.input_frames_used;
+			gen += data.output_frames_gen;
+		}
+		used += done;
+	}
+
+	return gen;
+}
+
+/* SNR of the tone in the first channel, against the least squares fit of the tone */
+static double tone_snr(const int16_t *buf, int frames, int channels, double freq, int rate)
+{
+	double ss = 0, cc = 0, sc = 0, ys = 0, yc = 0;
+	double a, b, det, fit, err, signal = 0, noise = 0;
+	double s, c;
+	int i;
+
+	for (i = SKIP_FRAMES; i < frames - SKIP_FRAMES; i++) {
+		s = sin(2.0 * M_PI * freq * i / rate);
+		c = cos(2.0 * M_PI * freq * i / rate);
+		ss += s * s;
+		cc += c * c;
+		sc += s * c;
+		ys += buf[i * channels] * s;
+		yc += buf[i * channels] * c;
+	}
+
+	det = ss * cc - sc * sc;
+	a = (ys * cc - yc * sc) / det;
+	b = (yc * ss - ys * sc) / det;
+
+	for (i = SKIP_FRAMES; i < frames - SKIP_FRAMES; i++) {
+		fit = a * sin(2.0 * M_PI * freq * i / rate) + b * cos(2.0 * M_PI * freq * i / rate);
+		err = buf[i * channels] - fit;
+		signal += fit * fit;
+		noise += err * err;
+	}
+
+	return 10.0 * log10(signal / (noise + 1e-9));
+}
+
+static double rms(const int16_t *buf, int frames, int channels)
+{
+	double sum = 0;
+	int i;
+
+	for (i = SKIP_FRAMES; i < frames - SKIP_FRAMES; i++) {
+		sum += (double)buf[i * channels] * buf[i * channels];
+	}
+
+	return sqrt(sum / (frames - 2 * SKIP_FRAMES));
+}
+
+static double measure_snr(const struct rate_pair_s *pair, double freq, int16_t *in, int16_t *out, int out_max)
+{
+	src_handle_t handle;
+	int in_frames = pair->in_rate * TONE_SECONDS;
+	int frames;
+
+	make_tone(in, in_frames, 2, freq, pair->in_rate);
+	handle = src_init(BUFFER_SIZE);
+	frames = convert(handle, pair, 2, in, in_frames, out, out_max);
+	src_destroy(handle);
+
+	return tone_snr(out, frames, 2, freq, pair->out_rate);
+}
+
+static double measure_alias(const struct rate_pair_s *pair, int16_t *in, int16_t *out, int out_max)
+{
+	src_handle_t handle;
+	int in_frames = pair->in_rate * TONE_SECONDS;
+	double freq;
+	int frames;
+
+	// Between the output and the input Nyquist frequencies
+	freq = pair->out_rate * 0.5 + (pair->in_rate - pair->out_rate) * 0.15;
+	make_tone(in, in_frames, 2, freq, pair->in_rate);
+	handle = src_init(BUFFER_SIZE);
+	frames = convert(handle, pair, 2, in, in_frames, out, out_max);
+	src_destroy(handle);
+
+	// Floor at -120dB, an exact silence has no level
+	return fmax(-120.0, 20.0 * log10((rms(out, frames, 2) + 1e-9) / rms(in, in_frames, 2)));
+}
+
+static double measure_speed(const struct rate_pair_s *pair, int channels, int16_t *in, int16_t *out, int out_max)
+{
+	src_handle_t handle;
+	int in_frames = pair->in_rate * TONE_SECONDS;
+	double start;
+	double elapsed;
+	int rounds = 0;
+
+	make_tone(in, in_frames, channels, 1000.0, pair->in_rate);
+	handle = src_init(BUFFER_SIZE);
+	// The first call builds the tables
+	convert(handle, pair, channels, in, PERIOD_FRAMES, out, out_max);
+
+	start = now();
+	do {
+		convert(handle, pair, channels, in, in_frames, out, out_max);
+		rounds++;
+		elapsed = now() - start;
+	} while (elapsed < BENCH_SECONDS);
+	src_destroy(handle);
+
+	return rounds * TONE_SECONDS / elapsed;
+}
+
+int main(void)
+{
+	int max_rate = 48000;
+	int out_max = 3 * max_rate * TONE_SECONDS + PERIOD_FRAMES;
+	int16_t *in = malloc(max_rate * TONE_SECONDS * 2 * sizeof(int16_t));
+	int16_t *out = malloc(out_max * 2 * sizeof(int16_t));
+	const struct rate_pair_s *pair;
+	double high;
+	unsigned i;
+	char alias[16];
+
+	if (!in || !out) {
+		printf("out of memory\n");
+		return 1;
+	}
+
+	printf("resampler: %s\n", RESAMPLER_NAME);
+	printf("  %-13s %9s %9s %9s %12s %12s\n", "rates", "SNR 1K", "SNR high", "alias", "stereo", "mono");
+
+	for (i = 0; i < sizeof(g_pairs) / sizeof(g_pairs[0]); i++) {
+		pair = &g_pairs[i];
+		high = 0.4 * (pair->in_rate < pair->out_rate ? pair->in_rate : pair->out_rate);
+
+		if (pair->in_rate > pair->out_rate) {
+			snprintf(alias, sizeof(alias), "%6.1fdB", measure_alias(pair, in, out, out_max));
+		} else {
+			snprintf(alias, sizeof(alias), "%8s", "-");
+		}
+
+		printf("  %5d->%-6d %7.1fdB %7.1fdB %9s %9.0fx rt %9.0fx rt\n", pair->in_rate, pair->out_rate,
+			   measure_snr(pair, 1000.0, in, out, out_max),
+			   measure_snr(pair, high, in, out, out_max),
+			   alias,
+			   measure_speed(pair, 2, in, out, out_max),
+			   measure_speed(pair, 1, in, out, out_max));
+	}
+
+	free(in);
+	free(out);
+	return 0;
+}
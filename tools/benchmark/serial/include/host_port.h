@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/* TizenRT definitions the serial driver sources use, mapped to Linux.
+ * This header is included ahead of every source of the host build.
+ */
+
+#ifndef __TOOLS_BENCHMARK_SERIAL_HOST_PORT_H
+#define __TOOLS_BENCHMARK_SERIAL_HOST_PORT_H
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#define FAR
+#define CODE
+
+#ifndef OK
+#define OK    0
+#endif
+#ifndef ERROR
+#define ERROR -1
+#endif
+
+#define DEBUGASSERT(f) do { } while (0)
+#define ASSERT(f)      do { } while (0)
+#define get_errno()    errno
+
+/* TizenRT open flags: O_RDONLY is a bit of its own */
+
+#undef O_RDONLY
+#undef O_WRONLY
+#undef O_RDWR
+#define O_RDONLY       (1 << 0)
+#define O_WRONLY       (1 << 1)
+#define O_RDWR         (O_RDONLY | O_WRONLY)
+
+/* Interrupts: one recursive lock, dropped while a thread sleeps */
+
+typedef int irqstate_t;
+
+irqstate_t irqsave(void);
+void irqrestore(irqstate_t flags);
+
+/* TizenRT semaphores */
+
+typedef struct host_sem_s {
+	int count;					/* Below zero: number of waiters */
+	int wakeups;				/* Posts not yet taken by a waiter */
+	pthread_cond_t cond;
+} host_sem_t;
+
+#define sem_t          host_sem_t
+#define sem_init       host_sem_init
+#define sem_destroy    host_sem_destroy
+#define sem_wait       host_sem_wait
+#define sem_post       host_sem_post
+#define sem_getvalue   host_sem_getvalue
+#define sem_reset      host_sem_reset
+
+int host_sem_init(host_sem_t *sem, int pshared, unsigned int value);
+int host_sem_destroy(host_sem_t *sem);
+int host_sem_wait(host_sem_t *sem);
+int host_sem_post(host_sem_t *sem);
+int host_sem_getvalue(host_sem_t *sem, int *sval);
+int host_sem_reset(host_sem_t *sem, int16_t count);
+
+#include <debug.h>
+
+#endif
@@ -0,0 +1,28 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_SERIAL_ARCH_H
+#define __TOOLS_BENCHMARK_SERIAL_ARCH_H
+
+/* The benchmark never writes from an interrupt handler */
+
+#define up_interrupt_context() false
+#define up_mdelay(ms)          usleep((ms) * 1000)
+
+int up_putc(int ch);
+
+#endif
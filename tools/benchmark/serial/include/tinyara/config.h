@@ -0,0 +1,34 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_SERIAL_CONFIG_H
+#define __TOOLS_BENCHMARK_SERIAL_CONFIG_H
+
+/* Host build of the serial upper half and the loopback lower half.
+ * CONFIG_SERIAL_TXDMA and CONFIG_SERIAL_RXDMA are given by the Makefile.
+ */
+
+#define CONFIG_ARCH_LOWPUTC 1
+#define CONFIG_DISABLE_POLL 1
+#define CONFIG_FS_PROCFS 1
+#define CONFIG_SCHED_WORKQUEUE 1
+#define CONFIG_SERIAL_STATS 1
+#define CONFIG_SERIAL_LOOPBACK 1
+#define CONFIG_SERIAL_LOOPBACK_RXBUFSIZE 1024
+#define CONFIG_SERIAL_LOOPBACK_TXBUFSIZE 1024
+
+#endif
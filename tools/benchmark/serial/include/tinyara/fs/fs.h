@@ -0,0 +1,45 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_SERIAL_FS_H
+#define __TOOLS_BENCHMARK_SERIAL_FS_H
+
+#include <sys/stat.h>
+
+struct inode {
+	FAR void *i_private;
+};
+
+struct file {
+	int f_oflags;
+	off_t f_pos;
+	FAR struct inode *f_inode;
+	FAR void *f_priv;
+};
+
+struct file_operations {
+	int (*open)(FAR struct file *filep);
+	int (*close)(FAR struct file *filep);
+	ssize_t (*read)(FAR struct file *filep, FAR char *buffer, size_t buflen);
+	ssize_t (*write)(FAR struct file *filep, FAR const char *buffer, size_t buflen);
+	off_t (*seek)(FAR struct file *filep, off_t offset, int whence);
+	int (*ioctl)(FAR struct file *filep, int cmd, unsigned long arg);
+};
+
+int register_driver(FAR const char *path, FAR const struct file_operations *fops, mode_t mode, FAR void *priv);
+
+#endif
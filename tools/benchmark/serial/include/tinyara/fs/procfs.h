@@ -0,0 +1,43 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_SERIAL_PROCFS_H
+#define __TOOLS_BENCHMARK_SERIAL_PROCFS_H
+
+struct fs_dirent_s;
+struct procfs_entry_s;
+
+struct procfs_operations {
+	int (*open)(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+	int (*close)(FAR struct file *filep);
+	ssize_t (*read)(FAR struct file *filep, FAR char *buffer, size_t buflen);
+	ssize_t (*write)(FAR struct file *filep, FAR const char *buffer, size_t buflen);
+	int (*dup)(FAR const struct file *oldp, FAR struct file *newp);
+	int (*opendir)(FAR const char *relpath, FAR struct fs_dirent_s *dir);
+	int (*closedir)(FAR struct fs_dirent_s *dir);
+	int (*readdir)(FAR struct fs_dirent_s *dir);
+	int (*rewinddir)(FAR struct fs_dirent_s *dir);
+	int (*stat)(FAR const char *relpath, FAR struct stat *buf);
+};
+
+struct procfs_file_s {
+	FAR const struct procfs_entry_s *procfsentry;
+};
+
+size_t procfs_memcpy(FAR const char *src, size_t srclen, FAR char *dest, size_t destlen, off_t *offset);
+
+#endif
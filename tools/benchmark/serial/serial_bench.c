@@ -0,0 +1,405 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/*
+ * Host benchmark of the serial upper half of os/drivers/serial.
+ *
+ * The upper half, the DMA helpers and /proc/serial are built unchanged on
+ * top of the small TizenRT shims of include/, with the loopback lower half
+ * of uart_loopback.c as the device.  Its 16 byte FIFO stands for the FIFO
+ * of a 16550 and its emulated interrupt runs on a work queue thread, so the
+ * numbers show the cost of the upper half per byte and per interrupt.
+ *
+ * A writer thread sends a pattern through /dev/ttyLB0 in chunks of a few
+ * sizes while a reader thread receives and checks it.  The irq build moves
+ * the data one byte at a time through uart_xmitchars()/uart_recvchars(),
+ * the dma build moves it in blocks through the uart_dmaxfer_s helpers.
+ */
+
+#include <tinyara/config.h>
+
+#include <stdlib.h>
+#include <time.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+#include <tinyara/wqueue.h>
+#include <tinyara/serial/serial.h>
+
+#define XFER_BYTES    (8 * 1024 * 1024)
+#define RECV_SIZE     4096
+
+#ifdef CONFIG_SERIAL_DMA
+#define BUILD_NAME    "dma"
+#else
+#define BUILD_NAME    "irq"
+#endif
+
+static const size_t g_write_sizes[] = { 1, 64, 4096 };
+
+extern const struct procfs_operations serial_operations;
+
+/*
+ * One mutex serializes the semaphores, the interrupt lock and the work
+ * queue, so that a thread waiting on a semaphore drops the interrupt lock
+ * and starts waiting atomically, the way TizenRT re-enables the interrupts
+ * when a thread sleeps.
+ */
+
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_lockcond = PTHREAD_COND_INITIALIZER;
+static pthread_t g_holder;
+static bool g_held;
+static int g_depth;
+
+static pthread_cond_t g_workcond = PTHREAD_COND_INITIALIZER;
+static struct work_s *g_workhead;
+static struct work_s *g_worktail;
+static unsigned long g_workruns;
+
+static FAR const struct file_operations *g_fops;
+static FAR uart_dev_t *g_dev;
+
+/* Interrupt lock */
+
+static void irq_lock_locked(int depth)
+{
+	pthread_t self = pthread_self();
+
+	while (g_held && !pthread_equal(g_holder, self)) {
+		pthread_cond_wait(&g_lockcond, &g_mutex);
+	}
+	g_held = true;
+	g_holder = self;
+	g_depth += depth;
+}
+
+static int irq_unlock_locked(void)
+{
+	int depth = 0;
+
+	if (g_held && pthread_equal(g_holder, pthread_self())) {
+		depth = g_depth;
+		g_depth = 0;
+		g_held = false;
+		pthread_cond_broadcast(&g_lockcond);
+	}
+
+	return depth;
+}
+
+irqstate_t irqsave(void)
+{
+	pthread_mutex_lock(&g_mutex);
+	irq_lock_locked(1);
+	pthread_mutex_unlock(&g_mutex);
+	return 0;
+}
+
+void irqrestore(irqstate_t flags)
+{
+	pthread_mutex_lock(&g_mutex);
+	if (--g_depth == 0) {
+		g_held = false;
+		pthread_cond_broadcast(&g_lockcond);
+	}
+	pthread_mutex_unlock(&g_mutex);
+}
+
+/* Semaphores */
+
+int host_sem_init(host_sem_t *sem, int pshared, unsigned int value)
+{
+	sem->count = value;
+	sem->wakeups = 0;
+	pthread_cond_init(&sem->cond, NULL);
+	return OK;
+}
+
+int host_sem_destroy(host_sem_t *sem)
+{
+	pthread_cond_destroy(&sem->cond);
+	return OK;
+}
+
+int host_sem_wait(host_sem_t *sem)
+{
+	int depth;
+
+	pthread_mutex_lock(&g_mutex);
+	depth = irq_unlock_locked();
+	if (--sem->count < 0) {
+		while (sem->wakeups == 0) {
+			pthread_cond_wait(&sem->cond, &g_mutex);
+		}
+		sem->wakeups--;
+	}
+	if (depth > 0) {
+		irq_lock_locked(depth);
+	}
+	pthread_mutex_unlock(&g_mutex);
+	return OK;
+}
+
+static void sem_post_locked(host_sem_t *sem)
+{
+	if (++sem->count <= 0) {
+		sem->wakeups++;
+		pthread_cond_signal(&sem->cond);
+	}
+}
+
+int host_sem_post(host_sem_t *sem)
+{
+	pthread_mutex_lock(&g_mutex);
+	sem_post_locked(sem);
+	pthread_mutex_unlock(&g_mutex);
+	return OK;
+}
+
+int host_sem_getvalue(host_sem_t *sem, int *sval)
+{
+	pthread_mutex_lock(&g_mutex);
+	*sval = sem->count;
+	pthread_mutex_unlock(&g_mutex);
+	return OK;
+}
+
+int host_sem_reset(host_sem_t *sem, int16_t count)
+{
+	pthread_mutex_lock(&g_mutex);
+	while (sem->count < 0 && count > 0) {
+		sem_post_locked(sem);
+		count--;
+	}
+	if (sem->count >= 0) {
+		sem->count = count;
+	}
+	pthread_mutex_unlock(&g_mutex);
+	return OK;
+}
+
+/* High priority work queue */
+
+int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay)
+{
+	pthread_mutex_lock(&g_mutex);
+	if (work->worker == NULL) {
+		work->next = NULL;
+		if (g_worktail != NULL) {
+			g_worktail->next = work;
+		} else {
+			g_workhead = work;
+		}
+		g_worktail = work;
+		pthread_cond_signal(&g_workcond);
+	}
+	work->worker = worker;
+	work->arg = arg;
+	pthread_mutex_unlock(&g_mutex);
+	return OK;
+}
+
+static void *work_thread(void *arg)
+{
+	struct work_s *work;
+	worker_t worker;
+
+	pthread_mutex_lock(&g_mutex);
+	for (;;) {
+		while (g_workhead == NULL) {
+			pthread_cond_wait(&g_workcond, &g_mutex);
+		}
+
+		work = g_workhead;
+		g_workhead = work->next;
+		if (g_workhead == NULL) {
+			g_worktail = NULL;
+		}
+
+		worker = work->worker;
+		arg = work->arg;
+		work->worker = NULL;
+		g_workruns++;
+
+		pthread_mutex_unlock(&g_mutex);
+		worker(arg);
+		pthread_mutex_lock(&g_mutex);
+	}
+
+	return NULL;
+}
+
+/* Drivers */
+
+int register_driver(FAR const char *path, FAR const struct file_operations *fops, mode_t mode, FAR void *priv)
+{
+	g_fops = fops;
+	g_dev = priv;
+	return OK;
+}
+
+int up_putc(int ch)
+{
+	return putchar(ch);
+}
+
+size_t procfs_memcpy(FAR const char *src, size_t srclen, FAR char *dest, size_t destlen, off_t *offset)
+{
+	size_t copysize;
+
+	if (*offset >= (off_t)srclen) {
+		*offset -= srclen;
+		return 0;
+	}
+
+	copysize = srclen - *offset;
+	if (copysize > destlen) {
+		copysize = destlen;
+	}
+	memcpy(dest, src + *offset, copysize);
+	*offset = 0;
+	return copysize;
+}
+
+/* Benchmark */
+
+static double now_sec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void fail(const char *what, int ret)
+{
+	fprintf(stderr, "%s: %s failed: %d\n", BUILD_NAME, what, ret);
+	exit(1);
+}
+
+static void *reader_thread(void *arg)
+{
+	struct file *filep = arg;
+	static char buf[RECV_SIZE];
+	size_t total = 0;
+	ssize_t ret;
+	ssize_t i;
+
+	while (total < XFER_BYTES) {
+		ret = g_fops->read(filep, buf, sizeof(buf));
+		if (ret <= 0) {
+			fail("read", ret);
+		}
+		for (i = 0; i < ret; i++) {
+			if (buf[i] != (char)((total + i) % 251)) {
+				fail("content check", (int)(total + i));
+			}
+		}
+		total += ret;
+	}
+
+	return NULL;
+}
+
+static void bench_stream(struct file *filep, size_t chunk)
+{
+	struct uart_stats_s before = g_dev->stats;
+	unsigned long runs = g_workruns;
+	pthread_t thread;
+	char *buf;
+	size_t sent;
+	size_t len;
+	ssize_t ret;
+	size_t i;
+	double start;
+	double elapsed;
+	double kbytes = XFER_BYTES / 1024.0;
+
+	buf = malloc(chunk + 251);
+	for (i = 0; i < chunk + 251; i++) {
+		buf[i] = (char)(i % 251);
+	}
+
+	pthread_create(&thread, NULL, reader_thread, filep);
+
+	start = now_sec();
+	for (sent = 0; sent < XFER_BYTES; sent += ret) {
+		len = XFER_BYTES - sent < chunk ? XFER_BYTES - sent : chunk;
+		ret = g_fops->write(filep, buf + sent % 251, len);
+		if (ret <= 0) {
+			fail("write", ret);
+		}
+	}
+	pthread_join(thread, NULL);
+	elapsed = now_sec() - start;
+	free(buf);
+
+	printf("%-4s write %4zu bytes %7.2f MB/s %8.1f interrupts/KB %8.1f lower half calls/KB\n",
+		   BUILD_NAME, chunk, XFER_BYTES / elapsed / (1024 * 1024),
+		   (g_workruns - runs) / kbytes,
+		   ((g_dev->stats.txcalls - before.txcalls) + (g_dev->stats.rxcalls - before.rxcalls)) / kbytes);
+}
+
+static void print_procfs(void)
+{
+	struct file file;
+	char buf[256];
+	ssize_t ret;
+
+	memset(&file, 0, sizeof(file));
+	if (serial_operations.open(&file, "serial", O_RDONLY, 0) < 0) {
+		fail("procfs open", -1);
+	}
+	while ((ret = serial_operations.read(&file, buf, sizeof(buf) - 1)) > 0) {
+		buf[ret] = '\0';
+		fputs(buf, stdout);
+	}
+	serial_operations.close(&file);
+}
+
+int main(int argc, char **argv)
+{
+	struct inode inode;
+	struct file file;
+	pthread_t worker;
+	size_t i;
+	int ret;
+
+	pthread_create(&worker, NULL, work_thread, NULL);
+
+	ret = uart_loopback_register();
+	if (ret < 0) {
+		fail("uart_loopback_register", ret);
+	}
+
+	inode.i_private = g_dev;
+	memset(&file, 0, sizeof(file));
+	file.f_inode = &inode;
+	file.f_oflags = O_RDWR;
+	ret = g_fops->open(&file);
+	if (ret < 0) {
+		fail("open", ret);
+	}
+
+	for (i = 0; i < sizeof(g_write_sizes) / sizeof(g_write_sizes[0]); i++) {
+		bench_stream(&file, g_write_sizes[i]);
+	}
+
+	g_fops->close(&file);
+	print_procfs();
+	return 0;
+}
@@ -0,0 +1 @@
+/* Host build of the libc string routines does not need any configuration. */
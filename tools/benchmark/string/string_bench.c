@@ -0,0 +1,477 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * tools/benchmark/string/string_bench.c
+ *
+ * Host equivalence test and benchmark of the libc string routines.  The
+ * *_OPTSPEED builds (opt_*) are checked against the byte-wise builds (ref_*)
+ * for every length, alignment and match position in a range which covers all
+ * head/word/tail combinations, then both are timed.
+ ****************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+void *ref_memcpy(void *dest, const void *src, size_t n);
+void *opt_memcpy(void *dest, const void *src, size_t n);
+void *ref_memset(void *s, int c, size_t n);
+void *opt_memset(void *s, int c, size_t n);
+int ref_memcmp(const void *s1, const void *s2, size_t n);
+int opt_memcmp(const void *s1, const void *s2, size_t n);
+void *ref_memchr(const void *s, int c, size_t n);
+void *opt_memchr(const void *s, int c, size_t n);
+size_t ref_strlen(const char *s);
+size_t opt_strlen(const char *s);
+int ref_strcmp(const char *cs, const char *ct);
+int opt_strcmp(const char *cs, const char *ct);
+char *ref_strchr(const char *s, int c);
+char *opt_strchr(const char *s, int c);
+
+#define MAXLEN    200
+#define MAXALIGN  8
+#define GUARD     16
+#define BUFSIZE   (GUARD + MAXALIGN + MAXLEN + GUARD)
+
+static int g_fail;
+
+#define CHECK(cond, ...) \
+	do { \
+		if (!(cond)) { \
+			if (g_fail++ < 10) { \
+				printf("FAIL %s:%d : ", __func__, __LINE__); \
+				printf(__VA_ARGS__); \
+				printf("\n"); \
+			} \
+		} \
+	} while (0)
+
+static int sign(int v)
+{
+	return (v > 0) - (v < 0);
+}
+
+/* The byte-wise strcmp() returns a signed char difference, so its sign is
+ * wrong for bytes above 0x7f.  Compare against the C standard definition.
+ */
+
+static int std_strcmp(const char *cs, const char *ct)
+{
+	const unsigned char *p1 = (const unsigned char *)cs;
+	const unsigned char *p2 = (const unsigned char *)ct;
+
+	while (*p1 == *p2 && *p1 != '\0') {
+		p1++;
+		p2++;
+	}
+	return *p1 - *p2;
+}
+
+static void fill(unsigned char *buf, size_t len, int nonzero)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		buf[i] = rand();
+		if (nonzero && buf[i] == 0) {
+			buf[i] = 0x80;
+		}
+	}
+}
+
+static void test_memcpy(void)
+{
+	static unsigned char src[BUFSIZE];
+	static unsigned char dst[BUFSIZE];
+	static unsigned char exp[BUFSIZE];
+	size_t len;
+	size_t sa;
+	size_t da;
+	size_t i;
+	void *ret;
+
+	for (len = 0; len <= MAXLEN; len++) {
+		for (sa = 0; sa < MAXALIGN; sa++) {
+			for (da = 0; da < MAXALIGN; da++) {
+				fill(src, BUFSIZE, 0);
+				fill(dst, BUFSIZE, 0);
+				for (i = 0; i < BUFSIZE; i++) {
+					exp[i] = dst[i];
+				}
+				ref_memcpy(exp + GUARD + da, src + GUARD + sa, len);
+				ret = opt_memcpy(dst + GUARD + da, src + GUARD + sa, len);
+				CHECK(ret == dst + GUARD + da, "len %zu sa %zu da %zu : return value", len, sa, da);
+				for (i = 0; i < BUFSIZE; i++) {
+					CHECK(dst[i] == exp[i], "len %zu sa %zu da %zu : byte %zu", len, sa, da, i);
+				}
+			}
+		}
+	}
+}
+
+static void test_memset(void)
+{
+	static const int values[] = {0, 0x5a, 0xff, 0x1a5};
+	static unsigned char dst[BUFSIZE];
+	static unsigned char exp[BUFSIZE];
+	size_t len;
+	size_t da;
+	size_t v;
+	size_t i;
+
+	for (len = 0; len <= MAXLEN; len++) {
+		for (da = 0; da < MAXALIGN; da++) {
+			for (v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+				fill(dst, BUFSIZE, 0);
+				for (i = 0; i < BUFSIZE; i++) {
+					exp[i] = dst[i];
+				}
+				ref_memset(exp + GUARD + da, values[v], len);
+				CHECK(opt_memset(dst + GUARD + da, values[v], len) == dst + GUARD + da, "return value");
+				for (i = 0; i < BUFSIZE; i++) {
+					CHECK(dst[i] == exp[i], "len %zu da %zu c 0x%x : byte %zu", len, da, values[v], i);
+				}
+			}
+		}
+	}
+}
+
+static void test_memcmp(void)
+{
+	static unsigned char b1[BUFSIZE];
+	static unsigned char b2[BUFSIZE];
+	size_t len;
+	size_t a1;
+	size_t a2;
+	size_t pos;
+	unsigned char *p1;
+	unsigned char *p2;
+
+	for (len = 0; len <= 80; len++) {
+		for (a1 = 0; a1 < MAXALIGN; a1++) {
+			for (a2 = 0; a2 < MAXALIGN; a2++) {
+				/* pos == len means equal buffers */
+				for (pos = 0; pos <= len; pos++) {
+					p1 = b1 + GUARD + a1;
+					p2 = b2 + GUARD + a2;
+					fill(p1, len + GUARD, 0);
+					ref_memcpy(p2, p1, len + GUARD);
+					if (pos < len) {
+						p2[pos] = p1[pos] ^ ((rand() & 1) ? 0x80 : 0x01);
+					}
+					CHECK(sign(opt_memcmp(p1, p2, len)) == sign(ref_memcmp(p1, p2, len)), "len %zu a1 %zu a2 %zu pos %zu", len, a1, a2, pos);
+					CHECK(sign(opt_memcmp(p2, p1, len)) == sign(ref_memcmp(p2, p1, len)), "len %zu a1 %zu a2 %zu pos %zu (swapped)", len, a1, a2, pos);
+				}
+			}
+		}
+	}
+}
+
+static void test_memchr(void)
+{
+	static const int values[] = {0, 0x41, 0xc1, 0x141};
+	static unsigned char buf[BUFSIZE];
+	size_t len;
+	size_t a;
+	size_t pos;
+	size_t v;
+	unsigned char *p;
+	unsigned char target;
+	size_t i;
+
+	for (len = 0; len <= MAXLEN; len++) {
+		for (a = 0; a < MAXALIGN; a++) {
+			for (v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+				target = (unsigned char)values[v];
+				/* pos == len means 'c' is only found beyond the buffer */
+				for (pos = 0; pos <= len; pos++) {
+					p = buf + GUARD + a;
+					fill(buf, BUFSIZE, 0);
+					for (i = 0; i < len; i++) {
+						if (p[i] == target) {
+							p[i] = target ^ 0x10;
+						}
+					}
+					p[pos] = target;
+					CHECK(opt_memchr(p, values[v], len) == ref_memchr(p, values[v], len), "len %zu a %zu pos %zu c 0x%x", len, a, pos, values[v]);
+				}
+			}
+		}
+	}
+	CHECK(opt_memchr(NULL, 0, 10) == NULL, "NULL source");
+}
+
+static void test_strlen(void)
+{
+	static char buf[BUFSIZE];
+	size_t len;
+	size_t a;
+	char *p;
+
+	for (len = 0; len <= MAXLEN; len++) {
+		for (a = 0; a < MAXALIGN; a++) {
+			p = buf + GUARD + a;
+			fill((unsigned char *)buf, BUFSIZE, 1);
+			p[len] = '\0';
+			CHECK(opt_strlen(p) == len && ref_strlen(p) == len, "len %zu a %zu", len, a);
+		}
+	}
+}
+
+static void test_strcmp(void)
+{
+	static char b1[BUFSIZE];
+	static char b2[BUFSIZE];
+	size_t len;
+	size_t a1;
+	size_t a2;
+	size_t pos;
+	int mode;
+	char *p1;
+	char *p2;
+
+	for (len = 0; len <= 80; len++) {
+		for (a1 = 0; a1 < MAXALIGN; a1++) {
+			for (a2 = 0; a2 < MAXALIGN; a2++) {
+				for (pos = 0; pos <= len; pos++) {
+					/* mode 0 : different byte at pos, 1 : p2 ends at pos */
+					for (mode = 0; mode < 2; mode++) {
+						p1 = b1 + GUARD + a1;
+						p2 = b2 + GUARD + a2;
+						fill((unsigned char *)b1, BUFSIZE, 1);
+						fill((unsigned char *)b2, BUFSIZE, 1);
+						ref_memcpy(p2, p1, len);
+						p1[len] = '\0';
+						p2[len] = '\0';
+						if (pos < len) {
+							if (mode == 0) {
+								p2[pos] = p1[pos] ^ ((rand() & 1) ? 0x80 : 0x01);
+								if (p2[pos] == '\0') {
+									p2[pos] = 0x7f;
+								}
+							} else {
+								p2[pos] = '\0';
+							}
+						}
+						CHECK(sign(opt_strcmp(p1, p2)) == sign(std_strcmp(p1, p2)), "len %zu a1 %zu a2 %zu pos %zu", len, a1, a2, pos);
+						CHECK(sign(opt_strcmp(p2, p1)) == sign(std_strcmp(p2, p1)), "len %zu a1 %zu a2 %zu pos %zu (swapped)", len, a1, a2, pos);
+					}
+				}
+			}
+		}
+	}
+}
+
+static void test_strchr(void)
+{
+	static const int values[] = {0, 0x41, 0xc1};
+	static char buf[BUFSIZE];
+	size_t len;
+	size_t a;
+	size_t pos;
+	size_t v;
+	size_t i;
+	char *p;
+	char *exp;
+	char target;
+
+	for (len = 0; len <= MAXLEN; len++) {
+		for (a = 0; a < MAXALIGN; a++) {
+			for (v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+				target = (char)values[v];
+				/* pos == len means 'c' is not in the string */
+				for (pos = 0; pos <= len; pos++) {
+					p = buf + GUARD + a;
+					fill((unsigned char *)buf, BUFSIZE, 1);
+					for (i = 0; i < len; i++) {
+						if (p[i] == target) {
+							p[i] = target ^ 0x10;
+						}
+					}
+					p[len] = '\0';
+					if (pos < len) {
+						p[pos] = target;
+					}
+					/* Put 'c' after the terminator to catch overruns */
+					p[len + 1] = target;
+					/* The byte-wise strchr() compares 'c' without converting it
+					 * to char, so it misses bytes above 0x7f; use the standard
+					 * result instead.
+					 */
+
+					exp = pos < len ? p + pos : (target == '\0' ? p + len : NULL);
+					CHECK(opt_strchr(p, values[v]) == exp, "len %zu a %zu pos %zu c 0x%x", len, a, pos, values[v]);
+				}
+			}
+		}
+	}
+	CHECK(opt_strchr(NULL, 'a') == NULL, "NULL source");
+}
+
+/****************************************************************************
+ * Benchmark
+ ****************************************************************************/
+
+static inline uint64_t bench_ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __builtin_ia32_rdtsc();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TICK_UNIT "cycle"
+#else
+#define TICK_UNIT "ns"
+#endif
+
+#define BENCH_BYTES (32 * 1024 * 1024)
+
+enum bench_op_e {
+	OP_MEMCPY,
+	OP_MEMSET,
+	OP_MEMCMP,
+	OP_MEMCHR,
+	OP_STRLEN,
+	OP_STRCMP,
+	OP_STRCHR,
+	OP_MAX
+};
+
+static const char *g_opname[OP_MAX] = {"memcpy", "memset", "memcmp", "memchr", "strlen", "strcmp", "strchr"};
+
+static volatile uintptr_t g_sink;
+
+static double bench_one(int op, int opt, unsigned char *dst, unsigned char *src, size_t size)
+{
+	size_t loops = BENCH_BYTES / size;
+	size_t i;
+	uint64_t start;
+	uint64_t ticks;
+
+	start = bench_ticks();
+	for (i = 0; i < loops; i++) {
+		switch (op) {
+		case OP_MEMCPY:
+			g_sink += (uintptr_t)(opt ? opt_memcpy(dst, src, size) : ref_memcpy(dst, src, size));
+			break;
+		case OP_MEMSET:
+			g_sink += (uintptr_t)(opt ? opt_memset(dst, 0x5a, size) : ref_memset(dst, 0x5a, size));
+			break;
+		case OP_MEMCMP:
+			g_sink += opt ? opt_memcmp(dst, src, size) : ref_memcmp(dst, src, size);
+			break;
+		case OP_MEMCHR:
+			g_sink += (uintptr_t)(opt ? opt_memchr(src, 0xee, size) : ref_memchr(src, 0xee, size));
+			break;
+		case OP_STRLEN:
+			g_sink += opt ? opt_strlen((char *)src) : ref_strlen((char *)src);
+			break;
+		case OP_STRCMP:
+			g_sink += opt ? opt_strcmp((char *)dst, (char *)src) : ref_strcmp((char *)dst, (char *)src);
+			break;
+		case OP_STRCHR:
+			g_sink += (uintptr_t)(opt ? opt_strchr((char *)src, 0xee) : ref_strchr((char *)src, 0xee));
+			break;
+		}
+	}
+	ticks = bench_ticks() - start;
+
+	return (double)loops * size / (ticks ? ticks : 1);
+}
+
+static void bench(void)
+{
+	static const size_t sizes[] = {8, 64, 512, 4096};
+	static const size_t aligns[][2] = {{0, 0}, {0, 1}, {3, 1}};
+	unsigned char *dbuf;
+	unsigned char *sbuf;
+	unsigned char *dst;
+	unsigned char *src;
+	size_t s;
+	size_t a;
+	size_t i;
+	int op;
+
+	dbuf = malloc(4096 + 64);
+	sbuf = malloc(4096 + 64);
+	if (dbuf == NULL || sbuf == NULL) {
+		return;
+	}
+
+	printf("\nbytes/%s, byte-wise -> word-at-a-time\n", TICK_UNIT);
+	printf("%-7s %6s %6s", "func", "size", "align");
+	for (i = 0; i < sizeof(aligns) / sizeof(aligns[0]); i++) {
+		printf("       d%zu/s%zu     ", aligns[i][0], aligns[i][1]);
+	}
+	printf("\n");
+
+	for (op = 0; op < OP_MAX; op++) {
+		for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+			printf("%-7s %6zu       ", g_opname[op], sizes[s]);
+			for (a = 0; a < sizeof(aligns) / sizeof(aligns[0]); a++) {
+				dst = dbuf + 16 + aligns[a][0];
+				src = sbuf + 16 + aligns[a][1];
+
+				/* Equal, non-zero contents without the searched byte and with
+				 * the terminator at the end, so every function scans 'size' bytes.
+				 */
+
+				for (i = 0; i < sizes[s]; i++) {
+					src[i] = dst[i] = 'a' + i % 26;
+				}
+				src[sizes[s] - 1] = dst[sizes[s] - 1] = '\0';
+
+				printf("  %6.2f -> %6.2f", bench_one(op, 0, dst, src, sizes[s]), bench_one(op, 1, dst, src, sizes[s]));
+			}
+			printf("\n");
+		}
+	}
+
+	free(dbuf);
+	free(sbuf);
+}
+
+int main(int argc, char **argv)
+{
+	srand(1);
+
+	test_memcpy();
+	test_memset();
+	test_memcmp();
+	test_memchr();
+	test_strlen();
+	test_strcmp();
+	test_strchr();
+
+	if (g_fail != 0) {
+		printf("equivalence : %d failures\n", g_fail);
+		return 1;
+	}
+	printf("equivalence : memcpy memset memcmp memchr strlen strcmp strchr match the byte-wise versions\n");
+
+	bench();
+	return 0;
+}
@@ -0,0 +1,76 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/* TizenRT definitions the tmpfs sources use, mapped to Linux.
+ * This header is included ahead of every source of the host build.
+ */
+
+#ifndef __TOOLS_BENCHMARK_TMPFS_HOST_PORT_H
+#define __TOOLS_BENCHMARK_TMPFS_HOST_PORT_H
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#define FAR
+#define CODE
+
+#ifndef OK
+#define OK    0
+#endif
+#ifndef ERROR
+#define ERROR -1
+#endif
+
+#define ASSERT(f)      do { } while (0)
+#define DEBUGASSERT(f) do { } while (0)
+#define get_errno()    errno
+
+/* TizenRT open flags: O_RDONLY is a bit of its own */
+
+#undef O_RDONLY
+#undef O_WRONLY
+#undef O_RDWR
+#define O_RDONLY       (1 << 0)
+#define O_WRONLY       (1 << 1)
+#define O_RDWR         (O_RDONLY | O_WRONLY)
+
+/* The bench is single threaded */
+
+static inline int sched_lock(void)
+{
+	return 0;
+}
+
+static inline int sched_unlock(void)
+{
+	return 0;
+}
+
+#include <debug.h>
+
+#endif
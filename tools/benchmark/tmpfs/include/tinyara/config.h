@@ -0,0 +1,36 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_TMPFS_CONFIG_H
+#define __TOOLS_BENCHMARK_TMPFS_CONFIG_H
+
+/* Host build of os/fs/tmpfs.  CONFIG_FS_TMPFS_CHUNKED is given by the
+ * Makefile.
+ */
+
+#define CONFIG_FS_TMPFS 1
+#define CONFIG_FS_TMPFS_BLOCKSIZE 512
+#define CONFIG_FS_TMPFS_DIRECTORY_ALLOCGUARD 64
+#define CONFIG_FS_TMPFS_DIRECTORY_FREEGUARD 128
+#define CONFIG_FS_TMPFS_FILE_ALLOCGUARD 512
+#define CONFIG_FS_TMPFS_FILE_FREEGUARD 1024
+#define CONFIG_FS_TMPFS_CHUNKSIZE 256
+#define CONFIG_FS_TMPFS_CHUNKPOOL 16
+#define CONFIG_MM_NHEAPS 1
+#define CONFIG_MM_REGIONS 1
+
+#endif
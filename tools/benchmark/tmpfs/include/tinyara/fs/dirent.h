@@ -0,0 +1,39 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_TMPFS_DIRENT_H
+#define __TOOLS_BENCHMARK_TMPFS_DIRENT_H
+
+#include <dirent.h>
+
+#define DTYPE_FILE      DT_REG
+#define DTYPE_DIRECTORY DT_DIR
+
+struct tmpfs_directory_s;
+struct fs_tmpfsdir_s {
+	FAR struct tmpfs_directory_s *tf_tdo;
+	unsigned int tf_index;
+};
+
+struct fs_dirent_s {
+	struct dirent fd_dir;
+	union {
+		struct fs_tmpfsdir_s tmpfs;
+	} u;
+};
+
+#endif
@@ -0,0 +1,61 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_TMPFS_FS_H
+#define __TOOLS_BENCHMARK_TMPFS_FS_H
+
+#include <sys/stat.h>
+#include <sys/statfs.h>
+
+struct fs_dirent_s;
+
+struct inode {
+	FAR void *i_private;
+};
+
+struct file {
+	int f_oflags;
+	off_t f_pos;
+	FAR struct inode *f_inode;
+	FAR void *f_priv;
+};
+
+struct mountpt_operations {
+	int (*open)(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+	int (*close)(FAR struct file *filep);
+	ssize_t (*read)(FAR struct file *filep, FAR char *buffer, size_t buflen);
+	ssize_t (*write)(FAR struct file *filep, FAR const char *buffer, size_t buflen);
+	off_t (*seek)(FAR struct file *filep, off_t offset, int whence);
+	int (*ioctl)(FAR struct file *filep, int cmd, unsigned long arg);
+	int (*sync)(FAR struct file *filep);
+	int (*dup)(FAR const struct file *oldp, FAR struct file *newp);
+	int (*fstat)(FAR const struct file *filep, FAR struct stat *buf);
+	int (*opendir)(FAR struct inode *mountpt, FAR const char *relpath, FAR struct fs_dirent_s *dir);
+	int (*closedir)(FAR struct inode *mountpt, FAR struct fs_dirent_s *dir);
+	int (*readdir)(FAR struct inode *mountpt, FAR struct fs_dirent_s *dir);
+	int (*rewinddir)(FAR struct inode *mountpt, FAR struct fs_dirent_s *dir);
+	int (*bind)(FAR struct inode *blkdriver, FAR const void *data, FAR void **handle);
+	int (*unbind)(FAR void *handle, FAR struct inode **blkdriver);
+	int (*statfs)(FAR struct inode *mountpt, FAR struct statfs *buf);
+	int (*unlink)(FAR struct inode *mountpt, FAR const char *relpath);
+	int (*mkdir)(FAR struct inode *mountpt, FAR const char *relpath, mode_t mode);
+	int (*rmdir)(FAR struct inode *mountpt, FAR const char *relpath);
+	int (*rename)(FAR struct inode *mountpt, FAR const char *oldrelpath, FAR const char *newrelpath);
+	int (*stat)(FAR struct inode *mountpt, FAR const char *relpath, FAR struct stat *buf);
+};
+
+#endif
@@ -0,0 +1,40 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_TMPFS_KMALLOC_H
+#define __TOOLS_BENCHMARK_TMPFS_KMALLOC_H
+
+#include <stdlib.h>
+
+/* The heap calls are counted by tmpfs_bench.c */
+
+void *bench_malloc(size_t size);
+void *bench_zalloc(size_t size);
+void *bench_realloc(void *ptr, size_t size);
+void bench_free(void *ptr);
+char *bench_strdup(const char *str);
+
+#define kmm_malloc(s)     bench_malloc(s)
+#define kmm_zalloc(s)     bench_zalloc(s)
+#define kmm_realloc(p, s) bench_realloc(p, s)
+#define kmm_free(p)       bench_free(p)
+
+/* TizenRT strdup() takes its copy from the same heap */
+
+#define strdup(s)         bench_strdup(s)
+
+#endif
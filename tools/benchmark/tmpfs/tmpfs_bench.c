@@ -0,0 +1,458 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/*
+ * Host benchmark of the file data storage of os/fs/tmpfs.
+ *
+ * fs_tmpfs.c is built unchanged on top of the small TizenRT shims of
+ * include/ and driven through its mountpt_operations.  Without
+ * CONFIG_FS_TMPFS_CHUNKED a file is one heap object which is reallocated
+ * as it grows; with it the data lives in fixed-size chunks.
+ *
+ * glibc is set up to serve everything from one heap without mmap() or
+ * trimming, like the heap of a TizenRT board.  The kmm_* calls are
+ * counted, with the bytes realloc() had to copy when it moved a block.
+ */
+
+#include <tinyara/config.h>
+
+#include <malloc.h>
+#include <stdlib.h>
+#include <time.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+
+#ifdef CONFIG_FS_TMPFS_CHUNKED
+#define BUILD_NAME    "chunked"
+#else
+#define BUILD_NAME    "contiguous"
+#endif
+
+#define WRITE_SIZE    64
+#define BIG_SIZE      (256 * 1024)
+#define NFILES        8
+#define FILE_SIZE     (32 * 1024)
+
+extern const struct mountpt_operations tmpfs_operations;
+
+static struct inode g_mount;
+
+static unsigned long g_allocs;
+static unsigned long g_moves;
+static unsigned long long g_copied;
+static size_t g_heap;
+
+/* Counting heap */
+
+static void heap_add(void *ptr)
+{
+	if (ptr != NULL) {
+		g_heap += malloc_usable_size(ptr);
+	}
+}
+
+void *bench_malloc(size_t size)
+{
+	void *ptr = malloc(size);
+
+	g_allocs++;
+	heap_add(ptr);
+	return ptr;
+}
+
+void *bench_zalloc(size_t size)
+{
+	void *ptr = calloc(1, size);
+
+	g_allocs++;
+	heap_add(ptr);
+	return ptr;
+}
+
+void *bench_realloc(void *ptr, size_t size)
+{
+	size_t old = ptr != NULL ? malloc_usable_size(ptr) : 0;
+	void *newptr;
+
+	g_allocs++;
+	newptr = realloc(ptr, size);
+	if (newptr != NULL) {
+		g_heap -= old;
+		heap_add(newptr);
+		if (ptr != NULL && newptr != ptr) {
+			g_moves++;
+			g_copied += old < size ? old : size;
+		}
+	}
+
+	return newptr;
+}
+
+void bench_free(void *ptr)
+{
+	if (ptr != NULL) {
+		g_heap -= malloc_usable_size(ptr);
+	}
+
+	free(ptr);
+}
+
+char *bench_strdup(const char *str)
+{
+	char *copy = bench_malloc(strlen(str) + 1);
+
+	if (copy != NULL) {
+		strcpy(copy, str);
+	}
+
+	return copy;
+}
+
+static double now_sec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void fail(const char *what, long value)
+{
+	fprintf(stderr, "%s: %s failed: %ld\n", BUILD_NAME, what, value);
+	exit(1);
+}
+
+static void reset_counts(void)
+{
+	g_allocs = 0;
+	g_moves = 0;
+	g_copied = 0;
+}
+
+/* File helpers on top of the mount point operations */
+
+static void file_open(struct file *filep, const char *path, int oflags)
+{
+	int ret;
+
+	memset(filep, 0, sizeof(*filep));
+	filep->f_oflags = oflags;
+	filep->f_inode = &g_mount;
+	ret = tmpfs_operations.open(filep, path, oflags, 0666);
+	if (ret < 0) {
+		fail("open", ret);
+	}
+}
+
+static void file_close(struct file *filep)
+{
+	tmpfs_operations.close(filep);
+}
+
+static void file_write(struct file *filep, const void *buf, size_t len)
+{
+	ssize_t ret = tmpfs_operations.write(filep, buf, len);
+
+	if (ret != (ssize_t)len) {
+		fail("write", ret);
+	}
+}
+
+static void file_read(struct file *filep, void *buf, size_t len, off_t pos)
+{
+	ssize_t ret;
+
+	tmpfs_operations.seek(filep, pos, SEEK_SET);
+	ret = tmpfs_operations.read(filep, buf, len);
+	if (ret != (ssize_t)len) {
+		fail("read", ret);
+	}
+}
+
+static void file_unlink(const char *path)
+{
+	int ret = tmpfs_operations.unlink(&g_mount, path);
+
+	if (ret < 0) {
+		fail("unlink", ret);
+	}
+}
+
+/* Random writes, holes, truncation and FIOC_MMAP against a shadow copy */
+
+static void check_data(void)
+{
+	static uint8_t shadow[FILE_SIZE];
+	static uint8_t buf[FILE_SIZE];
+	struct file file;
+	struct stat st;
+	void *map;
+	size_t size = 0;
+	int i;
+
+	srand(1);
+	memset(shadow, 0, sizeof(shadow));
+	file_open(&file, "check", O_RDWR | O_CREAT);
+
+	for (i = 0; i < 2000; i++) {
+		size_t len = 1 + rand() % 700;
+		off_t pos = rand() % (FILE_SIZE - len);
+		size_t j;
+
+		/* Now and then jump past the end of the file to leave a hole */
+
+		if (i % 50 != 0 && pos > (off_t)size) {
+			pos = size;
+		}
+
+		for (j = 0; j < len; j++) {
+			shadow[pos + j] = rand();
+		}
+
+		tmpfs_operations.seek(&file, pos, SEEK_SET);
+		file_write(&file, &shadow[pos], len);
+		if (pos + len > size) {
+			size = pos + len;
+		}
+	}
+
+	tmpfs_operations.fstat(&file, &st);
+	if (st.st_size != (off_t)size) {
+		fail("size check", st.st_size);
+	}
+
+	file_read(&file, buf, size, 0);
+	if (memcmp(buf, shadow, size) != 0) {
+		fail("data check", 0);
+	}
+
+	if (tmpfs_operations.read(&file, (char *)buf, 16) != 0) {
+		fail("read at end of file", 0);
+	}
+
+	file_close(&file);
+
+	/* Truncate, then extend by a write past the end: the gap reads zeros */
+
+	file_open(&file, "check", O_RDWR | O_TRUNC);
+	file_write(&file, shadow, 100);
+	tmpfs_operations.seek(&file, 1000, SEEK_SET);
+	file_write(&file, shadow, 10);
+	file_read(&file, buf, 1010, 0);
+	for (i = 100; i < 1000; i++) {
+		if (buf[i] != 0) {
+			fail("hole check", i);
+		}
+	}
+
+	/* A small file can still be mapped */
+
+	if (tmpfs_operations.ioctl(&file, FIOC_MMAP, (unsigned long)&map) == OK &&
+		memcmp(map, shadow, 100) != 0) {
+		fail("mmap check", 0);
+	}
+
+	file_close(&file);
+	file_unlink("check");
+	printf("%-10s data, holes, truncate and mmap checks passed\n", BUILD_NAME);
+}
+
+/* A file still open at the last unmount keeps its data until it is closed,
+ * and then all of the memory of the file system is returned.
+ */
+
+static void check_unmount(void)
+{
+	static uint8_t data[FILE_SIZE];
+	static uint8_t buf[FILE_SIZE];
+	size_t heap = g_heap;
+	struct file file;
+	void *handle;
+	int ret;
+	int i;
+
+	ret = tmpfs_operations.bind(NULL, NULL, &handle);
+	if (ret < 0) {
+		fail("bind", ret);
+	}
+
+	g_mount.i_private = handle;
+
+	for (i = 0; i < FILE_SIZE; i++) {
+		data[i] = i * 7;
+	}
+
+	file_open(&file, "open", O_RDWR | O_CREAT);
+	file_write(&file, data, FILE_SIZE);
+
+	tmpfs_operations.unbind(handle, NULL);
+	g_mount.i_private = NULL;
+
+	file_read(&file, buf, FILE_SIZE, 0);
+	if (memcmp(buf, data, FILE_SIZE) != 0) {
+		fail("data check after unmount", 0);
+	}
+
+	file_close(&file);
+	if (g_heap != heap) {
+		fail("heap check after unmount", (long)(g_heap - heap));
+	}
+
+	printf("%-10s open file across unmount check passed\n", BUILD_NAME);
+}
+
+/* One file grown by small appends */
+
+static void bench_append(void)
+{
+	static uint8_t data[WRITE_SIZE];
+	struct file file;
+	double start;
+	double elapsed;
+	int rounds = 0;
+	int i;
+
+	memset(data, 0x5a, sizeof(data));
+	reset_counts();
+
+	start = now_sec();
+	do {
+		file_open(&file, "big", O_WRONLY | O_CREAT | O_TRUNC);
+		for (i = 0; i < BIG_SIZE / WRITE_SIZE; i++) {
+			file_write(&file, data, WRITE_SIZE);
+		}
+
+		file_close(&file);
+		rounds++;
+		elapsed = now_sec() - start;
+	} while (elapsed < 1.0);
+
+	printf("%-10s append %dKB in %d byte writes: %7.1f MB/s, "
+		   "%5.2f heap calls/KB, %8.0f bytes copied/KB\n",
+		   BUILD_NAME, BIG_SIZE / 1024, WRITE_SIZE,
+		   (double)rounds * BIG_SIZE / elapsed / 1e6,
+		   (double)g_allocs * 1024 / ((double)rounds * BIG_SIZE),
+		   (double)g_copied * 1024 / ((double)rounds * BIG_SIZE));
+
+	file_unlink("big");
+}
+
+/* Several files grown side by side */
+
+static void grow_files(struct file *files, int first, int step, int nbytes)
+{
+	static uint8_t data[WRITE_SIZE];
+	int i;
+	int j;
+
+	memset(data, 0xa5, sizeof(data));
+	for (j = 0; j < nbytes / WRITE_SIZE; j++) {
+		for (i = first; i < NFILES; i += step) {
+			file_write(&files[i], data, WRITE_SIZE);
+		}
+	}
+}
+
+static void bench_interleaved(void)
+{
+	struct file files[NFILES];
+	struct mallinfo2 mi;
+	char name[16];
+	double start;
+	double elapsed;
+	size_t arena;
+	int i;
+
+	reset_counts();
+
+	for (i = 0; i < NFILES; i++) {
+		snprintf(name, sizeof(name), "f%d", i);
+		file_open(&files[i], name, O_WRONLY | O_CREAT | O_TRUNC);
+	}
+
+	start = now_sec();
+	grow_files(files, 0, 1, FILE_SIZE);
+	elapsed = now_sec() - start;
+
+	mi = mallinfo2();
+	printf("%-10s %d files of %dKB side by side: %7.1f MB/s, "
+		   "%8.0f bytes copied/KB, heap %zu KB for %d KB of data\n",
+		   BUILD_NAME, NFILES, FILE_SIZE / 1024,
+		   (double)NFILES * FILE_SIZE / elapsed / 1e6,
+		   (double)g_copied * 1024 / ((double)NFILES * FILE_SIZE),
+		   mi.arena / 1024, NFILES * FILE_SIZE / 1024);
+
+	/* Remove every other file, then grow the others to twice their size.
+	 * The space of the removed files can only be reused if the growing
+	 * files do not need it in one piece.
+	 */
+
+	for (i = 1; i < NFILES; i += 2) {
+		file_close(&files[i]);
+		snprintf(name, sizeof(name), "f%d", i);
+		file_unlink(name);
+	}
+
+	mi = mallinfo2();
+	arena = mi.arena;
+	printf("%-10s after removing half: %zu KB in use, %zu KB free in the "
+		   "heap (%.0f%%)\n",
+		   BUILD_NAME, g_heap / 1024, mi.fordblks / 1024,
+		   100.0 * mi.fordblks / mi.arena);
+
+	grow_files(files, 0, 2, FILE_SIZE);
+
+	mi = mallinfo2();
+	printf("%-10s after doubling the rest: heap grew by %zu KB for %d KB "
+		   "of new data\n",
+		   BUILD_NAME, (mi.arena - arena) / 1024,
+		   NFILES / 2 * FILE_SIZE / 1024);
+
+	for (i = 0; i < NFILES; i += 2) {
+		file_close(&files[i]);
+		snprintf(name, sizeof(name), "f%d", i);
+		file_unlink(name);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	void *handle;
+	int ret;
+
+	/* One flat heap: no mmap() for large blocks and no trimming */
+
+	mallopt(M_MMAP_THRESHOLD, 32 * 1024 * 1024);
+	mallopt(M_TRIM_THRESHOLD, 256 * 1024 * 1024);
+	mallopt(M_TOP_PAD, 0);
+
+	ret = tmpfs_operations.bind(NULL, NULL, &handle);
+	if (ret < 0) {
+		fail("bind", ret);
+	}
+
+	g_mount.i_private = handle;
+
+	check_data();
+	bench_append();
+	bench_interleaved();
+
+	tmpfs_operations.unbind(handle, NULL);
+
+	check_unmount();
+	return 0;
+}
@@ -0,0 +1,28 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/* Host build of the MPEG-2 TS demuxer does not log anything. */
+
+#ifndef __TOOLS_BENCHMARK_TSDEMUX_DEBUG_H
+#define __TOOLS_BENCHMARK_TSDEMUX_DEBUG_H
+
+#define mdbg(...)
+#define meddbg(...)
+#define medwdbg(...)
+#define medvdbg(...)
+
+#endif
@@ -0,0 +1,30 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_TSDEMUX_CONFIG_H
+#define __TOOLS_BENCHMARK_TSDEMUX_CONFIG_H
+
+/* Host build of the MPEG-2 TS demuxer, CONFIG_CONTAINER_MPEG2TS_INPLACE is
+ * given by the Makefile.
+ */
+
+#define CONFIG_MEDIA_PLAYER
+#define CONFIG_CONTAINER_MPEG2TS
+#define CONFIG_DEMUX_BUFFER_SIZE                 (4096)
+#define CONFIG_CONTAINER_MPEG2TS_PES_ARENA_SIZE  (8192)
+
+#endif
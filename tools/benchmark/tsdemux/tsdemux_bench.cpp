@@ -0,0 +1,355 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * tools/benchmark/tsdemux/tsdemux_bench.cpp
+ *
+ * Host benchmark of the MPEG-2 TS demuxer of the media framework.  A transport
+ * stream is pushed into the demuxer in 2KB chunks like HTTP input, and the
+ * audio elementary stream is pulled in 4KB reads like the player does.
+ * The stream is either generated (an AAC program with PAT/PMT repeats, PES
+ * packets with PTS and stuffing, and null packets) or read from a recorded TS
+ * file given as argument.  For the generated stream the pulled ES data is
+ * compared against what was packetized.
+ * Reports demux speed in MB/s of TS input and heap allocations per second
+ * while demuxing, counted in operator new.
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <new>
+#include <vector>
+#include "Demuxer.h"
+#include "TSDemuxer.h"
+
+#define PUSH_CHUNK      (2048)
+#define PULL_SIZE       (4096)
+#define STREAM_BYTES    (8 * 1024 * 1024)
+#define BENCH_SECONDS   (1.0)
+
+#define PACKET_SIZE     (188)
+#define PMT_PID         (0x100)
+#define AUDIO_PID       (0x101)
+#define NULL_PID        (0x1fff)
+#define PSI_INTERVAL    (40)    // packets between PAT/PMT repeats
+
+static unsigned long g_allocs;
+
+void *operator new(size_t size)
+{
+	void *ptr = malloc(size ? size : 1);
+
+	if (!ptr) {
+		throw std::bad_alloc();
+	}
+	g_allocs++;
+	return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void *ptr, size_t size) noexcept
+{
+	free(ptr);
+}
+
+/****************************************************************************
+ * Transport stream generator
+ ****************************************************************************/
+
+struct ts_writer_s {
+	std::vector<uint8_t> ts;
+	std::vector<uint8_t> es;
+	uint8_t cc[0x2000];
+	unsigned int packets;
+	uint32_t seed;
+};
+
+static uint32_t mpeg_crc32(const uint8_t *data, size_t length)
+{
+	uint32_t crc = 0xffffffff;
+	int i;
+
+	while (length--) {
+		crc ^= (uint32_t)*data++ << 24;
+		for (i = 0; i < 8; i++) {
+			crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04c11db7 : (crc << 1);
+		}
+	}
+	return crc;
+}
+
+/* Write a packet of the PID, the payload is padded with adaptation field stuffing */
+static void put_packet(struct ts_writer_s *w, uint16_t pid, bool start, const uint8_t *payload, size_t len)
+{
+	uint8_t pkt[PACKET_SIZE];
+	size_t head = 4;
+
+	pkt[0] = 0x47;
+	pkt[1] = (start ? 0x40 : 0x00) | (pid >> 8);
+	pkt[2] = pid & 0xff;
+	pkt[3] = 0x10 | (w->cc[pid]++ & 0x0f);
+	if (len < PACKET_SIZE - 4) {
+		size_t afl = PACKET_SIZE - 5 - len;
+
+		pkt[3] |= 0x20;
+		pkt[4] = afl;
+		if (afl > 0) {
+			pkt[5] = 0x00;
+			memset(&pkt[6], 0xff, afl - 1);
+		}
+		head += 1 + afl;
+	}
+	memcpy(&pkt[head], payload, len);
+	w->ts.insert(w->ts.end(), pkt, pkt + PACKET_SIZE);
+	w->packets++;
+}
+
+static void put_section(struct ts_writer_s *w, uint16_t pid, uint8_t *section, size_t len)
+{
+	uint8_t payload[PACKET_SIZE - 4];
+	uint32_t crc;
+
+	section[1] = 0xb0 | ((len + 4 - 3) >> 8);
+	section[2] = (len + 4 - 3) & 0xff;
+	crc = mpeg_crc32(section, len);
+	section[len++] = crc >> 24;
+	section[len++] = crc >> 16;
+	section[len++] = crc >> 8;
+	section[len++] = crc;
+
+	payload[0] = 0;             // pointer field
+	memcpy(&payload[1], section, len);
+	memset(&payload[1 + len], 0xff, sizeof(payload) - 1 - len);
+	put_packet(w, pid, true, payload, sizeof(payload));
+}
+
+static void put_psi(struct ts_writer_s *w)
+{
+	uint8_t pat[] = { 0x00, 0, 0, 0x00, 0x01, 0xc1, 0x00, 0x00,
+					  0x00, 0x01, 0xe0 | (PMT_PID >> 8), PMT_PID & 0xff, 0, 0, 0, 0 };
+	uint8_t pmt[] = { 0x02, 0, 0, 0x00, 0x01, 0xc1, 0x00, 0x00,
+					  0xe0 | (AUDIO_PID >> 8), AUDIO_PID & 0xff, 0xf0, 0x00,
+					  0x0f, 0xe0 | (AUDIO_PID >> 8), AUDIO_PID & 0xff, 0xf0, 0x00, 0, 0, 0, 0 };
+
+	put_section(w, 0, pat, sizeof(pat) - 4);
+	put_section(w, PMT_PID, pmt, sizeof(pmt) - 4);
+}
+
+static uint32_t next_rand(struct ts_writer_s *w)
+{
+	w->seed = w->seed * 1103515245 + 12345;
+	return w->seed >> 8;
+}
+
+static void put_pes(struct ts_writer_s *w, uint64_t pts, size_t esLen)
+{
+	std::vector<uint8_t> pes(14 + esLen);
+	size_t offset;
+	size_t len;
+	size_t i;
+
+	pes[0] = 0x00;
+	pes[1] = 0x00;
+	pes[2] = 0x01;
+	pes[3] = 0xc0;
+	pes[4] = (8 + esLen) >> 8;
+	pes[5] = (8 + esLen) & 0xff;
+	pes[6] = 0x80;
+	pes[7] = 0x80;              // PTS only
+	pes[8] = 5;
+	pes[9] = 0x21 | ((pts >> 29) & 0x0e);
+	pes[10] = pts >> 22;
+	pes[11] = 0x01 | ((pts >> 14) & 0xfe);
+	pes[12] = pts >> 7;
+	pes[13] = 0x01 | ((pts << 1) & 0xfe);
+	for (i = 0; i < esLen; i++) {
+		pes[14 + i] = next_rand(w);
+	}
+	w->es.insert(w->es.end(), pes.begin() + 14, pes.end());
+
+	for (offset = 0; offset < pes.size(); offset += len) {
+		if (w->packets % PSI_INTERVAL == 0) {
+			put_psi(w);
+		}
+		if (next_rand(w) % 16 == 0) {
+			uint8_t stuffing[PACKET_SIZE - 4];
+
+			memset(stuffing, 0xff, sizeof(stuffing));
+			put_packet(w, NULL_PID, false, stuffing, sizeof(stuffing));
+		}
+		len = pes.size() - offset;
+		if (len > PACKET_SIZE - 4) {
+			len = PACKET_SIZE - 4;
+		}
+		put_packet(w, AUDIO_PID, offset == 0, &pes[offset], len);
+	}
+}
+
+static void generate(struct ts_writer_s *w, size_t bytes)
+{
+	uint64_t pts = 0;
+
+	memset(w->cc, 0, sizeof(w->cc));
+	w->packets = 0;
+	w->seed = 1;
+	while (w->ts.size() < bytes) {
+		// a few AAC frames of 128kbps per PES packet, like HLS audio segments
+		put_pes(w, pts, 1200 + next_rand(w) % 2400);
+		pts += 3 * 1920;
+	}
+}
+
+/****************************************************************************
+ * Benchmark
+ ****************************************************************************/
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Demux the whole stream once, return ES bytes pulled or -1 on error */
+static long demux(const std::vector<uint8_t> &ts, std::vector<uint8_t> *es, double *elapsed, unsigned long *allocs)
+{
+	static uint8_t out[PULL_SIZE];
+	size_t pos = 0;
+	size_t len;
+	long total = 0;
+	ssize_t ret;
+	double start;
+
+	auto demuxer = media::TSDemuxer::create();
+	if (!demuxer) {
+		return -1;
+	}
+
+	auto push = [&]() -> size_t {
+		len = demuxer->getAvailSpace();
+		if (len > PUSH_CHUNK) {
+			len = PUSH_CHUNK;
+		}
+		if (len > ts.size() - pos) {
+			len = ts.size() - pos;
+		}
+		len = demuxer->pushData((uint8_t *)&ts[pos], len);
+		pos += len;
+		return len;
+	};
+
+	// PAT and PMT are parsed ahead like the player does
+	while ((ret = demuxer->prepare()) == media::DEMUXER_ERROR_WANT_DATA) {
+		if (!push()) {
+			return -1;
+		}
+	}
+	if (ret != media::DEMUXER_ERROR_NONE) {
+		return -1;
+	}
+
+	*allocs = g_allocs;
+	start = now();
+	for (;;) {
+		ret = demuxer->pullData(out, sizeof(out));
+		if (ret > 0) {
+			if (es) {
+				es->insert(es->end(), out, out + ret);
+			}
+			total += ret;
+		} else if (ret != media::DEMUXER_ERROR_WANT_DATA || !push()) {
+			break;
+		}
+	}
+	*elapsed = now() - start;
+	*allocs = g_allocs - *allocs;
+
+	return total;
+}
+
+int main(int argc, char *argv[])
+{
+	struct ts_writer_s w;
+	std::vector<uint8_t> es;
+	const char *source = "generated";
+	unsigned long allocs;
+	unsigned long totalAllocs = 0;
+	double elapsed;
+	double totalElapsed = 0;
+	double bytes = 0;
+	long esBytes;
+	bool ok = true;
+
+	if (argc > 1) {
+		FILE *fp = fopen(argv[1], "rb");
+		uint8_t buf[4096];
+		size_t len;
+
+		if (!fp) {
+			fprintf(stderr, "can't open %s\n", argv[1]);
+			return 1;
+		}
+		while ((len = fread(buf, 1, sizeof(buf), fp)) > 0) {
+			w.ts.insert(w.ts.end(), buf, buf + len);
+		}
+		fclose(fp);
+		source = argv[1];
+	} else {
+		generate(&w, STREAM_BYTES);
+	}
+
+	// First pass checks the ES data against the generated one
+	esBytes = demux(w.ts, &es, &elapsed, &allocs);
+	if (esBytes < 0) {
+		fprintf(stderr, "demux failed\n");
+		return 1;
+	}
+	if (!w.es.empty()) {
+		ok = (es == w.es);
+	}
+
+	do {
+		if (demux(w.ts, nullptr, &elapsed, &allocs) != esBytes) {
+			fprintf(stderr, "demux failed\n");
+			return 1;
+		}
+		totalElapsed += elapsed;
+		totalAllocs += allocs;
+		bytes += w.ts.size();
+	} while (totalElapsed < BENCH_SECONDS);
+
+#ifdef CONFIG_CONTAINER_MPEG2TS_INPLACE
+	printf("in place demux, %s stream\n", source);
+#else
+	printf("copying demux, %s stream\n", source);
+#endif
+	printf("  TS %zu bytes, ES %ld bytes%s\n", w.ts.size(), esBytes,
+		   w.es.empty() ? "" : (ok ? ", ES data ok" : ", ES data MISMATCH"));
+	printf("  %8.1f MB/s  %10.0f allocs/s  %6.2f allocs/TS packet\n",
+		   bytes / totalElapsed / 1e6, totalAllocs / totalElapsed, totalAllocs * (double)PACKET_SIZE / bytes);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/* TizenRT definitions the Unix domain socket sources use, mapped to Linux.
+ * This header is included ahead of every source of the host build.
+ *
+ * The semaphores count their waiters below zero as the TizenRT ones do,
+ * and net_lockedwait() releases the network lock and waits atomically.
+ * Both are implemented in uds_bench.c.
+ */
+
+#ifndef __TOOLS_BENCHMARK_UDS_HOST_PORT_H
+#define __TOOLS_BENCHMARK_UDS_HOST_PORT_H
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+
+#define FAR
+
+#ifndef OK
+#define OK    0
+#include <debug.h>
+
+#endif
+#ifndef ERROR
+#define ERROR -1
+#include <debug.h>
+
+#endif
+
+#define DEBUGASSERT(f) do { } while (0)
+#define DEBUGPANIC()   do { } while (0)
+
+#define UNIX_PATH_MAX  108
+
+#define PIPEIOC_POLICY 0x0001
+
+#define get_errno()    errno
+
+/* TizenRT semaphores */
+
+typedef struct host_sem_s {
+	int count;					/* Below zero: number of waiters */
+	int wakeups;				/* Posts not yet taken by a waiter */
+	pthread_cond_t cond;
+} host_sem_t;
+
+#define sem_t          host_sem_t
+#define sem_init       host_sem_init
+#define sem_destroy    host_sem_destroy
+#define sem_wait       host_sem_wait
+#define sem_post       host_sem_post
+#define sem_getvalue   host_sem_getvalue
+
+int host_sem_init(host_sem_t *sem, int pshared, unsigned int value);
+int host_sem_destroy(host_sem_t *sem);
+int host_sem_wait(host_sem_t *sem);
+int host_sem_post(host_sem_t *sem);
+int host_sem_getvalue(host_sem_t *sem, int *sval);
+
+/* TizenRT pollfd */
+
+typedef uint8_t pollevent_t;
+
+#define pollfd host_pollfd
+
+struct host_pollfd {
+	int fd;
+	pollevent_t events;
+	pollevent_t revents;
+	sem_t *sem;
+	void *priv;
+};
+
+#include <debug.h>
+
+#endif
@@ -0,0 +1,32 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_UDS_SOCKET_H
+#define __TOOLS_BENCHMARK_UDS_SOCKET_H
+
+/* The socket flags of net/socket/socket.h */
+
+#define _SF_NONBLOCK       0x08
+#define _SF_LISTENING      0x10
+#define _SF_BOUND          0x20
+#define _SF_CONNECTED      0x40
+#define _SF_CLOSED         0x80
+
+#define _SS_ISNONBLOCK(s)  (((s) & _SF_NONBLOCK) != 0)
+#define _SS_ISCONNECTED(s) (((s) & _SF_CONNECTED) != 0)
+
+#endif
@@ -0,0 +1,30 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_UDS_CONFIG_H
+#define __TOOLS_BENCHMARK_UDS_CONFIG_H
+
+/* Host build of the Unix domain stream sockets.
+ * CONFIG_NET_LOCAL_STREAM_DIRECT is given by the Makefile.
+ */
+
+#define CONFIG_NET
+#define CONFIG_NET_LOCAL
+#define CONFIG_NET_LOCAL_STREAM
+#define CONFIG_NET_LOCAL_STREAM_BUFSIZE 4096
+
+#endif
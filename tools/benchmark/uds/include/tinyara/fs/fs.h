@@ -0,0 +1,35 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_UDS_FS_H
+#define __TOOLS_BENCHMARK_UDS_FS_H
+
+/* The FIFOs are Linux FIFOs, f_inode is set while one is open */
+
+struct file {
+	int f_fd;
+	FAR void *f_inode;
+};
+
+int file_open(FAR struct file *filep, FAR const char *path, int oflags, ...);
+ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes);
+ssize_t file_write(FAR struct file *filep, FAR const void *buf, size_t nbytes);
+int file_close(FAR struct file *filep);
+int file_ioctl(FAR struct file *filep, int req, unsigned long arg);
+int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup);
+
+#endif
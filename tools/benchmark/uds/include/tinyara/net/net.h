@@ -0,0 +1,38 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_UDS_NET_H
+#define __TOOLS_BENCHMARK_UDS_NET_H
+
+struct sock_intf_s;
+
+struct socket {
+	int16_t s_crefs;
+	uint8_t s_domain;
+	uint8_t s_type;
+	uint8_t s_flags;
+	FAR void *s_conn;
+	FAR const struct sock_intf_s *s_sockif;
+};
+
+void net_lockinitialize(void);
+int net_lock(void);
+void net_unlock(void);
+int net_lockedwait(sem_t *sem);
+int net_lockedwait_uninterruptible(sem_t *sem);
+
+#endif
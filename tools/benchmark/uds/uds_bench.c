@@ -0,0 +1,548 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/*
+ * Host benchmark of the Unix domain stream sockets of os/net/local.
+ *
+ * The sources of os/net/local are built unchanged on top of the small
+ * TizenRT shims of include/.  Without CONFIG_NET_LOCAL_STREAM_DIRECT the
+ * connections go through named FIFOs, which are Linux FIFOs here, resized
+ * to the ring size of the direct build so that both get the same amount
+ * of buffering.  Semaphores count the waiters below zero as on TizenRT and
+ * net_lockedwait() drops the network lock while waiting.
+ *
+ * The benchmark measures the connect()/accept()/close() rate and the
+ * throughput of one connection for a few send sizes.  The direct build
+ * also checks socketpair() and the close handling of both ends.
+ *
+ * Large sends are slower on the direct build: every time the ring fills
+ * up the writer and the reader hand the network lock and the semaphores
+ * of the ring back and forth, which costs more context switches than the
+ * Linux FIFO does for the same amount of buffering.
+ */
+
+#include <tinyara/config.h>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <tinyara/net/net.h>
+#include <tinyara/fs/fs.h>
+#include <socket/socket.h>
+
+#include "local/local.h"
+
+#define CONNECTS      5000
+#define XFER_BYTES    (64 * 1024 * 1024)
+#define RECV_SIZE     16384
+
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+#define BUILD_NAME    "direct"
+#else
+#define BUILD_NAME    "fifo"
+#endif
+
+static const size_t g_send_sizes[] = { 64, 1024, 16384 };
+
+/*
+ * One mutex serializes the semaphores and the network lock, so that
+ * net_lockedwait() can drop the lock and start waiting atomically the way
+ * it does with the interrupts disabled on TizenRT.
+ */
+
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_lockcond = PTHREAD_COND_INITIALIZER;
+static pthread_t g_holder;
+static bool g_held;
+static int g_depth;
+
+static struct socket g_server;
+static struct sockaddr_un g_addr;
+
+/* Semaphores */
+
+int host_sem_init(host_sem_t *sem, int pshared, unsigned int value)
+{
+	sem->count = value;
+	sem->wakeups = 0;
+	pthread_cond_init(&sem->cond, NULL);
+	return OK;
+}
+
+int host_sem_destroy(host_sem_t *sem)
+{
+	pthread_cond_destroy(&sem->cond);
+	return OK;
+}
+
+static void sem_wait_locked(host_sem_t *sem)
+{
+	if (--sem->count < 0) {
+		while (sem->wakeups == 0) {
+			pthread_cond_wait(&sem->cond, &g_mutex);
+		}
+		sem->wakeups--;
+	}
+}
+
+int host_sem_wait(host_sem_t *sem)
+{
+	pthread_mutex_lock(&g_mutex);
+	sem_wait_locked(sem);
+	pthread_mutex_unlock(&g_mutex);
+	return OK;
+}
+
+int host_sem_post(host_sem_t *sem)
+{
+	pthread_mutex_lock(&g_mutex);
+	if (++sem->count <= 0) {
+		sem->wakeups++;
+		pthread_cond_signal(&sem->cond);
+	}
+	pthread_mutex_unlock(&g_mutex);
+	return OK;
+}
+
+int host_sem_getvalue(host_sem_t *sem, int *sval)
+{
+	pthread_mutex_lock(&g_mutex);
+	*sval = sem->count;
+	pthread_mutex_unlock(&g_mutex);
+	return OK;
+}
+
+/* Network lock */
+
+void net_lockinitialize(void)
+{
+}
+
+static void net_lock_locked(int depth)
+{
+	pthread_t self = pthread_self();
+
+	while (g_held && !pthread_equal(g_holder, self)) {
+		pthread_cond_wait(&g_lockcond, &g_mutex);
+	}
+	g_held = true;
+	g_holder = self;
+	g_depth += depth;
+}
+
+int net_lock(void)
+{
+	pthread_mutex_lock(&g_mutex);
+	net_lock_locked(1);
+	pthread_mutex_unlock(&g_mutex);
+	return OK;
+}
+
+void net_unlock(void)
+{
+	pthread_mutex_lock(&g_mutex);
+	if (--g_depth == 0) {
+		g_held = false;
+		pthread_cond_broadcast(&g_lockcond);
+	}
+	pthread_mutex_unlock(&g_mutex);
+}
+
+int net_lockedwait(sem_t *sem)
+{
+	int depth = 0;
+
+	pthread_mutex_lock(&g_mutex);
+	if (g_held && pthread_equal(g_holder, pthread_self())) {
+		depth = g_depth;
+		g_depth = 0;
+		g_held = false;
+		pthread_cond_broadcast(&g_lockcond);
+	}
+
+	sem_wait_locked(sem);
+
+	if (depth > 0) {
+		net_lock_locked(depth);
+	}
+	pthread_mutex_unlock(&g_mutex);
+	return OK;
+}
+
+int net_lockedwait_uninterruptible(sem_t *sem)
+{
+	return net_lockedwait(sem);
+}
+
+/* Files */
+
+int file_open(FAR struct file *filep, FAR const char *path, int oflags, ...)
+{
+	/* Both ends are opened for reading and writing so that open() does not
+	 * wait for the other end as it does not on TizenRT.
+	 */
+
+	filep->f_fd = open(path, O_RDWR | (oflags & O_NONBLOCK));
+	if (filep->f_fd < 0) {
+		return -errno;
+	}
+
+	/* The comparison is only fair if the FIFO buffers as much as the ring.
+	 * Linux pipes cannot be smaller than a page, hence the host ring size.
+	 */
+
+	if (fcntl(filep->f_fd, F_SETPIPE_SZ, CONFIG_NET_LOCAL_STREAM_BUFSIZE) < 0 ||
+		fcntl(filep->f_fd, F_GETPIPE_SZ) != CONFIG_NET_LOCAL_STREAM_BUFSIZE) {
+		fprintf(stderr, "FIFO buffer is not %d bytes\n",
+				CONFIG_NET_LOCAL_STREAM_BUFSIZE);
+		exit(1);
+	}
+
+	filep->f_inode = filep;
+	return OK;
+}
+
+ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes)
+{
+	ssize_t ret = read(filep->f_fd, buf, nbytes);
+
+	return ret < 0 ? -errno : ret;
+}
+
+ssize_t file_write(FAR struct file *filep, FAR const void *buf, size_t nbytes)
+{
+	ssize_t ret = write(filep->f_fd, buf, nbytes);
+
+	return ret < 0 ? -errno : ret;
+}
+
+int file_close(FAR struct file *filep)
+{
+	close(filep->f_fd);
+	filep->f_fd = -1;
+	filep->f_inode = NULL;
+	return OK;
+}
+
+int file_ioctl(FAR struct file *filep, int req, unsigned long arg)
+{
+	return OK;
+}
+
+int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
+{
+	return OK;
+}
+
+/* Sockets */
+
+static double now_sec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* The FIFOs are character devices on TizenRT and local_fifo.c unlinks
+ * only those, so the Linux FIFOs of the connections are removed here.
+ */
+
+static void remove_fifos(void)
+{
+	char prefix[32];
+	char path[64];
+	struct dirent *entry;
+	DIR *dir;
+
+	snprintf(prefix, sizeof(prefix), "uds_bench.%d", (int)getpid());
+	dir = opendir("/tmp");
+	if (dir == NULL) {
+		return;
+	}
+
+	while ((entry = readdir(dir)) != NULL) {
+		if (strncmp(entry->d_name, prefix, strlen(prefix)) == 0) {
+			snprintf(path, sizeof(path), "/tmp/%s", entry->d_name);
+			unlink(path);
+		}
+	}
+
+	closedir(dir);
+}
+
+static void fail(const char *what, int ret)
+{
+	fprintf(stderr, "%s: %s failed: %d\n", BUILD_NAME, what, ret);
+	exit(1);
+}
+
+static void bench_socket(struct socket *psock)
+{
+	FAR struct local_conn_s *conn = local_alloc();
+
+	if (conn == NULL) {
+		fail("local_alloc", -ENOMEM);
+	}
+
+	conn->lc_crefs = 1;
+	memset(psock, 0, sizeof(*psock));
+	psock->s_crefs = 1;
+	psock->s_domain = PF_LOCAL;
+	psock->s_type = SOCK_STREAM;
+	psock->s_conn = conn;
+}
+
+static void bench_close(struct socket *psock)
+{
+	FAR struct local_conn_s *conn = psock->s_conn;
+
+	conn->lc_crefs = 0;
+	local_release(conn);
+	psock->s_conn = NULL;
+}
+
+static void bench_connect(struct socket *psock)
+{
+	int ret;
+
+	bench_socket(psock);
+	ret = psock_local_connect(psock, (struct sockaddr *)&g_addr);
+	if (ret < 0) {
+		fail("connect", ret);
+	}
+	psock->s_flags |= _SF_CONNECTED;
+}
+
+static void bench_accept(struct socket *newsock)
+{
+	int ret;
+
+	memset(newsock, 0, sizeof(*newsock));
+	ret = local_accept(&g_server, NULL, NULL, newsock);
+	if (ret < 0) {
+		fail("accept", ret);
+	}
+	newsock->s_crefs = 1;
+	newsock->s_flags |= _SF_CONNECTED;
+}
+
+static void send_all(struct socket *psock, const uint8_t *buf, size_t len)
+{
+	ssize_t ret;
+
+	while (len > 0) {
+		ret = psock_local_send(psock, buf, len, 0);
+		if (ret <= 0) {
+			fail("send", ret);
+		}
+		buf += ret;
+		len -= ret;
+	}
+}
+
+static void *accept_thread(void *arg)
+{
+	struct socket newsock;
+	int i;
+
+	for (i = 0; i < CONNECTS; i++) {
+		bench_accept(&newsock);
+		bench_close(&newsock);
+	}
+
+	return NULL;
+}
+
+struct sink_s {
+	size_t nbytes;
+	bool check;
+	uint32_t sum;
+};
+
+static void *sink_thread(void *arg)
+{
+	struct sink_s *sink = arg;
+	struct socket newsock;
+	static uint8_t buf[RECV_SIZE];
+	size_t total = 0;
+	ssize_t ret;
+	ssize_t i;
+
+	bench_accept(&newsock);
+	while (total < sink->nbytes) {
+		ret = local_recvfrom(&newsock, buf, sizeof(buf), 0, NULL, NULL);
+		if (ret <= 0) {
+			fail("recv", ret);
+		}
+		if (sink->check) {
+			for (i = 0; i < ret; i++) {
+				if (buf[i] != (uint8_t)(total + i)) {
+					fail("content check", (int)(total + i));
+				}
+			}
+		}
+		total += ret;
+	}
+	bench_close(&newsock);
+	return NULL;
+}
+
+static void bench_connects(void)
+{
+	struct socket client;
+	pthread_t thread;
+	double start;
+	double elapsed;
+	int i;
+
+	pthread_create(&thread, NULL, accept_thread, NULL);
+	start = now_sec();
+	for (i = 0; i < CONNECTS; i++) {
+		bench_connect(&client);
+		bench_close(&client);
+	}
+	pthread_join(thread, NULL);
+	elapsed = now_sec() - start;
+
+	printf("%-7s connect+accept+close     %9.0f /s\n", BUILD_NAME,
+		   CONNECTS / elapsed);
+}
+
+static void bench_stream(size_t chunk, size_t nbytes, bool check)
+{
+	struct sink_s sink = { nbytes, check, 0 };
+	struct socket client;
+	pthread_t thread;
+	uint8_t *buf;
+	size_t sent;
+	size_t i;
+	double start;
+	double elapsed;
+
+	buf = malloc(chunk + 256);
+	for (i = 0; i < chunk + 256; i++) {
+		buf[i] = (uint8_t)i;
+	}
+
+	pthread_create(&thread, NULL, sink_thread, &sink);
+	bench_connect(&client);
+
+	start = now_sec();
+	for (sent = 0; sent < nbytes; sent += chunk) {
+		send_all(&client, buf + (sent & 0xff), chunk);
+	}
+	pthread_join(thread, NULL);
+	elapsed = now_sec() - start;
+
+	bench_close(&client);
+	free(buf);
+
+	if (!check) {
+		printf("%-7s send %5zu bytes          %9.1f MB/s\n", BUILD_NAME,
+			   chunk, nbytes / elapsed / (1024 * 1024));
+	}
+}
+
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+static void check_socketpair(void)
+{
+	struct socket sv[2];
+	uint8_t buf[64];
+	ssize_t ret;
+
+	bench_socket(&sv[0]);
+	bench_socket(&sv[1]);
+	ret = psock_local_socketpair(&sv[0], &sv[1]);
+	if (ret < 0) {
+		fail("socketpair", ret);
+	}
+
+	send_all(&sv[0], (const uint8_t *)"ping", 4);
+	send_all(&sv[1], (const uint8_t *)"pong!", 5);
+	ret = local_recvfrom(&sv[1], buf, sizeof(buf), 0, NULL, NULL);
+	if (ret != 4 || memcmp(buf, "ping", 4) != 0) {
+		fail("socketpair 0->1", ret);
+	}
+	ret = local_recvfrom(&sv[0], buf, sizeof(buf), 0, NULL, NULL);
+	if (ret != 5 || memcmp(buf, "pong!", 5) != 0) {
+		fail("socketpair 1->0", ret);
+	}
+
+	/* The data sent before close() is still received, then EOF */
+
+	send_all(&sv[0], (const uint8_t *)"bye", 3);
+	bench_close(&sv[0]);
+	ret = local_recvfrom(&sv[1], buf, sizeof(buf), 0, NULL, NULL);
+	if (ret != 3) {
+		fail("recv before EOF", ret);
+	}
+	ret = local_recvfrom(&sv[1], buf, sizeof(buf), 0, NULL, NULL);
+	if (ret != 0) {
+		fail("recv at EOF", ret);
+	}
+	ret = psock_local_send(&sv[1], buf, 1, 0);
+	if (ret != -EPIPE) {
+		fail("send to a closed peer", ret);
+	}
+	bench_close(&sv[1]);
+
+	printf("%-7s socketpair                ok\n", BUILD_NAME);
+}
+#endif
+
+int main(int argc, char **argv)
+{
+	size_t i;
+	int ret;
+
+	local_initialize();
+	atexit(remove_fifos);
+
+	g_addr.sun_family = AF_UNIX;
+	snprintf(g_addr.sun_path, sizeof(g_addr.sun_path), "/tmp/uds_bench.%d",
+			 (int)getpid());
+
+	bench_socket(&g_server);
+	ret = psock_local_bind(&g_server, (struct sockaddr *)&g_addr,
+						   sizeof(g_addr));
+	if (ret < 0) {
+		fail("bind", ret);
+	}
+	ret = local_listen(&g_server, 8);
+	if (ret < 0) {
+		fail("listen", ret);
+	}
+
+	printf("%-7s buffer %d bytes per direction\n", BUILD_NAME,
+		   CONFIG_NET_LOCAL_STREAM_BUFSIZE);
+
+	bench_stream(1000, 4 * 1024 * 1024, true);
+#ifdef CONFIG_NET_LOCAL_STREAM_DIRECT
+	check_socketpair();
+#endif
+	bench_connects();
+	for (i = 0; i < sizeof(g_send_sizes) / sizeof(g_send_sizes[0]); i++) {
+		bench_stream(g_send_sizes[i], XFER_BYTES, false);
+	}
+
+	bench_close(&g_server);
+	return 0;
+}
@@ -0,0 +1,92 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/* TizenRT definitions the webserver uses, mapped to Linux.
+ * This header is included ahead of every source of the host build.
+ */
+
+#ifndef __TOOLS_BENCHMARK_WEBSERVER_HOST_PORT_H
+#define __TOOLS_BENCHMARK_WEBSERVER_HOST_PORT_H
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <malloc.h>
+#include <mqueue.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifndef OK
+#define OK    0
+#endif
+#ifndef ERROR
+#define ERROR -1
+#endif
+
+typedef void *pthread_addr_t;
+typedef pthread_addr_t (*pthread_startroutine_t)(pthread_addr_t);
+
+/* POSIX message queue names start with '/' on Linux */
+static inline const char *host_mq_name(const char *name)
+{
+	static __thread char path[32];
+
+	snprintf(path, sizeof(path), "/%s", name);
+	return path;
+}
+
+/* TizenRT's mqd_t is a pointer and the webserver tests it against NULL, so
+ * the Linux queue descriptor is carried in a pointer.  It is offset by one
+ * so that descriptor 0 is not NULL, and a failed open gives (mqd_t)ERROR.
+ */
+typedef struct host_mq_s *host_mqd_t;
+
+#define HOST_MQFD(mqdes) ((int)((intptr_t)(mqdes) - 1))
+
+static inline host_mqd_t host_mq_open(const char *name, int oflags, mode_t mode, struct mq_attr *attr)
+{
+	int fd = mq_open(host_mq_name(name), oflags, mode, attr);
+
+	return fd < 0 ? (host_mqd_t)ERROR : (host_mqd_t)((intptr_t)fd + 1);
+}
+
+#define mqd_t                               host_mqd_t
+#define mq_open(name, oflags, mode, attr)   host_mq_open(name, oflags, mode, attr)
+#define mq_close(mqdes)                     mq_close(HOST_MQFD(mqdes))
+#define mq_getattr(mqdes, attr)             mq_getattr(HOST_MQFD(mqdes), attr)
+#define mq_send(mqdes, ...)                 mq_send(HOST_MQFD(mqdes), __VA_ARGS__)
+#define mq_receive(mqdes, ...)              mq_receive(HOST_MQFD(mqdes), __VA_ARGS__)
+#define mq_timedreceive(mqdes, ...)         mq_timedreceive(HOST_MQFD(mqdes), __VA_ARGS__)
+#define mq_unlink(name)                     mq_unlink(host_mq_name(name))
+
+/* The client handler checks the heap is big enough for a TLS session */
+static inline struct mallinfo host_mallinfo(void)
+{
+	struct mallinfo info;
+
+	memset(&info, 0, sizeof(info));
+	info.fordblks = 1024 * 1024;
+	return info;
+}
+
+#define mallinfo() host_mallinfo()
+
+#endif
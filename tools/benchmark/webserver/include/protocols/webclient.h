@@ -0,0 +1,39 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/* Host build of the webserver has no webclient, only the response type
+ * shared with http_parse_message() is used.
+ */
+
+#ifndef __TOOLS_BENCHMARK_WEBSERVER_WEBCLIENT_H
+#define __TOOLS_BENCHMARK_WEBSERVER_WEBCLIENT_H
+
+struct http_keyvalue_list_t;
+
+struct http_client_response_t {
+	int method;
+	char *url;
+	int status;
+	char *phrase;
+	struct http_keyvalue_list_t *headers;
+	char *message;
+	char *entity;
+	unsigned int entity_len;
+	unsigned int total_len;
+};
+
+#endif
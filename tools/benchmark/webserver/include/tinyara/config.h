@@ -0,0 +1,33 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_WEBSERVER_CONFIG_H
+#define __TOOLS_BENCHMARK_WEBSERVER_CONFIG_H
+
+/* Host build of the webserver without TLS and websocket.
+ * CONFIG_NETUTILS_WEBSERVER_KEEPALIVE and CONFIG_NETUTILS_WEBSERVER_SENDFILE
+ * are given by the Makefile.
+ */
+
+#define CONFIG_NET
+#define CONFIG_NETUTILS_WEBSERVER
+#define CONFIG_NETUTILS_WEBSERVER_MAX_CLIENT_HANDLER     1
+#define CONFIG_NETUTILS_WEBSERVER_KEEPALIVE_TIMEOUT_MSEC 2000
+#define CONFIG_NETUTILS_WEBSERVER_KEEPALIVE_MAX_REQUESTS 100
+#define CONFIG_NETUTILS_WEBSERVER_FILE_BUFFER_SIZE       2048
+
+#endif
@@ -0,0 +1,288 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/*
+ * Host benchmark of the webserver file serving.
+ *
+ * The server runs in this process on a loopback port and serves the files
+ * of a temporary directory with http_send_file(). A client thread fetches
+ * a small and a large file back to back with HTTP/1.1 requests, and opens a
+ * new connection whenever the server answers "Connection: close".
+ */
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <protocols/webserver/http_err.h>
+#include <protocols/webserver/http_server.h>
+
+#define BENCH_PORT        18080
+#define SMALL_FILE_SIZE   1024
+#define LARGE_FILE_SIZE   (1024 * 1024)
+#define SMALL_REQUESTS    5000
+#define LARGE_REQUESTS    200
+
+static char g_root[64];
+static char g_rsp[LARGE_FILE_SIZE + 4096];
+
+struct bench_conn {
+	int fd;
+	int connects;
+};
+
+static double now_sec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void get_cb(struct http_client_t *client, struct http_req_message *req)
+{
+	char path[128];
+
+	snprintf(path, sizeof(path), "%s%s", g_root, req->url);
+	http_send_file(client, req, path, "text/plain");
+}
+
+static int make_file(const char *name, int size)
+{
+	char path[128];
+	FILE *fp;
+	int i;
+
+	snprintf(path, sizeof(path), "%s/%s", g_root, name);
+	fp = fopen(path, "w");
+	if (fp == NULL) {
+		return -1;
+	}
+
+	for (i = 0; i < size; i++) {
+		fputc('a' + i % 26, fp);
+	}
+
+	fclose(fp);
+	return 0;
+}
+
+static int conn_open(struct bench_conn *conn)
+{
+	struct sockaddr_in addr;
+	int one = 1;
+
+	conn->fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (conn->fd < 0) {
+		return -1;
+	}
+
+	setsockopt(conn->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(BENCH_PORT);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (connect(conn->fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		close(conn->fd);
+		conn->fd = -1;
+		return -1;
+	}
+
+	conn->connects++;
+	return 0;
+}
+
+/*
+ * Send one GET and read the whole response into g_rsp.
+ * Returns the status code, the body length in *body_len and the
+ * ETag in etag if there is one.
+ */
+static int conn_get(struct bench_conn *conn, const char *url, const char *if_none_match, int *body_len, char *etag)
+{
+	char req[256];
+	char *hdr_end = NULL;
+	char *p;
+	int len;
+	int total = 0;
+	int content_len = 0;
+	int status;
+	int keep;
+
+	if (conn->fd < 0 && conn_open(conn) < 0) {
+		return -1;
+	}
+
+	len = snprintf(req, sizeof(req), "GET %s HTTP/1.1\r\nHost: localhost\r\n%s%s%s\r\n", url,
+		       if_none_match ? "If-None-Match: " : "", if_none_match ? if_none_match : "", if_none_match ? "\r\n" : "");
+	if (send(conn->fd, req, len, 0) != len) {
+		return -1;
+	}
+
+	while (hdr_end == NULL || total < (hdr_end - g_rsp) + 4 + content_len) {
+		len = recv(conn->fd, g_rsp + total, sizeof(g_rsp) - 1 - total, 0);
+		if (len <= 0) {
+			return -1;
+		}
+		total += len;
+		g_rsp[total] = '\0';
+
+		if (hdr_end == NULL && (hdr_end = strstr(g_rsp, "\r\n\r\n")) != NULL) {
+			p = strcasestr(g_rsp, "\r\nContent-Length:");
+			content_len = (p && p < hdr_end) ? atoi(p + 17) : 0;
+		}
+	}
+
+	status = atoi(g_rsp + 9);
+	*body_len = content_len;
+	if (etag) {
+		etag[0] = '\0';
+		p = strcasestr(g_rsp, "\r\nETag: ");
+		if (p && p < hdr_end) {
+			sscanf(p + 8, "%63[^\r]", etag);
+		}
+	}
+
+	p = strcasestr(g_rsp, "\r\nConnection: ");
+	keep = p && p < hdr_end && strncasecmp(p + 14, "keep-alive", 10) == 0;
+	if (!keep) {
+		close(conn->fd);
+		conn->fd = -1;
+	}
+
+	return status;
+}
+
+static int run(const char *name, const char *url, int size, int count)
+{
+	struct bench_conn conn = { -1, 0 };
+	double start;
+	double elapsed;
+	int body_len;
+	int i;
+
+	start = now_sec();
+	for (i = 0; i < count; i++) {
+		if (conn_get(&conn, url, NULL, &body_len, NULL) != 200 || body_len != size) {
+			printf("%s: request %d failed\n", name, i);
+			return -1;
+		}
+	}
+	elapsed = now_sec() - start;
+
+	printf("%-6s %7d bytes: %8.0f req/s %8.1f MB/s, %d connections for %d requests\n", name, size, count / elapsed,
+	       (double)size * count / elapsed / (1024 * 1024), conn.connects, count);
+
+	if (conn.fd >= 0) {
+		close(conn.fd);
+	}
+
+	return 0;
+}
+
+static int check(void)
+{
+	struct bench_conn conn = { -1, 0 };
+	char etag[64];
+	int body_len;
+	int status;
+	int i;
+
+	status = conn_get(&conn, "/large", NULL, &body_len, etag);
+	if (status != 200 || body_len != LARGE_FILE_SIZE || etag[0] == '\0') {
+		printf("check: GET failed, status %d\n", status);
+		return -1;
+	}
+
+	for (i = 0; i < LARGE_FILE_SIZE; i++) {
+		if (g_rsp[strstr(g_rsp, "\r\n\r\n") - g_rsp + 4 + i] != 'a' + i % 26) {
+			printf("check: content mismatch at %d\n", i);
+			return -1;
+		}
+	}
+
+	status = conn_get(&conn, "/large", etag, &body_len, NULL);
+	if (status != 304 || body_len != 0) {
+		printf("check: If-None-Match returned %d\n", status);
+		return -1;
+	}
+
+	status = conn_get(&conn, "/missing", NULL, &body_len, NULL);
+	if (status != 404) {
+		printf("check: missing file returned %d\n", status);
+		return -1;
+	}
+
+	if (conn.fd >= 0) {
+		close(conn.fd);
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	struct http_server_t *server;
+	int ret = 1;
+
+	snprintf(g_root, sizeof(g_root), "/tmp/webserver_bench.XXXXXX");
+	if (mkdtemp(g_root) == NULL || make_file("small", SMALL_FILE_SIZE) < 0 || make_file("large", LARGE_FILE_SIZE) < 0) {
+		printf("cannot create the test files\n");
+		return 1;
+	}
+
+	server = http_server_init(BENCH_PORT);
+	if (server == NULL) {
+		printf("http_server_init failed\n");
+		goto out;
+	}
+
+	http_server_register_cb(server, HTTP_METHOD_GET, NULL, get_cb);
+	if (http_server_start(server) != HTTP_OK) {
+		printf("http_server_start failed\n");
+		goto out;
+	}
+
+	/* Wait for the listener to come up */
+	usleep(200 * 1000);
+
+#ifdef CONFIG_NETUTILS_WEBSERVER_KEEPALIVE
+	printf("keep-alive, %s\n", "sendfile");
+#else
+	printf("close, buffered\n");
+#endif
+
+	if (check() == 0 && run("small", "/small", SMALL_FILE_SIZE, SMALL_REQUESTS) == 0 &&
+	    run("large", "/large", LARGE_FILE_SIZE, LARGE_REQUESTS) == 0) {
+		ret = 0;
+	}
+
+	http_server_stop(server);
+	http_server_release(&server);
+out:
+	unlink(strcat(strcpy(g_rsp, g_root), "/small"));
+	unlink(strcat(strcpy(g_rsp, g_root), "/large"));
+	rmdir(g_root);
+	return ret;
+}
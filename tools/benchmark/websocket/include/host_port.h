@@ -0,0 +1,37 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/* TizenRT definitions the websocket server uses, mapped to Linux.
+ * This header is included ahead of every source of the host build.
+ */
+
+#ifndef __TOOLS_BENCHMARK_WEBSOCKET_HOST_PORT_H
+#define __TOOLS_BENCHMARK_WEBSOCKET_HOST_PORT_H
+
+#define _GNU_SOURCE
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+
+#define FAR
+
+typedef void *pthread_addr_t;
+typedef pthread_addr_t (*pthread_startroutine_t)(pthread_addr_t);
+
+#define ndbg(...) do { } while (0)
+
+#endif
@@ -0,0 +1,68 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/* The host build has no TLS. The mbedtls calls of websocket.c are stubbed,
+ * and fail if they are ever reached.
+ */
+
+#ifndef __TOOLS_BENCHMARK_WEBSOCKET_MBEDTLS_SSL_H
+#define __TOOLS_BENCHMARK_WEBSOCKET_MBEDTLS_SSL_H
+
+#include <stddef.h>
+
+#define MBEDTLS_ERR_SSL_WANT_READ  -0x6900
+#define MBEDTLS_ERR_SSL_WANT_WRITE -0x6880
+#define MBEDTLS_ERR_SSL_CONN_EOF   -0x7280
+#define MBEDTLS_ERR_NET_SEND_FAILED -0x004E
+#define MBEDTLS_ERR_NET_RECV_FAILED -0x004C
+
+typedef struct {
+	int fd;
+} mbedtls_net_context;
+
+typedef struct {
+	int unused;
+} mbedtls_ssl_context;
+
+typedef struct {
+	int unused;
+} mbedtls_ssl_config;
+
+#define mbedtls_net_send NULL
+#define mbedtls_net_recv NULL
+
+#define mbedtls_net_init(net)                    ((void)(net))
+#define mbedtls_net_free(net)                    ((void)(net))
+#define mbedtls_net_set_block(net)               (-1)
+#define mbedtls_ssl_init(ssl)                    ((void)(ssl))
+#define mbedtls_ssl_free(ssl)                    ((void)(ssl))
+#define mbedtls_ssl_setup(ssl, conf)             (-1)
+#define mbedtls_ssl_conf_authmode(conf, mode)    ((void)(conf))
+#define mbedtls_ssl_set_bio(ssl, p, s, r, t)     ((void)(ssl))
+#define mbedtls_ssl_handshake(ssl)               (-1)
+#define mbedtls_ssl_read(ssl, buf, len)          (-1)
+#define mbedtls_ssl_write(ssl, buf, len)         (-1)
+#define mbedtls_ssl_get_bytes_avail(ssl)         ((size_t)0)
+#define mbedtls_sha1(in, len, out)               ((void)(out))
+
+static inline int mbedtls_base64_encode(unsigned char *dst, size_t dlen, size_t *olen, const unsigned char *src, size_t slen)
+{
+	*olen = 0;
+	return -1;
+}
+
+#endif
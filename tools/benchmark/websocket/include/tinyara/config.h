@@ -0,0 +1,30 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __TOOLS_BENCHMARK_WEBSOCKET_CONFIG_H
+#define __TOOLS_BENCHMARK_WEBSOCKET_CONFIG_H
+
+/* Host build of the websocket server without TLS.
+ * CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX is given by the Makefile.
+ */
+
+#define CONFIG_NETUTILS_WEBSOCKET
+#define CONFIG_NETUTILS_WEBSOCKET_MAX_CLIENT      20
+#define CONFIG_NETUTILS_WEBSOCKET_SEND_QUEUE_SIZE 4096
+#define CONFIG_CLOCK_MONOTONIC
+
+#endif
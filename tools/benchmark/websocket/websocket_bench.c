@@ -0,0 +1,372 @@
+/****************************************************************************
+ *
+ * Copyright 2020 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/*
+ * Host benchmark of the websocket server sessions.
+ *
+ * WEBSOCKET_MAX_CLIENT loopback connections are handed to
+ * websocket_server_init() the way the webserver does after the HTTP
+ * upgrade, with a thread per session or with CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX.
+ * The server echoes every message, and the client keeps a window of
+ * messages in flight on each connection.
+ *
+ * Only one message at a time is sent to a thread per session: the handler
+ * thread serves one message per wslay_event_recv(), and the next ones wait
+ * in the wslay buffer until more data arrives on the socket.
+ */
+
+#include <tinyara/config.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <malloc.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <protocols/websocket.h>
+
+#define SESSIONS          WEBSOCKET_MAX_CLIENT
+#define MSG_SIZE          64
+#define FRAME_SIZE        (2 + 4 + MSG_SIZE)	/* masked client frame */
+#define ECHO_SIZE         (2 + MSG_SIZE)	/* unmasked server frame */
+#define MSGS_PER_SESSION  20000
+#define STALL_MSGS        4000
+
+struct bench_session {
+	int fd;
+	websocket_t *ws;
+	int sent;
+	int echoed;
+	int rx_bytes;
+};
+
+static struct bench_session g_sessions[SESSIONS];
+static uint8_t g_frame[FRAME_SIZE];
+static int g_window;
+
+static double now_sec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Callbacks as in apps/examples/webserver. recv() doesn't block so that
+ * wslay_event_recv() returns and the echoes are sent with a thread per
+ * session too.
+ */
+
+static ssize_t recv_cb(websocket_context_ptr ctx, uint8_t *buf, size_t len, int flags, void *user_data)
+{
+	struct websocket_info_t *info = user_data;
+	ssize_t r;
+
+	r = recv(info->data->fd, buf, len, MSG_DONTWAIT);
+	if (r == 0) {
+		websocket_set_error(info->data, WEBSOCKET_ERR_CALLBACK_FAILURE);
+	} else if (r < 0) {
+		if (errno == EAGAIN || errno == EWOULDBLOCK) {
+			websocket_set_error(info->data, WEBSOCKET_ERR_WOULDBLOCK);
+		} else {
+			websocket_set_error(info->data, WEBSOCKET_ERR_CALLBACK_FAILURE);
+		}
+	}
+
+	return r;
+}
+
+static ssize_t send_cb(websocket_context_ptr ctx, const uint8_t *buf, size_t len, int flags, void *user_data)
+{
+	struct websocket_info_t *info = user_data;
+	ssize_t r;
+
+	r = send(info->data->fd, buf, len, MSG_NOSIGNAL);
+	if (r < 0) {
+		if (errno == EAGAIN || errno == EWOULDBLOCK) {
+			websocket_set_error(info->data, WEBSOCKET_ERR_WOULDBLOCK);
+		} else {
+			websocket_set_error(info->data, WEBSOCKET_ERR_CALLBACK_FAILURE);
+		}
+	}
+
+	return r;
+}
+
+static void on_msg_cb(websocket_context_ptr ctx, const websocket_on_msg_arg *arg, void *user_data)
+{
+	struct websocket_info_t *info = user_data;
+	websocket_frame_t msgarg = {
+		arg->opcode, arg->msg, arg->msg_length
+	};
+
+	if (WEBSOCKET_CHECK_NOT_CTRL_FRAME(arg->opcode)) {
+		if (websocket_queue_msg(info->data, &msgarg) != WEBSOCKET_SUCCESS) {
+			printf("echo is dropped\n");
+		}
+	}
+}
+
+static websocket_cb_t g_cb = {
+	recv_cb,		/* recv callback */
+	send_cb,		/* send callback */
+	NULL,			/* genmask callback */
+	NULL,			/* on_frame_recv_start callback */
+	NULL,			/* on_frame_recv_chunk callback */
+	NULL,			/* on_frame_recv_end callback */
+	on_msg_cb		/* on_msg_recv callback */
+};
+
+static int start_session(websocket_t *ws)
+{
+#ifdef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
+	return websocket_server_init(ws) == WEBSOCKET_SUCCESS ? 0 : -1;
+#else
+	/* As external/webserver/http_client.c does */
+	if (pthread_attr_init(&ws->thread_attr) != 0) {
+		return -1;
+	}
+	pthread_attr_setstacksize(&ws->thread_attr, WEBSOCKET_STACKSIZE);
+	if (pthread_create(&ws->thread_id, &ws->thread_attr, (pthread_startroutine_t)websocket_server_init, (pthread_addr_t)ws) != 0) {
+		return -1;
+	}
+	pthread_detach(ws->thread_id);
+	return 0;
+#endif
+}
+
+static int open_sessions(void)
+{
+	struct sockaddr_in addr;
+	socklen_t len = sizeof(addr);
+	int listen_fd;
+	int small = 4096;
+	int fd;
+	int i;
+
+	listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listen_fd, SESSIONS) < 0 ||
+		getsockname(listen_fd, (struct sockaddr *)&addr, &len) < 0) {
+		return -1;
+	}
+
+	for (i = 0; i < SESSIONS; i++) {
+		g_sessions[i].fd = socket(AF_INET, SOCK_STREAM, 0);
+		if (i == 0) {
+			/* The first session is stalled later, keep its buffers small */
+			setsockopt(g_sessions[i].fd, SOL_SOCKET, SO_RCVBUF, &small, sizeof(small));
+		}
+		if (connect(g_sessions[i].fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+			return -1;
+		}
+
+		fd = accept(listen_fd, NULL, NULL);
+		if (fd < 0) {
+			return -1;
+		}
+		if (i == 0) {
+			setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &small, sizeof(small));
+		}
+
+		g_sessions[i].ws = websocket_find_table();
+		if (g_sessions[i].ws == NULL) {
+			return -1;
+		}
+		g_sessions[i].ws->fd = fd;
+		g_sessions[i].ws->cb = &g_cb;
+		if (start_session(g_sessions[i].ws) < 0) {
+			return -1;
+		}
+	}
+
+	close(listen_fd);
+
+	/* The threads create their contexts asynchronously */
+	for (i = 0; i < SESSIONS; i++) {
+		while (g_sessions[i].ws->ctx == NULL) {
+			usleep(1000);
+		}
+	}
+
+	return 0;
+}
+
+static int pump(struct bench_session *s, short revents)
+{
+	uint8_t buf[8192];
+	int r;
+
+	if (revents & POLLIN) {
+		r = recv(s->fd, buf, sizeof(buf), 0);
+		if (r <= 0) {
+			return -1;
+		}
+		s->rx_bytes += r;
+		s->echoed = s->rx_bytes / ECHO_SIZE;
+	}
+
+	while (s->sent < MSGS_PER_SESSION && s->sent - s->echoed < g_window) {
+		if (send(s->fd, g_frame, FRAME_SIZE, 0) != FRAME_SIZE) {
+			return -1;
+		}
+		s->sent++;
+	}
+
+	return 0;
+}
+
+static int run(int window)
+{
+	struct pollfd fds[SESSIONS];
+	double start;
+	double elapsed;
+	int done = 0;
+	int i;
+
+	g_window = window;
+	for (i = 0; i < SESSIONS; i++) {
+		fds[i].fd = g_sessions[i].fd;
+		fds[i].events = POLLIN;
+		g_sessions[i].sent = g_sessions[i].echoed = g_sessions[i].rx_bytes = 0;
+		pump(&g_sessions[i], 0);
+	}
+
+	start = now_sec();
+	while (done < SESSIONS) {
+		if (poll(fds, SESSIONS, 5000) <= 0) {
+			printf("echo timed out\n");
+			return -1;
+		}
+
+		for (i = 0; i < SESSIONS; i++) {
+			if (fds[i].revents == 0 || fds[i].fd < 0) {
+				continue;
+			}
+			if (pump(&g_sessions[i], fds[i].revents) < 0) {
+				printf("session %d failed\n", i);
+				return -1;
+			}
+			if (g_sessions[i].echoed == MSGS_PER_SESSION) {
+				fds[i].fd = -1;
+				done++;
+			}
+		}
+	}
+	elapsed = now_sec() - start;
+
+	printf("%d sessions x %d messages of %d bytes, %d in flight each: %8.0f messages/s\n", SESSIONS, MSGS_PER_SESSION,
+		   MSG_SIZE, window, (double)SESSIONS * MSGS_PER_SESSION / elapsed);
+	return 0;
+}
+
+#ifdef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
+/*
+ * The client of the first session sends without reading. The others must
+ * still be served, and every message must be echoed once it reads again.
+ */
+static int stall(void)
+{
+	struct bench_session *s = &g_sessions[0];
+	struct bench_session *other = &g_sessions[1];
+	uint8_t buf[ECHO_SIZE];
+	int flags;
+	int sent = 0;
+	int total = 0;
+	int r;
+
+	flags = fcntl(s->fd, F_GETFL, 0);
+	fcntl(s->fd, F_SETFL, flags | O_NONBLOCK);
+	while (sent < STALL_MSGS && send(s->fd, g_frame, FRAME_SIZE, 0) == FRAME_SIZE) {
+		sent++;
+	}
+	fcntl(s->fd, F_SETFL, flags);
+	usleep(300 * 1000);
+
+	printf("stalled peer: %d messages sent, %zu bytes queued in the server\n", sent,
+		   wslay_event_get_queued_msg_length(s->ws->ctx));
+
+	if (send(other->fd, g_frame, FRAME_SIZE, 0) != FRAME_SIZE || recv(other->fd, buf, ECHO_SIZE, MSG_WAITALL) != ECHO_SIZE) {
+		printf("other session is not served\n");
+		return -1;
+	}
+
+	while (total < sent * ECHO_SIZE) {
+		r = recv(s->fd, buf, sizeof(buf), 0);
+		if (r <= 0) {
+			printf("stalled peer: %d of %d echoes\n", total / ECHO_SIZE, sent);
+			return -1;
+		}
+		total += r;
+	}
+
+	printf("stalled peer: all %d messages echoed after it reads\n", sent);
+	return 0;
+}
+#endif
+
+int main(void)
+{
+	size_t heap;
+	int i;
+
+	/* Count the heap of all threads in the main arena */
+	mallopt(M_ARENA_MAX, 1);
+
+	g_frame[0] = 0x80 | WEBSOCKET_TEXT_FRAME;
+	g_frame[1] = 0x80 | MSG_SIZE;	/* masked with a zero key */
+	for (i = 0; i < MSG_SIZE; i++) {
+		g_frame[6 + i] = 'a' + i % 26;
+	}
+
+	heap = mallinfo2().uordblks;
+	if (open_sessions() < 0) {
+		printf("cannot open the sessions\n");
+		return 1;
+	}
+	heap = mallinfo2().uordblks - heap;
+
+#ifdef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
+	printf("multiplexed: %zu bytes heap per session, one %d bytes stack for all\n", heap / SESSIONS, WEBSOCKET_STACKSIZE);
+#else
+	printf("thread per session: %zu bytes heap + %d bytes stack per session\n", heap / SESSIONS, WEBSOCKET_STACKSIZE);
+#endif
+
+	if (run(1) < 0) {
+		return 1;
+	}
+
+#ifdef CONFIG_NETUTILS_WEBSOCKET_MULTIPLEX
+	if (run(8) < 0 || stall() < 0) {
+		return 1;
+	}
+#endif
+
+	for (i = 0; i < SESSIONS; i++) {
+		close(g_sessions[i].fd);
+	}
+
+	return 0;
+}
@@ -0,0 +1,133 @@
+###########################################################################
+#
+# Copyright 2020 Samsung Electronics All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific
+# language governing permissions and limitations under the License.
+#
+###########################################################################
+#
+# profile_fold.py: turn the histogram of /proc/profile into folded stacks
+#
+# Captured with
+#   TASH>> echo start > /proc/profile
+#   ... run the workload ...
+#   TASH>> echo stop > /proc/profile
+#   TASH>> cat /proc/profile
+#
+# the output (console prompts and other lines around it are skipped) is
+# symbolized with addr2line against the ELF of the build and printed as
+#   <task>;<outermost caller>;...;<interrupted function> <samples>
+# which flamegraph.pl and speedscope read as is.
+
+import argparse
+import collections
+import re
+import shutil
+import subprocess
+import sys
+
+ENTRY = re.compile(r'^\s*(\d+)\s+(\d+)\s+(\S+)((?:\s+[0-9a-fA-F]{8})+)\s*$')
+HEADER = re.compile(r'^\s*#\s*samples\s+(\d+)\s+dropped\s+(\d+)')
+
+
+def parse(lines):
+    entries = []
+    samples = dropped = None
+    for line in lines:
+        m = HEADER.match(line)
+        if m:
+            samples, dropped = int(m.group(1)), int(m.group(2))
+            continue
+        m = ENTRY.match(line)
+        if m:
+            pcs = [int(pc, 16) for pc in m.group(4).split()]
+            entries.append((int(m.group(1)), m.group(3), int(m.group(2)), pcs))
+    return entries, samples, dropped
+
+
+def lookup_addresses(addrs, elf, addr2line, lines):
+    """Return {address: frame name} for the given addresses."""
+    names = {}
+    if not elf or not addrs:
+        return names
+    addrs = sorted(addrs)
+    cmd = [addr2line, '-f', '-C', '-e', elf] + ['0x%x' % a for a in addrs]
+    out = subprocess.run(cmd, stdout=subprocess.PIPE, check=True,
+                         universal_newlines=True).stdout.splitlines()
+    for i, addr in enumerate(addrs):
+        func = out[2 * i].strip() if 2 * i < len(out) else '??'
+        where = out[2 * i + 1].strip() if 2 * i + 1 < len(out) else '??:0'
+        if func == '??':
+            continue
+        if lines:
+            where = where.split(' ')[0]
+            func += ':' + where.rsplit('/', 1)[-1]
+        names[addr] = func
+    return names
+
+
+def fold(entries, names, with_task, with_pid):
+    stacks = collections.Counter()
+    for pid, task, count, pcs in entries:
+        frames = []
+        for depth, pc in enumerate(pcs):
+            # Callers are return addresses: look up the call instruction
+            addr = pc if depth == 0 else pc - 2
+            frames.append(names.get(addr, '0x%08x' % pc))
+        frames.reverse()
+        if with_task:
+            frames.insert(0, '%s[%d]' % (task, pid) if with_pid else task)
+        stacks[';'.join(frames)] += count
+    return stacks
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Fold the /proc/profile histogram into flame graph stacks')
+    parser.add_argument('dump', nargs='?', help='saved /proc/profile output (default: stdin)')
+    parser.add_argument('-e', '--elf', help='ELF of the build, e.g. build/output/bin/tinyara')
+    parser.add_argument('--addr2line', help='addr2line to use (default: arm-none-eabi-addr2line)')
+    parser.add_argument('--lines', action='store_true', help='add the source file and line to each frame')
+    parser.add_argument('--no-task', action='store_true', help='do not start the stacks with the task name')
+    parser.add_argument('--pid', action='store_true', help='keep threads of the same name apart')
+    args = parser.parse_args()
+
+    if args.dump:
+        with open(args.dump, errors='replace') as f:
+            entries, samples, dropped = parse(f)
+    else:
+        entries, samples, dropped = parse(sys.stdin)
+
+    if not entries:
+        sys.exit('no profile entries found')
+    if dropped:
+        sys.stderr.write('warning: %d of %d samples were dropped, '
+                         'raise CONFIG_SCHED_PROFILE_NENTRIES\n' % (dropped, samples))
+
+    addr2line = args.addr2line
+    if addr2line is None:
+        addr2line = shutil.which('arm-none-eabi-addr2line') or 'addr2line'
+
+    addrs = set()
+    for _, _, _, pcs in entries:
+        addrs.add(pcs[0])
+        addrs.update(pc - 2 for pc in pcs[1:])
+    names = lookup_addresses(addrs, args.elf, addr2line, args.lines)
+
+    stacks = fold(entries, names, not args.no_task, args.pid)
+    for stack, count in sorted(stacks.items()):
+        print('%s %d' % (stack, count))
+
+
+if __name__ == '__main__':
+    main()